@@ -462,6 +462,8 @@
         'callback_unittest.nc',
         'cancelable_callback_unittest.cc',
         'command_line_unittest.cc',
+        'containers/flat_map_unittest.cc',
+        'containers/flat_set_unittest.cc',
         'containers/hash_tables_unittest.cc',
         'containers/linked_list_unittest.cc',
         'containers/mru_cache_unittest.cc',
@@ -471,7 +473,9 @@
         'debug/crash_logging_unittest.cc',
         'debug/leak_tracker_unittest.cc',
         'debug/proc_maps_linux_unittest.cc',
+        'debug/sampling_profiler_linux_unittest.cc',
         'debug/stack_trace_unittest.cc',
+        'debug/trace_event_binary_unittest.cc',
         'debug/trace_event_memory_unittest.cc',
         'debug/trace_event_synthetic_delay_unittest.cc',
         'debug/trace_event_system_stats_monitor_unittest.cc',
@@ -482,6 +486,7 @@
         'environment_unittest.cc',
         'file_util_unittest.cc',
         'file_version_info_unittest.cc',
+        'files/async_file_io_linux_unittest.cc',
         'files/dir_reader_posix_unittest.cc',
         'files/file_path_unittest.cc',
         'files/file_unittest.cc',
@@ -521,6 +526,7 @@
         'mac/scoped_sending_event_unittest.mm',
         'md5_unittest.cc',
         'memory/aligned_memory_unittest.cc',
+        'memory/discardable_cache_unittest.cc',
         'memory/discardable_memory_allocator_android_unittest.cc',
         'memory/discardable_memory_unittest.cc',
         'memory/discardable_memory_provider_unittest.cc',
@@ -546,6 +552,7 @@
         'metrics/field_trial_unittest.cc',
         'metrics/histogram_base_unittest.cc',
         'metrics/histogram_delta_serialization_unittest.cc',
+        'metrics/histogram_shared_memory_unittest.cc',
         'metrics/histogram_snapshot_manager_unittest.cc',
         'metrics/histogram_unittest.cc',
         'metrics/sparse_histogram_unittest.cc',
@@ -617,6 +624,8 @@
         'test/test_reg_util_win_unittest.cc',
         'test/trace_event_analyzer_unittest.cc',
         'threading/non_thread_safe_unittest.cc',
+        'threading/parallel_for_unittest.cc',
+        'threading/parallel_task_graph_unittest.cc',
         'threading/platform_thread_unittest.cc',
         'threading/sequenced_worker_pool_unittest.cc',
         'threading/simple_thread_unittest.cc',
@@ -634,9 +643,11 @@
         'time/time_win_unittest.cc',
         'timer/hi_res_timer_manager_unittest.cc',
         'timer/timer_unittest.cc',
+        'timer/timer_wheel_unittest.cc',
         'tools_sanity_unittest.cc',
         'tracked_objects_unittest.cc',
         'tuple_unittest.cc',
+        'value_arena_unittest.cc',
         'values_unittest.cc',
         'version_unittest.cc',
         'vlog_unittest.cc',
@@ -815,10 +826,28 @@
         ['OS == "android"', {
           'sources/': [
             ['include', '^debug/proc_maps_linux_unittest\\.cc$'],
+            ['include', '^debug/sampling_profiler_linux_unittest\\.cc$'],
           ],
         }],
       ],  # target_conditions
     },
+    {
+      'target_name': 'base_perftests',
+      'type': '<(gtest_target_type)',
+      'dependencies': [
+        'base',
+        'test_support_base',
+        'test_support_perf',
+        '../testing/gtest.gyp:gtest',
+        '../testing/perf/perf_test.gyp:perf_test',
+      ],
+      'sources': [
+        'callback_perftest.cc',
+        'containers/flat_map_perftest.cc',
+        'message_loop/message_loop_perftest.cc',
+        'strings/string_util_perftest.cc',
+      ],
+    },
     {
       'target_name': 'base_i18n_perftests',
       'type': '<(gtest_target_type)',
@@ -4,11 +4,131 @@
 
 #include "base/callback_internal.h"
 
+#include <string.h>
+
+#include <new>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/third_party/dynamic_annotations/dynamic_annotations.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 namespace internal {
 
+namespace {
+
+// Memory tools need to see every allocation to catch use of a destroyed
+// callback.
+#if defined(ADDRESS_SANITIZER) || defined(MEMORY_SANITIZER) || \
+    defined(THREAD_SANITIZER) || defined(LEAK_SANITIZER)
+const bool kRecycleBindStates = false;
+#else
+const bool kRecycleBindStates = true;
+#endif
+
+// BindStates are rounded up to multiples of kSizeClassGranularity, and those
+// up to kSizeClassCount * kSizeClassGranularity bytes are recycled.  That
+// covers a vtable, the ref count, a method pointer and a few arguments.
+const size_t kSizeClassGranularity = 16;
+const size_t kSizeClassCount = 8;
+
+// Past this many blocks in a size class, freed blocks go back to the heap.
+// This bounds what a thread that only destroys callbacks posted from other
+// threads holds on to.
+const size_t kMaxBlocksPerSizeClass = 32;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+// The free lists of a thread.
+struct FreeLists {
+  FreeLists() {
+    memset(heads, 0, sizeof(heads));
+    memset(counts, 0, sizeof(counts));
+  }
+
+  ~FreeLists() {
+    for (size_t i = 0; i < kSizeClassCount; ++i) {
+      while (heads[i]) {
+        FreeBlock* block = heads[i];
+        heads[i] = block->next;
+        ::operator delete(block);
+      }
+    }
+  }
+
+  FreeBlock* heads[kSizeClassCount];
+  size_t counts[kSizeClassCount];
+};
+
+void DeleteFreeLists(void* free_lists) {
+  delete static_cast<FreeLists*>(free_lists);
+}
+
+struct FreeListsSlot {
+  FreeListsSlot()
+      : enabled(kRecycleBindStates && !RunningOnValgrind()),
+        slot(&DeleteFreeLists) {
+  }
+
+  const bool enabled;
+  ThreadLocalStorage::Slot slot;
+};
+
+LazyInstance<FreeListsSlot>::Leaky g_free_lists_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+inline size_t SizeClass(size_t size) {
+  return (size - 1) / kSizeClassGranularity;
+}
+
+}  // namespace
+
+void* AllocateBindStateMemory(size_t size) {
+  DCHECK_GT(size, 0u);
+  size_t size_class = SizeClass(size);
+  FreeListsSlot& free_lists_slot = g_free_lists_slot.Get();
+  if (size_class >= kSizeClassCount || !free_lists_slot.enabled)
+    return ::operator new(size);
+
+  FreeLists* free_lists = static_cast<FreeLists*>(free_lists_slot.slot.Get());
+  if (!free_lists) {
+    free_lists = new FreeLists;
+    free_lists_slot.slot.Set(free_lists);
+  }
+  FreeBlock* block = free_lists->heads[size_class];
+  if (!block)
+    return ::operator new((size_class + 1) * kSizeClassGranularity);
+  free_lists->heads[size_class] = block->next;
+  --free_lists->counts[size_class];
+  return block;
+}
+
+void FreeBindStateMemory(void* memory, size_t size) {
+  if (!memory)
+    return;
+  size_t size_class = SizeClass(size);
+  FreeListsSlot& free_lists_slot = g_free_lists_slot.Get();
+  if (size_class >= kSizeClassCount || !free_lists_slot.enabled) {
+    ::operator delete(memory);
+    return;
+  }
+
+  // Threads that never allocated a BindState, or are being torn down, don't
+  // get free lists.
+  FreeLists* free_lists = static_cast<FreeLists*>(free_lists_slot.slot.Get());
+  if (!free_lists || free_lists->counts[size_class] >= kMaxBlocksPerSizeClass) {
+    ::operator delete(memory);
+    return;
+  }
+  FreeBlock* block = static_cast<FreeBlock*>(memory);
+  block->next = free_lists->heads[size_class];
+  free_lists->heads[size_class] = block;
+  ++free_lists->counts[size_class];
+}
+
 bool CallbackBase::is_null() const {
   return bind_state_.get() == NULL;
 }
@@ -20,6 +20,14 @@ class ScopedVector;
 namespace base {
 namespace internal {
 
+// Allocate and free the memory of BindStates.  Small blocks are recycled
+// through per-thread free lists of a few size classes, since nearly every
+// Bind() and PostTask() allocates one and most are destroyed shortly after.
+// A block may be freed on another thread than the one it was allocated on.
+// |size| must be the same in both calls.
+BASE_EXPORT void* AllocateBindStateMemory(size_t size);
+BASE_EXPORT void FreeBindStateMemory(void* memory, size_t size);
+
 // BindStateBase is used to provide an opaque handle that the Callback
 // class can use to represent a function object with bound arguments.  It
 // behaves as an existential type that is used by a corresponding
@@ -27,6 +35,15 @@ namespace internal {
 // us to shield the Callback class from the types of the bound argument via
 // "type erasure."
 class BindStateBase : public RefCountedThreadSafe<BindStateBase> {
+ public:
+  // The destructor is virtual, so |size| is that of the derived BindState.
+  static void* operator new(size_t size) {
+    return AllocateBindStateMemory(size);
+  }
+  static void operator delete(void* memory, size_t size) {
+    FreeBindStateMemory(memory, size);
+  }
+
  protected:
   friend class RefCountedThreadSafe<BindStateBase>;
   virtual ~BindStateBase() {}
@@ -0,0 +1,103 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the cost of binding, running and destroying callbacks, most of
+// which is the allocation and release of their BindState.
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/callback_internal.h"
+#include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kIterations = 1000000;
+
+class Counter : public RefCountedThreadSafe<Counter> {
+ public:
+  Counter() : count_(0) {}
+
+  void Increment() { ++count_; }
+  void Add(int amount, const std::string& unused) { count_ += amount; }
+
+  int count() const { return count_; }
+
+ private:
+  friend class RefCountedThreadSafe<Counter>;
+  ~Counter() {}
+
+  int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(Counter);
+};
+
+void PrintTime(const std::string& trace, TimeDelta elapsed) {
+  perf_test::PrintResult(trace, "", "",
+                         elapsed.InMicroseconds() * 1000.0 / kIterations, "ns",
+                         true);
+}
+
+}  // namespace
+
+TEST(CallbackPerfTest, BindRunDestroy) {
+  scoped_refptr<Counter> counter(new Counter);
+  std::string argument("argument");
+
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i)
+    Bind(&Counter::Increment, Unretained(counter.get())).Run();
+  PrintTime("bind_unretained", TimeTicks::HighResNow() - start);
+
+  start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i)
+    Bind(&Counter::Increment, counter).Run();
+  PrintTime("bind_refcounted", TimeTicks::HighResNow() - start);
+
+  start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i)
+    Bind(&Counter::Add, counter, 1, argument).Run();
+  PrintTime("bind_three_args", TimeTicks::HighResNow() - start);
+
+  EXPECT_EQ(3 * kIterations, counter->count());
+}
+
+TEST(CallbackPerfTest, PostTask) {
+  MessageLoop message_loop;
+  scoped_refptr<Counter> counter(new Counter);
+
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i)
+    message_loop.PostTask(FROM_HERE, Bind(&Counter::Increment, counter));
+  RunLoop().RunUntilIdle();
+  PrintTime("post_task_to_self", TimeTicks::HighResNow() - start);
+
+  EXPECT_EQ(kIterations, counter->count());
+}
+
+TEST(CallbackPerfTest, RawAllocation) {
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i) {
+    void* memory = internal::AllocateBindStateMemory(48);
+    internal::FreeBindStateMemory(memory, 48);
+  }
+  PrintTime("bind_state_memory", TimeTicks::HighResNow() - start);
+
+  start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i) {
+    void* memory = ::operator new(48);
+    ::operator delete(memory);
+  }
+  PrintTime("operator_new", TimeTicks::HighResNow() - start);
+}
+
+}  // namespace base
@@ -8,6 +8,7 @@
 #include "base/callback_internal.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/third_party/dynamic_annotations/dynamic_annotations.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -177,5 +178,36 @@ TEST_F(CallbackTest, CallbackHasLastRefOnContainingObject) {
   ASSERT_TRUE(deleted);
 }
 
+TEST_F(CallbackTest, BindStateMemoryIsRecycled) {
+  // Memory tools get every BindState from the heap.
+#if defined(ADDRESS_SANITIZER) || defined(MEMORY_SANITIZER) || \
+    defined(THREAD_SANITIZER) || defined(LEAK_SANITIZER)
+  return;
+#endif
+  if (RunningOnValgrind())
+    return;
+
+  // Sizes up to the same multiple of 16 share blocks.
+  void* memory = internal::AllocateBindStateMemory(40);
+  internal::FreeBindStateMemory(memory, 40);
+  void* recycled = internal::AllocateBindStateMemory(48);
+  EXPECT_EQ(memory, recycled);
+  void* other = internal::AllocateBindStateMemory(40);
+  EXPECT_NE(recycled, other);
+  internal::FreeBindStateMemory(other, 40);
+  internal::FreeBindStateMemory(recycled, 48);
+
+  // A BindState released by the last Callback referring to it gives its
+  // storage to the next one of the same size.
+  FakeBindState1* bind_state = new FakeBindState1();
+  void* address = bind_state;
+  {
+    Callback<void(void)> callback(bind_state);
+  }
+  bind_state = new FakeBindState1();
+  Callback<void(void)> callback(bind_state);
+  EXPECT_EQ(address, static_cast<void*>(bind_state));
+}
+
 }  // namespace
 }  // namespace base
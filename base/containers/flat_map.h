@@ -0,0 +1,86 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_MAP_H_
+#define BASE_CONTAINERS_FLAT_MAP_H_
+
+#include <functional>
+#include <utility>
+
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// FlatMap is an STL-like associative container that keeps its elements in a
+// sorted std::vector instead of a tree.
+//
+// WHEN TO USE IT
+// --------------
+//
+// Lookups are a binary search over contiguous memory, and iteration is as fast
+// as iterating a vector. There is one heap allocation for the whole map rather
+// than one per element, and no per-element overhead. This makes FlatMap a good
+// fit for maps that are built once, or rarely changed, and then read a lot.
+//
+// Inserting or erasing a single element is O(n) since the elements after it
+// have to be moved. Prefer building the map in bulk, from the constructor
+// taking a range (which needn't be sorted) or the range insert(), over many
+// single insertions. For maps that are modified as often as they are read,
+// use std::map or base::hash_map; for maps that stay tiny, see SmallMap.
+//
+// DIFFERENCES FROM std::map
+// -------------------------
+//
+//  - value_type is std::pair<Key, Mapped>, without the const. Don't modify
+//    the keys through iterators.
+//  - Any insertion or erasure invalidates all iterators and references.
+//  - There is no at(), since Chromium doesn't use exceptions.
+//
+// Example:
+//   std::vector<std::pair<int, std::string> > items = ...;  // In any order.
+//   base::FlatMap<int, std::string> map(items.begin(), items.end());
+//   base::FlatMap<int, std::string>::const_iterator it = map.find(42);
+template <typename Key, typename Mapped, typename Compare = std::less<Key> >
+class FlatMap
+    : public internal::FlatTree<Key,
+                                std::pair<Key, Mapped>,
+                                internal::GetKeyFromPair<Key, Mapped>,
+                                Compare> {
+ private:
+  typedef internal::FlatTree<Key,
+                             std::pair<Key, Mapped>,
+                             internal::GetKeyFromPair<Key, Mapped>,
+                             Compare> Tree;
+
+ public:
+  typedef Mapped mapped_type;
+  typedef typename Tree::value_type value_type;
+  typedef typename Tree::iterator iterator;
+  typedef typename Tree::const_iterator const_iterator;
+
+  FlatMap() {}
+
+  explicit FlatMap(const Compare& comp) : Tree(comp) {}
+
+  template <typename InputIterator>
+  FlatMap(InputIterator first,
+          InputIterator last,
+          const Compare& comp = Compare())
+      : Tree(first, last, comp) {}
+
+  // Returns the value mapped to |key|, inserting a default constructed one
+  // first if there is none.
+  Mapped& operator[](const Key& key) {
+    iterator position = this->lower_bound(key);
+    if (position == this->end() || this->key_comp()(key, position->first))
+      position = this->unsafe_insert(position, value_type(key, Mapped()));
+    return position->second;
+  }
+
+  void swap(FlatMap& other) { Tree::swap(other); }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_MAP_H_
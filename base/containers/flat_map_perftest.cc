@@ -0,0 +1,101 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares lookups and iteration in FlatMap against std::map and
+// base::hash_map at a few sizes.
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/hash_tables.h"
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kLookups = 1000000;
+const int kIterations = 1000;
+
+template <typename Map>
+void MeasureLookups(const std::string& name,
+                    const Map& map,
+                    const std::vector<int>& keys) {
+  int found = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kLookups; ++i)
+    found += map.count(keys[i % keys.size()]);
+  TimeDelta elapsed = TimeTicks::Now() - start;
+  EXPECT_EQ(kLookups, found);
+  perf_test::PrintResult("lookup", name, "",
+                         elapsed.InMicroseconds() * 1000.0 / kLookups,
+                         "ns/lookup", true);
+}
+
+template <typename Map>
+void MeasureIteration(const std::string& name, const Map& map) {
+  int64 sum = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+      sum += it->second;
+  }
+  TimeDelta elapsed = TimeTicks::Now() - start;
+  EXPECT_NE(0, sum);
+  double visited = static_cast<double>(kIterations) * map.size();
+  perf_test::PrintResult("iterate", name, "",
+                         elapsed.InMicroseconds() * 1000.0 / visited,
+                         "ns/element", true);
+}
+
+void RunBenchmark(int size) {
+  std::vector<std::pair<int, int> > items;
+  for (int i = 0; i < size; ++i)
+    items.push_back(std::make_pair(RandInt(0, kint32max), i + 1));
+
+  std::map<int, int> std_map(items.begin(), items.end());
+  hash_map<int, int> hashed_map(items.begin(), items.end());
+
+  TimeTicks start = TimeTicks::Now();
+  FlatMap<int, int> flat_map(items.begin(), items.end());
+  perf_test::PrintResult("build", StringPrintf("_flat_map_%d", size), "",
+                         static_cast<double>(
+                             (TimeTicks::Now() - start).InMicroseconds()),
+                         "us", true);
+
+  // Look the keys up in an order unrelated to their layout in memory.
+  std::vector<int> keys;
+  for (size_t i = 0; i < items.size(); ++i)
+    keys.push_back(items[RandGenerator(items.size())].first);
+
+  MeasureLookups(StringPrintf("_std_map_%d", size), std_map, keys);
+  MeasureLookups(StringPrintf("_hash_map_%d", size), hashed_map, keys);
+  MeasureLookups(StringPrintf("_flat_map_%d", size), flat_map, keys);
+
+  MeasureIteration(StringPrintf("_std_map_%d", size), std_map);
+  MeasureIteration(StringPrintf("_hash_map_%d", size), hashed_map);
+  MeasureIteration(StringPrintf("_flat_map_%d", size), flat_map);
+}
+
+}  // namespace
+
+TEST(FlatMapPerfTest, Small) {
+  RunBenchmark(16);
+}
+
+TEST(FlatMapPerfTest, Medium) {
+  RunBenchmark(1000);
+}
+
+TEST(FlatMapPerfTest, Large) {
+  RunBenchmark(100000);
+}
+
+}  // namespace base
@@ -0,0 +1,188 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_map.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+typedef FlatMap<int, std::string> IntStringMap;
+
+}  // namespace
+
+TEST(FlatMapTest, Empty) {
+  IntStringMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(1) == map.end());
+  EXPECT_EQ(0u, map.count(1));
+}
+
+TEST(FlatMapTest, RangeConstructorSortsAndDropsDuplicates) {
+  std::vector<std::pair<int, std::string> > items;
+  items.push_back(std::make_pair(3, "three"));
+  items.push_back(std::make_pair(1, "one"));
+  items.push_back(std::make_pair(2, "two"));
+  items.push_back(std::make_pair(1, "uno"));
+  items.push_back(std::make_pair(3, "tres"));
+
+  IntStringMap map(items.begin(), items.end());
+  ASSERT_EQ(3u, map.size());
+
+  IntStringMap::const_iterator it = map.begin();
+  EXPECT_EQ(1, it->first);
+  // The first of several equivalent values wins.
+  EXPECT_EQ("one", it->second);
+  ++it;
+  EXPECT_EQ(2, it->first);
+  ++it;
+  EXPECT_EQ(3, it->first);
+  EXPECT_EQ("three", it->second);
+}
+
+TEST(FlatMapTest, Insert) {
+  IntStringMap map;
+  std::pair<IntStringMap::iterator, bool> result =
+      map.insert(std::make_pair(2, std::string("two")));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(2, result.first->first);
+
+  result = map.insert(std::make_pair(2, std::string("dos")));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("two", result.first->second);
+
+  map.insert(std::make_pair(1, std::string("one")));
+  map.insert(map.end(), std::make_pair(4, std::string("four")));
+  // A wrong hint still inserts at the right place.
+  map.insert(map.begin(), std::make_pair(3, std::string("three")));
+
+  ASSERT_EQ(4u, map.size());
+  int expected_key = 1;
+  for (IntStringMap::const_iterator it = map.begin(); it != map.end(); ++it)
+    EXPECT_EQ(expected_key++, it->first);
+}
+
+TEST(FlatMapTest, InsertRange) {
+  IntStringMap map;
+  map[5] = "five";
+  map[1] = "one";
+
+  std::vector<std::pair<int, std::string> > items;
+  items.push_back(std::make_pair(4, "four"));
+  items.push_back(std::make_pair(1, "uno"));
+  items.push_back(std::make_pair(2, "two"));
+  map.insert(items.begin(), items.end());
+
+  ASSERT_EQ(4u, map.size());
+  // Existing values are kept.
+  EXPECT_EQ("one", map[1]);
+  EXPECT_EQ("two", map[2]);
+  EXPECT_EQ("four", map[4]);
+  EXPECT_EQ("five", map[5]);
+}
+
+TEST(FlatMapTest, SubscriptOperator) {
+  IntStringMap map;
+  map[2] = "two";
+  map[1] = "one";
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ("one", map[1]);
+  EXPECT_EQ("", map[3]);
+  EXPECT_EQ(3u, map.size());
+  map[2] = "dos";
+  EXPECT_EQ("dos", map.find(2)->second);
+}
+
+TEST(FlatMapTest, Search) {
+  IntStringMap map;
+  map[10] = "ten";
+  map[20] = "twenty";
+  map[30] = "thirty";
+
+  EXPECT_TRUE(map.find(15) == map.end());
+  EXPECT_EQ("twenty", map.find(20)->second);
+  EXPECT_EQ(20, map.lower_bound(15)->first);
+  EXPECT_EQ(20, map.lower_bound(20)->first);
+  EXPECT_EQ(30, map.upper_bound(20)->first);
+  EXPECT_TRUE(map.upper_bound(30) == map.end());
+
+  std::pair<IntStringMap::iterator, IntStringMap::iterator> range =
+      map.equal_range(20);
+  EXPECT_EQ(1, range.second - range.first);
+  range = map.equal_range(25);
+  EXPECT_TRUE(range.first == range.second);
+  EXPECT_EQ(30, range.first->first);
+
+  const IntStringMap& const_map = map;
+  EXPECT_EQ("ten", const_map.find(10)->second);
+  EXPECT_EQ(1u, const_map.count(30));
+}
+
+TEST(FlatMapTest, Erase) {
+  IntStringMap map;
+  for (int i = 0; i < 10; ++i)
+    map[i] = "";
+
+  EXPECT_EQ(1u, map.erase(5));
+  EXPECT_EQ(0u, map.erase(5));
+  EXPECT_EQ(9u, map.size());
+
+  IntStringMap::iterator it = map.erase(map.begin());
+  EXPECT_EQ(1, it->first);
+  map.erase(map.begin(), map.find(8));
+  ASSERT_EQ(2u, map.size());
+  EXPECT_EQ(8, map.begin()->first);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatMapTest, CustomCompare) {
+  FlatMap<int, int, std::greater<int> > map;
+  map[1] = 1;
+  map[3] = 3;
+  map[2] = 2;
+  EXPECT_EQ(3, map.begin()->first);
+  EXPECT_EQ(1, map.rbegin()->first);
+  EXPECT_TRUE(map.key_comp()(2, 1));
+}
+
+TEST(FlatMapTest, SwapAndCompare) {
+  IntStringMap a;
+  a[1] = "one";
+  IntStringMap b;
+  b[2] = "two";
+  b[3] = "three";
+
+  IntStringMap a_copy(a);
+  EXPECT_TRUE(a == a_copy);
+  EXPECT_TRUE(a != b);
+  EXPECT_TRUE(a < b);
+
+  a.swap(b);
+  EXPECT_EQ(2u, a.size());
+  EXPECT_EQ(1u, b.size());
+  EXPECT_TRUE(b == a_copy);
+}
+
+TEST(FlatMapTest, Capacity) {
+  IntStringMap map;
+  map.reserve(100);
+  EXPECT_LE(100u, map.capacity());
+  map[1] = "one";
+  map.shrink_to_fit();
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ("one", map[1]);
+}
+
+}  // namespace base
@@ -0,0 +1,50 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_SET_H_
+#define BASE_CONTAINERS_FLAT_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// FlatSet is an STL-like set that keeps its elements in a sorted std::vector.
+// It has the same performance characteristics and caveats as FlatMap, see
+// flat_map.h: lookups and iteration are fast, single insertions and erasures
+// are O(n), and any modification invalidates all iterators.
+//
+// Example:
+//   std::vector<int> ids = ...;  // In any order, possibly with duplicates.
+//   base::FlatSet<int> id_set(ids.begin(), ids.end());
+//   if (id_set.count(42)) ...
+template <typename Key, typename Compare = std::less<Key> >
+class FlatSet : public internal::FlatTree<Key,
+                                          Key,
+                                          internal::GetKeyFromValue<Key>,
+                                          Compare> {
+ private:
+  typedef internal::FlatTree<Key,
+                             Key,
+                             internal::GetKeyFromValue<Key>,
+                             Compare> Tree;
+
+ public:
+  FlatSet() {}
+
+  explicit FlatSet(const Compare& comp) : Tree(comp) {}
+
+  template <typename InputIterator>
+  FlatSet(InputIterator first,
+          InputIterator last,
+          const Compare& comp = Compare())
+      : Tree(first, last, comp) {}
+
+  void swap(FlatSet& other) { Tree::swap(other); }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_SET_H_
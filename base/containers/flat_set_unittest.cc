@@ -0,0 +1,54 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_set.h"
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(FlatSetTest, RangeConstructor) {
+  const int kValues[] = { 5, 3, 1, 3, 4, 1, 2 };
+  FlatSet<int> set(kValues, kValues + arraysize(kValues));
+  ASSERT_EQ(5u, set.size());
+  int expected = 1;
+  for (FlatSet<int>::const_iterator it = set.begin(); it != set.end(); ++it)
+    EXPECT_EQ(expected++, *it);
+}
+
+TEST(FlatSetTest, InsertAndErase) {
+  FlatSet<std::string> set;
+  EXPECT_TRUE(set.insert("b").second);
+  EXPECT_TRUE(set.insert("a").second);
+  EXPECT_FALSE(set.insert("b").second);
+  EXPECT_EQ(2u, set.size());
+  EXPECT_EQ("a", *set.begin());
+
+  std::vector<std::string> more;
+  more.push_back("d");
+  more.push_back("c");
+  more.push_back("a");
+  set.insert(more.begin(), more.end());
+  EXPECT_EQ(4u, set.size());
+  EXPECT_EQ(1u, set.count("c"));
+
+  EXPECT_EQ(1u, set.erase("a"));
+  EXPECT_EQ(0u, set.erase("a"));
+  EXPECT_TRUE(set.find("a") == set.end());
+  EXPECT_EQ("b", *set.begin());
+}
+
+TEST(FlatSetTest, Bounds) {
+  const int kValues[] = { 10, 20, 30 };
+  const FlatSet<int> set(kValues, kValues + arraysize(kValues));
+  EXPECT_EQ(20, *set.lower_bound(11));
+  EXPECT_EQ(30, *set.upper_bound(20));
+  EXPECT_TRUE(set.lower_bound(31) == set.end());
+}
+
+}  // namespace base
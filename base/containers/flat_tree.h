@@ -0,0 +1,257 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_TREE_H_
+#define BASE_CONTAINERS_FLAT_TREE_H_
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace base {
+namespace internal {
+
+// Key extractors for FlatTree.
+template <typename Key>
+struct GetKeyFromValue {
+  const Key& operator()(const Key& key) const { return key; }
+};
+
+template <typename Key, typename Mapped>
+struct GetKeyFromPair {
+  const Key& operator()(const std::pair<Key, Mapped>& value) const {
+    return value.first;
+  }
+  const Key& operator()(const Key& key) const { return key; }
+};
+
+// The implementation shared by FlatSet and FlatMap: a vector of values kept
+// sorted by key, with no two values having equivalent keys. See flat_map.h
+// for when to use it.
+//
+// GetKey is a functor that returns the key of a value_type and also accepts a
+// bare key, which lets the comparator work on either.
+template <typename Key, typename Value, typename GetKey, typename Compare>
+class FlatTree {
+ private:
+  typedef std::vector<Value> Storage;
+
+  // Orders values, keys, and values against keys by their keys.
+  class KeyValueCompare {
+   public:
+    explicit KeyValueCompare(const Compare& key_comp) : key_comp_(key_comp) {}
+
+    template <typename Left, typename Right>
+    bool operator()(const Left& left, const Right& right) const {
+      GetKey get_key;
+      return key_comp_(get_key(left), get_key(right));
+    }
+
+    const Compare& key_comp() const { return key_comp_; }
+
+   private:
+    Compare key_comp_;
+  };
+
+ public:
+  typedef Key key_type;
+  typedef Compare key_compare;
+  typedef Value value_type;
+  typedef KeyValueCompare value_compare;
+
+  typedef typename Storage::pointer pointer;
+  typedef typename Storage::const_pointer const_pointer;
+  typedef typename Storage::reference reference;
+  typedef typename Storage::const_reference const_reference;
+  typedef typename Storage::size_type size_type;
+  typedef typename Storage::difference_type difference_type;
+  typedef typename Storage::iterator iterator;
+  typedef typename Storage::const_iterator const_iterator;
+  typedef typename Storage::reverse_iterator reverse_iterator;
+  typedef typename Storage::const_reverse_iterator const_reverse_iterator;
+
+  FlatTree() : comp_(Compare()) {}
+
+  explicit FlatTree(const Compare& comp) : comp_(comp) {}
+
+  // Builds the tree from unsorted input in O(n log n). Of several values with
+  // equivalent keys, the first one wins, like with repeated insert() calls.
+  template <typename InputIterator>
+  FlatTree(InputIterator first,
+           InputIterator last,
+           const Compare& comp = Compare())
+      : comp_(comp),
+        values_(first, last) {
+    SortAndUnique(values_.begin());
+  }
+
+  // Iterators ----------------------------------------------------------------
+
+  iterator begin() { return values_.begin(); }
+  const_iterator begin() const { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator end() const { return values_.end(); }
+
+  reverse_iterator rbegin() { return values_.rbegin(); }
+  const_reverse_iterator rbegin() const { return values_.rbegin(); }
+  reverse_iterator rend() { return values_.rend(); }
+  const_reverse_iterator rend() const { return values_.rend(); }
+
+  // Size management ----------------------------------------------------------
+
+  bool empty() const { return values_.empty(); }
+  size_type size() const { return values_.size(); }
+  size_type max_size() const { return values_.max_size(); }
+
+  size_type capacity() const { return values_.capacity(); }
+  void reserve(size_type new_capacity) { values_.reserve(new_capacity); }
+  // Releases unused capacity.
+  void shrink_to_fit() { Storage(values_).swap(values_); }
+
+  void clear() { values_.clear(); }
+
+  // Insertion ----------------------------------------------------------------
+  //
+  // Inserting a single value is O(n) since the values after it have to be
+  // moved. To add many values at once, use the range insert() or constructor.
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    iterator position = lower_bound(GetKey()(value));
+    if (position != end() && !comp_(value, *position))
+      return std::make_pair(position, false);
+    return std::make_pair(values_.insert(position, value), true);
+  }
+
+  // Insertion is cheap if |value| belongs right before |hint|, e.g. when
+  // values are added in order with end() as the hint.
+  iterator insert(const_iterator hint, const value_type& value) {
+    if ((hint == end() || comp_(value, *hint)) &&
+        (hint == begin() || comp_(*(hint - 1), value))) {
+      return values_.insert(begin() + (hint - begin()), value);
+    }
+    return insert(value).first;
+  }
+
+  // Inserts a range in O(n + k log k). Values whose key is already present
+  // are dropped.
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    size_type old_size = size();
+    values_.insert(values_.end(), first, last);
+    SortAndUnique(values_.begin() + old_size);
+  }
+
+  // Erasure ------------------------------------------------------------------
+
+  iterator erase(iterator position) { return values_.erase(position); }
+  iterator erase(iterator first, iterator last) {
+    return values_.erase(first, last);
+  }
+  size_type erase(const key_type& key) {
+    std::pair<iterator, iterator> range = equal_range(key);
+    size_type count = range.second - range.first;
+    erase(range.first, range.second);
+    return count;
+  }
+
+  // Search -------------------------------------------------------------------
+
+  size_type count(const key_type& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  iterator find(const key_type& key) {
+    iterator position = lower_bound(key);
+    return (position == end() || comp_(key, *position)) ? end() : position;
+  }
+  const_iterator find(const key_type& key) const {
+    const_iterator position = lower_bound(key);
+    return (position == end() || comp_(key, *position)) ? end() : position;
+  }
+
+  iterator lower_bound(const key_type& key) {
+    return std::lower_bound(begin(), end(), key, comp_);
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return std::lower_bound(begin(), end(), key, comp_);
+  }
+
+  iterator upper_bound(const key_type& key) {
+    return std::upper_bound(begin(), end(), key, comp_);
+  }
+  const_iterator upper_bound(const key_type& key) const {
+    return std::upper_bound(begin(), end(), key, comp_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    iterator position = lower_bound(key);
+    if (position == end() || comp_(key, *position))
+      return std::make_pair(position, position);
+    return std::make_pair(position, position + 1);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type& key) const {
+    const_iterator position = lower_bound(key);
+    if (position == end() || comp_(key, *position))
+      return std::make_pair(position, position);
+    return std::make_pair(position, position + 1);
+  }
+
+  // General operations -------------------------------------------------------
+
+  key_compare key_comp() const { return comp_.key_comp(); }
+  value_compare value_comp() const { return comp_; }
+
+  void swap(FlatTree& other) {
+    std::swap(comp_, other.comp_);
+    values_.swap(other.values_);
+  }
+
+  bool operator==(const FlatTree& other) const {
+    return values_ == other.values_;
+  }
+  bool operator!=(const FlatTree& other) const {
+    return values_ != other.values_;
+  }
+  bool operator<(const FlatTree& other) const {
+    return values_ < other.values_;
+  }
+
+ protected:
+  // For FlatMap::operator[].
+  iterator unsafe_insert(iterator position, const value_type& value) {
+    return values_.insert(position, value);
+  }
+
+ private:
+  // Restores the invariant after unsorted values were appended from
+  // |first_unsorted| on. Of equivalent keys the earliest value is kept, and
+  // values that were already in the tree precede appended ones.
+  void SortAndUnique(iterator first_unsorted) {
+    std::stable_sort(first_unsorted, end(), comp_);
+    std::inplace_merge(begin(), first_unsorted, end(), comp_);
+    values_.erase(std::unique(begin(), end(), EquivalentKeys(comp_)), end());
+  }
+
+  // Tests two values for equivalence of their keys, for std::unique.
+  class EquivalentKeys {
+   public:
+    explicit EquivalentKeys(const KeyValueCompare& comp) : comp_(comp) {}
+    bool operator()(const value_type& left, const value_type& right) const {
+      return !comp_(left, right) && !comp_(right, left);
+    }
+
+   private:
+    const KeyValueCompare& comp_;
+  };
+
+  KeyValueCompare comp_;
+  Storage values_;
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_TREE_H_
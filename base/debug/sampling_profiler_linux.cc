@@ -0,0 +1,408 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/sampling_profiler_linux.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/debug/stack_trace.h"
+#include "base/logging.h"
+#include "base/memory/singleton.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/values.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+const int kSampleSignal = SIGPROF;
+
+// How long to wait for a thread to run the signal handler, before giving up
+// on the sample.
+const int kSampleTimeoutMs = 100;
+
+// StackTrace doesn't capture more than that.
+const size_t kMaxFrames = 62;
+
+// The sample in flight.  The sampling thread takes one sample at a time: it
+// sets |thread_id| and signals the thread, whose handler fills in the frames,
+// sets |done_sequence| to |sequence| and posts |g_sample_done|.
+struct Sample {
+  subtle::Atomic32 thread_id;
+  subtle::Atomic32 sequence;
+  subtle::Atomic32 done_sequence;
+  size_t frame_count;
+  uintptr_t frames[kMaxFrames];
+};
+
+Sample g_sample;
+sem_t g_sample_done;
+
+// Returns the instruction the signal interrupted, or 0 if unknown.
+uintptr_t GetProgramCounter(void* context) {
+#if !defined(OS_ANDROID)
+  mcontext_t* mcontext = &static_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(ARCH_CPU_X86_64)
+  return mcontext->gregs[REG_RIP];
+#elif defined(ARCH_CPU_X86)
+  return mcontext->gregs[REG_EIP];
+#elif defined(ARCH_CPU_ARMEL)
+  return mcontext->arm_pc;
+#endif
+#endif
+  return 0;
+}
+
+// NOTE: This MUST be async-signal safe.  NO malloc or stdio is allowed here.
+void SampleSignalHandler(int signal, siginfo_t* info, void* context) {
+  int saved_errno = errno;
+  if (info->si_code == SI_TKILL && info->si_pid == getpid() &&
+      subtle::Acquire_Load(&g_sample.thread_id) ==
+          PlatformThread::CurrentId()) {
+    StackTrace stack_trace;
+    size_t count = 0;
+    const void* const* addresses = stack_trace.Addresses(&count);
+
+    // Drop the frames of the handler itself, which are above the interrupted
+    // instruction.
+    size_t first = 0;
+    uintptr_t pc = GetProgramCounter(context);
+    for (size_t i = 0; pc && i < count; ++i) {
+      if (reinterpret_cast<uintptr_t>(addresses[i]) == pc) {
+        first = i;
+        break;
+      }
+    }
+    g_sample.frame_count = std::min(count - first, kMaxFrames);
+    for (size_t i = 0; i < g_sample.frame_count; ++i)
+      g_sample.frames[i] = reinterpret_cast<uintptr_t>(addresses[first + i]);
+
+    subtle::Release_Store(&g_sample.done_sequence,
+                          subtle::NoBarrier_Load(&g_sample.sequence));
+    sem_post(&g_sample_done);
+  }
+  errno = saved_errno;
+}
+
+bool InstallSignalHandler() {
+  // Like EnableInProcessStackDumping(), make sure backtrace() doesn't first
+  // initialize itself in the signal handler.
+  StackTrace warm_up;
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  action.sa_sigaction = &SampleSignalHandler;
+  sigemptyset(&action.sa_mask);
+  return sigaction(kSampleSignal, &action, NULL) == 0;
+}
+
+}  // namespace
+
+// Wakes up every |interval| to sample the registered threads.
+class SamplingProfiler::SamplingThread : public PlatformThread::Delegate {
+ public:
+  SamplingThread(SamplingProfiler* profiler, TimeDelta interval)
+      : profiler_(profiler),
+        interval_(interval),
+        stop_event_(false, false) {
+  }
+
+  bool Start() {
+    return PlatformThread::Create(0, this, &thread_handle_);
+  }
+
+  void Stop() {
+    stop_event_.Signal();
+    PlatformThread::Join(thread_handle_);
+  }
+
+  // PlatformThread::Delegate implementation.
+  virtual void ThreadMain() OVERRIDE {
+    PlatformThread::SetName("SamplingProfiler");
+    std::vector<PlatformThreadId> thread_ids;
+    while (!stop_event_.TimedWait(interval_)) {
+      profiler_->GetRegisteredThreads(&thread_ids);
+      for (size_t i = 0; i < thread_ids.size(); ++i)
+        profiler_->SampleThread(thread_ids[i]);
+    }
+  }
+
+ private:
+  SamplingProfiler* const profiler_;
+  const TimeDelta interval_;
+  WaitableEvent stop_event_;
+  PlatformThreadHandle thread_handle_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingThread);
+};
+
+SamplingProfiler::ThreadProfile::ThreadProfile()
+    : thread_id(kInvalidThreadId),
+      samples(0) {
+}
+
+SamplingProfiler::ThreadProfile::~ThreadProfile() {
+}
+
+SamplingProfiler::Profile::Profile() {
+}
+
+SamplingProfiler::Profile::~Profile() {
+}
+
+SamplingProfiler::ThreadState::ThreadState() : registered(false) {
+}
+
+SamplingProfiler::ThreadState::~ThreadState() {
+}
+
+// static
+SamplingProfiler* SamplingProfiler::GetInstance() {
+  return Singleton<SamplingProfiler,
+                   LeakySingletonTraits<SamplingProfiler> >::get();
+}
+
+SamplingProfiler::SamplingProfiler() {
+  CHECK_EQ(0, sem_init(&g_sample_done, 0, 0));
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  STLDeleteValues(&threads_);
+}
+
+void SamplingProfiler::RegisterCurrentThread(const std::string& name) {
+  PlatformThreadId thread_id = PlatformThread::CurrentId();
+  AutoLock auto_lock(lock_);
+  ThreadState*& state = threads_[thread_id];
+  if (!state)
+    state = new ThreadState;
+  state->profile.thread_name = name;
+  state->profile.thread_id = thread_id;
+  state->registered = true;
+}
+
+void SamplingProfiler::UnregisterCurrentThread() {
+  AutoLock auto_lock(lock_);
+  std::map<PlatformThreadId, ThreadState*>::iterator it =
+      threads_.find(PlatformThread::CurrentId());
+  DCHECK(it != threads_.end());
+  if (it != threads_.end())
+    it->second->registered = false;
+}
+
+bool SamplingProfiler::Start(TimeDelta interval) {
+  AutoLock auto_lock(lock_);
+  if (sampling_thread_)
+    return false;
+
+  // The handler stays installed once the profiler has run, as a thread that
+  // was slow to handle the signal may still receive it.
+  static bool handler_installed = false;
+  if (!handler_installed) {
+    if (!InstallSignalHandler()) {
+      DPLOG(ERROR) << "sigaction";
+      return false;
+    }
+    handler_installed = true;
+  }
+
+  scoped_ptr<SamplingThread> sampling_thread(
+      new SamplingThread(this, interval));
+  if (!sampling_thread->Start())
+    return false;
+  sampling_thread_ = sampling_thread.Pass();
+  if (start_time_.is_null())
+    start_time_ = TimeTicks::Now();
+  return true;
+}
+
+void SamplingProfiler::Stop() {
+  scoped_ptr<SamplingThread> sampling_thread;
+  {
+    AutoLock auto_lock(lock_);
+    sampling_thread = sampling_thread_.Pass();
+  }
+  // The sampling thread takes |lock_| itself.
+  if (sampling_thread)
+    sampling_thread->Stop();
+}
+
+bool SamplingProfiler::IsRunning() const {
+  AutoLock auto_lock(lock_);
+  return sampling_thread_.get() != NULL;
+}
+
+void SamplingProfiler::TakeProfile(Profile* profile) {
+  {
+    AutoLock auto_lock(lock_);
+    TimeTicks now = TimeTicks::Now();
+    profile->start_time = start_time_;
+    profile->duration = start_time_.is_null() ? TimeDelta() : now - start_time_;
+    start_time_ = sampling_thread_.get() ? now : TimeTicks();
+
+    profile->threads.clear();
+    std::map<PlatformThreadId, ThreadState*>::iterator it = threads_.begin();
+    while (it != threads_.end()) {
+      ThreadState* state = it->second;
+      if (state->profile.samples) {
+        profile->threads.push_back(ThreadProfile());
+        ThreadProfile& thread_profile = profile->threads.back();
+        thread_profile.thread_name = state->profile.thread_name;
+        thread_profile.thread_id = state->profile.thread_id;
+        thread_profile.samples = state->profile.samples;
+        thread_profile.nodes.swap(state->profile.nodes);
+        state->profile.samples = 0;
+        state->node_index.clear();
+      }
+      if (!state->registered) {
+        delete state;
+        threads_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  profile->modules.clear();
+  std::string proc_maps;
+  std::vector<MappedMemoryRegion> regions;
+  if (ReadProcMaps(&proc_maps) && ParseProcMaps(proc_maps, &regions)) {
+    for (size_t i = 0; i < regions.size(); ++i) {
+      if (regions[i].permissions & MappedMemoryRegion::EXECUTE)
+        profile->modules.push_back(regions[i]);
+    }
+  }
+}
+
+// static
+scoped_ptr<DictionaryValue> SamplingProfiler::ProfileToValue(
+    const Profile& profile) {
+  scoped_ptr<DictionaryValue> value(new DictionaryValue);
+  value->SetDouble("duration_ms", profile.duration.InMillisecondsF());
+
+  ListValue* modules = new ListValue;
+  for (size_t i = 0; i < profile.modules.size(); ++i) {
+    const MappedMemoryRegion& region = profile.modules[i];
+    DictionaryValue* module = new DictionaryValue;
+    module->SetString("path", region.path);
+    module->SetString("start", StringPrintf("%" PRIxPTR, region.start));
+    module->SetString("end", StringPrintf("%" PRIxPTR, region.end));
+    module->SetString("offset", StringPrintf("%llx", region.offset));
+    modules->Append(module);
+  }
+  value->Set("modules", modules);
+
+  // Nodes are [parent, address, self samples] triples.
+  ListValue* threads = new ListValue;
+  for (size_t i = 0; i < profile.threads.size(); ++i) {
+    const ThreadProfile& thread_profile = profile.threads[i];
+    DictionaryValue* thread = new DictionaryValue;
+    thread->SetString("name", thread_profile.thread_name);
+    thread->SetInteger("thread_id", thread_profile.thread_id);
+    thread->SetInteger("samples", thread_profile.samples);
+    ListValue* nodes = new ListValue;
+    for (size_t j = 0; j < thread_profile.nodes.size(); ++j) {
+      const Node& node = thread_profile.nodes[j];
+      ListValue* node_value = new ListValue;
+      node_value->AppendInteger(node.parent);
+      node_value->AppendString(StringPrintf("%" PRIxPTR, node.address));
+      node_value->AppendInteger(node.self_samples);
+      nodes->Append(node_value);
+    }
+    thread->Set("nodes", nodes);
+    threads->Append(thread);
+  }
+  value->Set("threads", threads);
+  return value.Pass();
+}
+
+void SamplingProfiler::SampleThread(PlatformThreadId thread_id) {
+  subtle::Atomic32 sequence =
+      subtle::NoBarrier_AtomicIncrement(&g_sample.sequence, 1);
+  subtle::Release_Store(&g_sample.thread_id, thread_id);
+  if (syscall(__NR_tgkill, getpid(), thread_id, kSampleSignal)) {
+    DPLOG(WARNING) << "tgkill";
+    subtle::Release_Store(&g_sample.thread_id, kInvalidThreadId);
+    return;
+  }
+
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_nsec += kSampleTimeoutMs * Time::kMicrosecondsPerMillisecond *
+                      Time::kNanosecondsPerMicrosecond;
+  deadline.tv_sec += deadline.tv_nsec / Time::kNanosecondsPerSecond;
+  deadline.tv_nsec %= Time::kNanosecondsPerSecond;
+  while (true) {
+    if (sem_timedwait(&g_sample_done, &deadline) == 0) {
+      // Skip the posts of handlers that ran too late for earlier samples.
+      if (subtle::Acquire_Load(&g_sample.done_sequence) == sequence)
+        break;
+    } else if (errno != EINTR) {
+      // The thread is stuck with signals blocked, or went away.  Should its
+      // handler still run, it notices that it is no longer being sampled.
+      subtle::Release_Store(&g_sample.thread_id, kInvalidThreadId);
+      return;
+    }
+  }
+  subtle::Release_Store(&g_sample.thread_id, kInvalidThreadId);
+  AddSample(thread_id, g_sample.frames, g_sample.frame_count);
+}
+
+void SamplingProfiler::AddSample(PlatformThreadId thread_id,
+                                 const uintptr_t* frames,
+                                 size_t count) {
+  AutoLock auto_lock(lock_);
+  std::map<PlatformThreadId, ThreadState*>::iterator it =
+      threads_.find(thread_id);
+  if (it == threads_.end())
+    return;
+  ThreadState* state = it->second;
+  ++state->profile.samples;
+
+  // Walk down from the outermost frame.
+  int parent = -1;
+  for (size_t i = count; i > 0; --i) {
+    std::pair<int, uintptr_t> key(parent, frames[i - 1]);
+    std::map<std::pair<int, uintptr_t>, int>::iterator node =
+        state->node_index.find(key);
+    if (node == state->node_index.end()) {
+      Node new_node = { frames[i - 1], parent, 0 };
+      state->profile.nodes.push_back(new_node);
+      node = state->node_index.insert(
+          std::make_pair(key, state->profile.nodes.size() - 1)).first;
+    }
+    parent = node->second;
+  }
+  if (parent >= 0)
+    ++state->profile.nodes[parent].self_samples;
+}
+
+void SamplingProfiler::GetRegisteredThreads(
+    std::vector<PlatformThreadId>* thread_ids) {
+  thread_ids->clear();
+  AutoLock auto_lock(lock_);
+  for (std::map<PlatformThreadId, ThreadState*>::const_iterator it =
+           threads_.begin(); it != threads_.end(); ++it) {
+    if (it->second->registered)
+      thread_ids->push_back(it->first);
+  }
+}
+
+}  // namespace debug
+}  // namespace base
@@ -0,0 +1,156 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_DEBUG_SAMPLING_PROFILER_LINUX_H_
+#define BASE_DEBUG_SAMPLING_PROFILER_LINUX_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/debug/proc_maps_linux.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+
+template <typename T> struct DefaultSingletonTraits;
+
+namespace base {
+
+class DictionaryValue;
+
+namespace debug {
+
+// A statistical CPU profiler for field builds.  Threads that want to be
+// profiled register themselves; while the profiler is running, a sampling
+// thread interrupts each of them with SIGPROF at a fixed interval, and the
+// signal handler records the thread's stack with StackTrace.  The stacks are
+// merged into a call tree per thread, of raw addresses, which are symbolized
+// offline with the executable mappings that come with the profile.
+//
+// The signal interrupts system calls that don't restart with SA_RESTART, such
+// as poll() and nanosleep(), which then fail with EINTR.  The profiler can't
+// be used together with the gperftools CPU profiler, which takes SIGPROF too.
+//
+//   SamplingProfiler::GetInstance()->RegisterCurrentThread("UI");
+//   SamplingProfiler::GetInstance()->Start(TimeDelta::FromMilliseconds(50));
+//   ...
+//   SamplingProfiler::Profile profile;
+//   SamplingProfiler::GetInstance()->TakeProfile(&profile);
+//   Upload(SamplingProfiler::ProfileToValue(profile));
+class BASE_EXPORT SamplingProfiler {
+ public:
+  // A frame of a call tree.
+  struct Node {
+    // The return address of the frame, or the interrupted instruction for the
+    // innermost frame.
+    uintptr_t address;
+
+    // Index of the caller in ThreadProfile::nodes, or -1 for the outermost
+    // frame.  Callers come before their callees.
+    int parent;
+
+    // Number of samples where this was the innermost frame.
+    int self_samples;
+  };
+
+  struct ThreadProfile {
+    ThreadProfile();
+    ~ThreadProfile();
+
+    std::string thread_name;
+    PlatformThreadId thread_id;
+    int samples;
+    std::vector<Node> nodes;
+  };
+
+  struct Profile {
+    Profile();
+    ~Profile();
+
+    // When collection of the samples started, and how long it went on for.
+    TimeTicks start_time;
+    TimeDelta duration;
+
+    std::vector<ThreadProfile> threads;
+
+    // The executable mappings of the process, to symbolize the addresses.
+    std::vector<MappedMemoryRegion> modules;
+  };
+
+  static SamplingProfiler* GetInstance();
+
+  // Starts sampling the calling thread, labelled |name|, whenever the
+  // profiler runs.  The thread must unregister before it exits.
+  void RegisterCurrentThread(const std::string& name);
+  void UnregisterCurrentThread();
+
+  // Starts sampling every registered thread once per |interval|.  Returns
+  // false if the profiler is already running, or the signal handler could not
+  // be installed.
+  bool Start(TimeDelta interval);
+
+  // Stops sampling, and waits for the sampling thread to exit.  The samples
+  // taken so far are kept for TakeProfile().
+  void Stop();
+
+  bool IsRunning() const;
+
+  // Moves the samples taken since the last call into |profile|.
+  void TakeProfile(Profile* profile);
+
+  // Converts |profile| to a compact form for upload, with the addresses as
+  // hex strings.
+  static scoped_ptr<DictionaryValue> ProfileToValue(const Profile& profile);
+
+ private:
+  friend struct DefaultSingletonTraits<SamplingProfiler>;
+
+  class SamplingThread;
+
+  // The call tree of a thread, and an index of its nodes by caller and
+  // address.
+  struct ThreadState {
+    ThreadState();
+    ~ThreadState();
+
+    ThreadProfile profile;
+    std::map<std::pair<int, uintptr_t>, int> node_index;
+    bool registered;
+  };
+
+  SamplingProfiler();
+  ~SamplingProfiler();
+
+  // Interrupts |thread_id| and records its stack.  Called on the sampling
+  // thread.
+  void SampleThread(PlatformThreadId thread_id);
+
+  // Adds a stack of |count| |frames|, innermost first, to the thread's tree.
+  void AddSample(PlatformThreadId thread_id,
+                 const uintptr_t* frames,
+                 size_t count);
+
+  // Returns the ids of the registered threads.
+  void GetRegisteredThreads(std::vector<PlatformThreadId>* thread_ids);
+
+  // Protects everything below.
+  mutable Lock lock_;
+
+  std::map<PlatformThreadId, ThreadState*> threads_;
+  TimeTicks start_time_;
+
+  scoped_ptr<SamplingThread> sampling_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingProfiler);
+};
+
+}  // namespace debug
+}  // namespace base
+
+#endif  // BASE_DEBUG_SAMPLING_PROFILER_LINUX_H_
@@ -0,0 +1,91 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/sampling_profiler_linux.h"
+
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+// Keeps the CPU busy while registered with the profiler, until stopped.
+class BusyThread : public PlatformThread::Delegate {
+ public:
+  BusyThread() : registered_(false, false), stop_(false, false) {}
+
+  virtual void ThreadMain() OVERRIDE {
+    SamplingProfiler::GetInstance()->RegisterCurrentThread("Busy");
+    registered_.Signal();
+    volatile int count = 0;
+    while (!stop_.IsSignaled())
+      ++count;
+    SamplingProfiler::GetInstance()->UnregisterCurrentThread();
+  }
+
+  WaitableEvent registered_;
+  WaitableEvent stop_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BusyThread);
+};
+
+}  // namespace
+
+TEST(SamplingProfilerTest, SamplesRegisteredThreads) {
+  SamplingProfiler* profiler = SamplingProfiler::GetInstance();
+  SamplingProfiler::Profile profile;
+  profiler->TakeProfile(&profile);
+
+  BusyThread busy_thread;
+  PlatformThreadHandle handle;
+  ASSERT_TRUE(PlatformThread::Create(0, &busy_thread, &handle));
+  busy_thread.registered_.Wait();
+
+  ASSERT_TRUE(profiler->Start(TimeDelta::FromMilliseconds(1)));
+  EXPECT_TRUE(profiler->IsRunning());
+  EXPECT_FALSE(profiler->Start(TimeDelta::FromMilliseconds(1)));
+  PlatformThread::Sleep(TimeDelta::FromMilliseconds(200));
+  profiler->Stop();
+  EXPECT_FALSE(profiler->IsRunning());
+
+  busy_thread.stop_.Signal();
+  PlatformThread::Join(handle);
+
+  profiler->TakeProfile(&profile);
+  EXPECT_LE(TimeDelta::FromMilliseconds(200), profile.duration);
+  EXPECT_FALSE(profile.modules.empty());
+  ASSERT_EQ(1u, profile.threads.size());
+  const SamplingProfiler::ThreadProfile& thread_profile = profile.threads[0];
+  EXPECT_EQ("Busy", thread_profile.thread_name);
+  EXPECT_LT(0, thread_profile.samples);
+  ASSERT_FALSE(thread_profile.nodes.empty());
+
+  // Every sample ends in a node, and callers come first.
+  int self_samples = 0;
+  for (size_t i = 0; i < thread_profile.nodes.size(); ++i) {
+    const SamplingProfiler::Node& node = thread_profile.nodes[i];
+    EXPECT_LT(node.parent, static_cast<int>(i));
+    EXPECT_NE(0u, node.address);
+    self_samples += node.self_samples;
+  }
+  EXPECT_EQ(thread_profile.samples, self_samples);
+
+  scoped_ptr<DictionaryValue> value =
+      SamplingProfiler::ProfileToValue(profile);
+  ListValue* threads = NULL;
+  ASSERT_TRUE(value->GetList("threads", &threads));
+  EXPECT_EQ(1u, threads->GetSize());
+
+  // The samples have been taken, and the thread is gone.
+  profiler->TakeProfile(&profile);
+  EXPECT_TRUE(profile.threads.empty());
+}
+
+}  // namespace debug
+}  // namespace base
@@ -0,0 +1,527 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/trace_event_binary.h"
+
+#include <string.h>
+
+#include "base/bind.h"
+#include "base/debug/trace_event.h"
+#include "base/format_macros.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+// Bits of the per-event |fields| byte.
+const unsigned char kHasThreadTimestamp = 1 << 0;
+
+void AppendVarint(uint64 value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendSignedVarint(int64 value, std::string* out) {
+  // Zigzag encoding keeps small negative numbers small.
+  uint64 zigzag = (static_cast<uint64>(value) << 1) ^
+                  static_cast<uint64>(value >> 63);
+  AppendVarint(zigzag, out);
+}
+
+void AppendInlineString(const char* str, size_t length, std::string* out) {
+  AppendVarint(length, out);
+  out->append(str, length);
+}
+
+}  // namespace
+
+const char TraceEventBinaryWriter::kMagic[] = "CrTB";
+
+TraceEventBinaryWriter::TraceEventBinaryWriter(int process_id)
+    : process_id_(process_id),
+      wrote_header_(false),
+      last_timestamp_(0),
+      next_string_id_(1) {
+}
+
+TraceEventBinaryWriter::~TraceEventBinaryWriter() {
+}
+
+void TraceEventBinaryWriter::AppendEvent(const TraceEvent& event,
+                                         std::string* out) {
+  if (!wrote_header_) {
+    out->append(kMagic, sizeof(kMagic) - 1);
+    AppendVarint(kVersion, out);
+    AppendSignedVarint(process_id_, out);
+    wrote_header_ = true;
+  }
+
+  // Strings have to be defined before the event record refers to them.
+  const bool copy = (event.flags_ & TRACE_EVENT_FLAG_COPY) != 0;
+  uint32 category_id = DefineCategory(event.category_group_enabled_, out);
+  if (!copy) {
+    DefineString(event.name_, out);
+    for (int i = 0; i < kTraceMaxNumArgs && event.arg_names_[i]; ++i) {
+      DefineString(event.arg_names_[i], out);
+      if (event.arg_types_[i] == TRACE_VALUE_TYPE_STRING &&
+          event.arg_values_[i].as_string) {
+        DefineString(event.arg_values_[i].as_string, out);
+      }
+    }
+  }
+
+  out->push_back(static_cast<char>(kEventRecord));
+  out->push_back(event.phase_);
+  out->push_back(static_cast<char>(event.flags_));
+  unsigned char fields = 0;
+  if (!event.thread_timestamp_.is_null())
+    fields |= kHasThreadTimestamp;
+  out->push_back(static_cast<char>(fields));
+
+  AppendVarint(category_id, out);
+  AppendStringRef(event.name_, copy, out);
+  AppendSignedVarint(event.thread_id_, out);
+
+  int64 timestamp = event.timestamp_.ToInternalValue();
+  AppendSignedVarint(timestamp - last_timestamp_, out);
+  last_timestamp_ = timestamp;
+
+  if (fields & kHasThreadTimestamp)
+    AppendSignedVarint(event.thread_timestamp_.ToInternalValue(), out);
+  if (event.phase_ == TRACE_EVENT_PHASE_COMPLETE) {
+    AppendSignedVarint(event.duration_.ToInternalValue(), out);
+    AppendSignedVarint(event.thread_duration_.ToInternalValue(), out);
+  }
+  if (event.flags_ & TRACE_EVENT_FLAG_HAS_ID)
+    AppendVarint(event.id_, out);
+
+  unsigned char num_args = 0;
+  while (num_args < kTraceMaxNumArgs && event.arg_names_[num_args])
+    ++num_args;
+  out->push_back(static_cast<char>(num_args));
+
+  for (int i = 0; i < num_args; ++i) {
+    AppendStringRef(event.arg_names_[i], copy, out);
+    unsigned char type = event.arg_types_[i];
+    out->push_back(static_cast<char>(type));
+    const TraceEvent::TraceValue& value = event.arg_values_[i];
+    switch (type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        out->push_back(value.as_bool ? 1 : 0);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        AppendVarint(value.as_uint, out);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        AppendSignedVarint(value.as_int, out);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        // Traces are read back on the machine that wrote them, or one with
+        // the same byte order, so the raw representation is good enough.
+        out->append(reinterpret_cast<const char*>(&value.as_double),
+                    sizeof(value.as_double));
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        AppendVarint(static_cast<uint64>(
+            reinterpret_cast<uintptr_t>(value.as_pointer)), out);
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        if (!value.as_string) {
+          // Matches what TraceEvent::AppendValueAsJSON() prints.
+          AppendStringRef("NULL", true, out);
+        } else {
+          AppendStringRef(value.as_string,
+                          copy || type == TRACE_VALUE_TYPE_COPY_STRING, out);
+        }
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        std::string json;
+        event.convertable_values_[i]->AppendAsTraceFormat(&json);
+        AppendInlineString(json.data(), json.size(), out);
+        break;
+      }
+      default:
+        NOTREACHED() << "Don't know how to encode this value";
+        break;
+    }
+  }
+}
+
+void TraceEventBinaryWriter::AppendStringRef(const char* str,
+                                             bool copy,
+                                             std::string* out) {
+  if (copy) {
+    AppendVarint(0, out);
+    AppendInlineString(str, strlen(str), out);
+    return;
+  }
+  hash_map<uintptr_t, uint32>::const_iterator it =
+      string_ids_.find(reinterpret_cast<uintptr_t>(str));
+  DCHECK(it != string_ids_.end());
+  AppendVarint(it->second, out);
+}
+
+uint32 TraceEventBinaryWriter::DefineCategory(
+    const unsigned char* category_group_enabled,
+    std::string* out) {
+  uintptr_t key = reinterpret_cast<uintptr_t>(category_group_enabled);
+  hash_map<uintptr_t, uint32>::const_iterator it = category_ids_.find(key);
+  if (it != category_ids_.end())
+    return it->second;
+  uint32 id = AppendStringRecord(
+      TraceLog::GetCategoryGroupName(category_group_enabled), out);
+  category_ids_[key] = id;
+  return id;
+}
+
+uint32 TraceEventBinaryWriter::DefineString(const char* str, std::string* out) {
+  uintptr_t key = reinterpret_cast<uintptr_t>(str);
+  hash_map<uintptr_t, uint32>::const_iterator it = string_ids_.find(key);
+  if (it != string_ids_.end())
+    return it->second;
+  uint32 id = AppendStringRecord(str, out);
+  string_ids_[key] = id;
+  return id;
+}
+
+uint32 TraceEventBinaryWriter::AppendStringRecord(const char* str,
+                                                  std::string* out) {
+  uint32 id = next_string_id_++;
+  out->push_back(static_cast<char>(kStringRecord));
+  AppendVarint(id, out);
+  AppendInlineString(str, strlen(str), out);
+  return id;
+}
+
+class TraceEventBinaryReader::Cursor {
+ public:
+  explicit Cursor(const std::string& data)
+      : pos_(data.data()),
+        end_(data.data() + data.size()) {
+  }
+
+  bool AtEnd() const { return pos_ == end_; }
+
+  bool ReadByte(unsigned char* value) {
+    if (pos_ == end_)
+      return false;
+    *value = static_cast<unsigned char>(*pos_++);
+    return true;
+  }
+
+  bool ReadVarint(uint64* value) {
+    uint64 result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      unsigned char byte;
+      if (!ReadByte(&byte))
+        return false;
+      result |= static_cast<uint64>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64* value) {
+    uint64 zigzag;
+    if (!ReadVarint(&zigzag))
+      return false;
+    *value = static_cast<int64>(zigzag >> 1) ^ -static_cast<int64>(zigzag & 1);
+    return true;
+  }
+
+  bool ReadBytes(size_t length, std::string* value) {
+    if (static_cast<size_t>(end_ - pos_) < length)
+      return false;
+    value->assign(pos_, length);
+    pos_ += length;
+    return true;
+  }
+
+  bool ReadInlineString(std::string* value) {
+    uint64 length;
+    return ReadVarint(&length) && ReadBytes(static_cast<size_t>(length), value);
+  }
+
+ private:
+  const char* pos_;
+  const char* end_;
+};
+
+TraceEventBinaryReader::TraceEventBinaryReader()
+    : read_header_(false),
+      failed_(false),
+      wrote_event_(false),
+      process_id_(0),
+      last_timestamp_(0),
+      // Id 0 means an inline string, so it is never defined.
+      strings_(1) {
+}
+
+TraceEventBinaryReader::~TraceEventBinaryReader() {
+}
+
+bool TraceEventBinaryReader::AppendAsJSON(const std::string& data,
+                                          std::string* json) {
+  if (failed_)
+    return false;
+
+  Cursor cursor(data);
+  if (!read_header_ && !cursor.AtEnd()) {
+    if (!ReadHeader(&cursor)) {
+      failed_ = true;
+      return false;
+    }
+    read_header_ = true;
+  }
+
+  while (!cursor.AtEnd()) {
+    unsigned char type;
+    bool ok = cursor.ReadByte(&type);
+    if (ok && type == TraceEventBinaryWriter::kStringRecord)
+      ok = ReadStringRecord(&cursor);
+    else if (ok && type == TraceEventBinaryWriter::kEventRecord)
+      ok = ReadEventRecord(&cursor, json);
+    else
+      ok = false;
+    if (!ok) {
+      failed_ = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TraceEventBinaryReader::ReadHeader(Cursor* cursor) {
+  std::string magic;
+  uint64 version;
+  int64 process_id;
+  if (!cursor->ReadBytes(sizeof(TraceEventBinaryWriter::kMagic) - 1, &magic) ||
+      magic != TraceEventBinaryWriter::kMagic ||
+      !cursor->ReadVarint(&version) ||
+      version != TraceEventBinaryWriter::kVersion ||
+      !cursor->ReadSignedVarint(&process_id)) {
+    return false;
+  }
+  process_id_ = static_cast<int>(process_id);
+  return true;
+}
+
+bool TraceEventBinaryReader::ReadStringRecord(Cursor* cursor) {
+  uint64 id;
+  std::string str;
+  // Ids are handed out sequentially, so each record defines the next one.
+  if (!cursor->ReadVarint(&id) || id != strings_.size() ||
+      !cursor->ReadInlineString(&str)) {
+    return false;
+  }
+  strings_.push_back(str);
+  return true;
+}
+
+bool TraceEventBinaryReader::ReadStringRef(Cursor* cursor, std::string* str) {
+  uint64 id;
+  if (!cursor->ReadVarint(&id))
+    return false;
+  if (id == 0)
+    return cursor->ReadInlineString(str);
+  if (id >= strings_.size())
+    return false;
+  *str = strings_[static_cast<size_t>(id)];
+  return true;
+}
+
+// Mirrors TraceEvent::AppendAsJSON(); the two must be kept in sync.
+bool TraceEventBinaryReader::ReadEventRecord(Cursor* cursor,
+                                             std::string* json) {
+  unsigned char phase;
+  unsigned char flags;
+  unsigned char fields;
+  uint64 category_id;
+  std::string name;
+  int64 thread_id;
+  int64 timestamp_delta;
+  if (!cursor->ReadByte(&phase) ||
+      !cursor->ReadByte(&flags) ||
+      !cursor->ReadByte(&fields) ||
+      !cursor->ReadVarint(&category_id) ||
+      category_id == 0 || category_id >= strings_.size() ||
+      !ReadStringRef(cursor, &name) ||
+      !cursor->ReadSignedVarint(&thread_id) ||
+      !cursor->ReadSignedVarint(&timestamp_delta)) {
+    return false;
+  }
+  last_timestamp_ += timestamp_delta;
+
+  int64 thread_timestamp = 0;
+  if ((fields & kHasThreadTimestamp) &&
+      !cursor->ReadSignedVarint(&thread_timestamp)) {
+    return false;
+  }
+  int64 duration = -1;
+  int64 thread_duration = -1;
+  if (phase == TRACE_EVENT_PHASE_COMPLETE &&
+      (!cursor->ReadSignedVarint(&duration) ||
+       !cursor->ReadSignedVarint(&thread_duration))) {
+    return false;
+  }
+  uint64 id = 0;
+  if ((flags & TRACE_EVENT_FLAG_HAS_ID) && !cursor->ReadVarint(&id))
+    return false;
+
+  unsigned char num_args;
+  if (!cursor->ReadByte(&num_args) || num_args > kTraceMaxNumArgs)
+    return false;
+
+  if (wrote_event_)
+    *json += ",";
+  wrote_event_ = true;
+
+  StringAppendF(json,
+      "{\"cat\":\"%s\",\"pid\":%i,\"tid\":%i,\"ts\":%" PRId64 ","
+      "\"ph\":\"%c\",\"name\":\"%s\",\"args\":{",
+      strings_[static_cast<size_t>(category_id)].c_str(),
+      process_id_,
+      static_cast<int>(thread_id),
+      last_timestamp_,
+      phase,
+      name.c_str());
+
+  for (int i = 0; i < num_args; ++i) {
+    std::string arg_name;
+    unsigned char type;
+    if (!ReadStringRef(cursor, &arg_name) || !cursor->ReadByte(&type))
+      return false;
+    if (i > 0)
+      *json += ",";
+    *json += "\"";
+    *json += arg_name;
+    *json += "\":";
+
+    TraceEvent::TraceValue value;
+    std::string str;
+    switch (type) {
+      case TRACE_VALUE_TYPE_BOOL: {
+        unsigned char byte;
+        if (!cursor->ReadByte(&byte))
+          return false;
+        value.as_bool = byte != 0;
+        break;
+      }
+      case TRACE_VALUE_TYPE_UINT: {
+        uint64 uint_value;
+        if (!cursor->ReadVarint(&uint_value))
+          return false;
+        value.as_uint = uint_value;
+        break;
+      }
+      case TRACE_VALUE_TYPE_INT: {
+        int64 int_value;
+        if (!cursor->ReadSignedVarint(&int_value))
+          return false;
+        value.as_int = int_value;
+        break;
+      }
+      case TRACE_VALUE_TYPE_DOUBLE:
+        if (!cursor->ReadBytes(sizeof(value.as_double), &str))
+          return false;
+        memcpy(&value.as_double, str.data(), sizeof(value.as_double));
+        break;
+      case TRACE_VALUE_TYPE_POINTER: {
+        uint64 pointer_value;
+        if (!cursor->ReadVarint(&pointer_value))
+          return false;
+        value.as_pointer =
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(
+                pointer_value));
+        break;
+      }
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        if (!ReadStringRef(cursor, &str))
+          return false;
+        value.as_string = str.c_str();
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE:
+        if (!cursor->ReadInlineString(&str))
+          return false;
+        *json += str;
+        continue;
+      default:
+        return false;
+    }
+    TraceEvent::AppendValueAsJSON(type, value, json);
+  }
+  *json += "}";
+
+  if (phase == TRACE_EVENT_PHASE_COMPLETE) {
+    if (duration != -1)
+      StringAppendF(json, ",\"dur\":%" PRId64, duration);
+    if ((fields & kHasThreadTimestamp) && thread_duration != -1)
+      StringAppendF(json, ",\"tdur\":%" PRId64, thread_duration);
+  }
+
+  if (fields & kHasThreadTimestamp)
+    StringAppendF(json, ",\"tts\":%" PRId64, thread_timestamp);
+
+  if (flags & TRACE_EVENT_FLAG_HAS_ID)
+    StringAppendF(json, ",\"id\":\"0x%" PRIx64 "\"", id);
+
+  if (phase == TRACE_EVENT_PHASE_INSTANT) {
+    char scope = '?';
+    switch (flags & TRACE_EVENT_FLAG_SCOPE_MASK) {
+      case TRACE_EVENT_SCOPE_GLOBAL:
+        scope = TRACE_EVENT_SCOPE_NAME_GLOBAL;
+        break;
+
+      case TRACE_EVENT_SCOPE_PROCESS:
+        scope = TRACE_EVENT_SCOPE_NAME_PROCESS;
+        break;
+
+      case TRACE_EVENT_SCOPE_THREAD:
+        scope = TRACE_EVENT_SCOPE_NAME_THREAD;
+        break;
+    }
+    StringAppendF(json, ",\"s\":\"%c\"", scope);
+  }
+
+  *json += "}";
+  return true;
+}
+
+TraceBinaryFileSink::TraceBinaryFileSink(File file)
+    : file_(file.Pass()),
+      succeeded_(file_.IsValid()) {
+}
+
+TraceBinaryFileSink::~TraceBinaryFileSink() {
+}
+
+TraceLog::OutputCallback TraceBinaryFileSink::GetCallback() {
+  return Bind(&TraceBinaryFileSink::OnTraceDataCollected, Unretained(this));
+}
+
+void TraceBinaryFileSink::OnTraceDataCollected(
+    const scoped_refptr<RefCountedString>& fragment,
+    bool has_more_events) {
+  if (!succeeded_ || fragment->data().empty())
+    return;
+  int size = static_cast<int>(fragment->data().size());
+  if (file_.WriteAtCurrentPos(fragment->data().data(), size) != size) {
+    DLOG(ERROR) << "Failed to write trace data";
+    succeeded_ = false;
+  }
+}
+
+}  // namespace debug
+}  // namespace base
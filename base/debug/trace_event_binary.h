@@ -0,0 +1,147 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_DEBUG_TRACE_EVENT_BINARY_H_
+#define BASE_DEBUG_TRACE_EVENT_BINARY_H_
+
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
+#include "base/debug/trace_event_impl.h"
+#include "base/files/file.h"
+
+namespace base {
+namespace debug {
+
+// TraceEventBinaryWriter encodes TraceEvents into a compact binary stream that
+// is much cheaper to produce than the JSON from TraceEvent::AppendAsJSON().
+// It replaces the JSON conversion when a trace is collected with
+// TraceLog::FlushAsBinary() and TraceEventBinaryReader turns the stream back
+// into JSON offline.
+//
+// The stream starts with a header and is followed by records:
+//
+//   Header := "CrTB" version:varint pid:svarint
+//   Record := kStringRecord id:varint length:varint bytes
+//           | kEventRecord Event
+//   Event  := phase:byte flags:byte fields:byte category:varint name:StringRef
+//             tid:svarint ts_delta:svarint [tts:svarint] [dur:svarint
+//             tdur:svarint] [id:varint] num_args:byte Arg*
+//   Arg    := name:StringRef type:byte value
+//
+// Integers are LEB128 varints, signed ones zigzag encoded first. Timestamps are
+// deltas from the previous event in the stream. Category groups, event names,
+// argument names and TRACE_VALUE_TYPE_STRING values are long-lived strings, so
+// they are interned by pointer: the first use emits a kStringRecord and every
+// later event refers to its id. A
+// StringRef is either such an id or 0 followed by an inline length and bytes,
+// which is used for copied strings that only live as long as their event.
+//
+// One writer must be used for a whole stream since interned ids are only
+// valid within the stream that defined them. Not thread safe.
+class BASE_EXPORT TraceEventBinaryWriter {
+ public:
+  enum RecordType {
+    kStringRecord = 1,
+    kEventRecord = 2,
+  };
+
+  static const char kMagic[];
+  static const int kVersion = 1;
+
+  explicit TraceEventBinaryWriter(int process_id);
+  ~TraceEventBinaryWriter();
+
+  // Appends the encoding of |event| to |out|. The stream header is emitted
+  // before the first event.
+  void AppendEvent(const TraceEvent& event, std::string* out);
+
+ private:
+  // Appends a reference to |str|, interning it by pointer unless |copy| is
+  // set.
+  void AppendStringRef(const char* str, bool copy, std::string* out);
+  // Return the id of the given string, emitting a kStringRecord for it first
+  // if this is its first use in the stream.
+  uint32 DefineCategory(const unsigned char* category_group_enabled,
+                        std::string* out);
+  uint32 DefineString(const char* str, std::string* out);
+  uint32 AppendStringRecord(const char* str, std::string* out);
+
+  int process_id_;
+  bool wrote_header_;
+  int64 last_timestamp_;
+  uint32 next_string_id_;
+  hash_map<uintptr_t, uint32> category_ids_;
+  hash_map<uintptr_t, uint32> string_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryWriter);
+};
+
+// Converts a stream produced by TraceEventBinaryWriter back into the comma
+// separated JSON events that TraceLog::Flush() would have produced. The
+// fragments of a flush may be fed in one by one as long as they are fed in
+// order; a record may not straddle two fragments.
+class BASE_EXPORT TraceEventBinaryReader {
+ public:
+  TraceEventBinaryReader();
+  ~TraceEventBinaryReader();
+
+  // Appends the JSON for every event in |data| to |json|. Returns false if
+  // |data| is malformed, in which case the reader can't be used any more.
+  bool AppendAsJSON(const std::string& data, std::string* json);
+
+ private:
+  class Cursor;
+
+  bool ReadHeader(Cursor* cursor);
+  bool ReadStringRecord(Cursor* cursor);
+  bool ReadEventRecord(Cursor* cursor, std::string* json);
+  bool ReadStringRef(Cursor* cursor, std::string* str);
+
+  bool read_header_;
+  bool failed_;
+  bool wrote_event_;
+  int process_id_;
+  int64 last_timestamp_;
+  std::vector<std::string> strings_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryReader);
+};
+
+// Writes every fragment of a binary flush to a file as it arrives, so a trace
+// goes to disk without being collected in memory first. Usage:
+//
+//   TraceBinaryFileSink sink(File(path, File::FLAG_CREATE_ALWAYS |
+//                                       File::FLAG_WRITE));
+//   TraceLog::GetInstance()->FlushAsBinary(sink.GetCallback());
+//
+// The sink must outlive the flush, i.e. until the callback has been run with
+// |has_more_events| false.
+class BASE_EXPORT TraceBinaryFileSink {
+ public:
+  explicit TraceBinaryFileSink(File file);
+  ~TraceBinaryFileSink();
+
+  TraceLog::OutputCallback GetCallback();
+
+  // Whether every fragment made it to the file so far.
+  bool succeeded() const { return succeeded_; }
+
+ private:
+  void OnTraceDataCollected(const scoped_refptr<RefCountedString>& fragment,
+                            bool has_more_events);
+
+  File file_;
+  bool succeeded_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceBinaryFileSink);
+};
+
+}  // namespace debug
+}  // namespace base
+
+#endif  // BASE_DEBUG_TRACE_EVENT_BINARY_H_
@@ -0,0 +1,178 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/trace_event_binary.h"
+
+#include <string.h>
+
+#include "base/debug/trace_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+class JSONArg : public ConvertableToTraceFormat {
+ public:
+  JSONArg() {}
+
+  virtual void AppendAsTraceFormat(std::string* out) const OVERRIDE {
+    out->append("{\"nested\":[1,2]}");
+  }
+
+ private:
+  virtual ~JSONArg() {}
+
+  DISALLOW_COPY_AND_ASSIGN(JSONArg);
+};
+
+class TraceEventBinaryTest : public testing::Test {
+ protected:
+  TraceEventBinaryTest()
+      : writer_(TraceLog::GetInstance()->process_id()),
+        category_(TraceLog::GetCategoryGroupEnabled("binary_test")),
+        num_events_(0) {
+  }
+
+  void InitializeEvent(TraceEvent* event,
+                       char phase,
+                       const char* name,
+                       int num_args,
+                       const char** arg_names,
+                       const unsigned char* arg_types,
+                       const unsigned long long* arg_values,
+                       unsigned char flags) {
+    scoped_refptr<ConvertableToTraceFormat> convertables[kTraceMaxNumArgs];
+    for (int i = 0; i < num_args; ++i) {
+      if (arg_types[i] == TRACE_VALUE_TYPE_CONVERTABLE)
+        convertables[i] = new JSONArg;
+    }
+    event->Initialize(42, TimeTicks::FromInternalValue(1000 + num_events_++),
+                      TimeTicks(), phase, category_, name, 0x1234, num_args,
+                      arg_names, arg_types, arg_values, convertables, flags);
+  }
+
+  // Encodes |event|, decodes it again and checks that the result matches the
+  // JSON TraceEvent would have written itself.
+  void ExpectRoundTrip(const TraceEvent& event) {
+    std::string binary;
+    writer_.AppendEvent(event, &binary);
+    std::string json;
+    ASSERT_TRUE(reader_.AppendAsJSON(binary, &json));
+
+    std::string expected;
+    if (num_events_ > 1)
+      expected += ",";
+    event.AppendAsJSON(&expected);
+    EXPECT_EQ(expected, json);
+  }
+
+  TraceEventBinaryWriter writer_;
+  TraceEventBinaryReader reader_;
+  const unsigned char* category_;
+  int num_events_;
+};
+
+}  // namespace
+
+TEST_F(TraceEventBinaryTest, RoundTripsAllArgumentTypes) {
+  const char* names[] = { "a", "b" };
+  TraceEvent::TraceValue value;
+
+  unsigned char types[][2] = {
+    { TRACE_VALUE_TYPE_BOOL, TRACE_VALUE_TYPE_UINT },
+    { TRACE_VALUE_TYPE_INT, TRACE_VALUE_TYPE_DOUBLE },
+    { TRACE_VALUE_TYPE_POINTER, TRACE_VALUE_TYPE_STRING },
+    { TRACE_VALUE_TYPE_COPY_STRING, TRACE_VALUE_TYPE_CONVERTABLE },
+  };
+  for (size_t i = 0; i < arraysize(types); ++i) {
+    unsigned long long values[2];
+    for (int j = 0; j < 2; ++j) {
+      switch (types[i][j]) {
+        case TRACE_VALUE_TYPE_INT:
+          value.as_int = -7;
+          break;
+        case TRACE_VALUE_TYPE_DOUBLE:
+          value.as_double = 0.25;
+          break;
+        case TRACE_VALUE_TYPE_POINTER:
+          value.as_pointer = this;
+          break;
+        case TRACE_VALUE_TYPE_STRING:
+        case TRACE_VALUE_TYPE_COPY_STRING:
+          value.as_string = "has \"quotes\"";
+          break;
+        default:
+          value.as_uint = 1;
+          break;
+      }
+      memcpy(&values[j], &value, sizeof(values[j]));
+    }
+    TraceEvent event;
+    InitializeEvent(&event, TRACE_EVENT_PHASE_INSTANT, "args", 2, names,
+                    types[i], values, TRACE_EVENT_SCOPE_THREAD);
+    ExpectRoundTrip(event);
+  }
+}
+
+TEST_F(TraceEventBinaryTest, RoundTripsPhasesAndFlags) {
+  const char* names[] = { "arg" };
+  unsigned char types[] = { TRACE_VALUE_TYPE_STRING };
+  TraceEvent::TraceValue value;
+  value.as_string = NULL;
+  unsigned long long values[1];
+  memcpy(&values[0], &value, sizeof(values[0]));
+
+  TraceEvent begin;
+  InitializeEvent(&begin, TRACE_EVENT_PHASE_BEGIN, "begin", 1, names, types,
+                  values, TRACE_EVENT_FLAG_NONE);
+  ExpectRoundTrip(begin);
+
+  TraceEvent copied;
+  InitializeEvent(&copied, TRACE_EVENT_PHASE_ASYNC_BEGIN, "copied", 1, names,
+                  types, values, TRACE_EVENT_FLAG_COPY |
+                  TRACE_EVENT_FLAG_HAS_ID);
+  ExpectRoundTrip(copied);
+
+  TraceEvent complete;
+  InitializeEvent(&complete, TRACE_EVENT_PHASE_COMPLETE, "complete", 0, NULL,
+                  NULL, NULL, TRACE_EVENT_FLAG_NONE);
+  complete.UpdateDuration(TimeTicks::FromInternalValue(5000), TimeTicks());
+  ExpectRoundTrip(complete);
+}
+
+TEST_F(TraceEventBinaryTest, InternsRepeatedStrings) {
+  TraceEvent event;
+  InitializeEvent(&event, TRACE_EVENT_PHASE_BEGIN, "a_fairly_long_event_name",
+                  0, NULL, NULL, NULL, TRACE_EVENT_FLAG_NONE);
+  std::string first;
+  writer_.AppendEvent(event, &first);
+  std::string second;
+  writer_.AppendEvent(event, &second);
+  EXPECT_NE(std::string::npos, first.find("a_fairly_long_event_name"));
+  EXPECT_EQ(std::string::npos, second.find("a_fairly_long_event_name"));
+  EXPECT_LT(second.size(), 16u);
+
+  std::string json;
+  EXPECT_TRUE(reader_.AppendAsJSON(first, &json));
+  EXPECT_TRUE(reader_.AppendAsJSON(second, &json));
+  std::string expected;
+  event.AppendAsJSON(&expected);
+  EXPECT_EQ(expected + "," + expected, json);
+}
+
+TEST_F(TraceEventBinaryTest, RejectsMalformedInput) {
+  std::string json;
+  EXPECT_FALSE(reader_.AppendAsJSON("not a trace", &json));
+  // The reader stays failed.
+  EXPECT_FALSE(reader_.AppendAsJSON(std::string(), &json));
+
+  TraceEventBinaryReader empty_reader;
+  EXPECT_TRUE(empty_reader.AppendAsJSON(std::string(), &json));
+  EXPECT_TRUE(json.empty());
+}
+
+}  // namespace debug
+}  // namespace base
@@ -11,6 +11,7 @@
 #include "base/command_line.h"
 #include "base/debug/leak_annotations.h"
 #include "base/debug/trace_event.h"
+#include "base/debug/trace_event_binary.h"
 #include "base/debug/trace_event_synthetic_delay.h"
 #include "base/float_util.h"
 #include "base/format_macros.h"
@@ -1138,6 +1139,7 @@ TraceLog::TraceLog()
       event_callback_category_filter_(
           CategoryFilter::kDefaultCategoryFilterString),
       thread_shared_chunk_index_(0),
+      flush_as_binary_(false),
       generation_(0) {
   // Trace is enabled or disabled on one thread while other threads are
   // accessing the enabled flag. We don't care whether edge-case events are
@@ -1547,6 +1549,15 @@ void TraceLog::SetEventCallbackDisabled() {
 //    If this is the last message loop, finish the flush;
 // 4. If any thread hasn't finish its flush in time, finish the flush.
 void TraceLog::Flush(const TraceLog::OutputCallback& cb) {
+  FlushInternal(cb, false);
+}
+
+void TraceLog::FlushAsBinary(const TraceLog::OutputCallback& cb) {
+  FlushInternal(cb, true);
+}
+
+void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
+                             bool as_binary) {
   if (IsEnabled()) {
     // Can't flush when tracing is enabled because otherwise PostTask would
     // - generate more trace events;
@@ -1566,6 +1577,7 @@ void TraceLog::Flush(const TraceLog::OutputCallback& cb) {
     flush_message_loop_proxy_ = MessageLoopProxy::current();
     DCHECK(!thread_message_loops_.size() || flush_message_loop_proxy_.get());
     flush_output_callback_ = cb;
+    flush_as_binary_ = as_binary;
 
     if (thread_shared_chunk_) {
       logged_events_->ReturnChunk(thread_shared_chunk_index_,
@@ -1593,11 +1605,18 @@ void TraceLog::Flush(const TraceLog::OutputCallback& cb) {
 
 void TraceLog::ConvertTraceEventsToTraceFormat(
     scoped_ptr<TraceBuffer> logged_events,
-    const TraceLog::OutputCallback& flush_output_callback) {
+    const TraceLog::OutputCallback& flush_output_callback,
+    bool as_binary) {
 
   if (flush_output_callback.is_null())
     return;
 
+  // The binary writer interns strings across the whole flush, so the same one
+  // has to be used for every batch.
+  scoped_ptr<TraceEventBinaryWriter> binary_writer;
+  if (as_binary)
+    binary_writer.reset(new TraceEventBinaryWriter(process_id()));
+
   // The callback need to be called at least once even if there is no events
   // to let the caller know the completion of flush.
   bool has_more_events = true;
@@ -1612,6 +1631,11 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
         break;
       }
       for (size_t j = 0; j < chunk->size(); ++j) {
+        if (binary_writer) {
+          binary_writer->AppendEvent(*chunk->GetEventAt(j),
+                                     &(json_events_str_ptr->data()));
+          continue;
+        }
         if (i > 0 || j > 0)
           json_events_str_ptr->data().append(",");
         chunk->GetEventAt(j)->AppendAsJSON(&(json_events_str_ptr->data()));
@@ -1625,6 +1649,7 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
 void TraceLog::FinishFlush(int generation) {
   scoped_ptr<TraceBuffer> previous_logged_events;
   OutputCallback flush_output_callback;
+  bool flush_as_binary;
 
   if (!CheckGeneration(generation))
     return;
@@ -1639,10 +1664,12 @@ void TraceLog::FinishFlush(int generation) {
     flush_message_loop_proxy_ = NULL;
     flush_output_callback = flush_output_callback_;
     flush_output_callback_.Reset();
+    flush_as_binary = flush_as_binary_;
   }
 
   ConvertTraceEventsToTraceFormat(previous_logged_events.Pass(),
-                                  flush_output_callback);
+                                  flush_output_callback,
+                                  flush_as_binary);
 }
 
 // Run in each thread holding a local event buffer.
@@ -1705,7 +1732,8 @@ void TraceLog::FlushButLeaveBufferIntact(
   }  // release lock
 
   ConvertTraceEventsToTraceFormat(previous_logged_events.Pass(),
-                                  flush_output_callback);
+                                  flush_output_callback,
+                                  false);
 }
 
 void TraceLog::UseNextTraceBuffer() {
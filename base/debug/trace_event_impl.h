@@ -176,6 +176,8 @@ class BASE_EXPORT TraceEvent {
   unsigned char flags_;
   unsigned char arg_types_[kTraceMaxNumArgs];
 
+  friend class TraceEventBinaryWriter;
+
   DISALLOW_COPY_AND_ASSIGN(TraceEvent);
 };
 
@@ -495,6 +497,10 @@ class BASE_EXPORT TraceLog {
   typedef base::Callback<void(const scoped_refptr<base::RefCountedString>&,
                               bool has_more_events)> OutputCallback;
   void Flush(const OutputCallback& cb);
+  // Like Flush(), but the callback receives the compact binary encoding from
+  // TraceEventBinaryWriter, which is considerably cheaper to produce than
+  // JSON. Use TraceEventBinaryReader to convert it to JSON later on.
+  void FlushAsBinary(const OutputCallback& cb);
   void FlushButLeaveBufferIntact(const OutputCallback& flush_output_callback);
 
   // Called by TRACE_EVENT* macros, don't call this directly.
@@ -647,8 +653,10 @@ class BASE_EXPORT TraceLog {
   // |generation| is used in the following callbacks to check if the callback
   // is called for the flush of the current |logged_events_|.
   void FlushCurrentThread(int generation);
+  void FlushInternal(const OutputCallback& cb, bool as_binary);
   void ConvertTraceEventsToTraceFormat(scoped_ptr<TraceBuffer> logged_events,
-      const TraceLog::OutputCallback& flush_output_callback);
+      const TraceLog::OutputCallback& flush_output_callback,
+      bool as_binary);
   void FinishFlush(int generation);
   void OnFlushTimeout(int generation);
 
@@ -728,6 +736,7 @@ class BASE_EXPORT TraceLog {
 
   // Set when asynchronous Flush is in progress.
   OutputCallback flush_output_callback_;
+  bool flush_as_binary_;
   scoped_refptr<MessageLoopProxy> flush_message_loop_proxy_;
   subtle::AtomicWord generation_;
 
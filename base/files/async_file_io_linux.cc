@@ -0,0 +1,222 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file_io_linux.h"
+
+#include <errno.h>
+#include <linux/aio_abi.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+
+namespace base {
+
+namespace {
+
+// glibc has no wrappers for the AIO system calls, and libaio is not worth a
+// dependency for four of them.
+int IoSetup(int max_events, aio_context_t* context) {
+  return syscall(__NR_io_setup, max_events, context);
+}
+
+int IoDestroy(aio_context_t context) {
+  return syscall(__NR_io_destroy, context);
+}
+
+int IoSubmit(aio_context_t context, long count, struct iocb** iocbs) {
+  return syscall(__NR_io_submit, context, count, iocbs);
+}
+
+int IoGetEvents(aio_context_t context,
+                long min_count,
+                long max_count,
+                struct io_event* events,
+                struct timespec* timeout) {
+  return syscall(__NR_io_getevents, context, min_count, max_count, events,
+                 timeout);
+}
+
+// How many completions are reaped per io_getevents() call.
+const int kEventBatchSize = 32;
+
+}  // namespace
+
+struct AsyncFileIO::Operation {
+  struct iocb iocb;
+  CompletionCallback callback;
+};
+
+// static
+AsyncFileIO::Operation* AsyncFileIO::OperationFromEvent(
+    const struct io_event& event) {
+  return reinterpret_cast<Operation*>(static_cast<uintptr_t>(event.data));
+}
+
+// static
+scoped_ptr<AsyncFileIO> AsyncFileIO::Create(int max_operations) {
+  DCHECK_GT(max_operations, 0);
+  aio_context_t context = 0;
+  if (IoSetup(max_operations, &context)) {
+    DPLOG(WARNING) << "io_setup";
+    return scoped_ptr<AsyncFileIO>();
+  }
+  int event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (event_fd < 0) {
+    DPLOG(WARNING) << "eventfd";
+    IoDestroy(context);
+    return scoped_ptr<AsyncFileIO>();
+  }
+
+  scoped_ptr<AsyncFileIO> async_file_io(
+      new AsyncFileIO(context, event_fd, max_operations));
+  if (!MessageLoopForIO::current()->WatchFileDescriptor(
+          event_fd, true, MessageLoopForIO::WATCH_READ,
+          &async_file_io->event_fd_watcher_, async_file_io.get())) {
+    return scoped_ptr<AsyncFileIO>();
+  }
+  return async_file_io.Pass();
+}
+
+AsyncFileIO::AsyncFileIO(uint64 context, int event_fd, int max_operations)
+    : context_(context),
+      event_fd_(event_fd),
+      max_operations_(max_operations),
+      pending_operations_(0),
+      weak_factory_(this) {
+}
+
+AsyncFileIO::~AsyncFileIO() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  event_fd_watcher_.StopWatchingFileDescriptor();
+
+  // The kernel may still write to the buffers of operations in flight.
+  struct io_event events[kEventBatchSize];
+  while (pending_operations_ > 0) {
+    int count = HANDLE_EINTR(
+        IoGetEvents(context_, 1, kEventBatchSize, events, NULL));
+    if (count < 0) {
+      DPLOG(ERROR) << "io_getevents";
+      break;
+    }
+    for (int i = 0; i < count; ++i)
+      delete OperationFromEvent(events[i]);
+    pending_operations_ -= count;
+  }
+
+  // Also waits for whatever is still in flight, should io_getevents() have
+  // failed.
+  if (IoDestroy(context_))
+    DPLOG(ERROR) << "io_destroy";
+  if (IGNORE_EINTR(close(event_fd_)))
+    DPLOG(ERROR) << "close";
+}
+
+bool AsyncFileIO::Read(File* file,
+                       int64 offset,
+                       char* data,
+                       int size,
+                       const CompletionCallback& callback) {
+  return Submit(file, IOCB_CMD_PREAD, offset, data, size, callback);
+}
+
+bool AsyncFileIO::Write(File* file,
+                        int64 offset,
+                        const char* data,
+                        int size,
+                        const CompletionCallback& callback) {
+  return Submit(file, IOCB_CMD_PWRITE, offset, data, size, callback);
+}
+
+bool AsyncFileIO::Submit(File* file,
+                         uint16 opcode,
+                         int64 offset,
+                         const char* data,
+                         int size,
+                         const CompletionCallback& callback) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(file->IsValid());
+  DCHECK_GE(offset, 0);
+  DCHECK_GE(size, 0);
+  DCHECK(!callback.is_null());
+  if (pending_operations_ >= max_operations_)
+    return false;
+
+  Operation* operation = new Operation;
+  memset(&operation->iocb, 0, sizeof(operation->iocb));
+  operation->iocb.aio_data = reinterpret_cast<uintptr_t>(operation);
+  operation->iocb.aio_lio_opcode = opcode;
+  operation->iocb.aio_fildes = file->GetPlatformFile();
+  operation->iocb.aio_buf = reinterpret_cast<uintptr_t>(data);
+  operation->iocb.aio_nbytes = size;
+  operation->iocb.aio_offset = offset;
+  operation->iocb.aio_flags = IOCB_FLAG_RESFD;
+  operation->iocb.aio_resfd = event_fd_;
+  operation->callback = callback;
+
+  struct iocb* iocbs[] = { &operation->iocb };
+  if (HANDLE_EINTR(IoSubmit(context_, 1, iocbs)) != 1) {
+    DPLOG(WARNING) << "io_submit";
+    delete operation;
+    return false;
+  }
+  ++pending_operations_;
+  return true;
+}
+
+void AsyncFileIO::OnFileCanReadWithoutBlocking(int fd) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_EQ(event_fd_, fd);
+
+  // Reset the eventfd before reaping, so that completions that come in
+  // meanwhile signal it again.
+  uint64 completions;
+  if (HANDLE_EINTR(read(event_fd_, &completions, sizeof(completions))) < 0 &&
+      errno != EAGAIN) {
+    DPLOG(ERROR) << "read";
+  }
+
+  WeakPtr<AsyncFileIO> self = weak_factory_.GetWeakPtr();
+  struct io_event events[kEventBatchSize];
+  int count;
+  do {
+    struct timespec no_wait = { 0, 0 };
+    count = HANDLE_EINTR(
+        IoGetEvents(context_, 0, kEventBatchSize, events, &no_wait));
+    if (count < 0) {
+      DPLOG(ERROR) << "io_getevents";
+      return;
+    }
+    pending_operations_ -= count;
+
+    // Take the callbacks out first, as running one may delete |this|, and the
+    // other operations then need to be freed all the same.
+    std::vector<std::pair<CompletionCallback, int> > completed;
+    for (int i = 0; i < count; ++i) {
+      Operation* operation = OperationFromEvent(events[i]);
+      completed.push_back(std::make_pair(operation->callback,
+                                         static_cast<int>(events[i].res)));
+      delete operation;
+    }
+    for (size_t i = 0; i < completed.size(); ++i) {
+      completed[i].first.Run(completed[i].second);
+      if (!self.get())
+        return;
+    }
+  } while (count == kEventBatchSize);
+}
+
+void AsyncFileIO::OnFileCanWriteWithoutBlocking(int fd) {
+  NOTREACHED();
+}
+
+}  // namespace base
@@ -0,0 +1,108 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_ASYNC_FILE_IO_LINUX_H_
+#define BASE_FILES_ASYNC_FILE_IO_LINUX_H_
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/threading/thread_checker.h"
+
+struct io_event;
+
+namespace base {
+
+class File;
+
+// Reads and writes files with Linux kernel AIO (io_submit()), and runs the
+// completion callbacks on the thread's MessageLoopForIO, which learns about
+// completions through an eventfd.  Unlike posting blocking read() and write()
+// calls to worker threads, any number of operations can be in flight without
+// tying up a thread each.
+//
+// The kernel only performs operations asynchronously on files opened with
+// O_DIRECT, with |data|, |offset| and |size| aligned to the logical block size
+// of the disk (512 bytes, or 4096 to be safe).  Other operations are still
+// carried out correctly, but Read() and Write() then block until they are
+// done, like the corresponding File methods.
+//
+// An AsyncFileIO must be created and used on a thread with a
+// MessageLoopForIO.
+class BASE_EXPORT AsyncFileIO : public MessageLoopForIO::Watcher {
+ public:
+  // Receives the number of bytes read or written, or a negative errno.
+  typedef Callback<void(int)> CompletionCallback;
+
+  // Returns NULL if the kernel doesn't support AIO, or has no room for
+  // another |max_operations| concurrent operations, in which case callers
+  // should fall back to blocking I/O on a worker thread.
+  static scoped_ptr<AsyncFileIO> Create(int max_operations);
+
+  // Waits for the operations in flight to finish, without running their
+  // callbacks.
+  virtual ~AsyncFileIO();
+
+  // Starts reading up to |size| bytes at |offset| of |file| into |data|, or
+  // writing |size| bytes of |data| there.  |file| and |data| must remain
+  // valid until |callback| is run, which is never synchronous.  Returns false
+  // if the operation could not be started, such as when |max_operations| are
+  // already in flight or |file| wasn't opened for it, in which case
+  // |callback| is not run.
+  bool Read(File* file,
+            int64 offset,
+            char* data,
+            int size,
+            const CompletionCallback& callback);
+  bool Write(File* file,
+             int64 offset,
+             const char* data,
+             int size,
+             const CompletionCallback& callback);
+
+  int pending_operations() const { return pending_operations_; }
+
+ private:
+  struct Operation;
+
+  AsyncFileIO(uint64 context, int event_fd, int max_operations);
+
+  // Returns the operation that |event| reports the completion of.
+  static Operation* OperationFromEvent(const struct io_event& event);
+
+  bool Submit(File* file,
+              uint16 opcode,
+              int64 offset,
+              const char* data,
+              int size,
+              const CompletionCallback& callback);
+
+  // MessageLoopForIO::Watcher implementation.
+  virtual void OnFileCanReadWithoutBlocking(int fd) OVERRIDE;
+  virtual void OnFileCanWriteWithoutBlocking(int fd) OVERRIDE;
+
+  // The kernel's aio_context_t.
+  const uint64 context_;
+
+  // Signaled by the kernel as operations complete.
+  const int event_fd_;
+  MessageLoopForIO::FileDescriptorWatcher event_fd_watcher_;
+
+  const int max_operations_;
+  int pending_operations_;
+
+  ThreadChecker thread_checker_;
+
+  // Callbacks may delete |this|.
+  WeakPtrFactory<AsyncFileIO> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncFileIO);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_ASYNC_FILE_IO_LINUX_H_
@@ -0,0 +1,164 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file_io_linux.h"
+
+#include <errno.h>
+#include <sys/mman.h>
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const int kBlockSize = 4096;
+
+class AsyncFileIOTest : public testing::Test {
+ protected:
+  AsyncFileIOTest() : message_loop_(MessageLoop::TYPE_IO) {}
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    file_.Initialize(temp_dir_.path().AppendASCII("file"),
+                     File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE);
+    ASSERT_TRUE(file_.IsValid());
+    async_file_io_ = AsyncFileIO::Create(4);
+  }
+
+  // Runs the message loop until |count| operations completed, and returns
+  // the result of the last one.
+  int WaitForResults(int count) {
+    results_.clear();
+    while (static_cast<int>(results_.size()) < count) {
+      RunLoop run_loop;
+      quit_closure_ = run_loop.QuitClosure();
+      run_loop.Run();
+    }
+    return results_.back();
+  }
+
+  AsyncFileIO::CompletionCallback callback() {
+    return Bind(&AsyncFileIOTest::OnComplete, Unretained(this));
+  }
+
+  MessageLoop message_loop_;
+  ScopedTempDir temp_dir_;
+  File file_;
+  scoped_ptr<AsyncFileIO> async_file_io_;
+  std::vector<int> results_;
+
+ private:
+  void OnComplete(int result) {
+    results_.push_back(result);
+    quit_closure_.Run();
+  }
+
+  Closure quit_closure_;
+};
+
+void NotReached(int result) {
+  ADD_FAILURE() << "completed with " << result;
+}
+
+}  // namespace
+
+TEST_F(AsyncFileIOTest, WriteAndRead) {
+  if (!async_file_io_)
+    return;  // Not supported by this kernel.
+
+  std::string first(kBlockSize, 'a');
+  std::string second(kBlockSize, 'b');
+  ASSERT_TRUE(async_file_io_->Write(&file_, 0, first.data(), first.size(),
+                                    callback()));
+  ASSERT_TRUE(async_file_io_->Write(&file_, kBlockSize, second.data(),
+                                    second.size(), callback()));
+  EXPECT_EQ(2, async_file_io_->pending_operations());
+  WaitForResults(2);
+  EXPECT_EQ(kBlockSize, results_[0]);
+  EXPECT_EQ(kBlockSize, results_[1]);
+  EXPECT_EQ(0, async_file_io_->pending_operations());
+
+  std::string data(2 * kBlockSize, 0);
+  ASSERT_TRUE(async_file_io_->Read(&file_, 0, &data[0], data.size(),
+                                   callback()));
+  EXPECT_EQ(2 * kBlockSize, WaitForResults(1));
+  EXPECT_EQ(first + second, data);
+
+  // Short and empty reads at the end of the file.
+  ASSERT_TRUE(async_file_io_->Read(&file_, kBlockSize + 10, &data[0],
+                                   data.size(), callback()));
+  EXPECT_EQ(kBlockSize - 10, WaitForResults(1));
+  ASSERT_TRUE(async_file_io_->Read(&file_, 2 * kBlockSize, &data[0],
+                                   data.size(), callback()));
+  EXPECT_EQ(0, WaitForResults(1));
+}
+
+TEST_F(AsyncFileIOTest, Errors) {
+  if (!async_file_io_)
+    return;
+
+  // The kernel checks the file's mode before starting an operation.
+  File read_only(temp_dir_.path().AppendASCII("file"),
+                 File::FLAG_OPEN | File::FLAG_READ);
+  ASSERT_TRUE(read_only.IsValid());
+  const char kData[] = "data";
+  EXPECT_FALSE(async_file_io_->Write(&read_only, 0, kData, sizeof(kData),
+                                     Bind(&NotReached)));
+  EXPECT_EQ(0, async_file_io_->pending_operations());
+
+  // But it only finds out about a bad buffer while carrying out the read.
+  ASSERT_EQ(static_cast<int>(sizeof(kData)),
+            file_.Write(0, kData, sizeof(kData)));
+  void* unmapped = mmap(NULL, kBlockSize, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(MAP_FAILED, unmapped);
+  ASSERT_EQ(0, munmap(unmapped, kBlockSize));
+  ASSERT_TRUE(async_file_io_->Read(&file_, 0, static_cast<char*>(unmapped),
+                                   sizeof(kData), callback()));
+  EXPECT_EQ(-EFAULT, WaitForResults(1));
+}
+
+TEST_F(AsyncFileIOTest, MaxOperations) {
+  if (!async_file_io_)
+    return;
+
+  char data[4][16];
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(async_file_io_->Read(&file_, 0, data[i], sizeof(data[i]),
+                                     callback()));
+  }
+  char more[16];
+  EXPECT_FALSE(async_file_io_->Read(&file_, 0, more, sizeof(more),
+                                    callback()));
+  WaitForResults(4);
+  EXPECT_TRUE(async_file_io_->Read(&file_, 0, more, sizeof(more),
+                                   callback()));
+  WaitForResults(1);
+}
+
+TEST_F(AsyncFileIOTest, DeleteWithOperationsInFlight) {
+  if (!async_file_io_)
+    return;
+
+  std::string data(kBlockSize, 'c');
+  ASSERT_TRUE(async_file_io_->Write(&file_, 0, data.data(), data.size(),
+                                    Bind(&NotReached)));
+  async_file_io_.reset();
+  RunLoop().RunUntilIdle();
+
+  std::string read(kBlockSize, 0);
+  EXPECT_EQ(kBlockSize, file_.Read(0, &read[0], kBlockSize));
+  EXPECT_EQ(data, read);
+}
+
+}  // namespace base
@@ -49,8 +49,32 @@ void LogFailure(const FilePath& path, TempFileFailure failure_code,
                  << " : " << message;
 }
 
+void SerializeAndWriteFileAtomically(
+    const FilePath& path,
+    const ImportantFileWriter::DataSerializer::BackgroundSerializer&
+        serializer) {
+  std::string data;
+  if (!serializer.Run(&data)) {
+    DLOG(WARNING) << "failed to serialize data to be saved in "
+                  << path.value().c_str();
+    return;
+  }
+  // The data only exists once serialized, so this is WriteNow()'s size check
+  // for the scheduled writes that serialize on the task runner.
+  if (data.length() > static_cast<size_t>(kint32max)) {
+    NOTREACHED();
+    return;
+  }
+  ImportantFileWriter::WriteFileAtomically(path, data);
+}
+
 }  // namespace
 
+ImportantFileWriter::DataSerializer::BackgroundSerializer
+ImportantFileWriter::DataSerializer::GetBackgroundSerializer() {
+  return BackgroundSerializer();
+}
+
 // static
 bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
                                               const std::string& data) {
@@ -154,6 +178,22 @@ void ImportantFileWriter::ScheduleWrite(DataSerializer* serializer) {
 
 void ImportantFileWriter::DoScheduledWrite() {
   DCHECK(serializer_);
+  DataSerializer::BackgroundSerializer background_serializer =
+      serializer_->GetBackgroundSerializer();
+  if (!background_serializer.is_null()) {
+    timer_.Stop();
+    serializer_ = NULL;
+    if (!task_runner_->PostTask(
+            FROM_HERE,
+            MakeCriticalClosure(Bind(&SerializeAndWriteFileAtomically,
+                                     path_, background_serializer)))) {
+      // As in WriteNow(), rather block than lose the data.
+      NOTREACHED();
+      SerializeAndWriteFileAtomically(path_, background_serializer);
+    }
+    return;
+  }
+
   std::string data;
   if (serializer_->SerializeData(&data)) {
     WriteNow(data);
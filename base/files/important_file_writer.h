@@ -9,6 +9,7 @@
 
 #include "base/base_export.h"
 #include "base/basictypes.h"
+#include "base/callback.h"
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/threading/non_thread_safe.h"
@@ -42,11 +43,21 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   // to also batch data serializations.
   class BASE_EXPORT DataSerializer {
    public:
+    // Serializes a snapshot of the data on the writer's task runner.
+    typedef Callback<bool(std::string* data)> BackgroundSerializer;
+
     // Should put serialized string in |data| and return true on successful
     // serialization. Will be called on the same thread on which
     // ImportantFileWriter has been created.
     virtual bool SerializeData(std::string* data) = 0;
 
+    // Called instead of SerializeData() by scheduled writes, on the same
+    // thread. Data that is slow to serialize can return a callback bound to a
+    // snapshot of it, which is then serialized on the task runner right before
+    // being written. The default returns a null callback, to serialize with
+    // SerializeData() on this thread.
+    virtual BackgroundSerializer GetBackgroundSerializer();
+
    protected:
     virtual ~DataSerializer() {}
   };
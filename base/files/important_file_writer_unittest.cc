@@ -4,6 +4,7 @@
 
 #include "base/files/important_file_writer.h"
 
+#include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/file_util.h"
 #include "base/files/file_path.h"
@@ -41,6 +42,30 @@ class DataSerializer : public ImportantFileWriter::DataSerializer {
   const std::string data_;
 };
 
+bool AssignData(const std::string& data, std::string* output) {
+  output->assign(data);
+  return true;
+}
+
+// Only provides its data through GetBackgroundSerializer().
+class BackgroundDataSerializer : public ImportantFileWriter::DataSerializer {
+ public:
+  explicit BackgroundDataSerializer(const std::string& data) : data_(data) {
+  }
+
+  virtual bool SerializeData(std::string* output) OVERRIDE {
+    ADD_FAILURE() << "Serialized on the writer's thread";
+    return false;
+  }
+
+  virtual BackgroundSerializer GetBackgroundSerializer() OVERRIDE {
+    return Bind(&AssignData, data_);
+  }
+
+ private:
+  const std::string data_;
+};
+
 }  // namespace
 
 class ImportantFileWriterTest : public testing::Test {
@@ -103,6 +128,17 @@ TEST_F(ImportantFileWriterTest, DoScheduledWrite) {
   EXPECT_EQ("foo", GetFileContent(writer.path()));
 }
 
+TEST_F(ImportantFileWriterTest, BackgroundSerializer) {
+  ImportantFileWriter writer(file_, MessageLoopProxy::current().get());
+  BackgroundDataSerializer serializer("foo");
+  writer.ScheduleWrite(&serializer);
+  writer.DoScheduledWrite();
+  EXPECT_FALSE(writer.HasPendingWrite());
+  RunLoop().RunUntilIdle();
+  ASSERT_TRUE(PathExists(writer.path()));
+  EXPECT_EQ("foo", GetFileContent(writer.path()));
+}
+
 TEST_F(ImportantFileWriterTest, BatchingWrites) {
   ImportantFileWriter writer(file_, MessageLoopProxy::current().get());
   writer.set_commit_interval(TimeDelta::FromMilliseconds(25));
@@ -0,0 +1,103 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_event_handler.h"
+
+#include "base/logging.h"
+#include "base/values.h"
+
+namespace base {
+
+JSONValueBuilder::JSONValueBuilder() {
+}
+
+JSONValueBuilder::~JSONValueBuilder() {
+}
+
+bool JSONValueBuilder::IsComplete() const {
+  return root_.get() && open_containers_.empty();
+}
+
+scoped_ptr<Value> JSONValueBuilder::PassValue() {
+  DCHECK(IsComplete());
+  return root_.Pass();
+}
+
+bool JSONValueBuilder::OnObjectBegin() {
+  DictionaryValue* dictionary = new DictionaryValue;
+  if (!AddValue(dictionary))
+    return false;
+  open_containers_.push_back(dictionary);
+  return true;
+}
+
+bool JSONValueBuilder::OnObjectKey(const StringPiece& key) {
+  DCHECK(!open_containers_.empty());
+  DCHECK(open_containers_.back()->IsType(Value::TYPE_DICTIONARY));
+  key.CopyToString(&pending_key_);
+  return true;
+}
+
+bool JSONValueBuilder::OnObjectEnd() {
+  DCHECK(!open_containers_.empty());
+  open_containers_.pop_back();
+  return true;
+}
+
+bool JSONValueBuilder::OnArrayBegin() {
+  ListValue* list = new ListValue;
+  if (!AddValue(list))
+    return false;
+  open_containers_.push_back(list);
+  return true;
+}
+
+bool JSONValueBuilder::OnArrayEnd() {
+  DCHECK(!open_containers_.empty());
+  open_containers_.pop_back();
+  return true;
+}
+
+bool JSONValueBuilder::OnString(const StringPiece& value) {
+  return AddValue(new StringValue(value.as_string()));
+}
+
+bool JSONValueBuilder::OnInteger(int value) {
+  return AddValue(new FundamentalValue(value));
+}
+
+bool JSONValueBuilder::OnDouble(double value) {
+  return AddValue(new FundamentalValue(value));
+}
+
+bool JSONValueBuilder::OnBoolean(bool value) {
+  return AddValue(new FundamentalValue(value));
+}
+
+bool JSONValueBuilder::OnNull() {
+  return AddValue(Value::CreateNullValue());
+}
+
+bool JSONValueBuilder::AddValue(Value* value) {
+  if (open_containers_.empty()) {
+    if (root_.get()) {
+      // A second root value.
+      delete value;
+      return false;
+    }
+    root_.reset(value);
+    return true;
+  }
+
+  Value* container = open_containers_.back();
+  if (container->IsType(Value::TYPE_DICTIONARY)) {
+    static_cast<DictionaryValue*>(container)->SetWithoutPathExpansion(
+        pending_key_, value);
+  } else {
+    static_cast<ListValue*>(container)->Append(value);
+  }
+  return true;
+}
+
+}  // namespace base
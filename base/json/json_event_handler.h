@@ -0,0 +1,93 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_JSON_JSON_EVENT_HANDLER_H_
+#define BASE_JSON_JSON_EVENT_HANDLER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+
+class Value;
+
+// JSONEventHandler receives the contents of a JSON document one token at a
+// time from JSONReader::ParseWithHandler(), without a Value tree ever being
+// built. This is useful for large inputs of which only a part is needed, or
+// for decoding straight into C++ structures.
+//
+// Objects produce OnObjectBegin(), then an OnObjectKey() before each member's
+// value, then OnObjectEnd(); arrays produce OnArrayBegin(), their elements and
+// OnArrayEnd(). StringPiece arguments are only valid for the duration of the
+// call. Returning false from any method stops parsing, and the reader reports
+// JSON_ABORTED_BY_HANDLER.
+class BASE_EXPORT JSONEventHandler {
+ public:
+  virtual bool OnObjectBegin() = 0;
+  virtual bool OnObjectKey(const StringPiece& key) = 0;
+  virtual bool OnObjectEnd() = 0;
+  virtual bool OnArrayBegin() = 0;
+  virtual bool OnArrayEnd() = 0;
+  virtual bool OnString(const StringPiece& value) = 0;
+  virtual bool OnInteger(int value) = 0;
+  virtual bool OnDouble(double value) = 0;
+  virtual bool OnBoolean(bool value) = 0;
+  virtual bool OnNull() = 0;
+
+ protected:
+  virtual ~JSONEventHandler() {}
+};
+
+// A JSONEventHandler that builds the same Value tree JSONReader::Read() would
+// have returned, with JSON_DETACHABLE_CHILDREN semantics. It can also be fed
+// just the events of a single value inside a larger document.
+class BASE_EXPORT JSONValueBuilder : public JSONEventHandler {
+ public:
+  JSONValueBuilder();
+  virtual ~JSONValueBuilder();
+
+  // Returns true once a complete value has been received.
+  bool IsComplete() const;
+
+  // Returns the built value and resets the builder. Must only be called when
+  // IsComplete() is true.
+  scoped_ptr<Value> PassValue();
+
+  // JSONEventHandler implementation:
+  virtual bool OnObjectBegin() OVERRIDE;
+  virtual bool OnObjectKey(const StringPiece& key) OVERRIDE;
+  virtual bool OnObjectEnd() OVERRIDE;
+  virtual bool OnArrayBegin() OVERRIDE;
+  virtual bool OnArrayEnd() OVERRIDE;
+  virtual bool OnString(const StringPiece& value) OVERRIDE;
+  virtual bool OnInteger(int value) OVERRIDE;
+  virtual bool OnDouble(double value) OVERRIDE;
+  virtual bool OnBoolean(bool value) OVERRIDE;
+  virtual bool OnNull() OVERRIDE;
+
+ private:
+  // Adds |value| to the innermost open container, or makes it the root.
+  // Takes ownership of |value|.
+  bool AddValue(Value* value);
+
+  scoped_ptr<Value> root_;
+
+  // Open containers, innermost last. Weak; they are owned by |root_|.
+  std::vector<Value*> open_containers_;
+
+  // The key of the next member of the innermost open object.
+  std::string pending_key_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSONValueBuilder);
+};
+
+}  // namespace base
+
+#endif  // BASE_JSON_JSON_EVENT_HANDLER_H_
@@ -5,6 +5,7 @@
 #include "base/json/json_parser.h"
 
 #include "base/float_util.h"
+#include "base/json/json_event_handler.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/strings/string_number_conversions.h"
@@ -14,6 +15,7 @@
 #include "base/strings/utf_string_conversion_utils.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/third_party/icu/icu_utf.h"
+#include "base/value_arena.h"
 #include "base/values.h"
 
 namespace base {
@@ -193,6 +195,8 @@ JSONParser::JSONParser(int options)
       stack_depth_(0),
       line_number_(0),
       index_last_line_(0),
+      handler_(NULL),
+      arena_(NULL),
       error_code_(JSONReader::JSON_NO_ERROR),
       error_line_(0),
       error_column_(0) {
@@ -201,6 +205,13 @@ JSONParser::JSONParser(int options)
 JSONParser::~JSONParser() {
 }
 
+void JSONParser::set_arena(ValueArena* arena) {
+  arena_ = arena;
+  // Hidden roots and JSONStringValues come from the heap.
+  if (arena_)
+    options_ |= JSON_DETACHABLE_CHILDREN;
+}
+
 Value* JSONParser::Parse(const StringPiece& input) {
   scoped_ptr<std::string> input_copy;
   // If the children of a JSON root can be detached, then hidden roots cannot
@@ -212,38 +223,15 @@ Value* JSONParser::Parse(const StringPiece& input) {
   } else {
     start_pos_ = input.data();
   }
-  pos_ = start_pos_;
-  end_pos_ = start_pos_ + input.length();
-  index_ = 0;
-  line_number_ = 1;
-  index_last_line_ = 0;
-
-  error_code_ = JSONReader::JSON_NO_ERROR;
-  error_line_ = 0;
-  error_column_ = 0;
-
-  // When the input JSON string starts with a UTF-8 Byte-Order-Mark
-  // <0xEF 0xBB 0xBF>, advance the start position to avoid the
-  // ParseNextToken function mis-treating a Unicode BOM as an invalid
-  // character and returning NULL.
-  if (CanConsume(3) && static_cast<uint8>(*pos_) == 0xEF &&
-      static_cast<uint8>(*(pos_ + 1)) == 0xBB &&
-      static_cast<uint8>(*(pos_ + 2)) == 0xBF) {
-    NextNChars(3);
-  }
+  StartParsing(start_pos_, input.length());
 
   // Parse the first and any nested tokens.
   scoped_ptr<Value> root(ParseNextToken());
   if (!root.get())
     return NULL;
 
-  // Make sure the input stream is at an end.
-  if (GetNextToken() != T_END_OF_INPUT) {
-    if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
-      ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
-      return NULL;
-    }
-  }
+  if (!ConsumeEndOfInput())
+    return NULL;
 
   // Dictionaries and lists can contain JSONStringValues, so wrap them in a
   // hidden root.
@@ -264,6 +252,17 @@ Value* JSONParser::Parse(const StringPiece& input) {
   return root.release();
 }
 
+bool JSONParser::ParseWithHandler(const StringPiece& input,
+                                  JSONEventHandler* handler) {
+  DCHECK(handler);
+  StartParsing(input.data(), input.length());
+
+  handler_ = handler;
+  bool result = EmitToken(GetNextToken()) && ConsumeEndOfInput();
+  handler_ = NULL;
+  return result;
+}
+
 JSONReader::JsonParseError JSONParser::error_code() const {
   return error_code_;
 }
@@ -336,6 +335,40 @@ const std::string& JSONParser::StringBuilder::AsString() {
 
 // JSONParser private //////////////////////////////////////////////////////////
 
+void JSONParser::StartParsing(const char* input, size_t length) {
+  start_pos_ = input;
+  pos_ = start_pos_;
+  end_pos_ = start_pos_ + length;
+  index_ = 0;
+  line_number_ = 1;
+  index_last_line_ = 0;
+
+  error_code_ = JSONReader::JSON_NO_ERROR;
+  error_line_ = 0;
+  error_column_ = 0;
+
+  // When the input JSON string starts with a UTF-8 Byte-Order-Mark
+  // <0xEF 0xBB 0xBF>, advance the start position to avoid the
+  // ParseNextToken function mis-treating a Unicode BOM as an invalid
+  // character and returning NULL.
+  if (CanConsume(3) && static_cast<uint8>(*pos_) == 0xEF &&
+      static_cast<uint8>(*(pos_ + 1)) == 0xBB &&
+      static_cast<uint8>(*(pos_ + 2)) == 0xBF) {
+    NextNChars(3);
+  }
+}
+
+bool JSONParser::ConsumeEndOfInput() {
+  // Make sure the input stream is at an end.
+  if (GetNextToken() != T_END_OF_INPUT) {
+    if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
+      ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+      return false;
+    }
+  }
+  return true;
+}
+
 inline bool JSONParser::CanConsume(int length) {
   return pos_ + length <= end_pos_;
 }
@@ -489,7 +522,8 @@ Value* JSONParser::ConsumeDictionary() {
     return NULL;
   }
 
-  scoped_ptr<DictionaryValue> dict(new DictionaryValue);
+  scoped_ptr<DictionaryValue> dict(
+      arena_ ? arena_->NewDictionary() : new DictionaryValue);
 
   NextChar();
   Token token = GetNextToken();
@@ -553,7 +587,7 @@ Value* JSONParser::ConsumeList() {
     return NULL;
   }
 
-  scoped_ptr<ListValue> list(new ListValue);
+  scoped_ptr<ListValue> list(arena_ ? arena_->NewList() : new ListValue);
 
   NextChar();
   Token token = GetNextToken();
@@ -596,6 +630,8 @@ Value* JSONParser::ConsumeString() {
   } else {
     if (string.CanBeStringPiece())
       string.Convert();
+    if (arena_)
+      return arena_->NewString(string.AsString());
     return new StringValue(string.AsString());
   }
 }
@@ -804,6 +840,26 @@ void JSONParser::DecodeUTF8(const int32& point, StringBuilder* dest) {
 }
 
 Value* JSONParser::ConsumeNumber() {
+  StringPiece num_string;
+  if (!ConsumeNumberRaw(&num_string))
+    return NULL;
+
+  int num_int;
+  if (StringToInt(num_string, &num_int))
+    return arena_ ? arena_->NewInteger(num_int) : new FundamentalValue(num_int);
+
+  double num_double;
+  if (base::StringToDouble(num_string.as_string(), &num_double) &&
+      IsFinite(num_double)) {
+    if (arena_)
+      return arena_->NewDouble(num_double);
+    return new FundamentalValue(num_double);
+  }
+
+  return NULL;
+}
+
+bool JSONParser::ConsumeNumberRaw(StringPiece* num_string) {
   const char* num_start = pos_;
   const int start_index = index_;
   int end_index = start_index;
@@ -813,7 +869,7 @@ Value* JSONParser::ConsumeNumber() {
 
   if (!ReadInt(false)) {
     ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-    return NULL;
+    return false;
   }
   end_index = index_;
 
@@ -821,12 +877,12 @@ Value* JSONParser::ConsumeNumber() {
   if (*pos_ == '.') {
     if (!CanConsume(1)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -838,7 +894,7 @@ Value* JSONParser::ConsumeNumber() {
       NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -858,25 +914,14 @@ Value* JSONParser::ConsumeNumber() {
       break;
     default:
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
   }
 
   pos_ = exit_pos;
   index_ = exit_index;
 
-  StringPiece num_string(num_start, end_index - start_index);
-
-  int num_int;
-  if (StringToInt(num_string, &num_int))
-    return new FundamentalValue(num_int);
-
-  double num_double;
-  if (base::StringToDouble(num_string.as_string(), &num_double) &&
-      IsFinite(num_double)) {
-    return new FundamentalValue(num_double);
-  }
-
-  return NULL;
+  num_string->set(num_start, end_index - start_index);
+  return true;
 }
 
 bool JSONParser::ReadInt(bool allow_leading_zeros) {
@@ -900,45 +945,208 @@ bool JSONParser::ReadInt(bool allow_leading_zeros) {
 
 Value* JSONParser::ConsumeLiteral() {
   switch (*pos_) {
-    case 't': {
-      const char* kTrueLiteral = "true";
-      const int kTrueLen = static_cast<int>(strlen(kTrueLiteral));
-      if (!CanConsume(kTrueLen - 1) ||
-          !StringsAreEqual(pos_, kTrueLiteral, kTrueLen)) {
-        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+    case 't':
+      if (!ConsumeLiteralRaw("true"))
         return NULL;
-      }
-      NextNChars(kTrueLen - 1);
-      return new FundamentalValue(true);
-    }
-    case 'f': {
-      const char* kFalseLiteral = "false";
-      const int kFalseLen = static_cast<int>(strlen(kFalseLiteral));
-      if (!CanConsume(kFalseLen - 1) ||
-          !StringsAreEqual(pos_, kFalseLiteral, kFalseLen)) {
-        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return arena_ ? arena_->NewBoolean(true) : new FundamentalValue(true);
+    case 'f':
+      if (!ConsumeLiteralRaw("false"))
+        return NULL;
+      return arena_ ? arena_->NewBoolean(false) : new FundamentalValue(false);
+    case 'n':
+      if (!ConsumeLiteralRaw("null"))
         return NULL;
+      return arena_ ? arena_->NewNull() : Value::CreateNullValue();
+    default:
+      ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+      return NULL;
+  }
+}
+
+bool JSONParser::ConsumeLiteralRaw(const char* literal) {
+  const int literal_len = static_cast<int>(strlen(literal));
+  if (!CanConsume(literal_len - 1) ||
+      !StringsAreEqual(pos_, literal, literal_len)) {
+    ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+    return false;
+  }
+  NextNChars(literal_len - 1);
+  return true;
+}
+
+bool JSONParser::EmitToken(Token token) {
+  switch (token) {
+    case T_OBJECT_BEGIN:
+      return EmitDictionary();
+    case T_ARRAY_BEGIN:
+      return EmitList();
+    case T_STRING:
+      return EmitString();
+    case T_NUMBER:
+      return EmitNumber();
+    case T_BOOL_TRUE:
+    case T_BOOL_FALSE:
+    case T_NULL:
+      return EmitLiteral();
+    default:
+      ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+      return false;
+  }
+}
+
+bool JSONParser::EmitDictionary() {
+  if (*pos_ != '{') {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+
+  StackMarker depth_check(&stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
+    return false;
+  }
+
+  if (!CheckHandlerResult(handler_->OnObjectBegin()))
+    return false;
+
+  NextChar();
+  Token token = GetNextToken();
+  while (token != T_OBJECT_END) {
+    if (token != T_STRING) {
+      ReportError(JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
+      return false;
+    }
+
+    StringBuilder key;
+    if (!ConsumeStringRaw(&key))
+      return false;
+    if (!CheckHandlerResult(handler_->OnObjectKey(
+            key.CanBeStringPiece() ? key.AsStringPiece() :
+                                     StringPiece(key.AsString())))) {
+      return false;
+    }
+
+    NextChar();
+    token = GetNextToken();
+    if (token != T_OBJECT_PAIR_SEPARATOR) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+
+    NextChar();
+    if (!EmitToken(GetNextToken()))
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      NextChar();
+      token = GetNextToken();
+      if (token == T_OBJECT_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
       }
-      NextNChars(kFalseLen - 1);
-      return new FundamentalValue(false);
+    } else if (token != T_OBJECT_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
+      return false;
     }
-    case 'n': {
-      const char* kNullLiteral = "null";
-      const int kNullLen = static_cast<int>(strlen(kNullLiteral));
-      if (!CanConsume(kNullLen - 1) ||
-          !StringsAreEqual(pos_, kNullLiteral, kNullLen)) {
-        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+  }
+
+  return CheckHandlerResult(handler_->OnObjectEnd());
+}
+
+bool JSONParser::EmitList() {
+  if (*pos_ != '[') {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+
+  StackMarker depth_check(&stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
+    return false;
+  }
+
+  if (!CheckHandlerResult(handler_->OnArrayBegin()))
+    return false;
+
+  NextChar();
+  Token token = GetNextToken();
+  while (token != T_ARRAY_END) {
+    if (!EmitToken(token))
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      NextChar();
+      token = GetNextToken();
+      if (token == T_ARRAY_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
       }
-      NextNChars(kNullLen - 1);
-      return Value::CreateNullValue();
+    } else if (token != T_ARRAY_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
     }
+  }
+
+  return CheckHandlerResult(handler_->OnArrayEnd());
+}
+
+bool JSONParser::EmitString() {
+  StringBuilder string;
+  if (!ConsumeStringRaw(&string))
+    return false;
+
+  // Strings without escapes are handed out as pieces of the input.
+  return CheckHandlerResult(handler_->OnString(
+      string.CanBeStringPiece() ? string.AsStringPiece() :
+                                  StringPiece(string.AsString())));
+}
+
+bool JSONParser::EmitNumber() {
+  StringPiece num_string;
+  if (!ConsumeNumberRaw(&num_string))
+    return false;
+
+  int num_int;
+  if (StringToInt(num_string, &num_int))
+    return CheckHandlerResult(handler_->OnInteger(num_int));
+
+  double num_double;
+  if (base::StringToDouble(num_string.as_string(), &num_double) &&
+      IsFinite(num_double)) {
+    return CheckHandlerResult(handler_->OnDouble(num_double));
+  }
+
+  ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
+  return false;
+}
+
+bool JSONParser::EmitLiteral() {
+  switch (*pos_) {
+    case 't':
+      return ConsumeLiteralRaw("true") &&
+          CheckHandlerResult(handler_->OnBoolean(true));
+    case 'f':
+      return ConsumeLiteralRaw("false") &&
+          CheckHandlerResult(handler_->OnBoolean(false));
+    case 'n':
+      return ConsumeLiteralRaw("null") &&
+          CheckHandlerResult(handler_->OnNull());
     default:
       ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
-      return NULL;
+      return false;
   }
 }
 
+bool JSONParser::CheckHandlerResult(bool handler_result) {
+  if (!handler_result)
+    ReportError(JSONReader::JSON_ABORTED_BY_HANDLER, 0);
+  return handler_result;
+}
+
 // static
 bool JSONParser::StringsAreEqual(const char* one, const char* two, size_t len) {
   return strncmp(one, two, len) == 0;
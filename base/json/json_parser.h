@@ -18,7 +18,9 @@
 #endif
 
 namespace base {
+class JSONEventHandler;
 class Value;
+class ValueArena;
 }
 
 #if defined(OS_CHROMEOS)
@@ -62,10 +64,19 @@ class BASE_EXPORT_PRIVATE JSONParser {
   explicit JSONParser(int options);
   ~JSONParser();
 
+  // Makes Parse() allocate the Values it returns from |arena|, see
+  // value_arena.h. Implies JSON_DETACHABLE_CHILDREN.
+  void set_arena(ValueArena* arena);
+
   // Parses the input string according to the set options and returns the
   // result as a Value owned by the caller.
   Value* Parse(const StringPiece& input);
 
+  // Parses the input string according to the set options, reporting its
+  // contents to |handler| instead of building a Value. The input is not
+  // copied. Returns false on failure, including when |handler| asked to stop.
+  bool ParseWithHandler(const StringPiece& input, JSONEventHandler* handler);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -143,6 +154,13 @@ class BASE_EXPORT_PRIVATE JSONParser {
     std::string* string_;
   };
 
+  // Winds the parser to the start of |input|, skipping a UTF-8 byte order
+  // mark, and clears any previous error.
+  void StartParsing(const char* input, size_t length);
+
+  // Makes sure nothing but whitespace and comments follow the root value.
+  bool ConsumeEndOfInput();
+
   // Quick check that the stream has capacity to consume |length| more bytes.
   bool CanConsume(int length);
 
@@ -202,6 +220,9 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // Assuming that the parser is wound to the start of a valid JSON number,
   // this parses and converts it to either an int or double value.
   Value* ConsumeNumber();
+  // Helper for ConsumeNumber() that validates the number and places its text
+  // in |num_string|. Returns false on failure with error information set.
+  bool ConsumeNumberRaw(StringPiece* num_string);
   // Helper that reads characters that are ints. Returns true if a number was
   // read and false on error.
   bool ReadInt(bool allow_leading_zeros);
@@ -209,6 +230,23 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // Consumes the literal values of |true|, |false|, and |null|, assuming the
   // parser is wound to the first character of any of those.
   Value* ConsumeLiteral();
+  // Helper for ConsumeLiteral() that consumes |literal|, which the input must
+  // match. Returns false on failure with error information set.
+  bool ConsumeLiteralRaw(const char* literal);
+
+  // Counterparts of ParseToken() and the Consume functions above that report
+  // to |handler_| instead of returning Values. All return false on failure
+  // with error information set; the Consume invariant is the same.
+  bool EmitToken(Token token);
+  bool EmitDictionary();
+  bool EmitList();
+  bool EmitString();
+  bool EmitNumber();
+  bool EmitLiteral();
+
+  // Passes through |handler_result|, recording JSON_ABORTED_BY_HANDLER if the
+  // handler asked to stop.
+  bool CheckHandlerResult(bool handler_result);
 
   // Compares two string buffers of a given length.
   static bool StringsAreEqual(const char* left, const char* right, size_t len);
@@ -248,6 +286,12 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // The last value of |index_| on the previous line.
   int index_last_line_;
 
+  // The handler given to ParseWithHandler(), NULL otherwise. Weak.
+  JSONEventHandler* handler_;
+
+  // Where Parse() allocates Values from, or NULL for the heap.
+  ValueArena* arena_;
+
   // Error information.
   JSONReader::JsonParseError error_code_;
   int error_line_;
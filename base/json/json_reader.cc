@@ -29,6 +29,8 @@ const char* JSONReader::kUnsupportedEncoding =
     "Unsupported encoding. JSON must be UTF-8.";
 const char* JSONReader::kUnquotedDictionaryKey =
     "Dictionary keys must be quoted.";
+const char* JSONReader::kAbortedByHandler =
+    "Parsing was stopped by the event handler.";
 
 JSONReader::JSONReader()
     : parser_(new internal::JSONParser(JSON_PARSE_RFC)) {
@@ -72,6 +74,15 @@ Value* JSONReader::ReadAndReturnError(const StringPiece& json,
   return NULL;
 }
 
+// static
+Value* JSONReader::ReadInArena(const StringPiece& json,
+                               int options,
+                               ValueArena* arena) {
+  internal::JSONParser parser(options);
+  parser.set_arena(arena);
+  return parser.Parse(json);
+}
+
 // static
 std::string JSONReader::ErrorCodeToString(JsonParseError error_code) {
   switch (error_code) {
@@ -93,6 +104,8 @@ std::string JSONReader::ErrorCodeToString(JsonParseError error_code) {
       return kUnsupportedEncoding;
     case JSON_UNQUOTED_DICTIONARY_KEY:
       return kUnquotedDictionaryKey;
+    case JSON_ABORTED_BY_HANDLER:
+      return kAbortedByHandler;
     default:
       NOTREACHED();
       return std::string();
@@ -103,6 +116,11 @@ Value* JSONReader::ReadToValue(const std::string& json) {
   return parser_->Parse(json);
 }
 
+bool JSONReader::ParseWithHandler(const StringPiece& json,
+                                  JSONEventHandler* handler) {
+  return parser_->ParseWithHandler(json, handler);
+}
+
 JSONReader::JsonParseError JSONReader::error_code() const {
   return parser_->error_code();
 }
@@ -36,7 +36,9 @@
 #include "base/strings/string_piece.h"
 
 namespace base {
+class JSONEventHandler;
 class Value;
+class ValueArena;
 
 namespace internal {
 class JSONParser;
@@ -73,6 +75,7 @@ class BASE_EXPORT JSONReader {
     JSON_UNEXPECTED_DATA_AFTER_ROOT,
     JSON_UNSUPPORTED_ENCODING,
     JSON_UNQUOTED_DICTIONARY_KEY,
+    JSON_ABORTED_BY_HANDLER,
     JSON_PARSE_ERROR_COUNT
   };
 
@@ -85,6 +88,7 @@ class BASE_EXPORT JSONReader {
   static const char* kUnexpectedDataAfterRoot;
   static const char* kUnsupportedEncoding;
   static const char* kUnquotedDictionaryKey;
+  static const char* kAbortedByHandler;
 
   // Constructs a reader with the default options, JSON_PARSE_RFC.
   JSONReader();
@@ -112,6 +116,13 @@ class BASE_EXPORT JSONReader {
                                    int* error_code_out,
                                    std::string* error_msg_out);
 
+  // Reads and parses |json| like Read(), but allocates the returned Value and
+  // all of its children from |arena|. They must all be destroyed before
+  // |arena| is, see value_arena.h. Implies JSON_DETACHABLE_CHILDREN.
+  static Value* ReadInArena(const StringPiece& json,
+                            int options,  // JSONParserOptions
+                            ValueArena* arena);
+
   // Converts a JSON parse error code into a human readable message.
   // Returns an empty string if error_code is JSON_NO_ERROR.
   static std::string ErrorCodeToString(JsonParseError error_code);
@@ -119,8 +130,13 @@ class BASE_EXPORT JSONReader {
   // Parses an input string into a Value that is owned by the caller.
   Value* ReadToValue(const std::string& json);
 
-  // Returns the error code if the last call to ReadToValue() failed.
-  // Returns JSON_NO_ERROR otherwise.
+  // Parses |json| and reports its contents to |handler| as it goes, without
+  // building a Value tree. See json_event_handler.h. Returns false if |json|
+  // is not properly formed or |handler| stopped the parse.
+  bool ParseWithHandler(const StringPiece& json, JSONEventHandler* handler);
+
+  // Returns the error code if the last call to ReadToValue() or
+  // ParseWithHandler() failed. Returns JSON_NO_ERROR otherwise.
   JsonParseError error_code() const;
 
   // Converts error_code_ to a human-readable string, including line and column
@@ -6,6 +6,7 @@
 
 #include "base/base_paths.h"
 #include "base/file_util.h"
+#include "base/json/json_event_handler.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/path_service.h"
@@ -653,4 +654,79 @@ TEST(JSONReaderTest, IllegalTrailingNull) {
   EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
 }
 
+TEST(JSONReaderTest, ParseWithHandlerMatchesRead) {
+  const char* json[] = {
+      "{\"a\": [1, 2.5, -3e2, true, false, null], \"b\": {\"c\": \"d\"}}",
+      "[\"esc\\u00e9aped\\n\", {}, [], [[]]]",
+      "\"just a string\"",
+      "  42  ",
+      "\xEF\xBB\xBF{\"bom\": 1}",
+      "{\"k\": 1} // trailing comment",
+  };
+
+  for (size_t i = 0; i < arraysize(json); ++i) {
+    scoped_ptr<Value> expected(JSONReader::Read(json[i]));
+    ASSERT_TRUE(expected.get()) << json[i];
+
+    JSONReader reader;
+    JSONValueBuilder builder;
+    EXPECT_TRUE(reader.ParseWithHandler(json[i], &builder)) << json[i];
+    EXPECT_EQ(JSONReader::JSON_NO_ERROR, reader.error_code());
+    ASSERT_TRUE(builder.IsComplete());
+    scoped_ptr<Value> value = builder.PassValue();
+    EXPECT_TRUE(expected->Equals(value.get())) << json[i];
+  }
+}
+
+TEST(JSONReaderTest, ParseWithHandlerErrors) {
+  JSONReader reader;
+  JSONValueBuilder builder;
+  EXPECT_FALSE(reader.ParseWithHandler("[1, 2,]", &builder));
+  EXPECT_EQ(JSONReader::JSON_TRAILING_COMMA, reader.error_code());
+
+  JSONValueBuilder builder2;
+  EXPECT_FALSE(reader.ParseWithHandler("{\"a\": 1} x", &builder2));
+  EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
+}
+
+namespace {
+
+// Counts the values it sees and stops after |limit| of them.
+class CountingHandler : public JSONEventHandler {
+ public:
+  explicit CountingHandler(int limit) : limit_(limit), count_(0) {}
+  virtual ~CountingHandler() {}
+
+  int count() const { return count_; }
+
+  virtual bool OnObjectBegin() OVERRIDE { return true; }
+  virtual bool OnObjectKey(const StringPiece& key) OVERRIDE { return true; }
+  virtual bool OnObjectEnd() OVERRIDE { return true; }
+  virtual bool OnArrayBegin() OVERRIDE { return true; }
+  virtual bool OnArrayEnd() OVERRIDE { return true; }
+  virtual bool OnString(const StringPiece& value) OVERRIDE { return Count(); }
+  virtual bool OnInteger(int value) OVERRIDE { return Count(); }
+  virtual bool OnDouble(double value) OVERRIDE { return Count(); }
+  virtual bool OnBoolean(bool value) OVERRIDE { return Count(); }
+  virtual bool OnNull() OVERRIDE { return Count(); }
+
+ private:
+  bool Count() { return ++count_ < limit_; }
+
+  const int limit_;
+  int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingHandler);
+};
+
+}  // namespace
+
+TEST(JSONReaderTest, ParseWithHandlerStopsWhenAsked) {
+  JSONReader reader;
+  CountingHandler handler(2);
+  EXPECT_FALSE(reader.ParseWithHandler("[1, \"two\", 3, 4]", &handler));
+  EXPECT_EQ(2, handler.count());
+  EXPECT_EQ(JSONReader::JSON_ABORTED_BY_HANDLER, reader.error_code());
+}
+
 }  // namespace base
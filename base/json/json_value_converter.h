@@ -9,12 +9,15 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/json/json_event_handler.h"
+#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
 #include "base/stl_util.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "base/values.h"
 
 // JSONValueConverter converts a JSON value into a C++ struct in a
@@ -46,6 +49,11 @@
 //   JSONValueConverter<Message> converter;
 //   converter.Convert(json, &message);
 //
+// ConvertFromJSON() does the same straight from a JSON string. It never builds
+// a DictionaryValue for the whole input: only the values of registered fields
+// are turned into Values, one at a time, and everything else is skipped.
+//   converter.ConvertFromJSON(json_string, &message);
+//
 // Convert() returns false when it fails.  Here "fail" means that the value is
 // structurally different from expected, such like a string value appears
 // for an int field.  Do not report failures for missing fields.
@@ -364,6 +372,134 @@ class RepeatedCustomValueConverter
   DISALLOW_COPY_AND_ASSIGN(RepeatedCustomValueConverter);
 };
 
+// Used by JSONValueConverter::ConvertFromJSON() to hand the members of the
+// root object to |fields| while it is being parsed.
+template <typename StructType>
+class StreamingFieldDispatcher : public JSONEventHandler {
+ public:
+  StreamingFieldDispatcher(
+      const std::vector<FieldConverterBase<StructType>*>& fields,
+      StructType* output)
+      : fields_(fields),
+        output_(output),
+        depth_(0),
+        saw_root_object_(false) {
+  }
+
+  bool saw_root_object() const { return saw_root_object_; }
+
+  // JSONEventHandler implementation:
+  virtual bool OnObjectBegin() OVERRIDE {
+    if (depth_++ == 0) {
+      saw_root_object_ = true;
+      return true;
+    }
+    return !builder_ || builder_->OnObjectBegin();
+  }
+  virtual bool OnObjectKey(const StringPiece& key) OVERRIDE {
+    if (depth_ > 1)
+      return !builder_ || builder_->OnObjectKey(key);
+
+    // A member of the root object. Only build its value if some field wants
+    // it.
+    key.CopyToString(&member_name_);
+    builder_.reset();
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      if (IsFieldOfMember(fields_[i]->field_path())) {
+        builder_.reset(new JSONValueBuilder);
+        break;
+      }
+    }
+    return true;
+  }
+  virtual bool OnObjectEnd() OVERRIDE {
+    if (--depth_ == 0)
+      return true;
+    return (!builder_ || builder_->OnObjectEnd()) && MaybeConvertMember();
+  }
+  virtual bool OnArrayBegin() OVERRIDE {
+    if (depth_++ == 0)
+      return false;
+    return !builder_ || builder_->OnArrayBegin();
+  }
+  virtual bool OnArrayEnd() OVERRIDE {
+    --depth_;
+    return (!builder_ || builder_->OnArrayEnd()) && MaybeConvertMember();
+  }
+  virtual bool OnString(const StringPiece& value) OVERRIDE {
+    return depth_ > 0 && (!builder_ || builder_->OnString(value)) &&
+        MaybeConvertMember();
+  }
+  virtual bool OnInteger(int value) OVERRIDE {
+    return depth_ > 0 && (!builder_ || builder_->OnInteger(value)) &&
+        MaybeConvertMember();
+  }
+  virtual bool OnDouble(double value) OVERRIDE {
+    return depth_ > 0 && (!builder_ || builder_->OnDouble(value)) &&
+        MaybeConvertMember();
+  }
+  virtual bool OnBoolean(bool value) OVERRIDE {
+    return depth_ > 0 && (!builder_ || builder_->OnBoolean(value)) &&
+        MaybeConvertMember();
+  }
+  virtual bool OnNull() OVERRIDE {
+    return depth_ > 0 && (!builder_ || builder_->OnNull()) &&
+        MaybeConvertMember();
+  }
+
+ private:
+  // Whether |field_path| names the current member or something inside it.
+  bool IsFieldOfMember(const std::string& field_path) const {
+    return StartsWithASCII(field_path, member_name_, true) &&
+        (field_path.size() == member_name_.size() ||
+         field_path[member_name_.size()] == '.');
+  }
+
+  // Once the value of the current member is complete, runs the converters of
+  // every field it contains.
+  bool MaybeConvertMember() {
+    if (depth_ != 1 || !builder_)
+      return true;
+    DCHECK(builder_->IsComplete());
+    scoped_ptr<Value> value = builder_->PassValue();
+    builder_.reset();
+
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      const std::string& field_path = fields_[i]->field_path();
+      if (!IsFieldOfMember(field_path))
+        continue;
+      const Value* field = value.get();
+      if (field_path.size() != member_name_.size()) {
+        const DictionaryValue* dictionary = NULL;
+        if (!value->GetAsDictionary(&dictionary) ||
+            !dictionary->Get(field_path.substr(member_name_.size() + 1),
+                             &field)) {
+          continue;
+        }
+      }
+      if (!fields_[i]->ConvertField(*field, output_)) {
+        DVLOG(1) << "failure at field " << field_path;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const std::vector<FieldConverterBase<StructType>*>& fields_;
+  StructType* output_;
+
+  // Number of containers currently open, including the root object.
+  int depth_;
+  bool saw_root_object_;
+
+  // The name of the root object's member being parsed.
+  std::string member_name_;
+
+  // Builds the current member's value; NULL when no field wants it.
+  scoped_ptr<JSONValueBuilder> builder_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingFieldDispatcher);
+};
 
 }  // namespace internal
 
@@ -516,6 +652,17 @@ class JSONValueConverter {
     return true;
   }
 
+  bool ConvertFromJSON(const StringPiece& json, StructType* output) const {
+    internal::StreamingFieldDispatcher<StructType> dispatcher(fields_.get(),
+                                                              output);
+    JSONReader reader;
+    if (!reader.ParseWithHandler(json, &dispatcher)) {
+      DVLOG(1) << reader.GetErrorMessage();
+      return false;
+    }
+    return dispatcher.saw_root_object();
+  }
+
  private:
   ScopedVector<internal::FieldConverterBase<StructType> > fields_;
 
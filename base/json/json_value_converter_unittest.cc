@@ -123,6 +123,48 @@ TEST(JSONValueConverterTest, ParseSimpleMessage) {
   EXPECT_EQ(2, *(message.ints[1]));
 }
 
+TEST(JSONValueConverterTest, ParseSimpleMessageFromJSON) {
+  const char normal_data[] =
+      "{\n"
+      "  \"foo\": 1,\n"
+      "  \"unknown\": {\"bar\": [\"ignored\", {}]},\n"
+      "  \"bar\": \"bar\",\n"
+      "  \"baz\": true,\n"
+      "  \"bstruct\": {},\n"
+      "  \"string_values\": [{\"val\": \"value_1\"}, {\"val\": \"value_2\"}],"
+      "  \"simple_enum\": \"bar\","
+      "  \"ints\": [1, 2]"
+      "}\n";
+
+  SimpleMessage message;
+  base::JSONValueConverter<SimpleMessage> converter;
+  EXPECT_TRUE(converter.ConvertFromJSON(normal_data, &message));
+
+  EXPECT_EQ(1, message.foo);
+  EXPECT_EQ("bar", message.bar);
+  EXPECT_TRUE(message.baz);
+  EXPECT_TRUE(message.bstruct);
+  EXPECT_EQ(SimpleMessage::BAR, message.simple_enum);
+  ASSERT_EQ(2U, message.string_values.size());
+  EXPECT_EQ("value_1", *message.string_values[0]);
+  EXPECT_EQ("value_2", *message.string_values[1]);
+  ASSERT_EQ(2U, message.ints.size());
+  EXPECT_EQ(1, *(message.ints[0]));
+  EXPECT_EQ(2, *(message.ints[1]));
+}
+
+TEST(JSONValueConverterTest, ConvertFromJSONFailures) {
+  base::JSONValueConverter<SimpleMessage> converter;
+  SimpleMessage message;
+  // The root has to be an object.
+  EXPECT_FALSE(converter.ConvertFromJSON("[1, 2]", &message));
+  EXPECT_FALSE(converter.ConvertFromJSON("1", &message));
+  // Malformed JSON.
+  EXPECT_FALSE(converter.ConvertFromJSON("{\"foo\": 1,", &message));
+  // A field of the wrong type.
+  EXPECT_FALSE(converter.ConvertFromJSON("{\"foo\": \"1\"}", &message));
+}
+
 TEST(JSONValueConverterTest, ParseNestedMessage) {
   const char normal_data[] =
       "{\n"
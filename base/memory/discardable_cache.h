@@ -0,0 +1,198 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_DISCARDABLE_CACHE_H_
+#define BASE_MEMORY_DISCARDABLE_CACHE_H_
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/containers/mru_cache.h"
+#include "base/debug/trace_event.h"
+#include "base/logging.h"
+#include "base/memory/discardable_memory.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/threading/thread_checker.h"
+
+namespace base {
+
+// DiscardableCache keeps blobs of bytes, such as decoded images or rasterized
+// content, in DiscardableMemory, keyed by |KeyType|.
+//
+// Entries are unlocked while not in use, so the system may purge them at any
+// time; Lock() then reports a miss and the caller recreates the entry. On top
+// of that the cache holds at most |max_bytes|, evicting the least recently
+// used unlocked entries first, and sheds entries gradually on memory pressure:
+// down to half of |max_bytes| on moderate pressure, and every unlocked entry
+// on critical pressure. Its footprint is reported to TraceLog as a counter.
+//
+// Example:
+//   DiscardableCache<GURL> cache("ImageCache", 16 * 1024 * 1024);
+//
+//   size_t size;
+//   void* pixels = cache.Lock(url, &size);
+//   if (!pixels) {
+//     size = ...;
+//     pixels = cache.Insert(url, size);
+//     if (!pixels)
+//       return;  // Out of memory.
+//     Decode(..., pixels);
+//   }
+//   Draw(pixels, size);
+//   cache.Unlock(url);
+//
+// A DiscardableCache must be used on a single thread. It only responds to
+// memory pressure if that thread has a MessageLoop.
+template <typename KeyType>
+class DiscardableCache {
+ public:
+  // |name| must be a string literal, it names the trace counter.
+  DiscardableCache(const char* name, size_t max_bytes)
+      : name_(name),
+        max_bytes_(max_bytes),
+        bytes_(0),
+        entries_(Entries::NO_AUTO_EVICT),
+        memory_pressure_listener_(
+            Bind(&DiscardableCache::OnMemoryPressure, Unretained(this))) {
+  }
+
+  ~DiscardableCache() {
+    DCHECK(thread_checker_.CalledOnValidThread());
+  }
+
+  // Allocates |size| bytes for |key|, replacing any previous entry, and
+  // returns them locked. Evicts entries as needed to stay within |max_bytes|.
+  // Returns NULL if |size| doesn't fit or the allocation failed.
+  void* Insert(const KeyType& key, size_t size) {
+    DCHECK(thread_checker_.CalledOnValidThread());
+    Remove(key);
+    if (size > max_bytes_)
+      return NULL;
+    EvictToSize(max_bytes_ - size);
+
+    scoped_ptr<DiscardableMemory> memory =
+        DiscardableMemory::CreateLockedMemory(size);
+    if (!memory)
+      return NULL;
+    void* data = memory->Memory();
+    Entry* entry = new Entry;
+    entry->memory = memory.Pass();
+    entry->size = size;
+    entry->locked = true;
+    entries_.Put(key, entry);
+    bytes_ += size;
+    TraceFootprint();
+    return data;
+  }
+
+  // Locks the entry for |key|, marks it as most recently used and returns its
+  // contents, with their size in |size| unless it is NULL. Returns NULL if
+  // there is no entry for |key| or it was purged, in which case it is dropped.
+  // Locks don't nest.
+  void* Lock(const KeyType& key, size_t* size) {
+    DCHECK(thread_checker_.CalledOnValidThread());
+    typename Entries::iterator it = entries_.Get(key);
+    if (it == entries_.end())
+      return NULL;
+    Entry* entry = it->second;
+    DCHECK(!entry->locked);
+    DiscardableMemoryLockStatus status = entry->memory->Lock();
+    if (status != DISCARDABLE_MEMORY_LOCK_STATUS_SUCCESS) {
+      if (status == DISCARDABLE_MEMORY_LOCK_STATUS_PURGED)
+        entry->memory->Unlock();
+      Erase(it);
+      TraceFootprint();
+      return NULL;
+    }
+    entry->locked = true;
+    if (size)
+      *size = entry->size;
+    return entry->memory->Memory();
+  }
+
+  // Unlocks the entry for |key| after a successful Insert() or Lock().
+  void Unlock(const KeyType& key) {
+    DCHECK(thread_checker_.CalledOnValidThread());
+    typename Entries::iterator it = entries_.Peek(key);
+    DCHECK(it != entries_.end());
+    DCHECK(it->second->locked);
+    it->second->memory->Unlock();
+    it->second->locked = false;
+  }
+
+  // Drops the entry for |key|, if any. It must not be locked.
+  void Remove(const KeyType& key) {
+    DCHECK(thread_checker_.CalledOnValidThread());
+    typename Entries::iterator it = entries_.Peek(key);
+    if (it == entries_.end())
+      return;
+    DCHECK(!it->second->locked);
+    Erase(it);
+    TraceFootprint();
+  }
+
+  // Evicts least recently used unlocked entries until the cache holds at most
+  // |bytes|, or only locked entries are left.
+  void EvictToSize(size_t bytes) {
+    DCHECK(thread_checker_.CalledOnValidThread());
+    typename Entries::reverse_iterator it = entries_.rbegin();
+    while (bytes_ > bytes && it != entries_.rend()) {
+      if (it->second->locked)
+        ++it;
+      else
+        it = Erase(it);
+    }
+    TraceFootprint();
+  }
+
+  // The number of bytes held by all entries, locked or not.
+  size_t bytes() const { return bytes_; }
+  size_t max_bytes() const { return max_bytes_; }
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    scoped_ptr<DiscardableMemory> memory;
+    size_t size;
+    bool locked;
+  };
+  typedef OwningMRUCache<KeyType, Entry*> Entries;
+
+  template <typename Iterator>
+  Iterator Erase(Iterator it) {
+    DCHECK_GE(bytes_, it->second->size);
+    bytes_ -= it->second->size;
+    return entries_.Erase(it);
+  }
+
+  void OnMemoryPressure(
+      MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+    switch (memory_pressure_level) {
+      case MemoryPressureListener::MEMORY_PRESSURE_MODERATE:
+        EvictToSize(max_bytes_ / 2);
+        return;
+      case MemoryPressureListener::MEMORY_PRESSURE_CRITICAL:
+        EvictToSize(0);
+        return;
+    }
+    NOTREACHED();
+  }
+
+  void TraceFootprint() {
+    TRACE_COUNTER_ID1("base", name_, this, bytes_);
+  }
+
+  const char* const name_;
+  const size_t max_bytes_;
+  size_t bytes_;
+  Entries entries_;
+  MemoryPressureListener memory_pressure_listener_;
+  ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(DiscardableCache);
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_DISCARDABLE_CACHE_H_
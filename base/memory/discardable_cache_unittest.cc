@@ -0,0 +1,119 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/discardable_cache.h"
+
+#include <string.h>
+
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace {
+
+const size_t kEntrySize = 1024;
+
+class DiscardableCacheTest : public testing::Test {
+ public:
+  DiscardableCacheTest() : cache_("DiscardableCacheTest", 4 * kEntrySize) {}
+
+ protected:
+  // Inserts an entry for |key| filled with |key| and unlocks it.
+  bool InsertEntry(int key) {
+    void* data = cache_.Insert(key, kEntrySize);
+    if (!data)
+      return false;
+    memset(data, key, kEntrySize);
+    cache_.Unlock(key);
+    return true;
+  }
+
+  bool HasEntry(int key) {
+    size_t size = 0;
+    void* data = cache_.Lock(key, &size);
+    if (!data)
+      return false;
+    EXPECT_EQ(kEntrySize, size);
+    EXPECT_EQ(key, static_cast<char*>(data)[kEntrySize - 1]);
+    cache_.Unlock(key);
+    return true;
+  }
+
+  // Created first so that the cache listens to memory pressure.
+  MessageLoop message_loop_;
+  DiscardableCache<int> cache_;
+};
+
+TEST_F(DiscardableCacheTest, InsertAndLock) {
+  EXPECT_FALSE(cache_.Lock(1, NULL));
+  ASSERT_TRUE(InsertEntry(1));
+  EXPECT_EQ(1u, cache_.size());
+  EXPECT_EQ(kEntrySize, cache_.bytes());
+  EXPECT_TRUE(HasEntry(1));
+
+  cache_.Remove(1);
+  EXPECT_FALSE(HasEntry(1));
+  EXPECT_EQ(0u, cache_.bytes());
+
+  EXPECT_FALSE(cache_.Insert(2, cache_.max_bytes() + 1));
+}
+
+TEST_F(DiscardableCacheTest, EvictsLeastRecentlyUsed) {
+  for (int i = 1; i <= 4; ++i)
+    ASSERT_TRUE(InsertEntry(i));
+  EXPECT_EQ(cache_.max_bytes(), cache_.bytes());
+
+  // Make 1 the most recently used, so 2 goes first.
+  EXPECT_TRUE(HasEntry(1));
+  ASSERT_TRUE(InsertEntry(5));
+  EXPECT_FALSE(HasEntry(2));
+  EXPECT_TRUE(HasEntry(1));
+  EXPECT_TRUE(HasEntry(3));
+  EXPECT_EQ(cache_.max_bytes(), cache_.bytes());
+}
+
+TEST_F(DiscardableCacheTest, LockedEntriesAreNotEvicted) {
+  ASSERT_TRUE(cache_.Insert(1, kEntrySize));
+  for (int i = 2; i <= 5; ++i)
+    ASSERT_TRUE(InsertEntry(i));
+  cache_.Unlock(1);
+  EXPECT_TRUE(HasEntry(1));
+  EXPECT_FALSE(HasEntry(2));
+
+  ASSERT_TRUE(cache_.Lock(1, NULL));
+  cache_.EvictToSize(0);
+  EXPECT_EQ(1u, cache_.size());
+  cache_.Unlock(1);
+}
+
+TEST_F(DiscardableCacheTest, MemoryPressure) {
+  for (int i = 1; i <= 4; ++i)
+    ASSERT_TRUE(InsertEntry(i));
+
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_MODERATE);
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(cache_.max_bytes() / 2, cache_.bytes());
+  EXPECT_TRUE(HasEntry(4));
+
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_CRITICAL);
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(DiscardableCacheTest, PurgedEntriesAreDropped) {
+  if (!DiscardableMemory::PurgeForTestingSupported())
+    return;
+
+  ASSERT_TRUE(InsertEntry(1));
+  DiscardableMemory::PurgeForTesting();
+  EXPECT_FALSE(cache_.Lock(1, NULL));
+  EXPECT_EQ(0u, cache_.size());
+  EXPECT_EQ(0u, cache_.bytes());
+}
+
+}  // namespace
+}  // namespace base
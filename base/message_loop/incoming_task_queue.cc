@@ -8,13 +8,43 @@
 #include "base/location.h"
 #include "base/message_loop/message_loop.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
 
 namespace base {
 namespace internal {
 
+namespace {
+
+// Number of slots in the lock-free ring. Must be a power of two. Deep enough
+// to absorb bursts of cross-thread posts; anything beyond that spills into the
+// locked overflow queue.
+const int32 kRingSize = 128;
+const int32 kRingMask = kRingSize - 1;
+
+// Ring positions are free-running counters that are allowed to wrap around,
+// so all arithmetic on them is done unsigned.
+subtle::Atomic32 AdvancePosition(subtle::Atomic32 position, int32 count) {
+  return static_cast<subtle::Atomic32>(static_cast<uint32>(position) + count);
+}
+
+int32 PositionDelta(subtle::Atomic32 a, subtle::Atomic32 b) {
+  return static_cast<int32>(static_cast<uint32>(a) - static_cast<uint32>(b));
+}
+
+}  // namespace
+
 IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop)
-    : message_loop_(message_loop),
+    : ring_(new Slot[kRingSize]),
+      ring_enqueue_position_(0),
+      ring_dequeue_position_(0),
+      overflow_count_(0),
+      incoming_task_count_(0),
+      accepting_tasks_(1),
+      active_post_count_(0),
+      message_loop_(message_loop),
       next_sequence_num_(0) {
+  for (int32 i = 0; i < kRingSize; ++i)
+    subtle::NoBarrier_Store(&ring_[i].sequence, i);
 }
 
 bool IncomingTaskQueue::AddToIncomingQueue(
@@ -22,7 +52,6 @@ bool IncomingTaskQueue::AddToIncomingQueue(
     const Closure& task,
     TimeDelta delay,
     bool nestable) {
-  AutoLock locked(incoming_queue_lock_);
   PendingTask pending_task(
       from_here, task, CalculateDelayedRuntime(delay), nestable);
   return PostPendingTask(&pending_task);
@@ -30,6 +59,7 @@ bool IncomingTaskQueue::AddToIncomingQueue(
 
 bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 #if defined(OS_WIN)
+  AutoLock lock(high_resolution_timer_lock_);
   return !high_resolution_timer_expiration_.is_null();
 #else
   return true;
@@ -37,40 +67,82 @@ bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
-  AutoLock lock(incoming_queue_lock_);
-  return incoming_queue_.empty();
+  return subtle::Acquire_Load(&incoming_task_count_) == 0;
 }
 
 void IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
-  // Acquire all we can from the inter-thread queue with one lock acquisition.
-  AutoLock lock(incoming_queue_lock_);
-  if (!incoming_queue_.empty())
-    incoming_queue_.Swap(work_queue);  // Constant time
+  // Take everything that has been published into the ring. Bound the loop so
+  // that a steady stream of posts can't keep us here forever.
+  int32 loaded = 0;
+  while (loaded < kRingSize && TryPopFromRing(work_queue))
+    ++loaded;
 
-  DCHECK(incoming_queue_.empty());
+  // Overflowed tasks were posted after everything in the ring, so only take
+  // them once the ring is completely empty, i.e. no producer has a slot
+  // claimed but not yet published.
+  if (subtle::Acquire_Load(&overflow_count_) &&
+      subtle::Acquire_Load(&ring_enqueue_position_) ==
+          ring_dequeue_position_) {
+    AutoLock lock(overflow_lock_);
+    while (!overflow_queue_.empty()) {
+      work_queue->push(overflow_queue_.front());
+      overflow_queue_.pop();
+      ++loaded;
+    }
+    subtle::Release_Store(&overflow_count_, 0);
+  }
+
+  if (loaded) {
+    subtle::Barrier_AtomicIncrement(&incoming_task_count_, -loaded);
+  } else if (subtle::Acquire_Load(&incoming_task_count_)) {
+    // A producer has counted its task but not published it yet; its post
+    // won't wake us up since the count was already nonzero. Ask the pump to
+    // come back shortly instead of going idle.
+    message_loop_->ScheduleWork(true);
+  }
 }
 
 void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 #if defined(OS_WIN)
-  // If we left the high-resolution timer activated, deactivate it now.
-  // Doing this is not-critical, it is mainly to make sure we track
-  // the high resolution timer activations properly in our unit tests.
-  if (!high_resolution_timer_expiration_.is_null()) {
-    Time::ActivateHighResolutionTimer(false);
-    high_resolution_timer_expiration_ = TimeTicks();
+  {
+    // If we left the high-resolution timer activated, deactivate it now.
+    // Doing this is not-critical, it is mainly to make sure we track
+    // the high resolution timer activations properly in our unit tests.
+    AutoLock lock(high_resolution_timer_lock_);
+    if (!high_resolution_timer_expiration_.is_null()) {
+      Time::ActivateHighResolutionTimer(false);
+      high_resolution_timer_expiration_ = TimeTicks();
+    }
   }
 #endif
 
-  AutoLock lock(incoming_queue_lock_);
+  // Stop accepting tasks, then wait for posts that are already past the check
+  // in PostPendingTask() to finish with |message_loop_|. Posts never block, so
+  // this only spins for a very short time.
+  subtle::NoBarrier_Store(&accepting_tasks_, 0);
+  subtle::MemoryBarrier();
+  while (subtle::Acquire_Load(&active_post_count_))
+    PlatformThread::YieldCurrentThread();
   message_loop_ = NULL;
 }
 
 IncomingTaskQueue::~IncomingTaskQueue() {
   // Verify that WillDestroyCurrentMessageLoop() has been called.
   DCHECK(!message_loop_);
+
+  // Tasks left in the ring still need to be destroyed.
+  for (;;) {
+    Slot* slot = &ring_[ring_dequeue_position_ & kRingMask];
+    if (PositionDelta(subtle::Acquire_Load(&slot->sequence),
+                      AdvancePosition(ring_dequeue_position_, 1)) != 0) {
+      break;
+    }
+    slot->pending_task.Destroy();
+    ring_dequeue_position_ = AdvancePosition(ring_dequeue_position_, 1);
+  }
 }
 
 TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
@@ -79,6 +151,7 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
     delayed_run_time = TimeTicks::Now() + delay;
 
 #if defined(OS_WIN)
+    AutoLock lock(high_resolution_timer_lock_);
     if (high_resolution_timer_expiration_.is_null()) {
       // Windows timers are granular to 15.6ms.  If we only set high-res
       // timers for those under 15.6ms, then a 18ms timer ticks at ~32ms,
@@ -95,20 +168,20 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
         }
       }
     }
+
+    // The lease is only checked when delayed tasks are posted, which keeps
+    // the lock off the path of immediate tasks.
+    if (!high_resolution_timer_expiration_.is_null()) {
+      if (TimeTicks::Now() > high_resolution_timer_expiration_) {
+        Time::ActivateHighResolutionTimer(false);
+        high_resolution_timer_expiration_ = TimeTicks();
+      }
+    }
 #endif
   } else {
     DCHECK_EQ(delay.InMilliseconds(), 0) << "delay should not be negative";
   }
 
-#if defined(OS_WIN)
-  if (!high_resolution_timer_expiration_.is_null()) {
-    if (TimeTicks::Now() > high_resolution_timer_expiration_) {
-      Time::ActivateHighResolutionTimer(false);
-      high_resolution_timer_expiration_ = TimeTicks();
-    }
-  }
-#endif
-
   return delayed_run_time;
 }
 
@@ -117,10 +190,12 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   // directly, as it could starve handling of foreign threads.  Put every task
   // into this queue.
 
-  // This should only be called while the lock is taken.
-  incoming_queue_lock_.AssertAcquired();
-
-  if (!message_loop_) {
+  // Pairs with WillDestroyCurrentMessageLoop(): either it sees this post in
+  // |active_post_count_| and waits for it, or this post sees that the loop is
+  // going away.
+  subtle::Barrier_AtomicIncrement(&active_post_count_, 1);
+  if (!subtle::Acquire_Load(&accepting_tasks_)) {
+    subtle::Barrier_AtomicIncrement(&active_post_count_, -1);
     pending_task->task.Reset();
     return false;
   }
@@ -128,19 +203,74 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   // Initialize the sequence number. The sequence number is used for delayed
   // tasks (to faciliate FIFO sorting when two tasks have the same
   // delayed_run_time value) and for identifying the task in about:tracing.
-  pending_task->sequence_num = next_sequence_num_++;
+  pending_task->sequence_num =
+      subtle::NoBarrier_AtomicIncrement(&next_sequence_num_, 1) - 1;
 
   TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
       "MessageLoop::PostTask",
       TRACE_ID_MANGLE(message_loop_->GetTaskTraceID(*pending_task)));
 
-  bool was_empty = incoming_queue_.empty();
-  incoming_queue_.push(*pending_task);
+  bool was_empty =
+      subtle::Barrier_AtomicIncrement(&incoming_task_count_, 1) == 1;
+
+  if (subtle::Acquire_Load(&overflow_count_) ||
+      !TryPushToRing(*pending_task)) {
+    AutoLock lock(overflow_lock_);
+    overflow_queue_.push(*pending_task);
+    subtle::Release_Store(&overflow_count_,
+                          static_cast<subtle::Atomic32>(
+                              overflow_queue_.size()));
+  }
   pending_task->task.Reset();
 
   // Wake up the pump.
   message_loop_->ScheduleWork(was_empty);
 
+  subtle::Barrier_AtomicIncrement(&active_post_count_, -1);
+  return true;
+}
+
+bool IncomingTaskQueue::TryPushToRing(const PendingTask& pending_task) {
+  subtle::Atomic32 position = subtle::NoBarrier_Load(&ring_enqueue_position_);
+  Slot* slot;
+  for (;;) {
+    slot = &ring_[position & kRingMask];
+    int32 delta = PositionDelta(subtle::Acquire_Load(&slot->sequence),
+                                position);
+    if (delta == 0) {
+      // The slot is free for |position|; try to claim it.
+      subtle::Atomic32 previous = subtle::NoBarrier_CompareAndSwap(
+          &ring_enqueue_position_, position, AdvancePosition(position, 1));
+      if (previous == position)
+        break;
+      position = previous;
+    } else if (delta < 0) {
+      // The slot still holds a task from the previous lap: the ring is full.
+      return false;
+    } else {
+      // Another producer claimed |position| first.
+      position = subtle::NoBarrier_Load(&ring_enqueue_position_);
+    }
+  }
+
+  slot->pending_task.Init(pending_task);
+  subtle::Release_Store(&slot->sequence, AdvancePosition(position, 1));
+  return true;
+}
+
+bool IncomingTaskQueue::TryPopFromRing(TaskQueue* work_queue) {
+  Slot* slot = &ring_[ring_dequeue_position_ & kRingMask];
+  if (PositionDelta(subtle::Acquire_Load(&slot->sequence),
+                    AdvancePosition(ring_dequeue_position_, 1)) != 0) {
+    return false;
+  }
+
+  work_queue->push(*slot->pending_task);
+  slot->pending_task.Destroy();
+  // Hand the slot to the producer that will claim it on the next lap.
+  subtle::Release_Store(&slot->sequence,
+                        AdvancePosition(ring_dequeue_position_, kRingSize));
+  ring_dequeue_position_ = AdvancePosition(ring_dequeue_position_, 1);
   return true;
 }
 
@@ -5,8 +5,11 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
+#include "base/memory/manual_constructor.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/pending_task.h"
 #include "base/synchronization/lock.h"
 #include "base/time/time.h"
@@ -21,6 +24,13 @@ namespace internal {
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
 // threads and together with MessageLoop ensures clean shutdown.
+//
+// Posting does not take a lock in the common case. Tasks are written into a
+// fixed ring of preallocated slots that forms a lock-free multi-producer,
+// single-consumer queue; the slots are reused, so a post does not allocate a
+// queue node. Only when the ring is full do tasks spill into a locked overflow
+// queue, and they keep going there until the loop drains it, so tasks posted
+// from any one thread still run in FIFO order.
 class BASE_EXPORT IncomingTaskQueue
     : public RefCountedThreadSafe<IncomingTaskQueue> {
  public:
@@ -45,7 +55,7 @@ class BASE_EXPORT IncomingTaskQueue
   // Returns true if the message loop is "idle". Provided for testing.
   bool IsIdleForTesting();
 
-  // Loads tasks from the |incoming_queue_| into |*work_queue|. Must be called
+  // Loads tasks from the incoming queue into |*work_queue|. Must be called
   // from the thread that is running the loop.
   void ReloadWorkQueue(TaskQueue* work_queue);
 
@@ -54,35 +64,70 @@ class BASE_EXPORT IncomingTaskQueue
 
  private:
   friend class RefCountedThreadSafe<IncomingTaskQueue>;
+
+  // A ring slot. |sequence| equals the enqueue position that may claim the
+  // slot while it is free, and that position + 1 once a task has been
+  // published into it; see TryPushToRing() and TryPopFromRing().
+  struct Slot {
+    volatile subtle::Atomic32 sequence;
+    ManualConstructor<PendingTask> pending_task;
+  };
+
   virtual ~IncomingTaskQueue();
 
   // Calculates the time at which a PendingTask should run.
   TimeTicks CalculateDelayedRuntime(TimeDelta delay);
 
-  // Adds a task to |incoming_queue_|. The caller retains ownership of
+  // Adds a task to the incoming queue. The caller retains ownership of
   // |pending_task|, but this function will reset the value of
   // |pending_task->task|. This is needed to ensure that the posting call stack
   // does not retain |pending_task->task| beyond this function call.
   bool PostPendingTask(PendingTask* pending_task);
 
+  // Writes |pending_task| into the next free ring slot. Returns false if the
+  // ring is full.
+  bool TryPushToRing(const PendingTask& pending_task);
+
+  // Moves the oldest task in the ring into |work_queue|. Returns false if the
+  // next slot has not been published yet. Only called by the loop's thread.
+  bool TryPopFromRing(TaskQueue* work_queue);
+
 #if defined(OS_WIN)
+  // Protects |high_resolution_timer_expiration_|, which is only touched when
+  // posting delayed tasks.
+  base::Lock high_resolution_timer_lock_;
   TimeTicks high_resolution_timer_expiration_;
 #endif
 
-  // The lock that protects access to |incoming_queue_|, |message_loop_| and
-  // |next_sequence_num_|.
-  base::Lock incoming_queue_lock_;
-
-  // An incoming queue of tasks that are acquired under a mutex for processing
-  // on this instance's thread. These tasks have not yet been been pushed to
-  // |message_loop_|.
-  TaskQueue incoming_queue_;
+  // The ring of task slots. |ring_enqueue_position_| is claimed by producers
+  // with compare-and-swap; |ring_dequeue_position_| is only used by the loop's
+  // thread.
+  scoped_ptr<Slot[]> ring_;
+  volatile subtle::Atomic32 ring_enqueue_position_;
+  subtle::Atomic32 ring_dequeue_position_;
+
+  // Tasks that did not fit into the ring. |overflow_count_| is nonzero while
+  // |overflow_queue_| holds tasks, and sends new posts there too.
+  base::Lock overflow_lock_;
+  TaskQueue overflow_queue_;
+  volatile subtle::Atomic32 overflow_count_;
+
+  // Number of tasks posted but not yet loaded into a work queue. It is bumped
+  // before a task is published, so the post that takes it from zero is the one
+  // responsible for waking up the loop.
+  volatile subtle::Atomic32 incoming_task_count_;
+
+  // Nonzero while tasks may be posted. Cleared by
+  // WillDestroyCurrentMessageLoop(), which then waits for |active_post_count_|
+  // to drain so that no poster still uses |message_loop_|.
+  volatile subtle::Atomic32 accepting_tasks_;
+  volatile subtle::Atomic32 active_post_count_;
 
   // Points to the message loop that owns |this|.
   MessageLoop* message_loop_;
 
   // The next sequence number to use for delayed tasks.
-  int next_sequence_num_;
+  volatile subtle::Atomic32 next_sequence_num_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
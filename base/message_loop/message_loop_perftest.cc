@@ -0,0 +1,96 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how fast tasks posted from several threads can get through a
+// single MessageLoop, which is dominated by the cost of the incoming queue.
+
+#include "base/bind.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kTasksPerProducer = 100000;
+
+// Counts the tasks that ran on the consumer thread and signals |done| once
+// |expected| of them did. Only touched on the consumer thread.
+class TaskCounter {
+ public:
+  TaskCounter(int expected, WaitableEvent* done)
+      : count_(0), expected_(expected), done_(done) {}
+
+  void Run() {
+    if (++count_ == expected_)
+      done_->Signal();
+  }
+
+ private:
+  int count_;
+  const int expected_;
+  WaitableEvent* const done_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskCounter);
+};
+
+void PostTasks(scoped_refptr<MessageLoopProxy> target,
+               TaskCounter* counter,
+               WaitableEvent* start) {
+  start->Wait();
+  Closure task = Bind(&TaskCounter::Run, Unretained(counter));
+  for (int i = 0; i < kTasksPerProducer; ++i)
+    target->PostTask(FROM_HERE, task);
+}
+
+void RunPostRunBenchmark(int num_producers) {
+  Thread consumer("Consumer");
+  ASSERT_TRUE(consumer.Start());
+
+  ScopedVector<Thread> producers;
+  for (int i = 0; i < num_producers; ++i) {
+    producers.push_back(new Thread(StringPrintf("Producer%d", i).c_str()));
+    ASSERT_TRUE(producers.back()->Start());
+  }
+
+  WaitableEvent start(true, false);
+  WaitableEvent done(false, false);
+  TaskCounter counter(num_producers * kTasksPerProducer, &done);
+  for (int i = 0; i < num_producers; ++i) {
+    producers[i]->message_loop()->PostTask(
+        FROM_HERE,
+        Bind(&PostTasks, consumer.message_loop_proxy(), &counter, &start));
+  }
+
+  TimeTicks begin = TimeTicks::HighResNow();
+  start.Signal();
+  done.Wait();
+  TimeDelta elapsed = TimeTicks::HighResNow() - begin;
+
+  producers.clear();
+  consumer.Stop();
+
+  perf_test::PrintResult(
+      "task_post_run_throughput", "", StringPrintf("%d_producers",
+                                                   num_producers),
+      num_producers * kTasksPerProducer / elapsed.InMillisecondsF(),
+      "tasks/ms", true);
+}
+
+}  // namespace
+
+TEST(MessageLoopPerfTest, PostRunThroughput) {
+  const int kProducerCounts[] = { 1, 2, 4, 8, 16 };
+  for (size_t i = 0; i < arraysize(kProducerCounts); ++i)
+    RunPostRunBenchmark(kProducerCounts[i]);
+}
+
+}  // namespace base
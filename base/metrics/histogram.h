@@ -499,6 +499,7 @@ class BASE_EXPORT Histogram : public HistogramBase {
 
   friend class StatisticsRecorder;  // To allow it to delete duplicates.
   friend class StatisticsRecorderTest;
+  friend class HistogramSharedMemory;  // To move |samples_| to shared memory.
 
   friend BASE_EXPORT_PRIVATE HistogramBase* DeserializeHistogramInfo(
       PickleIterator* iter);
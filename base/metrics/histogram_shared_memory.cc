@@ -0,0 +1,264 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/histogram_shared_memory.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/memory/shared_memory.h"
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/sample_vector.h"
+#include "base/metrics/statistics_recorder.h"
+
+namespace base {
+
+namespace {
+
+// Records start at multiples of this, which suits the 64-bit sum.
+const size_t kAlignment = 8;
+
+size_t AlignUp(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+// Starts the segment.
+struct SegmentHeader {
+  // The number of bytes reserved for records. It keeps growing past the end
+  // of the segment when allocations fail.
+  subtle::Atomic32 used_size;
+  int32 padding;
+};
+
+// Followed by the histogram name, then the bucket counts.
+struct Record {
+  // Set to 1 with a release store once the rest is filled in.
+  subtle::Atomic32 ready;
+  uint32 record_size;
+
+  int32 histogram_type;
+  int32 flags;
+  int32 declared_min;
+  int32 declared_max;
+  uint32 bucket_count;
+  uint32 ranges_checksum;
+  uint32 name_length;
+  int32 padding;
+
+  HistogramSamples::Metadata meta;
+};
+
+COMPILE_ASSERT(sizeof(Record) % 8 == 0, record_misaligned);
+
+COMPILE_ASSERT(sizeof(SegmentHeader) % 8 == 0, segment_header_misaligned);
+
+HistogramSharedMemory* g_current_memory = NULL;
+
+}  // namespace
+
+struct HistogramSharedMemory::ImportedHistogram {
+  // The histogram of this process the samples go to.
+  Histogram* histogram;
+
+  // Reads the counts in the segment.
+  scoped_ptr<SampleVector> shared_samples;
+
+  // What was imported so far.
+  scoped_ptr<SampleVector> imported_samples;
+};
+
+HistogramSharedMemory::HistogramSharedMemory(scoped_ptr<SharedMemory> memory)
+    : memory_(memory.Pass()),
+      capacity_(0),
+      next_offset_(0) {
+  DCHECK(memory_->memory());
+  if (memory_->mapped_size() > sizeof(SegmentHeader))
+    capacity_ = memory_->mapped_size() - sizeof(SegmentHeader);
+  // Offsets are stored in 32 bits.
+  capacity_ = std::min<size_t>(capacity_, kint32max / 2);
+}
+
+HistogramSharedMemory::~HistogramSharedMemory() {
+  DCHECK_NE(this, g_current_memory);
+}
+
+// static
+void HistogramSharedMemory::SetForCurrentProcess(
+    HistogramSharedMemory* memory) {
+  g_current_memory = memory;
+}
+
+// static
+HistogramSharedMemory* HistogramSharedMemory::GetForCurrentProcess() {
+  return g_current_memory;
+}
+
+bool HistogramSharedMemory::MoveSamples(HistogramBase* histogram_base) {
+  HistogramType type = histogram_base->GetHistogramType();
+  // Custom ranges can't be recreated from the construction arguments, and
+  // sparse histograms have no fixed set of buckets.
+  if (type != HISTOGRAM && type != LINEAR_HISTOGRAM &&
+      type != BOOLEAN_HISTOGRAM) {
+    return false;
+  }
+  Histogram* histogram = static_cast<Histogram*>(histogram_base);
+  const std::string name = histogram->histogram_name();
+  size_t bucket_count = histogram->bucket_count();
+
+  size_t record_size =
+      AlignUp(sizeof(Record) + AlignUp(name.size()) +
+              bucket_count * sizeof(HistogramBase::AtomicCount));
+  if (record_size > capacity_)
+    return false;
+  SegmentHeader* header = static_cast<SegmentHeader*>(memory_->memory());
+  size_t end = subtle::NoBarrier_AtomicIncrement(
+      &header->used_size, static_cast<subtle::Atomic32>(record_size));
+  if (end > capacity_)
+    return false;
+  char* start = records() + end - record_size;
+
+  Record* record = reinterpret_cast<Record*>(start);
+  record->record_size = record_size;
+  record->histogram_type = type;
+  record->flags = histogram->flags();
+  record->declared_min = histogram->declared_min();
+  record->declared_max = histogram->declared_max();
+  record->bucket_count = bucket_count;
+  record->ranges_checksum = histogram->bucket_ranges()->checksum();
+  record->name_length = name.size();
+  memcpy(start + sizeof(Record), name.data(), name.size());
+
+  HistogramBase::AtomicCount* counts =
+      reinterpret_cast<HistogramBase::AtomicCount*>(
+          start + sizeof(Record) + AlignUp(name.size()));
+  histogram->samples_.reset(
+      new SampleVector(histogram->bucket_ranges(), &record->meta, counts));
+  subtle::Release_Store(&record->ready, 1);
+  return true;
+}
+
+void HistogramSharedMemory::ImportNewSamples() {
+  size_t limit = std::min(used_size(), capacity_);
+  while (next_offset_ + sizeof(Record) <= limit) {
+    Record* record = reinterpret_cast<Record*>(records() + next_offset_);
+    if (!subtle::Acquire_Load(&record->ready))
+      break;
+    size_t record_size = record->record_size;
+    if (record_size > limit - next_offset_ || !ImportRecord(next_offset_,
+                                                            record_size)) {
+      DLOG(ERROR) << "Corrupt histogram record at " << next_offset_;
+      // Nothing after a bad record can be trusted to be in the right place.
+      next_offset_ = capacity_;
+      break;
+    }
+    next_offset_ += record_size;
+  }
+
+  for (size_t i = 0; i < imported_.size(); ++i) {
+    ImportedHistogram* imported = imported_[i];
+    const BucketRanges* ranges = imported->histogram->bucket_ranges();
+    scoped_ptr<SampleVector> snapshot(new SampleVector(ranges));
+    snapshot->Add(*imported->shared_samples);
+
+    SampleVector delta(ranges);
+    delta.Add(*snapshot);
+    delta.Subtract(*imported->imported_samples);
+    // The writer bumps the bucket count before the totals, so the totals of
+    // a delta can't be trusted to tell whether there is anything new. A
+    // delta without samples is left for the next import to pick up, in case
+    // its totals moved.
+    if (delta.TotalCount() == 0)
+      continue;
+    imported->histogram->AddSamples(delta);
+    imported->imported_samples.swap(snapshot);
+  }
+}
+
+size_t HistogramSharedMemory::used_size() const {
+  SegmentHeader* header = static_cast<SegmentHeader*>(memory_->memory());
+  return static_cast<uint32>(subtle::Acquire_Load(&header->used_size));
+}
+
+bool HistogramSharedMemory::ImportRecord(size_t offset, size_t record_size) {
+  char* start = records() + offset;
+  // The writer may be hostile, so work from a copy of the header.
+  Record record;
+  memcpy(&record, start, sizeof(record));
+  if (record.record_size != record_size || record_size % kAlignment != 0 ||
+      record.name_length > record_size ||
+      record.bucket_count > Histogram::kBucketCount_MAX ||
+      sizeof(Record) + AlignUp(record.name_length) +
+          record.bucket_count * sizeof(HistogramBase::AtomicCount) >
+          record_size) {
+    return false;
+  }
+
+  std::string name(start + sizeof(Record), record.name_length);
+  int32 flags = record.flags & ~HistogramBase::kIPCSerializationSourceFlag;
+  // The factories below insist on sane arguments that match those of an
+  // existing histogram, so check first. Records that don't fit are skipped
+  // like DeserializeHistogramInfo() would.
+  Histogram::Sample minimum = record.declared_min;
+  Histogram::Sample maximum = record.declared_max;
+  size_t bucket_count = record.bucket_count;
+  if (record.histogram_type != BOOLEAN_HISTOGRAM &&
+      !Histogram::InspectConstructionArguments(name, &minimum, &maximum,
+                                               &bucket_count)) {
+    return true;
+  }
+  HistogramBase* existing = StatisticsRecorder::FindHistogram(name);
+  if (existing &&
+      (existing->GetHistogramType() != record.histogram_type ||
+       !existing->HasConstructionArguments(minimum, maximum, bucket_count))) {
+    return true;
+  }
+
+  HistogramBase* histogram = NULL;
+  switch (record.histogram_type) {
+    case HISTOGRAM:
+      histogram = Histogram::FactoryGet(name, minimum, maximum, bucket_count,
+                                        flags);
+      break;
+    case LINEAR_HISTOGRAM:
+      histogram = LinearHistogram::FactoryGet(name, minimum, maximum,
+                                              bucket_count, flags);
+      break;
+    case BOOLEAN_HISTOGRAM:
+      histogram = BooleanHistogram::FactoryGet(name, flags);
+      break;
+    default:
+      return true;
+  }
+
+  Histogram* local_histogram = static_cast<Histogram*>(histogram);
+  const BucketRanges* ranges = local_histogram->bucket_ranges();
+  if (histogram->GetHistogramType() != record.histogram_type ||
+      ranges->bucket_count() != record.bucket_count ||
+      ranges->checksum() != record.ranges_checksum) {
+    return true;
+  }
+
+  scoped_ptr<ImportedHistogram> imported(new ImportedHistogram);
+  imported->histogram = local_histogram;
+  HistogramBase::AtomicCount* counts =
+      reinterpret_cast<HistogramBase::AtomicCount*>(
+          start + sizeof(Record) + AlignUp(record.name_length));
+  imported->shared_samples.reset(new SampleVector(
+      ranges, &reinterpret_cast<Record*>(start)->meta, counts));
+  imported->imported_samples.reset(new SampleVector(ranges));
+  imported_.push_back(imported.release());
+  return true;
+}
+
+char* HistogramSharedMemory::records() const {
+  return static_cast<char*>(memory_->memory()) + sizeof(SegmentHeader);
+}
+
+}  // namespace base
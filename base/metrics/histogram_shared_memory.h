@@ -0,0 +1,90 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// HistogramSharedMemory keeps the sample counts of a process's histograms in
+// a shared memory segment, so that another process can collect them by
+// reading the segment instead of asking for a pickled delta over IPC.
+//
+// The recording process installs the segment with SetForCurrentProcess()
+// before creating histograms. From then on, each Histogram, LinearHistogram
+// and BooleanHistogram registered with the StatisticsRecorder gets a record
+// in the segment holding its construction arguments and its bucket counts,
+// and Histogram::Add() becomes a relaxed atomic increment there. Other
+// histogram types, and histograms created once the segment is full, keep
+// their counts on the heap and have to be collected the usual way.
+//
+// The collecting process maps the same segment and calls ImportNewSamples()
+// whenever it wants to catch up; the samples recorded since the last call are
+// added to its own histograms of the same names. The segment is treated as
+// untrusted input on that side.
+//
+// The layout is append-only: a header with the number of bytes in use,
+// followed by records that are reserved with an atomic increment of that
+// number and published with a release store once they are filled in. A zero
+// filled segment is a valid, empty one.
+
+#ifndef BASE_METRICS_HISTOGRAM_SHARED_MEMORY_H_
+#define BASE_METRICS_HISTOGRAM_SHARED_MEMORY_H_
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+
+namespace base {
+
+class HistogramBase;
+class SharedMemory;
+
+class BASE_EXPORT HistogramSharedMemory {
+ public:
+  // |memory| must already be mapped.
+  explicit HistogramSharedMemory(scoped_ptr<SharedMemory> memory);
+  ~HistogramSharedMemory();
+
+  // Makes the histograms registered from now on in this process count into
+  // |memory|, or stops doing so if |memory| is NULL. |memory| must outlive all
+  // those histograms, which in practice means it is leaked.
+  static void SetForCurrentProcess(HistogramSharedMemory* memory);
+  static HistogramSharedMemory* GetForCurrentProcess();
+
+  // Moves the sample storage of |histogram| into the segment. Returns false if
+  // the histogram type isn't supported or the segment is full, in which case
+  // |histogram| is left alone. Must be called before any other thread can see
+  // |histogram|; StatisticsRecorder does it while registering it.
+  bool MoveSamples(HistogramBase* histogram);
+
+  // Adds the samples recorded in the segment since the last call to the
+  // histograms of this process with the same names, creating them as needed.
+  void ImportNewSamples();
+
+  // The number of bytes in use in the segment.
+  size_t used_size() const;
+
+ private:
+  struct ImportedHistogram;
+
+  // Validates the record at |offset| and sets up its ImportedHistogram.
+  // Returns false if the record is malformed. A well formed record that
+  // doesn't match the histograms of this process is skipped.
+  bool ImportRecord(size_t offset, size_t record_size);
+
+  char* records() const;
+
+  scoped_ptr<SharedMemory> memory_;
+
+  // The bytes available for records.
+  size_t capacity_;
+
+  // Reading side: the offset of the first record not imported yet, and the
+  // state kept for the ones that were.
+  size_t next_offset_;
+  ScopedVector<ImportedHistogram> imported_;
+
+  DISALLOW_COPY_AND_ASSIGN(HistogramSharedMemory);
+};
+
+}  // namespace base
+
+#endif  // BASE_METRICS_HISTOGRAM_SHARED_MEMORY_H_
@@ -0,0 +1,187 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/histogram_shared_memory.h"
+
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/pickle.h"
+#include "base/process/process_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const size_t kSegmentSize = 64 * 1024;
+
+}  // namespace
+
+class HistogramSharedMemoryTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    statistics_recorder_ = new StatisticsRecorder;
+
+    scoped_ptr<SharedMemory> memory(new SharedMemory);
+    ASSERT_TRUE(memory->CreateAndMapAnonymous(kSegmentSize));
+    SharedMemoryHandle handle;
+    ASSERT_TRUE(memory->ShareToProcess(GetCurrentProcessHandle(), &handle));
+    writer_.reset(new HistogramSharedMemory(memory.Pass()));
+
+    scoped_ptr<SharedMemory> reader_memory(new SharedMemory(handle, false));
+    ASSERT_TRUE(reader_memory->Map(kSegmentSize));
+    reader_.reset(new HistogramSharedMemory(reader_memory.Pass()));
+  }
+
+  virtual void TearDown() OVERRIDE {
+    HistogramSharedMemory::SetForCurrentProcess(NULL);
+    delete statistics_recorder_;
+  }
+
+  // Forgets all histograms, as if the reader ran in another process. The
+  // histograms created so far are leaked and stay usable.
+  void ResetStatisticsRecorder() {
+    delete statistics_recorder_;
+    statistics_recorder_ = new StatisticsRecorder;
+  }
+
+  StatisticsRecorder* statistics_recorder_;
+  scoped_ptr<HistogramSharedMemory> writer_;
+  scoped_ptr<HistogramSharedMemory> reader_;
+};
+
+TEST_F(HistogramSharedMemoryTest, ImportSamples) {
+  HistogramSharedMemory::SetForCurrentProcess(writer_.get());
+  HistogramBase* exponential = Histogram::FactoryGet(
+      "Test.Exponential", 1, 1000, 10, HistogramBase::kNoFlags);
+  HistogramBase* linear = LinearHistogram::FactoryGet(
+      "Test.Linear", 1, 10, 11, HistogramBase::kNoFlags);
+  HistogramBase* boolean = BooleanHistogram::FactoryGet(
+      "Test.Boolean", HistogramBase::kNoFlags);
+  HistogramSharedMemory::SetForCurrentProcess(NULL);
+  EXPECT_LT(0u, writer_->used_size());
+
+  exponential->Add(5);
+  exponential->Add(500);
+  linear->Add(3);
+  boolean->AddBoolean(true);
+
+  ResetStatisticsRecorder();
+  reader_->ImportNewSamples();
+
+  HistogramBase* imported = StatisticsRecorder::FindHistogram(
+      "Test.Exponential");
+  ASSERT_TRUE(imported);
+  EXPECT_NE(exponential, imported);
+  scoped_ptr<HistogramSamples> samples = imported->SnapshotSamples();
+  EXPECT_EQ(2, samples->TotalCount());
+  EXPECT_EQ(505, samples->sum());
+
+  imported = StatisticsRecorder::FindHistogram("Test.Linear");
+  ASSERT_TRUE(imported);
+  EXPECT_EQ(LINEAR_HISTOGRAM, imported->GetHistogramType());
+  EXPECT_EQ(1, imported->SnapshotSamples()->GetCount(3));
+
+  imported = StatisticsRecorder::FindHistogram("Test.Boolean");
+  ASSERT_TRUE(imported);
+  EXPECT_EQ(1, imported->SnapshotSamples()->GetCount(1));
+
+  // Only what's new gets imported the next time.
+  exponential->Add(5);
+  reader_->ImportNewSamples();
+  reader_->ImportNewSamples();
+  samples = StatisticsRecorder::FindHistogram("Test.Exponential")->
+      SnapshotSamples();
+  EXPECT_EQ(3, samples->TotalCount());
+  EXPECT_EQ(2, samples->GetCount(5));
+}
+
+// A sample can be counted in its bucket before the totals catch up.
+TEST_F(HistogramSharedMemoryTest, ImportSamplesAheadOfTotals) {
+  HistogramSharedMemory::SetForCurrentProcess(writer_.get());
+  HistogramBase* histogram = LinearHistogram::FactoryGet(
+      "Test.AheadOfTotals", 1, 10, 11, HistogramBase::kNoFlags);
+  HistogramSharedMemory::SetForCurrentProcess(NULL);
+
+  // One sample of 3, with the sum and redundant count still at zero.
+  Pickle pickle;
+  pickle.WriteInt64(0);
+  pickle.WriteInt(0);
+  pickle.WriteInt(3);
+  pickle.WriteInt(4);
+  pickle.WriteInt(1);
+  PickleIterator iter(pickle);
+  ASSERT_TRUE(histogram->AddSamplesFromPickle(&iter));
+
+  ResetStatisticsRecorder();
+  reader_->ImportNewSamples();
+  HistogramBase* imported =
+      StatisticsRecorder::FindHistogram("Test.AheadOfTotals");
+  ASSERT_TRUE(imported);
+  scoped_ptr<HistogramSamples> samples = imported->SnapshotSamples();
+  EXPECT_EQ(1, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(3));
+}
+
+TEST_F(HistogramSharedMemoryTest, UnsupportedTypesStayOnHeap) {
+  HistogramSharedMemory::SetForCurrentProcess(writer_.get());
+  std::vector<HistogramBase::Sample> custom_ranges;
+  custom_ranges.push_back(1);
+  custom_ranges.push_back(5);
+  HistogramBase* custom = CustomHistogram::FactoryGet(
+      "Test.Custom", custom_ranges, HistogramBase::kNoFlags);
+  HistogramSharedMemory::SetForCurrentProcess(NULL);
+  EXPECT_EQ(0u, writer_->used_size());
+
+  custom->Add(2);
+  EXPECT_EQ(1, custom->SnapshotSamples()->TotalCount());
+}
+
+TEST_F(HistogramSharedMemoryTest, FullSegment) {
+  HistogramSharedMemory::SetForCurrentProcess(writer_.get());
+  // Each of these needs about 40KB of counts, so only the first one fits.
+  HistogramBase* first = Histogram::FactoryGet(
+      "Test.First", 1, 1000000, 10000, HistogramBase::kNoFlags);
+  size_t used_size = writer_->used_size();
+  HistogramBase* second = Histogram::FactoryGet(
+      "Test.Second", 1, 1000000, 10000, HistogramBase::kNoFlags);
+  HistogramSharedMemory::SetForCurrentProcess(NULL);
+  EXPECT_LT(0u, used_size);
+  EXPECT_LT(kSegmentSize, writer_->used_size());
+
+  first->Add(10);
+  second->Add(10);
+  EXPECT_EQ(1, second->SnapshotSamples()->TotalCount());
+
+  ResetStatisticsRecorder();
+  reader_->ImportNewSamples();
+  EXPECT_TRUE(StatisticsRecorder::FindHistogram("Test.First"));
+  EXPECT_FALSE(StatisticsRecorder::FindHistogram("Test.Second"));
+}
+
+TEST_F(HistogramSharedMemoryTest, MismatchedHistogramIsSkipped) {
+  HistogramSharedMemory::SetForCurrentProcess(writer_.get());
+  HistogramBase* mismatched = Histogram::FactoryGet(
+      "Test.Mismatched", 1, 1000, 10, HistogramBase::kNoFlags);
+  HistogramBase* matched = Histogram::FactoryGet(
+      "Test.Matched", 1, 1000, 10, HistogramBase::kNoFlags);
+  HistogramSharedMemory::SetForCurrentProcess(NULL);
+  mismatched->Add(1);
+  matched->Add(1);
+
+  ResetStatisticsRecorder();
+  HistogramBase* local = Histogram::FactoryGet(
+      "Test.Mismatched", 1, 100, 5, HistogramBase::kNoFlags);
+  reader_->ImportNewSamples();
+  EXPECT_EQ(0, local->SnapshotSamples()->TotalCount());
+  EXPECT_EQ(1, StatisticsRecorder::FindHistogram("Test.Matched")->
+                   SnapshotSamples()->TotalCount());
+}
+
+}  // namespace base
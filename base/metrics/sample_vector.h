@@ -23,6 +23,12 @@ class BucketRanges;
 class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
  public:
   explicit SampleVector(const BucketRanges* bucket_ranges);
+  // Counts into |counts|, which must have room for a count per bucket, and
+  // keeps the totals in |meta|. Both are owned by the caller, typically in
+  // shared memory, and must outlive this object.
+  SampleVector(const BucketRanges* bucket_ranges,
+               Metadata* meta,
+               HistogramBase::AtomicCount* counts);
   virtual ~SampleVector();
 
   // HistogramSamples implementation:
@@ -46,7 +52,10 @@ class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
  private:
   FRIEND_TEST_ALL_PREFIXES(HistogramTest, CorruptSampleCounts);
 
-  std::vector<HistogramBase::AtomicCount> counts_;
+  // Backs |counts_| unless the counts were supplied by the caller.
+  std::vector<HistogramBase::AtomicCount> local_counts_;
+  HistogramBase::AtomicCount* const counts_;
+  const size_t counts_size_;
 
   // Shares the same BucketRanges with Histogram object.
   const BucketRanges* const bucket_ranges_;
@@ -56,7 +65,8 @@ class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
 
 class BASE_EXPORT_PRIVATE SampleVectorIterator : public SampleCountIterator {
  public:
-  SampleVectorIterator(const std::vector<HistogramBase::AtomicCount>* counts,
+  SampleVectorIterator(const HistogramBase::AtomicCount* counts,
+                       size_t counts_size,
                        const BucketRanges* bucket_ranges);
   virtual ~SampleVectorIterator();
 
@@ -73,7 +83,8 @@ class BASE_EXPORT_PRIVATE SampleVectorIterator : public SampleCountIterator {
  private:
   void SkipEmptyBuckets();
 
-  const std::vector<HistogramBase::AtomicCount>* counts_;
+  const HistogramBase::AtomicCount* counts_;
+  size_t counts_size_;
   const BucketRanges* bucket_ranges_;
 
   size_t index_;
@@ -42,6 +42,35 @@ TEST(SampleVectorTest, AccumulateTest) {
   EXPECT_EQ(samples.TotalCount(), samples.redundant_count());
 }
 
+TEST(SampleVectorTest, ExternalStorageTest) {
+  // Custom buckets: [1, 5) [5, 10)
+  BucketRanges ranges(3);
+  ranges.set_range(0, 1);
+  ranges.set_range(1, 5);
+  ranges.set_range(2, 10);
+
+  HistogramSamples::Metadata meta = { 0, 0 };
+  HistogramBase::AtomicCount counts[2] = { 0, 0 };
+  SampleVector samples(&ranges, &meta, counts);
+
+  samples.Accumulate(1, 200);
+  samples.Accumulate(5, 100);
+  EXPECT_EQ(200, counts[0]);
+  EXPECT_EQ(100, counts[1]);
+  EXPECT_EQ(700, meta.sum);
+  EXPECT_EQ(300, meta.redundant_count);
+
+  // Another vector over the same storage sees the same samples.
+  SampleVector view(&ranges, &meta, counts);
+  EXPECT_EQ(100, view.GetCount(5));
+  EXPECT_EQ(700, view.sum());
+
+  SampleVector copy(&ranges);
+  copy.Add(view);
+  EXPECT_EQ(300, copy.TotalCount());
+  EXPECT_EQ(copy.redundant_count(), copy.TotalCount());
+}
+
 TEST(SampleVectorTest, AddSubtractTest) {
   // Custom buckets: [0, 1) [1, 2) [2, 3) [3, INT_MAX)
   BucketRanges ranges(5);
@@ -185,7 +214,7 @@ TEST(SampleVectorIteratorTest, IterateTest) {
   counts[2] = 2;
 
   // BucketRanges can have larger size than counts.
-  SampleVectorIterator it(&counts, &ranges);
+  SampleVectorIterator it(&counts[0], counts.size(), &ranges);
   size_t index;
 
   HistogramBase::Sample min;
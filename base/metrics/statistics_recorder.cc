@@ -10,6 +10,7 @@
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_shared_memory.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/lock.h"
 #include "base/values.h"
@@ -63,6 +64,11 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
       const string& name = histogram->histogram_name();
       HistogramMap::iterator it = histograms_->find(name);
       if (histograms_->end() == it) {
+        // Nothing else can see |histogram| yet, so its samples can still move.
+        HistogramSharedMemory* shared_memory =
+            HistogramSharedMemory::GetForCurrentProcess();
+        if (shared_memory)
+          shared_memory->MoveSamples(histogram);
         (*histograms_)[name] = histogram;
         ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
         histogram_to_return = histogram;
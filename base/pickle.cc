@@ -141,6 +141,31 @@ bool PickleIterator::ReadString16(string16* result) {
   return true;
 }
 
+bool PickleIterator::ReadStringPiece(base::StringPiece* result) {
+  int len;
+  if (!ReadInt(&len))
+    return false;
+  const char* read_from = GetReadPointerAndAdvance(len);
+  if (!read_from)
+    return false;
+
+  result->set(read_from, len);
+  return true;
+}
+
+bool PickleIterator::ReadStringPiece16(base::StringPiece16* result) {
+  int len;
+  if (!ReadInt(&len))
+    return false;
+  const char* read_from = GetReadPointerAndAdvance(len, sizeof(char16));
+  if (!read_from)
+    return false;
+
+  *result = base::StringPiece16(reinterpret_cast<const char16*>(read_from),
+                                len);
+  return true;
+}
+
 bool PickleIterator::ReadData(const char** data, int* length) {
   *length = 0;
   *data = 0;
@@ -259,10 +284,36 @@ bool Pickle::WriteString16(const string16& value) {
                     static_cast<int>(value.size()) * sizeof(char16));
 }
 
+bool Pickle::WriteStringPiece(const base::StringPiece& value) {
+  if (!WriteInt(static_cast<int>(value.size())))
+    return false;
+
+  return WriteBytes(value.data(), static_cast<int>(value.size()));
+}
+
 bool Pickle::WriteData(const char* data, int length) {
   return length >= 0 && WriteInt(length) && WriteBytes(data, length);
 }
 
+bool Pickle::WriteDataSegments(const base::StringPiece* segments,
+                               size_t num_segments) {
+  size_t length = 0;
+  for (size_t i = 0; i < num_segments; ++i) {
+    if (segments[i].size() > static_cast<size_t>(kint32max) - length)
+      return false;
+    length += segments[i].size();
+  }
+
+  Reserve(sizeof(int) + length);
+  WriteInt(static_cast<int>(length));
+  char* write = ClaimBytes(length);
+  for (size_t i = 0; i < num_segments; ++i) {
+    memcpy(write, segments[i].data(), segments[i].size());
+    write += segments[i].size();
+  }
+  return true;
+}
+
 bool Pickle::WriteBytes(const void* data, int length) {
   WriteBytesCommon(data, length);
   return true;
@@ -316,6 +367,10 @@ template void Pickle::WriteBytesStatic<4>(const void* data);
 template void Pickle::WriteBytesStatic<8>(const void* data);
 
 inline void Pickle::WriteBytesCommon(const void* data, size_t length) {
+  memcpy(ClaimBytes(length), data, length);
+}
+
+inline char* Pickle::ClaimBytes(size_t length) {
   DCHECK_NE(kCapacityReadOnly, capacity_after_header_)
       << "oops: pickle is readonly";
   size_t data_len = AlignInt(length, sizeof(uint32));
@@ -330,8 +385,8 @@ inline void Pickle::WriteBytesCommon(const void* data, size_t length) {
   }
 
   char* write = mutable_payload() + write_offset_;
-  memcpy(write, data, length);
   memset(write + length, 0, data_len - length);
   header_->payload_size = static_cast<uint32>(write_offset_ + length);
   write_offset_ = new_size;
+  return write;
 }
@@ -13,6 +13,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_piece.h"
 
 class Pickle;
 
@@ -38,6 +39,11 @@ class BASE_EXPORT PickleIterator {
   bool ReadString(std::string* result) WARN_UNUSED_RESULT;
   bool ReadWString(std::wstring* result) WARN_UNUSED_RESULT;
   bool ReadString16(base::string16* result) WARN_UNUSED_RESULT;
+  // Like ReadString() and ReadString16(), but the result points into the
+  // Pickle's buffer instead of being copied out, so it is only valid for as
+  // long as the Pickle is.
+  bool ReadStringPiece(base::StringPiece* result) WARN_UNUSED_RESULT;
+  bool ReadStringPiece16(base::StringPiece16* result) WARN_UNUSED_RESULT;
   bool ReadData(const char** data, int* length) WARN_UNUSED_RESULT;
   bool ReadBytes(const char** data, int length) WARN_UNUSED_RESULT;
 
@@ -244,9 +250,18 @@ class BASE_EXPORT Pickle {
   bool WriteString(const std::string& value);
   bool WriteWString(const std::wstring& value);
   bool WriteString16(const base::string16& value);
+  // Writes the same format as WriteString(), without requiring the caller to
+  // build a std::string first.
+  bool WriteStringPiece(const base::StringPiece& value);
   // "Data" is a blob with a length. When you read it out you will be given the
   // length. See also WriteBytes.
   bool WriteData(const char* data, int length);
+  // Writes |num_segments| buffers as a single "Data" blob, which is read back
+  // with ReadData() or ReadStringPiece(). The segments are copied straight
+  // into the Pickle after growing it once, so callers with a payload split
+  // over several buffers don't have to concatenate it into a temporary.
+  bool WriteDataSegments(const base::StringPiece* segments,
+                         size_t num_segments);
   // "Bytes" is a blob with no length. The caller must specify the length both
   // when reading and writing. It is normally used to serialize PoD types of a
   // known size. See also WriteData.
@@ -338,6 +353,9 @@ class BASE_EXPORT Pickle {
     return true;
   }
   inline void WriteBytesCommon(const void* data, size_t length);
+  // Grows the payload by |length| bytes plus alignment padding, zeroes the
+  // padding and returns where the caller should write the bytes.
+  inline char* ClaimBytes(size_t length);
 
   FRIEND_TEST_ALL_PREFIXES(PickleTest, Resize);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, FindNext);
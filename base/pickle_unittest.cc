@@ -8,6 +8,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/pickle.h"
 #include "base/strings/string16.h"
+#include "base/strings/utf_string_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 // Remove when this file is in the base namespace.
@@ -362,3 +363,75 @@ TEST(PickleTest, ReadBytes) {
   memcpy(&outdata, outdata_char, sizeof(outdata));
   EXPECT_EQ(data, outdata);
 }
+
+TEST(PickleTest, ReadStringPiece) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteString(teststr));
+  EXPECT_TRUE(pickle.WriteString16(base::ASCIIToUTF16(teststr)));
+
+  PickleIterator iter(pickle);
+  base::StringPiece piece;
+  EXPECT_TRUE(iter.ReadStringPiece(&piece));
+  EXPECT_EQ(teststr, piece.as_string());
+  // The piece refers to the Pickle's own buffer.
+  EXPECT_TRUE(piece.data() > pickle.payload());
+  EXPECT_TRUE(piece.data() < pickle.end_of_payload());
+
+  base::StringPiece16 piece16;
+  EXPECT_TRUE(iter.ReadStringPiece16(&piece16));
+  EXPECT_EQ(base::ASCIIToUTF16(teststr), piece16.as_string());
+
+  EXPECT_FALSE(iter.ReadStringPiece(&piece));
+}
+
+TEST(PickleTest, BadLenStringPiece) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteInt(-2));
+
+  PickleIterator iter(pickle);
+  base::StringPiece piece;
+  EXPECT_FALSE(iter.ReadStringPiece(&piece));
+}
+
+TEST(PickleTest, WriteStringPiece) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteStringPiece(teststr));
+  EXPECT_TRUE(pickle.WriteInt(testint));
+
+  PickleIterator iter(pickle);
+  std::string outstr;
+  EXPECT_TRUE(pickle.ReadString(&iter, &outstr));
+  EXPECT_EQ(teststr, outstr);
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  EXPECT_EQ(testint, outint);
+}
+
+TEST(PickleTest, WriteDataSegments) {
+  const base::StringPiece segments[] = {
+    base::StringPiece("abc"),
+    base::StringPiece(),
+    base::StringPiece(testdata, testdatalen),
+  };
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteDataSegments(segments, arraysize(segments)));
+  // Following fields keep their alignment.
+  EXPECT_TRUE(pickle.WriteInt(testint));
+  EXPECT_TRUE(pickle.WriteDataSegments(NULL, 0));
+
+  PickleIterator iter(pickle);
+  const char* outdata;
+  int outdatalen;
+  EXPECT_TRUE(pickle.ReadData(&iter, &outdata, &outdatalen));
+  EXPECT_EQ(3 + testdatalen, outdatalen);
+  EXPECT_EQ(0, memcmp("abc", outdata, 3));
+  EXPECT_EQ(0, memcmp(testdata, outdata + 3, testdatalen));
+
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  EXPECT_EQ(testint, outint);
+
+  base::StringPiece piece;
+  EXPECT_TRUE(iter.ReadStringPiece(&piece));
+  EXPECT_TRUE(piece.empty());
+}
@@ -139,6 +139,12 @@ void FileThreadDeserializer::HandleErrors(
   }
 }
 
+bool SerializePrefs(const base::DictionaryValue* prefs, std::string* output) {
+  JSONStringValueSerializer serializer(output);
+  serializer.set_pretty_print(true);
+  return serializer.Serialize(*prefs);
+}
+
 }  // namespace
 
 scoped_refptr<base::SequencedTaskRunner> JsonPrefStore::GetTaskRunnerForFile(
@@ -333,7 +339,14 @@ bool JsonPrefStore::SerializeData(std::string* output) {
   if (pref_filter_)
     pref_filter_->FilterSerializeData(prefs_.get());
 
-  JSONStringValueSerializer serializer(output);
-  serializer.set_pretty_print(true);
-  return serializer.Serialize(*prefs_);
+  return SerializePrefs(prefs_.get(), output);
+}
+
+JsonPrefStore::BackgroundSerializer JsonPrefStore::GetBackgroundSerializer() {
+  if (pref_filter_)
+    pref_filter_->FilterSerializeData(prefs_.get());
+
+  // Copying the values is cheaper than turning them into JSON, so the
+  // latter is left to the file task runner.
+  return base::Bind(&SerializePrefs, base::Owned(prefs_->DeepCopy()));
 }
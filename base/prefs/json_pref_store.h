@@ -79,6 +79,7 @@ class BASE_PREFS_EXPORT JsonPrefStore
 
   // ImportantFileWriter::DataSerializer overrides:
   virtual bool SerializeData(std::string* output) OVERRIDE;
+  virtual BackgroundSerializer GetBackgroundSerializer() OVERRIDE;
 
   base::FilePath path_;
   const scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner_;
@@ -361,28 +361,18 @@ std::string UTF16ToASCII(const string16& utf16) {
   return std::string(utf16.begin(), utf16.end());
 }
 
-template<class STR>
-static bool DoIsStringASCII(const STR& str) {
-  for (size_t i = 0; i < str.length(); i++) {
-    typename ToUnsigned<typename STR::value_type>::Unsigned c = str[i];
-    if (c > 0x7F)
-      return false;
-  }
-  return true;
-}
-
 #if !defined(WCHAR_T_IS_UTF16)
 bool IsStringASCII(const std::wstring& str) {
-  return DoIsStringASCII(str);
+  return base::CountLeadingASCII(str.data(), str.length()) == str.length();
 }
 #endif
 
 bool IsStringASCII(const string16& str) {
-  return DoIsStringASCII(str);
+  return base::CountLeadingASCII(str.data(), str.length()) == str.length();
 }
 
 bool IsStringASCII(const base::StringPiece& str) {
-  return DoIsStringASCII(str);
+  return base::CountLeadingASCII(str.data(), str.length()) == str.length();
 }
 
 bool IsStringUTF8(const std::string& str) {
@@ -403,16 +393,56 @@ template<typename Iter>
 static inline bool DoLowerCaseEqualsASCII(Iter a_begin,
                                           Iter a_end,
                                           const char* b) {
+  // |b| is typically a short literal, so getting its length is cheap and
+  // rules out most mismatches before comparing any characters.
+  if (static_cast<size_t>(a_end - a_begin) != strlen(b))
+    return false;
   for (Iter it = a_begin; it != a_end; ++it, ++b) {
-    if (!*b || base::ToLowerASCII(*it) != *b)
+    if (base::ToLowerASCII(*it) != *b)
+      return false;
+  }
+  return true;
+}
+
+// Lower cases the ASCII letters among the eight bytes of |word|, leaving the
+// other bytes alone.
+static inline uint64 ToLowerASCIIWord(uint64 word) {
+  const uint64 kOnes = GG_UINT64_C(0x0101010101010101);
+  // The high bit of a byte ends up set in |at_least_a| if its low seven bits
+  // are >= 'A', and in |above_z| if they are > 'Z'. The sums can't carry into
+  // the next byte.
+  uint64 low_bits = word & (0x7F * kOnes);
+  uint64 at_least_a = low_bits + (0x80 - 'A') * kOnes;
+  uint64 above_z = low_bits + (0x7F - 'Z') * kOnes;
+  uint64 is_upper = at_least_a & ~above_z & ~word & (0x80 * kOnes);
+  return word | (is_upper >> 2);
+}
+
+// Like DoLowerCaseEqualsASCII(), but compares eight bytes at a time.
+static bool DoLowerCaseEqualsASCIIBytes(const char* a,
+                                        size_t a_length,
+                                        const char* b) {
+  if (a_length != strlen(b))
+    return false;
+  size_t i = 0;
+  for (; i + sizeof(uint64) <= a_length; i += sizeof(uint64)) {
+    uint64 a_word;
+    uint64 b_word;
+    memcpy(&a_word, a + i, sizeof(a_word));
+    memcpy(&b_word, b + i, sizeof(b_word));
+    if (ToLowerASCIIWord(a_word) != b_word)
+      return false;
+  }
+  for (; i < a_length; ++i) {
+    if (base::ToLowerASCII(a[i]) != b[i])
       return false;
   }
-  return *b == 0;
+  return true;
 }
 
 // Front-ends for LowerCaseEqualsASCII.
 bool LowerCaseEqualsASCII(const std::string& a, const char* b) {
-  return DoLowerCaseEqualsASCII(a.begin(), a.end(), b);
+  return DoLowerCaseEqualsASCIIBytes(a.data(), a.length(), b);
 }
 
 bool LowerCaseEqualsASCII(const string16& a, const char* b) {
@@ -422,7 +452,9 @@ bool LowerCaseEqualsASCII(const string16& a, const char* b) {
 bool LowerCaseEqualsASCII(std::string::const_iterator a_begin,
                           std::string::const_iterator a_end,
                           const char* b) {
-  return DoLowerCaseEqualsASCII(a_begin, a_end, b);
+  if (a_begin == a_end)
+    return !*b;
+  return DoLowerCaseEqualsASCIIBytes(&*a_begin, a_end - a_begin, b);
 }
 
 bool LowerCaseEqualsASCII(string16::const_iterator a_begin,
@@ -436,7 +468,7 @@ bool LowerCaseEqualsASCII(string16::const_iterator a_begin,
 bool LowerCaseEqualsASCII(const char* a_begin,
                           const char* a_end,
                           const char* b) {
-  return DoLowerCaseEqualsASCII(a_begin, a_end, b);
+  return DoLowerCaseEqualsASCIIBytes(a_begin, a_end - a_begin, b);
 }
 
 bool LowerCaseEqualsASCII(const char16* a_begin,
@@ -0,0 +1,121 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the ASCII checks, case-insensitive comparisons and UTF conversions
+// that URL handling and HTTP header parsing spend their time in.
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string16.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kIterations = 100000;
+
+const char* const kURLs[] = {
+  "http://www.google.com/",
+  "https://www.example.com/search?q=chromium+perf&ie=UTF-8&oe=UTF-8",
+  "https://mail.example.com/mail/u/0/?tab=wm#inbox/13f2d4b8c9a7e6f1",
+  "http://cdn.example.net/static/js/application.min.js?v=20140301.1",
+  "https://fonts.example.com/css?family=Open+Sans:400italic,700,400",
+};
+
+// A few request and response header names, and the names they are commonly
+// looked up by.
+const char* const kHeaderNames[] = {
+  "Host", "User-Agent", "Accept", "Accept-Language", "Accept-Encoding",
+  "Cookie", "Connection", "Cache-Control", "Content-Type", "Content-Length",
+  "Last-Modified", "ETag", "Set-Cookie", "Transfer-Encoding", "Vary",
+};
+
+const char* const kLookedUpNames[] = {
+  "content-type", "content-length", "set-cookie", "transfer-encoding",
+};
+
+void PrintTime(const std::string& trace, TimeDelta elapsed, double count) {
+  perf_test::PrintResult(trace, "", "",
+                         elapsed.InMicroseconds() * 1000.0 / count, "ns",
+                         true);
+}
+
+}  // namespace
+
+TEST(StringUtilPerfTest, IsStringASCII) {
+  std::vector<std::string> urls(kURLs, kURLs + arraysize(kURLs));
+  std::vector<string16> urls16;
+  for (size_t i = 0; i < urls.size(); ++i)
+    urls16.push_back(ASCIIToUTF16(urls[i]));
+
+  int ascii = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < urls.size(); ++j)
+      ascii += IsStringASCII(urls[j]);
+  }
+  PrintTime("is_ascii_url", TimeTicks::Now() - start,
+            static_cast<double>(kIterations) * urls.size());
+
+  start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < urls16.size(); ++j)
+      ascii += IsStringASCII(urls16[j]);
+  }
+  PrintTime("is_ascii_url16", TimeTicks::Now() - start,
+            static_cast<double>(kIterations) * urls16.size());
+  EXPECT_EQ(2 * kIterations * static_cast<int>(urls.size()), ascii);
+}
+
+TEST(StringUtilPerfTest, LowerCaseEqualsASCII) {
+  std::vector<std::string> names(kHeaderNames,
+                                 kHeaderNames + arraysize(kHeaderNames));
+  int matches = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < names.size(); ++j) {
+      for (size_t k = 0; k < arraysize(kLookedUpNames); ++k)
+        matches += LowerCaseEqualsASCII(names[j], kLookedUpNames[k]);
+    }
+  }
+  PrintTime("lower_case_equals_header", TimeTicks::Now() - start,
+            static_cast<double>(kIterations) * names.size() *
+                arraysize(kLookedUpNames));
+  EXPECT_EQ(4 * kIterations, matches);
+}
+
+TEST(StringUtilPerfTest, UTFConversions) {
+  std::vector<std::string> urls(kURLs, kURLs + arraysize(kURLs));
+  // Something of the omnibox kind: mostly ASCII with a few non-ASCII words.
+  urls.push_back("https://de.example.org/wiki/M\xc3\xbcnchen_Hauptbahnhof");
+  urls.push_back("http://example.jp/\xe6\x9d\xb1\xe4\xba\xac/index.html");
+
+  std::vector<string16> urls16;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    urls16.clear();
+    for (size_t j = 0; j < urls.size(); ++j)
+      urls16.push_back(UTF8ToUTF16(urls[j]));
+  }
+  PrintTime("utf8_to_utf16_url", TimeTicks::Now() - start,
+            static_cast<double>(kIterations) * urls.size());
+
+  size_t length = 0;
+  start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < urls16.size(); ++j)
+      length += UTF16ToUTF8(urls16[j]).length();
+  }
+  PrintTime("utf16_to_utf8_url", TimeTicks::Now() - start,
+            static_cast<double>(kIterations) * urls16.size());
+  EXPECT_LT(0u, length);
+}
+
+}  // namespace base
@@ -403,6 +403,32 @@ TEST(StringUtilTest, IsStringUTF8) {
   EXPECT_FALSE(IsStringUTF8("embedded\xc0\x80U+0000"));
 }
 
+TEST(StringUtilTest, IsStringASCII) {
+  static const char kASCII[] =
+      "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  const size_t kLength = arraysize(kASCII) - 1;
+
+  // Put a non-ASCII character at every position of every substring, so that
+  // both the word-at-a-time and the character-at-a-time paths see it at all
+  // alignments.
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; offset + length <= kLength; ++length) {
+      std::string str(kASCII + offset, length);
+      string16 str16(ASCIIToUTF16(str));
+      EXPECT_TRUE(IsStringASCII(str));
+      EXPECT_TRUE(IsStringASCII(str16));
+      for (size_t position = 0; position < length; ++position) {
+        str[position] = '\x80';
+        str16[position] = 0x100;
+        EXPECT_FALSE(IsStringASCII(str));
+        EXPECT_FALSE(IsStringASCII(str16));
+        str[position] = kASCII[offset + position];
+        str16[position] = kASCII[offset + position];
+      }
+    }
+  }
+}
+
 TEST(StringUtilTest, ConvertASCII) {
   static const char* char_cases[] = {
     "Google Video",
@@ -480,6 +506,9 @@ TEST(StringUtilTest, LowerCaseEqualsASCII) {
     { "FoO", "foo" },
     { "foo", "foo" },
     { "FOO", "foo" },
+    { "", "" },
+    { "Content-Type", "content-type" },
+    { "ACCEPT-ENCODING: GZIP@[Z]", "accept-encoding: gzip@[z]" },
   };
 
   for (size_t i = 0; i < ARRAYSIZE_UNSAFE(lowercase_cases); ++i) {
@@ -487,6 +516,27 @@ TEST(StringUtilTest, LowerCaseEqualsASCII) {
                                      lowercase_cases[i].dst));
     EXPECT_TRUE(LowerCaseEqualsASCII(lowercase_cases[i].src_a,
                                      lowercase_cases[i].dst));
+    std::string src(lowercase_cases[i].src_a);
+    EXPECT_TRUE(LowerCaseEqualsASCII(src.begin(), src.end(),
+                                     lowercase_cases[i].dst));
+  }
+
+  static const struct {
+    const char*    src_a;
+    const char*    dst;
+  } mismatch_cases[] = {
+    { "foo", "fo" },
+    { "fo", "foo" },
+    { "Content-Type", "content-typf" },
+    { "Content-Type", "Content-Type" },
+    { "Content-Length", "content-lengtH" },
+  };
+
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(mismatch_cases); ++i) {
+    EXPECT_FALSE(LowerCaseEqualsASCII(ASCIIToUTF16(mismatch_cases[i].src_a),
+                                      mismatch_cases[i].dst));
+    EXPECT_FALSE(LowerCaseEqualsASCII(mismatch_cases[i].src_a,
+                                      mismatch_cases[i].dst));
   }
 }
 
@@ -4,10 +4,62 @@
 
 #include "base/strings/utf_string_conversion_utils.h"
 
+#include "base/strings/string_util.h"
 #include "base/third_party/icu/icu_utf.h"
 
 namespace base {
 
+namespace {
+
+typedef uintptr_t MachineWord;
+
+// The bits that are set in a MachineWord full of |CHAR|s iff one of them is
+// not ASCII.
+template<typename CHAR>
+MachineWord NonASCIIMask() {
+  typedef typename ToUnsigned<CHAR>::Unsigned Unit;
+  const Unit kMaxUnit = static_cast<Unit>(~static_cast<Unit>(0));
+  // Dividing all ones by the largest code unit gives a 1 in each code unit.
+  return ~static_cast<MachineWord>(0) / kMaxUnit *
+      static_cast<Unit>(kMaxUnit & ~0x7F);
+}
+
+template<typename CHAR>
+inline bool IsASCIIUnit(CHAR c) {
+  return static_cast<typename ToUnsigned<CHAR>::Unsigned>(c) <= 0x7F;
+}
+
+template<typename CHAR>
+size_t DoCountLeadingASCII(const CHAR* src, size_t src_len) {
+  const CHAR* const end = src + src_len;
+  const CHAR* current = src;
+
+  // Go one character at a time until |current| is aligned for word reads.
+  while (current != end &&
+         reinterpret_cast<uintptr_t>(current) % sizeof(MachineWord) != 0) {
+    if (!IsASCIIUnit(*current))
+      return current - src;
+    ++current;
+  }
+
+  // Then two words at a time, until a word has a non-ASCII character in it.
+  const size_t kCharsPerWord = sizeof(MachineWord) / sizeof(CHAR);
+  const MachineWord kMask = NonASCIIMask<CHAR>();
+  while (static_cast<size_t>(end - current) >= 2 * kCharsPerWord) {
+    const MachineWord* words = reinterpret_cast<const MachineWord*>(current);
+    if ((words[0] | words[1]) & kMask)
+      break;
+    current += 2 * kCharsPerWord;
+  }
+
+  // And finish, or find the non-ASCII character, one character at a time.
+  while (current != end && IsASCIIUnit(*current))
+    ++current;
+  return current - src;
+}
+
+}  // namespace
+
 // ReadUnicodeCharacter --------------------------------------------------------
 
 bool ReadUnicodeCharacter(const char* src,
@@ -66,6 +118,22 @@ bool ReadUnicodeCharacter(const wchar_t* src,
 }
 #endif  // defined(WCHAR_T_IS_UTF32)
 
+// CountLeadingASCII -----------------------------------------------------------
+
+size_t CountLeadingASCII(const char* src, size_t src_len) {
+  return DoCountLeadingASCII(src, src_len);
+}
+
+size_t CountLeadingASCII(const char16* src, size_t src_len) {
+  return DoCountLeadingASCII(src, src_len);
+}
+
+#if defined(WCHAR_T_IS_UTF32)
+size_t CountLeadingASCII(const wchar_t* src, size_t src_len) {
+  return DoCountLeadingASCII(src, src_len);
+}
+#endif  // defined(WCHAR_T_IS_UTF32)
+
 // WriteUnicodeCharacter -------------------------------------------------------
 
 size_t WriteUnicodeCharacter(uint32 code_point, std::string* output) {
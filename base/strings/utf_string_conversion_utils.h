@@ -56,6 +56,17 @@ BASE_EXPORT bool ReadUnicodeCharacter(const wchar_t* src,
                                       uint32* code_point);
 #endif  // defined(WCHAR_T_IS_UTF32)
 
+// CountLeadingASCII -----------------------------------------------------------
+
+// Returns the number of characters at the start of |src| that are ASCII. Long
+// inputs are checked a couple of machine words at a time rather than one
+// character at a time.
+BASE_EXPORT size_t CountLeadingASCII(const char* src, size_t src_len);
+BASE_EXPORT size_t CountLeadingASCII(const char16* src, size_t src_len);
+#if defined(WCHAR_T_IS_UTF32)
+BASE_EXPORT size_t CountLeadingASCII(const wchar_t* src, size_t src_len);
+#endif  // defined(WCHAR_T_IS_UTF32)
+
 // WriteUnicodeCharacter -------------------------------------------------------
 
 // Appends a UTF-8 character to the given 8-bit string.  Returns the number of
@@ -26,6 +26,15 @@ bool ConvertUnicode(const SRC_CHAR* src,
   bool success = true;
   int32 src_len32 = static_cast<int32>(src_len);
   for (int32 i = 0; i < src_len32; i++) {
+    // ASCII maps to the same code units in every encoding, so copy runs of it
+    // in bulk.
+    if (static_cast<typename ToUnsigned<SRC_CHAR>::Unsigned>(src[i]) < 0x80) {
+      size_t ascii_len = CountLeadingASCII(src + i, src_len - i);
+      output->append(src + i, src + i + ascii_len);
+      i += static_cast<int32>(ascii_len) - 1;
+      continue;
+    }
+
     uint32 code_point;
     if (ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
       WriteUnicodeCharacter(code_point, output);
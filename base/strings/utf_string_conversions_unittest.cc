@@ -208,4 +208,27 @@ TEST(UTFStringConversionsTest, ConvertMultiString) {
   EXPECT_EQ(expected, converted);
 }
 
+TEST(UTFStringConversionsTest, ConvertMixedASCIIRuns) {
+  // Long ASCII runs take the bulk copy path; the characters around them don't.
+  const std::string ascii("http://www.example.com/path/to/some/resource?q=1");
+  const std::string utf8 = "\xe4\xbd\xa0" + ascii + "\xe5\xa5\xbd" + ascii +
+      "\xF0\x90\x8C\x80";
+  string16 utf16 = UTF8ToUTF16(utf8);
+  ASSERT_EQ(1 + ascii.length() + 1 + ascii.length() + 2, utf16.length());
+  EXPECT_EQ(0x4f60, utf16[0]);
+  EXPECT_EQ(ASCIIToUTF16(ascii), utf16.substr(1, ascii.length()));
+  EXPECT_EQ(0x597d, utf16[1 + ascii.length()]);
+  EXPECT_EQ(0xd800, utf16[utf16.length() - 2]);
+  EXPECT_EQ(utf8, UTF16ToUTF8(utf16));
+
+  // An invalid byte right after an ASCII run is still replaced.
+  string16 converted;
+  EXPECT_FALSE(UTF8ToUTF16((ascii + "\xff" + ascii).data(),
+                           2 * ascii.length() + 1, &converted));
+  EXPECT_EQ(ASCIIToUTF16(ascii) + static_cast<char16>(0xFFFD) +
+                ASCIIToUTF16(ascii),
+            converted);
+  EXPECT_EQ(UTF8ToWide(utf8), UTF16ToWide(utf16));
+}
+
 }  // base
@@ -0,0 +1,129 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/parallel_for.h"
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/callback.h"
+#include "base/logging.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/parallel_worker_pool.h"
+
+namespace base {
+
+namespace {
+
+class ParallelForJob : public internal::ParallelJob {
+ public:
+  ParallelForJob(size_t begin,
+                 size_t end,
+                 size_t grain_size,
+                 const Callback<void(size_t, size_t)>& body,
+                 const CancellationFlag* cancel)
+      : begin_(begin),
+        end_(end),
+        grain_size_(grain_size),
+        chunk_count_(static_cast<subtle::Atomic32>(
+            (end - begin + grain_size - 1) / grain_size)),
+        body_(body),
+        cancel_(cancel),
+        next_chunk_(0),
+        remaining_chunks_(chunk_count_),
+        canceled_(0),
+        done_(true, false) {
+  }
+
+  // internal::ParallelJob implementation.
+  virtual void Participate(size_t slot) OVERRIDE {
+    while (true) {
+      subtle::Atomic32 chunk =
+          subtle::NoBarrier_AtomicIncrement(&next_chunk_, 1) - 1;
+      if (chunk >= chunk_count_)
+        return;
+      if (cancel_ && cancel_->IsSet()) {
+        subtle::NoBarrier_Store(&canceled_, 1);
+      } else {
+        size_t chunk_begin = begin_ + chunk * grain_size_;
+        body_.Run(chunk_begin, std::min(chunk_begin + grain_size_, end_));
+      }
+      // The barrier publishes what |body_| wrote to the thread that waits.
+      if (!subtle::Barrier_AtomicIncrement(&remaining_chunks_, -1))
+        done_.Signal();
+    }
+  }
+
+  virtual bool HasWork() const OVERRIDE {
+    return subtle::NoBarrier_Load(&next_chunk_) < chunk_count_;
+  }
+
+  // Waits for the chunks taken by other threads, and returns false if any
+  // was skipped.
+  bool Wait() {
+    done_.Wait();
+    // No thread runs |body_| anymore. Release what it bound on the thread that
+    // bound it, rather than on whichever worker drops the last reference to
+    // the job.
+    body_.Reset();
+    return !subtle::NoBarrier_Load(&canceled_);
+  }
+
+ private:
+  virtual ~ParallelForJob() {}
+
+  const size_t begin_;
+  const size_t end_;
+  const size_t grain_size_;
+  const subtle::Atomic32 chunk_count_;
+  Callback<void(size_t, size_t)> body_;
+  const CancellationFlag* const cancel_;
+
+  // The next chunk to take.  Runs past |chunk_count_| as threads that find
+  // no more work still increment it.
+  subtle::Atomic32 next_chunk_;
+  subtle::Atomic32 remaining_chunks_;
+  subtle::Atomic32 canceled_;
+  WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelForJob);
+};
+
+}  // namespace
+
+bool ParallelFor(size_t begin,
+                 size_t end,
+                 size_t grain_size,
+                 const Callback<void(size_t, size_t)>& body,
+                 const CancellationFlag* cancel) {
+  DCHECK_LE(begin, end);
+  DCHECK_GT(grain_size, 0u);
+  if (begin == end)
+    return true;
+
+  // Keep the chunk count, and the overshoot of the chunk counter, well within
+  // an Atomic32.
+  const size_t kMaxChunks = 1 << 24;
+  grain_size = std::max(grain_size, (end - begin - 1) / kMaxChunks + 1);
+
+  // Don't bother the pool for a single chunk.
+  if (end - begin <= grain_size) {
+    if (cancel && cancel->IsSet())
+      return false;
+    body.Run(begin, end);
+    return true;
+  }
+
+  scoped_refptr<ParallelForJob> job(
+      new ParallelForJob(begin, end, grain_size, body, cancel));
+  internal::ParallelWorkerPool* pool =
+      internal::ParallelWorkerPool::GetInstance();
+  pool->AddJob(job.get());
+  job->Participate(0);
+  pool->RemoveJob(job.get());
+  return job->Wait();
+}
+
+}  // namespace base
@@ -0,0 +1,46 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_THREADING_PARALLEL_FOR_H_
+#define BASE_THREADING_PARALLEL_FOR_H_
+
+#include <stddef.h>
+
+#include "base/base_export.h"
+#include "base/callback_forward.h"
+
+namespace base {
+
+class CancellationFlag;
+
+// Runs |body| over the indices in [begin, end), in parallel on the calling
+// thread and the threads of a process-wide pool.  The range is cut into
+// consecutive chunks of |grain_size| indices (the last one may be shorter),
+// and |body| is run once per chunk with its [begin, end).  Idle threads take
+// the next chunk, so uneven chunks balance out; |grain_size| should make a
+// chunk take at least some tens of microseconds.
+//
+// Returns once every chunk has run.  If |cancel| is not NULL and gets set,
+// chunks that have not started yet are skipped, and ParallelFor() returns
+// false.
+//
+// |body| runs concurrently with itself, so it must only write state that
+// belongs to its chunk.  ParallelFor() blocks until the chunks run by other
+// threads are done, so it must not be used where waiting is disallowed.  It
+// may be called from within |body| or a ParallelTaskGraph task.
+//
+// Example:
+//   void ScaleRows(const Bitmap* source, Bitmap* dest, size_t begin,
+//                  size_t end);
+//   ParallelFor(0, dest.height(), 16,
+//               Bind(&ScaleRows, &source, &dest), NULL);
+BASE_EXPORT bool ParallelFor(size_t begin,
+                             size_t end,
+                             size_t grain_size,
+                             const Callback<void(size_t, size_t)>& body,
+                             const CancellationFlag* cancel);
+
+}  // namespace base
+
+#endif  // BASE_THREADING_PARALLEL_FOR_H_
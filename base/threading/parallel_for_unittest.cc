@@ -0,0 +1,108 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/parallel_for.h"
+
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/synchronization/lock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+void CountIndices(std::vector<int>* counts, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i)
+    ++(*counts)[i];
+}
+
+void RecordChunk(Lock* lock,
+                 std::vector<size_t>* chunk_sizes,
+                 size_t begin,
+                 size_t end) {
+  AutoLock auto_lock(*lock);
+  chunk_sizes->push_back(end - begin);
+}
+
+void CountCalls(subtle::Atomic32* calls, size_t begin, size_t end) {
+  subtle::NoBarrier_AtomicIncrement(calls, 1);
+}
+
+// Each index is a row of |counts|, which is counted in parallel again.
+void CountRow(std::vector<std::vector<int> >* counts,
+              size_t begin,
+              size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    std::vector<int>& row = (*counts)[i];
+    ParallelFor(0, row.size(), 3, Bind(&CountIndices, &row), NULL);
+  }
+}
+
+}  // namespace
+
+TEST(ParallelForTest, RunsEveryIndexOnce) {
+  for (size_t grain_size = 1; grain_size <= 1000; grain_size *= 10) {
+    std::vector<int> counts(10000);
+    EXPECT_TRUE(ParallelFor(0, counts.size(), grain_size,
+                            Bind(&CountIndices, &counts), NULL));
+    for (size_t i = 0; i < counts.size(); ++i)
+      ASSERT_EQ(1, counts[i]) << "grain size " << grain_size << ", " << i;
+  }
+
+  // Only part of the range.
+  std::vector<int> counts(100);
+  EXPECT_TRUE(ParallelFor(20, 70, 4, Bind(&CountIndices, &counts), NULL));
+  for (size_t i = 0; i < counts.size(); ++i)
+    EXPECT_EQ(i >= 20 && i < 70 ? 1 : 0, counts[i]) << i;
+}
+
+TEST(ParallelForTest, Chunks) {
+  Lock lock;
+  std::vector<size_t> chunk_sizes;
+  EXPECT_TRUE(ParallelFor(0, 103, 10,
+                          Bind(&RecordChunk, &lock, &chunk_sizes), NULL));
+  ASSERT_EQ(11u, chunk_sizes.size());
+  size_t total = 0;
+  int short_chunks = 0;
+  for (size_t i = 0; i < chunk_sizes.size(); ++i) {
+    total += chunk_sizes[i];
+    if (chunk_sizes[i] != 10u) {
+      EXPECT_EQ(3u, chunk_sizes[i]);
+      ++short_chunks;
+    }
+  }
+  EXPECT_EQ(103u, total);
+  EXPECT_EQ(1, short_chunks);
+
+  subtle::Atomic32 calls = 0;
+  EXPECT_TRUE(ParallelFor(5, 5, 1, Bind(&CountCalls, &calls), NULL));
+  EXPECT_EQ(0, calls);
+  EXPECT_TRUE(ParallelFor(0, 5, 100, Bind(&CountCalls, &calls), NULL));
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ParallelForTest, Nested) {
+  std::vector<std::vector<int> > counts(50, std::vector<int>(100));
+  EXPECT_TRUE(ParallelFor(0, counts.size(), 1, Bind(&CountRow, &counts),
+                          NULL));
+  for (size_t i = 0; i < counts.size(); ++i) {
+    for (size_t j = 0; j < counts[i].size(); ++j)
+      ASSERT_EQ(1, counts[i][j]) << i << ", " << j;
+  }
+}
+
+TEST(ParallelForTest, Canceled) {
+  CancellationFlag cancel;
+  cancel.Set();
+  subtle::Atomic32 calls = 0;
+  EXPECT_FALSE(ParallelFor(0, 1000, 1, Bind(&CountCalls, &calls), &cancel));
+  EXPECT_FALSE(ParallelFor(0, 1, 1, Bind(&CountCalls, &calls), &cancel));
+  EXPECT_EQ(0, calls);
+}
+
+}  // namespace base
@@ -0,0 +1,228 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/parallel_task_graph.h"
+
+#include <deque>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/parallel_worker_pool.h"
+
+namespace base {
+
+namespace {
+
+class TaskGraphJob : public internal::ParallelJob {
+ public:
+  struct Task {
+    Closure closure;
+    std::vector<ParallelTaskGraph::TaskId> dependents;
+    // The dependencies that have not run yet.
+    subtle::Atomic32 pending;
+  };
+
+  TaskGraphJob(std::vector<Task>* tasks,
+               size_t num_slots,
+               const CancellationFlag* cancel)
+      : cancel_(cancel),
+        queued_(0),
+        remaining_(static_cast<subtle::Atomic32>(tasks->size())),
+        canceled_(0),
+        done_(true, false) {
+    tasks_.swap(*tasks);
+    for (size_t i = 0; i < num_slots; ++i)
+      slots_.push_back(new Slot);
+    // Spread the tasks that are ready from the start over all threads.
+    size_t slot = 0;
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+      if (!tasks_[i].pending) {
+        Push(slot, i);
+        slot = (slot + 1) % num_slots;
+      }
+    }
+  }
+
+  // internal::ParallelJob implementation.
+  virtual void Participate(size_t slot) OVERRIDE {
+    DCHECK_LT(slot, slots_.size());
+    ParallelTaskGraph::TaskId id;
+    while (Take(slot, &id)) {
+      Task& task = tasks_[id];
+      if (cancel_ && cancel_->IsSet())
+        subtle::NoBarrier_Store(&canceled_, 1);
+      else
+        task.closure.Run();
+
+      size_t made_ready = 0;
+      for (size_t i = 0; i < task.dependents.size(); ++i) {
+        ParallelTaskGraph::TaskId dependent = task.dependents[i];
+        // The barrier publishes what |task| wrote to the thread that runs
+        // |dependent|.
+        if (!subtle::Barrier_AtomicIncrement(&tasks_[dependent].pending, -1)) {
+          Push(slot, dependent);
+          ++made_ready;
+        }
+      }
+      // This thread runs one of them next, others may steal the rest.
+      if (made_ready > 1)
+        internal::ParallelWorkerPool::GetInstance()->NotifyWork();
+
+      if (!subtle::Barrier_AtomicIncrement(&remaining_, -1))
+        done_.Signal();
+    }
+  }
+
+  virtual bool HasWork() const OVERRIDE {
+    return subtle::NoBarrier_Load(&queued_) > 0;
+  }
+
+  // Waits for the tasks run by other threads, and returns false if any was
+  // skipped.
+  bool Wait() {
+    done_.Wait();
+    // With every task taken, |queued_| stays 0 and no thread touches |tasks_|
+    // anymore. Release what the tasks bound on the thread that bound it.
+    tasks_.clear();
+    return !subtle::NoBarrier_Load(&canceled_);
+  }
+
+ private:
+  struct Slot {
+    Lock lock;
+    // Ready tasks, oldest first.
+    std::deque<ParallelTaskGraph::TaskId> ready;
+  };
+
+  virtual ~TaskGraphJob() {}
+
+  void Push(size_t slot, ParallelTaskGraph::TaskId id) {
+    AutoLock lock(slots_[slot]->lock);
+    slots_[slot]->ready.push_back(id);
+    subtle::NoBarrier_AtomicIncrement(&queued_, 1);
+  }
+
+  // Takes the newest task of |slot|, or else the oldest of another slot.
+  bool Take(size_t slot, ParallelTaskGraph::TaskId* id) {
+    // |queued_| may briefly lag behind the queues. That only delays a steal,
+    // since threads always go on with the tasks they made ready themselves.
+    if (!subtle::NoBarrier_Load(&queued_))
+      return false;
+    {
+      AutoLock lock(slots_[slot]->lock);
+      std::deque<ParallelTaskGraph::TaskId>& ready = slots_[slot]->ready;
+      if (!ready.empty()) {
+        *id = ready.back();
+        ready.pop_back();
+        subtle::NoBarrier_AtomicIncrement(&queued_, -1);
+        return true;
+      }
+    }
+    for (size_t i = 1; i < slots_.size(); ++i) {
+      Slot* victim = slots_[(slot + i) % slots_.size()];
+      AutoLock lock(victim->lock);
+      if (!victim->ready.empty()) {
+        *id = victim->ready.front();
+        victim->ready.pop_front();
+        subtle::NoBarrier_AtomicIncrement(&queued_, -1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Task> tasks_;
+  ScopedVector<Slot> slots_;
+  const CancellationFlag* const cancel_;
+  subtle::Atomic32 queued_;
+  subtle::Atomic32 remaining_;
+  subtle::Atomic32 canceled_;
+  WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskGraphJob);
+};
+
+}  // namespace
+
+ParallelTaskGraph::Node::Node() : dependency_count(0) {
+}
+
+ParallelTaskGraph::Node::~Node() {
+}
+
+ParallelTaskGraph::ParallelTaskGraph() {
+}
+
+ParallelTaskGraph::~ParallelTaskGraph() {
+}
+
+ParallelTaskGraph::TaskId ParallelTaskGraph::AddTask(const Closure& task) {
+  DCHECK(!task.is_null());
+  tasks_.push_back(Node());
+  tasks_.back().task = task;
+  return tasks_.size() - 1;
+}
+
+void ParallelTaskGraph::AddDependency(TaskId prerequisite, TaskId dependent) {
+  DCHECK_LT(prerequisite, tasks_.size());
+  DCHECK_LT(dependent, tasks_.size());
+  DCHECK_NE(prerequisite, dependent);
+  tasks_[prerequisite].dependents.push_back(dependent);
+  ++tasks_[dependent].dependency_count;
+}
+
+bool ParallelTaskGraph::Run(const CancellationFlag* cancel) {
+  DCHECK(IsAcyclic());
+  if (tasks_.empty())
+    return true;
+
+  std::vector<TaskGraphJob::Task> tasks(tasks_.size());
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    tasks[i].closure = tasks_[i].task;
+    tasks[i].dependents = tasks_[i].dependents;
+    tasks[i].pending = static_cast<subtle::Atomic32>(
+        tasks_[i].dependency_count);
+  }
+
+  internal::ParallelWorkerPool* pool =
+      internal::ParallelWorkerPool::GetInstance();
+  scoped_refptr<TaskGraphJob> job(
+      new TaskGraphJob(&tasks, pool->num_slots(), cancel));
+  pool->AddJob(job.get());
+  job->Participate(0);
+  // Tasks that the other threads make ready from now on still need idle
+  // workers to pick them up, so the job stays with the pool until all of
+  // them have run.
+  bool result = job->Wait();
+  pool->RemoveJob(job.get());
+  return result;
+}
+
+bool ParallelTaskGraph::IsAcyclic() const {
+  std::vector<size_t> pending(tasks_.size());
+  std::vector<TaskId> ready;
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    pending[i] = tasks_[i].dependency_count;
+    if (!pending[i])
+      ready.push_back(i);
+  }
+  size_t reached = 0;
+  while (!ready.empty()) {
+    TaskId id = ready.back();
+    ready.pop_back();
+    ++reached;
+    const std::vector<TaskId>& dependents = tasks_[id].dependents;
+    for (size_t i = 0; i < dependents.size(); ++i) {
+      if (!--pending[dependents[i]])
+        ready.push_back(dependents[i]);
+    }
+  }
+  return reached == tasks_.size();
+}
+
+}  // namespace base
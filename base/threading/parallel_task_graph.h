@@ -0,0 +1,82 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_THREADING_PARALLEL_TASK_GRAPH_H_
+#define BASE_THREADING_PARALLEL_TASK_GRAPH_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/callback.h"
+
+namespace base {
+
+class CancellationFlag;
+
+// A set of tasks and the dependencies between them, which Run() runs in
+// parallel on the calling thread and the threads that ParallelFor() uses.
+// Like cc's TaskGraph, each task counts the tasks it still waits for, and
+// becomes ready to run when that count drops to zero.
+//
+// Each thread keeps the tasks it made ready in a queue of its own and runs
+// the most recent first, since those likely use what the thread just
+// computed.  A thread that runs out of tasks steals the oldest task of
+// another thread's queue.
+//
+// Example:
+//   ParallelTaskGraph graph;
+//   ParallelTaskGraph::TaskId decode = graph.AddTask(Bind(&Decode, ...));
+//   ParallelTaskGraph::TaskId scale = graph.AddTask(Bind(&Scale, ...));
+//   graph.AddDependency(decode, scale);
+//   graph.Run(NULL);
+class BASE_EXPORT ParallelTaskGraph {
+ public:
+  typedef size_t TaskId;
+
+  ParallelTaskGraph();
+  ~ParallelTaskGraph();
+
+  // Adds |task| to the graph and returns its id.
+  TaskId AddTask(const Closure& task);
+
+  // Makes |dependent| wait for |prerequisite| to have run.  The dependencies
+  // must not form a cycle.
+  void AddDependency(TaskId prerequisite, TaskId dependent);
+
+  // Runs every task of the graph once, after the tasks it depends on, and
+  // returns when all of them have run.  Tasks run concurrently with each
+  // other, and may use ParallelFor() or run other graphs.
+  //
+  // If |cancel| is not NULL and gets set, tasks that have not started yet
+  // are skipped, and Run() returns false.
+  //
+  // Blocks until the tasks run by other threads are done, so it must not be
+  // used where waiting is disallowed.  The graph may be run again.
+  bool Run(const CancellationFlag* cancel);
+
+  size_t size() const { return tasks_.size(); }
+
+ private:
+  struct Node {
+    Node();
+    ~Node();
+
+    Closure task;
+    std::vector<TaskId> dependents;
+    size_t dependency_count;
+  };
+
+  // Returns whether every task can be reached by following dependencies
+  // from the tasks without any.
+  bool IsAcyclic() const;
+
+  std::vector<Node> tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelTaskGraph);
+};
+
+}  // namespace base
+
+#endif  // BASE_THREADING_PARALLEL_TASK_GRAPH_H_
@@ -0,0 +1,217 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/parallel_task_graph.h"
+
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/test/test_timeouts.h"
+#include "base/threading/parallel_for.h"
+#include "base/threading/parallel_worker_pool.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Records the order in which tasks run.
+class RunOrder {
+ public:
+  explicit RunOrder(size_t size) : next_(0), order_(size, -1) {}
+
+  void Run(size_t task) {
+    EXPECT_EQ(-1, order_[task]) << "task " << task << " ran twice";
+    order_[task] = subtle::NoBarrier_AtomicIncrement(&next_, 1);
+  }
+
+  bool RanBefore(size_t first, size_t second) const {
+    return order_[first] != -1 && order_[first] < order_[second];
+  }
+
+  int count() const { return subtle::NoBarrier_Load(&next_); }
+
+ private:
+  subtle::Atomic32 next_;
+  std::vector<subtle::Atomic32> order_;
+
+  DISALLOW_COPY_AND_ASSIGN(RunOrder);
+};
+
+// Lets a number of tasks wait for each other to have started, which only
+// works out when that many threads run them at once.
+class StartBarrier {
+ public:
+  explicit StartBarrier(int count) : cv_(&lock_), waiting_for_(count) {}
+
+  // Returns false if the other tasks didn't start in time.
+  bool Arrive() {
+    AutoLock lock(lock_);
+    if (!--waiting_for_) {
+      cv_.Broadcast();
+      return true;
+    }
+    TimeTicks deadline = TimeTicks::Now() + TestTimeouts::action_timeout();
+    while (waiting_for_) {
+      TimeDelta left = deadline - TimeTicks::Now();
+      if (left <= TimeDelta())
+        return false;
+      cv_.TimedWait(left);
+    }
+    return true;
+  }
+
+ private:
+  Lock lock_;
+  ConditionVariable cv_;
+  int waiting_for_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartBarrier);
+};
+
+void RunRoot(StartBarrier* barrier, PlatformThreadId starting_thread) {
+  EXPECT_TRUE(barrier->Arrive());
+  // A root on a worker finishes well after the starting thread ran out of
+  // tasks, so only workers are left to run what it makes ready.
+  if (PlatformThread::CurrentId() != starting_thread)
+    PlatformThread::Sleep(TimeDelta::FromMilliseconds(100));
+}
+
+void RunDependent(StartBarrier* barrier, PlatformThreadId starting_thread) {
+  EXPECT_NE(starting_thread, PlatformThread::CurrentId());
+  EXPECT_TRUE(barrier->Arrive());
+}
+
+void CountIndices(std::vector<int>* counts, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i)
+    ++(*counts)[i];
+}
+
+void RunParallelFor(std::vector<int>* counts) {
+  ParallelFor(0, counts->size(), 10, Bind(&CountIndices, counts), NULL);
+}
+
+}  // namespace
+
+TEST(ParallelTaskGraphTest, Empty) {
+  ParallelTaskGraph graph;
+  EXPECT_TRUE(graph.Run(NULL));
+}
+
+TEST(ParallelTaskGraphTest, RunsDependenciesFirst) {
+  // Layers of 10 tasks, where each depends on two tasks of the layer before.
+  const size_t kLayers = 20;
+  const size_t kWidth = 10;
+  RunOrder order(kLayers * kWidth);
+  ParallelTaskGraph graph;
+  for (size_t i = 0; i < kLayers * kWidth; ++i)
+    EXPECT_EQ(i, graph.AddTask(Bind(&RunOrder::Run, Unretained(&order), i)));
+  for (size_t layer = 1; layer < kLayers; ++layer) {
+    for (size_t i = 0; i < kWidth; ++i) {
+      size_t task = layer * kWidth + i;
+      graph.AddDependency(task - kWidth, task);
+      graph.AddDependency((layer - 1) * kWidth + (i + 1) % kWidth, task);
+    }
+  }
+
+  EXPECT_TRUE(graph.Run(NULL));
+  EXPECT_EQ(static_cast<int>(kLayers * kWidth), order.count());
+  for (size_t layer = 1; layer < kLayers; ++layer) {
+    for (size_t i = 0; i < kWidth; ++i) {
+      size_t task = layer * kWidth + i;
+      EXPECT_TRUE(order.RanBefore(task - kWidth, task)) << task;
+      EXPECT_TRUE(order.RanBefore((layer - 1) * kWidth + (i + 1) % kWidth,
+                                  task)) << task;
+    }
+  }
+}
+
+TEST(ParallelTaskGraphTest, FanOutAndIn) {
+  const size_t kTasks = 1000;
+  RunOrder order(kTasks + 2);
+  ParallelTaskGraph graph;
+  ParallelTaskGraph::TaskId first =
+      graph.AddTask(Bind(&RunOrder::Run, Unretained(&order), kTasks));
+  ParallelTaskGraph::TaskId last =
+      graph.AddTask(Bind(&RunOrder::Run, Unretained(&order), kTasks + 1));
+  for (size_t i = 0; i < kTasks; ++i) {
+    ParallelTaskGraph::TaskId task =
+        graph.AddTask(Bind(&RunOrder::Run, Unretained(&order), i));
+    graph.AddDependency(first, task);
+    graph.AddDependency(task, last);
+  }
+
+  EXPECT_TRUE(graph.Run(NULL));
+  EXPECT_EQ(static_cast<int>(kTasks + 2), order.count());
+  for (size_t i = 0; i < kTasks; ++i) {
+    EXPECT_TRUE(order.RanBefore(kTasks, i));
+    EXPECT_TRUE(order.RanBefore(i, kTasks + 1));
+  }
+}
+
+TEST(ParallelTaskGraphTest, LateReadyTasksRunOnWorkers) {
+  // Needs two workers besides the starting thread.
+  if (internal::ParallelWorkerPool::GetInstance()->num_slots() < 3)
+    return;
+
+  // Two roots that run at the same time, so at least one of them runs on a
+  // worker, and two tasks that depend on both and must run at the same time.
+  PlatformThreadId starting_thread = PlatformThread::CurrentId();
+  StartBarrier roots(2);
+  StartBarrier dependents(2);
+  ParallelTaskGraph graph;
+  ParallelTaskGraph::TaskId root_a =
+      graph.AddTask(Bind(&RunRoot, &roots, starting_thread));
+  ParallelTaskGraph::TaskId root_b =
+      graph.AddTask(Bind(&RunRoot, &roots, starting_thread));
+  for (int i = 0; i < 2; ++i) {
+    ParallelTaskGraph::TaskId task =
+        graph.AddTask(Bind(&RunDependent, &dependents, starting_thread));
+    graph.AddDependency(root_a, task);
+    graph.AddDependency(root_b, task);
+  }
+
+  EXPECT_TRUE(graph.Run(NULL));
+}
+
+TEST(ParallelTaskGraphTest, RunTwice) {
+  std::vector<int> counts(1000);
+  ParallelTaskGraph graph;
+  ParallelTaskGraph::TaskId previous = graph.AddTask(
+      Bind(&RunParallelFor, &counts));
+  for (int i = 0; i < 3; ++i) {
+    ParallelTaskGraph::TaskId task = graph.AddTask(
+        Bind(&RunParallelFor, &counts));
+    graph.AddDependency(previous, task);
+    previous = task;
+  }
+
+  EXPECT_TRUE(graph.Run(NULL));
+  EXPECT_TRUE(graph.Run(NULL));
+  for (size_t i = 0; i < counts.size(); ++i)
+    ASSERT_EQ(8, counts[i]) << i;
+}
+
+TEST(ParallelTaskGraphTest, Canceled) {
+  RunOrder order(10);
+  ParallelTaskGraph graph;
+  for (size_t i = 0; i < 10; ++i) {
+    graph.AddTask(Bind(&RunOrder::Run, Unretained(&order), i));
+    if (i)
+      graph.AddDependency(i - 1, i);
+  }
+
+  CancellationFlag cancel;
+  cancel.Set();
+  EXPECT_FALSE(graph.Run(&cancel));
+  EXPECT_EQ(0, order.count());
+}
+
+}  // namespace base
@@ -0,0 +1,89 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/parallel_worker_pool.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+
+namespace base {
+namespace internal {
+
+// static
+ParallelWorkerPool* ParallelWorkerPool::GetInstance() {
+  return Singleton<ParallelWorkerPool,
+                   LeakySingletonTraits<ParallelWorkerPool> >::get();
+}
+
+ParallelWorkerPool::ParallelWorkerPool()
+    : has_work_cv_(&lock_),
+      next_worker_index_(0) {
+  // The thread that starts a job works on it too.
+  int num_workers = std::max(SysInfo::NumberOfProcessors() - 1, 0);
+  AutoLock lock(lock_);
+  for (int i = 0; i < num_workers; ++i) {
+    workers_.push_back(new DelegateSimpleThread(
+        this, StringPrintf("ParallelWorker%d", i + 1)));
+    workers_.back()->Start();
+  }
+}
+
+ParallelWorkerPool::~ParallelWorkerPool() {
+  // Leaked, the workers never exit.
+  NOTREACHED();
+}
+
+void ParallelWorkerPool::AddJob(ParallelJob* job) {
+  AutoLock lock(lock_);
+  jobs_.push_back(job);
+  has_work_cv_.Broadcast();
+}
+
+void ParallelWorkerPool::RemoveJob(ParallelJob* job) {
+  AutoLock lock(lock_);
+  for (size_t i = 0; i < jobs_.size(); ++i) {
+    if (jobs_[i].get() == job) {
+      jobs_.erase(jobs_.begin() + i);
+      return;
+    }
+  }
+  NOTREACHED();
+}
+
+void ParallelWorkerPool::NotifyWork() {
+  AutoLock lock(lock_);
+  has_work_cv_.Broadcast();
+}
+
+void ParallelWorkerPool::Run() {
+  AutoLock lock(lock_);
+  const size_t slot = ++next_worker_index_;
+  while (true) {
+    scoped_refptr<ParallelJob> job = FindJobWithWork();
+    if (!job.get()) {
+      has_work_cv_.Wait();
+      continue;
+    }
+    AutoUnlock unlock(lock_);
+    job->Participate(slot);
+    // The last reference may be this one, and the job's destructor may run
+    // arbitrary code.
+    job = NULL;
+  }
+}
+
+ParallelJob* ParallelWorkerPool::FindJobWithWork() const {
+  lock_.AssertAcquired();
+  for (size_t i = 0; i < jobs_.size(); ++i) {
+    if (jobs_[i]->HasWork())
+      return jobs_[i].get();
+  }
+  return NULL;
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,94 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_THREADING_PARALLEL_WORKER_POOL_H_
+#define BASE_THREADING_PARALLEL_WORKER_POOL_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_vector.h"
+#include "base/memory/singleton.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+
+namespace base {
+namespace internal {
+
+// A unit of data-parallel work, such as a ParallelFor() loop or a run of a
+// ParallelTaskGraph, that threads of the ParallelWorkerPool join while it has
+// work to hand out.
+class BASE_EXPORT ParallelJob : public RefCountedThreadSafe<ParallelJob> {
+ public:
+  // Runs work items of the job on the calling thread until there is none
+  // left to take, then returns, possibly while other threads still run
+  // theirs.  |slot| is 0 for the thread that started the job, and 1 + the
+  // worker index for the pool's threads, so it is below
+  // ParallelWorkerPool::num_slots() and unique among concurrent callers.
+  virtual void Participate(size_t slot) = 0;
+
+  // Whether Participate() would find work right now.  Called with the pool's
+  // lock held, so it must be cheap and must not block.
+  virtual bool HasWork() const = 0;
+
+ protected:
+  friend class RefCountedThreadSafe<ParallelJob>;
+  virtual ~ParallelJob() {}
+};
+
+// The threads, one fewer than there are processors, that ParallelFor() and
+// ParallelTaskGraph share.  The thread that starts a job always participates
+// in it, so jobs make progress even when every worker is busy, including
+// jobs started from within other jobs.  The pool is created on first use and
+// lives until the process exits.
+class BASE_EXPORT ParallelWorkerPool : public DelegateSimpleThread::Delegate {
+ public:
+  static ParallelWorkerPool* GetInstance();
+
+  // The number of distinct |slot| values jobs see in Participate().
+  size_t num_slots() const { return workers_.size() + 1; }
+
+  // Offers |job| to the workers until RemoveJob() is called.  Jobs are
+  // offered in the order they were added.
+  void AddJob(ParallelJob* job);
+  void RemoveJob(ParallelJob* job);
+
+  // Wakes up idle workers after a job got more work than it had when they
+  // last looked.
+  void NotifyWork();
+
+ private:
+  friend struct DefaultSingletonTraits<ParallelWorkerPool>;
+
+  ParallelWorkerPool();
+  virtual ~ParallelWorkerPool();
+
+  // DelegateSimpleThread::Delegate implementation.
+  virtual void Run() OVERRIDE;
+
+  // Returns the oldest job with work, or NULL.  |lock_| must be held.
+  ParallelJob* FindJobWithWork() const;
+
+  // Protects everything below.
+  Lock lock_;
+
+  // Signaled when a job is added or gets more work.
+  ConditionVariable has_work_cv_;
+
+  std::vector<scoped_refptr<ParallelJob> > jobs_;
+
+  size_t next_worker_index_;
+
+  ScopedVector<DelegateSimpleThread> workers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelWorkerPool);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_THREADING_PARALLEL_WORKER_POOL_H_
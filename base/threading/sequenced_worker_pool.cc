@@ -4,6 +4,7 @@
 
 #include "base/threading/sequenced_worker_pool.h"
 
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "base/atomic_sequence_num.h"
+#include "base/atomicops.h"
 #include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/critical_closure.h"
@@ -18,6 +20,7 @@
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/linked_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop_proxy.h"
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
@@ -84,6 +87,67 @@ struct SequencedTaskLessThan {
   }
 };
 
+// A unit of work handed out through the WORK_STEALING queues: either an
+// unsequenced task, or the right to run the next task queued for
+// |sequence_token_id|. At most one such claim exists per sequence token, which
+// is what keeps tasks of the same sequence from running concurrently.
+struct StealableWork {
+  StealableWork() : sequence_token_id(0) {}
+
+  int sequence_token_id;
+
+  // Only set when |sequence_token_id| is zero.
+  SequencedTask task;
+};
+
+// A per-worker deque of StealableWork. The owning worker takes work from the
+// front while other workers steal from the back. The lock is only ever
+// contended by the owner and a thief, never by the whole pool.
+class StealableWorkQueue {
+ public:
+  StealableWorkQueue() {}
+  ~StealableWorkQueue() {}
+
+  void Push(const StealableWork& work) {
+    AutoLock lock(lock_);
+    work_.push_back(work);
+  }
+
+  bool TakeFront(StealableWork* work) {
+    AutoLock lock(lock_);
+    if (work_.empty())
+      return false;
+    *work = work_.front();
+    work_.pop_front();
+    return true;
+  }
+
+  bool StealBack(StealableWork* work) {
+    AutoLock lock(lock_);
+    if (work_.empty())
+      return false;
+    *work = work_.back();
+    work_.pop_back();
+    return true;
+  }
+
+ private:
+  Lock lock_;
+  std::deque<StealableWork> work_;
+
+  DISALLOW_COPY_AND_ASSIGN(StealableWorkQueue);
+};
+
+// One shard of the WORK_STEALING per-sequence run queues. A sequence token has
+// an entry here for as long as a StealableWork claim for it is outstanding or
+// one of its tasks is running.
+struct SequenceQueueShard {
+  Lock lock;
+  std::map<int, std::deque<SequencedTask> > queues;
+};
+
+const int kNumSequenceQueueShards = 16;
+
 // SequencedWorkerPoolTaskRunner ---------------------------------------------
 // A TaskRunner which posts tasks to a SequencedWorkerPool with a
 // fixed ShutdownBehavior.
@@ -252,8 +316,13 @@ class SequencedWorkerPool::Worker : public SimpleThread {
     return running_shutdown_behavior_;
   }
 
+  int thread_number() const {
+    return thread_number_;
+  }
+
  private:
   scoped_refptr<SequencedWorkerPool> worker_pool_;
+  const int thread_number_;
   SequenceToken running_sequence_;
   WorkerShutdown running_shutdown_behavior_;
 
@@ -268,6 +337,7 @@ class SequencedWorkerPool::Inner {
   // by it).
   Inner(SequencedWorkerPool* worker_pool, size_t max_threads,
         const std::string& thread_name_prefix,
+        SchedulingMode scheduling_mode,
         TestingObserver* observer);
 
   ~Inner();
@@ -389,6 +459,44 @@ class SequencedWorkerPool::Inner {
   // called inside the lock.
   bool CanShutdown() const;
 
+  // WORK_STEALING helpers. Unless noted otherwise, these must be called
+  // outside the lock.
+
+  // Hands |task| to the stealable queues. Returns false if shutdown has
+  // started, in which case the caller must fall back to the locked path,
+  // which knows which tasks may still be posted.
+  bool PostStealableTask(const SequencedTask& task);
+
+  // Queues |task| behind its sequence, or on a worker deque if it is
+  // unsequenced. Shutdown accounting must already be done by the caller.
+  void ScheduleStealableTask(const SequencedTask& task);
+
+  // Pushes |work| onto a worker deque and makes sure someone will pick it up.
+  void EnqueueStealableWork(const StealableWork& work);
+
+  // Takes work from |this_worker|'s deque, or steals it from another one.
+  bool TakeStealableWork(Worker* this_worker, StealableWork* work);
+
+  // Runs (or, during shutdown, discards) one piece of stealable work. Returns
+  // false if there was none.
+  bool RunStealableWork(Worker* this_worker);
+
+  // Drops the claim on |sequence_token_id| after one of its tasks ran,
+  // re-queueing the claim if more tasks are waiting.
+  void ReleaseSequence(int sequence_token_id);
+
+  // Wakes an idle worker, or starts a new one if none is idle and the pool
+  // can still grow.
+  void WakeUpWorkerForStealableWork();
+
+  // Decrements one of the stealable shutdown counters, unblocking Shutdown()
+  // if it drops to zero once shutdown has started.
+  void DecrementStealableCount(volatile subtle::Atomic32* count);
+
+  // Returns true if there is stealable work that no worker has claimed yet.
+  // Can be called inside or outside the lock.
+  bool HasStealableWork() const;
+
   SequencedWorkerPool* const worker_pool_;
 
   // The last sequence number used. Managed by GetSequenceToken, since this
@@ -454,7 +562,7 @@ class SequencedWorkerPool::Inner {
   std::set<int> current_sequences_;
 
   // An ID for each posted task to distinguish the task from others in traces.
-  int trace_id_;
+  AtomicSequenceNumber trace_id_;
 
   // Set when Shutdown is called and no further tasks should be
   // allowed, though we may still be running existing tasks.
@@ -471,6 +579,41 @@ class SequencedWorkerPool::Inner {
 
   TestingObserver* const testing_observer_;
 
+  // WORK_STEALING state. Everything below is accessed without |lock_|. The
+  // counters are only modified with full-barrier atomic operations, so that
+  // a poster or worker and a concurrent Shutdown() always agree on whether
+  // a given task still blocks shutdown.
+  const bool work_stealing_;
+
+  // One deque per potential worker, indexed by thread number - 1.
+  ScopedVector<StealableWorkQueue> stealable_queues_;
+
+  SequenceQueueShard sequence_queue_shards_[kNumSequenceQueueShards];
+
+  // The worker running on the current thread, if any.
+  mutable ThreadLocalPointer<Worker> current_worker_;
+
+  // Spreads work posted from non-worker threads over the worker deques.
+  AtomicSequenceNumber next_stealable_queue_;
+
+  // Number of threads created or being created; mirrors the thread number
+  // handed out by PrepareToStartAdditionalThreadIfHelpful.
+  subtle::Atomic32 reserved_thread_count_;
+
+  // Number of workers waiting on |has_work_cv_|.
+  subtle::Atomic32 idle_thread_count_;
+
+  // Number of StealableWork items sitting in |stealable_queues_|.
+  subtle::Atomic32 stealable_work_count_;
+
+  // Stealable BLOCK_SHUTDOWN tasks not yet started, and stealable
+  // BLOCK_SHUTDOWN or SKIP_ON_SHUTDOWN tasks currently running.
+  subtle::Atomic32 stealable_blocking_pending_count_;
+  subtle::Atomic32 stealable_blocking_running_count_;
+
+  // Nonzero once Shutdown() has been called.
+  subtle::Atomic32 stealable_shutdown_called_;
+
   DISALLOW_COPY_AND_ASSIGN(Inner);
 };
 
@@ -483,6 +626,7 @@ SequencedWorkerPool::Worker::Worker(
     : SimpleThread(
           prefix + StringPrintf("Worker%d", thread_number).c_str()),
       worker_pool_(worker_pool),
+      thread_number_(thread_number),
       running_shutdown_behavior_(CONTINUE_ON_SHUTDOWN) {
   Start();
 }
@@ -511,6 +655,7 @@ SequencedWorkerPool::Inner::Inner(
     SequencedWorkerPool* worker_pool,
     size_t max_threads,
     const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode,
     TestingObserver* observer)
     : worker_pool_(worker_pool),
       lock_(),
@@ -523,13 +668,24 @@ SequencedWorkerPool::Inner::Inner(
       blocking_shutdown_thread_count_(0),
       next_sequence_task_number_(0),
       blocking_shutdown_pending_task_count_(0),
-      trace_id_(0),
       shutdown_called_(false),
       max_blocking_tasks_after_shutdown_(0),
       cleanup_state_(CLEANUP_DONE),
       cleanup_idlers_(0),
       cleanup_cv_(&lock_),
-      testing_observer_(observer) {}
+      testing_observer_(observer),
+      work_stealing_(scheduling_mode == WORK_STEALING),
+      reserved_thread_count_(0),
+      idle_thread_count_(0),
+      stealable_work_count_(0),
+      stealable_blocking_pending_count_(0),
+      stealable_blocking_running_count_(0),
+      stealable_shutdown_called_(0) {
+  if (work_stealing_) {
+    for (size_t i = 0; i < max_threads_; ++i)
+      stealable_queues_.push_back(new StealableWorkQueue);
+  }
+}
 
 SequencedWorkerPool::Inner::~Inner() {
   // You must call Shutdown() before destroying the pool.
@@ -575,6 +731,20 @@ bool SequencedWorkerPool::Inner::PostTask(
       base::MakeCriticalClosure(task) : task;
   sequenced.time_to_run = TimeTicks::Now() + delay;
 
+  if (work_stealing_ && delay == TimeDelta()) {
+    if (optional_token_name) {
+      AutoLock lock(lock_);
+      sequenced.sequence_token_id = LockedGetNamedTokenID(*optional_token_name);
+      optional_token_name = NULL;
+    }
+    // The trace_id is used for identifying the task in about:tracing.
+    sequenced.trace_id = trace_id_.GetNext();
+    if (PostStealableTask(sequenced))
+      return true;
+    // Shutdown has started; the locked path below applies the rules for
+    // tasks posted during shutdown.
+  }
+
   int create_thread_id = 0;
   {
     AutoLock lock(lock_);
@@ -591,7 +761,8 @@ bool SequencedWorkerPool::Inner::PostTask(
     }
 
     // The trace_id is used for identifying the task in about:tracing.
-    sequenced.trace_id = trace_id_++;
+    if (!sequenced.trace_id)
+      sequenced.trace_id = trace_id_.GetNext();
 
     TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
         "SequencedWorkerPool::PostTask",
@@ -621,12 +792,19 @@ bool SequencedWorkerPool::Inner::PostTask(
 }
 
 bool SequencedWorkerPool::Inner::RunsTasksOnCurrentThread() const {
+  if (work_stealing_)
+    return current_worker_.Get() != NULL;
   AutoLock lock(lock_);
   return ContainsKey(threads_, PlatformThread::CurrentId());
 }
 
 bool SequencedWorkerPool::Inner::IsRunningSequenceOnCurrentThread(
     SequenceToken sequence_token) const {
+  if (work_stealing_) {
+    // A worker's running sequence is only ever changed by its own thread.
+    Worker* worker = current_worker_.Get();
+    return worker && sequence_token.Equals(worker->running_sequence());
+  }
   AutoLock lock(lock_);
   ThreadMap::const_iterator found = threads_.find(PlatformThread::CurrentId());
   if (found == threads_.end())
@@ -642,8 +820,10 @@ void SequencedWorkerPool::Inner::CleanupForTesting() {
   CHECK_EQ(CLEANUP_DONE, cleanup_state_);
   if (shutdown_called_)
     return;
-  if (pending_tasks_.empty() && waiting_thread_count_ == threads_.size())
+  if (pending_tasks_.empty() && !HasStealableWork() &&
+      waiting_thread_count_ == threads_.size()) {
     return;
+  }
   cleanup_state_ = CLEANUP_REQUESTED;
   cleanup_idlers_ = 0;
   has_work_cv_.Signal();
@@ -666,6 +846,12 @@ void SequencedWorkerPool::Inner::Shutdown(
       return;
     shutdown_called_ = true;
     max_blocking_tasks_after_shutdown_ = max_new_blocking_tasks_after_shutdown;
+    if (work_stealing_) {
+      // Pairs with the barriers in PostStealableTask and RunStealableWork;
+      // see the comments there.
+      subtle::NoBarrier_Store(&stealable_shutdown_called_, 1);
+      subtle::MemoryBarrier();
+    }
 
     // Tickle the threads. This will wake up a waiting one so it will know that
     // it can exit, which in turn will wake up any other waiting ones.
@@ -712,6 +898,8 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
         threads_.insert(
             std::make_pair(this_worker->tid(), make_linked_ptr(this_worker)));
     DCHECK(result.second);
+    if (work_stealing_)
+      current_worker_.Set(this_worker);
 
     while (true) {
 #if defined(OS_MACOSX)
@@ -720,13 +908,34 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
 
       HandleCleanup();
 
+      if (work_stealing_) {
+        // Run everything that can be found without the pool-wide lock before
+        // looking at delayed tasks.
+        AutoUnlock unlock(lock_);
+        while (RunStealableWork(this_worker)) {
+#if defined(OS_MACOSX)
+          autorelease_pool.Recycle();
+#endif
+        }
+      }
+
       // See GetWork for what delete_these_outside_lock is doing.
       SequencedTask task;
       TimeDelta wait_time;
       std::vector<Closure> delete_these_outside_lock;
       GetWorkStatus status =
           GetWork(&task, &wait_time, &delete_these_outside_lock);
-      if (status == GET_WORK_FOUND) {
+      if (status == GET_WORK_FOUND && work_stealing_) {
+        // Due tasks are handed over to the stealable queues, so that sequence
+        // exclusivity is only ever enforced there. GetWork() already dropped
+        // the task from |blocking_shutdown_pending_task_count_|; account for
+        // it on the stealable side before the lock is released.
+        if (task.shutdown_behavior == BLOCK_SHUTDOWN)
+          subtle::Barrier_AtomicIncrement(&stealable_blocking_pending_count_, 1);
+        AutoUnlock unlock(lock_);
+        delete_these_outside_lock.clear();
+        ScheduleStealableTask(task);
+      } else if (status == GET_WORK_FOUND) {
         TRACE_EVENT_FLOW_END0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
             "SequencedWorkerPool::PostTask",
             TRACE_ID_MANGLE(GetTaskTraceID(task, static_cast<void*>(this))));
@@ -794,10 +1003,24 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
         // ones with the same sequence token, but additional threads won't
         // help this case.
         if (shutdown_called_ &&
-            blocking_shutdown_pending_task_count_ == 0)
+            blocking_shutdown_pending_task_count_ == 0 &&
+            subtle::Acquire_Load(&stealable_blocking_pending_count_) == 0)
           break;
         waiting_thread_count_++;
 
+        if (work_stealing_) {
+          // Announce that we are about to wait before checking for stealable
+          // work one last time. Posters add their work before checking
+          // |idle_thread_count_|, and signal under |lock_|, so either we see
+          // their work here or they see us and wake us up.
+          subtle::Barrier_AtomicIncrement(&idle_thread_count_, 1);
+          if (HasStealableWork()) {
+            subtle::Barrier_AtomicIncrement(&idle_thread_count_, -1);
+            waiting_thread_count_--;
+            continue;
+          }
+        }
+
         switch (status) {
           case GET_WORK_NOT_FOUND:
             has_work_cv_.Wait();
@@ -809,6 +1032,8 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
             NOTREACHED();
         }
         waiting_thread_count_--;
+        if (work_stealing_)
+          subtle::Barrier_AtomicIncrement(&idle_thread_count_, -1);
       }
     }
   }  // Release lock_.
@@ -1081,13 +1306,18 @@ int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
       threads_.size() < max_threads_ &&
       waiting_thread_count_ == 0) {
     // We could use an additional thread if there's work to be done.
+    bool has_runnable_task = work_stealing_ && HasStealableWork();
     for (PendingTaskSet::const_iterator i = pending_tasks_.begin();
-         i != pending_tasks_.end(); ++i) {
-      if (IsSequenceTokenRunnable(i->sequence_token_id)) {
-        // Found a runnable task, mark the thread as being started.
-        thread_being_created_ = true;
-        return static_cast<int>(threads_.size() + 1);
-      }
+         !has_runnable_task && i != pending_tasks_.end(); ++i) {
+      if (IsSequenceTokenRunnable(i->sequence_token_id))
+        has_runnable_task = true;
+    }
+    if (has_runnable_task) {
+      // Found a runnable task, mark the thread as being started.
+      thread_being_created_ = true;
+      int thread_number = static_cast<int>(threads_.size() + 1);
+      subtle::NoBarrier_Store(&reserved_thread_count_, thread_number);
+      return thread_number;
     }
   }
   return 0;
@@ -1115,7 +1345,225 @@ bool SequencedWorkerPool::Inner::CanShutdown() const {
   // See PrepareToStartAdditionalThreadIfHelpful for how thread creation works.
   return !thread_being_created_ &&
          blocking_shutdown_thread_count_ == 0 &&
-         blocking_shutdown_pending_task_count_ == 0;
+         blocking_shutdown_pending_task_count_ == 0 &&
+         subtle::Acquire_Load(&stealable_blocking_pending_count_) == 0 &&
+         subtle::Acquire_Load(&stealable_blocking_running_count_) == 0;
+}
+
+bool SequencedWorkerPool::Inner::PostStealableTask(const SequencedTask& task) {
+  DCHECK(work_stealing_);
+  // This is one half of a handshake with Shutdown(): the task is counted
+  // before |stealable_shutdown_called_| is read, and Shutdown() sets the flag
+  // before reading the count. So either we see the flag, or Shutdown() sees
+  // the task. Non-blocking tasks need no handshake; if they slip in, the
+  // worker picking them up will see the flag and discard them.
+  if (task.shutdown_behavior == BLOCK_SHUTDOWN)
+    subtle::Barrier_AtomicIncrement(&stealable_blocking_pending_count_, 1);
+  else
+    subtle::MemoryBarrier();
+  if (subtle::Acquire_Load(&stealable_shutdown_called_)) {
+    if (task.shutdown_behavior == BLOCK_SHUTDOWN)
+      DecrementStealableCount(&stealable_blocking_pending_count_);
+    return false;
+  }
+
+  TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+      "SequencedWorkerPool::PostTask",
+      TRACE_ID_MANGLE(GetTaskTraceID(task, static_cast<void*>(this))));
+
+  ScheduleStealableTask(task);
+  return true;
+}
+
+void SequencedWorkerPool::Inner::ScheduleStealableTask(
+    const SequencedTask& task) {
+  StealableWork work;
+  if (!task.sequence_token_id) {
+    work.task = task;
+    EnqueueStealableWork(work);
+    return;
+  }
+
+  SequenceQueueShard& shard = sequence_queue_shards_[
+      task.sequence_token_id % kNumSequenceQueueShards];
+  {
+    AutoLock lock(shard.lock);
+    std::pair<std::map<int, std::deque<SequencedTask> >::iterator, bool>
+        result = shard.queues.insert(
+            std::make_pair(task.sequence_token_id,
+                           std::deque<SequencedTask>()));
+    result.first->second.push_back(task);
+    // If the sequence already has an entry, its claim is outstanding or one
+    // of its tasks is running; ReleaseSequence() will pick this task up.
+    if (!result.second)
+      return;
+  }
+  work.sequence_token_id = task.sequence_token_id;
+  EnqueueStealableWork(work);
+}
+
+void SequencedWorkerPool::Inner::EnqueueStealableWork(
+    const StealableWork& work) {
+  Worker* current_worker = current_worker_.Get();
+  size_t queue_index;
+  if (current_worker) {
+    // Work posted by a worker stays with it until someone steals it.
+    queue_index = current_worker->thread_number() - 1;
+  } else {
+    size_t queue_count = std::max(
+        1, static_cast<int>(subtle::Acquire_Load(&reserved_thread_count_)));
+    queue_index = next_stealable_queue_.GetNext() % queue_count;
+  }
+  stealable_queues_[queue_index]->Push(work);
+  subtle::Barrier_AtomicIncrement(&stealable_work_count_, 1);
+  WakeUpWorkerForStealableWork();
+}
+
+bool SequencedWorkerPool::Inner::TakeStealableWork(Worker* this_worker,
+                                                   StealableWork* work) {
+  if (!HasStealableWork())
+    return false;
+  size_t own_index = this_worker->thread_number() - 1;
+  if (!stealable_queues_[own_index]->TakeFront(work)) {
+    size_t queue_count = std::max(
+        own_index + 1,
+        static_cast<size_t>(subtle::Acquire_Load(&reserved_thread_count_)));
+    bool stolen = false;
+    for (size_t i = 1; !stolen && i < queue_count; ++i)
+      stolen = stealable_queues_[(own_index + i) % queue_count]->StealBack(work);
+    if (!stolen)
+      return false;
+  }
+  subtle::Barrier_AtomicIncrement(&stealable_work_count_, -1);
+  return true;
+}
+
+bool SequencedWorkerPool::Inner::RunStealableWork(Worker* this_worker) {
+  StealableWork work;
+  if (!TakeStealableWork(this_worker, &work))
+    return false;
+
+  SequencedTask task;
+  if (work.sequence_token_id) {
+    SequenceQueueShard& shard = sequence_queue_shards_[
+        work.sequence_token_id % kNumSequenceQueueShards];
+    AutoLock lock(shard.lock);
+    std::deque<SequencedTask>& queue = shard.queues[work.sequence_token_id];
+    DCHECK(!queue.empty());
+    task = queue.front();
+    queue.pop_front();
+  } else {
+    task = work.task;
+    work.task.task = Closure();
+  }
+
+  // The second half of the handshake described in PostStealableTask: a task
+  // that may block shutdown is counted as running before the shutdown flag
+  // is checked, so a SKIP_ON_SHUTDOWN task either runs to completion before
+  // Shutdown() returns or doesn't start at all.
+  bool should_run = true;
+  if (task.shutdown_behavior != CONTINUE_ON_SHUTDOWN)
+    subtle::Barrier_AtomicIncrement(&stealable_blocking_running_count_, 1);
+  if (task.shutdown_behavior == BLOCK_SHUTDOWN) {
+    DecrementStealableCount(&stealable_blocking_pending_count_);
+  } else {
+    subtle::MemoryBarrier();
+    should_run = !subtle::Acquire_Load(&stealable_shutdown_called_);
+  }
+
+  if (should_run) {
+    // There may be more work available, so wake up another worker thread or
+    // grow the pool; see WillRunWorkerTask for why this happens before the
+    // task runs.
+    if (HasStealableWork())
+      WakeUpWorkerForStealableWork();
+
+    TRACE_EVENT_FLOW_END0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+        "SequencedWorkerPool::PostTask",
+        TRACE_ID_MANGLE(GetTaskTraceID(task, static_cast<void*>(this))));
+    TRACE_EVENT2("toplevel", "SequencedWorkerPool::ThreadLoop",
+                 "src_file", task.posted_from.file_name(),
+                 "src_func", task.posted_from.function_name());
+
+    this_worker->set_running_task_info(
+        SequenceToken(task.sequence_token_id), task.shutdown_behavior);
+
+    tracked_objects::TrackedTime start_time =
+        tracked_objects::ThreadData::NowForStartOfRun(task.birth_tally);
+
+    task.task.Run();
+
+    tracked_objects::ThreadData::TallyRunOnNamedThreadIfTracking(task,
+        start_time, tracked_objects::ThreadData::NowForEndOfRun());
+  }
+
+  // Destroy the task before clearing the running task info and releasing the
+  // sequence; see ThreadLoop.
+  task.task = Closure();
+  this_worker->set_running_task_info(SequenceToken(), CONTINUE_ON_SHUTDOWN);
+
+  if (task.shutdown_behavior != CONTINUE_ON_SHUTDOWN)
+    DecrementStealableCount(&stealable_blocking_running_count_);
+  if (work.sequence_token_id)
+    ReleaseSequence(work.sequence_token_id);
+  return true;
+}
+
+void SequencedWorkerPool::Inner::ReleaseSequence(int sequence_token_id) {
+  SequenceQueueShard& shard =
+      sequence_queue_shards_[sequence_token_id % kNumSequenceQueueShards];
+  {
+    AutoLock lock(shard.lock);
+    std::map<int, std::deque<SequencedTask> >::iterator found =
+        shard.queues.find(sequence_token_id);
+    DCHECK(found != shard.queues.end());
+    if (found->second.empty()) {
+      shard.queues.erase(found);
+      return;
+    }
+  }
+  StealableWork work;
+  work.sequence_token_id = sequence_token_id;
+  EnqueueStealableWork(work);
+}
+
+void SequencedWorkerPool::Inner::WakeUpWorkerForStealableWork() {
+  // Callers have just published work with a full barrier, so this read pairs
+  // with the one in ThreadLoop; see the comment there.
+  if (subtle::Acquire_Load(&idle_thread_count_) > 0) {
+    AutoLock lock(lock_);
+    SignalHasWork();
+    return;
+  }
+
+  if (static_cast<size_t>(subtle::Acquire_Load(&reserved_thread_count_)) >=
+      max_threads_) {
+    return;
+  }
+  int create_thread_id = 0;
+  {
+    AutoLock lock(lock_);
+    create_thread_id = PrepareToStartAdditionalThreadIfHelpful();
+  }
+  if (create_thread_id)
+    FinishStartingAdditionalThread(create_thread_id);
+}
+
+void SequencedWorkerPool::Inner::DecrementStealableCount(
+    volatile subtle::Atomic32* count) {
+  if (subtle::Barrier_AtomicIncrement(count, -1) != 0 ||
+      !subtle::Acquire_Load(&stealable_shutdown_called_)) {
+    return;
+  }
+  // Shutdown() may be waiting for this count to drop, and workers may be
+  // waiting for the last blocking task before they exit.
+  AutoLock lock(lock_);
+  can_shutdown_cv_.Signal();
+  SignalHasWork();
+}
+
+bool SequencedWorkerPool::Inner::HasStealableWork() const {
+  return subtle::Acquire_Load(&stealable_work_count_) > 0;
 }
 
 base::StaticAtomicSequenceNumber
@@ -1140,15 +1588,27 @@ SequencedWorkerPool::SequencedWorkerPool(
     size_t max_threads,
     const std::string& thread_name_prefix)
     : constructor_message_loop_(MessageLoopProxy::current()),
-      inner_(new Inner(this, max_threads, thread_name_prefix, NULL)) {
+      inner_(new Inner(this, max_threads, thread_name_prefix, CENTRAL_QUEUE,
+                       NULL)) {
+}
+
+SequencedWorkerPool::SequencedWorkerPool(
+    size_t max_threads,
+    const std::string& thread_name_prefix,
+    TestingObserver* observer)
+    : constructor_message_loop_(MessageLoopProxy::current()),
+      inner_(new Inner(this, max_threads, thread_name_prefix, CENTRAL_QUEUE,
+                       observer)) {
 }
 
 SequencedWorkerPool::SequencedWorkerPool(
     size_t max_threads,
     const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode,
     TestingObserver* observer)
     : constructor_message_loop_(MessageLoopProxy::current()),
-      inner_(new Inner(this, max_threads, thread_name_prefix, observer)) {
+      inner_(new Inner(this, max_threads, thread_name_prefix, scheduling_mode,
+                       observer)) {
 }
 
 SequencedWorkerPool::~SequencedWorkerPool() {}
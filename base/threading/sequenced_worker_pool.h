@@ -118,6 +118,24 @@ class BASE_EXPORT SequencedWorkerPool : public TaskRunner {
     BLOCK_SHUTDOWN,
   };
 
+  // Defines how runnable tasks are handed to the worker threads.
+  enum SchedulingMode {
+    // Every task goes through the pool-wide lock and a single pending-task
+    // set. This is the default.
+    CENTRAL_QUEUE,
+
+    // Non-delayed tasks are handed out through per-worker deques (for
+    // unsequenced tasks) and per-sequence-token run queues, which idle
+    // workers steal from without taking the pool-wide lock. Delayed tasks
+    // still wait in the pool-wide set and join their sequence once they are
+    // due. SequenceToken ordering and WorkerShutdown semantics are the same
+    // as for CENTRAL_QUEUE.
+    //
+    // This is meant for pools with many threads and bursty workloads, where
+    // the pool-wide lock is the main point of contention.
+    WORK_STEALING,
+  };
+
   // Opaque identifier that defines sequencing of tasks posted to the worker
   // pool.
   class SequenceToken {
@@ -171,6 +189,13 @@ class BASE_EXPORT SequencedWorkerPool : public TaskRunner {
                       const std::string& thread_name_prefix,
                       TestingObserver* observer);
 
+  // Like above, but with an explicit |scheduling_mode|. |observer| may be
+  // NULL.
+  SequencedWorkerPool(size_t max_threads,
+                      const std::string& thread_name_prefix,
+                      SchedulingMode scheduling_mode,
+                      TestingObserver* observer);
+
   // Returns a unique token that can be used to sequence tasks posted to
   // PostSequencedWorkerTask(). Valid tokens are always nonzero.
   SequenceToken GetSequenceToken();
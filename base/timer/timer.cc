@@ -6,14 +6,104 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <vector>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
 #include "base/single_thread_task_runner.h"
 #include "base/thread_task_runner_handle.h"
 #include "base/threading/platform_thread.h"
+#include "base/threading/thread_local.h"
+#include "base/timer/timer_wheel.h"
 
 namespace base {
 
+namespace {
+
+// Keeps the timers of the current thread's MessageLoop on a TimerWheel, and
+// has the MessageLoop run a task whenever the wheel needs to advance.
+class TimerWheelDriver : public MessageLoop::DestructionObserver {
+ public:
+  // Returns the driver of the current thread, or NULL if the thread has no
+  // MessageLoop.
+  static TimerWheelDriver* GetForCurrentThread();
+
+  void Schedule(TimerWheel::Entry* entry, TimeTicks deadline) {
+    wheel_.Schedule(entry, deadline);
+    // A wake-up that is due before |deadline| takes care of it.
+    if (wake_up_time_.is_null() || deadline < wake_up_time_)
+      PostWakeUp();
+  }
+
+  // MessageLoop::DestructionObserver implementation.
+  virtual void WillDestroyCurrentMessageLoop() OVERRIDE;
+
+ private:
+  explicit TimerWheelDriver(MessageLoop* message_loop)
+      : message_loop_(message_loop),
+        wheel_(TimeTicks::Now()),
+        weak_factory_(this) {
+    message_loop_->AddDestructionObserver(this);
+  }
+
+  virtual ~TimerWheelDriver() {}
+
+  // Posts a task for when the wheel next needs to advance, if earlier than
+  // |wake_up_time_|.
+  void PostWakeUp();
+
+  void WakeUp() {
+    wake_up_time_ = TimeTicks();
+    wheel_.Advance(TimeTicks::Now());
+    PostWakeUp();
+  }
+
+  MessageLoop* const message_loop_;
+  TimerWheel wheel_;
+
+  // The earliest wake-up task that is pending, if any.
+  TimeTicks wake_up_time_;
+
+  WeakPtrFactory<TimerWheelDriver> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheelDriver);
+};
+
+LazyInstance<ThreadLocalPointer<TimerWheelDriver> >::Leaky
+    lazy_tls_driver = LAZY_INSTANCE_INITIALIZER;
+
+// static
+TimerWheelDriver* TimerWheelDriver::GetForCurrentThread() {
+  TimerWheelDriver* driver = lazy_tls_driver.Pointer()->Get();
+  if (driver)
+    return driver;
+  MessageLoop* message_loop = MessageLoop::current();
+  if (!message_loop)
+    return NULL;
+  driver = new TimerWheelDriver(message_loop);
+  lazy_tls_driver.Pointer()->Set(driver);
+  return driver;
+}
+
+void TimerWheelDriver::PostWakeUp() {
+  TimeTicks next_wake_up = wheel_.NextWakeUpTime();
+  if (next_wake_up.is_null())
+    return;
+  if (!wake_up_time_.is_null() && wake_up_time_ <= next_wake_up)
+    return;
+  wake_up_time_ = next_wake_up;
+  message_loop_->PostDelayedTask(
+      FROM_HERE,
+      Bind(&TimerWheelDriver::WakeUp, weak_factory_.GetWeakPtr()),
+      std::max(next_wake_up - TimeTicks::Now(), TimeDelta()));
+}
+
+}  // namespace
+
 // BaseTimerTaskInternal is a simple delegate for scheduling a callback to
 // Timer in the thread's default task runner. It also handles the following
 // edge cases:
@@ -59,8 +149,54 @@ class BaseTimerTaskInternal {
   Timer* timer_;
 };
 
+// TimerWheelEntryInternal is what Timer schedules on the TimerWheel of the
+// thread's MessageLoop instead of posting a BaseTimerTaskInternal, so that it
+// can be cancelled for real.
+class TimerWheelEntryInternal : public TimerWheel::Entry {
+ public:
+  explicit TimerWheelEntryInternal(Timer* timer) : timer_(timer) {}
+
+  virtual ~TimerWheelEntryInternal() {
+    Cancel();
+  }
+
+  void Cancel() {
+    if (IsScheduled())
+      wheel()->Cancel(this);
+  }
+
+  // Like ~BaseTimerTaskInternal(), for when the MessageLoop is destructed.
+  void OnMessageLoopDestroyed() {
+    timer_->StopAndAbandon();
+  }
+
+ protected:
+  // TimerWheel::Entry implementation.
+  virtual void OnExpired() OVERRIDE {
+    timer_->RunScheduledTask();
+  }
+
+ private:
+  Timer* timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheelEntryInternal);
+};
+
+void TimerWheelDriver::WillDestroyCurrentMessageLoop() {
+  std::vector<TimerWheel::Entry*> entries;
+  wheel_.Clear(&entries);
+  lazy_tls_driver.Pointer()->Set(NULL);
+  message_loop_->RemoveDestructionObserver(this);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    static_cast<TimerWheelEntryInternal*>(entries[i])->
+        OnMessageLoopDestroyed();
+  }
+  delete this;
+}
+
 Timer::Timer(bool retain_user_task, bool is_repeating)
     : scheduled_task_(NULL),
+      wheel_entry_(NULL),
       thread_id_(0),
       is_repeating_(is_repeating),
       retain_user_task_(retain_user_task),
@@ -72,6 +208,7 @@ Timer::Timer(const tracked_objects::Location& posted_from,
              const base::Closure& user_task,
              bool is_repeating)
     : scheduled_task_(NULL),
+      wheel_entry_(NULL),
       posted_from_(posted_from),
       delay_(delay),
       user_task_(user_task),
@@ -83,6 +220,7 @@ Timer::Timer(const tracked_objects::Location& posted_from,
 
 Timer::~Timer() {
   StopAndAbandon();
+  delete wheel_entry_;
 }
 
 void Timer::Start(const tracked_objects::Location& posted_from,
@@ -94,6 +232,8 @@ void Timer::Start(const tracked_objects::Location& posted_from,
 
 void Timer::Stop() {
   is_running_ = false;
+  if (wheel_entry_)
+    wheel_entry_->Cancel();
   if (!retain_user_task_)
     user_task_.Reset();
 }
@@ -101,7 +241,8 @@ void Timer::Stop() {
 void Timer::Reset() {
   DCHECK(!user_task_.is_null());
 
-  // If there's no pending task, start one up and return.
+  // If there's no pending task, start one up and return.  This is always the
+  // case for timers on a TimerWheel, which can be rescheduled in place.
   if (!scheduled_task_) {
     PostNewScheduledTask(delay_);
     return;
@@ -136,16 +277,30 @@ void Timer::SetTaskInfo(const tracked_objects::Location& posted_from,
 void Timer::PostNewScheduledTask(TimeDelta delay) {
   DCHECK(scheduled_task_ == NULL);
   is_running_ = true;
-  scheduled_task_ = new BaseTimerTaskInternal(this);
-  if (delay > TimeDelta::FromMicroseconds(0)) {
-    ThreadTaskRunnerHandle::Get()->PostDelayedTask(posted_from_,
-        base::Bind(&BaseTimerTaskInternal::Run, base::Owned(scheduled_task_)),
-        delay);
+  TimerWheelDriver* driver = NULL;
+  if (delay > TimeDelta::FromMicroseconds(0))
+    driver = TimerWheelDriver::GetForCurrentThread();
+  if (driver) {
+    if (!wheel_entry_)
+      wheel_entry_ = new TimerWheelEntryInternal(this);
     scheduled_run_time_ = desired_run_time_ = TimeTicks::Now() + delay;
+    driver->Schedule(wheel_entry_, desired_run_time_);
   } else {
-    ThreadTaskRunnerHandle::Get()->PostTask(posted_from_,
-        base::Bind(&BaseTimerTaskInternal::Run, base::Owned(scheduled_task_)));
-    scheduled_run_time_ = desired_run_time_ = TimeTicks();
+    if (wheel_entry_)
+      wheel_entry_->Cancel();
+    scheduled_task_ = new BaseTimerTaskInternal(this);
+    if (delay > TimeDelta::FromMicroseconds(0)) {
+      ThreadTaskRunnerHandle::Get()->PostDelayedTask(posted_from_,
+          base::Bind(&BaseTimerTaskInternal::Run,
+                     base::Owned(scheduled_task_)),
+          delay);
+      scheduled_run_time_ = desired_run_time_ = TimeTicks::Now() + delay;
+    } else {
+      ThreadTaskRunnerHandle::Get()->PostTask(posted_from_,
+          base::Bind(&BaseTimerTaskInternal::Run,
+                     base::Owned(scheduled_task_)));
+      scheduled_run_time_ = desired_run_time_ = TimeTicks();
+    }
   }
   // Remember the thread ID that posts the first task -- this will be verified
   // later when the task is abandoned to detect misuse from multiple threads.
@@ -60,12 +60,17 @@
 namespace base {
 
 class BaseTimerTaskInternal;
+class TimerWheelEntryInternal;
 
 //-----------------------------------------------------------------------------
 // This class wraps MessageLoop::PostDelayedTask to manage delayed and repeating
 // tasks. It must be destructed on the same thread that starts tasks. There are
 // DCHECKs in place to verify this.
 //
+// Timers with a delay that run on a MessageLoop share the MessageLoop's
+// TimerWheel, which only posts a task for the earliest of them, and fires them
+// up to a millisecond late.
+//
 class BASE_EXPORT Timer {
  public:
   // Construct a timer in repeating or one-shot mode. Start or SetTaskInfo must
@@ -117,6 +122,7 @@ class BASE_EXPORT Timer {
 
  private:
   friend class BaseTimerTaskInternal;
+  friend class TimerWheelEntryInternal;
 
   // Allocates a new scheduled_task_ and posts it on the current MessageLoop
   // with the given |delay|. scheduled_task_ must be NULL. scheduled_run_time_
@@ -140,6 +146,12 @@ class BASE_EXPORT Timer {
   // RunScheduledTask() at scheduled_run_time_.
   BaseTimerTaskInternal* scheduled_task_;
 
+  // With a delay and a MessageLoop, the timer is scheduled on the
+  // MessageLoop's TimerWheel through this instead, which is created on first
+  // use and kept for reuse.  Stop() and Reset() cancel and reschedule it in
+  // place.
+  TimerWheelEntryInternal* wheel_entry_;
+
   // Location in user code.
   tracked_objects::Location posted_from_;
   // Delay requested by user.
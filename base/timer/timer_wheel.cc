@@ -0,0 +1,206 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/timer/timer_wheel.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace base {
+
+namespace {
+
+int64 TicksFromDelta(TimeDelta delta, bool round_up) {
+  int64 us = delta.InMicroseconds();
+  if (round_up && us > 0)
+    us += Time::kMicrosecondsPerMillisecond - 1;
+  return us / Time::kMicrosecondsPerMillisecond;
+}
+
+}  // namespace
+
+// static
+bool TimerWheel::ExpiresBefore(const Entry* a, const Entry* b) {
+  if (a->deadline_ != b->deadline_)
+    return a->deadline_ < b->deadline_;
+  return a->sequence_number_ < b->sequence_number_;
+}
+
+TimerWheel::Entry::Entry()
+    : wheel_(NULL),
+      tick_(0),
+      sequence_number_(0),
+      level_(0),
+      slot_(0) {
+}
+
+TimerWheel::Entry::~Entry() {
+  DCHECK(!IsScheduled());
+}
+
+TimerWheel::TimerWheel(TimeTicks origin)
+    : origin_(origin),
+      current_tick_(0),
+      next_sequence_number_(0),
+      size_(0) {
+  for (int level = 0; level < kLevels; ++level)
+    occupied_[level] = 0;
+}
+
+TimerWheel::~TimerWheel() {
+  Clear(NULL);
+}
+
+void TimerWheel::Schedule(Entry* entry, TimeTicks deadline) {
+  if (entry->wheel_)
+    entry->wheel_->Cancel(entry);
+
+  entry->wheel_ = this;
+  entry->deadline_ = deadline;
+  entry->tick_ = std::max(TicksFromDelta(deadline - origin_, true),
+                          current_tick_ + 1);
+  entry->sequence_number_ = next_sequence_number_++;
+  ++size_;
+  Insert(entry);
+}
+
+void TimerWheel::Cancel(Entry* entry) {
+  DCHECK_EQ(this, entry->wheel_);
+  entry->RemoveFromList();
+  entry->wheel_ = NULL;
+  --size_;
+  if (entry->level_ != kExpiring) {
+    const Slot& slot = slots_[entry->level_][entry->slot_];
+    if (slot.head() == slot.end())
+      occupied_[entry->level_] &= ~(GG_UINT64_C(1) << entry->slot_);
+  }
+}
+
+void TimerWheel::Clear(std::vector<Entry*>* entries) {
+  std::vector<Entry*> cleared;
+  for (int level = 0; level < kLevels; ++level) {
+    for (int slot = 0; slot < kSlotsPerLevel; ++slot)
+      TakeEntries(level, slot, &cleared);
+  }
+  for (size_t i = 0; i < cleared.size(); ++i)
+    cleared[i]->wheel_ = NULL;
+  size_ -= cleared.size();
+  if (entries)
+    entries->insert(entries->end(), cleared.begin(), cleared.end());
+}
+
+void TimerWheel::Advance(TimeTicks now) {
+  int64 target_tick = TicksFromDelta(now - origin_, false);
+  while (true) {
+    int64 tick = NextEventTick();
+    if (tick < 0 || tick > target_tick)
+      break;
+    current_tick_ = tick;
+    // Cascade from the top, so that entries can move down several levels at
+    // once.
+    for (int level = kLevels - 1; level > 0; --level) {
+      int64 level_mask = (GG_INT64_C(1) << (level * kLevelBits)) - 1;
+      if (!(current_tick_ & level_mask))
+        Cascade(level);
+    }
+    Expire();
+  }
+  // Nothing happens in between, so skip ahead.
+  current_tick_ = std::max(current_tick_, target_tick);
+}
+
+TimeTicks TimerWheel::NextWakeUpTime() const {
+  int64 tick = NextEventTick();
+  if (tick < 0)
+    return TimeTicks();
+  return origin_ + TimeDelta::FromMilliseconds(tick);
+}
+
+void TimerWheel::Insert(Entry* entry) {
+  DCHECK_GE(entry->tick_, current_tick_);
+  int level = 0;
+  int shift = 0;
+  while (level < kLevels - 1 &&
+         (entry->tick_ >> shift) - (current_tick_ >> shift) >= kSlotsPerLevel) {
+    ++level;
+    shift += kLevelBits;
+  }
+  // Park entries that are out of reach in the last slot of the top level,
+  // from where they get placed again once the wheel gets there.
+  int64 window = std::min(entry->tick_ >> shift,
+                          (current_tick_ >> shift) + kSlotsPerLevel - 1);
+  entry->level_ = level;
+  entry->slot_ = static_cast<int>(window & kSlotMask);
+  slots_[level][entry->slot_].Append(entry);
+  occupied_[level] |= GG_UINT64_C(1) << entry->slot_;
+}
+
+int64 TimerWheel::NextEventTick() const {
+  int64 next_tick = -1;
+  for (int level = 0; level < kLevels; ++level) {
+    if (!occupied_[level])
+      continue;
+    // The slot that |current_tick_| is in is never occupied above level 0,
+    // and has expired on level 0.
+    int shift = level * kLevelBits;
+    int64 window = current_tick_ >> shift;
+    for (int i = 1; i < kSlotsPerLevel; ++i) {
+      int slot = static_cast<int>((window + i) & kSlotMask);
+      if (occupied_[level] & (GG_UINT64_C(1) << slot)) {
+        int64 tick = (window + i) << shift;
+        if (next_tick < 0 || tick < next_tick)
+          next_tick = tick;
+        break;
+      }
+    }
+  }
+  return next_tick;
+}
+
+void TimerWheel::Cascade(int level) {
+  std::vector<Entry*> entries;
+  TakeEntries(level, static_cast<int>(
+      (current_tick_ >> (level * kLevelBits)) & kSlotMask), &entries);
+  for (size_t i = 0; i < entries.size(); ++i)
+    Insert(entries[i]);
+}
+
+void TimerWheel::Expire() {
+  std::vector<Entry*> entries;
+  TakeEntries(0, static_cast<int>(current_tick_ & kSlotMask), &entries);
+  if (entries.empty())
+    return;
+
+  // Keep the entries linked in while they run one by one, so that they can
+  // still be cancelled.
+  std::sort(entries.begin(), entries.end(), ExpiresBefore);
+  Slot expiring;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    entries[i]->level_ = kExpiring;
+    expiring.Append(entries[i]);
+  }
+  while (expiring.head() != expiring.end()) {
+    Entry* entry = expiring.head()->value();
+    entry->RemoveFromList();
+    entry->wheel_ = NULL;
+    --size_;
+    entry->OnExpired();
+    // |entry| may be deleted.
+  }
+}
+
+void TimerWheel::TakeEntries(int level,
+                             int slot,
+                             std::vector<Entry*>* entries) {
+  Slot& list = slots_[level][slot];
+  while (list.head() != list.end()) {
+    Entry* entry = list.head()->value();
+    entry->RemoveFromList();
+    entries->push_back(entry);
+  }
+  occupied_[level] &= ~(GG_UINT64_C(1) << slot);
+}
+
+}  // namespace base
@@ -0,0 +1,150 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TIMER_TIMER_WHEEL_H_
+#define BASE_TIMER_TIMER_WHEEL_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/containers/linked_list.h"
+#include "base/time/time.h"
+
+namespace base {
+
+// A hierarchical timing wheel: a set of deadlines with O(1) insertion and
+// cancellation, at the cost of rounding every deadline up to the next
+// millisecond.  Timer keeps the timers of a MessageLoop on one of these, and
+// only has the MessageLoop wake it up when the earliest of them is due, so
+// that stopping or restarting a timer doesn't leave an orphaned task behind
+// in the MessageLoop's delayed work queue.
+//
+// Each of the kLevels levels has 64 slots that each span 64 times as many
+// milliseconds as a slot of the level below.  An entry goes in the lowest
+// level that reaches its deadline, and moves down a level as the wheel
+// turns and the deadline gets closer ("cascading"), so that every entry is
+// moved at most kLevels times.  Level 0 reaches 64ms out and level 3 about
+// 4.7 hours; entries further out than that are cascaded from the top level
+// again until they are in reach.
+//
+// This class is not thread safe.
+class BASE_EXPORT TimerWheel {
+ public:
+  class BASE_EXPORT Entry : public LinkNode<Entry> {
+   public:
+    Entry();
+    virtual ~Entry();
+
+    bool IsScheduled() const { return wheel_ != NULL; }
+
+    // The wheel the entry is scheduled on, or NULL.
+    TimerWheel* wheel() const { return wheel_; }
+
+    TimeTicks deadline() const { return deadline_; }
+
+   protected:
+    // Called by TimerWheel::Advance() once the deadline has passed.  The entry
+    // is no longer scheduled at that point, and may be deleted or scheduled
+    // again.
+    virtual void OnExpired() = 0;
+
+   private:
+    friend class TimerWheel;
+
+    TimerWheel* wheel_;
+    TimeTicks deadline_;
+
+    // |deadline_| rounded up to whole ticks since the wheel's origin.
+    int64 tick_;
+
+    // Orders entries with the same deadline by when they were scheduled.
+    int64 sequence_number_;
+
+    // Where the entry is linked in; |level_| is kExpiring when it is about to
+    // run in Advance().
+    int level_;
+    int slot_;
+
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  // Deadlines are kept in milliseconds since |origin|.
+  explicit TimerWheel(TimeTicks origin);
+
+  // Unschedules the entries that are left, without running them.
+  ~TimerWheel();
+
+  // Schedules |entry| to expire at |deadline|, or as soon as possible if that
+  // has already passed.  Reschedules |entry| if it was already scheduled.
+  void Schedule(Entry* entry, TimeTicks deadline);
+
+  // Unschedules |entry|, so that it doesn't expire.
+  void Cancel(Entry* entry);
+
+  // Unschedules all entries, and appends them to |entries| if not NULL.
+  void Clear(std::vector<Entry*>* entries);
+
+  // Runs OnExpired() for every entry whose deadline is at or before |now|, in
+  // the order of their deadlines.  The entries may schedule and cancel
+  // entries of the wheel, including ones expiring in the same call.
+  void Advance(TimeTicks now);
+
+  // Returns when Advance() next needs to be called.  This may be before the
+  // earliest deadline, when entries have to be cascaded first, but never
+  // after.  Returns a null TimeTicks if the wheel is empty.
+  TimeTicks NextWakeUpTime() const;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  enum {
+    kLevelBits = 6,
+    kSlotsPerLevel = 1 << kLevelBits,
+    kSlotMask = kSlotsPerLevel - 1,
+    kLevels = 4,
+    kExpiring = -1,
+  };
+
+  typedef LinkedList<Entry> Slot;
+
+  // Orders entries by deadline, and then by when they were scheduled.
+  static bool ExpiresBefore(const Entry* a, const Entry* b);
+
+  // Links |entry| into the slot for its |tick_|.
+  void Insert(Entry* entry);
+
+  // Returns the next tick after |current_tick_| at which a slot of level 0
+  // expires or one of a higher level cascades, or -1 if there is none.
+  int64 NextEventTick() const;
+
+  // Re-inserts the entries of the |level| slot that |current_tick_| is in.
+  void Cascade(int level);
+
+  // Runs the entries of the level 0 slot that |current_tick_| is in.
+  void Expire();
+
+  // Unlinks |slot| and returns its entries in |entries|.
+  void TakeEntries(int level, int slot, std::vector<Entry*>* entries);
+
+  const TimeTicks origin_;
+
+  // Every entry that expires at or before this tick has been run.
+  int64 current_tick_;
+
+  int64 next_sequence_number_;
+  size_t size_;
+
+  Slot slots_[kLevels][kSlotsPerLevel];
+
+  // Bit i of |occupied_[level]| is set iff |slots_[level][i]| is non-empty.
+  uint64 occupied_[kLevels];
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace base
+
+#endif  // BASE_TIMER_TIMER_WHEEL_H_
@@ -0,0 +1,169 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/timer/timer_wheel.h"
+
+#include <vector>
+
+#include "base/memory/scoped_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class TestEntry : public TimerWheel::Entry {
+ public:
+  TestEntry(int id, std::vector<int>* expired)
+      : id_(id), expired_(expired), cancel_on_expiry_(NULL) {}
+
+  virtual ~TestEntry() {
+    if (IsScheduled())
+      wheel()->Cancel(this);
+  }
+
+  // Cancels |entry| when expiring.
+  void set_cancel_on_expiry(TestEntry* entry) { cancel_on_expiry_ = entry; }
+
+ protected:
+  virtual void OnExpired() OVERRIDE {
+    expired_->push_back(id_);
+    if (cancel_on_expiry_ && cancel_on_expiry_->IsScheduled())
+      cancel_on_expiry_->wheel()->Cancel(cancel_on_expiry_);
+  }
+
+ private:
+  const int id_;
+  std::vector<int>* expired_;
+  TestEntry* cancel_on_expiry_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestEntry);
+};
+
+class TimerWheelTest : public testing::Test {
+ protected:
+  TimerWheelTest() : origin_(TimeTicks::Now()), wheel_(origin_) {}
+
+  TimeTicks At(int64 ms) const {
+    return origin_ + TimeDelta::FromMilliseconds(ms);
+  }
+
+  TimeTicks AtMicroseconds(int64 us) const {
+    return origin_ + TimeDelta::FromMicroseconds(us);
+  }
+
+  const TimeTicks origin_;
+  TimerWheel wheel_;
+  std::vector<int> expired_;
+};
+
+}  // namespace
+
+TEST_F(TimerWheelTest, ExpiresInOrder) {
+  const int64 kDeadlines[] = {
+    5, 1, 63, 64, 65, 4095, 4096, 4097, 300000, 3, 1000000, 3,
+  };
+  ScopedVector<TestEntry> entries;
+  for (size_t i = 0; i < arraysize(kDeadlines); ++i) {
+    entries.push_back(new TestEntry(i, &expired_));
+    wheel_.Schedule(entries.back(), At(kDeadlines[i]));
+  }
+  EXPECT_EQ(arraysize(kDeadlines), wheel_.size());
+
+  wheel_.Advance(At(3));
+  // Same deadlines expire in the order they were scheduled.
+  ASSERT_EQ(3u, expired_.size());
+  EXPECT_EQ(1, expired_[0]);
+  EXPECT_EQ(9, expired_[1]);
+  EXPECT_EQ(11, expired_[2]);
+
+  wheel_.Advance(At(2000000));
+  const int kOrder[] = { 1, 9, 11, 0, 2, 3, 4, 5, 6, 7, 8, 10 };
+  ASSERT_EQ(arraysize(kOrder), expired_.size());
+  for (size_t i = 0; i < arraysize(kOrder); ++i)
+    EXPECT_EQ(kOrder[i], expired_[i]) << i;
+  EXPECT_TRUE(wheel_.empty());
+  EXPECT_TRUE(wheel_.NextWakeUpTime().is_null());
+}
+
+TEST_F(TimerWheelTest, NeverExpiresEarly) {
+  TestEntry entry(0, &expired_);
+  // Rounded up to 11ms.
+  wheel_.Schedule(&entry, AtMicroseconds(10001));
+  EXPECT_LE(At(11), wheel_.NextWakeUpTime());
+  wheel_.Advance(AtMicroseconds(10999));
+  EXPECT_TRUE(expired_.empty());
+  wheel_.Advance(At(11));
+  EXPECT_EQ(1u, expired_.size());
+
+  // Deadlines out of reach of all levels.
+  const int64 kTenHours = 10 * 60 * 60 * 1000;
+  wheel_.Schedule(&entry, At(kTenHours));
+  TimeTicks wake_up = wheel_.NextWakeUpTime();
+  while (!wake_up.is_null() && wake_up < At(kTenHours)) {
+    wheel_.Advance(wake_up);
+    EXPECT_EQ(1u, expired_.size());
+    EXPECT_LT(wake_up, wheel_.NextWakeUpTime());
+    wake_up = wheel_.NextWakeUpTime();
+  }
+  EXPECT_EQ(At(kTenHours), wake_up);
+  wheel_.Advance(wake_up);
+  EXPECT_EQ(2u, expired_.size());
+}
+
+TEST_F(TimerWheelTest, PastDeadline) {
+  wheel_.Advance(At(100));
+  TestEntry entry(0, &expired_);
+  wheel_.Schedule(&entry, At(50));
+  EXPECT_EQ(At(101), wheel_.NextWakeUpTime());
+  wheel_.Advance(At(100));
+  EXPECT_TRUE(expired_.empty());
+  wheel_.Advance(At(101));
+  EXPECT_EQ(1u, expired_.size());
+}
+
+TEST_F(TimerWheelTest, CancelAndReschedule) {
+  TestEntry first(0, &expired_);
+  TestEntry second(1, &expired_);
+  wheel_.Schedule(&first, At(10));
+  wheel_.Schedule(&second, At(5000));
+  wheel_.Cancel(&first);
+  EXPECT_FALSE(first.IsScheduled());
+  EXPECT_EQ(1u, wheel_.size());
+
+  // Moving an entry earlier or later.
+  wheel_.Schedule(&second, At(20));
+  wheel_.Schedule(&first, At(30));
+  wheel_.Schedule(&first, At(15));
+  wheel_.Advance(At(10000));
+  ASSERT_EQ(2u, expired_.size());
+  EXPECT_EQ(0, expired_[0]);
+  EXPECT_EQ(1, expired_[1]);
+
+  // Cancelling an entry that is due in the same Advance().
+  wheel_.Schedule(&first, At(10001));
+  wheel_.Schedule(&second, At(10001));
+  first.set_cancel_on_expiry(&second);
+  wheel_.Advance(At(10001));
+  ASSERT_EQ(3u, expired_.size());
+  EXPECT_EQ(0, expired_[2]);
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, Clear) {
+  TestEntry first(0, &expired_);
+  TestEntry second(1, &expired_);
+  wheel_.Schedule(&first, At(10));
+  wheel_.Schedule(&second, At(100000));
+  std::vector<TimerWheel::Entry*> entries;
+  wheel_.Clear(&entries);
+  EXPECT_EQ(2u, entries.size());
+  EXPECT_TRUE(wheel_.empty());
+  EXPECT_FALSE(first.IsScheduled());
+  EXPECT_FALSE(second.IsScheduled());
+  wheel_.Advance(At(200000));
+  EXPECT_TRUE(expired_.empty());
+}
+
+}  // namespace base
@@ -6,6 +6,7 @@
 
 #include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "base/atomicops.h"
 #include "base/base_switches.h"
@@ -80,6 +81,36 @@ inline bool IsProfilerTimingEnabled() {
   return current_timing_enabled == ENABLED_TIMING;
 }
 
+// Whether runs are also timed with the CPU clock of the thread they run on.
+inline bool IsThreadCpuTimingEnabled() {
+  return kTrackAllTaskObjects && ThreadData::TrackingStatus() &&
+      IsProfilerTimingEnabled() && base::TimeTicks::IsThreadNowSupported();
+}
+
+// Returns the duration below which |percent| of the durations tallied in
+// |buckets| fall, rounded up to the top of a bucket.
+int32 EstimatePercentile(const std::vector<int32>& buckets, int percent) {
+  // Snapshots come from other processes too. Below two buckets the
+  // distribution only holds zero durations, and above 32 the tops of the
+  // buckets overflow an int32, so neither is estimated.
+  if (buckets.size() < 2 || buckets.size() > 32)
+    return 0;
+  int64 total = 0;
+  for (size_t i = 0; i < buckets.size(); ++i)
+    total += buckets[i];
+  if (!total)
+    return 0;
+  // The number of durations at or below the percentile, rounded up.
+  int64 rank = (total * percent + 99) / 100;
+  int64 seen = 0;
+  for (size_t i = 0; i + 1 < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank)
+      return i ? (1 << i) - 1 : 0;
+  }
+  return 1 << (buckets.size() - 2);
+}
+
 }  // namespace
 
 //------------------------------------------------------------------------------
@@ -106,17 +137,24 @@ DeathData::DeathData(int count) {
 
 void DeathData::RecordDeath(const int32 queue_duration,
                             const int32 run_duration,
+                            const int32 run_cpu_duration,
                             int32 random_number) {
   // We'll just clamp at INT_MAX, but we should note this in the UI as such.
   if (count_ < INT_MAX)
     ++count_;
   queue_duration_sum_ += queue_duration;
   run_duration_sum_ += run_duration;
+  run_cpu_duration_sum_ += run_cpu_duration;
 
   if (queue_duration_max_ < queue_duration)
     queue_duration_max_ = queue_duration;
   if (run_duration_max_ < run_duration)
     run_duration_max_ = run_duration;
+  if (run_cpu_duration_max_ < run_cpu_duration)
+    run_cpu_duration_max_ = run_cpu_duration;
+
+  ++queue_duration_buckets_[DurationBucket(queue_duration)];
+  ++run_duration_buckets_[DurationBucket(run_duration)];
 
   // Take a uniformly distributed sample over all durations ever supplied.
   // The probability that we (instead) use this new sample is 1/count_.  This
@@ -141,6 +179,14 @@ int32 DeathData::run_duration_sample() const {
   return run_duration_sample_;
 }
 
+int32 DeathData::run_cpu_duration_sum() const {
+  return run_cpu_duration_sum_;
+}
+
+int32 DeathData::run_cpu_duration_max() const {
+  return run_cpu_duration_max_;
+}
+
 int32 DeathData::queue_duration_sum() const {
   return queue_duration_sum_;
 }
@@ -153,9 +199,28 @@ int32 DeathData::queue_duration_sample() const {
   return queue_duration_sample_;
 }
 
+const int32* DeathData::run_duration_buckets() const {
+  return run_duration_buckets_;
+}
+
+const int32* DeathData::queue_duration_buckets() const {
+  return queue_duration_buckets_;
+}
+
+// static
+int DeathData::DurationBucket(int32 duration) {
+  int bucket = 0;
+  while (duration > 0 && bucket < kDurationBucketCount - 1) {
+    duration >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
 void DeathData::ResetMax() {
   run_duration_max_ = 0;
   queue_duration_max_ = 0;
+  run_cpu_duration_max_ = 0;
 }
 
 void DeathData::Clear() {
@@ -166,6 +231,10 @@ void DeathData::Clear() {
   queue_duration_sum_ = 0;
   queue_duration_max_ = 0;
   queue_duration_sample_ = 0;
+  run_cpu_duration_sum_ = 0;
+  run_cpu_duration_max_ = 0;
+  memset(run_duration_buckets_, 0, sizeof(run_duration_buckets_));
+  memset(queue_duration_buckets_, 0, sizeof(queue_duration_buckets_));
 }
 
 //------------------------------------------------------------------------------
@@ -174,6 +243,8 @@ DeathDataSnapshot::DeathDataSnapshot()
       run_duration_sum(-1),
       run_duration_max(-1),
       run_duration_sample(-1),
+      run_cpu_duration_sum(-1),
+      run_cpu_duration_max(-1),
       queue_duration_sum(-1),
       queue_duration_max(-1),
       queue_duration_sample(-1) {
@@ -185,14 +256,31 @@ DeathDataSnapshot::DeathDataSnapshot(
       run_duration_sum(death_data.run_duration_sum()),
       run_duration_max(death_data.run_duration_max()),
       run_duration_sample(death_data.run_duration_sample()),
+      run_cpu_duration_sum(death_data.run_cpu_duration_sum()),
+      run_cpu_duration_max(death_data.run_cpu_duration_max()),
       queue_duration_sum(death_data.queue_duration_sum()),
       queue_duration_max(death_data.queue_duration_max()),
-      queue_duration_sample(death_data.queue_duration_sample()) {
+      queue_duration_sample(death_data.queue_duration_sample()),
+      run_duration_buckets(
+          death_data.run_duration_buckets(),
+          death_data.run_duration_buckets() + DeathData::kDurationBucketCount),
+      queue_duration_buckets(
+          death_data.queue_duration_buckets(),
+          death_data.queue_duration_buckets() +
+              DeathData::kDurationBucketCount) {
 }
 
 DeathDataSnapshot::~DeathDataSnapshot() {
 }
 
+int32 DeathDataSnapshot::EstimateRunDurationPercentile(int percent) const {
+  return EstimatePercentile(run_duration_buckets, percent);
+}
+
+int32 DeathDataSnapshot::EstimateQueueDurationPercentile(int percent) const {
+  return EstimatePercentile(queue_duration_buckets, percent);
+}
+
 //------------------------------------------------------------------------------
 BirthOnThread::BirthOnThread(const Location& location,
                              const ThreadData& current)
@@ -447,6 +535,13 @@ void ThreadData::TallyADeath(const Births& birth,
   if (kAllowAlternateTimeSourceHandling && now_function_)
     queue_duration = 0;
 
+  int32 run_cpu_duration = 0;
+  if (!run_cpu_start_stack_.empty()) {
+    run_cpu_duration = (base::TimeTicks::ThreadNow() -
+                        run_cpu_start_stack_.top()).InMilliseconds();
+    run_cpu_start_stack_.pop();
+  }
+
   DeathMap::iterator it = death_map_.find(&birth);
   DeathData* death_data;
   if (it != death_map_.end()) {
@@ -455,7 +550,8 @@ void ThreadData::TallyADeath(const Births& birth,
     base::AutoLock lock(map_lock_);  // Lock as the map may get relocated now.
     death_data = &death_map_[&birth];
   }  // Release lock ASAP.
-  death_data->RecordDeath(queue_duration, run_duration, random_number_);
+  death_data->RecordDeath(queue_duration, run_duration, run_cpu_duration,
+                          random_number_);
 
   if (!kTrackParentChildLinks)
     return;
@@ -764,6 +860,14 @@ TrackedTime ThreadData::NowForStartOfRun(const Births* parent) {
     if (current_thread_data)
       current_thread_data->parent_stack_.push(parent);
   }
+  // Only runs with a |parent| reach TallyADeath(), which pops the stack.
+  if (parent && IsThreadCpuTimingEnabled()) {
+    ThreadData* current_thread_data = Get();
+    if (current_thread_data) {
+      current_thread_data->run_cpu_start_stack_.push(
+          base::TimeTicks::ThreadNow());
+    }
+  }
   return Now();
 }
 
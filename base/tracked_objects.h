@@ -21,6 +21,7 @@
 #include "base/profiler/tracked_time.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_local_storage.h"
+#include "base/time/time.h"
 
 namespace base {
 struct TrackingInfo;
@@ -269,10 +270,18 @@ class BASE_EXPORT DeathData {
   // a corresponding death.
   explicit DeathData(int count);
 
+  // Durations are also tallied in buckets of exponentially growing size, so
+  // that percentiles can be estimated: bucket 0 counts durations of 0ms, and
+  // bucket i > 0 counts those from 2^(i-1) to 2^i - 1 ms, except for the last
+  // one which counts everything longer.
+  enum { kDurationBucketCount = 12 };
+
   // Update stats for a task destruction (death) that had a Run() time of
-  // |duration|, and has had a queueing delay of |queue_duration|.
+  // |duration|, of which |run_cpu_duration| was spent on the CPU, and has had
+  // a queueing delay of |queue_duration|.
   void RecordDeath(const int32 queue_duration,
                    const int32 run_duration,
+                   const int32 run_cpu_duration,
                    int random_number);
 
   // Metrics accessors, used only for serialization and in tests.
@@ -280,9 +289,16 @@ class BASE_EXPORT DeathData {
   int32 run_duration_sum() const;
   int32 run_duration_max() const;
   int32 run_duration_sample() const;
+  int32 run_cpu_duration_sum() const;
+  int32 run_cpu_duration_max() const;
   int32 queue_duration_sum() const;
   int32 queue_duration_max() const;
   int32 queue_duration_sample() const;
+  const int32* run_duration_buckets() const;
+  const int32* queue_duration_buckets() const;
+
+  // Returns the bucket that |duration| is tallied in.
+  static int DurationBucket(int32 duration);
 
   // Reset the max values to zero.
   void ResetMax();
@@ -302,10 +318,18 @@ class BASE_EXPORT DeathData {
   // but rarely updated.
   int32 run_duration_max_;
   int32 queue_duration_max_;
+  // Time spent running on the CPU, as opposed to waiting on I/O, locks, or
+  // for other threads to be scheduled.  Zero where the platform doesn't
+  // provide a thread CPU clock.
+  int32 run_cpu_duration_sum_;
+  int32 run_cpu_duration_max_;
   // Samples, used by crowd sourcing gatherers.  These are almost never read,
   // and rarely updated.
   int32 run_duration_sample_;
   int32 queue_duration_sample_;
+  // Duration distributions, read only by snapshots.
+  int32 run_duration_buckets_[kDurationBucketCount];
+  int32 queue_duration_buckets_[kDurationBucketCount];
 };
 
 //------------------------------------------------------------------------------
@@ -316,13 +340,24 @@ struct BASE_EXPORT DeathDataSnapshot {
   explicit DeathDataSnapshot(const DeathData& death_data);
   ~DeathDataSnapshot();
 
+  // Estimates the duration that |percent| of the runs or queueing delays did
+  // not exceed, from the bucketed distributions.  Rounds up to the top of the
+  // bucket the percentile falls in, or returns the bottom of the last bucket
+  // if it falls there.  Returns 0 if there is no distribution.
+  int32 EstimateRunDurationPercentile(int percent) const;
+  int32 EstimateQueueDurationPercentile(int percent) const;
+
   int count;
   int32 run_duration_sum;
   int32 run_duration_max;
   int32 run_duration_sample;
+  int32 run_cpu_duration_sum;
+  int32 run_cpu_duration_max;
   int32 queue_duration_sum;
   int32 queue_duration_max;
   int32 queue_duration_sample;
+  std::vector<int32> run_duration_buckets;
+  std::vector<int32> queue_duration_buckets;
 };
 
 //------------------------------------------------------------------------------
@@ -523,6 +558,8 @@ class BASE_EXPORT ThreadData {
   Births* TallyABirth(const Location& location);
 
   // Find a place to record a death on this thread.
+  // The CPU time of the run is measured here, from the thread CPU clock
+  // reading that NowForStartOfRun() pushed on run_cpu_start_stack_.
   void TallyADeath(const Births& birth, int32 queue_duration, int32 duration);
 
   // Snapshot (under a lock) the profiled data for the tasks in each ThreadData
@@ -674,6 +711,12 @@ class BASE_EXPORT ThreadData {
   // significant additional cost).
   ParentStack parent_stack_;
 
+  // The thread CPU clock at the start of each run that is currently being
+  // profiled, innermost last, when that clock is available.  Like
+  // parent_stack_ it is usually at most one deep.  Nested runs are not
+  // deducted from the runs around them.
+  std::stack<base::TimeTicks> run_cpu_start_stack_;
+
   // A random number that we used to select decide which sample to keep as a
   // representative sample in each DeathData instance.  We can't start off with
   // much randomness (because we can't call RandInt() on all our threads), so
@@ -6,6 +6,7 @@
 
 #include "base/tracked_objects.h"
 
+#include <limits.h>
 #include <stddef.h>
 
 #include "base/memory/scoped_ptr.h"
@@ -242,21 +243,24 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   EXPECT_EQ(data->count(), 0);
 
   int32 run_ms = 42;
+  int32 run_cpu_ms = 40;
   int32 queue_ms = 8;
 
   const int kUnrandomInt = 0;  // Fake random int that ensure we sample data.
-  data->RecordDeath(queue_ms, run_ms, kUnrandomInt);
+  data->RecordDeath(queue_ms, run_ms, run_cpu_ms, kUnrandomInt);
   EXPECT_EQ(data->run_duration_sum(), run_ms);
   EXPECT_EQ(data->run_duration_sample(), run_ms);
   EXPECT_EQ(data->queue_duration_sum(), queue_ms);
   EXPECT_EQ(data->queue_duration_sample(), queue_ms);
   EXPECT_EQ(data->count(), 1);
 
-  data->RecordDeath(queue_ms, run_ms, kUnrandomInt);
+  data->RecordDeath(queue_ms, run_ms, run_cpu_ms, kUnrandomInt);
   EXPECT_EQ(data->run_duration_sum(), run_ms + run_ms);
   EXPECT_EQ(data->run_duration_sample(), run_ms);
   EXPECT_EQ(data->queue_duration_sum(), queue_ms + queue_ms);
   EXPECT_EQ(data->queue_duration_sample(), queue_ms);
+  EXPECT_EQ(data->run_cpu_duration_sum(), run_cpu_ms + run_cpu_ms);
+  EXPECT_EQ(data->run_cpu_duration_max(), run_cpu_ms);
   EXPECT_EQ(data->count(), 2);
 
   DeathDataSnapshot snapshot(*data);
@@ -264,9 +268,61 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   EXPECT_EQ(2 * run_ms, snapshot.run_duration_sum);
   EXPECT_EQ(run_ms, snapshot.run_duration_max);
   EXPECT_EQ(run_ms, snapshot.run_duration_sample);
+  EXPECT_EQ(2 * run_cpu_ms, snapshot.run_cpu_duration_sum);
+  EXPECT_EQ(run_cpu_ms, snapshot.run_cpu_duration_max);
   EXPECT_EQ(2 * queue_ms, snapshot.queue_duration_sum);
   EXPECT_EQ(queue_ms, snapshot.queue_duration_max);
   EXPECT_EQ(queue_ms, snapshot.queue_duration_sample);
+  ASSERT_EQ(static_cast<size_t>(DeathData::kDurationBucketCount),
+            snapshot.run_duration_buckets.size());
+  // 42ms falls in the 32-63ms bucket, and 8ms in the 8-15ms one.
+  EXPECT_EQ(2, snapshot.run_duration_buckets[6]);
+  EXPECT_EQ(2, snapshot.queue_duration_buckets[4]);
+  EXPECT_EQ(63, snapshot.EstimateRunDurationPercentile(50));
+  EXPECT_EQ(15, snapshot.EstimateQueueDurationPercentile(95));
+}
+
+TEST_F(TrackedObjectsTest, DurationPercentiles) {
+  EXPECT_EQ(0, DeathData::DurationBucket(0));
+  EXPECT_EQ(1, DeathData::DurationBucket(1));
+  EXPECT_EQ(2, DeathData::DurationBucket(2));
+  EXPECT_EQ(2, DeathData::DurationBucket(3));
+  EXPECT_EQ(3, DeathData::DurationBucket(4));
+  EXPECT_EQ(10, DeathData::DurationBucket(1023));
+  EXPECT_EQ(DeathData::kDurationBucketCount - 1,
+            DeathData::DurationBucket(1024));
+  EXPECT_EQ(DeathData::kDurationBucketCount - 1,
+            DeathData::DurationBucket(INT_MAX));
+
+  // A few long tasks behind many short ones.
+  DeathData data;
+  for (int i = 0; i < 90; ++i)
+    data.RecordDeath(0, 1, 1, 0);
+  for (int i = 0; i < 9; ++i)
+    data.RecordDeath(20, 100, 2, 0);
+  data.RecordDeath(3000, 5000, 4000, 0);
+
+  DeathDataSnapshot snapshot(data);
+  EXPECT_EQ(1, snapshot.EstimateRunDurationPercentile(50));
+  EXPECT_EQ(1, snapshot.EstimateRunDurationPercentile(90));
+  EXPECT_EQ(127, snapshot.EstimateRunDurationPercentile(95));
+  EXPECT_EQ(1024, snapshot.EstimateRunDurationPercentile(100));
+  EXPECT_EQ(0, snapshot.EstimateQueueDurationPercentile(90));
+  EXPECT_EQ(31, snapshot.EstimateQueueDurationPercentile(99));
+  EXPECT_EQ(4000, snapshot.run_cpu_duration_max);
+
+  // Snapshots that carry no distribution, as from older processes.
+  EXPECT_EQ(0, DeathDataSnapshot().EstimateRunDurationPercentile(50));
+
+  // Nor are distributions too small or too large for DeathData to record.
+  DeathDataSnapshot odd_snapshot;
+  odd_snapshot.run_duration_buckets.assign(1, 5);
+  EXPECT_EQ(0, odd_snapshot.EstimateRunDurationPercentile(50));
+  odd_snapshot.run_duration_buckets.assign(2, 5);
+  EXPECT_EQ(0, odd_snapshot.EstimateRunDurationPercentile(50));
+  EXPECT_EQ(1, odd_snapshot.EstimateRunDurationPercentile(100));
+  odd_snapshot.run_duration_buckets.assign(33, 5);
+  EXPECT_EQ(0, odd_snapshot.EstimateRunDurationPercentile(100));
 }
 
 TEST_F(TrackedObjectsTest, DeactivatedBirthOnlyToSnapshotWorkerThread) {
@@ -0,0 +1,133 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/value_arena.h"
+
+#include "base/logging.h"
+#include "base/values.h"
+
+namespace base {
+
+namespace {
+
+// Values are a few dozen bytes each, so a block holds a good number of them.
+const size_t kBlockSize = 4096;
+
+// Allocations are rounded up to this, which suits every Value.
+const size_t kAlignment = 8;
+
+}  // namespace
+
+// A |T| whose memory comes from a ValueArena. Deleting one through a pointer
+// to any Value finds this class's operator delete through the virtual
+// destructor, so plain heap Values don't pay anything for arenas.
+template <typename T>
+class ArenaValue : public T {
+ public:
+  explicit ArenaValue(ValueArena* arena) : arena_(arena) {}
+
+  template <typename A>
+  ArenaValue(ValueArena* arena, const A& in_value)
+      : T(in_value),
+        arena_(arena) {
+  }
+
+  virtual ~ArenaValue() {
+    arena_->ValueDestroyed();
+  }
+
+  static void* operator new(size_t size, ValueArena* arena) {
+    return arena->Allocate(size);
+  }
+
+  // The arena releases the memory of all of its Values at once.
+  static void operator delete(void* ptr) {}
+  static void operator delete(void* ptr, ValueArena* arena) {}
+
+ private:
+  ValueArena* arena_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArenaValue);
+};
+
+ValueArena::ValueArena()
+    : next_(NULL),
+      end_(NULL),
+      live_values_(0) {
+}
+
+ValueArena::~ValueArena() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_EQ(0u, live_values_) << "A Value outlived its arena";
+  for (size_t i = 0; i < blocks_.size(); ++i)
+    delete[] blocks_[i];
+}
+
+Value* ValueArena::NewNull() {
+  ++live_values_;
+  return new(this) ArenaValue<Value>(this, Value::TYPE_NULL);
+}
+
+FundamentalValue* ValueArena::NewBoolean(bool in_value) {
+  ++live_values_;
+  return new(this) ArenaValue<FundamentalValue>(this, in_value);
+}
+
+FundamentalValue* ValueArena::NewInteger(int in_value) {
+  ++live_values_;
+  return new(this) ArenaValue<FundamentalValue>(this, in_value);
+}
+
+FundamentalValue* ValueArena::NewDouble(double in_value) {
+  ++live_values_;
+  return new(this) ArenaValue<FundamentalValue>(this, in_value);
+}
+
+StringValue* ValueArena::NewString(const std::string& in_value) {
+  ++live_values_;
+  return new(this) ArenaValue<StringValue>(this, in_value);
+}
+
+StringValue* ValueArena::NewString(const string16& in_value) {
+  ++live_values_;
+  return new(this) ArenaValue<StringValue>(this, in_value);
+}
+
+DictionaryValue* ValueArena::NewDictionary() {
+  ++live_values_;
+  return new(this) ArenaValue<DictionaryValue>(this);
+}
+
+ListValue* ValueArena::NewList() {
+  ++live_values_;
+  return new(this) ArenaValue<ListValue>(this);
+}
+
+void* ValueArena::Allocate(size_t size) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  size = (size + kAlignment - 1) & ~(kAlignment - 1);
+  if (size > static_cast<size_t>(end_ - next_)) {
+    // Unusually big objects get a block of their own so the free space in the
+    // current block isn't wasted.
+    if (size > kBlockSize / 4) {
+      char* block = new char[size];
+      blocks_.push_back(block);
+      return block;
+    }
+    next_ = new char[kBlockSize];
+    end_ = next_ + kBlockSize;
+    blocks_.push_back(next_);
+  }
+  void* result = next_;
+  next_ += size;
+  return result;
+}
+
+void ValueArena::ValueDestroyed() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_GT(live_values_, 0u);
+  --live_values_;
+}
+
+}  // namespace base
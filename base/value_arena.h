@@ -0,0 +1,81 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_VALUE_ARENA_H_
+#define BASE_VALUE_ARENA_H_
+
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/strings/string16.h"
+#include "base/threading/thread_checker.h"
+
+namespace base {
+
+class DictionaryValue;
+class FundamentalValue;
+class ListValue;
+class StringValue;
+class Value;
+
+// ValueArena is a bump allocator for base::Value trees whose whole lifetime is
+// known up front, e.g. a large tree that is parsed, read and thrown away in a
+// single function. Building such a tree out of an arena saves a heap
+// allocation per node.
+//
+// Values created by an arena are used like any others, and may be inserted
+// into, detached from and deleted out of ordinary trees. Deleting one runs
+// its destructor but doesn't give its memory back; the arena releases all of
+// its memory at once when it is destroyed. Every Value from an arena must be
+// destroyed before the arena itself, on the arena's thread. DeepCopy() a
+// Value that needs to outlive its arena; the copy comes from the heap.
+//
+//   ValueArena arena;
+//   scoped_ptr<Value> value(JSONReader::ReadInArena(json, 0, &arena));
+//
+// Only the Value objects themselves come from the arena. The std::map nodes,
+// vectors and strings they own still use the heap.
+class BASE_EXPORT ValueArena {
+ public:
+  ValueArena();
+  ~ValueArena();
+
+  // The returned Values are owned by the caller like those made with new.
+  Value* NewNull();
+  FundamentalValue* NewBoolean(bool in_value);
+  FundamentalValue* NewInteger(int in_value);
+  FundamentalValue* NewDouble(double in_value);
+  StringValue* NewString(const std::string& in_value);
+  StringValue* NewString(const string16& in_value);
+  DictionaryValue* NewDictionary();
+  ListValue* NewList();
+
+  // Returns |size| bytes aligned for any Value.
+  void* Allocate(size_t size);
+
+ private:
+  template <typename T> friend class ArenaValue;
+
+  // Called as each Value from this arena is destroyed.
+  void ValueDestroyed();
+
+  std::vector<char*> blocks_;
+
+  // The free space in the last block.
+  char* next_;
+  char* end_;
+
+  // The number of Values from this arena that haven't been destroyed yet.
+  size_t live_values_;
+
+  ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueArena);
+};
+
+}  // namespace base
+
+#endif  // BASE_VALUE_ARENA_H_
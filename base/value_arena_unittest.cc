@@ -0,0 +1,137 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/value_arena.h"
+
+#include <string.h>
+
+#include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(ValueArenaTest, BuildsTrees) {
+  ValueArena arena;
+  scoped_ptr<DictionaryValue> dictionary(arena.NewDictionary());
+  for (int i = 0; i < 1000; ++i) {
+    ListValue* list = arena.NewList();
+    list->Append(arena.NewInteger(i));
+    list->Append(arena.NewDouble(i + 0.5));
+    list->Append(arena.NewBoolean(i % 2 == 0));
+    list->Append(arena.NewString("string"));
+    list->Append(arena.NewString(ASCIIToUTF16("string16")));
+    list->Append(arena.NewNull());
+    dictionary->Set(StringPrintf("key%d", i), list);
+  }
+
+  // Heap Values can be mixed freely with arena ones.
+  dictionary->SetBoolean("heap", true);
+
+  ListValue* list = NULL;
+  ASSERT_TRUE(dictionary->GetList("key999", &list));
+  int integer = 0;
+  EXPECT_TRUE(list->GetInteger(0, &integer));
+  EXPECT_EQ(999, integer);
+  double number = 0;
+  EXPECT_TRUE(list->GetDouble(1, &number));
+  EXPECT_EQ(999.5, number);
+  bool boolean = true;
+  EXPECT_TRUE(list->GetBoolean(2, &boolean));
+  EXPECT_FALSE(boolean);
+  std::string string;
+  EXPECT_TRUE(list->GetString(3, &string));
+  EXPECT_EQ("string", string);
+  EXPECT_TRUE(list->GetString(4, &string));
+  EXPECT_EQ("string16", string);
+  const Value* null = NULL;
+  EXPECT_TRUE(list->Get(5, &null));
+  EXPECT_TRUE(null->IsType(Value::TYPE_NULL));
+}
+
+TEST(ValueArenaTest, DetachAndDeleteChild) {
+  ValueArena arena;
+  scoped_ptr<DictionaryValue> dictionary(arena.NewDictionary());
+  DictionaryValue* child = arena.NewDictionary();
+  child->Set("int", arena.NewInteger(1));
+  dictionary->Set("child", child);
+  dictionary->Set("sibling", arena.NewString("sibling"));
+
+  // A detached child is an ordinary Value as long as the arena is alive.
+  scoped_ptr<Value> detached;
+  ASSERT_TRUE(dictionary->Remove("child", &detached));
+  EXPECT_EQ(child, detached.get());
+  int value = 0;
+  EXPECT_TRUE(child->GetInteger("int", &value));
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(dictionary->HasKey("child"));
+
+  // Deleting it separately from the rest of the tree is fine.
+  detached.reset();
+  std::string sibling;
+  EXPECT_TRUE(dictionary->GetString("sibling", &sibling));
+  EXPECT_EQ("sibling", sibling);
+
+  // So is giving it to a heap tree, and deleting that.
+  scoped_ptr<DictionaryValue> heap(new DictionaryValue);
+  ASSERT_TRUE(dictionary->Remove("sibling", &detached));
+  heap->Set("from_arena", detached.release());
+  heap.reset();
+  EXPECT_TRUE(dictionary->empty());
+}
+
+TEST(ValueArenaTest, DetachedCopyOutlivesArena) {
+  scoped_ptr<Value> copy;
+  {
+    ValueArena arena;
+    scoped_ptr<ListValue> list(arena.NewList());
+    ListValue* child = arena.NewList();
+    child->Append(arena.NewString("kept"));
+    list->Append(child);
+
+    scoped_ptr<Value> detached;
+    ASSERT_TRUE(list->Remove(0, &detached));
+    copy.reset(detached->DeepCopy());
+  }
+
+  // The copy came from the heap, so it is still good.
+  ListValue* list = NULL;
+  ASSERT_TRUE(copy->GetAsList(&list));
+  std::string string;
+  EXPECT_TRUE(list->GetString(0, &string));
+  EXPECT_EQ("kept", string);
+}
+
+TEST(ValueArenaTest, AllocatesLargeValues) {
+  ValueArena arena;
+  // Sizes above and below a block's worth of space.
+  for (size_t size = 8; size < 16384; size *= 2) {
+    void* memory = arena.Allocate(size);
+    memset(memory, 0xAB, size);
+  }
+}
+
+TEST(ValueArenaTest, JSONReader) {
+  const char kJSON[] =
+      "{\"list\": [1, 2.5, \"three\", \"f\\u00f6ur\", null, true],"
+      " \"nested\": {\"a\": {}}}";
+  scoped_ptr<Value> expected(JSONReader::Read(kJSON));
+  ValueArena arena;
+  scoped_ptr<Value> value(JSONReader::ReadInArena(kJSON, 0, &arena));
+  ASSERT_TRUE(value.get());
+  EXPECT_TRUE(expected->Equals(value.get()));
+
+  // The children can be detached without a hidden root getting in the way.
+  DictionaryValue* dictionary = NULL;
+  ASSERT_TRUE(value->GetAsDictionary(&dictionary));
+  scoped_ptr<Value> list;
+  ASSERT_TRUE(dictionary->Remove("list", &list));
+  value.reset();
+  EXPECT_TRUE(list->IsType(Value::TYPE_LIST));
+}
+
+}  // namespace base
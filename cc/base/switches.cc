@@ -79,6 +79,15 @@ const char kCompositeToMailbox[] = "composite-to-mailbox";
 const char kStrictLayerPropertyChangeChecking[] =
     "strict-layer-property-change-checking";
 
+// Gives tiles hidden behind opaque layers on the pending tree a low priority,
+// so that they are rasterized last.
+const char kEnableOcclusionForTilePrioritization[] =
+    "enable-occlusion-for-tile-prioritization";
+
+// Rasterizes the low res tiles of the viewport before the high res ones while
+// smoothness takes priority, e.g. during a fling.
+const char kEnableProgressiveRaster[] = "enable-progressive-raster";
+
 // Virtual viewport for fixed-position elements, scrollbars during pinch.
 const char kEnablePinchVirtualViewport[] = "enable-pinch-virtual-viewport";
 
@@ -144,6 +153,13 @@ const char kCCLayerTreeTestNoTimeout[] = "cc-layer-tree-test-no-timeout";
 // Makes pixel tests write their output instead of read it.
 const char kCCRebaselinePixeltests[] = "cc-rebaseline-pixeltests";
 
+// The layer tree JSON file that the layer tree host perf tests replay.
+const char kCCPerfTestLayerTree[] = "cc-perf-test-layer-tree";
+
+// The JSON list of per-frame invalidations that the layer tree host perf tests
+// replay on top of the layer tree.
+const char kCCPerfTestInvalidations[] = "cc-perf-test-invalidations";
+
 // Disable textures using RGBA_4444 layout.
 const char kDisable4444Textures[] = "disable-4444-textures";
 
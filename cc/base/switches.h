@@ -37,6 +37,8 @@ CC_EXPORT extern const char kMaxTilesForInterestArea[];
 CC_EXPORT extern const char kMaxUnusedResourceMemoryUsagePercentage[];
 CC_EXPORT extern const char kEnablePinchVirtualViewport[];
 CC_EXPORT extern const char kStrictLayerPropertyChangeChecking[];
+CC_EXPORT extern const char kEnableOcclusionForTilePrioritization[];
+CC_EXPORT extern const char kEnableProgressiveRaster[];
 CC_EXPORT extern const char kEnableMapImage[];
 CC_EXPORT extern const char kDisableMapImage[];
 CC_EXPORT extern const char kDisable4444Textures[];
@@ -69,6 +71,8 @@ CC_EXPORT extern const char kUIShowNonOccludingRects[];
 // Unit test related.
 CC_EXPORT extern const char kCCLayerTreeTestNoTimeout[];
 CC_EXPORT extern const char kCCRebaselinePixeltests[];
+CC_EXPORT extern const char kCCPerfTestLayerTree[];
+CC_EXPORT extern const char kCCPerfTestInvalidations[];
 
 CC_EXPORT bool IsLCDTextEnabled();
 CC_EXPORT bool IsGpuRasterizationEnabled();
@@ -122,7 +122,8 @@ void RasterizeAndRecordBenchmark::RunOnLayer(PictureLayer* layer) {
   for (int i = 0; i < record_repeat_count_; ++i) {
     base::TimeTicks start = Now();
     scoped_refptr<Picture> picture = Picture::Create(
-        visible_content_rect, painter, tile_grid_info, false, 0);
+        visible_content_rect, painter, tile_grid_info,
+        false, gfx::Rect(), false, 0);
     base::TimeTicks end = Now();
     base::TimeDelta duration = end - start;
     if (duration < min_time)
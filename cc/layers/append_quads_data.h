@@ -14,17 +14,21 @@ struct AppendQuadsData {
   AppendQuadsData()
       : had_incomplete_tile(false),
         num_missing_tiles(0),
+        checkerboarded_visible_content_area(0),
         render_pass_id(0, 0) {}
 
   explicit AppendQuadsData(RenderPass::Id render_pass_id)
       : had_incomplete_tile(false),
         num_missing_tiles(0),
+        checkerboarded_visible_content_area(0),
         render_pass_id(render_pass_id) {}
 
   // Set by the layer appending quads.
   bool had_incomplete_tile;
   // Set by the layer appending quads.
   int64 num_missing_tiles;
+  // Set by the layer appending quads.
+  int64 checkerboarded_visible_content_area;
   // Given to the layer appending quads.
   const RenderPass::Id render_pass_id;
 };
@@ -37,6 +37,8 @@ Layer::Layer()
     : needs_push_properties_(false),
       num_dependents_need_push_properties_(false),
       stacking_order_changed_(false),
+      regions_changed_(true),
+      scroll_and_clip_relations_changed_(true),
       layer_id_(s_next_layer_id++),
       ignore_set_needs_commit_(false),
       parent_(NULL),
@@ -625,6 +627,7 @@ void Layer::SetScrollParent(Layer* parent) {
   if (scroll_parent_)
     scroll_parent_->AddScrollChild(this);
 
+  scroll_and_clip_relations_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -632,6 +635,7 @@ void Layer::AddScrollChild(Layer* child) {
   if (!scroll_children_)
     scroll_children_.reset(new std::set<Layer*>);
   scroll_children_->insert(child);
+  scroll_and_clip_relations_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -639,6 +643,7 @@ void Layer::RemoveScrollChild(Layer* child) {
   scroll_children_->erase(child);
   if (scroll_children_->empty())
     scroll_children_.reset();
+  scroll_and_clip_relations_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -655,6 +660,7 @@ void Layer::SetClipParent(Layer* ancestor) {
   if (clip_parent_)
     clip_parent_->AddClipChild(this);
 
+  scroll_and_clip_relations_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -662,6 +668,7 @@ void Layer::AddClipChild(Layer* child) {
   if (!clip_children_)
     clip_children_.reset(new std::set<Layer*>);
   clip_children_->insert(child);
+  scroll_and_clip_relations_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -669,6 +676,7 @@ void Layer::RemoveClipChild(Layer* child) {
   clip_children_->erase(child);
   if (clip_children_->empty())
     clip_children_.reset();
+  scroll_and_clip_relations_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -774,6 +782,7 @@ void Layer::SetNonFastScrollableRegion(const Region& region) {
   if (non_fast_scrollable_region_ == region)
     return;
   non_fast_scrollable_region_ = region;
+  regions_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -782,6 +791,7 @@ void Layer::SetTouchEventHandlerRegion(const Region& region) {
   if (touch_event_handler_region_ == region)
     return;
   touch_event_handler_region_ = region;
+  regions_changed_ = true;
   SetNeedsCommit();
 }
 
@@ -899,6 +909,39 @@ static void PostCopyCallbackToMainThread(
                                                base::Passed(&result)));
 }
 
+void Layer::PushScrollAndClipRelationsTo(LayerImpl* layer) {
+  LayerImpl* scroll_parent = NULL;
+  if (scroll_parent_)
+    scroll_parent = layer->layer_tree_impl()->LayerById(scroll_parent_->id());
+
+  layer->SetScrollParent(scroll_parent);
+  if (scroll_children_) {
+    std::set<LayerImpl*>* scroll_children = new std::set<LayerImpl*>;
+    for (std::set<Layer*>::iterator it = scroll_children_->begin();
+        it != scroll_children_->end(); ++it)
+      scroll_children->insert(layer->layer_tree_impl()->LayerById((*it)->id()));
+    layer->SetScrollChildren(scroll_children);
+  }
+
+  LayerImpl* clip_parent = NULL;
+  if (clip_parent_) {
+    clip_parent =
+        layer->layer_tree_impl()->LayerById(clip_parent_->id());
+  }
+
+  layer->SetClipParent(clip_parent);
+  if (clip_children_) {
+    std::set<LayerImpl*>* clip_children = new std::set<LayerImpl*>;
+    for (std::set<Layer*>::iterator it = clip_children_->begin();
+        it != clip_children_->end(); ++it) {
+      LayerImpl* clip_child = layer->layer_tree_impl()->LayerById((*it)->id());
+      DCHECK(clip_child);
+      clip_children->insert(clip_child);
+    }
+    layer->SetClipChildren(clip_children);
+  }
+}
+
 void Layer::PushPropertiesTo(LayerImpl* layer) {
   DCHECK(layer_tree_host_);
 
@@ -934,8 +977,6 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
   layer->SetMasksToBounds(masks_to_bounds_);
   layer->SetShouldScrollOnMainThread(should_scroll_on_main_thread_);
   layer->SetHaveWheelEventHandlers(have_wheel_event_handlers_);
-  layer->SetNonFastScrollableRegion(non_fast_scrollable_region_);
-  layer->SetTouchEventHandlerRegion(touch_event_handler_region_);
   layer->SetContentsOpaque(contents_opaque_);
   if (!layer->OpacityIsAnimatingOnImplOnly() && !OpacityIsAnimating())
     layer->SetOpacity(opacity_);
@@ -958,36 +999,15 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
   layer->set_user_scrollable_horizontal(user_scrollable_horizontal_);
   layer->set_user_scrollable_vertical(user_scrollable_vertical_);
 
-  LayerImpl* scroll_parent = NULL;
-  if (scroll_parent_)
-    scroll_parent = layer->layer_tree_impl()->LayerById(scroll_parent_->id());
-
-  layer->SetScrollParent(scroll_parent);
-  if (scroll_children_) {
-    std::set<LayerImpl*>* scroll_children = new std::set<LayerImpl*>;
-    for (std::set<Layer*>::iterator it = scroll_children_->begin();
-        it != scroll_children_->end(); ++it)
-      scroll_children->insert(layer->layer_tree_impl()->LayerById((*it)->id()));
-    layer->SetScrollChildren(scroll_children);
-  }
-
-  LayerImpl* clip_parent = NULL;
-  if (clip_parent_) {
-    clip_parent =
-        layer->layer_tree_impl()->LayerById(clip_parent_->id());
-  }
-
-  layer->SetClipParent(clip_parent);
-  if (clip_children_) {
-    std::set<LayerImpl*>* clip_children = new std::set<LayerImpl*>;
-    for (std::set<Layer*>::iterator it = clip_children_->begin();
-        it != clip_children_->end(); ++it) {
-      LayerImpl* clip_child = layer->layer_tree_impl()->LayerById((*it)->id());
-      DCHECK(clip_child);
-      clip_children->insert(clip_child);
-    }
-    layer->SetClipChildren(clip_children);
+  // A rebuilt impl tree may have new LayerImpls that haven't seen any of
+  // these properties.
+  bool impl_tree_was_rebuilt = layer->layer_tree_impl()->needs_full_tree_sync();
+  if (regions_changed_ || impl_tree_was_rebuilt) {
+    layer->SetNonFastScrollableRegion(non_fast_scrollable_region_);
+    layer->SetTouchEventHandlerRegion(touch_event_handler_region_);
   }
+  if (scroll_and_clip_relations_changed_ || impl_tree_was_rebuilt)
+    PushScrollAndClipRelationsTo(layer);
 
   // Adjust the scroll delta to be just the scrolls that have happened since
   // the BeginMainFrame was sent.  This happens for impl-side painting
@@ -1034,6 +1054,8 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
 
   // Reset any state that should be cleared for the next update.
   stacking_order_changed_ = false;
+  regions_changed_ = false;
+  scroll_and_clip_relations_changed_ = false;
   update_rect_ = gfx::RectF();
 
   needs_push_properties_ = false;
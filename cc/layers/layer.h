@@ -508,6 +508,11 @@ class CC_EXPORT Layer : public base::RefCounted<Layer>,
   // siblings.
   bool stacking_order_changed_;
 
+  // Properties that are costly to copy are only pushed to the impl side when
+  // they have changed since the last push, or when the impl tree was rebuilt.
+  bool regions_changed_;
+  bool scroll_and_clip_relations_changed_;
+
   // The update rect is the region of the compositor resource that was
   // actually updated by the compositor. For layers that may do updating
   // outside the compositor's control (i.e. plugin layers), this information
@@ -535,6 +540,8 @@ class CC_EXPORT Layer : public base::RefCounted<Layer>,
   // This should only be called from RemoveFromParent().
   void RemoveChildOrDependent(Layer* child);
 
+  void PushScrollAndClipRelationsTo(LayerImpl* layer);
+
   // LayerAnimationValueProvider implementation.
   virtual gfx::Vector2dF ScrollOffsetForAnimation() const OVERRIDE;
 
@@ -47,6 +47,7 @@ namespace cc {
 class LayerTreeHostImpl;
 class LayerTreeImpl;
 class MicroBenchmarkImpl;
+template <typename LayerType, typename SurfaceType> class OcclusionTrackerBase;
 class QuadSink;
 class Renderer;
 class ScrollbarAnimationController;
@@ -179,7 +180,11 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
   virtual RenderPass::Id FirstContributingRenderPassId() const;
   virtual RenderPass::Id NextContributingRenderPassId(RenderPass::Id id) const;
 
-  virtual void UpdateTilePriorities() {}
+  // |occlusion_tracker| holds the occlusion from the layers in front of this
+  // one, or is NULL if occlusion is not used to prioritize tiles.
+  virtual void UpdateTilePriorities(
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+          occlusion_tracker) {}
 
   virtual ScrollbarLayerImplBase* ToScrollbarLayer();
 
@@ -610,6 +610,40 @@ TEST_F(LayerTest, PushPropertiesAccumulatesUpdateRect) {
                        impl_layer->update_rect());
 }
 
+TEST_F(LayerTest, PushPropertiesOnlyPushesRegionsWhenChanged) {
+  scoped_refptr<Layer> test_layer = Layer::Create();
+  scoped_ptr<LayerImpl> impl_layer =
+      LayerImpl::Create(host_impl_.active_tree(), 1);
+
+  EXPECT_SET_NEEDS_FULL_TREE_SYNC(1,
+                                  layer_tree_host_->SetRootLayer(test_layer));
+
+  Region region(gfx::Rect(0, 0, 10, 10));
+  EXPECT_SET_NEEDS_COMMIT(1, test_layer->SetTouchEventHandlerRegion(region));
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(region, impl_layer->touch_event_handler_region());
+
+  // Without a tree rebuild or a change on the main thread, the region is not
+  // pushed again.
+  host_impl_.active_tree()->set_needs_full_tree_sync(false);
+  impl_layer->SetTouchEventHandlerRegion(Region());
+  EXPECT_SET_NEEDS_COMMIT(1, test_layer->SetOpacity(0.5f));
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(Region(), impl_layer->touch_event_handler_region());
+
+  Region new_region(gfx::Rect(5, 5, 10, 10));
+  EXPECT_SET_NEEDS_COMMIT(1,
+                          test_layer->SetTouchEventHandlerRegion(new_region));
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(new_region, impl_layer->touch_event_handler_region());
+
+  // A rebuilt impl tree gets all properties again.
+  host_impl_.active_tree()->set_needs_full_tree_sync(true);
+  impl_layer->SetTouchEventHandlerRegion(Region());
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(new_region, impl_layer->touch_event_handler_region());
+}
+
 TEST_F(LayerTest, PushPropertiesCausesLayerPropertyChangedForTransform) {
   scoped_refptr<Layer> test_layer = Layer::Create();
   scoped_ptr<LayerImpl> impl_layer =
@@ -51,6 +51,9 @@ void PictureLayer::PushPropertiesTo(LayerImpl* base_layer) {
   }
 
   layer_impl->SetIsMask(is_mask_);
+  layer_impl->SetShouldUseGpuRasterization(
+      layer_tree_host()->settings().gpu_rasterization &&
+      pile_->IsSuitableForGpuRasterization());
   // Unlike other properties, invalidation must always be set on layer_impl.
   // See PictureLayerImpl::PushPropertiesTo for more details.
   layer_impl->invalidation_.Clear();
@@ -67,6 +70,10 @@ void PictureLayer::SetLayerTreeHost(LayerTreeHost* host) {
         host->debug_state().slow_down_raster_scale_factor);
     pile_->set_show_debug_picture_borders(
         host->debug_state().show_picture_borders);
+    pile_->set_analyze_pictures_for_gpu_rasterization(
+        host->settings().gpu_rasterization);
+    pile_->set_analyze_pictures_for_solid_color(
+        host->settings().analyze_pictures_for_solid_color);
   }
 }
 
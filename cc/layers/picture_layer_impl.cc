@@ -91,6 +91,9 @@ void PictureLayerImpl::PushPropertiesTo(LayerImpl* base_layer) {
 
   layer_impl->SetIsMask(is_mask_);
   layer_impl->pile_ = pile_;
+  // The tilings swapped below were created for this setting, so it is copied
+  // directly rather than through SetShouldUseGpuRasterization().
+  layer_impl->should_use_gpu_rasterization_ = should_use_gpu_rasterization_;
 
   // Tilings would be expensive to push, so we swap.  This optimization requires
   // an extra invalidation in SyncFromActiveLayer.
@@ -208,25 +211,68 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
   // unused can be considered for removal.
   std::vector<PictureLayerTiling*> seen_tilings;
 
+  // Solid color tiles that follow each other in a row with the same color are
+  // drawn as a single quad, which saves draw calls on plain areas of a page.
+  gfx::Rect solid_color_run_rect;
+  SkColor solid_color_run_color = SK_ColorTRANSPARENT;
+
   for (PictureLayerTilingSet::CoverageIterator iter(
       tilings_.get(), contents_scale_x(), rect, ideal_contents_scale_);
        iter;
        ++iter) {
     gfx::Rect geometry_rect = iter.geometry_rect();
+    if (*iter && iter->IsReadyToDraw() &&
+        iter->GetTileVersionForDrawing().mode() ==
+            ManagedTileState::TileVersion::SOLID_COLOR_MODE) {
+      SkColor color = iter->GetTileVersionForDrawing().get_solid_color();
+      if (!solid_color_run_rect.IsEmpty() &&
+          color == solid_color_run_color &&
+          geometry_rect.x() == solid_color_run_rect.right() &&
+          geometry_rect.y() == solid_color_run_rect.y() &&
+          geometry_rect.height() == solid_color_run_rect.height()) {
+        solid_color_run_rect.Union(geometry_rect);
+      } else {
+        AppendSolidColorQuad(quad_sink,
+                             shared_quad_state,
+                             append_quads_data,
+                             solid_color_run_rect,
+                             solid_color_run_color);
+        solid_color_run_rect = geometry_rect;
+        solid_color_run_color = color;
+      }
+
+      if (seen_tilings.empty() || seen_tilings.back() != iter.CurrentTiling())
+        seen_tilings.push_back(iter.CurrentTiling());
+      continue;
+    }
+
+    AppendSolidColorQuad(quad_sink,
+                         shared_quad_state,
+                         append_quads_data,
+                         solid_color_run_rect,
+                         solid_color_run_color);
+    solid_color_run_rect = gfx::Rect();
+
     if (!*iter || !iter->IsReadyToDraw()) {
       if (DrawCheckerboardForMissingTiles()) {
         // TODO(enne): Figure out how to show debug "invalidated checker" color
         scoped_ptr<CheckerboardDrawQuad> quad = CheckerboardDrawQuad::Create();
         SkColor color = DebugColors::DefaultCheckerboardColor();
         quad->SetNew(shared_quad_state, geometry_rect, color);
-        if (quad_sink->Append(quad.PassAs<DrawQuad>(), append_quads_data))
+        if (quad_sink->Append(quad.PassAs<DrawQuad>(), append_quads_data)) {
           append_quads_data->num_missing_tiles++;
+          append_quads_data->checkerboarded_visible_content_area +=
+              geometry_rect.size().GetArea();
+        }
       } else {
         SkColor color = SafeOpaqueBackgroundColor();
         scoped_ptr<SolidColorDrawQuad> quad = SolidColorDrawQuad::Create();
         quad->SetNew(shared_quad_state, geometry_rect, color, false);
-        if (quad_sink->Append(quad.PassAs<DrawQuad>(), append_quads_data))
+        if (quad_sink->Append(quad.PassAs<DrawQuad>(), append_quads_data)) {
           append_quads_data->num_missing_tiles++;
+          append_quads_data->checkerboarded_visible_content_area +=
+              geometry_rect.size().GetArea();
+        }
       }
 
       append_quads_data->had_incomplete_tile = true;
@@ -278,15 +324,10 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
         draw_quad = quad.PassAs<DrawQuad>();
         break;
       }
-      case ManagedTileState::TileVersion::SOLID_COLOR_MODE: {
-        scoped_ptr<SolidColorDrawQuad> quad = SolidColorDrawQuad::Create();
-        quad->SetNew(shared_quad_state,
-                     geometry_rect,
-                     tile_version.get_solid_color(),
-                     false);
-        draw_quad = quad.PassAs<DrawQuad>();
+      case ManagedTileState::TileVersion::SOLID_COLOR_MODE:
+        // Solid color tiles are appended in runs, above.
+        NOTREACHED();
         break;
-      }
     }
 
     DCHECK(draw_quad);
@@ -296,6 +337,12 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
       seen_tilings.push_back(iter.CurrentTiling());
   }
 
+  AppendSolidColorQuad(quad_sink,
+                       shared_quad_state,
+                       append_quads_data,
+                       solid_color_run_rect,
+                       solid_color_run_color);
+
   // Aggressively remove any tilings that are not seen to save memory. Note
   // that this is at the expense of doing cause more frequent re-painting. A
   // better scheme would be to maintain a tighter visible_content_rect for the
@@ -303,7 +350,22 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
   CleanUpTilingsOnActiveLayer(seen_tilings);
 }
 
-void PictureLayerImpl::UpdateTilePriorities() {
+void PictureLayerImpl::AppendSolidColorQuad(
+    QuadSink* quad_sink,
+    SharedQuadState* shared_quad_state,
+    AppendQuadsData* append_quads_data,
+    const gfx::Rect& rect,
+    SkColor color) {
+  if (rect.IsEmpty())
+    return;
+  scoped_ptr<SolidColorDrawQuad> quad = SolidColorDrawQuad::Create();
+  quad->SetNew(shared_quad_state, rect, color, false);
+  quad_sink->Append(quad.PassAs<DrawQuad>(), append_quads_data);
+}
+
+void PictureLayerImpl::UpdateTilePriorities(
+    const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+        occlusion_tracker) {
   DCHECK(!needs_post_commit_initialization_);
   CHECK(should_update_tile_priorities_);
 
@@ -353,10 +415,16 @@ void PictureLayerImpl::UpdateTilePriorities() {
   tilings_->UpdateTilePriorities(tree,
                                  visible_rect_in_content_space,
                                  contents_scale_x(),
-                                 current_frame_time_in_seconds);
+                                 current_frame_time_in_seconds,
+                                 occlusion_tracker,
+                                 render_target(),
+                                 draw_transform());
 
   if (layer_tree_impl()->IsPendingTree())
     MarkVisibleResourcesAsRequired();
+  else if (layer_tree_impl()->settings().use_progressive_raster &&
+           layer_tree_impl()->SmoothnessTakesPriority())
+    DeferHighResTilesUntilLowResIsReady(visible_rect_in_content_space);
 
   // Tile priorities were modified.
   layer_tree_impl()->DidModifyTilePriorities();
@@ -635,7 +703,7 @@ void PictureLayerImpl::SyncTiling(
   // we can create tiles for this tiling immediately.
   if (!layer_tree_impl()->needs_update_draw_properties() &&
       should_update_tile_priorities_)
-    UpdateTilePriorities();
+    UpdateTilePriorities(NULL);
 }
 
 void PictureLayerImpl::SetIsMask(bool is_mask) {
@@ -794,6 +862,10 @@ bool PictureLayerImpl::MarkVisibleTilesAsRequired(
     if (!missing_region.Intersects(iter.geometry_rect()))
       continue;
 
+    // An occluded tile is not drawn, so it can't cause flashing.
+    if (tile->is_occluded(PENDING_TREE))
+      continue;
+
     // If the twin tile doesn't exist (i.e. missing recording or so far away
     // that it is outside the visible tile rect) or this tile is shared between
     // with the twin, then this tile isn't required to prevent flashing.
@@ -810,6 +882,57 @@ bool PictureLayerImpl::MarkVisibleTilesAsRequired(
   return twin_had_missing_tile;
 }
 
+void PictureLayerImpl::DeferHighResTilesUntilLowResIsReady(
+    const gfx::Rect& rect) {
+  DCHECK(layer_tree_impl()->IsActiveTree());
+
+  PictureLayerTiling* high_res = NULL;
+  PictureLayerTiling* low_res = NULL;
+  for (size_t i = 0; i < tilings_->num_tilings(); ++i) {
+    PictureLayerTiling* tiling = tilings_->tiling_at(i);
+    if (tiling->resolution() == HIGH_RESOLUTION)
+      high_res = tiling;
+    else if (tiling->resolution() == LOW_RESOLUTION)
+      low_res = tiling;
+  }
+  if (!high_res || !low_res)
+    return;
+
+  // Once the low res tiling covers the visible rect, let high res tiles
+  // refine it as usual.
+  bool low_res_is_ready = true;
+  for (PictureLayerTiling::CoverageIterator iter(low_res,
+                                                 contents_scale_x(),
+                                                 rect);
+       iter;
+       ++iter) {
+    if (*iter && !iter->IsReadyToDraw()) {
+      low_res_is_ready = false;
+      break;
+    }
+  }
+  if (low_res_is_ready)
+    return;
+
+  // Until then, visible high res tiles that still need raster give way to
+  // the low res ones, which are much cheaper and cover the same content.
+  for (PictureLayerTiling::CoverageIterator iter(high_res,
+                                                 contents_scale_x(),
+                                                 rect);
+       iter;
+       ++iter) {
+    Tile* tile = *iter;
+    if (!tile || tile->IsReadyToDraw())
+      continue;
+
+    TilePriority priority = tile->priority(ACTIVE_TREE);
+    if (priority.priority_bin != TilePriority::NOW)
+      continue;
+    priority.priority_bin = TilePriority::SOON;
+    tile->SetPriority(ACTIVE_TREE, priority);
+  }
+}
+
 void PictureLayerImpl::DoPostCommitInitialization() {
   DCHECK(needs_post_commit_initialization_);
   DCHECK(layer_tree_impl()->IsPendingTree());
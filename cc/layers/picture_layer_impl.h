@@ -39,7 +39,9 @@ class CC_EXPORT PictureLayerImpl
   virtual void PushPropertiesTo(LayerImpl* layer) OVERRIDE;
   virtual void AppendQuads(QuadSink* quad_sink,
                            AppendQuadsData* append_quads_data) OVERRIDE;
-  virtual void UpdateTilePriorities() OVERRIDE;
+  virtual void UpdateTilePriorities(
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+          occlusion_tracker) OVERRIDE;
   virtual void DidBecomeActive() OVERRIDE;
   virtual void DidBeginTracing() OVERRIDE;
   virtual void ReleaseResources() OVERRIDE;
@@ -98,6 +100,12 @@ class CC_EXPORT PictureLayerImpl
       bool animating_transform_to_screen);
   void CleanUpTilingsOnActiveLayer(
       std::vector<PictureLayerTiling*> used_tilings);
+  // Appends a quad of |color| covering |rect|, if it is not empty.
+  void AppendSolidColorQuad(QuadSink* quad_sink,
+                            SharedQuadState* shared_quad_state,
+                            AppendQuadsData* append_quads_data,
+                            const gfx::Rect& rect,
+                            SkColor color);
   float MinimumContentsScale() const;
   float SnappedContentsScale(float new_contents_scale);
   void UpdateLCDTextStatus(bool new_status);
@@ -109,6 +117,10 @@ class CC_EXPORT PictureLayerImpl
       float contents_scale,
       const gfx::Rect& rect,
       const Region& missing_region) const;
+  // While smoothness takes priority, lowers the priority of visible high res
+  // tiles in |rect| until the low res tiling is ready to draw there, so that
+  // the viewport is covered with low res content first.
+  void DeferHighResTilesUntilLowResIsReady(const gfx::Rect& rect);
 
   void DoPostCommitInitializationIfNeeded() {
     if (needs_post_commit_initialization_)
@@ -311,7 +311,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         &dummy_content_bounds);
 
   EXPECT_TRUE(host_impl_.manage_tiles_needed());
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   host_impl_.ManageTiles();
   EXPECT_FALSE(host_impl_.manage_tiles_needed());
 
@@ -324,7 +324,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         gfx::Rect(layer_bounds),
                                         gfx::Rect(layer_bounds),
                                         valid_for_tile_management);
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   EXPECT_FALSE(host_impl_.manage_tiles_needed());
 
   time_ticks += base::TimeDelta::FromMilliseconds(200);
@@ -335,7 +335,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         gfx::Rect(layer_bounds),
                                         gfx::Rect(layer_bounds),
                                         valid_for_tile_management);
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   EXPECT_TRUE(host_impl_.manage_tiles_needed());
 }
 
@@ -1173,6 +1173,41 @@ TEST_F(PictureLayerImplTest, DisallowTileDrawQuads) {
   EXPECT_EQ(DrawQuad::PICTURE_CONTENT, quad_culler.quad_list()[0]->material);
 }
 
+TEST_F(PictureLayerImplTest, SolidColorTilesInARowShareAQuad) {
+  MockQuadCuller quad_culler;
+
+  gfx::Size tile_size(400, 400);
+  gfx::Size layer_bounds(1300, 1900);
+
+  scoped_refptr<FakePicturePileImpl> pending_pile =
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds);
+  scoped_refptr<FakePicturePileImpl> active_pile =
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds);
+
+  SetupTrees(pending_pile, active_pile);
+
+  active_layer_->SetContentBounds(layer_bounds);
+  active_layer_->draw_properties().visible_content_rect =
+      gfx::Rect(layer_bounds);
+
+  AddDefaultTilingsWithInvalidation(Region());
+  active_layer_->SetAllTilesReady();
+
+  AppendQuadsData data;
+  active_layer_->WillDraw(DRAW_MODE_HARDWARE, NULL);
+  active_layer_->AppendQuads(&quad_culler, &data);
+  active_layer_->DidDraw(NULL);
+
+  // All the tiles have the same color, so each row is a single quad.
+  ASSERT_LT(0U, quad_culler.quad_list().size());
+  for (size_t i = 0; i < quad_culler.quad_list().size(); ++i) {
+    const DrawQuad* quad = quad_culler.quad_list()[i];
+    EXPECT_EQ(DrawQuad::SOLID_COLOR, quad->material);
+    EXPECT_EQ(0, quad->rect.x());
+    EXPECT_EQ(layer_bounds.width(), quad->rect.width());
+  }
+}
+
 TEST_F(PictureLayerImplTest, MarkRequiredNullTiles) {
   gfx::Size tile_size(100, 100);
   gfx::Size layer_bounds(1000, 1000);
@@ -1561,5 +1596,127 @@ TEST_F(DeferredInitPictureLayerImplTest,
   host_impl_.active_tree()->UpdateDrawProperties();
 }
 
+class OcclusionTrackingSettings : public ImplSidePaintingSettings {
+ public:
+  OcclusionTrackingSettings() { use_occlusion_for_tile_prioritization = true; }
+};
+
+class OcclusionTrackingPictureLayerImplTest : public PictureLayerImplTest {
+ public:
+  OcclusionTrackingPictureLayerImplTest()
+      : PictureLayerImplTest(OcclusionTrackingSettings()) {}
+};
+
+TEST_F(OcclusionTrackingPictureLayerImplTest,
+       OccludedTilesSkippedDuringRasterization) {
+  gfx::Size tile_size(100, 100);
+  gfx::Size layer_bounds(1000, 1000);
+  gfx::Size occluder_bounds(1000, 500);
+  host_impl_.SetViewportSize(layer_bounds);
+
+  scoped_refptr<FakePicturePileImpl> pending_pile =
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds);
+  SetupPendingTree(pending_pile);
+
+  // Cover the top half of the layer with an opaque layer.
+  scoped_ptr<LayerImpl> occluder =
+      LayerImpl::Create(host_impl_.pending_tree(), 8);
+  occluder->SetBounds(occluder_bounds);
+  occluder->SetContentBounds(occluder_bounds);
+  occluder->SetContentsOpaque(true);
+  occluder->SetDrawsContent(true);
+  pending_layer_->AddChild(occluder.Pass());
+
+  host_impl_.pending_tree()->UpdateDrawProperties();
+
+  PictureLayerTiling* tiling = pending_layer_->HighResTiling();
+  ASSERT_TRUE(tiling);
+  gfx::Rect content_rect(
+      gfx::ScaleToEnclosingRect(gfx::Rect(layer_bounds),
+                                tiling->contents_scale()));
+  gfx::Rect occluded_rect(
+      gfx::ScaleToEnclosingRect(gfx::Rect(occluder_bounds),
+                                tiling->contents_scale()));
+  int occluded_tile_count = 0;
+  for (PictureLayerTiling::CoverageIterator
+           iter(tiling, tiling->contents_scale(), content_rect);
+       iter;
+       ++iter) {
+    const Tile* tile = *iter;
+    ASSERT_TRUE(tile);
+    if (occluded_rect.Contains(tile->content_rect())) {
+      EXPECT_TRUE(tile->is_occluded(PENDING_TREE));
+      EXPECT_EQ(TilePriority::EVENTUALLY,
+                tile->priority(PENDING_TREE).priority_bin);
+      EXPECT_FALSE(tile->required_for_activation());
+      ++occluded_tile_count;
+    } else if (!occluded_rect.Intersects(tile->content_rect())) {
+      EXPECT_FALSE(tile->is_occluded(PENDING_TREE));
+      EXPECT_EQ(TilePriority::NOW, tile->priority(PENDING_TREE).priority_bin);
+    }
+  }
+  EXPECT_GT(occluded_tile_count, 0);
+}
+
+class ProgressiveRasterSettings : public ImplSidePaintingSettings {
+ public:
+  ProgressiveRasterSettings() { use_progressive_raster = true; }
+};
+
+class ProgressiveRasterPictureLayerImplTest : public PictureLayerImplTest {
+ public:
+  ProgressiveRasterPictureLayerImplTest()
+      : PictureLayerImplTest(ProgressiveRasterSettings()) {}
+};
+
+TEST_F(ProgressiveRasterPictureLayerImplTest,
+       LowResTilesGoFirstDuringSmoothness) {
+  base::TimeTicks time_ticks;
+  host_impl_.SetCurrentFrameTimeTicks(time_ticks);
+
+  gfx::Size layer_bounds(400, 400);
+  host_impl_.SetViewportSize(layer_bounds);
+  SetupDefaultTrees(layer_bounds);
+  ActivateTree();
+  host_impl_.SetTreePriority(SMOOTHNESS_TAKES_PRIORITY);
+  active_layer_->CreateDefaultTilingsAndTiles();
+
+  time_ticks += base::TimeDelta::FromMilliseconds(200);
+  host_impl_.SetCurrentFrameTimeTicks(time_ticks);
+  host_impl_.active_tree()->UpdateDrawProperties();
+
+  PictureLayerTiling* high_res = active_layer_->HighResTiling();
+  PictureLayerTiling* low_res = active_layer_->LowResTiling();
+  ASSERT_TRUE(high_res);
+  ASSERT_TRUE(low_res);
+
+  // Nothing is ready yet, so the low res tiles have to be rasterized first.
+  for (PictureLayerTiling::CoverageIterator iter(
+           low_res, 1.f, gfx::Rect(layer_bounds));
+       iter;
+       ++iter) {
+    EXPECT_EQ(TilePriority::NOW, iter->priority(ACTIVE_TREE).priority_bin);
+  }
+  for (PictureLayerTiling::CoverageIterator iter(
+           high_res, 1.f, gfx::Rect(layer_bounds));
+       iter;
+       ++iter) {
+    EXPECT_EQ(TilePriority::SOON, iter->priority(ACTIVE_TREE).priority_bin);
+  }
+
+  // Once low res covers the viewport, high res tiles refine it.
+  active_layer_->SetAllTilesReadyInTiling(low_res);
+  time_ticks += base::TimeDelta::FromMilliseconds(200);
+  host_impl_.SetCurrentFrameTimeTicks(time_ticks);
+  host_impl_.active_tree()->UpdateDrawProperties();
+
+  for (PictureLayerTiling::CoverageIterator iter(
+           high_res, 1.f, gfx::Rect(layer_bounds));
+       iter;
+       ++iter) {
+    EXPECT_EQ(TilePriority::NOW, iter->priority(ACTIVE_TREE).priority_bin);
+  }
+}
+
 }  // namespace
 }  // namespace cc
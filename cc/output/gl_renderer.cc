@@ -357,6 +357,9 @@ void GLRenderer::DoDrawQuad(DrawingFrame* frame, const DrawQuad* quad) {
   if (quad->material != DrawQuad::TEXTURE_CONTENT) {
     FlushTextureQuadCache();
   }
+  if (quad->material != DrawQuad::SOLID_COLOR) {
+    FlushSolidColorQuadCache();
+  }
 
   switch (quad->material) {
     case DrawQuad::INVALID:
@@ -1351,11 +1354,16 @@ void GLRenderer::DrawSolidColorQuad(const DrawingFrame* frame,
       settings_->allow_antialiasing && !quad->force_anti_aliasing_off &&
       SetupQuadForAntialiasing(device_transform, quad, &local_quad, edge);
 
+  // Quads without antialiasing are batched together, the others need the
+  // edge uniforms of their own draw call.
+  if (!use_aa) {
+    EnqueueSolidColorQuad(frame, quad, alpha);
+    return;
+  }
+  FlushSolidColorQuadCache();
+
   SolidColorProgramUniforms uniforms;
-  if (use_aa)
-    SolidColorUniformLocation(GetSolidColorProgramAA(), &uniforms);
-  else
-    SolidColorUniformLocation(GetSolidColorProgram(), &uniforms);
+  SolidColorUniformLocation(GetSolidColorProgramAA(), &uniforms);
   SetUseProgram(uniforms.program);
 
   GLC(gl_,
@@ -1364,18 +1372,15 @@ void GLRenderer::DrawSolidColorQuad(const DrawingFrame* frame,
                      (SkColorGetG(color) * (1.0f / 255.0f)) * alpha,
                      (SkColorGetB(color) * (1.0f / 255.0f)) * alpha,
                      alpha));
-  if (use_aa) {
-    float viewport[4] = {static_cast<float>(viewport_.x()),
-                         static_cast<float>(viewport_.y()),
-                         static_cast<float>(viewport_.width()),
-                         static_cast<float>(viewport_.height()), };
-    GLC(gl_, gl_->Uniform4fv(uniforms.viewport_location, 1, viewport));
-    GLC(gl_, gl_->Uniform3fv(uniforms.edge_location, 8, edge));
-  }
+  float viewport[4] = {static_cast<float>(viewport_.x()),
+                       static_cast<float>(viewport_.y()),
+                       static_cast<float>(viewport_.width()),
+                       static_cast<float>(viewport_.height()), };
+  GLC(gl_, gl_->Uniform4fv(uniforms.viewport_location, 1, viewport));
+  GLC(gl_, gl_->Uniform3fv(uniforms.edge_location, 8, edge));
 
-  // Enable blending when the quad properties require it or if we decided
-  // to use antialiasing.
-  SetBlendEnabled(quad->ShouldDrawWithBlending() || use_aa);
+  // Antialiasing always needs blending.
+  SetBlendEnabled(true);
 
   // Normalize to tile_rect.
   local_quad.Scale(1.0f / tile_rect.width(), 1.0f / tile_rect.height());
@@ -1393,6 +1398,77 @@ void GLRenderer::DrawSolidColorQuad(const DrawingFrame* frame,
       frame, quad->quadTransform(), centered_rect, uniforms.matrix_location);
 }
 
+void GLRenderer::FlushSolidColorQuadCache() {
+  // Check to see if we have anything to draw.
+  if (solid_color_draw_cache_.program_id == 0)
+    return;
+
+  SetBlendEnabled(solid_color_draw_cache_.needs_blending);
+  SetUseProgram(solid_color_draw_cache_.program_id);
+
+  // Upload the transforms and colors of all the quads.
+  GLC(gl_,
+      gl_->UniformMatrix4fv(
+          solid_color_draw_cache_.matrix_location,
+          static_cast<int>(solid_color_draw_cache_.matrix_data.size()),
+          false,
+          reinterpret_cast<float*>(
+              &solid_color_draw_cache_.matrix_data.front())));
+  GLC(gl_,
+      gl_->Uniform4fv(
+          solid_color_draw_cache_.color_location,
+          static_cast<int>(solid_color_draw_cache_.color_data.size()),
+          reinterpret_cast<float*>(
+              &solid_color_draw_cache_.color_data.front())));
+
+  GLC(gl_,
+      gl_->DrawElements(GL_TRIANGLES,
+                        6 * solid_color_draw_cache_.matrix_data.size(),
+                        GL_UNSIGNED_SHORT,
+                        0));
+
+  // Clear the cache.
+  solid_color_draw_cache_.program_id = 0;
+  solid_color_draw_cache_.matrix_data.resize(0);
+  solid_color_draw_cache_.color_data.resize(0);
+}
+
+void GLRenderer::EnqueueSolidColorQuad(const DrawingFrame* frame,
+                                       const SolidColorDrawQuad* quad,
+                                       float alpha) {
+  const SolidColorBatchProgram* program = GetSolidColorBatchProgram();
+  bool needs_blending = quad->ShouldDrawWithBlending();
+
+  if (solid_color_draw_cache_.program_id != program->program() ||
+      solid_color_draw_cache_.needs_blending != needs_blending ||
+      solid_color_draw_cache_.matrix_data.size() >= 8) {
+    FlushSolidColorQuadCache();
+    solid_color_draw_cache_.program_id = program->program();
+    solid_color_draw_cache_.needs_blending = needs_blending;
+    solid_color_draw_cache_.matrix_location =
+        program->vertex_shader().matrix_location();
+    solid_color_draw_cache_.color_location =
+        program->vertex_shader().color_location();
+  }
+
+  SkColor color = quad->color;
+  Float4 premultiplied_color = {
+      {(SkColorGetR(color) * (1.0f / 255.0f)) * alpha,
+       (SkColorGetG(color) * (1.0f / 255.0f)) * alpha,
+       (SkColorGetB(color) * (1.0f / 255.0f)) * alpha,
+       alpha}};
+  solid_color_draw_cache_.color_data.push_back(premultiplied_color);
+
+  gfx::Transform quad_rect_matrix;
+  QuadRectTransform(
+      &quad_rect_matrix, quad->quadTransform(), quad->visible_rect);
+  quad_rect_matrix = frame->projection_matrix * quad_rect_matrix;
+
+  Float16 m;
+  quad_rect_matrix.matrix().asColMajorf(m.data);
+  solid_color_draw_cache_.matrix_data.push_back(m);
+}
+
 struct TileProgramUniforms {
   unsigned program;
   unsigned matrix_location;
@@ -1998,7 +2074,12 @@ void GLRenderer::FinishDrawingFrame(DrawingFrame* frame) {
   blend_shadow_ = false;
 }
 
-void GLRenderer::FinishDrawingQuadList() { FlushTextureQuadCache(); }
+void GLRenderer::FlushQuadCaches() {
+  FlushTextureQuadCache();
+  FlushSolidColorQuadCache();
+}
+
+void GLRenderer::FinishDrawingQuadList() { FlushQuadCaches(); }
 
 bool GLRenderer::FlippedFramebuffer() const { return true; }
 
@@ -2006,7 +2087,7 @@ void GLRenderer::EnsureScissorTestEnabled() {
   if (is_scissor_enabled_)
     return;
 
-  FlushTextureQuadCache();
+  FlushQuadCaches();
   GLC(gl_, gl_->Enable(GL_SCISSOR_TEST));
   is_scissor_enabled_ = true;
 }
@@ -2015,7 +2096,7 @@ void GLRenderer::EnsureScissorTestDisabled() {
   if (!is_scissor_enabled_)
     return;
 
-  FlushTextureQuadCache();
+  FlushQuadCaches();
   GLC(gl_, gl_->Disable(GL_SCISSOR_TEST));
   is_scissor_enabled_ = false;
 }
@@ -2580,7 +2661,7 @@ void GLRenderer::SetScissorTestRect(const gfx::Rect& scissor_rect) {
     return;
 
   scissor_rect_ = scissor_rect;
-  FlushTextureQuadCache();
+  FlushQuadCaches();
   GLC(gl_,
       gl_->Scissor(scissor_rect.x(),
                    scissor_rect.y(),
@@ -2630,16 +2711,6 @@ const GLRenderer::DebugBorderProgram* GLRenderer::GetDebugBorderProgram() {
   return &debug_border_program_;
 }
 
-const GLRenderer::SolidColorProgram* GLRenderer::GetSolidColorProgram() {
-  if (!solid_color_program_.initialized()) {
-    TRACE_EVENT0("cc", "GLRenderer::solidColorProgram::initialize");
-    solid_color_program_.Initialize(output_surface_->context_provider(),
-                                    TexCoordPrecisionNA,
-                                    SamplerTypeNA);
-  }
-  return &solid_color_program_;
-}
-
 const GLRenderer::SolidColorProgramAA* GLRenderer::GetSolidColorProgramAA() {
   if (!solid_color_program_aa_.initialized()) {
     TRACE_EVENT0("cc", "GLRenderer::solidColorProgramAA::initialize");
@@ -2650,6 +2721,17 @@ const GLRenderer::SolidColorProgramAA* GLRenderer::GetSolidColorProgramAA() {
   return &solid_color_program_aa_;
 }
 
+const GLRenderer::SolidColorBatchProgram*
+GLRenderer::GetSolidColorBatchProgram() {
+  if (!solid_color_batch_program_.initialized()) {
+    TRACE_EVENT0("cc", "GLRenderer::solidColorBatchProgram::initialize");
+    solid_color_batch_program_.Initialize(output_surface_->context_provider(),
+                                          TexCoordPrecisionNA,
+                                          SamplerTypeNA);
+  }
+  return &solid_color_batch_program_;
+}
+
 const GLRenderer::RenderPassProgram* GLRenderer::GetRenderPassProgram(
     TexCoordPrecision precision) {
   DCHECK_GE(precision, 0);
@@ -3006,8 +3088,8 @@ void GLRenderer::CleanupSharedObjects() {
   tile_checkerboard_program_.Cleanup(gl_);
 
   debug_border_program_.Cleanup(gl_);
-  solid_color_program_.Cleanup(gl_);
   solid_color_program_aa_.Cleanup(gl_);
+  solid_color_batch_program_.Cleanup(gl_);
 
   if (offscreen_framebuffer_id_)
     GLC(gl_, gl_->DeleteFramebuffers(1, &offscreen_framebuffer_id_));
@@ -162,6 +162,12 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   void EnqueueTextureQuad(const DrawingFrame* frame,
                           const TextureDrawQuad* quad);
   void FlushTextureQuadCache();
+  void EnqueueSolidColorQuad(const DrawingFrame* frame,
+                             const SolidColorDrawQuad* quad,
+                             float alpha);
+  void FlushSolidColorQuadCache();
+  // Draws everything held in the quad caches.
+  void FlushQuadCaches();
   void DrawIOSurfaceQuad(const DrawingFrame* frame,
                          const IOSurfaceDrawQuad* quad);
   void DrawTileQuad(const DrawingFrame* frame, const TileDrawQuad* quad);
@@ -294,10 +300,10 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   // Special purpose / effects shaders.
   typedef ProgramBinding<VertexShaderPos, FragmentShaderColor>
       DebugBorderProgram;
-  typedef ProgramBinding<VertexShaderQuad, FragmentShaderColor>
-      SolidColorProgram;
   typedef ProgramBinding<VertexShaderQuadAA, FragmentShaderColorAA>
       SolidColorProgramAA;
+  typedef ProgramBinding<VertexShaderPosColor, FragmentShaderVaryingColor>
+      SolidColorBatchProgram;
 
   const TileProgram* GetTileProgram(
       TexCoordPrecision precision, SamplerType sampler);
@@ -350,8 +356,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       TexCoordPrecision precision);
 
   const DebugBorderProgram* GetDebugBorderProgram();
-  const SolidColorProgram* GetSolidColorProgram();
   const SolidColorProgramAA* GetSolidColorProgramAA();
+  const SolidColorBatchProgram* GetSolidColorBatchProgram();
 
   TileProgram tile_program_[NumTexCoordPrecisions][NumSamplerTypes];
   TileProgramOpaque
@@ -393,8 +399,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       video_stream_texture_program_[NumTexCoordPrecisions];
 
   DebugBorderProgram debug_border_program_;
-  SolidColorProgram solid_color_program_;
   SolidColorProgramAA solid_color_program_aa_;
+  SolidColorBatchProgram solid_color_batch_program_;
 
   gpu::gles2::GLES2Interface* gl_;
   gpu::ContextSupport* context_support_;
@@ -416,6 +422,7 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   bool blend_shadow_;
   unsigned program_shadow_;
   TexturedQuadDrawCache draw_cache_;
+  SolidColorQuadDrawCache solid_color_draw_cache_;
   int highp_threshold_min_;
   int highp_threshold_cache_;
 
@@ -0,0 +1,109 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/gl_renderer.h"
+
+#include <string>
+
+#include "cc/output/renderer.h"
+#include "cc/resources/resource_provider.h"
+#include "cc/test/fake_output_surface.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "cc/test/lap_timer.h"
+#include "cc/test/render_pass_test_common.h"
+#include "cc/test/render_pass_test_utils.h"
+#include "cc/test/test_web_graphics_context_3d.h"
+#include "cc/trees/layer_tree_settings.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+class PerfRendererClient : public RendererClient {
+ public:
+  virtual void SetFullRootLayerDamage() OVERRIDE {}
+};
+
+class GLRendererPerfTest : public testing::Test {
+ public:
+  GLRendererPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+ protected:
+  virtual void SetUp() OVERRIDE {
+    output_surface_ = FakeOutputSurface::Create3d();
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+    resource_provider_ =
+        ResourceProvider::Create(output_surface_.get(), NULL, 0, false, 1);
+    renderer_ = GLRenderer::Create(&renderer_client_,
+                                   &settings_,
+                                   output_surface_.get(),
+                                   resource_provider_.get(),
+                                   NULL,
+                                   0);
+  }
+
+  // Draws frames made of a grid of |tile_size| solid color quads covering
+  // |viewport_rect|, the way tiles of solid color layers are drawn.
+  void RunSolidColorQuadsTest(const std::string& test_name,
+                              const gfx::Rect& viewport_rect,
+                              int tile_size) {
+    timer_.Reset();
+    do {
+      RenderPassList render_passes;
+      TestRenderPass* root_pass = AddRenderPass(&render_passes,
+                                                RenderPass::Id(1, 1),
+                                                viewport_rect,
+                                                gfx::Transform());
+      for (int y = 0; y < viewport_rect.height(); y += tile_size) {
+        for (int x = 0; x < viewport_rect.width(); x += tile_size) {
+          AddQuad(root_pass,
+                  gfx::Rect(x, y, tile_size, tile_size),
+                  (x / tile_size + y / tile_size) % 2 ? SK_ColorRED
+                                                      : SK_ColorBLUE);
+        }
+      }
+
+      renderer_->DecideRenderPassAllocationsForFrame(render_passes);
+      renderer_->DrawFrame(&render_passes,
+                           NULL,
+                           1.f,
+                           viewport_rect,
+                           viewport_rect,
+                           true,
+                           false);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("draw_solid_color_quads",
+                           "",
+                           test_name,
+                           timer_.LapsPerSecond(),
+                           "runs/s",
+                           true);
+  }
+
+  LayerTreeSettings settings_;
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  PerfRendererClient renderer_client_;
+  scoped_ptr<GLRenderer> renderer_;
+  LapTimer timer_;
+};
+
+TEST_F(GLRendererPerfTest, SolidColorQuads) {
+  RunSolidColorQuadsTest("256_tiles", gfx::Rect(1024, 1024), 64);
+  RunSolidColorQuadsTest("1024_tiles", gfx::Rect(1024, 1024), 32);
+}
+
+}  // namespace
+}  // namespace cc
@@ -81,6 +81,21 @@ bool IsScaleAndIntegerTranslate(const SkMatrix& matrix) {
          SkScalarNearlyZero(matrix[SkMatrix::kMPersp2] - 1.0f);
 }
 
+// Returns true if |matrix| only translates by whole pixels, so that bitmaps
+// drawn through it land texel for texel on the device.
+bool IsIntegerTranslate(const SkMatrix& matrix) {
+  return IsScaleAndIntegerTranslate(matrix) &&
+         SkScalarNearlyZero(matrix[SkMatrix::kMScaleX] - 1.0f) &&
+         SkScalarNearlyZero(matrix[SkMatrix::kMScaleY] - 1.0f);
+}
+
+bool IsRectNearlyIntegral(const SkRect& rect) {
+  return IsScalarNearlyInteger(rect.fLeft) &&
+         IsScalarNearlyInteger(rect.fTop) &&
+         IsScalarNearlyInteger(rect.fRight) &&
+         IsScalarNearlyInteger(rect.fBottom);
+}
+
 static SkShader::TileMode WrapModeToTileMode(GLint wrap_mode) {
   switch (wrap_mode) {
     case GL_REPEAT:
@@ -262,6 +277,39 @@ bool SoftwareRenderer::IsSoftwareResource(
   return false;
 }
 
+bool SoftwareRenderer::DrawBitmapAsSprite(const SkBitmap& bitmap,
+                                          const SkRect& src_rect,
+                                          const SkRect& dst_rect) {
+  const SkMatrix& matrix = current_canvas_->getTotalMatrix();
+  if (!IsIntegerTranslate(matrix))
+    return false;
+
+  SkRect device_rect;
+  matrix.mapRect(&device_rect, dst_rect);
+  if (!IsRectNearlyIntegral(src_rect) || !IsRectNearlyIntegral(device_rect))
+    return false;
+
+  SkIRect src_irect;
+  src_rect.round(&src_irect);
+  SkIRect device_irect;
+  device_rect.round(&device_irect);
+  if (src_irect.width() != device_irect.width() ||
+      src_irect.height() != device_irect.height())
+    return false;
+  if (!SkIRect::MakeWH(bitmap.width(), bitmap.height()).contains(src_irect))
+    return false;
+
+  SkBitmap subset;
+  if (!bitmap.extractSubset(&subset, src_irect))
+    return false;
+
+  // Sprites skip the matrix and sampling setup entirely and go straight to
+  // Skia's row blitters, which copy or blend whole rows at a time.
+  current_canvas_->drawSprite(
+      subset, device_irect.x(), device_irect.y(), &current_paint_);
+  return true;
+}
+
 void SoftwareRenderer::DoDrawQuad(DrawingFrame* frame, const DrawQuad* quad) {
   TRACE_EVENT0("cc", "SoftwareRenderer::DoDrawQuad");
   gfx::Transform quad_rect_matrix;
@@ -454,7 +502,7 @@ void SoftwareRenderer::DrawTextureQuad(const DrawingFrame* frame,
     paint.setStyle(SkPaint::kFill_Style);
     paint.setShader(shader.get());
     current_canvas_->drawRect(quad_rect, paint);
-  } else {
+  } else if (!DrawBitmapAsSprite(*bitmap, sk_uv_rect, quad_rect)) {
     current_canvas_->drawBitmapRectToRect(*bitmap,
                                           &sk_uv_rect,
                                           quad_rect,
@@ -482,12 +530,13 @@ void SoftwareRenderer::DrawTileQuad(const DrawingFrame* frame,
       QuadVertexRect(), quad->rect, quad->visible_rect);
 
   SkRect uv_rect = gfx::RectFToSkRect(visible_tex_coord_rect);
+  SkRect quad_rect = gfx::RectFToSkRect(visible_quad_vertex_rect);
+  if (DrawBitmapAsSprite(*lock.sk_bitmap(), uv_rect, quad_rect))
+    return;
+
   current_paint_.setFilterBitmap(true);
   current_canvas_->drawBitmapRectToRect(
-      *lock.sk_bitmap(),
-      &uv_rect,
-      gfx::RectFToSkRect(visible_quad_vertex_rect),
-      &current_paint_);
+      *lock.sk_bitmap(), &uv_rect, quad_rect, &current_paint_);
 }
 
 void SoftwareRenderer::DrawRenderPassQuad(const DrawingFrame* frame,
@@ -80,6 +80,12 @@ class CC_EXPORT SoftwareRenderer : public DirectRenderer {
   void ClearCanvas(SkColor color);
   void SetClipRect(const gfx::Rect& rect);
   bool IsSoftwareResource(ResourceProvider::ResourceId resource_id) const;
+  // Draws the |src_rect| part of |bitmap| into |dst_rect| as a sprite if the
+  // current matrix maps it one texel to one pixel. Returns false, drawing
+  // nothing, if the general Skia path is needed instead.
+  bool DrawBitmapAsSprite(const SkBitmap& bitmap,
+                          const SkRect& src_rect,
+                          const SkRect& dst_rect);
 
   void DrawCheckerboardQuad(const DrawingFrame* frame,
                             const CheckerboardDrawQuad* quad);
@@ -0,0 +1,156 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/software_renderer.h"
+
+#include <string>
+
+#include "cc/output/renderer.h"
+#include "cc/output/software_output_device.h"
+#include "cc/quads/tile_draw_quad.h"
+#include "cc/resources/resource_provider.h"
+#include "cc/test/fake_output_surface.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "cc/test/lap_timer.h"
+#include "cc/test/render_pass_test_common.h"
+#include "cc/test/render_pass_test_utils.h"
+#include "cc/trees/layer_tree_settings.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+class PerfRendererClient : public RendererClient {
+ public:
+  virtual void SetFullRootLayerDamage() OVERRIDE {}
+};
+
+class SoftwareRendererPerfTest : public testing::Test {
+ public:
+  SoftwareRendererPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+ protected:
+  virtual void SetUp() OVERRIDE {
+    output_surface_ = FakeOutputSurface::CreateSoftware(
+        make_scoped_ptr(new SoftwareOutputDevice));
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+    resource_provider_ =
+        ResourceProvider::Create(output_surface_.get(), NULL, 0, false, 1);
+    renderer_ = SoftwareRenderer::Create(&renderer_client_,
+                                         &settings_,
+                                         output_surface_.get(),
+                                         resource_provider_.get());
+  }
+
+  ResourceProvider::ResourceId CreateTileResource(const gfx::Size& tile_size) {
+    ResourceProvider::ResourceId resource =
+        resource_provider_->CreateResource(tile_size,
+                                           GL_CLAMP_TO_EDGE,
+                                           ResourceProvider::TextureUsageAny,
+                                           RGBA_8888);
+    SkBitmap bitmap;
+    bitmap.setConfig(
+        SkBitmap::kARGB_8888_Config, tile_size.width(), tile_size.height());
+    bitmap.allocPixels();
+    bitmap.eraseColor(SK_ColorCYAN);
+    resource_provider_->SetPixels(resource,
+                                  static_cast<uint8_t*>(bitmap.getPixels()),
+                                  gfx::Rect(tile_size),
+                                  gfx::Rect(tile_size),
+                                  gfx::Vector2d());
+    return resource;
+  }
+
+  // Draws frames made of a grid of |tile_size| tile quads covering
+  // |viewport_rect|, scaled by |scale|. A scale of 1 is the axis-aligned
+  // scrolling case that the renderer blits directly.
+  void RunTileQuadsTest(const std::string& test_name,
+                        const gfx::Rect& viewport_rect,
+                        int tile_size,
+                        float scale,
+                        bool opaque) {
+    gfx::Size tile_bounds(tile_size, tile_size);
+    ResourceProvider::ResourceId resource = CreateTileResource(tile_bounds);
+
+    gfx::Transform scale_transform;
+    scale_transform.Scale(scale, scale);
+    scoped_ptr<SharedQuadState> shared_quad_state = SharedQuadState::Create();
+    shared_quad_state->SetAll(scale_transform,
+                              viewport_rect.size(),
+                              viewport_rect,
+                              viewport_rect,
+                              false,
+                              opaque ? 1.f : 0.5f,
+                              SkXfermode::kSrcOver_Mode);
+
+    timer_.Reset();
+    do {
+      RenderPassList render_passes;
+      TestRenderPass* root_pass = AddRenderPass(&render_passes,
+                                                RenderPass::Id(1, 1),
+                                                viewport_rect,
+                                                gfx::Transform());
+      for (int y = 0; y < viewport_rect.height(); y += tile_size) {
+        for (int x = 0; x < viewport_rect.width(); x += tile_size) {
+          gfx::Rect tile_rect(x, y, tile_size, tile_size);
+          scoped_ptr<TileDrawQuad> quad = TileDrawQuad::Create();
+          quad->SetNew(shared_quad_state.get(),
+                       tile_rect,
+                       opaque ? tile_rect : gfx::Rect(),
+                       resource,
+                       gfx::RectF(tile_bounds),
+                       tile_bounds,
+                       false);
+          root_pass->AppendQuad(quad.PassAs<DrawQuad>());
+        }
+      }
+
+      renderer_->DecideRenderPassAllocationsForFrame(render_passes);
+      renderer_->DrawFrame(&render_passes,
+                           NULL,
+                           1.f,
+                           viewport_rect,
+                           viewport_rect,
+                           true,
+                           false);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    resource_provider_->DeleteResource(resource);
+
+    perf_test::PrintResult("draw_tile_quads",
+                           "",
+                           test_name,
+                           timer_.LapsPerSecond(),
+                           "runs/s",
+                           true);
+  }
+
+  LayerTreeSettings settings_;
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  PerfRendererClient renderer_client_;
+  scoped_ptr<SoftwareRenderer> renderer_;
+  LapTimer timer_;
+};
+
+TEST_F(SoftwareRendererPerfTest, TileQuads) {
+  RunTileQuadsTest("opaque_unscaled", gfx::Rect(1024, 1024), 256, 1.f, true);
+  RunTileQuadsTest(
+      "translucent_unscaled", gfx::Rect(1024, 1024), 256, 1.f, false);
+  RunTileQuadsTest("opaque_scaled", gfx::Rect(1024, 1024), 256, 1.5f, true);
+}
+
+}  // namespace
+}  // namespace cc
@@ -309,6 +309,86 @@ TEST_F(SoftwareRendererTest, TileQuadVisibleRect) {
       output.getColor(visible_rect.right() - 1, visible_rect.bottom() - 1));
 }
 
+TEST_F(SoftwareRendererTest, TranslatedTileQuad) {
+  gfx::Size tile_size(50, 50);
+  gfx::Rect tile_rect(tile_size);
+  gfx::Size viewport_size(100, 100);
+  InitializeRenderer(make_scoped_ptr(new SoftwareOutputDevice));
+
+  ResourceProvider::ResourceId resource_cyan =
+      resource_provider()->CreateResource(tile_size,
+                                          GL_CLAMP_TO_EDGE,
+                                          ResourceProvider::TextureUsageAny,
+                                          RGBA_8888);
+
+  SkBitmap cyan_tile;  // The top left texel is yellow.
+  cyan_tile.setConfig(
+      SkBitmap::kARGB_8888_Config, tile_size.width(), tile_size.height());
+  cyan_tile.allocPixels();
+  cyan_tile.eraseColor(SK_ColorCYAN);
+  cyan_tile.eraseArea(SkIRect::MakeWH(1, 1), SK_ColorYELLOW);
+
+  resource_provider()->SetPixels(resource_cyan,
+                                 static_cast<uint8_t*>(cyan_tile.getPixels()),
+                                 gfx::Rect(tile_size),
+                                 gfx::Rect(tile_size),
+                                 gfx::Vector2d());
+
+  // Whole pixel translations take the sprite path, which must still honor
+  // the transform.
+  gfx::Transform translation;
+  translation.Translate(10, 20);
+  scoped_ptr<SharedQuadState> shared_quad_state = SharedQuadState::Create();
+  shared_quad_state->SetAll(translation,
+                            tile_size,
+                            tile_rect,
+                            gfx::Rect(viewport_size),
+                            false,
+                            1.0,
+                            SkXfermode::kSrcOver_Mode);
+  gfx::Rect root_rect(viewport_size);
+  RenderPass::Id root_render_pass_id = RenderPass::Id(1, 1);
+  scoped_ptr<TestRenderPass> root_render_pass = TestRenderPass::Create();
+  root_render_pass->SetNew(
+      root_render_pass_id, root_rect, root_rect, gfx::Transform());
+  scoped_ptr<TileDrawQuad> quad = TileDrawQuad::Create();
+  quad->SetNew(shared_quad_state.get(),
+               tile_rect,
+               tile_rect,
+               resource_cyan,
+               gfx::RectF(tile_size),
+               tile_size,
+               false);
+  root_render_pass->AppendQuad(quad.PassAs<DrawQuad>());
+
+  RenderPassList list;
+  list.push_back(root_render_pass.PassAs<RenderPass>());
+
+  float device_scale_factor = 1.f;
+  gfx::Rect device_viewport_rect(viewport_size);
+  renderer()->DrawFrame(&list,
+                        NULL,
+                        device_scale_factor,
+                        device_viewport_rect,
+                        device_viewport_rect,
+                        true,
+                        false);
+
+  SkBitmap output;
+  output.setConfig(SkBitmap::kARGB_8888_Config,
+                   viewport_size.width(),
+                   viewport_size.height());
+  output.allocPixels();
+  renderer()->GetFramebufferPixels(output.getPixels(), root_rect);
+
+  const unsigned int kTransparent = SK_ColorTRANSPARENT;
+  EXPECT_EQ(kTransparent, output.getColor(9, 19));
+  EXPECT_EQ(SK_ColorYELLOW, output.getColor(10, 20));
+  EXPECT_EQ(SK_ColorCYAN, output.getColor(11, 21));
+  EXPECT_EQ(SK_ColorCYAN, output.getColor(59, 69));
+  EXPECT_EQ(kTransparent, output.getColor(60, 70));
+}
+
 TEST_F(SoftwareRendererTest, ShouldClearRootRenderPass) {
   float device_scale_factor = 1.f;
   gfx::Rect viewport_rect(0, 0, 100, 100);
@@ -16,11 +16,13 @@
 #include "cc/debug/traced_picture.h"
 #include "cc/debug/traced_value.h"
 #include "cc/layers/content_layer_client.h"
+#include "skia/ext/analysis_canvas.h"
 #include "skia/ext/pixel_ref_utils.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkDrawFilter.h"
 #include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/utils/SkPictureUtils.h"
 #include "ui/gfx/codec/jpeg_codec.h"
@@ -79,6 +81,47 @@ bool DecodeBitmap(const void* buffer, size_t size, SkBitmap* bm) {
   return false;
 }
 
+// Pictures with this many slow draws or more are rasterized in software.
+const int kMaxSlowDrawsForGpuRasterization = 5;
+
+// Counts the draws that Ganesh rasterizes much more slowly than the software
+// rasterizer does. Antialiased concave paths need a software mask, path
+// effects such as dashing turn one path into many, and text on a path is drawn
+// as one path per glyph.
+class GpuRasterizationAnalysisDevice : public skia::AnalysisDevice {
+ public:
+  explicit GpuRasterizationAnalysisDevice(const SkBitmap& bitmap)
+      : skia::AnalysisDevice(bitmap),
+        num_slow_draws_(0) {}
+
+  int num_slow_draws() const { return num_slow_draws_; }
+
+ protected:
+  virtual void drawPath(const SkDraw& draw,
+                        const SkPath& path,
+                        const SkPaint& paint,
+                        const SkMatrix* pre_path_matrix,
+                        bool path_is_mutable) OVERRIDE {
+    if ((paint.isAntiAlias() && !path.isConvex()) || paint.getPathEffect())
+      ++num_slow_draws_;
+    skia::AnalysisDevice::drawPath(
+        draw, path, paint, pre_path_matrix, path_is_mutable);
+  }
+
+  virtual void drawTextOnPath(const SkDraw& draw,
+                              const void* text,
+                              size_t len,
+                              const SkPath& path,
+                              const SkMatrix* matrix,
+                              const SkPaint& paint) OVERRIDE {
+    ++num_slow_draws_;
+    skia::AnalysisDevice::drawTextOnPath(draw, text, len, path, matrix, paint);
+  }
+
+ private:
+  int num_slow_draws_;
+};
+
 }  // namespace
 
 scoped_refptr<Picture> Picture::Create(
@@ -86,12 +129,18 @@ scoped_refptr<Picture> Picture::Create(
     ContentLayerClient* client,
     const SkTileGridPicture::TileGridInfo& tile_grid_info,
     bool gather_pixel_refs,
+    const gfx::Rect& solid_color_analysis_rect,
+    bool analyze_for_gpu_rasterization,
     int num_raster_threads) {
   scoped_refptr<Picture> picture = make_scoped_refptr(new Picture(layer_rect));
 
   picture->Record(client, tile_grid_info);
   if (gather_pixel_refs)
     picture->GatherPixelRefs(tile_grid_info);
+  if (!solid_color_analysis_rect.IsEmpty())
+    picture->AnalyzeForSolidColor(solid_color_analysis_rect);
+  if (analyze_for_gpu_rasterization)
+    picture->AnalyzeForGpuRasterization();
   picture->CloneForDrawing(num_raster_threads);
 
   return picture;
@@ -99,7 +148,10 @@ scoped_refptr<Picture> Picture::Create(
 
 Picture::Picture(const gfx::Rect& layer_rect)
   : layer_rect_(layer_rect),
-    cell_size_(layer_rect.size()) {
+    cell_size_(layer_rect.size()),
+    is_solid_color_(false),
+    solid_color_(SK_ColorTRANSPARENT),
+    is_suitable_for_gpu_rasterization_(true) {
   // Instead of recording a trace event for object creation here, we wait for
   // the picture to be recorded in Picture::Record.
 }
@@ -169,7 +221,10 @@ Picture::Picture(SkPicture* picture,
     layer_rect_(layer_rect),
     opaque_rect_(opaque_rect),
     picture_(skia::AdoptRef(picture)),
-    cell_size_(layer_rect.size()) {
+    cell_size_(layer_rect.size()),
+    is_solid_color_(false),
+    solid_color_(SK_ColorTRANSPARENT),
+    is_suitable_for_gpu_rasterization_(true) {
 }
 
 Picture::Picture(const skia::RefPtr<SkPicture>& picture,
@@ -180,7 +235,10 @@ Picture::Picture(const skia::RefPtr<SkPicture>& picture,
     opaque_rect_(opaque_rect),
     picture_(picture),
     pixel_refs_(pixel_refs),
-    cell_size_(layer_rect.size()) {
+    cell_size_(layer_rect.size()),
+    is_solid_color_(false),
+    solid_color_(SK_ColorTRANSPARENT),
+    is_suitable_for_gpu_rasterization_(true) {
 }
 
 Picture::~Picture() {
@@ -189,6 +247,11 @@ Picture::~Picture() {
 }
 
 Picture* Picture::GetCloneForDrawingOnThread(unsigned thread_index) {
+  // Solid color pictures never play back their SkPicture, so every thread
+  // can share them.
+  if (is_solid_color_)
+    return this;
+
   // SkPicture is not thread-safe to rasterize with, this returns a clone
   // to rasterize with on a specific thread.
   CHECK_GE(clones_.size(), thread_index);
@@ -204,6 +267,11 @@ void Picture::CloneForDrawing(int num_threads) {
   // We can re-use this picture for one raster worker thread.
   raster_thread_checker_.DetachFromThread();
 
+  // Solid color pictures are rastered without touching the SkPicture, so
+  // they don't need the per-thread copies of its playback state.
+  if (is_solid_color_)
+    return;
+
   if (num_threads > 1) {
     scoped_ptr<SkPicture[]> clones(new SkPicture[num_threads - 1]);
     picture_->clone(&clones[0], num_threads - 1);
@@ -316,12 +384,60 @@ void Picture::GatherPixelRefs(
   max_pixel_cell_ = gfx::Point(max_x, max_y);
 }
 
+void Picture::AnalyzeForSolidColor(const gfx::Rect& analysis_rect) {
+  TRACE_EVENT2("cc", "Picture::AnalyzeForSolidColor",
+               "width", analysis_rect.width(),
+               "height", analysis_rect.height());
+
+  DCHECK(picture_);
+  DCHECK(layer_rect_.Contains(analysis_rect));
+
+  SkBitmap empty_bitmap;
+  empty_bitmap.setConfig(SkBitmap::kNo_Config,
+                         analysis_rect.width(),
+                         analysis_rect.height());
+  skia::AnalysisDevice device(empty_bitmap);
+  skia::AnalysisCanvas canvas(&device);
+  canvas.translate(layer_rect_.x() - analysis_rect.x(),
+                   layer_rect_.y() - analysis_rect.y());
+  // The canvas aborts the playback as soon as it sees text, which leaves the
+  // picture not solid.
+  picture_->draw(&canvas, &canvas);
+
+  is_solid_color_ = canvas.GetColorIfSolid(&solid_color_);
+  if (is_solid_color_) {
+    solid_color_rect_ = analysis_rect;
+    // Every thread shares a solid color picture, so its clones are unused.
+    clones_.clear();
+  }
+}
+
+void Picture::AnalyzeForGpuRasterization() {
+  TRACE_EVENT2("cc", "Picture::AnalyzeForGpuRasterization",
+               "width", layer_rect_.width(),
+               "height", layer_rect_.height());
+
+  DCHECK(picture_);
+  DCHECK(clones_.empty());
+
+  SkBitmap empty_bitmap;
+  empty_bitmap.setConfig(SkBitmap::kNo_Config,
+                         layer_rect_.width(),
+                         layer_rect_.height());
+  GpuRasterizationAnalysisDevice device(empty_bitmap);
+  SkCanvas canvas(&device);
+  picture_->draw(&canvas);
+
+  is_suitable_for_gpu_rasterization_ =
+      device.num_slow_draws() < kMaxSlowDrawsForGpuRasterization;
+}
+
 int Picture::Raster(
     SkCanvas* canvas,
     SkDrawPictureCallback* callback,
     const Region& negated_content_region,
     float contents_scale) {
-  DCHECK(raster_thread_checker_.CalledOnValidThread());
+  DCHECK(is_solid_color_ || raster_thread_checker_.CalledOnValidThread());
   TRACE_EVENT_BEGIN1(
       "cc",
       "Picture::Raster",
@@ -336,8 +452,16 @@ int Picture::Raster(
     canvas->clipRect(gfx::RectToSkRect(it.rect()), SkRegion::kDifference_Op);
 
   canvas->scale(contents_scale, contents_scale);
-  canvas->translate(layer_rect_.x(), layer_rect_.y());
-  picture_->draw(canvas, callback);
+  if (is_solid_color_) {
+    // The analysis already replayed the whole recording once, so draw its
+    // result instead of replaying it again.
+    SkPaint paint;
+    paint.setColor(solid_color_);
+    canvas->drawRect(gfx::RectToSkRect(solid_color_rect_), paint);
+  } else {
+    canvas->translate(layer_rect_.x(), layer_rect_.y());
+    picture_->draw(canvas, callback);
+  }
   SkIRect bounds;
   canvas->getClipDeviceBounds(&bounds);
   canvas->restore();
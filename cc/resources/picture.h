@@ -20,6 +20,7 @@
 #include "cc/base/cc_export.h"
 #include "cc/base/region.h"
 #include "skia/ext/refptr.h"
+#include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkTileGridPicture.h"
 #include "ui/gfx/rect.h"
 
@@ -49,6 +50,8 @@ class CC_EXPORT Picture
       ContentLayerClient* client,
       const SkTileGridPicture::TileGridInfo& tile_grid_info,
       bool gather_pixels_refs,
+      const gfx::Rect& solid_color_analysis_rect,
+      bool analyze_for_gpu_rasterization,
       int num_raster_threads);
   static scoped_refptr<Picture> CreateFromValue(const base::Value* value);
   static scoped_refptr<Picture> CreateFromSkpValue(const base::Value* value);
@@ -64,6 +67,7 @@ class CC_EXPORT Picture
 
   // Apply this scale and raster the negated region into the canvas. See comment
   // in PicturePileImpl::RasterCommon for explanation on negated content region.
+  // Solid color pictures draw their color without replaying the recording.
   int Raster(SkCanvas* canvas,
              SkDrawPictureCallback* callback,
              const Region& negated_content_region,
@@ -113,6 +117,27 @@ class CC_EXPORT Picture
 
   bool WillPlayBackBitmaps() const { return picture_->willPlayBackBitmaps(); }
 
+  // Play back the part of the recording within |analysis_rect|, in layer space,
+  // to decide GetColorIfSolid(). This must happen before the picture is handed
+  // to a raster thread.
+  void AnalyzeForSolidColor(const gfx::Rect& analysis_rect);
+
+  // Returns true if the part of the recording within the rect passed to
+  // AnalyzeForSolidColor() rasters to a single color, which is then written to
+  // |color|. Transparent pictures are solid SK_ColorTRANSPARENT.
+  bool GetColorIfSolid(SkColor* color) const {
+    if (is_solid_color_)
+      *color = solid_color_;
+    return is_solid_color_;
+  }
+
+  // Returns false if the recording has too many operations that Ganesh
+  // rasterizes slowly for it to be worth rasterizing on the GPU. Pictures that
+  // were not created with |analyze_for_gpu_rasterization| are always suitable.
+  bool IsSuitableForGpuRasterization() const {
+    return is_suitable_for_gpu_rasterization_;
+  }
+
  private:
   explicit Picture(const gfx::Rect& layer_rect);
   // This constructor assumes SkPicture is already ref'd and transfers
@@ -138,6 +163,10 @@ class CC_EXPORT Picture
   // Gather pixel refs from recording.
   void GatherPixelRefs(const SkTileGridPicture::TileGridInfo& tile_grid_info);
 
+  // Play back the recording to decide IsSuitableForGpuRasterization(). This
+  // must happen before the picture is handed to a raster thread.
+  void AnalyzeForGpuRasterization();
+
   gfx::Rect layer_rect_;
   gfx::Rect opaque_rect_;
   skia::RefPtr<SkPicture> picture_;
@@ -150,6 +179,11 @@ class CC_EXPORT Picture
   gfx::Point max_pixel_cell_;
   gfx::Size cell_size_;
 
+  bool is_solid_color_;
+  SkColor solid_color_;
+  gfx::Rect solid_color_rect_;
+  bool is_suitable_for_gpu_rasterization_;
+
   scoped_refptr<base::debug::ConvertableToTraceFormat>
     AsTraceableRasterData(float scale) const;
   scoped_refptr<base::debug::ConvertableToTraceFormat>
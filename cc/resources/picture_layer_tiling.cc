@@ -10,6 +10,7 @@
 
 #include "base/debug/trace_event.h"
 #include "cc/base/math_util.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/point_conversions.h"
 #include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/safe_integer_conversions.h"
@@ -391,7 +392,11 @@ void PictureLayerTiling::UpdateTilePriorities(
     WhichTree tree,
     const gfx::Rect& visible_layer_rect,
     float layer_contents_scale,
-    double current_frame_time_in_seconds) {
+    double current_frame_time_in_seconds,
+    const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+        occlusion_tracker,
+    const LayerImpl* render_target,
+    const gfx::Transform& draw_transform) {
   if (!NeedsUpdateForFrameAtTime(current_frame_time_in_seconds)) {
     // This should never be zero for the purposes of has_ever_been_updated().
     DCHECK_NE(current_frame_time_in_seconds, 0.0);
@@ -430,8 +435,11 @@ void PictureLayerTiling::UpdateTilePriorities(
   last_impl_frame_time_in_seconds_ = current_frame_time_in_seconds;
   last_visible_rect_in_content_space_ = visible_rect_in_content_space;
 
-  // Assign now priority to all visible tiles.
+  // Assign now priority to all visible tiles, unless they are hidden behind
+  // other layers.
   TilePriority now_priority(resolution_, TilePriority::NOW, 0);
+  TilePriority occluded_priority(resolution_, TilePriority::EVENTUALLY, 0);
+  float tiling_to_layer_content_scale = layer_contents_scale / contents_scale_;
   for (TilingData::Iterator iter(&tiling_data_, visible_rect_in_content_space);
        iter;
        ++iter) {
@@ -440,7 +448,19 @@ void PictureLayerTiling::UpdateTilePriorities(
       continue;
     Tile* tile = find->second.get();
 
-    tile->SetPriority(tree, now_priority);
+    bool is_occluded = false;
+    if (occlusion_tracker) {
+      gfx::Rect visible_tile_rect = gfx::IntersectRects(
+          tile->content_rect(), visible_rect_in_content_space);
+      is_occluded = occlusion_tracker->Occluded(
+          render_target,
+          gfx::ScaleToEnclosingRect(visible_tile_rect,
+                                    tiling_to_layer_content_scale),
+          draw_transform,
+          false);
+    }
+    tile->set_is_occluded(tree, is_occluded);
+    tile->SetPriority(tree, is_occluded ? occluded_priority : now_priority);
   }
 
   // Assign soon priority to all tiles in the skewport that are not visible.
@@ -532,6 +552,7 @@ void PictureLayerTiling::DidBecomeRecycled() {
   // due to a pending invalidation).
   for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
     it->second->SetPriority(ACTIVE_TREE, TilePriority());
+    it->second->set_is_occluded(ACTIVE_TREE, false);
   }
 }
 
@@ -539,6 +560,9 @@ void PictureLayerTiling::DidBecomeActive() {
   for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
     it->second->SetPriority(ACTIVE_TREE, it->second->priority(PENDING_TREE));
     it->second->SetPriority(PENDING_TREE, TilePriority());
+    it->second->set_is_occluded(ACTIVE_TREE,
+                                it->second->is_occluded(PENDING_TREE));
+    it->second->set_is_occluded(PENDING_TREE, false);
 
     // Tile holds a ref onto a picture pile. If the tile never gets invalidated
     // and recreated, then that picture pile ref could exist indefinitely.  To
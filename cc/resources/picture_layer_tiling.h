@@ -17,10 +17,14 @@
 #include "cc/resources/tile.h"
 #include "cc/resources/tile_priority.h"
 #include "ui/gfx/rect.h"
+#include "ui/gfx/transform.h"
 
 namespace cc {
 
+template <typename LayerType, typename SurfaceType> class OcclusionTrackerBase;
+class LayerImpl;
 class PictureLayerTiling;
+class RenderSurfaceImpl;
 
 class CC_EXPORT PictureLayerTilingClient {
  public:
@@ -136,10 +140,18 @@ class CC_EXPORT PictureLayerTiling {
 
   void Reset();
 
-  void UpdateTilePriorities(WhichTree tree,
-                            const gfx::Rect& visible_layer_rect,
-                            float layer_contents_scale,
-                            double current_frame_time_in_seconds);
+  // If |occlusion_tracker| is not NULL, visible tiles that it finds fully
+  // occluded for the layer drawn into |render_target| with |draw_transform|
+  // are marked as occluded and only get an eventually priority.
+  void UpdateTilePriorities(
+      WhichTree tree,
+      const gfx::Rect& visible_layer_rect,
+      float layer_contents_scale,
+      double current_frame_time_in_seconds,
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+          occlusion_tracker,
+      const LayerImpl* render_target,
+      const gfx::Transform& draw_transform);
 
   // Copies the src_tree priority into the dst_tree priority for all tiles.
   // The src_tree priority is reset to the lowest priority possible.  This
@@ -70,8 +70,13 @@ class PictureLayerTilingPerfTest : public testing::Test {
     gfx::Size layer_bounds(50 * 256, 50 * 256);
     gfx::Rect viewport_rect(0, 0, 1024, 768);
     do {
-      picture_layer_tiling_->UpdateTilePriorities(
-          ACTIVE_TREE, viewport_rect, 1.f, num_runs_ + 1);
+      picture_layer_tiling_->UpdateTilePriorities(ACTIVE_TREE,
+                                                  viewport_rect,
+                                                  1.f,
+                                                  num_runs_ + 1,
+                                                  NULL,
+                                                  NULL,
+                                                  gfx::Transform());
     } while (DidRun());
 
     perf_test::PrintResult("update_tile_priorities_stationary",
@@ -96,8 +101,13 @@ class PictureLayerTilingPerfTest : public testing::Test {
     int offsetCount = 0;
     const int maxOffsetCount = 1000;
     do {
-      picture_layer_tiling_->UpdateTilePriorities(
-          ACTIVE_TREE, viewport_rect, 1.f, num_runs_ + 1);
+      picture_layer_tiling_->UpdateTilePriorities(ACTIVE_TREE,
+                                                  viewport_rect,
+                                                  1.f,
+                                                  num_runs_ + 1,
+                                                  NULL,
+                                                  NULL,
+                                                  gfx::Transform());
 
       viewport_rect = gfx::Rect(viewport_rect.x() + xoffsets[offsetIndex],
                                 viewport_rect.y() + yoffsets[offsetIndex],
@@ -54,10 +54,15 @@ class CC_EXPORT PictureLayerTilingSet {
   // Remove all tiles; keep all tilings.
   void RemoveAllTiles();
 
-  void UpdateTilePriorities(WhichTree tree,
-                            const gfx::Rect& visible_content_rect,
-                            float layer_contents_scale,
-                            double current_frame_time_in_seconds);
+  void UpdateTilePriorities(
+      WhichTree tree,
+      const gfx::Rect& visible_content_rect,
+      float layer_contents_scale,
+      double current_frame_time_in_seconds,
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+          occlusion_tracker,
+      const LayerImpl* render_target,
+      const gfx::Transform& draw_transform);
 
   void DidBecomeActive();
   void DidBecomeRecycled();
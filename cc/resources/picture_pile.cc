@@ -141,7 +141,9 @@ float ClusterTiles(const std::vector<gfx::Rect>& invalid_tiles,
 
 namespace cc {
 
-PicturePile::PicturePile() {
+PicturePile::PicturePile()
+    : analyze_pictures_for_gpu_rasterization_(false),
+      analyze_pictures_for_solid_color_(false) {
 }
 
 PicturePile::~PicturePile() {
@@ -236,6 +238,8 @@ bool PicturePile::Update(
                                   painter,
                                   tile_grid_info_,
                                   gather_pixel_refs,
+                                  gfx::Rect(),
+                                  analyze_pictures_for_gpu_rasterization_,
                                   num_raster_threads);
         base::TimeDelta duration =
             stats_instrumentation->EndRecording(start_time);
@@ -246,6 +250,13 @@ bool PicturePile::Update(
       stats_instrumentation->AddRecord(best_duration, recorded_pixel_count);
     }
 
+    // Analyzed once, outside the recording time, over the part of the
+    // recording inside the layer.
+    if (analyze_pictures_for_solid_color_) {
+      picture->AnalyzeForSolidColor(
+          gfx::IntersectRects(record_rect, gfx::Rect(size())));
+    }
+
     for (TilingData::Iterator it(&tiling_, record_rect);
         it; ++it) {
       const PictureMapKey& key = it.index();
@@ -261,4 +272,15 @@ bool PicturePile::Update(
   return true;
 }
 
+bool PicturePile::IsSuitableForGpuRasterization() const {
+  for (PictureMap::const_iterator it = picture_map_.begin();
+       it != picture_map_.end();
+       ++it) {
+    const Picture* picture = it->second.GetPicture();
+    if (picture && !picture->IsSuitableForGpuRasterization())
+      return false;
+  }
+  return true;
+}
+
 }  // namespace cc
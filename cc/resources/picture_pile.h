@@ -37,12 +37,32 @@ class CC_EXPORT PicturePile : public PicturePileBase {
     show_debug_picture_borders_ = show;
   }
 
+  // When set, pictures recorded from now on are checked for content that
+  // Ganesh rasterizes slowly.
+  void set_analyze_pictures_for_gpu_rasterization(bool analyze) {
+    analyze_pictures_for_gpu_rasterization_ = analyze;
+  }
+
+  // When set, pictures recorded from now on are checked for being a single
+  // color within the layer, which lets the tile manager skip rasterizing the
+  // tiles they cover.
+  void set_analyze_pictures_for_solid_color(bool analyze) {
+    analyze_pictures_for_solid_color_ = analyze;
+  }
+
+  // Returns false if any of the recorded pictures was found unsuitable for
+  // GPU rasterization.
+  bool IsSuitableForGpuRasterization() const;
+
  protected:
   virtual ~PicturePile();
 
  private:
   friend class PicturePileImpl;
 
+  bool analyze_pictures_for_gpu_rasterization_;
+  bool analyze_pictures_for_solid_color_;
+
   DISALLOW_COPY_AND_ASSIGN(PicturePile);
 };
 
@@ -343,6 +343,36 @@ void PicturePileImpl::AnalyzeInRect(
   analysis->has_text = canvas.HasText();
 }
 
+bool PicturePileImpl::GetColorIfSolidInRect(const gfx::Rect& content_rect,
+                                            float contents_scale,
+                                            SkColor* color) const {
+  gfx::Rect layer_rect = gfx::ScaleToEnclosingRect(
+      content_rect, 1.f / contents_scale);
+  layer_rect.Intersect(gfx::Rect(tiling_.total_size()));
+
+  bool found_picture = false;
+  SkColor solid_color = SK_ColorTRANSPARENT;
+  for (TilingData::Iterator tile_iter(&tiling_, layer_rect);
+       tile_iter; ++tile_iter) {
+    PictureMap::const_iterator map_iter = picture_map_.find(tile_iter.index());
+    if (map_iter == picture_map_.end())
+      return false;
+    const Picture* picture = map_iter->second.GetPicture();
+    SkColor picture_color;
+    if (!picture || !picture->GetColorIfSolid(&picture_color))
+      return false;
+    if (found_picture && picture_color != solid_color)
+      return false;
+    found_picture = true;
+    solid_color = picture_color;
+  }
+
+  if (!found_picture)
+    return false;
+  *color = solid_color;
+  return true;
+}
+
 PicturePileImpl::Analysis::Analysis()
     : is_solid_color(false),
       has_text(false) {
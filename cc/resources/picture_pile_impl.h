@@ -80,6 +80,13 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
                      Analysis* analysis,
                      RenderingStatsInstrumentation* stats_instrumentation);
 
+  // Returns true if all the pictures covering |content_rect| were recorded as
+  // the same solid color, without rastering any of them. The color is written
+  // to |color|.
+  bool GetColorIfSolidInRect(const gfx::Rect& content_rect,
+                             float contents_scale,
+                             SkColor* color) const;
+
   class CC_EXPORT PixelRefIterator {
    public:
     PixelRefIterator(const gfx::Rect& content_rect,
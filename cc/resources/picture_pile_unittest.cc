@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "cc/resources/picture_pile.h"
+#include "cc/resources/picture_pile_impl.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/fake_rendering_stats_instrumentation.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -299,5 +300,89 @@ TEST(PicturePileTest, StopRecordingOffscreenInvalidations) {
   }
 }
 
+TEST(PicturePileTest, SolidColorPictures) {
+  FakeContentLayerClient client;
+  FakeRenderingStatsInstrumentation stats_instrumentation;
+  scoped_refptr<TestPicturePile> pile = new TestPicturePile;
+  SkColor background_color = SK_ColorBLUE;
+
+  gfx::Size tile_size = pile->tiling().max_texture_size();
+  gfx::Size layer_size = gfx::ToFlooredSize(gfx::ScaleSize(tile_size, 2.f));
+  pile->Resize(layer_size);
+  pile->SetTileGridSize(gfx::Size(1000, 1000));
+  pile->set_analyze_pictures_for_solid_color(true);
+
+  SkPaint white_paint;
+  white_paint.setColor(SK_ColorWHITE);
+  client.add_draw_rect(gfx::Rect(layer_size), white_paint);
+  pile->Update(&client,
+               background_color,
+               true,
+               gfx::Rect(layer_size),
+               gfx::Rect(layer_size),
+               1,
+               &stats_instrumentation);
+
+  scoped_refptr<PicturePileImpl> pile_impl =
+      PicturePileImpl::CreateFromOther(pile.get());
+  SkColor color = SK_ColorTRANSPARENT;
+  EXPECT_TRUE(pile_impl->GetColorIfSolidInRect(
+      gfx::Rect(layer_size), 1.f, &color));
+  EXPECT_EQ(SK_ColorWHITE, color);
+
+  // Drawing something in the middle of the layer only leaves the pictures it
+  // doesn't touch solid.
+  SkPaint black_paint;
+  black_paint.setColor(SK_ColorBLACK);
+  gfx::Rect black_rect(tile_size.width() / 2, tile_size.height() / 2, 1, 1);
+  client.add_draw_rect(black_rect, black_paint);
+  pile->Update(&client,
+               background_color,
+               true,
+               black_rect,
+               gfx::Rect(layer_size),
+               2,
+               &stats_instrumentation);
+
+  pile_impl = PicturePileImpl::CreateFromOther(pile.get());
+  EXPECT_FALSE(pile_impl->GetColorIfSolidInRect(
+      gfx::Rect(layer_size), 1.f, &color));
+  EXPECT_FALSE(pile_impl->GetColorIfSolidInRect(
+      gfx::Rect(tile_size), 1.f, &color));
+  gfx::Rect far_rect(layer_size.width() - 10, layer_size.height() - 10, 10, 10);
+  EXPECT_TRUE(pile_impl->GetColorIfSolidInRect(far_rect, 1.f, &color));
+  EXPECT_EQ(SK_ColorWHITE, color);
+}
+
+TEST(PicturePileTest, SolidColorAnalysisIsOptional) {
+  FakeContentLayerClient client;
+  FakeRenderingStatsInstrumentation stats_instrumentation;
+  scoped_refptr<TestPicturePile> pile = new TestPicturePile;
+  SkColor background_color = SK_ColorBLUE;
+
+  gfx::Size layer_size = pile->tiling().max_texture_size();
+  pile->Resize(layer_size);
+  pile->SetTileGridSize(gfx::Size(1000, 1000));
+
+  SkPaint white_paint;
+  white_paint.setColor(SK_ColorWHITE);
+  client.add_draw_rect(gfx::Rect(layer_size), white_paint);
+  pile->Update(&client,
+               background_color,
+               true,
+               gfx::Rect(layer_size),
+               gfx::Rect(layer_size),
+               1,
+               &stats_instrumentation);
+
+  // Pictures are only analyzed when the pile is asked to, so tiles are left
+  // to the raster task's own analysis.
+  scoped_refptr<PicturePileImpl> pile_impl =
+      PicturePileImpl::CreateFromOther(pile.get());
+  SkColor color = SK_ColorTRANSPARENT;
+  EXPECT_FALSE(pile_impl->GetColorIfSolidInRect(
+      gfx::Rect(layer_size), 1.f, &color));
+}
+
 }  // namespace
 }  // namespace cc
@@ -49,7 +49,8 @@ TEST(PictureTest, AsBase64String) {
   // Single full-size rect picture.
   content_layer_client.add_draw_rect(layer_rect, red_paint);
   scoped_refptr<Picture> one_rect_picture = Picture::Create(
-      layer_rect, &content_layer_client, tile_grid_info, false, 0);
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), false, 0);
   scoped_ptr<base::Value> serialized_one_rect(
       one_rect_picture->AsValue());
 
@@ -74,7 +75,8 @@ TEST(PictureTest, AsBase64String) {
   // Two rect picture.
   content_layer_client.add_draw_rect(gfx::Rect(25, 25, 50, 50), green_paint);
   scoped_refptr<Picture> two_rect_picture = Picture::Create(
-      layer_rect, &content_layer_client, tile_grid_info, false, 0);
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), false, 0);
 
   scoped_ptr<base::Value> serialized_two_rect(
       two_rect_picture->AsValue());
@@ -133,7 +135,8 @@ TEST(PictureTest, PixelRefIterator) {
   }
 
   scoped_refptr<Picture> picture = Picture::Create(
-      layer_rect, &content_layer_client, tile_grid_info, true, 0);
+      layer_rect, &content_layer_client, tile_grid_info,
+      true, gfx::Rect(), false, 0);
 
   // Default iterator does not have any pixel refs
   {
@@ -230,7 +233,8 @@ TEST(PictureTest, PixelRefIteratorNonZeroLayer) {
   }
 
   scoped_refptr<Picture> picture = Picture::Create(
-      layer_rect, &content_layer_client, tile_grid_info, true, 0);
+      layer_rect, &content_layer_client, tile_grid_info,
+      true, gfx::Rect(), false, 0);
 
   // Default iterator does not have any pixel refs
   {
@@ -350,7 +354,8 @@ TEST(PictureTest, PixelRefIteratorOnePixelQuery) {
   }
 
   scoped_refptr<Picture> picture = Picture::Create(
-      layer_rect, &content_layer_client, tile_grid_info, true, 0);
+      layer_rect, &content_layer_client, tile_grid_info,
+      true, gfx::Rect(), false, 0);
 
   for (int y = 0; y < 4; ++y) {
     for (int x = 0; x < 4; ++x) {
@@ -395,7 +400,8 @@ TEST(PictureTest, CreateFromSkpValue) {
   // Single full-size rect picture.
   content_layer_client.add_draw_rect(layer_rect, red_paint);
   scoped_refptr<Picture> one_rect_picture = Picture::Create(
-      layer_rect, &content_layer_client, tile_grid_info, false, 0);
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), false, 0);
   scoped_ptr<base::Value> serialized_one_rect(
       one_rect_picture->AsValue());
 
@@ -416,5 +422,110 @@ TEST(PictureTest, CreateFromSkpValue) {
   EXPECT_EQ(100, one_rect_picture_check->OpaqueRect().width());
   EXPECT_EQ(200, one_rect_picture_check->OpaqueRect().height());
 }
+
+TEST(PictureTest, SuitableForGpuRasterization) {
+  gfx::Rect layer_rect(100, 100);
+
+  SkTileGridPicture::TileGridInfo tile_grid_info;
+  tile_grid_info.fTileInterval = SkISize::Make(100, 100);
+  tile_grid_info.fMargin.setEmpty();
+  tile_grid_info.fOffset.setZero();
+
+  FakeContentLayerClient content_layer_client;
+
+  // A concave path.
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(50, 50);
+  path.lineTo(100, 0);
+  path.lineTo(50, 100);
+  path.close();
+
+  // Concave paths are cheap to draw on the GPU without antialiasing.
+  SkPaint aliased_paint;
+  for (int i = 0; i < 10; ++i)
+    content_layer_client.add_draw_path(path, aliased_paint);
+  scoped_refptr<Picture> picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), true, 0);
+  EXPECT_TRUE(picture->IsSuitableForGpuRasterization());
+
+  SkPaint antialiased_paint;
+  antialiased_paint.setAntiAlias(true);
+  for (int i = 0; i < 4; ++i)
+    content_layer_client.add_draw_path(path, antialiased_paint);
+  picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), true, 0);
+  EXPECT_TRUE(picture->IsSuitableForGpuRasterization());
+
+  content_layer_client.add_draw_path(path, antialiased_paint);
+  picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), true, 0);
+  EXPECT_FALSE(picture->IsSuitableForGpuRasterization());
+
+  // Pictures that were not analyzed are assumed to be suitable.
+  picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, gfx::Rect(), false, 0);
+  EXPECT_TRUE(picture->IsSuitableForGpuRasterization());
+}
+
+TEST(PictureTest, SolidColorPictureIsSharedAcrossThreads) {
+  gfx::Rect layer_rect(100, 100);
+
+  SkTileGridPicture::TileGridInfo tile_grid_info;
+  tile_grid_info.fTileInterval = SkISize::Make(100, 100);
+  tile_grid_info.fMargin.setEmpty();
+  tile_grid_info.fOffset.setZero();
+
+  FakeContentLayerClient content_layer_client;
+  SkPaint red_paint;
+  red_paint.setColor(SK_ColorRED);
+  content_layer_client.add_draw_rect(layer_rect, red_paint);
+
+  scoped_refptr<Picture> picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, layer_rect, false, 4);
+  SkColor color;
+  ASSERT_TRUE(picture->GetColorIfSolid(&color));
+  EXPECT_EQ(SK_ColorRED, color);
+  for (unsigned i = 0; i < 4; ++i)
+    EXPECT_EQ(picture.get(), picture->GetCloneForDrawingOnThread(i));
+
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, 50, 50);
+  bitmap.allocPixels();
+  bitmap.eraseColor(SK_ColorTRANSPARENT);
+  SkCanvas canvas(bitmap);
+  picture->Raster(&canvas, NULL, Region(), 0.5f);
+  EXPECT_EQ(SK_ColorRED, bitmap.getColor(0, 0));
+  EXPECT_EQ(SK_ColorRED, bitmap.getColor(49, 49));
+
+  // Pictures that are not solid still get one clone per extra thread.
+  content_layer_client.add_draw_rect(gfx::Rect(50, 50), SkPaint());
+  picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info,
+      false, layer_rect, false, 4);
+  EXPECT_FALSE(picture->GetColorIfSolid(&color));
+  EXPECT_NE(picture.get(), picture->GetCloneForDrawingOnThread(0));
+  EXPECT_EQ(picture.get(), picture->GetCloneForDrawingOnThread(3));
+
+  // Pictures can also be analyzed after they were cloned.
+  FakeContentLayerClient red_layer_client;
+  red_layer_client.add_draw_rect(layer_rect, red_paint);
+  picture = Picture::Create(
+      layer_rect, &red_layer_client, tile_grid_info,
+      false, gfx::Rect(), false, 4);
+  EXPECT_FALSE(picture->GetColorIfSolid(&color));
+  EXPECT_NE(picture.get(), picture->GetCloneForDrawingOnThread(0));
+  picture->AnalyzeForSolidColor(layer_rect);
+  ASSERT_TRUE(picture->GetColorIfSolid(&color));
+  EXPECT_EQ(SK_ColorRED, color);
+  for (unsigned i = 0; i < 4; ++i)
+    EXPECT_EQ(picture.get(), picture->GetCloneForDrawingOnThread(i));
+}
+
 }  // namespace
 }  // namespace cc
@@ -42,21 +42,25 @@ namespace {
 
 typedef std::vector<Tile*> TileVector;
 
-void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
+// Bins are sorted this many tiles at a time at first, then in chunks as large
+// as the part already sorted.
+const size_t kMinSortChunkSize = 64;
+
+bool BinNeedsSorting(ManagedTileBin bin) {
   switch (bin) {
     case NOW_AND_READY_TO_DRAW_BIN:
     case NEVER_BIN:
-      break;
+      return false;
     case NOW_BIN:
     case SOON_BIN:
     case EVENTUALLY_AND_ACTIVE_BIN:
     case EVENTUALLY_BIN:
     case AT_LAST_AND_ACTIVE_BIN:
     case AT_LAST_BIN:
-      std::sort(tiles->begin(), tiles->end(), BinComparator());
-      break;
+      return true;
     default:
       NOTREACHED();
+      return false;
   }
 }
 
@@ -64,27 +68,48 @@ void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
 
 PrioritizedTileSet::PrioritizedTileSet() {
   for (int bin = 0; bin < NUM_BINS; ++bin)
-    bin_sorted_[bin] = true;
+    num_sorted_tiles_[bin] = 0;
 }
 
 PrioritizedTileSet::~PrioritizedTileSet() {}
 
 void PrioritizedTileSet::InsertTile(Tile* tile, ManagedTileBin bin) {
   tiles_[bin].push_back(tile);
-  bin_sorted_[bin] = false;
+  num_sorted_tiles_[bin] = 0;
 }
 
 void PrioritizedTileSet::Clear() {
   for (int bin = 0; bin < NUM_BINS; ++bin) {
     tiles_[bin].clear();
-    bin_sorted_[bin] = true;
+    num_sorted_tiles_[bin] = 0;
   }
 }
 
-void PrioritizedTileSet::SortBinIfNeeded(ManagedTileBin bin) {
-  if (!bin_sorted_[bin]) {
-    SortBinTiles(bin, &tiles_[bin]);
-    bin_sorted_[bin] = true;
+void PrioritizedTileSet::SortBinIfNeeded(ManagedTileBin bin, size_t index) {
+  TileVector& tiles = tiles_[bin];
+  size_t& num_sorted = num_sorted_tiles_[bin];
+  if (index < num_sorted || index >= tiles.size())
+    return;
+
+  if (!BinNeedsSorting(bin)) {
+    num_sorted = tiles.size();
+    return;
+  }
+
+  // The iteration stops following priority order once memory runs out, so
+  // only sort the next chunk of tiles instead of the whole bin. Since chunks
+  // grow as the sorted part does, going through the whole bin costs about as
+  // much as sorting it at once.
+  while (index >= num_sorted) {
+    size_t chunk_size = std::max(kMinSortChunkSize, num_sorted);
+    TileVector::iterator chunk_begin = tiles.begin() + num_sorted;
+    TileVector::iterator chunk_end = tiles.end();
+    if (chunk_size < tiles.size() - num_sorted) {
+      chunk_end = chunk_begin + chunk_size;
+      std::nth_element(chunk_begin, chunk_end, tiles.end(), BinComparator());
+    }
+    std::sort(chunk_begin, chunk_end, BinComparator());
+    num_sorted = chunk_end - tiles.begin();
   }
 }
 
@@ -92,11 +117,11 @@ PrioritizedTileSet::Iterator::Iterator(
     PrioritizedTileSet* tile_set, bool use_priority_ordering)
     : tile_set_(tile_set),
       current_bin_(NOW_AND_READY_TO_DRAW_BIN),
+      index_(0),
       use_priority_ordering_(use_priority_ordering) {
   if (use_priority_ordering_)
-    tile_set_->SortBinIfNeeded(current_bin_);
-  iterator_ = tile_set->tiles_[current_bin_].begin();
-  if (iterator_ == tile_set_->tiles_[current_bin_].end())
+    tile_set_->SortBinIfNeeded(current_bin_, index_);
+  if (index_ == tile_set_->tiles_[current_bin_].size())
     AdvanceList();
 }
 
@@ -109,30 +134,32 @@ void PrioritizedTileSet::Iterator::DisablePriorityOrdering() {
 PrioritizedTileSet::Iterator&
 PrioritizedTileSet::Iterator::operator++() {
   // We can't increment past the end of the tiles.
-  DCHECK(iterator_ != tile_set_->tiles_[current_bin_].end());
+  DCHECK_LT(index_, tile_set_->tiles_[current_bin_].size());
 
-  ++iterator_;
-  if (iterator_ == tile_set_->tiles_[current_bin_].end())
+  ++index_;
+  if (index_ == tile_set_->tiles_[current_bin_].size())
     AdvanceList();
+  else if (use_priority_ordering_)
+    tile_set_->SortBinIfNeeded(current_bin_, index_);
   return *this;
 }
 
 Tile* PrioritizedTileSet::Iterator::operator*() {
-  DCHECK(iterator_ != tile_set_->tiles_[current_bin_].end());
-  return *iterator_;
+  DCHECK_LT(index_, tile_set_->tiles_[current_bin_].size());
+  return tile_set_->tiles_[current_bin_][index_];
 }
 
 void PrioritizedTileSet::Iterator::AdvanceList() {
-  DCHECK(iterator_ == tile_set_->tiles_[current_bin_].end());
+  DCHECK_EQ(index_, tile_set_->tiles_[current_bin_].size());
 
   while (current_bin_ != NEVER_BIN) {
     current_bin_ = static_cast<ManagedTileBin>(current_bin_ + 1);
+    index_ = 0;
 
     if (use_priority_ordering_)
-      tile_set_->SortBinIfNeeded(current_bin_);
+      tile_set_->SortBinIfNeeded(current_bin_, index_);
 
-    iterator_ = tile_set_->tiles_[current_bin_].begin();
-    if (iterator_ != tile_set_->tiles_[current_bin_].end())
+    if (index_ != tile_set_->tiles_[current_bin_].size())
       break;
   }
 }
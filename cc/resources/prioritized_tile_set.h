@@ -33,7 +33,7 @@ class CC_EXPORT PrioritizedTileSet {
     Tile* operator->() { return *(*this); }
     Tile* operator*();
     operator bool() const {
-      return iterator_ != tile_set_->tiles_[current_bin_].end();
+      return index_ < tile_set_->tiles_[current_bin_].size();
     }
 
    private:
@@ -41,17 +41,20 @@ class CC_EXPORT PrioritizedTileSet {
 
     PrioritizedTileSet* tile_set_;
     ManagedTileBin current_bin_;
-    std::vector<Tile*>::iterator iterator_;
+    size_t index_;
     bool use_priority_ordering_;
   };
 
  private:
   friend class Iterator;
 
-  void SortBinIfNeeded(ManagedTileBin bin);
+  // Makes sure the tile at |index| in |bin| is in priority order.
+  void SortBinIfNeeded(ManagedTileBin bin, size_t index);
 
   std::vector<Tile*> tiles_[NUM_BINS];
-  bool bin_sorted_[NUM_BINS];
+  // The tiles of each bin before this count are sorted, and come before the
+  // rest of the bin in priority order.
+  size_t num_sorted_tiles_[NUM_BINS];
 };
 
 }  // namespace cc
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <set>
 #include <vector>
 
 #include "cc/resources/managed_tile_state.h"
@@ -65,9 +66,13 @@ class PrioritizedTileSetTest : public testing::Test {
   }
 
   scoped_refptr<Tile> CreateTile() {
+    return CreateTileWithContentRect(gfx::Rect());
+  }
+
+  scoped_refptr<Tile> CreateTileWithContentRect(const gfx::Rect& content_rect) {
     return tile_manager_->CreateTile(picture_pile_.get(),
                                      settings_.default_tile_size,
-                                     gfx::Rect(),
+                                     content_rect,
                                      gfx::Rect(),
                                      1.0,
                                      0,
@@ -75,6 +80,24 @@ class PrioritizedTileSetTest : public testing::Test {
                                      Tile::USE_LCD_TEXT);
   }
 
+  // Inserts |count| tiles into NOW_BIN of |set|, out of order. The tiles
+  // differ by position only, so that their order is unique.
+  void InsertTilesInNowBin(int count,
+                           PrioritizedTileSet* set,
+                           std::vector<scoped_refptr<Tile> >* tiles) {
+    for (int i = 0; i < count; ++i) {
+      // 7 has no common factor with the counts used, so this visits every
+      // position once.
+      int position = (i * 7) % count;
+      scoped_refptr<Tile> tile = CreateTileWithContentRect(
+          gfx::Rect((position % 25) * 10, (position / 25) * 10, 10, 10));
+      tile->SetPriority(ACTIVE_TREE, TilePriorityForNowBin());
+      tile->SetPriority(PENDING_TREE, TilePriorityForNowBin());
+      tiles->push_back(tile);
+      set->InsertTile(tile, NOW_BIN);
+    }
+  }
+
  private:
   LayerTreeSettings settings_;
   FakeOutputSurfaceClient output_surface_client_;
@@ -173,6 +196,61 @@ TEST_F(PrioritizedTileSetTest, NowBin) {
   EXPECT_EQ(20, i);
 }
 
+TEST_F(PrioritizedTileSetTest, ManyTilesInOneBin) {
+  // A bin large enough to be sorted in several steps still comes out in
+  // BinComparator order.
+
+  PrioritizedTileSet set;
+  std::vector<scoped_refptr<Tile> > tiles;
+  InsertTilesInNowBin(500, &set, &tiles);
+
+  std::sort(tiles.begin(), tiles.end(), BinComparator());
+
+  int i = 0;
+  for (PrioritizedTileSet::Iterator it(&set, true);
+       it;
+       ++it) {
+    EXPECT_TRUE(*it == tiles[i].get());
+    ++i;
+  }
+  EXPECT_EQ(500, i);
+}
+
+TEST_F(PrioritizedTileSetTest, ManyTilesInOneBinDisablePriority) {
+  // Tiles come in order until DisablePriorityOrdering is called in the middle
+  // of the bin, and every tile still comes once after that.
+
+  PrioritizedTileSet set;
+  std::vector<scoped_refptr<Tile> > tiles;
+  InsertTilesInNowBin(500, &set, &tiles);
+
+  std::sort(tiles.begin(), tiles.end(), BinComparator());
+
+  std::set<Tile*> seen_tiles;
+  int i = 0;
+  for (PrioritizedTileSet::Iterator it(&set, true);
+       it;
+       ++it) {
+    if (i < 100)
+      EXPECT_TRUE(*it == tiles[i].get());
+    if (i == 100)
+      it.DisablePriorityOrdering();
+    EXPECT_TRUE(seen_tiles.insert(*it).second);
+    ++i;
+  }
+  EXPECT_EQ(500, i);
+
+  // A new iterator sees the whole bin in order.
+  i = 0;
+  for (PrioritizedTileSet::Iterator it(&set, true);
+       it;
+       ++it) {
+    EXPECT_TRUE(*it == tiles[i].get());
+    ++i;
+  }
+  EXPECT_EQ(500, i);
+}
+
 TEST_F(PrioritizedTileSetTest, SoonBin) {
   // Ensure that tiles in SOON_BIN are sorted according to BinComparator.
 
@@ -2134,8 +2134,9 @@ uint8_t* ResourceProvider::MapImage(const Resource* resource, int* stride) {
     DCHECK(gl);
     gl->GetImageParameterivCHROMIUM(
         resource->image_id, GL_IMAGE_ROWBYTES_CHROMIUM, stride);
+    // Raster never reads the old contents of the buffer.
     return static_cast<uint8_t*>(
-        gl->MapImageCHROMIUM(resource->image_id, GL_READ_WRITE));
+        gl->MapImageCHROMIUM(resource->image_id, GL_WRITE_ONLY));
   }
   DCHECK_EQ(Bitmap, resource->type);
   *stride = 0;
@@ -597,7 +597,7 @@ class CC_EXPORT ResourceProvider {
   // manipulation of texture memory.
   void AcquireImage(Resource* resource);
   void ReleaseImage(Resource* resource);
-  // Maps the acquired image so that its pixels could be modified.
+  // Maps the acquired image write-only so that its pixels could be set.
   // Unmap is called when all pixels are set.
   uint8_t* MapImage(const Resource* resource, int* stride);
   void UnmapImage(const Resource* resource);
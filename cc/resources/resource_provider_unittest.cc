@@ -3020,7 +3020,7 @@ TEST_P(ResourceProviderTest, Image_GLTexture) {
                                                     _))
       .WillOnce(SetArgPointee<2>(kStride))
       .RetiresOnSaturation();
-  EXPECT_CALL(*context, mapImageCHROMIUM(kImageId, GL_READ_WRITE))
+  EXPECT_CALL(*context, mapImageCHROMIUM(kImageId, GL_WRITE_ONLY))
       .WillOnce(Return(dummy_mapped_buffer_address))
       .RetiresOnSaturation();
   resource_provider->MapImageRasterBuffer(id);
@@ -3050,7 +3050,7 @@ TEST_P(ResourceProviderTest, Image_GLTexture) {
       getImageParameterivCHROMIUM(kImageId, GL_IMAGE_ROWBYTES_CHROMIUM, _))
       .WillOnce(SetArgPointee<2>(kStride))
       .RetiresOnSaturation();
-  EXPECT_CALL(*context, mapImageCHROMIUM(kImageId, GL_READ_WRITE))
+  EXPECT_CALL(*context, mapImageCHROMIUM(kImageId, GL_WRITE_ONLY))
       .WillOnce(Return(dummy_mapped_buffer_address))
       .RetiresOnSaturation();
   resource_provider->MapImageRasterBuffer(id);
@@ -33,6 +33,8 @@ Tile::Tile(TileManager* tile_manager,
     flags_(flags),
     id_(s_next_id_++) {
   set_picture_pile(picture_pile);
+  for (int i = 0; i < NUM_TREES; ++i)
+    is_occluded_[i] = false;
 }
 
 Tile::~Tile() {
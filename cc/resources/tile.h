@@ -57,6 +57,13 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
     return priority_[PENDING_TREE].required_for_activation;
   }
 
+  // Whether layers in front of this tile's layer fully hide the tile in the
+  // given tree.
+  bool is_occluded(WhichTree tree) const { return is_occluded_[tree]; }
+  void set_is_occluded(WhichTree tree, bool is_occluded) {
+    is_occluded_[tree] = is_occluded;
+  }
+
   void set_can_use_lcd_text(bool can_use_lcd_text) {
     if (can_use_lcd_text)
       flags_ |= USE_LCD_TEXT;
@@ -155,6 +162,7 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
   gfx::Rect opaque_rect_;
 
   TilePriority priority_[NUM_TREES];
+  bool is_occluded_[NUM_TREES];
   ManagedTileState managed_state_;
   int layer_id_;
   int source_frame_number_;
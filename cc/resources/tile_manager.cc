@@ -992,6 +992,16 @@ scoped_refptr<Tile> TileManager::CreateTile(PicturePileImpl* picture_pile,
                                                          flags));
   DCHECK(tiles_.find(tile->id()) == tiles_.end());
 
+  // Tiles covered by pictures that were recorded as a single color don't
+  // need memory or a raster task, in any raster mode.
+  SkColor solid_color;
+  if (picture_pile->GetColorIfSolidInRect(
+          content_rect, contents_scale, &solid_color)) {
+    ManagedTileState& mts = tile->managed_state();
+    for (int mode = 0; mode < NUM_RASTER_MODES; ++mode)
+      mts.tile_versions[mode].set_solid_color(solid_color);
+  }
+
   tiles_[tile->id()] = tile;
   used_layer_counts_[tile->layer_id()]++;
   prioritized_tiles_dirty_ = true;
@@ -49,11 +49,12 @@ class TileManagerPerfTest : public testing::Test {
     picture_pile_ = FakePicturePileImpl::CreatePile();
   }
 
-  GlobalStateThatImpactsTilePriority GlobalStateForTest() {
+  GlobalStateThatImpactsTilePriority GlobalStateForTest(
+      size_t memory_limit_in_tiles) {
     GlobalStateThatImpactsTilePriority state;
     gfx::Size tile_size = settings_.default_tile_size;
     state.soft_memory_limit_in_bytes =
-        10000u * 4u *
+        memory_limit_in_tiles * 4u *
         static_cast<size_t>(tile_size.width() * tile_size.height());
     state.hard_memory_limit_in_bytes = state.soft_memory_limit_in_bytes;
     state.num_resources_limit = 10000;
@@ -135,7 +136,8 @@ class TileManagerPerfTest : public testing::Test {
 
   void RunManageTilesTest(const std::string& test_name,
                           unsigned tile_count,
-                          int priority_change_percent) {
+                          int priority_change_percent,
+                          size_t memory_limit_in_tiles) {
     DCHECK_GE(tile_count, 100u);
     DCHECK_GE(priority_change_percent, 0);
     DCHECK_LE(priority_change_percent, 100);
@@ -154,7 +156,7 @@ class TileManagerPerfTest : public testing::Test {
         }
       }
 
-      tile_manager_->ManageTiles(GlobalStateForTest());
+      tile_manager_->ManageTiles(GlobalStateForTest(memory_limit_in_tiles));
       tile_manager_->UpdateVisibleTiles();
       timer_.NextLap();
     } while (!timer_.HasTimeLimitExpired());
@@ -175,15 +177,22 @@ class TileManagerPerfTest : public testing::Test {
 };
 
 TEST_F(TileManagerPerfTest, ManageTiles) {
-  RunManageTilesTest("100_0", 100, 0);
-  RunManageTilesTest("1000_0", 1000, 0);
-  RunManageTilesTest("10000_0", 10000, 0);
-  RunManageTilesTest("100_10", 100, 10);
-  RunManageTilesTest("1000_10", 1000, 10);
-  RunManageTilesTest("10000_10", 10000, 10);
-  RunManageTilesTest("100_100", 100, 100);
-  RunManageTilesTest("1000_100", 1000, 100);
-  RunManageTilesTest("10000_100", 10000, 100);
+  RunManageTilesTest("100_0", 100, 0, 10000u);
+  RunManageTilesTest("1000_0", 1000, 0, 10000u);
+  RunManageTilesTest("10000_0", 10000, 0, 10000u);
+  RunManageTilesTest("100_10", 100, 10, 10000u);
+  RunManageTilesTest("1000_10", 1000, 10, 10000u);
+  RunManageTilesTest("10000_10", 10000, 10, 10000u);
+  RunManageTilesTest("100_100", 100, 100, 10000u);
+  RunManageTilesTest("1000_100", 1000, 100, 10000u);
+  RunManageTilesTest("10000_100", 10000, 100, 10000u);
+}
+
+// Memory only covers part of the tiles, like on large displays, so the
+// assignment stops following priority order early.
+TEST_F(TileManagerPerfTest, ManageTilesOutOfMemory) {
+  RunManageTilesTest("10000_10_oom", 10000, 10, 500u);
+  RunManageTilesTest("10000_100_oom", 10000, 100, 500u);
 }
 
 }  // namespace
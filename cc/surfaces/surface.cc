@@ -14,7 +14,8 @@ Surface::Surface(SurfaceManager* manager,
                  const gfx::Size& size)
     : manager_(manager),
       client_(client),
-      size_(size) {
+      size_(size),
+      frame_index_(0) {
   surface_id_ = manager_->RegisterAndAllocateIDForSurface(this);
 }
 
@@ -24,6 +25,7 @@ Surface::~Surface() {
 
 void Surface::QueueFrame(scoped_ptr<CompositorFrame> frame) {
   current_frame_ = frame.Pass();
+  ++frame_index_;
 }
 
 CompositorFrame* Surface::GetEligibleFrame() { return current_frame_.get(); }
@@ -29,6 +29,10 @@ class CC_SURFACES_EXPORT Surface {
   // Returns the most recent frame that is eligible to be rendered.
   CompositorFrame* GetEligibleFrame();
 
+  // Returns a number that changes every time a frame is queued, so that
+  // consumers can tell whether they have already seen the current frame.
+  int frame_index() const { return frame_index_; }
+
  private:
   SurfaceManager* manager_;
   SurfaceClient* client_;
@@ -36,6 +40,7 @@ class CC_SURFACES_EXPORT Surface {
   int surface_id_;
   // TODO(jamesr): Support multiple frames in flight.
   scoped_ptr<CompositorFrame> current_frame_;
+  int frame_index_;
 
   DISALLOW_COPY_AND_ASSIGN(Surface);
 };
@@ -6,6 +6,7 @@
 
 #include "base/containers/hash_tables.h"
 #include "base/logging.h"
+#include "cc/base/math_util.h"
 #include "cc/output/compositor_frame.h"
 #include "cc/output/delegated_frame_data.h"
 #include "cc/quads/draw_quad.h"
@@ -35,6 +36,26 @@ DelegatedFrameData* SurfaceAggregator::GetReferencedDataForSurfaceID(
   return referenced_frame->delegated_frame_data.get();
 }
 
+gfx::RectF SurfaceAggregator::DamageFromSurface(int surface_id,
+                                                const RenderPass& root_pass) {
+  Surface* surface = manager_->GetSurfaceForID(surface_id);
+  DCHECK(surface);
+  int frame_index = surface->frame_index();
+  contained_frames_[surface_id] = frame_index;
+
+  SurfaceFrameIndexMap::const_iterator it =
+      previous_contained_frames_.find(surface_id);
+  if (it == previous_contained_frames_.end())
+    return gfx::RectF(root_pass.output_rect);
+  if (it->second == frame_index)
+    return gfx::RectF();
+  // The frame's damage is relative to the frame queued before it, so it only
+  // covers the change since the last aggregation if no frame was skipped.
+  if (it->second == frame_index - 1)
+    return root_pass.damage_rect;
+  return gfx::RectF(root_pass.output_rect);
+}
+
 class SurfaceAggregator::RenderPassIdAllocator {
  public:
   explicit RenderPassIdAllocator(int surface_id)
@@ -127,6 +148,12 @@ void SurfaceAggregator::HandleSurfaceQuad(const SurfaceDrawQuad* surface_quad,
                   dest_pass,
                   surface_id);
 
+  // The embedded surface's damage is added to the pass it is drawn into, so
+  // that a change in the surface alone still gets redrawn.
+  dest_pass->damage_rect.Union(
+      MathUtil::MapClippedRect(surface_quad->quadTransform(),
+                               DamageFromSurface(surface_id, last_pass)));
+
   referenced_surfaces_.erase(it);
 }
 
@@ -199,9 +226,14 @@ void SurfaceAggregator::CopyPasses(const RenderPassList& source_pass_list,
 
     RenderPass::Id remapped_pass_id = RemapPassId(source.id, surface_id);
 
+    bool is_root_pass = i + 1 == source_pass_list.size();
+    gfx::RectF damage_rect = is_root_pass
+                                 ? DamageFromSurface(surface_id, source)
+                                 : source.damage_rect;
+
     copy_pass->SetAll(remapped_pass_id,
                       source.output_rect,
-                      source.damage_rect,
+                      damage_rect,
                       source.transform_to_root_target,
                       source.has_transparent_background);
 
@@ -240,6 +272,8 @@ scoped_ptr<CompositorFrame> SurfaceAggregator::Aggregate(int surface_id) {
   DCHECK(referenced_surfaces_.empty());
 
   dest_pass_list_ = NULL;
+  previous_contained_frames_.swap(contained_frames_);
+  contained_frames_.clear();
 
   // TODO(jamesr): Aggregate all resource references into the returned frame's
   // resource list.
@@ -5,12 +5,14 @@
 #ifndef CC_SURFACES_SURFACE_AGGREGATOR_H_
 #define CC_SURFACES_SURFACE_AGGREGATOR_H_
 
+#include <map>
 #include <set>
 
 #include "base/containers/scoped_ptr_hash_map.h"
 #include "base/memory/scoped_ptr.h"
 #include "cc/quads/render_pass.h"
 #include "cc/surfaces/surfaces_export.h"
+#include "ui/gfx/rect_f.h"
 
 namespace cc {
 
@@ -28,6 +30,11 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
 
  private:
   DelegatedFrameData* GetReferencedDataForSurfaceID(int surface_id);
+  // Returns the damage of |root_pass|, the root pass of the current frame of
+  // the surface |surface_id|. This is empty if that frame was already part of
+  // the previous aggregated frame, and the whole pass if the surface wasn't
+  // drawn then or has skipped frames since.
+  gfx::RectF DamageFromSurface(int surface_id, const RenderPass& root_pass);
   RenderPass::Id RemapPassId(RenderPass::Id surface_local_pass_id,
                              int surface_id);
 
@@ -50,6 +57,11 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
       RenderPassIdAllocatorMap;
   RenderPassIdAllocatorMap render_pass_allocator_map_;
 
+  // Maps the id of each surface drawn in the previous aggregated frame to the
+  // index of the frame it had then.
+  typedef std::map<int, int> SurfaceFrameIndexMap;
+  SurfaceFrameIndexMap previous_contained_frames_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
@@ -61,6 +73,9 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
   // This is the pass list for the aggregated frame.
   RenderPassList* dest_pass_list_;
 
+  // The frames of the surfaces drawn in the aggregated frame so far.
+  SurfaceFrameIndexMap contained_frames_;
+
   DISALLOW_COPY_AND_ASSIGN(SurfaceAggregator);
 };
 
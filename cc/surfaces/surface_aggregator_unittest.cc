@@ -694,6 +694,100 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, AggregateMultiplePassWithTransform) {
   }
 }
 
+// Tests that the damage of embedded surfaces reaches the root pass of the
+// aggregated frame, and that frames which were already aggregated don't
+// damage it again.
+TEST_F(SurfaceAggregatorValidSurfaceTest, AggregateDamageRect) {
+  gfx::Size surface_size(5, 5);
+
+  Surface child_surface(&manager_, NULL, surface_size);
+  test::Quad child_quads[] = {test::Quad::SolidColorQuad(SK_ColorGREEN)};
+  test::Pass child_passes[] = {
+      test::Pass(child_quads, arraysize(child_quads))};
+  SubmitFrame(child_passes, arraysize(child_passes), &child_surface);
+
+  test::Quad root_quads[] = {
+      test::Quad::SurfaceQuad(child_surface.surface_id())};
+  test::Pass root_passes[] = {test::Pass(root_quads, arraysize(root_quads))};
+
+  RenderPassList root_pass_list;
+  AddPasses(&root_pass_list,
+            gfx::Rect(surface_size),
+            root_passes,
+            arraysize(root_passes));
+  root_pass_list.at(0)
+      ->shared_quad_state_list[0]
+      ->content_to_target_transform.Translate(0, 10);
+
+  scoped_ptr<DelegatedFrameData> root_frame_data(new DelegatedFrameData);
+  root_pass_list.swap(root_frame_data->render_pass_list);
+  scoped_ptr<CompositorFrame> root_frame(new CompositorFrame);
+  root_frame->delegated_frame_data = root_frame_data.Pass();
+  root_surface_.QueueFrame(root_frame.Pass());
+
+  // Both frames are new, so both surfaces are fully damaged.
+  scoped_ptr<CompositorFrame> aggregated_frame =
+      aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  ASSERT_TRUE(aggregated_frame->delegated_frame_data);
+  const RenderPassList& first_pass_list =
+      aggregated_frame->delegated_frame_data->render_pass_list;
+  ASSERT_EQ(1u, first_pass_list.size());
+  EXPECT_EQ(gfx::RectF(0, 0, 5, 15).ToString(),
+            first_pass_list[0]->damage_rect.ToString());
+
+  // Only the child surface gets a new frame, with a small damage rect.
+  scoped_ptr<RenderPass> child_pass = RenderPass::Create();
+  child_pass->SetNew(RenderPass::Id(1, 1),
+                     gfx::Rect(surface_size),
+                     gfx::RectF(1, 1, 2, 2),
+                     gfx::Transform());
+  test::QueuePassAsFrame(child_pass.Pass(), &child_surface);
+
+  aggregated_frame = aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  ASSERT_TRUE(aggregated_frame->delegated_frame_data);
+  const RenderPassList& second_pass_list =
+      aggregated_frame->delegated_frame_data->render_pass_list;
+  ASSERT_EQ(1u, second_pass_list.size());
+  EXPECT_EQ(gfx::RectF(1, 11, 2, 2).ToString(),
+            second_pass_list[0]->damage_rect.ToString());
+
+  // Nothing changed since the last aggregation.
+  aggregated_frame = aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  ASSERT_TRUE(aggregated_frame->delegated_frame_data);
+  const RenderPassList& third_pass_list =
+      aggregated_frame->delegated_frame_data->render_pass_list;
+  ASSERT_EQ(1u, third_pass_list.size());
+  EXPECT_TRUE(third_pass_list[0]->damage_rect.IsEmpty());
+
+  // The child surface gets two frames between aggregations. The damage of the
+  // second one is relative to the first, which was never drawn, so the whole
+  // child surface is damaged.
+  child_pass = RenderPass::Create();
+  child_pass->SetNew(RenderPass::Id(1, 1),
+                     gfx::Rect(surface_size),
+                     gfx::RectF(1, 1, 2, 2),
+                     gfx::Transform());
+  test::QueuePassAsFrame(child_pass.Pass(), &child_surface);
+  child_pass = RenderPass::Create();
+  child_pass->SetNew(RenderPass::Id(1, 1),
+                     gfx::Rect(surface_size),
+                     gfx::RectF(3, 3, 1, 1),
+                     gfx::Transform());
+  test::QueuePassAsFrame(child_pass.Pass(), &child_surface);
+
+  aggregated_frame = aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  ASSERT_TRUE(aggregated_frame->delegated_frame_data);
+  const RenderPassList& fourth_pass_list =
+      aggregated_frame->delegated_frame_data->render_pass_list;
+  ASSERT_EQ(1u, fourth_pass_list.size());
+  EXPECT_EQ(gfx::RectF(0, 10, 5, 5).ToString(),
+            fourth_pass_list[0]->damage_rect.ToString());
+}
+
 }  // namespace
 }  // namespace cc
 
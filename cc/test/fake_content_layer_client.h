@@ -12,6 +12,7 @@
 #include "cc/layers/content_layer_client.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
 #include "ui/gfx/rect.h"
 
 namespace cc {
@@ -48,13 +49,19 @@ class FakeContentLayerClient : public ContentLayerClient {
     draw_bitmaps_.push_back(data);
   }
 
+  void add_draw_path(const SkPath& path, const SkPaint& paint) {
+    draw_paths_.push_back(std::make_pair(path, paint));
+  }
+
  private:
   typedef std::vector<std::pair<gfx::RectF, SkPaint> > RectPaintVector;
   typedef std::vector<BitmapData> BitmapVector;
+  typedef std::vector<std::pair<SkPath, SkPaint> > PathPaintVector;
 
   bool paint_all_opaque_;
   RectPaintVector draw_rects_;
   BitmapVector draw_bitmaps_;
+  PathPaintVector draw_paths_;
 };
 
 }  // namespace cc
@@ -29,6 +29,38 @@ static const int kTimeLimitMillis = 2000;
 static const int kWarmupRuns = 5;
 static const int kTimeCheckInterval = 10;
 
+// Shape of the synthetic tree used to measure pages with thousands of layers.
+static const int kNumContainers = 100;
+static const int kLayersPerContainer = 30;
+
+// Builds a tree of clipping containers, stacked down the page, each holding a
+// row of small drawn layers. One container in ten is scaled, so that not every
+// transform is a translation.
+scoped_refptr<Layer> BuildManyLayersTree(const gfx::Size& viewport) {
+  scoped_refptr<Layer> root = Layer::Create();
+  root->SetBounds(viewport);
+  for (int i = 0; i < kNumContainers; ++i) {
+    scoped_refptr<Layer> container = Layer::Create();
+    container->SetPosition(gfx::PointF(0.f, i * 100.f));
+    container->SetBounds(gfx::Size(viewport.width(), 100));
+    container->SetMasksToBounds(true);
+    if (i % 10 == 0) {
+      gfx::Transform scale;
+      scale.Scale(1.5, 1.5);
+      container->SetTransform(scale);
+    }
+    for (int j = 0; j < kLayersPerContainer; ++j) {
+      scoped_refptr<Layer> layer = Layer::Create();
+      layer->SetPosition(gfx::PointF(j * 24.f, 10.f));
+      layer->SetBounds(gfx::Size(20, 20));
+      layer->SetIsDrawable(true);
+      container->AddChild(layer);
+    }
+    root->AddChild(container);
+  }
+  return root;
+}
+
 class LayerTreeHostCommonPerfTest : public LayerTreeTest {
  public:
   LayerTreeHostCommonPerfTest()
@@ -146,6 +178,24 @@ class CalcDrawPropsImplTest : public LayerTreeHostCommonPerfTest {
   }
 };
 
+class CalcDrawPropsManyLayersMainTest : public CalcDrawPropsMainTest {
+ public:
+  virtual void SetupTree() OVERRIDE {
+    gfx::Size viewport = gfx::Size(720, 1038);
+    layer_tree_host()->SetViewportSize(viewport);
+    layer_tree_host()->SetRootLayer(BuildManyLayersTree(viewport));
+  }
+};
+
+class CalcDrawPropsManyLayersImplTest : public CalcDrawPropsImplTest {
+ public:
+  virtual void SetupTree() OVERRIDE {
+    gfx::Size viewport = gfx::Size(720, 1038);
+    layer_tree_host()->SetViewportSize(viewport);
+    layer_tree_host()->SetRootLayer(BuildManyLayersTree(viewport));
+  }
+};
+
 TEST_F(CalcDrawPropsMainTest, TenTen) {
   SetTestName("10_10_main_thread");
   ReadTestFile("10_10_layer_tree");
@@ -170,6 +220,11 @@ TEST_F(CalcDrawPropsMainTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsManyLayersMainTest, ManyLayers) {
+  SetTestName("many_layers_main_thread");
+  RunCalcDrawProps();
+}
+
 TEST_F(CalcDrawPropsImplTest, TenTen) {
   SetTestName("10_10");
   ReadTestFile("10_10_layer_tree");
@@ -194,5 +249,10 @@ TEST_F(CalcDrawPropsImplTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsManyLayersImplTest, ManyLayers) {
+  SetTestName("many_layers");
+  RunCalcDrawProps();
+}
+
 }  // namespace
 }  // namespace cc
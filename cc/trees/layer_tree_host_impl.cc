@@ -777,6 +777,7 @@ DrawSwapReadbackResult::DrawResult LayerTreeHostImpl::CalculateRenderPasses(
   bool have_copy_request = false;
 
   int layers_drawn = 0;
+  int64 checkerboarded_visible_content_area = 0;
 
   const DrawMode draw_mode = GetDrawMode(output_surface_.get());
 
@@ -853,6 +854,9 @@ DrawSwapReadbackResult::DrawResult LayerTreeHostImpl::CalculateRenderPasses(
       ++layers_drawn;
     }
 
+    checkerboarded_visible_content_area +=
+        append_quads_data.checkerboarded_visible_content_area;
+
     if (append_quads_data.num_missing_tiles) {
       bool layer_has_animating_transform =
           it->screen_space_transform_is_animating() ||
@@ -877,6 +881,11 @@ DrawSwapReadbackResult::DrawResult LayerTreeHostImpl::CalculateRenderPasses(
       output_surface_->capabilities().draw_and_swap_full_viewport_every_frame)
     draw_result = DrawSwapReadbackResult::DRAW_SUCCESS;
 
+  TRACE_COUNTER_ID1("cc",
+                    "checkerboarded_visible_content_area",
+                    this,
+                    checkerboarded_visible_content_area);
+
 #ifndef NDEBUG
   for (size_t i = 0; i < frame->render_passes.size(); ++i) {
     for (size_t j = 0; j < frame->render_passes[i]->quad_list.size(); ++j)
@@ -4,18 +4,25 @@
 
 #include "cc/trees/layer_tree_host.h"
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
+#include "base/command_line.h"
 #include "base/file_util.h"
 #include "base/files/file_path.h"
+#include "base/json/json_reader.h"
 #include "base/path_service.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/values.h"
+#include "cc/base/switches.h"
 #include "cc/layers/content_layer.h"
 #include "cc/layers/nine_patch_layer.h"
 #include "cc/layers/solid_color_layer.h"
 #include "cc/layers/texture_layer.h"
 #include "cc/resources/texture_mailbox.h"
+#include "cc/resources/tile_manager.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/lap_timer.h"
 #include "cc/test/layer_tree_json_parser.h"
@@ -38,9 +45,14 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
                     base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
                     kTimeCheckInterval),
         commit_timer_(0, base::TimeDelta(), 1),
+        main_frame_timer_(0, base::TimeDelta(), 1),
+        activate_timer_(0, base::TimeDelta(), 1),
         full_damage_each_frame_(false),
         animation_driven_drawing_(false),
-        measure_commit_cost_(false) {
+        measure_commit_cost_(false),
+        measure_stage_costs_(false),
+        tile_memory_used_bytes_(0),
+        num_resources_(0) {
     fake_content_layer_client_.set_paint_all_opaque(true);
   }
 
@@ -58,6 +70,28 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
       layer_tree_host()->SetNeedsAnimate();
   }
 
+  virtual void WillBeginMainFrame() OVERRIDE {
+    if (measure_stage_costs_)
+      main_frame_timer_.Start();
+  }
+
+  // Covers animation, layout and updating (painting) the layers.
+  virtual void WillCommit() OVERRIDE {
+    if (measure_stage_costs_ && draw_timer_.IsWarmedUp())
+      main_frame_timer_.NextLap();
+  }
+
+  virtual void WillActivateTreeOnThread(LayerTreeHostImpl* host_impl)
+      OVERRIDE {
+    if (measure_stage_costs_)
+      activate_timer_.Start();
+  }
+
+  virtual void DidActivateTreeOnThread(LayerTreeHostImpl* host_impl) OVERRIDE {
+    if (measure_stage_costs_ && draw_timer_.IsWarmedUp())
+      activate_timer_.NextLap();
+  }
+
   virtual void BeginCommitOnThread(LayerTreeHostImpl* host_impl) OVERRIDE {
     if (measure_commit_cost_)
       commit_timer_.Start();
@@ -74,6 +108,7 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
       return;
     draw_timer_.NextLap();
     if (draw_timer_.HasTimeLimitExpired()) {
+      RecordMemoryUsage(impl);
       CleanUpAndEndTest(impl);
       return;
     }
@@ -89,6 +124,19 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
 
   virtual void BuildTree() {}
 
+  void RecordMemoryUsage(LayerTreeHostImpl* impl) {
+    num_resources_ = impl->resource_provider()->num_resources();
+    if (!impl->tile_manager())
+      return;
+    size_t memory_required_bytes;
+    size_t memory_nice_to_have_bytes;
+    size_t memory_allocated_bytes;
+    impl->tile_manager()->GetMemoryStats(&memory_required_bytes,
+                                         &memory_nice_to_have_bytes,
+                                         &memory_allocated_bytes,
+                                         &tile_memory_used_bytes_);
+  }
+
   virtual void AfterTest() OVERRIDE {
     CHECK(!test_name_.empty()) << "Must SetTestName() before AfterTest().";
     perf_test::PrintResult("layer_tree_host_frame_time", "", test_name_,
@@ -97,11 +145,24 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
       perf_test::PrintResult("layer_tree_host_commit_time", "", test_name_,
                              1000 * commit_timer_.MsPerLap(), "us", true);
     }
+    if (measure_stage_costs_) {
+      perf_test::PrintResult("layer_tree_host_main_frame_time", "",
+                             test_name_, 1000 * main_frame_timer_.MsPerLap(),
+                             "us", true);
+      perf_test::PrintResult("layer_tree_host_activate_time", "", test_name_,
+                             1000 * activate_timer_.MsPerLap(), "us", true);
+      perf_test::PrintResult("layer_tree_host_tile_memory", "", test_name_,
+                             tile_memory_used_bytes_, "bytes", true);
+      perf_test::PrintResult("layer_tree_host_resources", "", test_name_,
+                             num_resources_, "count", true);
+    }
   }
 
  protected:
   LapTimer draw_timer_;
   LapTimer commit_timer_;
+  LapTimer main_frame_timer_;
+  LapTimer activate_timer_;
 
   std::string test_name_;
   FakeContentLayerClient fake_content_layer_client_;
@@ -109,6 +170,11 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
   bool animation_driven_drawing_;
 
   bool measure_commit_cost_;
+  // Also reports main frame and activation timings and the memory in use at
+  // the end of the test.
+  bool measure_stage_costs_;
+  size_t tile_memory_used_bytes_;
+  size_t num_resources_;
 };
 
 
@@ -126,6 +192,10 @@ class LayerTreeHostPerfTestJsonReader : public LayerTreeHostPerfTest {
     base::FilePath test_data_dir;
     ASSERT_TRUE(PathService::Get(CCPaths::DIR_TEST_DATA, &test_data_dir));
     base::FilePath json_file = test_data_dir.AppendASCII(name + ".json");
+    ReadTestFileFromPath(json_file);
+  }
+
+  void ReadTestFileFromPath(const base::FilePath& json_file) {
     ASSERT_TRUE(base::ReadFileToString(json_file, &json_));
   }
 
@@ -212,6 +282,125 @@ TEST_F(LayerTreeHostPerfTestLeafInvalidates, TenTenThreadedImplSide) {
   RunTestWithImplSidePainting();
 }
 
+// Replays a layer tree and a sequence of invalidations through the whole
+// pipeline, reporting the cost of each stage. The tree and the invalidations
+// can be supplied with --cc-perf-test-layer-tree and
+// --cc-perf-test-invalidations to benchmark recorded workloads. The
+// invalidations file is a JSON list of frames, each a list of
+// [layer_index, x, y, width, height] entries, where layer_index counts the
+// layers of the tree in pre-order. The frames are replayed in a loop, one per
+// commit.
+class LayerTreeHostPerfTestReplay : public LayerTreeHostPerfTestJsonReader {
+ public:
+  LayerTreeHostPerfTestReplay() : next_frame_(0) {
+    measure_commit_cost_ = true;
+    measure_stage_costs_ = true;
+  }
+
+  void ReadInvalidationsFromPath(const base::FilePath& path) {
+    std::string json;
+    ASSERT_TRUE(base::ReadFileToString(path, &json));
+    scoped_ptr<base::Value> value(base::JSONReader::Read(json));
+    base::ListValue* frames = NULL;
+    ASSERT_TRUE(value && value->GetAsList(&frames));
+    for (size_t i = 0; i < frames->GetSize(); ++i) {
+      base::ListValue* frame = NULL;
+      ASSERT_TRUE(frames->GetList(i, &frame));
+      InvalidationList invalidations;
+      for (size_t j = 0; j < frame->GetSize(); ++j) {
+        base::ListValue* entry = NULL;
+        ASSERT_TRUE(frame->GetList(j, &entry));
+        Invalidation invalidation;
+        int x, y, width, height;
+        ASSERT_TRUE(entry->GetInteger(0, &invalidation.layer_index));
+        ASSERT_TRUE(entry->GetInteger(1, &x));
+        ASSERT_TRUE(entry->GetInteger(2, &y));
+        ASSERT_TRUE(entry->GetInteger(3, &width));
+        ASSERT_TRUE(entry->GetInteger(4, &height));
+        invalidation.rect = gfx::Rect(x, y, width, height);
+        invalidations.push_back(invalidation);
+      }
+      frames_.push_back(invalidations);
+    }
+  }
+
+  void ReadInputsFromCommandLine(const std::string& default_test_file) {
+    const CommandLine* command_line = CommandLine::ForCurrentProcess();
+    base::FilePath tree_path =
+        command_line->GetSwitchValuePath(switches::kCCPerfTestLayerTree);
+    if (tree_path.empty())
+      ReadTestFile(default_test_file);
+    else
+      ReadTestFileFromPath(tree_path);
+
+    base::FilePath invalidations_path =
+        command_line->GetSwitchValuePath(switches::kCCPerfTestInvalidations);
+    if (!invalidations_path.empty())
+      ReadInvalidationsFromPath(invalidations_path);
+  }
+
+  virtual void BuildTree() OVERRIDE {
+    LayerTreeHostPerfTestJsonReader::BuildTree();
+    AppendLayers(layer_tree_host()->root_layer());
+
+    // Without recorded invalidations, repaint the first leaf every frame.
+    if (frames_.empty()) {
+      Layer* leaf = layer_tree_host()->root_layer();
+      while (leaf->children().size())
+        leaf = leaf->children()[0];
+      Invalidation invalidation;
+      invalidation.layer_index =
+          std::find(layers_.begin(), layers_.end(), leaf) - layers_.begin();
+      invalidation.rect = gfx::Rect(leaf->bounds());
+      frames_.push_back(InvalidationList(1, invalidation));
+    }
+  }
+
+  virtual void DidCommitAndDrawFrame() OVERRIDE {
+    if (TestEnded())
+      return;
+
+    const InvalidationList& invalidations = frames_[next_frame_];
+    for (size_t i = 0; i < invalidations.size(); ++i) {
+      int index = invalidations[i].layer_index;
+      ASSERT_LT(static_cast<size_t>(index), layers_.size());
+      layers_[index]->SetNeedsDisplayRect(invalidations[i].rect);
+    }
+    next_frame_ = (next_frame_ + 1) % frames_.size();
+    // Make sure the next frame commits even if nothing was invalidated.
+    layer_tree_host()->SetNeedsCommit();
+  }
+
+ private:
+  struct Invalidation {
+    int layer_index;
+    gfx::Rect rect;
+  };
+  typedef std::vector<Invalidation> InvalidationList;
+
+  void AppendLayers(Layer* layer) {
+    layers_.push_back(layer);
+    for (size_t i = 0; i < layer->children().size(); ++i)
+      AppendLayers(layer->children()[i].get());
+  }
+
+  std::vector<Layer*> layers_;
+  std::vector<InvalidationList> frames_;
+  size_t next_frame_;
+};
+
+TEST_F(LayerTreeHostPerfTestReplay, ReplaySingleThread) {
+  SetTestName("replay_single_thread");
+  ReadInputsFromCommandLine("10_10_layer_tree");
+  RunTest(false, false, false);
+}
+
+TEST_F(LayerTreeHostPerfTestReplay, ReplayThreadedImplSide) {
+  SetTestName("replay_threaded_impl_side");
+  ReadInputsFromCommandLine("10_10_layer_tree");
+  RunTestWithImplSidePainting();
+}
+
 // Simulates main-thread scrolling on each frame.
 class ScrollingLayerTreePerfTest : public LayerTreeHostPerfTestJsonReader {
  public:
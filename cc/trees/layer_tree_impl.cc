@@ -17,6 +17,7 @@
 #include "cc/resources/ui_resource_request.h"
 #include "cc/trees/layer_tree_host_common.h"
 #include "cc/trees/layer_tree_host_impl.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/size_conversions.h"
 #include "ui/gfx/vector2d_conversions.h"
 
@@ -479,24 +480,42 @@ void LayerTreeImpl::UpdateDrawProperties() {
                  IsActiveTree(),
                  "SourceFrameNumber",
                  source_frame_number_);
+    // Occlusion is only computed for the pending tree, since that is where
+    // new tiles are prioritized before they get rasterized.
+    scoped_ptr<OcclusionTrackerImpl> occlusion_tracker;
+    if (settings().use_occlusion_for_tile_prioritization && IsPendingTree()) {
+      occlusion_tracker.reset(new OcclusionTrackerImpl(
+          root_layer()->render_surface()->content_rect(), false));
+      occlusion_tracker->set_minimum_tracking_size(
+          settings().minimum_occlusion_tracking_size);
+    }
+
     // LayerIterator is used here instead of CallFunctionForSubtree to only
     // UpdateTilePriorities on layers that will be visible (and thus have valid
-    // draw properties) and not because any ordering is required.
+    // draw properties). It walks the layers front-to-back, which is the order
+    // the occlusion tracker needs.
     typedef LayerIterator<LayerImpl> LayerIteratorType;
     LayerIteratorType end = LayerIteratorType::End(&render_surface_layer_list_);
     for (LayerIteratorType it =
              LayerIteratorType::Begin(&render_surface_layer_list_);
          it != end;
          ++it) {
-      if (!it.represents_itself())
-        continue;
-      LayerImpl* layer = *it;
+      if (occlusion_tracker)
+        occlusion_tracker->EnterLayer(it);
 
-      layer->UpdateTilePriorities();
-      if (layer->mask_layer())
-        layer->mask_layer()->UpdateTilePriorities();
-      if (layer->replica_layer() && layer->replica_layer()->mask_layer())
-        layer->replica_layer()->mask_layer()->UpdateTilePriorities();
+      LayerImpl* layer = *it;
+      if (it.represents_itself()) {
+        layer->UpdateTilePriorities(occlusion_tracker.get());
+        // Mask layers are not visited by the iterator, so the occlusion
+        // tracker doesn't know about them.
+        if (layer->mask_layer())
+          layer->mask_layer()->UpdateTilePriorities(NULL);
+        if (layer->replica_layer() && layer->replica_layer()->mask_layer())
+          layer->replica_layer()->mask_layer()->UpdateTilePriorities(NULL);
+      }
+
+      if (occlusion_tracker)
+        occlusion_tracker->LeaveLayer(it);
     }
   }
 
@@ -680,6 +699,10 @@ bool LayerTreeImpl::PinchGestureActive() const {
   return layer_tree_host_impl_->pinch_gesture_active();
 }
 
+bool LayerTreeImpl::SmoothnessTakesPriority() const {
+  return layer_tree_host_impl_->tree_priority() == SMOOTHNESS_TAKES_PRIORITY;
+}
+
 base::TimeTicks LayerTreeImpl::CurrentFrameTimeTicks() const {
   return layer_tree_host_impl_->CurrentFrameTimeTicks();
 }
@@ -79,6 +79,7 @@ class CC_EXPORT LayerTreeImpl {
   LayerImpl* FindPendingTreeLayerById(int id);
   int MaxTextureSize() const;
   bool PinchGestureActive() const;
+  bool SmoothnessTakesPriority() const;
   base::TimeTicks CurrentFrameTimeTicks() const;
   base::Time CurrentFrameTime() const;
   base::TimeTicks CurrentPhysicalTimeTicks() const;
@@ -26,6 +26,7 @@ LayerTreeSettings::LayerTreeSettings()
       can_use_lcd_text(true),
       should_clear_root_render_pass(true),
       gpu_rasterization(false),
+      analyze_pictures_for_solid_color(true),
       scrollbar_animator(NoAnimator),
       scrollbar_linear_fade_delay_ms(300),
       scrollbar_linear_fade_length_ms(300),
@@ -45,6 +46,8 @@ LayerTreeSettings::LayerTreeSettings()
       default_tile_size(gfx::Size(256, 256)),
       max_untiled_layer_size(gfx::Size(512, 512)),
       minimum_occlusion_tracking_size(gfx::Size(160, 160)),
+      use_occlusion_for_tile_prioritization(false),
+      use_progressive_raster(false),
       use_pinch_zoom_scrollbars(false),
       use_pinch_virtual_viewport(false),
       // At 256x256 tiles, 128 tiles cover an area of 2048x4096 pixels.
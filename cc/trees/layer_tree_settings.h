@@ -31,6 +31,7 @@ class CC_EXPORT LayerTreeSettings {
   bool can_use_lcd_text;
   bool should_clear_root_render_pass;
   bool gpu_rasterization;
+  bool analyze_pictures_for_solid_color;
 
   enum ScrollbarAnimator {
     NoAnimator,
@@ -56,6 +57,8 @@ class CC_EXPORT LayerTreeSettings {
   gfx::Size default_tile_size;
   gfx::Size max_untiled_layer_size;
   gfx::Size minimum_occlusion_tracking_size;
+  bool use_occlusion_for_tile_prioritization;
+  bool use_progressive_raster;
   bool use_pinch_zoom_scrollbars;
   bool use_pinch_virtual_viewport;
   size_t max_tiles_for_interest_area;
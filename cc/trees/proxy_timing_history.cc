@@ -4,10 +4,15 @@
 
 #include "cc/trees/proxy_timing_history.h"
 
+#include "base/debug/trace_event.h"
+#include "base/metrics/histogram.h"
+
 const size_t kDurationHistorySize = 60;
 const double kCommitAndActivationDurationEstimationPercentile = 50.0;
 const double kDrawDurationEstimationPercentile = 100.0;
 const int kDrawDurationEstimatePaddingInMicroseconds = 0;
+// Swaps that are never acked should not grow the history without bound.
+const size_t kMaxPendingSwaps = 8;
 
 namespace cc {
 
@@ -43,24 +48,92 @@ void ProxyTimingHistory::DidBeginMainFrame() {
 
 void ProxyTimingHistory::DidCommit() {
   commit_complete_time_ = base::TimeTicks::HighResNow();
+  base::TimeDelta begin_main_frame_to_commit_duration =
+      commit_complete_time_ - begin_main_frame_sent_time_;
   begin_main_frame_to_commit_duration_history_.InsertSample(
-      commit_complete_time_ - begin_main_frame_sent_time_);
+      begin_main_frame_to_commit_duration);
+
+  UMA_HISTOGRAM_CUSTOM_TIMES("Renderer.BeginMainFrameToCommitDuration",
+                             begin_main_frame_to_commit_duration,
+                             base::TimeDelta::FromMilliseconds(1),
+                             base::TimeDelta::FromMilliseconds(100),
+                             50);
+  TRACE_COUNTER_ID1("cc",
+                    "BeginMainFrameToCommitDurationUs",
+                    this,
+                    begin_main_frame_to_commit_duration.InMicroseconds());
 }
 
 void ProxyTimingHistory::DidActivatePendingTree() {
+  activate_time_ = base::TimeTicks::HighResNow();
+  base::TimeDelta commit_to_activate_duration =
+      activate_time_ - commit_complete_time_;
   commit_to_activate_duration_history_.InsertSample(
-      base::TimeTicks::HighResNow() - commit_complete_time_);
+      commit_to_activate_duration);
+
+  UMA_HISTOGRAM_CUSTOM_TIMES("Renderer.CommitToActivateDuration",
+                             commit_to_activate_duration,
+                             base::TimeDelta::FromMilliseconds(1),
+                             base::TimeDelta::FromMilliseconds(100),
+                             50);
+  TRACE_COUNTER_ID1("cc",
+                    "CommitToActivateDurationUs",
+                    this,
+                    commit_to_activate_duration.InMicroseconds());
 }
 
 void ProxyTimingHistory::DidStartDrawing() {
   start_draw_time_ = base::TimeTicks::HighResNow();
+
+  // Only the first draw after an activation shows new content.
+  if (activate_time_.is_null())
+    return;
+  base::TimeDelta activate_to_draw_duration =
+      start_draw_time_ - activate_time_;
+  activate_time_ = base::TimeTicks();
+
+  UMA_HISTOGRAM_CUSTOM_TIMES("Renderer.ActivateToDrawDuration",
+                             activate_to_draw_duration,
+                             base::TimeDelta::FromMilliseconds(1),
+                             base::TimeDelta::FromMilliseconds(100),
+                             50);
+  TRACE_COUNTER_ID1("cc",
+                    "ActivateToDrawDurationUs",
+                    this,
+                    activate_to_draw_duration.InMicroseconds());
 }
 
 base::TimeDelta ProxyTimingHistory::DidFinishDrawing() {
   base::TimeDelta draw_duration =
       base::TimeTicks::HighResNow() - start_draw_time_;
   draw_duration_history_.InsertSample(draw_duration);
+  TRACE_COUNTER_ID1(
+      "cc", "DrawDurationUs", this, draw_duration.InMicroseconds());
   return draw_duration;
 }
 
+void ProxyTimingHistory::DidSwapBuffers() {
+  if (swap_times_.size() == kMaxPendingSwaps)
+    swap_times_.pop_front();
+  swap_times_.push_back(base::TimeTicks::HighResNow());
+}
+
+void ProxyTimingHistory::DidSwapBuffersComplete() {
+  if (swap_times_.empty())
+    return;
+  base::TimeDelta swap_to_ack_duration =
+      base::TimeTicks::HighResNow() - swap_times_.front();
+  swap_times_.pop_front();
+
+  UMA_HISTOGRAM_CUSTOM_TIMES("Renderer.SwapToSwapAckDuration",
+                             swap_to_ack_duration,
+                             base::TimeDelta::FromMilliseconds(1),
+                             base::TimeDelta::FromMilliseconds(100),
+                             50);
+  TRACE_COUNTER_ID1("cc",
+                    "SwapToSwapAckDurationUs",
+                    this,
+                    swap_to_ack_duration.InMicroseconds());
+}
+
 }  // namespace cc
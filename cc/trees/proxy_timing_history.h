@@ -5,10 +5,16 @@
 #ifndef CC_TREES_PROXY_TIMING_HISTORY_H_
 #define CC_TREES_PROXY_TIMING_HISTORY_H_
 
+#include <deque>
+
 #include "cc/base/rolling_time_delta_history.h"
 
 namespace cc {
 
+// Keeps estimates of how long each stage of the frame pipeline takes, for
+// scheduling decisions. Durations of the stages from BeginMainFrame through
+// the swap ack are also reported to UMA and as trace counters, so missed
+// frames can be attributed to a stage.
 class ProxyTimingHistory {
  public:
   ProxyTimingHistory();
@@ -24,6 +30,8 @@ class ProxyTimingHistory {
   void DidStartDrawing();
   // Returns draw duration.
   base::TimeDelta DidFinishDrawing();
+  void DidSwapBuffers();
+  void DidSwapBuffersComplete();
 
  protected:
   RollingTimeDeltaHistory draw_duration_history_;
@@ -32,7 +40,10 @@ class ProxyTimingHistory {
 
   base::TimeTicks begin_main_frame_sent_time_;
   base::TimeTicks commit_complete_time_;
+  base::TimeTicks activate_time_;
   base::TimeTicks start_draw_time_;
+  // Swaps that have not been acked yet, oldest first.
+  std::deque<base::TimeTicks> swap_times_;
 };
 
 }  // namespace cc
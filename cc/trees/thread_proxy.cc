@@ -439,6 +439,7 @@ void ThreadProxy::CheckOutputSurfaceStatusOnImplThread() {
 void ThreadProxy::OnSwapBuffersCompleteOnImplThread() {
   TRACE_EVENT0("cc", "ThreadProxy::OnSwapBuffersCompleteOnImplThread");
   DCHECK(IsImplThread());
+  impl().timing_history.DidSwapBuffersComplete();
   Proxy::MainThreadTaskRunner()->PostTask(
       FROM_HERE,
       base::Bind(&ThreadProxy::DidCompleteSwapBuffers, main_thread_weak_ptr_));
@@ -1245,6 +1246,7 @@ DrawSwapReadbackResult ThreadProxy::DrawSwapReadbackInternal(
     // We don't know if we have incomplete tiles if we didn't actually swap.
     if (result.did_swap) {
       DCHECK(!frame.has_no_damage);
+      impl().timing_history.DidSwapBuffers();
       SetSwapUsedIncompleteTileOnImplThread(frame.contains_incomplete_tile);
     }
   }
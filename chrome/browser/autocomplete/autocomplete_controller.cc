@@ -215,6 +215,17 @@ AutocompleteController::AutocompleteController(
 
   for (ACProviders::iterator i(providers_.begin()); i != providers_.end(); ++i)
     (*i)->AddRef();
+
+  // Look up the per-provider timing histograms once rather than building
+  // each name and taking the histogram registry lock on every keystroke.
+  // TODO(mpearson): Remove timing code once bugs 178705 / 237703 / 168933
+  // are resolved.
+  for (ACProviders::iterator i(providers_.begin()); i != providers_.end();
+       ++i) {
+    provider_time_histograms_.push_back(base::Histogram::FactoryGet(
+        std::string("Omnibox.ProviderTime.") + (*i)->GetName(), 1, 5000, 20,
+        base::Histogram::kUmaTargetedHistogramFlag));
+  }
 }
 
 AutocompleteController::~AutocompleteController() {
@@ -258,19 +269,15 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   in_zero_suggest_ = false;
   in_start_ = true;
   base::TimeTicks start_time = base::TimeTicks::Now();
-  for (ACProviders::iterator i(providers_.begin()); i != providers_.end();
-       ++i) {
+  for (size_t i = 0; i < providers_.size(); ++i) {
     // TODO(mpearson): Remove timing code once bugs 178705 / 237703 / 168933
     // are resolved.
     base::TimeTicks provider_start_time = base::TimeTicks::Now();
-    (*i)->Start(input_, minimal_changes);
+    providers_[i]->Start(input_, minimal_changes);
     if (input.matches_requested() != AutocompleteInput::ALL_MATCHES)
-      DCHECK((*i)->done());
+      DCHECK(providers_[i]->done());
     base::TimeTicks provider_end_time = base::TimeTicks::Now();
-    std::string name = std::string("Omnibox.ProviderTime.") + (*i)->GetName();
-    base::HistogramBase* counter = base::Histogram::FactoryGet(
-        name, 1, 5000, 20, base::Histogram::kUmaTargetedHistogramFlag);
-    counter->Add(static_cast<int>(
+    provider_time_histograms_[i]->Add(static_cast<int>(
         (provider_end_time - provider_start_time).InMilliseconds()));
   }
   if (input.matches_requested() == AutocompleteInput::ALL_MATCHES &&
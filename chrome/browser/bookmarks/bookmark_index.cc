@@ -119,24 +119,25 @@ void BookmarkIndex::SortMatches(const Matches& matches,
   history::URLDatabase* url_db = history_service ?
       history_service->InMemoryDatabase() : NULL;
 
+  // A node matched through several prefix terms appears in several matches.
+  // Eliminate the duplicates first so that each node's typed count is only
+  // looked up once.
+  NodeSet nodes;
   for (Matches::const_iterator i = matches.begin(); i != matches.end(); ++i)
-    ExtractBookmarkNodePairs(url_db, *i, node_typed_counts);
+    nodes.insert(i->nodes_begin(), i->nodes_end());
+
+  ExtractBookmarkNodePairs(url_db, nodes, node_typed_counts);
 
   std::sort(node_typed_counts->begin(), node_typed_counts->end(),
             &NodeTypedCountPairSortFunc);
-  // Eliminate duplicates.
-  node_typed_counts->erase(std::unique(node_typed_counts->begin(),
-                                       node_typed_counts->end()),
-                           node_typed_counts->end());
 }
 
 void BookmarkIndex::ExtractBookmarkNodePairs(
     history::URLDatabase* url_db,
-    const Match& match,
+    const NodeSet& nodes,
     NodeTypedCountPairs* node_typed_counts) const {
-
-  for (NodeSet::const_iterator i = match.nodes_begin();
-       i != match.nodes_end(); ++i) {
+  node_typed_counts->reserve(node_typed_counts->size() + nodes.size());
+  for (NodeSet::const_iterator i = nodes.begin(); i != nodes.end(); ++i) {
     history::URLRow url;
     if (url_db)
       url_db->GetRowForURL((*i)->url(), &url);
@@ -208,6 +208,15 @@ TEST_F(BookmarkIndexTest, ChangeTitle) {
   ExpectMatches("BlAh", expected, ARRAYSIZE_UNSAFE(expected));
 }
 
+// Makes sure a node whose title matches through more than one prefix term is
+// only returned once.
+TEST_F(BookmarkIndexTest, NoDuplicatesForSeveralMatchingTerms) {
+  const char* input[] = { "abcd abcf", "abce" };
+  AddBookmarksWithTitles(input, ARRAYSIZE_UNSAFE(input));
+
+  ExpectMatches("abc", input, ARRAYSIZE_UNSAFE(input));
+}
+
 // Makes sure no more than max queries is returned.
 TEST_F(BookmarkIndexTest, HonorMax) {
   const char* input[] = { "abcd", "abcde" };
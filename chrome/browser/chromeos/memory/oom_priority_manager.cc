@@ -14,6 +14,7 @@
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/command_line.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/process/process.h"
@@ -406,6 +407,10 @@ void OomPriorityManager::PurgeBrowserMemory() {
     // touch back/forward.
     web_contents->GetController().ClearAllScreenshots();
   }
+  // Let the browser's own caches, such as the history backend's and
+  // discardable memory, drop what they can before a tab has to go.
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_CRITICAL);
   // TODO(jamescook): Are there other things we could flush? Drive metadata?
 }
 
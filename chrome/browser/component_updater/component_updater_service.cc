@@ -247,6 +247,8 @@ class CrxUpdateService : public ComponentUpdateService {
 
   bool HasOnDemandItems() const;
 
+  StepDelayInterval UpdateCompleteDelay() const;
+
   void OnNewResourceThrottle(base::WeakPtr<CUResourceThrottle> rt,
                              const std::string& crx_id);
 
@@ -335,12 +337,20 @@ bool CrxUpdateService::HasOnDemandItems() const {
                       Helper::IsOnDemand) != work_items_.end();
 }
 
+// Returns the delay to wait after a component update has finished. Other
+// components found to have updates by the same check are applied right away,
+// instead of spacing the updates of a cycle out by a medium delay each.
+CrxUpdateService::StepDelayInterval
+CrxUpdateService::UpdateCompleteDelay() const {
+  return FindReadyComponent() ? kStepDelayShort : kStepDelayMedium;
+}
+
 // This function sets the timer which will call ProcessPendingItems() or
 // ProcessRequestedItem() if there is an on_demand item.  There
 // are three kinds of waits:
-//  - a short delay, when there is immediate work to be done.
-//  - a medium delay, when there are updates to be applied within the current
-//    update cycle, or there are components that are still unchecked.
+//  - a short delay, when there is immediate work to be done, such as further
+//    updates to be applied within the current update cycle.
+//  - a medium delay, when there are components that are still unchecked.
 //  - a long delay when a full check/update cycle has completed for all
 //    components.
 void CrxUpdateService::ScheduleNextRun(StepDelayInterval step_delay) {
@@ -825,7 +835,7 @@ void CrxUpdateService::DownloadComplete(
     ping_manager_->OnUpdateComplete(crx);
 
     // Move on to the next update, if there is one available.
-    ScheduleNextRun(kStepDelayMedium);
+    ScheduleNextRun(UpdateCompleteDelay());
   } else {
     size_t count = 0;
     if (crx->status == CrxUpdateItem::kDownloadingDiff) {
@@ -931,7 +941,7 @@ void CrxUpdateService::DoneInstalling(const std::string& component_id,
   ping_manager_->OnUpdateComplete(item);
 
   // Move on to the next update, if there is one available.
-  ScheduleNextRun(kStepDelayMedium);
+  ScheduleNextRun(UpdateCompleteDelay());
 }
 
 void CrxUpdateService::NotifyComponentObservers(
@@ -500,6 +500,92 @@ TEST_F(ComponentUpdaterTest, InstallCrx) {
   component_updater()->Stop();
 }
 
+// Two components get updates from the same check. The second update is
+// applied right after the first, and the updater only goes to sleep, which
+// it does on every medium or long delay, once both are done. With a loop
+// count of one, a medium delay between the two updates would end the test
+// before the second one is installed.
+TEST_F(ComponentUpdaterTest, InstallTwoCrxFoundInOneCheck) {
+  MockComponentObserver observer1;
+  {
+    InSequence seq;
+    EXPECT_CALL(observer1,
+                OnEvent(ComponentObserver::COMPONENT_UPDATER_STARTED, 0))
+                .Times(1);
+    EXPECT_CALL(observer1,
+                OnEvent(ComponentObserver::COMPONENT_UPDATE_FOUND, 0))
+                .Times(1);
+    EXPECT_CALL(observer1,
+                OnEvent(ComponentObserver::COMPONENT_UPDATE_READY, 0))
+                .Times(1);
+    EXPECT_CALL(observer1,
+                OnEvent(ComponentObserver::COMPONENT_UPDATED, 0))
+                .Times(1);
+    EXPECT_CALL(observer1,
+                OnEvent(ComponentObserver::COMPONENT_UPDATER_SLEEPING, 0))
+                .Times(1);
+  }
+
+  MockComponentObserver observer2;
+  {
+    InSequence seq;
+    EXPECT_CALL(observer2,
+                OnEvent(ComponentObserver::COMPONENT_UPDATER_STARTED, 0))
+                .Times(1);
+    EXPECT_CALL(observer2,
+                OnEvent(ComponentObserver::COMPONENT_UPDATE_FOUND, 0))
+                .Times(1);
+    EXPECT_CALL(observer2,
+                OnEvent(ComponentObserver::COMPONENT_UPDATE_READY, 0))
+                .Times(1);
+    EXPECT_CALL(observer2,
+                OnEvent(ComponentObserver::COMPONENT_UPDATED, 0))
+                .Times(1);
+    EXPECT_CALL(observer2,
+                OnEvent(ComponentObserver::COMPONENT_UPDATER_SLEEPING, 0))
+                .Times(1);
+  }
+
+  EXPECT_TRUE(post_interceptor_->ExpectRequest(new PartialMatch(
+      "updatecheck"), test_file("updatecheck_reply_two_updates.xml")));
+  EXPECT_TRUE(post_interceptor_->ExpectRequest(new PartialMatch("event")));
+  EXPECT_TRUE(post_interceptor_->ExpectRequest(new PartialMatch("event")));
+
+  get_interceptor_->SetResponse(
+      GURL(expected_crx_url),
+      test_file("jebgalgnebhfojomionfpkfelancnnkf.crx"));
+  get_interceptor_->SetResponse(
+      GURL("http://localhost/download/ihfokbkgjpifnbbojhneepfflplebdkc_1.crx"),
+      test_file("ihfokbkgjpifnbbojhneepfflplebdkc_1.crx"));
+
+  TestInstaller installer1;
+  CrxComponent com1;
+  com1.observer = &observer1;
+  RegisterComponent(&com1, kTestComponent_jebg, Version("0.9"), &installer1);
+  VersionedTestInstaller installer2;
+  CrxComponent com2;
+  com2.observer = &observer2;
+  RegisterComponent(&com2, kTestComponent_ihfo, Version("0.0"), &installer2);
+
+  test_configurator()->SetLoopCount(1);
+  component_updater()->Start();
+  RunThreads();
+
+  EXPECT_EQ(0, static_cast<TestInstaller*>(com1.installer)->error());
+  EXPECT_EQ(1, static_cast<TestInstaller*>(com1.installer)->install_count());
+  EXPECT_EQ(0, static_cast<TestInstaller*>(com2.installer)->error());
+  EXPECT_EQ(1, static_cast<TestInstaller*>(com2.installer)->install_count());
+
+  // Expect one update check and a ping for each update.
+  EXPECT_EQ(3, post_interceptor_->GetHitCount())
+      << post_interceptor_->GetRequestsAsString();
+  EXPECT_EQ(3, post_interceptor_->GetCount())
+      << post_interceptor_->GetRequestsAsString();
+  EXPECT_EQ(2, get_interceptor_->GetHitCount());
+
+  component_updater()->Stop();
+}
+
 // This test checks that the "prodversionmin" value is handled correctly. In
 // particular there should not be an install because the minimum product
 // version is much higher than of chrome.
@@ -12,6 +12,7 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/values.h"
 #include "chrome/browser/chrome_notification_types.h"
 #include "chrome/browser/content_settings/content_settings_custom_extension_provider.h"
 #include "chrome/browser/content_settings/content_settings_default_provider.h"
@@ -73,8 +74,60 @@ bool SupportsResourceIdentifier(ContentSettingsType content_type) {
   return content_type == CONTENT_SETTINGS_TYPE_PLUGINS;
 }
 
+// The number of GetWebsiteSetting() results kept in the lookup cache.
+const size_t kSettingCacheSize = 1000;
+
+// Sets |origin| to the part of |url| that decides which patterns match it.
+// Returns false if lookups for |url| can't be shared with other URLs, e.g.
+// because patterns look at the path of file: URLs.
+bool GetSettingCacheOrigin(const GURL& url, std::string* origin) {
+  if (url.is_empty()) {
+    origin->clear();
+    return true;
+  }
+  if (!url.is_valid() || !url.SchemeIsHTTPOrHTTPS())
+    return false;
+  *origin = url.GetOrigin().spec();
+  return true;
+}
+
 }  // namespace
 
+HostContentSettingsMap::SettingCacheKey::SettingCacheKey(
+    const std::string& primary_origin,
+    const std::string& secondary_origin,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier)
+    : primary_origin(primary_origin),
+      secondary_origin(secondary_origin),
+      content_type(content_type),
+      resource_identifier(resource_identifier) {
+}
+
+HostContentSettingsMap::SettingCacheKey::~SettingCacheKey() {
+}
+
+bool HostContentSettingsMap::SettingCacheKey::operator<(
+    const SettingCacheKey& other) const {
+  if (content_type != other.content_type)
+    return content_type < other.content_type;
+  if (primary_origin != other.primary_origin)
+    return primary_origin < other.primary_origin;
+  if (secondary_origin != other.secondary_origin)
+    return secondary_origin < other.secondary_origin;
+  return resource_identifier < other.resource_identifier;
+}
+
+HostContentSettingsMap::CachedSetting::CachedSetting(
+    base::Value* value,
+    const content_settings::SettingInfo& info)
+    : value(value),
+      info(info) {
+}
+
+HostContentSettingsMap::CachedSetting::~CachedSetting() {
+}
+
 HostContentSettingsMap::HostContentSettingsMap(
     PrefService* prefs,
     bool incognito) :
@@ -82,7 +135,9 @@ HostContentSettingsMap::HostContentSettingsMap(
       used_from_thread_id_(base::PlatformThread::CurrentId()),
 #endif
       prefs_(prefs),
-      is_off_the_record_(incognito) {
+      is_off_the_record_(incognito),
+      setting_cache_(kSettingCacheSize),
+      setting_cache_generation_(0) {
   content_settings::ObservableProvider* policy_provider =
       new content_settings::PolicyProvider(prefs_);
   policy_provider->AddObserver(this);
@@ -125,6 +180,9 @@ void HostContentSettingsMap::RegisterExtensionService(
   content_settings_providers_[CUSTOM_EXTENSION_PROVIDER] =
       custom_extension_provider;
 
+  // Lookups cached so far didn't consult the extension providers.
+  ClearSettingCache();
+
 #ifndef NDEBUG
   DCHECK(used_from_thread_id_ != base::kInvalidThreadId)
       << "Used from multiple threads before initialization complete.";
@@ -418,6 +476,7 @@ void HostContentSettingsMap::OnContentSettingChanged(
     const ContentSettingsPattern& secondary_pattern,
     ContentSettingsType content_type,
     std::string resource_identifier) {
+  ClearSettingCache();
   const ContentSettingsDetails details(primary_pattern,
                                        secondary_pattern,
                                        content_type,
@@ -442,6 +501,7 @@ void HostContentSettingsMap::ShutdownOnUIThread() {
        ++it) {
     it->second->ShutdownOnUIThread();
   }
+  ClearSettingCache();
 }
 
 void HostContentSettingsMap::MigrateObsoleteClearOnExitPref() {
@@ -587,6 +647,57 @@ base::Value* HostContentSettingsMap::GetWebsiteSetting(
     return base::Value::CreateIntegerValue(CONTENT_SETTING_ALLOW);
   }
 
+  std::string primary_origin;
+  std::string secondary_origin;
+  if (!GetSettingCacheOrigin(primary_url, &primary_origin) ||
+      !GetSettingCacheOrigin(secondary_url, &secondary_origin)) {
+    return GetWebsiteSettingFromProviders(primary_url, secondary_url,
+                                          content_type, resource_identifier,
+                                          info);
+  }
+
+  SettingCacheKey key(primary_origin, secondary_origin, content_type,
+                      resource_identifier);
+  uint64 generation;
+  {
+    base::AutoLock lock(setting_cache_lock_);
+    SettingCache::iterator it = setting_cache_.Get(key);
+    if (it != setting_cache_.end()) {
+      const CachedSetting* cached = it->second;
+      if (info)
+        *info = cached->info;
+      return cached->value ? cached->value->DeepCopy() : NULL;
+    }
+    generation = setting_cache_generation_;
+  }
+
+  content_settings::SettingInfo setting_info;
+  base::Value* value = GetWebsiteSettingFromProviders(
+      primary_url, secondary_url, content_type, resource_identifier,
+      &setting_info);
+  if (info)
+    *info = setting_info;
+
+  base::AutoLock lock(setting_cache_lock_);
+  if (generation == setting_cache_generation_) {
+    setting_cache_.Put(
+        key, new CachedSetting(value ? value->DeepCopy() : NULL, setting_info));
+  }
+  return value;
+}
+
+void HostContentSettingsMap::ClearSettingCache() {
+  base::AutoLock lock(setting_cache_lock_);
+  setting_cache_.Clear();
+  ++setting_cache_generation_;
+}
+
+base::Value* HostContentSettingsMap::GetWebsiteSettingFromProviders(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier,
+    content_settings::SettingInfo* info) const {
   ContentSettingsPattern* primary_pattern = NULL;
   ContentSettingsPattern* secondary_pattern = NULL;
   if (info) {
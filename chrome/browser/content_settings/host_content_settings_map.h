@@ -13,8 +13,11 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/prefs/pref_change_registrar.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/platform_thread.h"
 #include "base/tuple.h"
 #include "chrome/browser/content_settings/content_settings_observer.h"
@@ -208,8 +211,52 @@ class HostContentSettingsMap
   typedef ProviderMap::iterator ProviderIterator;
   typedef ProviderMap::const_iterator ConstProviderIterator;
 
+  // Identifies a GetWebsiteSetting() lookup in |setting_cache_|.  The URLs are
+  // reduced to their origins, which is all the patterns look at for the URLs
+  // that are cached.
+  struct SettingCacheKey {
+    SettingCacheKey(const std::string& primary_origin,
+                    const std::string& secondary_origin,
+                    ContentSettingsType content_type,
+                    const std::string& resource_identifier);
+    ~SettingCacheKey();
+
+    bool operator<(const SettingCacheKey& other) const;
+
+    std::string primary_origin;
+    std::string secondary_origin;
+    ContentSettingsType content_type;
+    std::string resource_identifier;
+  };
+
+  // The result of a GetWebsiteSetting() lookup.  |value| is NULL if no
+  // provider had a setting.
+  struct CachedSetting {
+    CachedSetting(base::Value* value,
+                  const content_settings::SettingInfo& info);
+    ~CachedSetting();
+
+    scoped_ptr<base::Value> value;
+    content_settings::SettingInfo info;
+  };
+
+  typedef base::OwningMRUCache<SettingCacheKey, CachedSetting*> SettingCache;
+
   virtual ~HostContentSettingsMap();
 
+  // Asks the providers, in order of precedence, for the setting of
+  // |content_type| between the given URLs.  Does not use |setting_cache_|.
+  base::Value* GetWebsiteSettingFromProviders(
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      ContentSettingsType content_type,
+      const std::string& resource_identifier,
+      content_settings::SettingInfo* info) const;
+
+  // Drops all cached lookups, including the results of lookups that are
+  // still in flight on other threads.
+  void ClearSettingCache();
+
   ContentSetting GetDefaultContentSettingFromProvider(
       ContentSettingsType content_type,
       content_settings::ProviderInterface* provider) const;
@@ -257,6 +304,16 @@ class HostContentSettingsMap
   // before any other uses of it.
   ProviderMap content_settings_providers_;
 
+  // Recently looked up settings, so that the frequent queries for the same
+  // pair of origins (e.g. the cookie checks for every request of a page)
+  // don't each walk all the rules of every provider.  Cleared whenever a
+  // provider reports a change.  Guarded by |setting_cache_lock_|, as is
+  // |setting_cache_generation_|, which is bumped on every clear so that a
+  // lookup that raced with a change doesn't cache its stale result.
+  mutable base::Lock setting_cache_lock_;
+  mutable SettingCache setting_cache_;
+  uint64 setting_cache_generation_;
+
   DISALLOW_COPY_AND_ASSIGN(HostContentSettingsMap);
 };
 
@@ -10,9 +10,13 @@
 #include "base/prefs/pref_service.h"
 #include "base/prefs/scoped_user_pref_update.h"
 #include "chrome/browser/content_settings/content_settings_details.h"
+#include "chrome/browser/content_settings/content_settings_utils.h"
 #include "chrome/browser/content_settings/cookie_settings.h"
 #include "chrome/browser/content_settings/host_content_settings_map.h"
 #include "chrome/browser/content_settings/mock_settings_observer.h"
+#include "chrome/browser/extensions/api/content_settings/content_settings_store.h"
+#include "chrome/browser/extensions/extension_service.h"
+#include "chrome/browser/extensions/test_extension_system.h"
 #include "chrome/common/chrome_switches.h"
 #include "chrome/common/pref_names.h"
 #include "chrome/common/url_constants.h"
@@ -982,3 +986,92 @@ TEST_F(HostContentSettingsMapTest, MigrateClearOnExit) {
                 CONTENT_SETTINGS_TYPE_COOKIES,
                 std::string()));
 }
+
+// Tests that lookups answered from the cache of recent lookups still see
+// changes, including ones made to the preferences directly.
+TEST_F(HostContentSettingsMapTest, CachedLookups) {
+  TestingProfile profile;
+  HostContentSettingsMap* host_content_settings_map =
+      profile.GetHostContentSettingsMap();
+
+  GURL host("http://example.com/");
+  GURL same_origin("http://example.com/other/path?query");
+  ContentSettingsPattern pattern =
+      ContentSettingsPattern::FromString("[*.]example.com");
+
+  content_settings::SettingInfo info;
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            host_content_settings_map->GetContentSetting(
+                host, host, CONTENT_SETTINGS_TYPE_COOKIES, std::string()));
+  host_content_settings_map->SetContentSetting(
+      pattern,
+      ContentSettingsPattern::Wildcard(),
+      CONTENT_SETTINGS_TYPE_COOKIES,
+      std::string(),
+      CONTENT_SETTING_BLOCK);
+  for (int i = 0; i < 2; ++i) {
+    scoped_ptr<base::Value> value(host_content_settings_map->GetWebsiteSetting(
+        same_origin, host, CONTENT_SETTINGS_TYPE_COOKIES, std::string(),
+        &info));
+    EXPECT_EQ(CONTENT_SETTING_BLOCK,
+              content_settings::ValueToContentSetting(value.get()));
+    EXPECT_EQ(content_settings::SETTING_SOURCE_USER, info.source);
+    EXPECT_EQ(pattern, info.primary_pattern);
+    EXPECT_EQ(ContentSettingsPattern::Wildcard(), info.secondary_pattern);
+  }
+
+  scoped_ptr<base::Value> patterns(base::JSONReader::Read(
+      "{\"[*.]example.com,*\":{\"cookies\": 4}}"));
+  profile.GetPrefs()->Set(prefs::kContentSettingsPatternPairs, *patterns);
+  EXPECT_EQ(CONTENT_SETTING_SESSION_ONLY,
+            host_content_settings_map->GetContentSetting(
+                host, host, CONTENT_SETTINGS_TYPE_COOKIES, std::string()));
+
+  profile.GetPrefs()->ClearPref(prefs::kContentSettingsPatternPairs);
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            host_content_settings_map->GetContentSetting(
+                host, host, CONTENT_SETTINGS_TYPE_COOKIES, std::string()));
+}
+
+#if defined(ENABLE_EXTENSIONS)
+// Tests that lookups cached before the extension providers are registered
+// don't hide the settings of extensions afterwards.
+TEST_F(HostContentSettingsMapTest, CachedLookupsAndExtensionService) {
+  TestingProfile profile;
+  // The map is created before the ExtensionService, so the profile doesn't
+  // register it.
+  HostContentSettingsMap* host_content_settings_map =
+      profile.GetHostContentSettingsMap();
+
+  GURL host("http://example.com/");
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            host_content_settings_map->GetContentSetting(
+                host, host, CONTENT_SETTINGS_TYPE_COOKIES, std::string()));
+
+  CommandLine command_line(CommandLine::NO_PROGRAM);
+  ExtensionService* extension_service =
+      static_cast<extensions::TestExtensionSystem*>(
+          extensions::ExtensionSystem::Get(&profile))->CreateExtensionService(
+              &command_line, base::FilePath(), false);
+  extensions::ContentSettingsStore* store =
+      extension_service->GetContentSettingsStore();
+  const std::string kExtensionId("abcdefghijklmnopabcdefghijklmnop");
+  store->RegisterExtension(kExtensionId, base::Time::Now(), true);
+  store->SetExtensionContentSetting(
+      kExtensionId,
+      ContentSettingsPattern::FromString("[*.]example.com"),
+      ContentSettingsPattern::Wildcard(),
+      CONTENT_SETTINGS_TYPE_COOKIES,
+      std::string(),
+      CONTENT_SETTING_BLOCK,
+      extensions::kExtensionPrefsScopeRegular);
+
+  host_content_settings_map->RegisterExtensionService(extension_service);
+  content_settings::SettingInfo info;
+  scoped_ptr<base::Value> value(host_content_settings_map->GetWebsiteSetting(
+      host, host, CONTENT_SETTINGS_TYPE_COOKIES, std::string(), &info));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            content_settings::ValueToContentSetting(value.get()));
+  EXPECT_EQ(content_settings::SETTING_SOURCE_EXTENSION, info.source);
+}
+#endif
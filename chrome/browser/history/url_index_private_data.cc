@@ -77,6 +77,26 @@ bool LengthGreater(const base::string16& string_a,
   return string_a.length() > string_b.length();
 }
 
+// Comparison function for sorting word sets by ascending size.
+bool WordIDSetSmaller(const WordIDSet* set_a, const WordIDSet* set_b) {
+  return set_a->size() < set_b->size();
+}
+
+// Removes the items of |*set| that are not in |other|.  This only walks
+// |*set|, so it is much cheaper than std::set_intersection() when |*set| is
+// the smaller one, as is usual once the first few terms have narrowed down
+// the candidates.
+template <typename T>
+void IntersectInto(std::set<T>* set, const std::set<T>& other) {
+  for (typename std::set<T>::iterator iter = set->begin();
+       iter != set->end(); ) {
+    if (other.find(*iter) == other.end())
+      set->erase(iter++);
+    else
+      ++iter;
+  }
+}
+
 
 // UpdateRecentVisitsFromHistoryDBTask -----------------------------------------
 
@@ -536,12 +556,11 @@ HistoryIDSet URLIndexPrivateData::HistoryIDSetFromWords(
     if (iter == words.begin()) {
       history_id_set.swap(term_history_set);
     } else {
-      HistoryIDSet new_history_id_set;
-      std::set_intersection(history_id_set.begin(), history_id_set.end(),
-                            term_history_set.begin(), term_history_set.end(),
-                            std::inserter(new_history_id_set,
-                                          new_history_id_set.begin()));
-      history_id_set.swap(new_history_id_set);
+      if (term_history_set.size() < history_id_set.size())
+        history_id_set.swap(term_history_set);
+      IntersectInto(&history_id_set, term_history_set);
+      if (history_id_set.empty())
+        break;
     }
   }
   return history_id_set;
@@ -611,12 +630,9 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
       if (prefix_chars.empty()) {
         word_id_set.swap(leftover_set);
       } else {
-        WordIDSet new_word_id_set;
-        std::set_intersection(word_id_set.begin(), word_id_set.end(),
-                              leftover_set.begin(), leftover_set.end(),
-                              std::inserter(new_word_id_set,
-                                            new_word_id_set.begin()));
-        word_id_set.swap(new_word_id_set);
+        if (leftover_set.size() < word_id_set.size())
+          word_id_set.swap(leftover_set);
+        IntersectInto(&word_id_set, leftover_set);
       }
     }
 
@@ -659,35 +675,30 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
 
 WordIDSet URLIndexPrivateData::WordIDSetForTermChars(
     const Char16Set& term_chars) {
-  WordIDSet word_id_set;
+  std::vector<const WordIDSet*> char_word_id_sets;
   for (Char16Set::const_iterator c_iter = term_chars.begin();
        c_iter != term_chars.end(); ++c_iter) {
     CharWordIDMap::iterator char_iter = char_word_map_.find(*c_iter);
-    if (char_iter == char_word_map_.end()) {
-      // A character was not found so there are no matching results: bail.
-      word_id_set.clear();
-      break;
-    }
-    WordIDSet& char_word_id_set(char_iter->second);
+    // A character was not found so there are no matching results: bail.
+    if (char_iter == char_word_map_.end())
+      return WordIDSet();
     // It is possible for there to no longer be any words associated with
     // a particular character. Give up in that case.
-    if (char_word_id_set.empty()) {
-      word_id_set.clear();
-      break;
-    }
-
-    if (c_iter == term_chars.begin()) {
-      // First character results becomes base set of results.
-      word_id_set = char_word_id_set;
-    } else {
-      // Subsequent character results get intersected in.
-      WordIDSet new_word_id_set;
-      std::set_intersection(word_id_set.begin(), word_id_set.end(),
-                            char_word_id_set.begin(), char_word_id_set.end(),
-                            std::inserter(new_word_id_set,
-                                          new_word_id_set.begin()));
-      word_id_set.swap(new_word_id_set);
-    }
+    if (char_iter->second.empty())
+      return WordIDSet();
+    char_word_id_sets.push_back(&char_iter->second);
+  }
+  if (char_word_id_sets.empty())
+    return WordIDSet();
+
+  // Start from the rarest character, so that common ones such as vowels only
+  // get probed rather than copied.
+  std::sort(char_word_id_sets.begin(), char_word_id_sets.end(),
+            WordIDSetSmaller);
+  WordIDSet word_id_set(*char_word_id_sets[0]);
+  for (size_t i = 1; i < char_word_id_sets.size() && !word_id_set.empty();
+       ++i) {
+    IntersectInto(&word_id_set, *char_word_id_sets[i]);
   }
   return word_id_set;
 }
@@ -1080,6 +1091,7 @@ bool URLIndexPrivateData::RestoreWordList(
   if (actual_item_count == 0 || actual_item_count != expected_item_count)
     return false;
   const RepeatedPtrField<std::string>& words(list_item.word());
+  word_list_.reserve(actual_item_count);
   for (RepeatedPtrField<std::string>::const_iterator iter = words.begin();
        iter != words.end(); ++iter)
     word_list_.push_back(base::UTF8ToUTF16(*iter));
@@ -1096,9 +1108,13 @@ bool URLIndexPrivateData::RestoreWordMap(
   if (actual_item_count == 0 || actual_item_count != expected_item_count)
     return false;
   const RepeatedPtrField<WordMapEntry>& entries(list_item.word_map_entry());
+  // The maps and sets below were saved in order, so restoring them with
+  // end() as the insertion hint costs amortized constant time per item.
   for (RepeatedPtrField<WordMapEntry>::const_iterator iter = entries.begin();
-       iter != entries.end(); ++iter)
-    word_map_[base::UTF8ToUTF16(iter->word())] = iter->word_id();
+       iter != entries.end(); ++iter) {
+    word_map_.insert(word_map_.end(), WordMap::value_type(
+        base::UTF8ToUTF16(iter->word()), iter->word_id()));
+  }
   return true;
 }
 
@@ -1120,12 +1136,11 @@ bool URLIndexPrivateData::RestoreCharWordMap(
     if (actual_item_count == 0 || actual_item_count != expected_item_count)
       return false;
     base::char16 uni_char = static_cast<base::char16>(iter->char_16());
-    WordIDSet word_id_set;
+    WordIDSet& word_id_set(char_word_map_[uni_char]);
     const RepeatedField<int32>& word_ids(iter->word_id());
     for (RepeatedField<int32>::const_iterator jiter = word_ids.begin();
          jiter != word_ids.end(); ++jiter)
-      word_id_set.insert(*jiter);
-    char_word_map_[uni_char] = word_id_set;
+      word_id_set.insert(word_id_set.end(), *jiter);
   }
   return true;
 }
@@ -1148,14 +1163,15 @@ bool URLIndexPrivateData::RestoreWordIDHistoryMap(
     if (actual_item_count == 0 || actual_item_count != expected_item_count)
       return false;
     WordID word_id = iter->word_id();
-    HistoryIDSet history_id_set;
+    HistoryIDSet& history_id_set(word_id_history_map_[word_id]);
     const RepeatedField<int64>& history_ids(iter->history_id());
     for (RepeatedField<int64>::const_iterator jiter = history_ids.begin();
          jiter != history_ids.end(); ++jiter) {
-      history_id_set.insert(*jiter);
-      AddToHistoryIDWordMap(*jiter, word_id);
+      history_id_set.insert(history_id_set.end(), *jiter);
+      // Word IDs arrive in increasing order for every history ID too.
+      WordIDSet& word_id_set(history_id_word_map_[*jiter]);
+      word_id_set.insert(word_id_set.end(), word_id);
     }
-    word_id_history_map_[word_id] = history_id_set;
   }
   return true;
 }
@@ -1183,10 +1199,11 @@ bool URLIndexPrivateData::RestoreHistoryInfoMap(
       base::string16 title(base::UTF8ToUTF16(iter->title()));
       url_row.set_title(title);
     }
-    history_info_map_[history_id].url_row = url_row;
+    HistoryInfoMapValue& value(history_info_map_[history_id]);
+    value.url_row = url_row;
 
     // Restore visits list.
-    VisitInfoVector visits;
+    VisitInfoVector& visits(value.visits);
     visits.reserve(iter->visits_size());
     for (int i = 0; i < iter->visits_size(); ++i) {
       visits.push_back(std::make_pair(
@@ -1194,7 +1211,6 @@ bool URLIndexPrivateData::RestoreHistoryInfoMap(
           static_cast<content::PageTransition>(iter->visits(i).
                                                transition_type())));
     }
-    history_info_map_[history_id].visits = visits;
   }
   return true;
 }
@@ -1216,18 +1232,15 @@ bool URLIndexPrivateData::RestoreWordStartsMap(
     for (RepeatedPtrField<WordStartsMapEntry>::const_iterator iter =
          entries.begin(); iter != entries.end(); ++iter) {
       HistoryID history_id = iter->history_id();
-      RowWordStarts word_starts;
+      RowWordStarts& word_starts(word_starts_map_[history_id]);
       // Restore the URL word starts.
       const RepeatedField<int32>& url_starts(iter->url_word_starts());
-      for (RepeatedField<int32>::const_iterator jiter = url_starts.begin();
-           jiter != url_starts.end(); ++jiter)
-        word_starts.url_word_starts_.push_back(*jiter);
+      word_starts.url_word_starts_.assign(url_starts.begin(),
+                                          url_starts.end());
       // Restore the page title word starts.
       const RepeatedField<int32>& title_starts(iter->title_word_starts());
-      for (RepeatedField<int32>::const_iterator jiter = title_starts.begin();
-           jiter != title_starts.end(); ++jiter)
-        word_starts.title_word_starts_.push_back(*jiter);
-      word_starts_map_[history_id] = word_starts;
+      word_starts.title_word_starts_.assign(title_starts.begin(),
+                                            title_starts.end());
     }
   } else {
     // Since the cache did not contain any word starts we must rebuild then from
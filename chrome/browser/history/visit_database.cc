@@ -8,6 +8,7 @@
 #include <limits>
 #include <map>
 #include <set>
+#include <string>
 
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
@@ -204,6 +205,59 @@ void VisitDatabase::DeleteVisit(const VisitRow& visit) {
   del.Run();
 }
 
+void VisitDatabase::DeleteVisits(const VisitVector& visits) {
+  if (visits.empty())
+    return;
+
+  std::map<VisitID, VisitID> deleted;  // Deleted visit -> its referrer.
+  for (size_t i = 0; i < visits.size(); i++)
+    deleted[visits[i].visit_id] = visits[i].referring_visit;
+
+  // Patch around the deleted visits. Following the referrers of each deleted
+  // visit until we leave the deleted set means a run of deleted visits in a
+  // chain collapses onto the visit before it, whatever order they come in.
+  sql::Statement update_chain(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "UPDATE visits SET from_visit=? WHERE from_visit=?"));
+  for (std::map<VisitID, VisitID>::const_iterator i = deleted.begin();
+       i != deleted.end(); ++i) {
+    VisitID source = i->second;
+    std::map<VisitID, VisitID>::const_iterator next = deleted.find(source);
+    // Bounded by the set size in case the referrers form a loop.
+    for (size_t steps = 0; next != deleted.end() && steps < deleted.size();
+         ++steps) {
+      source = next->second;
+      next = deleted.find(source);
+    }
+    if (next != deleted.end())
+      source = 0;
+
+    update_chain.Reset(true);
+    update_chain.BindInt64(0, source);
+    update_chain.BindInt64(1, i->first);
+    if (!update_chain.Run())
+      return;
+  }
+
+  // Now delete the visits and their sources, in batches to bound the length
+  // of the statements. Browsed visits have no visit_source row, so nothing is
+  // deleted from that table for them.
+  const size_t batch_size = 500;
+  std::map<VisitID, VisitID>::const_iterator it = deleted.begin();
+  while (it != deleted.end()) {
+    std::string ids;
+    for (size_t j = 0; j < batch_size && it != deleted.end(); ++j, ++it) {
+      if (!ids.empty())
+        ids.push_back(',');
+      ids.append(base::Int64ToString(it->first));
+    }
+    if (!GetDB().Execute(("DELETE FROM visits WHERE id IN (" + ids +
+                          ")").c_str()))
+      return;
+    GetDB().Execute(("DELETE FROM visit_source WHERE id IN (" + ids +
+                     ")").c_str());
+  }
+}
+
 bool VisitDatabase::GetRowForVisit(VisitID visit_id, VisitRow* out_visit) {
   sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "SELECT" HISTORY_VISIT_ROW_FIELDS "FROM visits WHERE id=?"));
@@ -45,6 +45,12 @@ class VisitDatabase {
   // doesn't exist, it will not do anything.
   void DeleteVisit(const VisitRow& visit);
 
+  // Deletes all of the given visits, like calling DeleteVisit() for each, but
+  // removes the rows with a few batched statements instead of one per visit.
+  // Visits that came from a deleted visit are patched to come from the
+  // nearest visit in the chain that isn't being deleted.
+  void DeleteVisits(const VisitVector& visits);
+
   // Query a VisitInfo giving an visit id, filling the given VisitRow.
   // Returns true on success.
   bool GetRowForVisit(VisitID visit_id, VisitRow* out_visit);
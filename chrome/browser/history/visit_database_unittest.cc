@@ -136,6 +136,37 @@ TEST_F(VisitDatabaseTest, Delete) {
               IsVisitInfoEqual(matches[1], visit_info3));
 }
 
+TEST_F(VisitDatabaseTest, DeleteVisits) {
+  // Build the chain 1 -> 2 -> 3 -> 4, give the visits some sources, and
+  // delete 2 and 3, listing the later one first. 4 should then come from 1.
+  VisitRow visits[4];
+  for (int i = 0; i < 4; i++) {
+    visits[i] = VisitRow(1, Time::FromInternalValue(1000 + i),
+                         i ? visits[i - 1].visit_id : 0,
+                         content::PAGE_TRANSITION_LINK, 0);
+    EXPECT_TRUE(AddVisit(&visits[i], SOURCE_SYNCED));
+  }
+
+  VisitVector to_delete;
+  to_delete.push_back(visits[2]);
+  to_delete.push_back(visits[1]);
+  DeleteVisits(to_delete);
+
+  visits[3].referring_visit = visits[0].visit_id;
+  std::vector<VisitRow> matches;
+  EXPECT_TRUE(GetVisitsForURL(1, &matches));
+  ASSERT_EQ(2U, matches.size());
+  EXPECT_TRUE(IsVisitInfoEqual(matches[0], visits[0]));
+  EXPECT_TRUE(IsVisitInfoEqual(matches[1], visits[3]));
+
+  // The sources of the deleted visits should be gone too.
+  VisitSourceMap sources;
+  GetVisitsSource(std::vector<VisitRow>(visits, visits + 4), &sources);
+  EXPECT_EQ(2U, sources.size());
+  EXPECT_TRUE(sources.find(visits[1].visit_id) == sources.end());
+  EXPECT_TRUE(sources.find(visits[2].visit_id) == sources.end());
+}
+
 TEST_F(VisitDatabaseTest, Update) {
   // Make something in the database.
   VisitRow original(1, Time::Now(), 23, content::PageTransitionFromInt(0), 19);
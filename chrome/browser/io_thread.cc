@@ -126,10 +126,16 @@ const char kQuicFieldTrialName[] = "QUIC";
 const char kQuicFieldTrialEnabledGroupName[] = "Enabled";
 const char kQuicFieldTrialHttpsEnabledGroupName[] = "HttpsEnabled";
 const char kQuicFieldTrialPacketLengthSuffix[] = "BytePackets";
+const char kQuicFieldTrialPacingSuffix[] = "WithPacing";
 
 const char kSpdyFieldTrialName[] = "SPDY";
 const char kSpdyFieldTrialDisabledGroupName[] = "SpdyDisabled";
 
+const char kDnsServeStaleFieldTrialName[] = "DnsServeStale";
+const char kDnsServeStaleFieldTrialEnabledGroupName[] = "Enabled";
+// How long after expiring a host cache entry may answer while it refreshes.
+const int kDnsServeStaleMaxAgeSeconds = 60;
+
 #if defined(OS_MACOSX) && !defined(OS_IOS)
 void ObserveKeychainEvents() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
@@ -187,6 +193,12 @@ scoped_ptr<net::HostResolver> CreateGlobalHostResolver(net::NetLog* net_log) {
     }
   }
 
+  if (base::FieldTrialList::FindFullName(kDnsServeStaleFieldTrialName) ==
+      kDnsServeStaleFieldTrialEnabledGroupName) {
+    options.max_stale_age =
+        base::TimeDelta::FromSeconds(kDnsServeStaleMaxAgeSeconds);
+  }
+
   scoped_ptr<net::HostResolver> global_host_resolver(
       net::HostResolver::CreateSystemResolver(options, net_log));
 
@@ -1015,6 +1027,7 @@ void IOThread::InitializeNetworkSessionParams(
   globals_->enable_quic_https.CopyToIfSet(&params->enable_quic_https);
   globals_->enable_quic_port_selection.CopyToIfSet(
       &params->enable_quic_port_selection);
+  globals_->enable_quic_pacing.CopyToIfSet(&params->enable_quic_pacing);
   globals_->quic_max_packet_length.CopyToIfSet(&params->quic_max_packet_length);
   globals_->quic_supported_versions.CopyToIfSet(
       &params->quic_supported_versions);
@@ -1104,6 +1117,8 @@ void IOThread::ConfigureQuic(const CommandLine& command_line) {
         ShouldEnableQuicHttps(command_line, quic_trial_group));
     globals_->enable_quic_port_selection.set(
         ShouldEnableQuicPortSelection(command_line));
+    globals_->enable_quic_pacing.set(
+        ShouldEnableQuicPacing(command_line, quic_trial_group));
   }
 
   size_t max_packet_length = GetQuicMaxPacketLength(command_line,
@@ -1180,6 +1195,14 @@ bool IOThread::ShouldEnableQuicPortSelection(
 #endif
 }
 
+bool IOThread::ShouldEnableQuicPacing(const CommandLine& command_line,
+                                      base::StringPiece quic_trial_group) {
+  if (command_line.HasSwitch(switches::kEnableQuicPacing))
+    return true;
+
+  return quic_trial_group.ends_with(kQuicFieldTrialPacingSuffix);
+}
+
 size_t IOThread::GetQuicMaxPacketLength(const CommandLine& command_line,
                                         base::StringPiece quic_trial_group) {
   if (command_line.HasSwitch(switches::kQuicMaxPacketLength)) {
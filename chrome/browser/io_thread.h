@@ -166,6 +166,7 @@ class IOThread : public content::BrowserThreadDelegate {
     Optional<bool> enable_quic;
     Optional<bool> enable_quic_https;
     Optional<bool> enable_quic_port_selection;
+    Optional<bool> enable_quic_pacing;
     Optional<size_t> quic_max_packet_length;
     Optional<net::QuicVersionVector> quic_supported_versions;
     Optional<net::HostPortPair> origin_to_force_quic_on;
@@ -281,6 +282,11 @@ class IOThread : public content::BrowserThreadDelegate {
   // dialog.
   bool ShouldEnableQuicPortSelection(const CommandLine& command_line);
 
+  // Returns true if QUIC packet pacing should be negotiated during the QUIC
+  // handshake, either as a result of a field trial or a command line flag.
+  bool ShouldEnableQuicPacing(const CommandLine& command_line,
+                              base::StringPiece quic_trial_group);
+
   // Returns the maximum length for QUIC packets, based on any flags in
   // |command_line| or the field trial.  Returns 0 if there is an error
   // parsing any of the options, or if the default value should be used.
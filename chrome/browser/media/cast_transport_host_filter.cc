@@ -27,6 +27,8 @@ bool CastTransportHostFilter::OnMessageReceived(const IPC::Message& message,
                         OnSendRtcpFromRtpSender);
     IPC_MESSAGE_HANDLER(CastHostMsg_ResendPackets,
                         OnResendPackets)
+    IPC_MESSAGE_HANDLER(CastHostMsg_SetVideoBitrate,
+                        OnSetVideoBitrate)
     IPC_MESSAGE_UNHANDLED(handled = false);
   IPC_END_MESSAGE_MAP_EX();
   return handled;
@@ -169,4 +171,16 @@ void CastTransportHostFilter::OnResendPackets(
   }
 }
 
+void CastTransportHostFilter::OnSetVideoBitrate(int32 channel_id,
+                                                int bits_per_second) {
+  media::cast::transport::CastTransportSender* sender =
+      id_map_.Lookup(channel_id);
+  if (sender) {
+    sender->SetVideoBitrate(bits_per_second);
+  } else {
+    DVLOG(1)
+        << "CastTransportHostFilter::OnSetVideoBitrate on non-existing channel";
+  }
+}
+
 }  // namespace cast
@@ -56,6 +56,7 @@ class CastTransportHostFilter : public content::BrowserMessageFilter {
       int32 channel_id,
       bool is_audio,
       const media::cast::MissingFramesAndPacketsMap& missing_packets);
+  void OnSetVideoBitrate(int32 channel_id, int bits_per_second);
   void OnNew(
       int32 channel_id,
       const media::cast::transport::CastTransportConfig& config);
@@ -154,6 +154,9 @@ TEST_F(CastTransportHostFilterTest, SimpleMessages) {
       kChannelId, false, missing_packets);
   FakeSend(resend_msg);
 
+  CastHostMsg_SetVideoBitrate bitrate_msg(kChannelId, 2000000);
+  FakeSend(bitrate_msg);
+
   CastHostMsg_Delete delete_msg(kChannelId);
   FakeSend(delete_msg);
 }
@@ -4,9 +4,8 @@
 
 #include "chrome/browser/metrics/compression_utils.h"
 
-#include <vector>
-
 #include "base/basictypes.h"
+#include "base/stl_util.h"
 #include "third_party/zlib/zlib.h"
 
 namespace {
@@ -75,18 +74,22 @@ int GzipCompressHelper(Bytef* dest,
 namespace chrome {
 
 bool GzipCompress(const std::string& input, std::string* output) {
-  std::vector<Bytef> compressed_data(kGzipZlibHeaderDifferenceBytes +
-                                     compressBound(input.size()));
+  // Compress straight into a string rather than a temporary buffer, so that
+  // large logs aren't held in memory twice while being copied over.
+  std::string compressed_data;
+  compressed_data.resize(kGzipZlibHeaderDifferenceBytes +
+                         compressBound(input.size()));
 
   uLongf compressed_size = compressed_data.size();
-  if (GzipCompressHelper(&compressed_data.front(),
+  if (GzipCompressHelper(bit_cast<Bytef*>(string_as_array(&compressed_data)),
                          &compressed_size,
                          bit_cast<const Bytef*>(input.data()),
                          input.size()) != Z_OK)
     return false;
 
-  compressed_data.resize(compressed_size);
-  output->assign(compressed_data.begin(), compressed_data.end());
+  // resize() would keep the capacity of the bound, which can be several times
+  // the compressed size, so copy the result into a string of its own size.
+  std::string(compressed_data.data(), compressed_size).swap(*output);
   return true;
 }
 }  // namespace chrome
@@ -45,4 +45,12 @@ TEST(CompressionUtilsTest, GzipCompression) {
   EXPECT_EQ(golden_compressed_data, compressed_data);
 }
 
+// The output shouldn't hold on to the memory reserved for compressing.
+TEST(CompressionUtilsTest, GzipCompressionFitsOutput) {
+  const std::string data(100000, 'a');
+  std::string compressed_data;
+  EXPECT_TRUE(chrome::GzipCompress(data, &compressed_data));
+  EXPECT_LT(compressed_data.capacity(), data.size() / 10);
+}
+
 }  // namespace
@@ -1259,6 +1259,8 @@ void MetricsService::CloseCurrentLog() {
   if (!log_manager_.current_log())
     return;
 
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
   // TODO(jar): Integrate bounds on log recording more consistently, so that we
   // can stop recording logs that are too big much sooner.
   if (log_manager_.current_log()->num_events() > kEventLimit) {
@@ -1289,6 +1291,12 @@ void MetricsService::CloseCurrentLog() {
   RecordCurrentHistograms();
 
   log_manager_.FinishCurrentLog();
+
+  // Building and serializing the log happens on the UI thread, so keep track
+  // of how long it takes.  This lands in the next log.  It doesn't include
+  // the gzip compression, which happens when the log is uploaded.
+  UMA_HISTOGRAM_TIMES("UMA.CloseCurrentLogTime",
+                      base::TimeTicks::Now() - start_time);
 }
 
 void MetricsService::PushPendingLogsToPersistentStorage() {
@@ -1621,7 +1629,7 @@ void MetricsService::PrepareFetchWithStagedLog() {
     current_fetch_->SetRequestContext(
         g_browser_process->system_request_context());
 
-    std::string log_text = log_manager_.staged_log_text();
+    const std::string& log_text = log_manager_.staged_log_text();
     std::string compressed_log_text;
     bool compression_successful = chrome::GzipCompress(log_text,
                                                        &compressed_log_text);
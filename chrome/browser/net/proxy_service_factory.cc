@@ -5,6 +5,7 @@
 #include "chrome/browser/net/proxy_service_factory.h"
 
 #include "base/command_line.h"
+#include "base/metrics/field_trial.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/threading/thread.h"
 #include "chrome/browser/browser_process.h"
@@ -32,6 +33,16 @@
 
 using content::BrowserThread;
 
+namespace {
+
+const char kPacResultCacheFieldTrialName[] = "PacResultCache";
+const char kPacResultCacheFieldTrialEnabledGroupName[] = "Enabled";
+// Bounds on the PAC script results the ProxyService keeps per origin.
+const size_t kPacResultCacheMaxEntries = 100;
+const int kPacResultCacheTtlSeconds = 60;
+
+}  // namespace
+
 // static
 net::ProxyConfigService* ProxyServiceFactory::CreateProxyConfigService(
     PrefProxyConfigTracker* tracker) {
@@ -162,5 +173,12 @@ net::ProxyService* ProxyServiceFactory::CreateProxyService(
 
   proxy_service->set_quick_check_enabled(quick_check_enabled);
 
+  if (base::FieldTrialList::FindFullName(kPacResultCacheFieldTrialName) ==
+      kPacResultCacheFieldTrialEnabledGroupName) {
+    proxy_service->EnablePacResultCache(
+        kPacResultCacheMaxEntries,
+        base::TimeDelta::FromSeconds(kPacResultCacheTtlSeconds));
+  }
+
   return proxy_service;
 }
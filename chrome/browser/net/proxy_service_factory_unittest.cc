@@ -0,0 +1,41 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/proxy_service_factory.h"
+
+#include "base/command_line.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/metrics/field_trial.h"
+#include "chrome/common/chrome_switches.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "net/proxy/proxy_config_service_fixed.h"
+#include "net/proxy/proxy_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Creates a ProxyService that does not use V8, so no URLRequestContext is
+// needed.
+net::ProxyService* CreateProxyService() {
+  CommandLine command_line(CommandLine::NO_PROGRAM);
+  command_line.AppendSwitch(switches::kWinHttpProxyResolver);
+  return ProxyServiceFactory::CreateProxyService(
+      NULL, NULL, NULL,
+      new net::ProxyConfigServiceFixed(net::ProxyConfig::CreateDirect()),
+      command_line, false);
+}
+
+}  // namespace
+
+TEST(ProxyServiceFactoryTest, PacResultCacheFieldTrial) {
+  content::TestBrowserThreadBundle thread_bundle;
+  base::FieldTrialList field_trial_list(NULL);
+
+  scoped_ptr<net::ProxyService> proxy_service(CreateProxyService());
+  EXPECT_FALSE(proxy_service->pac_result_cache_enabled());
+
+  base::FieldTrialList::CreateFieldTrial("PacResultCache", "Enabled");
+  proxy_service.reset(CreateProxyService());
+  EXPECT_TRUE(proxy_service->pac_result_cache_enabled());
+}
@@ -32,6 +32,7 @@
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
+#include "content/public/browser/resource_dispatcher_host.h"
 #include "content/public/browser/resource_request_details.h"
 #include "content/public/browser/session_storage_namespace.h"
 #include "content/public/browser/web_contents.h"
@@ -71,6 +72,28 @@ void ResumeThrottles(
   }
 }
 
+void SetRouteExemptFromHiddenLimit(int child_id, int route_id, bool is_exempt) {
+  content::ResourceDispatcherHost* resource_dispatcher_host =
+      content::ResourceDispatcherHost::Get();
+  if (resource_dispatcher_host) {
+    resource_dispatcher_host->SetRouteExemptFromHiddenLimit(
+        child_id, route_id, is_exempt);
+  }
+}
+
+// Prerenders are hidden while they load, but are meant to be ready when they
+// are shown, so they are not held to the smaller limit of hidden tabs.
+void PostSetRouteExemptFromHiddenLimit(RenderViewHost* render_view_host,
+                                       bool is_exempt) {
+  content::BrowserThread::PostTask(
+      content::BrowserThread::IO,
+      FROM_HERE,
+      base::Bind(&SetRouteExemptFromHiddenLimit,
+                 render_view_host->GetProcess()->GetID(),
+                 render_view_host->GetRoutingID(),
+                 is_exempt));
+}
+
 }  // namespace
 
 // static
@@ -444,6 +467,7 @@ void PrerenderContents::Observe(int type,
                   prerender_contents_.get());
 
         content::Details<RenderViewHost> new_render_view_host(details);
+        PostSetRouteExemptFromHiddenLimit(new_render_view_host.ptr(), true);
         OnRenderViewHostCreated(new_render_view_host.ptr());
 
         // Make sure the size of the RenderViewHost has been passed to the new
@@ -778,6 +802,8 @@ void PrerenderContents::PrepareForUse() {
   if (prerender_contents_.get()) {
     prerender_contents_->SendToAllFrames(
         new PrerenderMsg_SetIsPrerendering(MSG_ROUTING_NONE, false));
+    PostSetRouteExemptFromHiddenLimit(
+        prerender_contents_->GetRenderViewHost(), false);
   }
 
   NotifyPrerenderStop();
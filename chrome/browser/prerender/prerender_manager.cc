@@ -17,6 +17,7 @@
 #include "base/prefs/pref_service.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/sys_info.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/values.h"
@@ -98,6 +99,11 @@ const int kSessionStorageNamespaceMergeTimeoutMs = 500;
 // If true, all session storage merges hang indefinitely.
 bool g_hang_session_storage_merges_for_testing = false;
 
+// A single prerender may use at most 1/kMaxBytesPhysicalMemoryDivisor of the
+// machine's physical memory, so that machines with little memory don't start
+// swapping on behalf of a page the user may never visit.
+const int64 kMaxBytesPhysicalMemoryDivisor = 16;
+
 // Indicates whether a Prerender has been cancelled such that we need
 // a dummy replacement for the purpose of recording the correct PPLT for
 // the Match Complete case.
@@ -271,6 +277,14 @@ PrerenderManager::PrerenderManager(Profile* profile,
     }
   }
 
+  // Scale the memory limit down on low-end machines.
+  const int64 max_bytes_for_machine =
+      base::SysInfo::AmountOfPhysicalMemory() / kMaxBytesPhysicalMemoryDivisor;
+  if (max_bytes_for_machine > 0 &&
+      max_bytes_for_machine < static_cast<int64>(config_.max_bytes)) {
+    config_.max_bytes = static_cast<size_t>(max_bytes_for_machine);
+  }
+
   // Certain experiments override our default config_ values.
   switch (PrerenderManager::GetMode()) {
     case PrerenderManager::PRERENDER_MODE_EXPERIMENT_MULTI_PRERENDER_GROUP:
@@ -5,6 +5,7 @@
 #include "chrome/browser/safe_browsing/safe_browsing_store.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "base/logging.h"
 
@@ -172,3 +173,48 @@ void SBProcessSubs(SBAddPrefixes* add_prefixes,
   RemoveDeleted(add_full_hashes, add_chunks_deleted);
   RemoveDeleted(sub_full_hashes, sub_chunks_deleted);
 }
+
+void SBGetSortedPrefixes(SBAddPrefixes* add_prefixes,
+                         std::vector<SBPrefix>* prefixes) {
+  // |bounds| holds the start of each sorted run in |runs|, followed by the
+  // end.
+  std::vector<SBPrefix> runs;
+  runs.reserve(add_prefixes->size());
+  std::vector<size_t> bounds;
+  for (SBAddPrefixes::const_iterator iter = add_prefixes->begin();
+       iter != add_prefixes->end(); ++iter) {
+    if (runs.empty() || iter->prefix < runs.back())
+      bounds.push_back(runs.size());
+    runs.push_back(iter->prefix);
+  }
+  bounds.push_back(runs.size());
+  SBAddPrefixes().swap(*add_prefixes);
+
+  // Each pass merges pairs of runs from |runs| into |merged|, carrying an
+  // odd run over as is.  The two buffers trade places between passes, so
+  // the merge buffer is only allocated once.
+  std::vector<SBPrefix> merged;
+  while (bounds.size() > 2) {
+    merged.clear();
+    merged.reserve(runs.size());
+    std::vector<size_t> merged_bounds;
+    merged_bounds.reserve(bounds.size() / 2 + 1);
+    size_t i = 0;
+    for (; i + 2 < bounds.size(); i += 2) {
+      merged_bounds.push_back(merged.size());
+      std::merge(runs.begin() + bounds[i], runs.begin() + bounds[i + 1],
+                 runs.begin() + bounds[i + 1], runs.begin() + bounds[i + 2],
+                 std::back_inserter(merged));
+    }
+    if (i + 1 < bounds.size()) {
+      merged_bounds.push_back(merged.size());
+      merged.insert(merged.end(),
+                    runs.begin() + bounds[i], runs.begin() + bounds[i + 1]);
+    }
+    merged_bounds.push_back(merged.size());
+    runs.swap(merged);
+    bounds.swap(merged_bounds);
+  }
+
+  prefixes->swap(runs);
+}
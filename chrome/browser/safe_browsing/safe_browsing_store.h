@@ -146,6 +146,15 @@ void SBProcessSubs(SBAddPrefixes* add_prefixes,
                    const base::hash_set<int32>& add_chunks_deleted,
                    const base::hash_set<int32>& sub_chunks_deleted);
 
+// Fill |prefixes| with the prefixes from |add_prefixes| in sorted order,
+// releasing |add_prefixes| along the way.  |FinishUpdate()| leaves the add
+// prefixes ordered by chunk-id and then prefix, so rather than sorting from
+// scratch this finds the runs which are already sorted and merges them
+// pairwise.  |add_prefixes| is released before the runs are merged, so it
+// is never alive at the same time as the merge buffer.
+void SBGetSortedPrefixes(SBAddPrefixes* add_prefixes,
+                         std::vector<SBPrefix>* prefixes);
+
 // TODO(shess): This uses int32 rather than int because it's writing
 // specifically-sized items to files.  SBPrefix should likewise be
 // explicitly sized.
@@ -4,6 +4,9 @@
 
 #include "chrome/browser/safe_browsing/safe_browsing_store_file.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "base/md5.h"
 #include "base/metrics/histogram.h"
 
@@ -14,6 +17,9 @@ namespace {
 const int32 kFileMagic = 0x600D71FE;
 const int32 kFileVersion = 7;  // SQLite storage was 6...
 
+// Upper bound on the buffers used to batch container reads and writes.
+const size_t kIOBufferBytes = 16 * 1024;
+
 // Header at the front of the main database file.
 struct FileHeader {
   int32 magic, version;
@@ -82,39 +88,83 @@ bool WriteItem(const T& item, FILE* fp, base::MD5Context* context) {
 }
 
 // Read |count| items into |values| from |fp|, and fold them into the
-// checksum in |context|.  Returns true on success.
+// checksum in |context|.  Returns true on success.  Items are read
+// through a buffer of at most |kIOBufferBytes|, so large counts don't
+// cost a call to fread() and MD5Update() apiece.
 template <typename CT>
 bool ReadToContainer(CT* values, size_t count, FILE* fp,
                      base::MD5Context* context) {
   if (!count)
     return true;
 
-  for (size_t i = 0; i < count; ++i) {
-    typename CT::value_type value;
-    if (!ReadItem(&value, fp, context))
+  typedef typename CT::value_type ValueType;
+  const size_t buffer_items =
+      std::max(kIOBufferBytes / sizeof(ValueType), static_cast<size_t>(1));
+  std::vector<ValueType> buffer(std::min(count, buffer_items));
+
+  while (count) {
+    const size_t n = std::min(count, buffer.size());
+    if (fread(&buffer[0], sizeof(ValueType), n, fp) != n)
       return false;
 
+    if (context) {
+      base::MD5Update(context,
+                      base::StringPiece(reinterpret_cast<char*>(&buffer[0]),
+                                        n * sizeof(ValueType)));
+    }
+
     // push_back() is more obvious, but coded this way std::set can
     // also be read.
-    values->insert(values->end(), value);
+    for (size_t i = 0; i < n; ++i)
+      values->insert(values->end(), buffer[i]);
+    count -= n;
   }
 
   return true;
 }
 
+// Write |n| items from |buffer| to |fp|, and fold the data into the
+// checksum in |context|, if non-NULL.  Returns true on success.
+template <class T>
+bool WriteBuffer(const T* buffer, size_t n, FILE* fp,
+                 base::MD5Context* context) {
+  if (fwrite(buffer, sizeof(T), n, fp) != n)
+    return false;
+
+  if (context) {
+    base::MD5Update(context,
+                    base::StringPiece(reinterpret_cast<const char*>(buffer),
+                                      n * sizeof(T)));
+  }
+  return true;
+}
+
 // Write all of |values| to |fp|, and fold the data into the checksum
-// in |context|, if non-NULL.  Returns true on succsess.
+// in |context|, if non-NULL.  Returns true on succsess.  As for reads,
+// items are gathered into a bounded buffer and written in blocks.
 template <typename CT>
 bool WriteContainer(const CT& values, FILE* fp,
                     base::MD5Context* context) {
   if (values.empty())
     return true;
 
+  typedef typename CT::value_type ValueType;
+  const size_t buffer_items =
+      std::max(kIOBufferBytes / sizeof(ValueType), static_cast<size_t>(1));
+  std::vector<ValueType> buffer;
+  buffer.reserve(std::min(values.size(), buffer_items));
+
   for (typename CT::const_iterator iter = values.begin();
        iter != values.end(); ++iter) {
-    if (!WriteItem(*iter, fp, context))
-      return false;
+    buffer.push_back(*iter);
+    if (buffer.size() == buffer_items) {
+      if (!WriteBuffer(&buffer[0], buffer.size(), fp, context))
+        return false;
+      buffer.clear();
+    }
   }
+  if (!buffer.empty())
+    return WriteBuffer(&buffer[0], buffer.size(), fp, context);
   return true;
 }
 
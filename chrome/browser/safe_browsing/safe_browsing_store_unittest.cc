@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "chrome/browser/safe_browsing/safe_browsing_store.h"
+
+#include <algorithm>
+
 #include "chrome/browser/safe_browsing/safe_browsing_store_unittest_helper.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
@@ -278,6 +281,33 @@ TEST(SafeBrowsingStoreTest, SBProcessSubsDeleteChunk) {
   EXPECT_TRUE(sub_hashes.empty());
 }
 
+// Test that the prefixes come out sorted however the chunks' runs
+// interleave, and that the add prefixes are released.
+TEST(SafeBrowsingStoreTest, SBGetSortedPrefixes) {
+  std::vector<SBPrefix> prefixes;
+  SBAddPrefixes add_prefixes;
+  SBGetSortedPrefixes(&add_prefixes, &prefixes);
+  EXPECT_TRUE(prefixes.empty());
+
+  // Five chunks, each sorted by prefix the way FinishUpdate() leaves them,
+  // with some prefixes in more than one chunk.  An odd number of runs
+  // exercises carrying a run over to the next pass.
+  std::vector<SBPrefix> expected;
+  for (int32 chunk_id = 1; chunk_id <= 5; ++chunk_id) {
+    for (SBPrefix prefix = chunk_id; prefix < 100; prefix += chunk_id + 1) {
+      add_prefixes.push_back(SBAddPrefix(chunk_id, prefix * 7919));
+      expected.push_back(prefix * 7919);
+    }
+  }
+  add_prefixes.push_back(SBAddPrefix(6, 0));
+  expected.push_back(0);
+  std::sort(expected.begin(), expected.end());
+
+  SBGetSortedPrefixes(&add_prefixes, &prefixes);
+  EXPECT_TRUE(add_prefixes.empty());
+  EXPECT_EQ(expected, prefixes);
+}
+
 TEST(SafeBrowsingStoreTest, Y2K38) {
   const base::Time now = base::Time::Now();
   const base::Time future = now + base::TimeDelta::FromDays(3*365);
@@ -5,6 +5,7 @@
 #include "chrome/browser/sessions/session_backend.h"
 
 #include <limits>
+#include <string>
 
 #include "base/file_util.h"
 #include "base/memory/scoped_vector.h"
@@ -30,6 +31,30 @@ struct FileHeader {
   int32 version;
 };
 
+// Commands are gathered into a buffer of about this many bytes before being
+// written, instead of issuing a write per field of every command; a reset
+// rewrites the whole session in one go.
+const size_t kFileWriteBufferSize = 64 * 1024;
+
+// Writes |buffer| to |file| and empties it. Returns false on error.
+bool WriteBufferToFile(net::FileStream* file, std::string* buffer) {
+  if (buffer->empty())
+    return true;
+  int size = static_cast<int>(buffer->size());
+  int wrote = file->WriteSync(buffer->data(), size);
+  buffer->clear();
+  if (wrote != size) {
+    NOTREACHED() << "error writing";
+    return false;
+  }
+#if defined(OS_CHROMEOS)
+  // TODO(gspencer): Remove this once we find a better place to do it.
+  // See issue http://crbug.com/245015
+  file->FlushSync();
+#endif
+  return true;
+}
+
 // SessionFileReader ----------------------------------------------------------
 
 // SessionFileReader is responsible for reading the set of SessionCommands that
@@ -306,43 +331,30 @@ bool SessionBackend::ReadCurrentSessionCommandsImpl(
 
 bool SessionBackend::AppendCommandsToFile(net::FileStream* file,
     const std::vector<SessionCommand*>& commands) {
+  std::string buffer;
+  buffer.reserve(kFileWriteBufferSize);
   for (std::vector<SessionCommand*>::const_iterator i = commands.begin();
        i != commands.end(); ++i) {
-    int wrote;
     const size_type content_size = static_cast<size_type>((*i)->size());
     const size_type total_size =  content_size + sizeof(id_type);
     if (type_ == BaseSessionService::TAB_RESTORE)
       UMA_HISTOGRAM_COUNTS("TabRestore.command_size", total_size);
     else
       UMA_HISTOGRAM_COUNTS("SessionRestore.command_size", total_size);
-    wrote = file->WriteSync(reinterpret_cast<const char*>(&total_size),
-                            sizeof(total_size));
-    if (wrote != sizeof(total_size)) {
-      NOTREACHED() << "error writing";
+    if (buffer.size() + sizeof(total_size) + total_size >
+            kFileWriteBufferSize &&
+        !WriteBufferToFile(file, &buffer)) {
       return false;
     }
+    buffer.append(reinterpret_cast<const char*>(&total_size),
+                  sizeof(total_size));
     id_type command_id = (*i)->id();
-    wrote = file->WriteSync(reinterpret_cast<char*>(&command_id),
-                            sizeof(command_id));
-    if (wrote != sizeof(command_id)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
-    if (content_size > 0) {
-      wrote = file->WriteSync(reinterpret_cast<char*>((*i)->contents()),
-                              content_size);
-      if (wrote != content_size) {
-        NOTREACHED() << "error writing";
-        return false;
-      }
-    }
-#if defined(OS_CHROMEOS)
-    // TODO(gspencer): Remove this once we find a better place to do it.
-    // See issue http://crbug.com/245015
-    file->FlushSync();
-#endif
+    buffer.append(reinterpret_cast<const char*>(&command_id),
+                  sizeof(command_id));
+    if (content_size > 0)
+      buffer.append((*i)->contents(), content_size);
   }
-  return true;
+  return WriteBufferToFile(file, &buffer);
 }
 
 SessionBackend::~SessionBackend() {
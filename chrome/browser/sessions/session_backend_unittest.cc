@@ -155,6 +155,34 @@ TEST_F(SessionBackendTest, BigData) {
   STLDeleteElements(&commands);
 }
 
+// Writes enough commands in one go that they span several writes.
+TEST_F(SessionBackendTest, ManyCommands) {
+  const size_t kCommandCount = 5000;
+  const std::string contents(100, 'x');
+
+  scoped_refptr<SessionBackend> backend(
+      new SessionBackend(BaseSessionService::SESSION_RESTORE, path_));
+  std::vector<SessionCommand*> commands;
+  for (size_t i = 0; i < kCommandCount; ++i) {
+    TestData data = { static_cast<SessionCommand::id_type>(i % 200),
+                      contents.substr(0, i % contents.size()) };
+    commands.push_back(CreateCommandFromData(data));
+  }
+  backend->AppendCommands(new SessionCommands(commands), false);
+  commands.clear();
+
+  backend = NULL;
+  backend = new SessionBackend(BaseSessionService::SESSION_RESTORE, path_);
+  backend->ReadLastSessionCommandsImpl(&commands);
+  ASSERT_EQ(kCommandCount, commands.size());
+  for (size_t i = 0; i < kCommandCount; ++i) {
+    TestData data = { static_cast<SessionCommand::id_type>(i % 200),
+                      contents.substr(0, i % contents.size()) };
+    AssertCommandEqualsData(data, commands[i]);
+  }
+  STLDeleteElements(&commands);
+}
+
 TEST_F(SessionBackendTest, EmptyCommand) {
   TestData empty_command;
   empty_command.command_id = 1;
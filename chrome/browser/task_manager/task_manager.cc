@@ -589,6 +589,15 @@ bool TaskManagerModel::GetPhysicalMemory(int index, size_t* result) const {
   PerProcessValues& values(per_process_cache_[handle]);
 
   if (!values.is_physical_memory_valid) {
+#if defined(OS_LINUX)
+    // On Linux private memory is also resident. Just use it, rather than
+    // reading the process's working set a second time for this refresh.
+    if (!CachePrivateAndSharedMemory(handle))
+      return false;
+
+    values.is_physical_memory_valid = true;
+    values.physical_memory = values.private_bytes;
+#else
     base::WorkingSetKBytes ws_usage;
     MetricsMap::const_iterator iter = metrics_map_.find(handle);
     if (iter == metrics_map_.end() ||
@@ -596,10 +605,6 @@ bool TaskManagerModel::GetPhysicalMemory(int index, size_t* result) const {
       return false;
 
     values.is_physical_memory_valid = true;
-#if defined(OS_LINUX)
-    // On Linux private memory is also resident. Just use it.
-    values.physical_memory = ws_usage.priv * 1024;
-#else
     // Memory = working_set.private + working_set.shareable.
     // We exclude the shared memory.
     values.physical_memory = iter->second->GetWorkingSetSize();
@@ -75,7 +75,24 @@ void DeathDataSnapshotToValue(const DeathDataSnapshot& death_data,
   dictionary->Set("queue_ms_sample",
                   base::Value::CreateIntegerValue(
                       death_data.queue_duration_sample));
-
+  dictionary->Set("run_cpu_ms",
+                  base::Value::CreateIntegerValue(
+                      death_data.run_cpu_duration_sum));
+  dictionary->Set("run_cpu_ms_max",
+                  base::Value::CreateIntegerValue(
+                      death_data.run_cpu_duration_max));
+  dictionary->Set("run_ms_p50",
+                  base::Value::CreateIntegerValue(
+                      death_data.EstimateRunDurationPercentile(50)));
+  dictionary->Set("run_ms_p95",
+                  base::Value::CreateIntegerValue(
+                      death_data.EstimateRunDurationPercentile(95)));
+  dictionary->Set("queue_ms_p50",
+                  base::Value::CreateIntegerValue(
+                      death_data.EstimateQueueDurationPercentile(50)));
+  dictionary->Set("queue_ms_p95",
+                  base::Value::CreateIntegerValue(
+                      death_data.EstimateQueueDurationPercentile(95)));
 }
 
 // Re-serializes the |snapshot| into |dictionary|.
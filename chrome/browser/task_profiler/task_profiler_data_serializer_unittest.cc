@@ -92,6 +92,12 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
     process_data.tasks.back().death_data.queue_duration_max = 2053;
     process_data.tasks.back().death_data.queue_duration_sample = 2013;
     process_data.tasks.back().death_data.queue_duration_sum = 2079;
+    process_data.tasks.back().death_data.run_cpu_duration_max = 180;
+    process_data.tasks.back().death_data.run_cpu_duration_sum = 1500;
+    // 30 runs of 16-31ms and 11 of 128-255ms.
+    process_data.tasks.back().death_data.run_duration_buckets.resize(12);
+    process_data.tasks.back().death_data.run_duration_buckets[5] = 30;
+    process_data.tasks.back().death_data.run_duration_buckets[8] = 11;
     process_data.tasks.back().death_thread_name = "PAC thread #3";
 
     // Add a parent-child pair.
@@ -130,9 +136,15 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
                                 "\"count\":37,"
                                 "\"queue_ms\":79,"
                                 "\"queue_ms_max\":53,"
+                                "\"queue_ms_p50\":0,"
+                                "\"queue_ms_p95\":0,"
                                 "\"queue_ms_sample\":13,"
+                                "\"run_cpu_ms\":-1,"
+                                "\"run_cpu_ms_max\":-1,"
                                 "\"run_ms\":17,"
                                 "\"run_ms_max\":5,"
+                                "\"run_ms_p50\":0,"
+                                "\"run_ms_p95\":0,"
                                 "\"run_ms_sample\":3"
                              "},"
                              "\"death_thread\":\"WorkerPool/-1340960768\""
@@ -147,9 +159,15 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
                                 "\"count\":41,"
                                 "\"queue_ms\":2079,"
                                 "\"queue_ms_max\":2053,"
+                                "\"queue_ms_p50\":0,"
+                                "\"queue_ms_p95\":0,"
                                 "\"queue_ms_sample\":2013,"
+                                "\"run_cpu_ms\":1500,"
+                                "\"run_cpu_ms_max\":180,"
                                 "\"run_ms\":2017,"
                                 "\"run_ms_max\":205,"
+                                "\"run_ms_p50\":31,"
+                                "\"run_ms_p95\":255,"
                                 "\"run_ms_sample\":203"
                              "},"
                              "\"death_thread\":\"PAC thread #3\""
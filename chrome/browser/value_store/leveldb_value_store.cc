@@ -23,6 +23,11 @@ namespace {
 
 const char kInvalidJson[] = "Invalid JSON";
 
+// Upper bound on the keys and serialized values cached by each store. It
+// easily holds the settings of typical extensions, and the whole cache is
+// dropped once it fills up.
+const size_t kMaxCacheBytes = 512 * 1024;
+
 // Scoped leveldb snapshot which releases the snapshot on destruction.
 class ScopedSnapshot {
  public:
@@ -46,8 +51,15 @@ class ScopedSnapshot {
 
 }  // namespace
 
+LeveldbValueStore::CachedValue::CachedValue() : size(0) {
+}
+
+LeveldbValueStore::CachedValue::~CachedValue() {
+}
+
 LeveldbValueStore::LeveldbValueStore(const base::FilePath& db_path)
-    : db_path_(db_path) {
+    : db_path_(db_path),
+      cache_bytes_(0) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
 
   scoped_ptr<Error> open_error = EnsureDbIsOpen();
@@ -230,13 +242,13 @@ ValueStore::WriteResult LeveldbValueStore::Remove(
   for (std::vector<std::string>::const_iterator it = keys.begin();
       it != keys.end(); ++it) {
     scoped_ptr<base::Value> old_value;
-    scoped_ptr<Error> read_error =
-        ReadFromDb(leveldb::ReadOptions(), *it, &old_value);
+    scoped_ptr<Error> read_error = ReadFromDbBeforeWrite(*it, &old_value);
     if (read_error)
       return MakeWriteResult(read_error.Pass());
 
     if (old_value) {
       changes->push_back(ValueStoreChange(*it, old_value.release(), NULL));
+      RemoveFromCache(*it);
       batch.Delete(*it);
     }
   }
@@ -297,6 +309,51 @@ scoped_ptr<ValueStore::Error> LeveldbValueStore::ReadFromDb(
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
   DCHECK(setting);
 
+  // All access to |db_| goes through this object on the same thread, so the
+  // cache is just as current as any snapshot in |options|.
+  Cache::const_iterator cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    if (cached->second.value.get())
+      setting->reset(cached->second.value->DeepCopy());
+    return util::NoError();
+  }
+
+  size_t value_size = 0;
+  scoped_ptr<Error> read_error =
+      ReadFromDbUncached(options, key, setting, &value_size);
+  if (read_error)
+    return read_error.Pass();
+
+  AddToCache(key,
+             *setting ? make_scoped_ptr((*setting)->DeepCopy())
+                      : scoped_ptr<base::Value>(),
+             value_size);
+  return util::NoError();
+}
+
+scoped_ptr<ValueStore::Error> LeveldbValueStore::ReadFromDbBeforeWrite(
+    const std::string& key,
+    scoped_ptr<base::Value>* setting) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  DCHECK(setting);
+
+  Cache::const_iterator cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    if (cached->second.value.get())
+      setting->reset(cached->second.value->DeepCopy());
+    return util::NoError();
+  }
+
+  // The write removes |key| from the cache, so don't copy the value into it.
+  size_t value_size = 0;
+  return ReadFromDbUncached(leveldb::ReadOptions(), key, setting, &value_size);
+}
+
+scoped_ptr<ValueStore::Error> LeveldbValueStore::ReadFromDbUncached(
+    leveldb::ReadOptions options,
+    const std::string& key,
+    scoped_ptr<base::Value>* setting,
+    size_t* value_size) {
   std::string value_as_json;
   leveldb::Status s = db_->Get(options, key, &value_as_json);
 
@@ -314,6 +371,7 @@ scoped_ptr<ValueStore::Error> LeveldbValueStore::ReadFromDb(
     return Error::Create(CORRUPTION, kInvalidJson, util::NewKey(key));
 
   setting->reset(value);
+  *value_size = value_as_json.size();
   return util::NoError();
 }
 
@@ -327,8 +385,7 @@ scoped_ptr<ValueStore::Error> LeveldbValueStore::AddToBatch(
 
   if (!(options & NO_GENERATE_CHANGES)) {
     scoped_ptr<base::Value> old_value;
-    scoped_ptr<Error> read_error =
-        ReadFromDb(leveldb::ReadOptions(), key, &old_value);
+    scoped_ptr<Error> read_error = ReadFromDbBeforeWrite(key, &old_value);
     if (read_error)
       return read_error.Pass();
     if (!old_value || !old_value->Equals(&value)) {
@@ -342,6 +399,7 @@ scoped_ptr<ValueStore::Error> LeveldbValueStore::AddToBatch(
   if (write_new_value) {
     std::string value_as_json;
     base::JSONWriter::Write(&value, &value_as_json);
+    RemoveFromCache(key);
     batch->Put(key, value_as_json);
   }
 
@@ -369,6 +427,8 @@ bool LeveldbValueStore::IsEmpty() {
 }
 
 void LeveldbValueStore::DeleteDbFile() {
+  cache_.clear();
+  cache_bytes_ = 0;
   db_.reset();  // release any lock on the directory
   if (!base::DeleteFile(db_path_, true /* recursive */)) {
     LOG(WARNING) << "Failed to delete LeveldbValueStore database at " <<
@@ -376,6 +436,32 @@ void LeveldbValueStore::DeleteDbFile() {
   }
 }
 
+void LeveldbValueStore::AddToCache(const std::string& key,
+                                   scoped_ptr<base::Value> value,
+                                   size_t value_size) {
+  DCHECK(cache_.find(key) == cache_.end());
+  const size_t size = key.size() + value_size;
+  if (size > kMaxCacheBytes)
+    return;
+  if (cache_bytes_ + size > kMaxCacheBytes) {
+    cache_.clear();
+    cache_bytes_ = 0;
+  }
+
+  CachedValue& cached = cache_[key];
+  cached.value.reset(value.release());
+  cached.size = size;
+  cache_bytes_ += size;
+}
+
+void LeveldbValueStore::RemoveFromCache(const std::string& key) {
+  Cache::iterator it = cache_.find(key);
+  if (it == cache_.end())
+    return;
+  cache_bytes_ -= it->second.size;
+  cache_.erase(it);
+}
+
 scoped_ptr<ValueStore::Error> LeveldbValueStore::ToValueStoreError(
     const leveldb::Status& status,
     scoped_ptr<std::string> key) {
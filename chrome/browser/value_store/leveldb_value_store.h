@@ -5,11 +5,13 @@
 #ifndef CHROME_BROWSER_VALUE_STORE_LEVELDB_VALUE_STORE_H_
 #define CHROME_BROWSER_VALUE_STORE_LEVELDB_VALUE_STORE_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
+#include "base/memory/linked_ptr.h"
 #include "base/memory/scoped_ptr.h"
 #include "chrome/browser/value_store/value_store.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
@@ -47,6 +49,17 @@ class LeveldbValueStore : public ValueStore {
   virtual WriteResult Clear() OVERRIDE;
 
  private:
+  struct CachedValue {
+    CachedValue();
+    ~CachedValue();
+
+    // NULL if the setting is known not to exist.
+    linked_ptr<base::Value> value;
+    // Bytes the entry is accounted for in |cache_bytes_|.
+    size_t size;
+  };
+  typedef std::map<std::string, CachedValue> Cache;
+
   // Tries to open the database if it hasn't been opened already.
   scoped_ptr<ValueStore::Error> EnsureDbIsOpen();
 
@@ -57,6 +70,21 @@ class LeveldbValueStore : public ValueStore {
       // Will be reset() with the result, if any.
       scoped_ptr<base::Value>* setting);
 
+  // Like ReadFromDb(), for a setting that is about to be overwritten or
+  // removed. A value read from the database isn't added to the cache, since
+  // the write would only remove it again.
+  scoped_ptr<ValueStore::Error> ReadFromDbBeforeWrite(
+      const std::string& key,
+      scoped_ptr<base::Value>* setting);
+
+  // Reads a setting from the database itself, bypassing the cache. Sets
+  // |value_size| to the size of its serialized value, if there is one.
+  scoped_ptr<ValueStore::Error> ReadFromDbUncached(
+      leveldb::ReadOptions options,
+      const std::string& key,
+      scoped_ptr<base::Value>* setting,
+      size_t* value_size);
+
   // Adds a setting to a WriteBatch, and logs the change in |changes|. For use
   // with WriteToDb.
   scoped_ptr<ValueStore::Error> AddToBatch(ValueStore::WriteOptions options,
@@ -68,6 +96,15 @@ class LeveldbValueStore : public ValueStore {
   // Commits the changes in |batch| to the database.
   scoped_ptr<ValueStore::Error> WriteToDb(leveldb::WriteBatch* batch);
 
+  // Remembers the result of reading |key| from the database, which is
+  // |value| (or NULL if there is none) stored as |value_size| bytes.
+  void AddToCache(const std::string& key,
+                  scoped_ptr<base::Value> value,
+                  size_t value_size);
+
+  // Forgets |key|, before it is written to the database.
+  void RemoveFromCache(const std::string& key);
+
   // Converts an error leveldb::Status to a ValueStore::Error. Returns a
   // scoped_ptr for convenience; the result will always be non-empty.
   scoped_ptr<ValueStore::Error> ToValueStoreError(
@@ -87,6 +124,12 @@ class LeveldbValueStore : public ValueStore {
   // leveldb backend.
   scoped_ptr<leveldb::DB> db_;
 
+  // Settings recently read from |db_|, so that reading them again skips the
+  // lookup and the JSON parsing. Keys are removed before they are written, so
+  // this never disagrees with |db_|.
+  Cache cache_;
+  size_t cache_bytes_;
+
   DISALLOW_COPY_AND_ASSIGN(LeveldbValueStore);
 };
 
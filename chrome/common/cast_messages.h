@@ -134,6 +134,11 @@ IPC_MESSAGE_CONTROL3(
     bool /* is_audio */,
     media::cast::MissingFramesAndPacketsMap /* missing_packets */)
 
+IPC_MESSAGE_CONTROL2(
+    CastHostMsg_SetVideoBitrate,
+    int32 /* channel_id */,
+    int /* bits_per_second */)
+
 IPC_MESSAGE_CONTROL2(
     CastHostMsg_New,
     int32 /* channel_id */,
@@ -209,6 +209,7 @@ extern const char kEnablePrivetStorage[];
 extern const char kEnableProfiling[];
 extern const char kEnableQuic[];
 extern const char kEnableQuicHttps[];
+extern const char kEnableQuicPacing[];
 extern const char kEnableQuicPortSelection[];
 extern const char kEnableResourceContentSettings[];
 extern const char kEnableSavePasswordBubble[];
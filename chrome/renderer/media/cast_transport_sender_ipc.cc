@@ -77,6 +77,10 @@ void CastTransportSenderIPC::ResendPackets(
                                      missing_packets));
 }
 
+void CastTransportSenderIPC::SetVideoBitrate(int bits_per_second) {
+  Send(new CastHostMsg_SetVideoBitrate(channel_id_, bits_per_second));
+}
+
 void CastTransportSenderIPC::SubscribeAudioRtpStatsCallback(
     const media::cast::transport::CastTransportRtpStatistics& callback) {
   audio_rtp_callback_ = callback;
@@ -44,6 +44,7 @@ class CastTransportSenderIPC
       bool is_audio,
       const media::cast::transport::MissingFramesAndPacketsMap& missing_packets)
       OVERRIDE;
+  virtual void SetVideoBitrate(int bits_per_second) OVERRIDE;
   virtual void SubscribeAudioRtpStatsCallback(
       const media::cast::transport::CastTransportRtpStatistics& callback)
       OVERRIDE;
@@ -693,6 +693,9 @@ bool ChromeContentUtilityClient::RenderPDFPagesToPWGRaster(
 
   cloud_print::BitmapImage image(settings.area().size(),
                                  cloud_print::BitmapImage::BGRA);
+  // Pages are encoded into the same string, so that its buffer is only grown
+  // for the first few pages instead of being reallocated for every one.
+  std::string pwg_page;
   for (int i = 0; i < total_page_count; ++i) {
     if (!g_pdf_lib.Get().RenderPDFPageToBitmap(
              data.data(), data.size(), i, image.pixel_data(),
@@ -700,7 +703,7 @@ bool ChromeContentUtilityClient::RenderPDFPagesToPWGRaster(
              settings.dpi(), autoupdate)) {
       return false;
     }
-    std::string pwg_page;
+    pwg_page.clear();
     if (!encoder.EncodePage(image, settings.dpi(), total_page_count, &pwg_page))
       return false;
     bytes_written = base::WritePlatformFileAtCurrentPos(bitmap_file,
@@ -236,7 +236,9 @@ void DistillerImpl::RunDistillerCallbackIfDone() {
     for (std::map<int, size_t>::iterator it = finished_pages_index_.begin();
          it != finished_pages_index_.end();) {
       DistilledPageData* page_data = GetPageAtIndex(it->second);
-      *(article_proto->add_pages()) = *(page_data->proto);
+      // The page, and the image data it holds, is dropped once the article
+      // is built, so move it into the article instead of copying it.
+      article_proto->add_pages()->Swap(page_data->proto.get());
 
       if (first_page) {
         article_proto->set_title(page_data->title);
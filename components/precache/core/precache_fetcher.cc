@@ -13,10 +13,13 @@
 #include "base/containers/hash_tables.h"
 #include "components/precache/core/precache_switches.h"
 #include "components/precache/core/proto/precache.pb.h"
+#include "net/base/completion_callback.h"
 #include "net/base/escape.h"
 #include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
 #include "net/url_request/url_fetcher.h"
 #include "net/url_request/url_fetcher_delegate.h"
+#include "net/url_request/url_fetcher_response_writer.h"
 #include "net/url_request/url_request_context_getter.h"
 #include "net/url_request/url_request_status.h"
 
@@ -92,6 +95,27 @@ bool ParseProtoFromFetchResponse(const URLFetcher& source,
   return true;
 }
 
+// URLFetcherResponseWriter that discards the response body. Precached
+// resources are only fetched so that they end up in the HTTP cache, which
+// the network stack fills as the response is read, so there's no need to
+// hold each body in memory as well.
+class URLFetcherNullWriter : public net::URLFetcherResponseWriter {
+ public:
+  virtual int Initialize(const net::CompletionCallback& callback) OVERRIDE {
+    return net::OK;
+  }
+
+  virtual int Write(net::IOBuffer* buffer,
+                    int num_bytes,
+                    const net::CompletionCallback& callback) OVERRIDE {
+    return num_bytes;
+  }
+
+  virtual int Finish(const net::CompletionCallback& callback) OVERRIDE {
+    return net::OK;
+  }
+};
+
 }  // namespace
 
 // Class that fetches a URL, and runs the specified callback when the fetch is
@@ -102,9 +126,12 @@ bool ParseProtoFromFetchResponse(const URLFetcher& source,
 class PrecacheFetcher::Fetcher : public net::URLFetcherDelegate {
  public:
   // Construct a new Fetcher. This will create and start a new URLFetcher for
-  // the specified URL using the specified request context.
+  // the specified URL using the specified request context. If
+  // |ignore_response_body| is true, the response body isn't kept, and the
+  // URLFetcher passed to |callback| has no response string.
   Fetcher(net::URLRequestContextGetter* request_context, const GURL& url,
-          const base::Callback<void(const URLFetcher&)>& callback);
+          const base::Callback<void(const URLFetcher&)>& callback,
+          bool ignore_response_body);
   virtual ~Fetcher() {}
   virtual void OnURLFetchComplete(const URLFetcher* source) OVERRIDE;
 
@@ -117,11 +144,16 @@ class PrecacheFetcher::Fetcher : public net::URLFetcherDelegate {
 
 PrecacheFetcher::Fetcher::Fetcher(
     net::URLRequestContextGetter* request_context, const GURL& url,
-    const base::Callback<void(const URLFetcher&)>& callback)
+    const base::Callback<void(const URLFetcher&)>& callback,
+    bool ignore_response_body)
     : callback_(callback) {
   url_fetcher_.reset(URLFetcher::Create(url, URLFetcher::GET, this));
   url_fetcher_->SetRequestContext(request_context);
   url_fetcher_->SetLoadFlags(net::LOAD_DO_NOT_PROMPT_FOR_LOGIN);
+  if (ignore_response_body) {
+    url_fetcher_->SaveResponseWithWriter(
+        scoped_ptr<net::URLFetcherResponseWriter>(new URLFetcherNullWriter));
+  }
   url_fetcher_->Start();
 }
 
@@ -157,7 +189,8 @@ void PrecacheFetcher::Start() {
   // Fetch the precache configuration settings from the server.
   fetcher_.reset(new Fetcher(request_context_, config_url,
                              base::Bind(&PrecacheFetcher::OnConfigFetchComplete,
-                                        base::Unretained(this))));
+                                        base::Unretained(this)),
+                             false));
 }
 
 void PrecacheFetcher::StartNextFetch() {
@@ -166,7 +199,8 @@ void PrecacheFetcher::StartNextFetch() {
     fetcher_.reset(
         new Fetcher(request_context_, resource_urls_to_fetch_.front(),
                     base::Bind(&PrecacheFetcher::OnResourceFetchComplete,
-                               base::Unretained(this))));
+                               base::Unretained(this)),
+                    true));
 
     resource_urls_to_fetch_.pop_front();
     return;
@@ -177,7 +211,8 @@ void PrecacheFetcher::StartNextFetch() {
     fetcher_.reset(
         new Fetcher(request_context_, manifest_urls_to_fetch_.front(),
                     base::Bind(&PrecacheFetcher::OnManifestFetchComplete,
-                               base::Unretained(this))));
+                               base::Unretained(this)),
+                    false));
 
     manifest_urls_to_fetch_.pop_front();
     return;
@@ -12,6 +12,7 @@
 #include "base/logging.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/value_arena.h"
 #include "base/values.h"
 #include "components/translate/core/browser/translate_browser_metrics.h"
 #include "components/translate/core/browser/translate_download_manager.h"
@@ -270,8 +271,10 @@ void TranslateLanguageList::SetSupportedLanguages(
   std::string languages_json = language_list.substr(
       kLanguageListCallbackNameLength,
       language_list.size() - kLanguageListCallbackNameLength - 1);
-  scoped_ptr<base::Value> json_value(
-      base::JSONReader::Read(languages_json, base::JSON_ALLOW_TRAILING_COMMAS));
+  // The parsed list is only read here, so it can come from an arena.
+  base::ValueArena arena;
+  scoped_ptr<base::Value> json_value(base::JSONReader::ReadInArena(
+      languages_json, base::JSON_ALLOW_TRAILING_COMMAS, &arena));
   if (json_value == NULL || !json_value->IsType(base::Value::TYPE_DICTIONARY)) {
     NOTREACHED();
     return;
@@ -10,9 +10,25 @@
 #include "components/url_matcher/substring_set_matcher.h"
 #include "third_party/re2/re2/filtered_re2.h"
 #include "third_party/re2/re2/re2.h"
+#include "third_party/re2/re2/set.h"
 
 namespace url_matcher {
 
+namespace {
+
+// Upper bound on the memory used by the RE2::Set for the compiled program
+// and its DFA cache. The cache is filled lazily, so this is only reached for
+// large sets of regexes; larger sets use FilteredRE2 instead.
+const int64 kMaxRegexSetMemory = 32 << 20;
+
+}  // namespace
+
+class RegexSetMatcher::RegexSet : public RE2::Set {
+ public:
+  explicit RegexSet(const RE2::Options& options)
+      : RE2::Set(options, RE2::UNANCHORED) {}
+};
+
 RegexSetMatcher::RegexSetMatcher() {}
 
 RegexSetMatcher::~RegexSetMatcher() {
@@ -40,6 +56,21 @@ bool RegexSetMatcher::Match(const std::string& text,
   size_t old_number_of_matches = matches->size();
   if (regexes_.empty())
     return false;
+
+  if (regex_set_.get()) {
+    std::vector<int> set_ids;
+    bool dfa_failed = false;
+    if (regex_set_->Match(text, &set_ids, &dfa_failed)) {
+      for (size_t i = 0; i < set_ids.size(); ++i)
+        matches->insert(set_id_map_[set_ids[i]]);
+      return old_number_of_matches != matches->size();
+    }
+    if (!dfa_failed)
+      return false;
+    // The DFA ran out of memory on |text|, so the set can't tell whether it
+    // matches; use FilteredRE2 instead.
+  }
+
   if (!filtered_re2_.get()) {
     LOG(ERROR) << "RegexSetMatcher was not initialized";
     return false;
@@ -71,12 +102,43 @@ std::vector<RegexSetMatcher::RE2ID> RegexSetMatcher::FindSubstringMatches(
   return std::vector<RE2ID>(atoms_set.begin(), atoms_set.end());
 }
 
+void RegexSetMatcher::BuildRegexSet() {
+  RE2::Options options;
+  options.set_max_mem(kMaxRegexSetMemory);
+  // Running out of memory is expected for large sets and handled below.
+  options.set_log_errors(false);
+  scoped_ptr<RegexSet> regex_set(new RegexSet(options));
+
+  RE2IDMap set_id_map;
+  for (RegexMap::iterator it = regexes_.begin(); it != regexes_.end(); ++it) {
+    // Unparseable regexes should have been rejected already in
+    // URLMatcherFactory::CreateURLMatchesCondition.
+    int set_id = regex_set->Add(it->second->pattern(), NULL);
+    if (set_id < 0)
+      continue;
+    DCHECK_EQ(static_cast<int>(set_id_map.size()), set_id);
+    set_id_map.push_back(it->first);
+  }
+
+  if (set_id_map.empty() || !regex_set->Compile())
+    return;
+
+  regex_set_.swap(regex_set);
+  set_id_map_.swap(set_id_map);
+}
+
 void RegexSetMatcher::RebuildMatcher() {
   re2_id_map_.clear();
+  regex_set_.reset();
+  set_id_map_.clear();
   filtered_re2_.reset(new re2::FilteredRE2());
   if (regexes_.empty())
     return;
 
+  // FilteredRE2 is built even if the set fits, as Match() falls back to it
+  // for texts on which the set runs out of memory.
+  BuildRegexSet();
+
   for (RegexMap::iterator it = regexes_.begin(); it != regexes_.end(); ++it) {
     RE2ID re2_id;
     RE2::ErrorCode error = filtered_re2_->Add(
@@ -21,8 +21,11 @@ class FilteredRE2;
 
 namespace url_matcher {
 
-// Efficiently matches URLs against a collection of regular expressions,
-// using FilteredRE2 to reduce the number of regexes that must be matched
+// Efficiently matches URLs against a collection of regular expressions.
+// When the regexes fit in the memory budget, they are compiled into a
+// single RE2::Set, so a text is matched against all of them in one DFA
+// pass. Otherwise, or if the set's DFA runs out of memory on a text,
+// FilteredRE2 is used to reduce the number of regexes that must be matched
 // by pre-filtering with substring matching. See:
 // http://swtch.com/~rsc/regexp/regexp3.html#analysis
 class URL_MATCHER_EXPORT RegexSetMatcher {
@@ -31,8 +34,8 @@ class URL_MATCHER_EXPORT RegexSetMatcher {
   virtual ~RegexSetMatcher();
 
   // Adds the regex patterns in |regex_list| to the matcher. Also rebuilds
-  // the FilteredRE2 matcher; thus, for efficiency, prefer adding multiple
-  // patterns at once.
+  // the RE2::Set or FilteredRE2 matcher; thus, for efficiency, prefer adding
+  // multiple patterns at once.
   // Ownership of the patterns remains with the caller.
   void AddPatterns(const std::vector<const StringPattern*>& regex_list);
 
@@ -47,6 +50,9 @@ class URL_MATCHER_EXPORT RegexSetMatcher {
   bool IsEmpty() const;
 
  private:
+  // Wraps RE2::Set, which can't be forward-declared as it is nested in RE2.
+  class RegexSet;
+
   typedef int RE2ID;
   typedef std::map<StringPattern::ID, const StringPattern*> RegexMap;
   typedef std::vector<StringPattern::ID> RE2IDMap;
@@ -55,8 +61,12 @@ class URL_MATCHER_EXPORT RegexSetMatcher {
   // match the |text|.
   std::vector<RE2ID> FindSubstringMatches(const std::string& text) const;
 
-  // Rebuild FilteredRE2 from scratch. Needs to be called whenever
-  // our set of regexes changes.
+  // Tries to compile |regexes_| into |regex_set_|, filling |set_id_map_|.
+  // Leaves both empty if the set doesn't fit in the memory budget.
+  void BuildRegexSet();
+
+  // Rebuild the RE2::Set or FilteredRE2 from scratch. Needs to be called
+  // whenever our set of regexes changes.
   // TODO(yoz): investigate if it could be done incrementally;
   // apparently not supported by FilteredRE2.
   void RebuildMatcher();
@@ -70,6 +80,13 @@ class URL_MATCHER_EXPORT RegexSetMatcher {
   // to regex StringPattern::IDs.
   RE2IDMap re2_id_map_;
 
+  // Matches all of |regexes_| at once, or NULL if they didn't fit, in which
+  // case |filtered_re2_| is used instead. |filtered_re2_| is also used for
+  // the texts this runs out of memory on.
+  scoped_ptr<RegexSet> regex_set_;
+  // Mapping of the indices in |regex_set_| to regex StringPattern::IDs.
+  RE2IDMap set_id_map_;
+
   scoped_ptr<re2::FilteredRE2> filtered_re2_;
   scoped_ptr<SubstringSetMatcher> substring_matcher_;
 
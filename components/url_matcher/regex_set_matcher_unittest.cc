@@ -6,7 +6,9 @@
 
 #include <set>
 
+#include "base/memory/scoped_vector.h"
 #include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
@@ -59,4 +61,69 @@ TEST(RegexSetMatcherTest, CaseSensitivity) {
   EXPECT_TRUE(ContainsKey(result2, 57));
 }
 
+// Large sets of regexes may not fit into a single RE2::Set; they must match
+// the same way regardless.
+TEST(RegexSetMatcherTest, ManyRegexes) {
+  const int kNumRegexes = 5000;
+  ScopedVector<StringPattern> patterns;
+  std::vector<const StringPattern*> regexes;
+  for (int i = 0; i < kNumRegexes; ++i) {
+    patterns.push_back(new StringPattern(
+        base::StringPrintf("/ad%d[0-9]*\\.(js|gif)|track=%dx", i, i), i));
+    regexes.push_back(patterns.back());
+  }
+  RegexSetMatcher matcher;
+  matcher.AddPatterns(regexes);
+
+  std::set<StringPattern::ID> result1;
+  matcher.Match("http://example.com/ad4321.gif", &result1);
+  EXPECT_EQ(4U, result1.size());
+  EXPECT_TRUE(ContainsKey(result1, 4));
+  EXPECT_TRUE(ContainsKey(result1, 43));
+  EXPECT_TRUE(ContainsKey(result1, 432));
+  EXPECT_TRUE(ContainsKey(result1, 4321));
+
+  std::set<StringPattern::ID> result2;
+  matcher.Match("http://example.com/?track=4999x", &result2);
+  EXPECT_EQ(1U, result2.size());
+  EXPECT_TRUE(ContainsKey(result2, 4999));
+
+  std::set<StringPattern::ID> result3;
+  matcher.Match("http://example.com/ad.gif", &result3);
+  EXPECT_EQ(0U, result3.size());
+}
+
+// The set's DFA runs out of memory on a long text that keeps landing in new
+// states; matching must fall back to FilteredRE2 rather than miss matches.
+TEST(RegexSetMatcherTest, RegexSetOutOfMemory) {
+  ScopedVector<StringPattern> patterns;
+  std::vector<const StringPattern*> regexes;
+  for (char c = 'a'; c <= 'z'; ++c) {
+    patterns.push_back(
+        new StringPattern(base::StringPrintf("%c[^/]{20}/", c), c));
+    regexes.push_back(patterns.back());
+  }
+  RegexSetMatcher matcher;
+  matcher.AddPatterns(regexes);
+
+  std::string text = "http://example.com/";
+  uint32 seed = 1;
+  while (text.size() < 100000) {
+    seed = seed * 1103515245 + 12345;
+    text += static_cast<char>('a' + (seed >> 16) % 26);
+  }
+  text += '/';
+
+  std::set<StringPattern::ID> result1;
+  matcher.Match(text, &result1);
+  EXPECT_EQ(1U, result1.size());
+  EXPECT_TRUE(ContainsKey(result1, text[text.size() - 22]));
+
+  // Short texts are still matched correctly afterwards.
+  std::set<StringPattern::ID> result2;
+  matcher.Match("http://example.com/abcdefghijklmnopqrstuvwxyz/", &result2);
+  EXPECT_EQ(1U, result2.size());
+  EXPECT_TRUE(ContainsKey(result2, 'f'));
+}
+
 }  // namespace url_matcher
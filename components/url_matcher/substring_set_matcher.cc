@@ -19,6 +19,12 @@ bool ComparePatterns(const StringPattern* a, const StringPattern* b) {
   return a->pattern() < b->pattern();
 }
 
+// Compare the edges of an Aho-Corasick node by their labels.
+bool CompareEdgeLabels(const std::pair<char, uint32>& a,
+                       const std::pair<char, uint32>& b) {
+  return a.first < b.first;
+}
+
 // Given the set of patterns, compute how many nodes will the corresponding
 // Aho-Corasick tree have. Note that |patterns| need to be sorted.
 uint32 TreeSize(const std::vector<const StringPattern*>& patterns) {
@@ -123,8 +129,11 @@ bool SubstringSetMatcher::Match(const std::string& text,
     }
     if (edge_from_current != AhoCorasickNode::kNoSuchEdge) {
       current_node = edge_from_current;
-      matches->insert(tree_[current_node].matches().begin(),
-                      tree_[current_node].matches().end());
+      for (uint32 node = current_node; node != AhoCorasickNode::kNoSuchEdge;
+           node = tree_[node].output()) {
+        matches->insert(tree_[node].matches().begin(),
+                        tree_[node].matches().end());
+      }
     } else {
       DCHECK_EQ(0u, current_node);
     }
@@ -224,7 +233,16 @@ void SubstringSetMatcher::CreateFailureEdges() {
               ? edge_from_failure
               : 0;
       tree_[leads_to].set_failure(follow_in_case_of_failure);
-      tree_[leads_to].AddMatches(tree_[follow_in_case_of_failure].matches());
+
+      // The failure node is shallower, so its output edge is already set.
+      // Matches at the root are reported by Match() up front.
+      const AhoCorasickNode& failure_node = tree_[follow_in_case_of_failure];
+      if (follow_in_case_of_failure == 0)
+        tree_[leads_to].set_output(AhoCorasickNode::kNoSuchEdge);
+      else if (!failure_node.matches().empty())
+        tree_[leads_to].set_output(follow_in_case_of_failure);
+      else
+        tree_[leads_to].set_output(failure_node.output());
     }
   }
 }
@@ -232,7 +250,8 @@ void SubstringSetMatcher::CreateFailureEdges() {
 const uint32 SubstringSetMatcher::AhoCorasickNode::kNoSuchEdge = ~0;
 
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode()
-    : failure_(kNoSuchEdge) {}
+    : failure_(kNoSuchEdge),
+      output_(kNoSuchEdge) {}
 
 SubstringSetMatcher::AhoCorasickNode::~AhoCorasickNode() {}
 
@@ -240,6 +259,7 @@ SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode(
     const SubstringSetMatcher::AhoCorasickNode& other)
     : edges_(other.edges_),
       failure_(other.failure_),
+      output_(other.output_),
       matches_(other.matches_) {}
 
 SubstringSetMatcher::AhoCorasickNode&
@@ -247,26 +267,28 @@ SubstringSetMatcher::AhoCorasickNode::operator=(
     const SubstringSetMatcher::AhoCorasickNode& other) {
   edges_ = other.edges_;
   failure_ = other.failure_;
+  output_ = other.output_;
   matches_ = other.matches_;
   return *this;
 }
 
 uint32 SubstringSetMatcher::AhoCorasickNode::GetEdge(char c) const {
-  Edges::const_iterator i = edges_.find(c);
-  return i == edges_.end() ? kNoSuchEdge : i->second;
+  Edges::const_iterator i = std::lower_bound(
+      edges_.begin(), edges_.end(), std::make_pair(c, 0u), CompareEdgeLabels);
+  return (i == edges_.end() || i->first != c) ? kNoSuchEdge : i->second;
 }
 
 void SubstringSetMatcher::AhoCorasickNode::SetEdge(char c, uint32 node) {
-  edges_[c] = node;
+  Edges::iterator i = std::lower_bound(
+      edges_.begin(), edges_.end(), std::make_pair(c, 0u), CompareEdgeLabels);
+  if (i != edges_.end() && i->first == c)
+    i->second = node;
+  else
+    edges_.insert(i, std::make_pair(c, node));
 }
 
 void SubstringSetMatcher::AhoCorasickNode::AddMatch(StringPattern::ID id) {
   matches_.insert(id);
 }
 
-void SubstringSetMatcher::AhoCorasickNode::AddMatches(
-    const SubstringSetMatcher::AhoCorasickNode::Matches& matches) {
-  matches_.insert(matches.begin(), matches.end());
-}
-
 }  // namespace url_matcher
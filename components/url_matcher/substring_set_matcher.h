@@ -79,10 +79,19 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // If your brain thinks "Forget it, let's go shopping.", don't worry.
   // Take a nap and read an introductory text on the Aho Corasick algorithm.
   // It will make sense. Eventually.
+  //
+  // Rather than copying the matches of the nodes reachable by failure edges
+  // into every node, each node only stores the matches of the patterns ending
+  // there, plus an output edge to the nearest node along its failure edges
+  // that has matches of its own. Match() reports matches by following the
+  // output edges, which keeps the tree small for large sets of patterns that
+  // are suffixes of each other.
   class AhoCorasickNode {
    public:
     // Key: label of the edge, value: node index in |tree_| of parent class.
-    typedef std::map<char, uint32> Edges;
+    // Kept sorted by label; most nodes only have a handful of edges, so this
+    // is much more compact than a map.
+    typedef std::vector<std::pair<char, uint32> > Edges;
     typedef std::set<StringPattern::ID> Matches;
 
     static const uint32 kNoSuchEdge;  // Represents an invalid node index.
@@ -99,8 +108,10 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     uint32 failure() const { return failure_; }
     void set_failure(uint32 failure) { failure_ = failure; }
 
+    uint32 output() const { return output_; }
+    void set_output(uint32 output) { output_ = output; }
+
     void AddMatch(StringPattern::ID id);
-    void AddMatches(const Matches& matches);
     const Matches& matches() const { return matches_; }
 
    private:
@@ -110,7 +121,11 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     // Node index that failure edge leads to.
     uint32 failure_;
 
-    // Identifiers of matches.
+    // Node index of the closest node along the failure edges (not counting
+    // the root) that has matches, or kNoSuchEdge if there is none.
+    uint32 output_;
+
+    // Identifiers of the patterns that end at this node.
     Matches matches_;
   };
 
@@ -121,6 +121,38 @@ TEST(SubstringSetMatcherTest, TestMatcher) {
   TestTwoPatterns("abcde", std::string(), "abcdef", true, false);
 }
 
+// Tests that matches are found through a chain of output edges, including
+// across nodes which have no matches of their own.
+TEST(SubstringSetMatcherTest, SuffixChain) {
+  SubstringSetMatcher matcher;
+
+  StringPattern pattern_1("xabcd", 1);
+  StringPattern pattern_2("bcd", 2);
+  StringPattern pattern_3("d", 3);
+  StringPattern pattern_4("cde", 4);
+
+  std::vector<const StringPattern*> patterns;
+  patterns.push_back(&pattern_1);
+  patterns.push_back(&pattern_2);
+  patterns.push_back(&pattern_3);
+  patterns.push_back(&pattern_4);
+  matcher.RegisterPatterns(patterns);
+
+  std::set<int> matches;
+  matcher.Match("xabcd", &matches);
+  EXPECT_EQ(3u, matches.size());
+  EXPECT_TRUE(matches.end() != matches.find(1));
+  EXPECT_TRUE(matches.end() != matches.find(2));
+  EXPECT_TRUE(matches.end() != matches.find(3));
+
+  matches.clear();
+  matcher.Match("abcde", &matches);
+  EXPECT_EQ(3u, matches.size());
+  EXPECT_TRUE(matches.end() != matches.find(2));
+  EXPECT_TRUE(matches.end() != matches.find(3));
+  EXPECT_TRUE(matches.end() != matches.find(4));
+}
+
 TEST(SubstringSetMatcherTest, RegisterAndRemove) {
   SubstringSetMatcher matcher;
 
@@ -55,6 +55,13 @@ const size_t VisitedLinkMaster::kBigDeleteThreshold = 64;
 
 namespace {
 
+// Load limits for good performance/space. We are pretty conservative about
+// keeping the table not very full. This is because we use linear probing
+// which increases the likelihood of clumps of entries which will reduce
+// performance.
+const float kMaxTableLoad = 0.5f;  // Grow when we're > this full.
+const float kMinTableLoad = 0.2f;  // Shrink when we're < this full.
+
 // Fills the given salt structure with some quasi-random values
 // It is not necessary to generate a cryptographically strong random string,
 // only that it be reasonably different for different users.
@@ -304,8 +311,14 @@ void VisitedLinkMaster::AddURLs(const std::vector<GURL>& url) {
   for (std::vector<GURL>::const_iterator i = url.begin();
        i != url.end(); ++i) {
     Hash index = TryToAddURL(*i);
-    if (!table_builder_.get() && index != null_hash_)
-      ResizeTableIfNecessary();
+    if (!table_builder_.get() && index != null_hash_ &&
+        ComputeTableLoad() >= kMaxTableLoad) {
+      // Grow the table enough for the rest of the batch as well, so a big
+      // batch is copied and sent to every renderer once instead of at each
+      // step of the growth.
+      int32 remaining = static_cast<int32>(url.end() - i) - 1;
+      ResizeTable(NewTableSizeForCount(used_items_ + remaining));
+    }
   }
 
   // Keeps the file on disk up-to-date.
@@ -733,23 +746,16 @@ void VisitedLinkMaster::FreeURLTable() {
 bool VisitedLinkMaster::ResizeTableIfNecessary() {
   DCHECK(table_length_ > 0) << "Must have a table";
 
-  // Load limits for good performance/space. We are pretty conservative about
-  // keeping the table not very full. This is because we use linear probing
-  // which increases the likelihood of clumps of entries which will reduce
-  // performance.
-  const float max_table_load = 0.5f;  // Grow when we're > this full.
-  const float min_table_load = 0.2f;  // Shrink when we're < this full.
-
   float load = ComputeTableLoad();
-  if (load < max_table_load &&
+  if (load < kMaxTableLoad &&
       (table_length_ <= static_cast<float>(kDefaultTableSize) ||
-       load > min_table_load))
+       load > kMinTableLoad))
     return false;
 
   // Table needs to grow or shrink.
   int new_size = NewTableSizeForCount(used_items_);
   DCHECK(new_size > used_items_);
-  DCHECK(load <= min_table_load || new_size > table_length_);
+  DCHECK(load <= kMinTableLoad || new_size > table_length_);
   ResizeTable(new_size);
   return true;
 }
@@ -92,6 +92,10 @@
 #include <glib-object.h>
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include "content/browser/tracing/startup_sampling_profiler.h"
+#endif
+
 #if defined(OS_LINUX) && defined(USE_UDEV)
 #include "content/browser/device_monitor_udev.h"
 #elif defined(OS_MACOSX) && !defined(OS_IOS)
@@ -129,6 +133,11 @@
 namespace content {
 namespace {
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// How often --trace-startup-sampling-profile samples the browser threads.
+const int kStartupSamplingProfileIntervalMs = 10;
+#endif
+
 #if defined(OS_POSIX) && !defined(OS_MACOSX) && !defined(OS_ANDROID)
 void SetupSandbox(const CommandLine& parsed_command_line) {
   TRACE_EVENT0("startup", "SetupSandbox");
@@ -752,6 +761,10 @@ void BrowserMainLoop::ShutdownThreadsAndCleanUp() {
 
   trace_memory_controller_.reset();
   system_stats_monitor_.reset();
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Unregisters the IO thread, so must happen before it stops.
+  startup_sampling_profiler_.reset();
+#endif
 
 #if !defined(OS_IOS)
   // Destroying the GpuProcessHostUIShims on the UI thread posts a task to
@@ -929,6 +942,11 @@ int BrowserMainLoop::BrowserThreadsStarted() {
   indexed_db_thread_->Start();
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  if (startup_sampling_profiler_)
+    startup_sampling_profiler_->RegisterIOThread();
+#endif
+
 #if defined(OS_ANDROID)
   // Up the priority of anything that touches with display tasks
   // (this thread is UI thread, and io_thread_ is for IPCs).
@@ -1117,6 +1135,18 @@ void BrowserMainLoop::InitStartupTracing(const CommandLine& command_line) {
     delay_secs = 5;
   }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  if (command_line.HasSwitch(switches::kTraceStartupSamplingProfile)) {
+    startup_sampling_profiler_.reset(new StartupSamplingProfiler);
+    if (!startup_sampling_profiler_->Start(
+            base::TimeDelta::FromMilliseconds(
+                kStartupSamplingProfileIntervalMs))) {
+      LOG(ERROR) << "Could not start the startup sampling profiler";
+      startup_sampling_profiler_.reset();
+    }
+  }
+#endif
+
   BrowserThread::PostDelayedTask(
       BrowserThread::UI, FROM_HERE,
       base::Bind(&BrowserMainLoop::EndStartupTracing,
@@ -1128,6 +1158,13 @@ void BrowserMainLoop::EndStartupTracing(const base::FilePath& trace_file) {
   is_tracing_startup_ = false;
   TracingController::GetInstance()->DisableRecording(
       trace_file, TracingController::TracingFileResultCallback());
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  if (startup_sampling_profiler_) {
+    startup_sampling_profiler_->StopAndWrite(
+        trace_file.AddExtension(FILE_PATH_LITERAL("samples")));
+    startup_sampling_profiler_.reset();
+  }
+#endif
 }
 
 }  // namespace content
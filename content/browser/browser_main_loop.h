@@ -44,6 +44,7 @@ class BrowserThreadImpl;
 class MediaStreamManager;
 class ResourceDispatcherHostImpl;
 class SpeechRecognitionManagerImpl;
+class StartupSamplingProfiler;
 class StartupTaskRunner;
 class SystemMessageWindowWin;
 struct MainFunctionParams;
@@ -178,6 +179,9 @@ class CONTENT_EXPORT BrowserMainLoop {
   scoped_ptr<MemoryObserver> memory_observer_;
   scoped_ptr<base::debug::TraceMemoryController> trace_memory_controller_;
   scoped_ptr<base::debug::TraceEventSystemStatsMonitor> system_stats_monitor_;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  scoped_ptr<StartupSamplingProfiler> startup_sampling_profiler_;
+#endif
 
   bool is_tracing_startup_;
 
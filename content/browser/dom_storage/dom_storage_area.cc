@@ -134,8 +134,13 @@ bool DOMStorageArea::SetItem(const base::string16& key,
   if (is_shutdown_)
     return false;
   InitialImportIfNeeded();
-  if (!map_->HasOneRef())
+  if (!map_->HasOneRef()) {
+    // The map is shared with a clone; don't copy what may be megabytes of
+    // values only to have the write fail.
+    if (!map_->CanSetItem(key, value))
+      return false;
     map_ = map_->DeepCopy();
+  }
   bool success = map_->SetItem(key, value, old_value);
   if (success && backing_) {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
@@ -149,8 +154,12 @@ bool DOMStorageArea::RemoveItem(const base::string16& key,
   if (is_shutdown_)
     return false;
   InitialImportIfNeeded();
-  if (!map_->HasOneRef())
+  if (!map_->HasOneRef()) {
+    // As in SetItem(), only copy the shared map if this changes it.
+    if (map_->GetItem(key).is_null())
+      return false;
     map_ = map_->DeepCopy();
+  }
   bool success = map_->RemoveItem(key, old_value);
   if (success && backing_) {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
@@ -97,6 +97,10 @@ TEST_F(DOMStorageAreaTest, DOMStorageAreaBasics) {
   EXPECT_EQ(area->Key(0).string(), copy->Key(0).string());
   EXPECT_EQ(copy->map_.get(), area->map_.get());
 
+  // Writes that change nothing don't copy the map.
+  EXPECT_FALSE(area->RemoveItem(ASCIIToUTF16("missing"), &old_value));
+  EXPECT_EQ(copy->map_.get(), area->map_.get());
+
   // But will deep copy-on-write as needed.
   EXPECT_TRUE(area->RemoveItem(kKey, &old_value));
   EXPECT_NE(copy->map_.get(), area->map_.get());
@@ -26,6 +26,11 @@ namespace content {
 const int kUpdatePeriodMs = 500;
 const int kMaxTimeBlockingFileThreadMs = 1000;
 
+// Buffers read from the stream are gathered until they add up to this many
+// bytes, so that a fast download isn't written and hashed in many small
+// pieces. Larger buffers are written as they are.
+const size_t kMaxCoalescedWriteSize = 256 * 1024;
+
 int DownloadFile::number_active_objects_ = 0;
 
 DownloadFileImpl::DownloadFileImpl(
@@ -226,18 +231,30 @@ void DownloadFileImpl::StreamActive() {
       case ByteStreamReader::STREAM_HAS_DATA:
         {
           ++num_buffers;
-          base::TimeTicks write_start(base::TimeTicks::Now());
-          reason = AppendDataToFile(
-              incoming_data.get()->data(), incoming_data_size);
-          disk_writes_time_ += (base::TimeTicks::Now() - write_start);
+          if (write_buffer_.size() + incoming_data_size >
+              kMaxCoalescedWriteSize) {
+            reason = FlushWriteBuffer();
+          }
+          if (reason == DOWNLOAD_INTERRUPT_REASON_NONE) {
+            if (incoming_data_size >= kMaxCoalescedWriteSize) {
+              reason = WriteToFile(incoming_data.get()->data(),
+                                   incoming_data_size);
+            } else {
+              write_buffer_.append(incoming_data.get()->data(),
+                                   incoming_data_size);
+            }
+          }
           bytes_seen_ += incoming_data_size;
           total_incoming_data_size += incoming_data_size;
         }
         break;
       case ByteStreamReader::STREAM_COMPLETE:
         {
-          reason = static_cast<DownloadInterruptReason>(
-              stream_reader_->GetStatus());
+          reason = FlushWriteBuffer();
+          if (reason == DOWNLOAD_INTERRUPT_REASON_NONE) {
+            reason = static_cast<DownloadInterruptReason>(
+                stream_reader_->GetStatus());
+          }
           SendUpdate();
           base::TimeTicks close_start(base::TimeTicks::Now());
           file_.Finish();
@@ -257,6 +274,13 @@ void DownloadFileImpl::StreamActive() {
            reason == DOWNLOAD_INTERRUPT_REASON_NONE &&
            now - start <= delta);
 
+  // Don't hold on to data across tasks; progress updates and errors should
+  // reflect everything read so far.
+  if (reason == DOWNLOAD_INTERRUPT_REASON_NONE)
+    reason = FlushWriteBuffer();
+  else
+    write_buffer_.clear();
+
   // If we're stopping to yield the thread, post a task so we come back.
   if (state == ByteStreamReader::STREAM_HAS_DATA &&
       now - start > delta) {
@@ -305,6 +329,23 @@ void DownloadFileImpl::StreamActive() {
   }
 }
 
+DownloadInterruptReason DownloadFileImpl::WriteToFile(const char* data,
+                                                      size_t data_len) {
+  base::TimeTicks write_start(base::TimeTicks::Now());
+  DownloadInterruptReason reason = AppendDataToFile(data, data_len);
+  disk_writes_time_ += (base::TimeTicks::Now() - write_start);
+  return reason;
+}
+
+DownloadInterruptReason DownloadFileImpl::FlushWriteBuffer() {
+  if (write_buffer_.empty())
+    return DOWNLOAD_INTERRUPT_REASON_NONE;
+  DownloadInterruptReason reason =
+      WriteToFile(write_buffer_.data(), write_buffer_.size());
+  write_buffer_.clear();
+  return reason;
+}
+
 void DownloadFileImpl::SendUpdate() {
   BrowserThread::PostTask(
       BrowserThread::UI, FROM_HERE,
@@ -78,6 +78,12 @@ class CONTENT_EXPORT DownloadFileImpl : virtual public DownloadFile {
   // handled.
   void StreamActive();
 
+  // Appends |data| to the file, accounting for the time it takes.
+  DownloadInterruptReason WriteToFile(const char* data, size_t data_len);
+
+  // Writes out and empties |write_buffer_|.
+  DownloadInterruptReason FlushWriteBuffer();
+
   // The base file instance.
   BaseFile file_;
 
@@ -90,6 +96,10 @@ class CONTENT_EXPORT DownloadFileImpl : virtual public DownloadFile {
   // with DownloadFile and get rid of BaseFile.
   scoped_ptr<ByteStreamReader> stream_reader_;
 
+  // Small buffers read from |stream_reader_| in one StreamActive() call, to
+  // be written with a single AppendDataToFile() before it returns.
+  std::string write_buffer_;
+
   // Used to trigger progress updates.
   scoped_ptr<base::RepeatingTimer<DownloadFileImpl> > update_timer_;
 
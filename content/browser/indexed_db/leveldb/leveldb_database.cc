@@ -4,14 +4,17 @@
 
 #include "content/browser/indexed_db/leveldb/leveldb_database.h"
 
+#include <algorithm>
 #include <cerrno>
 
 #include "base/basictypes.h"
 #include "base/files/file.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -22,6 +25,7 @@
 #include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/env_idb.h"
 #include "third_party/leveldatabase/src/helpers/memenv/memenv.h"
+#include "third_party/leveldatabase/src/include/leveldb/cache.h"
 #include "third_party/leveldatabase/src/include/leveldb/comparator.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/leveldatabase/src/include/leveldb/env.h"
@@ -47,6 +51,32 @@ static const bool kSyncWrites = true;
 static const bool kSyncWrites = true;
 #endif
 
+// All IndexedDB databases share one block cache, so that many origins with
+// small databases don't each get (and mostly waste) leveldb's default 8MB
+// cache, while the few large, busy databases can use more than that.
+static const int64 kMinBlockCacheBytes = 8 * 1024 * 1024;
+static const int64 kMaxBlockCacheBytes = 64 * 1024 * 1024;
+
+class IDBBlockCache {
+ public:
+  IDBBlockCache() {
+    int64 capacity = base::SysInfo::AmountOfPhysicalMemory() / 128;
+    capacity = std::max(kMinBlockCacheBytes,
+                        std::min(kMaxBlockCacheBytes, capacity));
+    cache_.reset(leveldb::NewLRUCache(static_cast<size_t>(capacity)));
+  }
+
+  leveldb::Cache* cache() { return cache_.get(); }
+
+ private:
+  scoped_ptr<leveldb::Cache> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(IDBBlockCache);
+};
+
+static base::LazyInstance<IDBBlockCache>::Leaky g_block_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 static leveldb::Slice MakeSlice(const StringPiece& s) {
   return leveldb::Slice(s.begin(), s.size());
 }
@@ -105,6 +135,12 @@ static leveldb::Status OpenDB(leveldb::Comparator* comparator,
   // https://code.google.com/p/chromium/issues/detail?id=227313#c11
   options.max_open_files = 80;
   options.env = env;
+  options.block_cache = g_block_cache.Get().cache();
+
+  // No filter_policy: leveldb's bloom filters hash the raw key bytes, which
+  // is only correct when the comparator's equality is byte equality.
+  // IndexedDB's isn't (number keys 0 and -0 encode differently but compare
+  // equal), so a filter would have to hash a canonical encoding instead.
 
   // ChromiumEnv assumes UTF8, converts back to FilePath before using.
   return leveldb::DB::Open(options, path.AsUTF8Unsafe(), db);
@@ -227,6 +263,30 @@ static void ParseAndHistogramCorruptionDetails(
       base::HistogramBase::kUmaTargetedHistogramFlag)->Add(error);
 }
 
+// Records how many tables a point read may have to consult: every level-0
+// table (they overlap), plus one in each deeper level that has any. A large
+// value means compaction is falling behind.
+static void HistogramReadAmplification(leveldb::DB* db) {
+  int read_amplification = 0;
+  for (int level = 0;; ++level) {
+    std::string value;
+    // GetProperty() fails once |level| is past the last level.
+    if (!db->GetProperty("leveldb.num-files-at-level" +
+                             base::IntToString(level),
+                         &value))
+      break;
+    int num_files = 0;
+    if (!base::StringToInt(value, &num_files))
+      return;
+    if (level == 0)
+      read_amplification += num_files;
+    else if (num_files > 0)
+      ++read_amplification;
+  }
+  UMA_HISTOGRAM_COUNTS_100("WebCore.IndexedDB.LevelDB.OpenReadAmplification",
+                           read_amplification);
+}
+
 static void HistogramLevelDBError(const std::string& histogram_name,
                                   const leveldb::Status& s) {
   if (s.ok()) {
@@ -284,6 +344,7 @@ leveldb::Status LevelDBDatabase::Open(const base::FilePath& file_name,
   }
 
   CheckFreeSpace("Success", file_name);
+  HistogramReadAmplification(db);
 
   (*result).reset(new LevelDBDatabase);
   (*result)->db_ = make_scoped_ptr(db);
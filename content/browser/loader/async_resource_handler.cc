@@ -58,6 +58,24 @@ void InitializeResourceBufferConstants() {
   GetNumericArg("resource-buffer-max-allocation-size", &kMaxAllocationSize);
 }
 
+// Returns the size of the shared memory buffer to use for a response whose
+// body is expected to be |expected_content_size| bytes, or -1 if unknown. The
+// expected size is measured before any content decoding, so leave headroom for
+// it to expand; the buffer is recycled as a ring either way, so a response
+// that outgrows it only costs extra ACK round trips.
+int CalcBufferSize(int64 expected_content_size) {
+  if (expected_content_size < 0)
+    return kBufferSize;
+  int64 size = std::max(4 * expected_content_size,
+                        static_cast<int64>(2 * kMaxAllocationSize));
+  if (size >= kBufferSize)
+    return kBufferSize;
+  // Keep the size a multiple of the allocation sizes.
+  return static_cast<int>(
+      (size + kMaxAllocationSize - 1) / kMaxAllocationSize *
+      kMaxAllocationSize);
+}
+
 int CalcUsedPercentage(int bytes_read, int buffer_size) {
   double ratio = static_cast<double>(bytes_read) / buffer_size;
   return static_cast<int>(ratio * 100.0 + 0.5);  // Round to nearest integer.
@@ -385,9 +403,10 @@ bool AsyncResourceHandler::EnsureResourceBufferIsInitialized() {
   }
 
   buffer_ = new ResourceBuffer();
-  return buffer_->Initialize(kBufferSize,
-                             kMinAllocationSize,
-                             kMaxAllocationSize);
+  return buffer_->Initialize(
+      CalcBufferSize(request()->GetExpectedContentSize()),
+      kMinAllocationSize,
+      kMaxAllocationSize);
 }
 
 void AsyncResourceHandler::ResumeIfDeferred() {
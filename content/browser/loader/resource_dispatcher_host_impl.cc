@@ -1310,8 +1310,11 @@ ResourceRequestInfoImpl* ResourceDispatcherHostImpl::CreateRequestInfo(
 
 void ResourceDispatcherHostImpl::OnRenderViewHostCreated(
     int child_id,
-    int route_id) {
+    int route_id,
+    bool is_visible) {
   scheduler_->OnClientCreated(child_id, route_id);
+  if (!is_visible)
+    scheduler_->OnVisibilityChanged(child_id, route_id, false);
 }
 
 void ResourceDispatcherHostImpl::OnRenderViewHostDeleted(
@@ -1321,6 +1324,21 @@ void ResourceDispatcherHostImpl::OnRenderViewHostDeleted(
   CancelRequestsForRoute(child_id, route_id);
 }
 
+void ResourceDispatcherHostImpl::OnRenderViewHostVisibilityChanged(
+    int child_id,
+    int route_id,
+    bool is_visible) {
+  scheduler_->OnVisibilityChanged(child_id, route_id, is_visible);
+}
+
+void ResourceDispatcherHostImpl::SetRouteExemptFromHiddenLimit(
+    int child_id,
+    int route_id,
+    bool is_exempt) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  scheduler_->OnHiddenLimitExemptionChanged(child_id, route_id, is_exempt);
+}
+
 // This function is only used for saving feature.
 void ResourceDispatcherHostImpl::BeginSaveFile(
     const GURL& url,
@@ -93,6 +93,8 @@ class CONTENT_EXPORT ResourceDispatcherHostImpl
   virtual void BlockRequestsForRoute(int child_id, int route_id) OVERRIDE;
   virtual void ResumeBlockedRequestsForRoute(
       int child_id, int route_id) OVERRIDE;
+  virtual void SetRouteExemptFromHiddenLimit(
+      int child_id, int route_id, bool is_exempt) OVERRIDE;
 
   // Puts the resource dispatcher host in an inactive state (unable to begin
   // new requests).  Cancels all pending requests.
@@ -162,11 +164,16 @@ class CONTENT_EXPORT ResourceDispatcherHostImpl
   }
 
   // Called when a RenderViewHost is created.
-  void OnRenderViewHostCreated(int child_id, int route_id);
+  void OnRenderViewHostCreated(int child_id, int route_id, bool is_visible);
 
   // Called when a RenderViewHost is deleted.
   void OnRenderViewHostDeleted(int child_id, int route_id);
 
+  // Called when a RenderViewHost is shown or hidden.
+  void OnRenderViewHostVisibilityChanged(int child_id,
+                                         int route_id,
+                                         bool is_visible);
+
   // Force cancels any pending requests for the given process.
   void CancelRequestsForProcess(int child_id);
 
@@ -4,6 +4,7 @@
 
 #include "content/browser/loader/resource_scheduler.h"
 
+#include "base/metrics/field_trial.h"
 #include "base/stl_util.h"
 #include "content/common/resource_messages.h"
 #include "content/browser/loader/resource_message_delegate.h"
@@ -22,6 +23,13 @@ namespace content {
 
 static const size_t kMaxNumDelayableRequestsPerClient = 10;
 static const size_t kMaxNumDelayableRequestsPerHost = 6;
+// Hidden clients get a smaller share of the connections so that background
+// tabs don't compete with the visible tab for bandwidth.
+static const size_t kMaxNumDelayableRequestsPerHiddenClient = 2;
+// Hidden clients are only held to the smaller limit in this field trial group.
+static const char kHiddenClientFieldTrialName[] =
+    "ResourceSchedulerHiddenClients";
+static const char kHiddenClientFieldTrialThrottleGroup[] = "Throttle";
 
 // A thin wrapper around net::PriorityQueue that deals with
 // ScheduledResourceRequests instead of PriorityQueue::Pointers.
@@ -178,11 +186,17 @@ class ResourceScheduler::ScheduledResourceRequest
 
 // Each client represents a tab.
 struct ResourceScheduler::Client {
-  Client() : has_body(false), using_spdy_proxy(false) {}
+  Client()
+      : has_body(false),
+        using_spdy_proxy(false),
+        is_visible(true),
+        is_exempt_from_hidden_limit(false) {}
   ~Client() {}
 
   bool has_body;
   bool using_spdy_proxy;
+  bool is_visible;
+  bool is_exempt_from_hidden_limit;
   RequestQueue pending_requests;
   RequestSet in_flight_requests;
 };
@@ -310,6 +324,53 @@ void ResourceScheduler::OnWillInsertBody(int child_id, int route_id) {
   LoadAnyStartablePendingRequests(client);
 }
 
+void ResourceScheduler::OnVisibilityChanged(int child_id,
+                                            int route_id,
+                                            bool is_visible) {
+  DCHECK(CalledOnValidThread());
+  ClientId client_id = MakeClientId(child_id, route_id);
+
+  ClientMap::iterator it = client_map_.find(client_id);
+  if (it == client_map_.end()) {
+    // The client was likely deleted shortly before we received this IPC.
+    return;
+  }
+
+  Client* client = it->second;
+  if (client->is_visible == is_visible)
+    return;
+  // Outside the field trial, hidden clients load like visible ones.
+  if (!is_visible &&
+      base::FieldTrialList::FindFullName(kHiddenClientFieldTrialName) !=
+          kHiddenClientFieldTrialThrottleGroup) {
+    return;
+  }
+
+  client->is_visible = is_visible;
+  // Requests already in flight are left alone when a client is hidden. Once
+  // it is shown again, it may load up to the visible limit.
+  if (is_visible)
+    LoadAnyStartablePendingRequests(client);
+}
+
+void ResourceScheduler::OnHiddenLimitExemptionChanged(int child_id,
+                                                      int route_id,
+                                                      bool is_exempt) {
+  DCHECK(CalledOnValidThread());
+  ClientId client_id = MakeClientId(child_id, route_id);
+
+  ClientMap::iterator it = client_map_.find(client_id);
+  if (it == client_map_.end()) {
+    // The client was likely deleted shortly before we received this IPC.
+    return;
+  }
+
+  Client* client = it->second;
+  client->is_exempt_from_hidden_limit = is_exempt;
+  if (is_exempt)
+    LoadAnyStartablePendingRequests(client);
+}
+
 void ResourceScheduler::OnReceivedSpdyProxiedHttpResponse(
     int child_id,
     int route_id) {
@@ -454,7 +515,8 @@ void ResourceScheduler::GetNumDelayableRequestsInFlight(
 //   * If no high priority requests are in flight, start loading low priority
 //     requests.
 //   * Once the renderer has a <body>, start loading delayable requests.
-//   * Never exceed 10 delayable requests in flight per client.
+//   * Never exceed 10 delayable requests in flight per client, or 2 if the
+//     client is hidden.
 //   * Never exceed 6 delayable requests for a given host.
 //   * Prior to <body>, allow one delayable request to load at a time.
 ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
@@ -496,7 +558,11 @@ ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
                                   &num_delayable_requests_in_flight,
                                   &num_requests_in_flight_for_host);
 
-  if (num_delayable_requests_in_flight >= kMaxNumDelayableRequestsPerClient) {
+  size_t max_num_delayable_requests =
+      client->is_visible || client->is_exempt_from_hidden_limit ?
+          kMaxNumDelayableRequestsPerClient :
+          kMaxNumDelayableRequestsPerHiddenClient;
+  if (num_delayable_requests_in_flight >= max_num_delayable_requests) {
     return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
   }
 
@@ -69,6 +69,17 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // Called when a renderer is destroyed.
   void OnClientDeleted(int child_id, int route_id);
 
+  // Called when a renderer is shown or hidden. Clients are visible when they
+  // are created. In the ResourceSchedulerHiddenClients field trial, hidden
+  // clients load fewer delayable requests at a time.
+  void OnVisibilityChanged(int child_id, int route_id, bool is_visible);
+
+  // Called when a renderer starts or stops loading like a visible one while
+  // it is hidden, as prerenders do.
+  void OnHiddenLimitExemptionChanged(int child_id,
+                                     int route_id,
+                                     bool is_exempt);
+
   // Signals from IPC messages directly from the renderers:
 
   // Called when a client navigates to a new main document.
@@ -6,6 +6,7 @@
 
 #include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/field_trial.h"
 #include "base/strings/string_number_conversions.h"
 #include "content/browser/browser_thread_impl.h"
 #include "content/browser/loader/resource_dispatcher_host_impl.h"
@@ -478,6 +479,72 @@ TEST_F(ResourceSchedulerTest, SpdyProxySchedulesImmediately) {
   EXPECT_TRUE(after->started());
 }
 
+TEST_F(ResourceSchedulerTest, HiddenClientLoadsFewerDelayableRequests) {
+  base::FieldTrialList field_trial_list(NULL);
+  base::FieldTrialList::CreateFieldTrial("ResourceSchedulerHiddenClients",
+                                         "Throttle");
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+  scheduler_.OnVisibilityChanged(kChildId, kRouteId, false);
+
+  const int kMaxNumDelayableRequestsPerHiddenClient = 2;  // Should match .cc.
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerHiddenClient; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows[i]->started());
+  }
+
+  scoped_ptr<TestRequest> low(NewRequest("http://host_new/low", net::LOWEST));
+  EXPECT_FALSE(low->started());
+
+  // High priority requests aren't limited.
+  scoped_ptr<TestRequest> high(NewRequest("http://host/high", net::HIGHEST));
+  EXPECT_TRUE(high->started());
+
+  scheduler_.OnVisibilityChanged(kChildId, kRouteId, true);
+  EXPECT_TRUE(low->started());
+}
+
+TEST_F(ResourceSchedulerTest, HiddenClientOutsideFieldTrial) {
+  base::FieldTrialList field_trial_list(NULL);
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+  scheduler_.OnVisibilityChanged(kChildId, kRouteId, false);
+
+  const int kMaxNumDelayableRequestsPerClient = 10;  // Should match .cc.
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerClient; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows[i]->started());
+  }
+}
+
+TEST_F(ResourceSchedulerTest, HiddenClientExemptFromHiddenLimit) {
+  base::FieldTrialList field_trial_list(NULL);
+  base::FieldTrialList::CreateFieldTrial("ResourceSchedulerHiddenClients",
+                                         "Throttle");
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+  scheduler_.OnVisibilityChanged(kChildId, kRouteId, false);
+
+  const int kMaxNumDelayableRequestsPerHiddenClient = 2;  // Should match .cc.
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerHiddenClient; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+  }
+  scoped_ptr<TestRequest> low(NewRequest("http://host_new/low", net::LOWEST));
+  EXPECT_FALSE(low->started());
+
+  // An exempt client, like a prerender, loads as if it were visible.
+  scheduler_.OnHiddenLimitExemptionChanged(kChildId, kRouteId, true);
+  EXPECT_TRUE(low->started());
+
+  scheduler_.OnHiddenLimitExemptionChanged(kChildId, kRouteId, false);
+  scoped_ptr<TestRequest> last(NewRequest("http://host_last/low",
+                                          net::LOWEST));
+  EXPECT_FALSE(last->started());
+}
+
 }  // unnamed namespace
 
 }  // namespace content
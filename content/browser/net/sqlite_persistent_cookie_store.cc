@@ -4,7 +4,6 @@
 
 #include "content/browser/net/sqlite_persistent_cookie_store.h"
 
-#include <list>
 #include <map>
 #include <set>
 #include <utility>
@@ -19,8 +18,10 @@
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/lock.h"
@@ -34,6 +35,8 @@
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_constants.h"
 #include "net/cookies/cookie_util.h"
+#include "sql/async_writer.h"
+#include "sql/connection.h"
 #include "sql/error_delegate_util.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
@@ -46,6 +49,32 @@ using base::Time;
 
 namespace content {
 
+namespace {
+
+// Commit every 30 seconds.
+const int kCommitIntervalMs = 30 * 1000;
+// Commit right away if we have more than 512 outstanding operations.
+const size_t kCommitAfterBatchSize = 512;
+
+// In this field trial group the cookie database uses write-ahead logging.
+const char kWriteAheadLoggingFieldTrialName[] = "CookieDBWriteAheadLogging";
+const char kWriteAheadLoggingFieldTrialEnabledGroup[] = "Enabled";
+
+void RecordBackingStoreUpdateResult(size_t num_operations, bool succeeded) {
+  UMA_HISTOGRAM_ENUMERATION("Cookie.BackingStoreUpdateResults",
+                            succeeded ? 0 : 1, 2);
+}
+
+// Cookies are committed in small batches throughout the session, so logging
+// them ahead avoids syncing a rollback journal for each batch. A database
+// opened outside the trial group is converted back to the rollback journal.
+bool UseWriteAheadLogging() {
+  return base::FieldTrialList::FindFullName(kWriteAheadLoggingFieldTrialName) ==
+      kWriteAheadLoggingFieldTrialEnabledGroup;
+}
+
+}  // namespace
+
 // This class is designed to be shared between any client thread and the
 // background task runner. It batches operations and commits them on a timer.
 //
@@ -67,7 +96,7 @@ namespace content {
 // Subsequent to loading, mutations may be queued by any thread using
 // AddCookie, UpdateCookieAccessTime, and DeleteCookie. These are flushed to
 // disk on the BG runner every 30 seconds, 512 operations, or call to Flush(),
-// whichever occurs first.
+// whichever occurs first, by |writer_|.
 class SQLitePersistentCookieStore::Backend
     : public base::RefCountedThreadSafe<SQLitePersistentCookieStore::Backend> {
  public:
@@ -79,7 +108,11 @@ class SQLitePersistentCookieStore::Backend
       quota::SpecialStoragePolicy* special_storage_policy,
       CookieCryptoDelegate* crypto_delegate)
       : path_(path),
-        num_pending_(0),
+        writer_(new sql::AsyncWriter(
+            background_task_runner,
+            NULL,
+            kCommitAfterBatchSize,
+            base::TimeDelta::FromMilliseconds(kCommitIntervalMs))),
         force_keep_session_state_(false),
         initialized_(false),
         corruption_detected_(false),
@@ -90,7 +123,9 @@ class SQLitePersistentCookieStore::Backend
         background_task_runner_(background_task_runner),
         num_priority_waiting_(0),
         total_priority_requests_(0),
-        crypto_(crypto_delegate) {}
+        crypto_(crypto_delegate) {
+    writer_->set_commit_callback(base::Bind(&RecordBackingStoreUpdateResult));
+  }
 
   // Creates or loads the SQLite database.
   void Load(const LoadedCallback& loaded_callback);
@@ -123,31 +158,12 @@ class SQLitePersistentCookieStore::Backend
   // You should call Close() before destructing this object.
   ~Backend() {
     DCHECK(!db_.get()) << "Close should have already been called.";
-    DCHECK(num_pending_ == 0 && pending_.empty());
+    DCHECK_EQ(0u, writer_->num_pending());
   }
 
   // Database upgrade statements.
   bool EnsureDatabaseVersion();
 
-  class PendingOperation {
-   public:
-    typedef enum {
-      COOKIE_ADD,
-      COOKIE_UPDATEACCESS,
-      COOKIE_DELETE,
-    } OperationType;
-
-    PendingOperation(OperationType op, const net::CanonicalCookie& cc)
-        : op_(op), cc_(cc) { }
-
-    OperationType op() const { return op_; }
-    const net::CanonicalCookie& cc() const { return cc_; }
-
-   private:
-    OperationType op_;
-    net::CanonicalCookie cc_;
-  };
-
  private:
   // Creates or loads the SQLite database on background runner.
   void LoadAndNotifyInBackground(const LoadedCallback& loaded_callback,
@@ -193,11 +209,20 @@ class SQLitePersistentCookieStore::Backend
   // Load all cookies for a set of domains/hosts
   bool LoadCookiesForDomains(const std::set<std::string>& key);
 
-  // Batch a cookie operation (add or delete)
-  void BatchOperation(PendingOperation::OperationType op,
-                      const net::CanonicalCookie& cc);
-  // Commit our pending operations to the database.
-  void Commit();
+  // Batch a cookie operation, to be run by |writer_| under |key| (see
+  // sql::AsyncWriter::Enqueue).
+  void BatchOperation(const std::string& key,
+                      const sql::AsyncWriter::Operation& operation);
+  // The operations batched by AddCookie(), UpdateCookieAccessTime() and
+  // DeleteCookie(), run on the background runner when |writer_| commits.
+  bool AddCookieInBackground(const net::CanonicalCookie& cc,
+                             sql::Connection* db);
+  bool UpdateCookieAccessTimeInBackground(const net::CanonicalCookie& cc,
+                                          sql::Connection* db);
+  bool DeleteCookieInBackground(const net::CanonicalCookie& cc,
+                                sql::Connection* db);
+  // Detaches |writer_| and closes |db_|.
+  void ResetDatabase();
   // Close() executed on the background runner.
   void InternalBackgroundClose();
 
@@ -217,12 +242,12 @@ class SQLitePersistentCookieStore::Backend
   scoped_ptr<sql::Connection> db_;
   sql::MetaTable meta_table_;
 
-  typedef std::list<PendingOperation*> PendingOperationsList;
-  PendingOperationsList pending_;
-  PendingOperationsList::size_type num_pending_;
+  // Batches cookie operations into transactions on |db_|, to which it is
+  // attached once the database is initialized.
+  scoped_refptr<sql::AsyncWriter> writer_;
   // True if the persistent store should skip delete on exit rules.
   bool force_keep_session_state_;
-  // Guard |cookies_|, |pending_|, |num_pending_|, |force_keep_session_state_|
+  // Guard |cookies_|, |force_keep_session_state_|
   base::Lock lock_;
 
   // Temporary buffer for cookies loaded from DB. Accumulates cookies to reduce
@@ -572,6 +597,8 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
 
   db_.reset(new sql::Connection);
   db_->set_histogram_tag("Cookie");
+  if (UseWriteAheadLogging())
+    db_->set_write_ahead_logging();
 
   // Unretained to avoid a ref loop with |db_|.
   db_->set_error_callback(
@@ -652,6 +679,7 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
       50);
 
   initialized_ = true;
+  writer_->SetConnection(db_.get());
   return true;
 }
 
@@ -709,8 +737,7 @@ bool SQLitePersistentCookieStore::Backend::LoadCookiesForDomains(
   }
   if (!smt.is_valid()) {
     smt.Clear();  // Disconnect smt_ref from db_.
-    meta_table_.Reset();
-    db_.reset();
+    ResetDatabase();
     return false;
   }
 
@@ -890,7 +917,9 @@ bool SQLitePersistentCookieStore::Backend::EnsureDatabaseVersion() {
 
     meta_table_.Reset();
     db_.reset(new sql::Connection);
-    if (!base::DeleteFile(path_, false) ||
+    if (UseWriteAheadLogging())
+      db_->set_write_ahead_logging();
+    if (!sql::Connection::Delete(path_) ||
         !db_->Open(path_) ||
         !meta_table_.Init(
             db_.get(), kCurrentVersionNumber, kCompatibleVersionNumber)) {
@@ -907,161 +936,122 @@ bool SQLitePersistentCookieStore::Backend::EnsureDatabaseVersion() {
 
 void SQLitePersistentCookieStore::Backend::AddCookie(
     const net::CanonicalCookie& cc) {
-  BatchOperation(PendingOperation::COOKIE_ADD, cc);
+  BatchOperation(std::string(),
+                 base::Bind(&Backend::AddCookieInBackground,
+                            base::Unretained(this), cc));
 }
 
 void SQLitePersistentCookieStore::Backend::UpdateCookieAccessTime(
     const net::CanonicalCookie& cc) {
-  BatchOperation(PendingOperation::COOKIE_UPDATEACCESS, cc);
+  // Only the latest access time of a cookie needs writing.  Running it after
+  // a later delete of the cookie is harmless, and creation times are unique,
+  // so it can't land on a cookie added since.
+  BatchOperation(base::Int64ToString(cc.CreationDate().ToInternalValue()),
+                 base::Bind(&Backend::UpdateCookieAccessTimeInBackground,
+                            base::Unretained(this), cc));
 }
 
 void SQLitePersistentCookieStore::Backend::DeleteCookie(
     const net::CanonicalCookie& cc) {
-  BatchOperation(PendingOperation::COOKIE_DELETE, cc);
+  BatchOperation(std::string(),
+                 base::Bind(&Backend::DeleteCookieInBackground,
+                            base::Unretained(this), cc));
 }
 
+// The operations are bound Unretained: |writer_| only runs them while it is
+// attached to |db_|, which is detached before Close() finishes.
 void SQLitePersistentCookieStore::Backend::BatchOperation(
-    PendingOperation::OperationType op,
-    const net::CanonicalCookie& cc) {
-  // Commit every 30 seconds.
-  static const int kCommitIntervalMs = 30 * 1000;
-  // Commit right away if we have more than 512 outstanding operations.
-  static const size_t kCommitAfterBatchSize = 512;
+    const std::string& key,
+    const sql::AsyncWriter::Operation& operation) {
   DCHECK(!background_task_runner_->RunsTasksOnCurrentThread());
-
-  // We do a full copy of the cookie here, and hopefully just here.
-  scoped_ptr<PendingOperation> po(new PendingOperation(op, cc));
-
-  PendingOperationsList::size_type num_pending;
-  {
-    base::AutoLock locked(lock_);
-    pending_.push_back(po.release());
-    num_pending = ++num_pending_;
-  }
-
-  if (num_pending == 1) {
-    // We've gotten our first entry for this batch, fire off the timer.
-    if (!background_task_runner_->PostDelayedTask(
-            FROM_HERE, base::Bind(&Backend::Commit, this),
-            base::TimeDelta::FromMilliseconds(kCommitIntervalMs))) {
-      NOTREACHED() << "background_task_runner_ is not running.";
-    }
-  } else if (num_pending == kCommitAfterBatchSize) {
-    // We've reached a big enough batch, fire off a commit now.
-    PostBackgroundTask(FROM_HERE, base::Bind(&Backend::Commit, this));
-  }
+  // The cookie is copied into |operation|, and hopefully just there.
+  writer_->Enqueue(key, operation);
 }
 
-void SQLitePersistentCookieStore::Backend::Commit() {
-  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
-
-  PendingOperationsList ops;
-  {
-    base::AutoLock locked(lock_);
-    pending_.swap(ops);
-    num_pending_ = 0;
-  }
-
-  // Maybe an old timer fired or we are already Close()'ed.
-  if (!db_.get() || ops.empty())
-    return;
-
-  sql::Statement add_smt(db_->GetCachedStatement(SQL_FROM_HERE,
+bool SQLitePersistentCookieStore::Backend::AddCookieInBackground(
+    const net::CanonicalCookie& cc,
+    sql::Connection* db) {
+  sql::Statement add_smt(db->GetCachedStatement(SQL_FROM_HERE,
       "INSERT INTO cookies (creation_utc, host_key, name, value, "
       "encrypted_value, path, expires_utc, secure, httponly, last_access_utc, "
       "has_expires, persistent, priority) "
       "VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"));
   if (!add_smt.is_valid())
-    return;
+    return false;
 
-  sql::Statement update_access_smt(db_->GetCachedStatement(SQL_FROM_HERE,
+  cookies_per_origin_[CookieOrigin(cc.Domain(), cc.IsSecure())]++;
+  add_smt.BindInt64(0, cc.CreationDate().ToInternalValue());
+  add_smt.BindString(1, cc.Domain());
+  add_smt.BindString(2, cc.Name());
+  if (crypto_) {
+    std::string encrypted_value;
+    add_smt.BindCString(3, "");  // value
+    crypto_->EncryptString(cc.Value(), &encrypted_value);
+    // BindBlob() immediately makes an internal copy of the data.
+    add_smt.BindBlob(4, encrypted_value.data(),
+                     static_cast<int>(encrypted_value.length()));
+  } else {
+    add_smt.BindString(3, cc.Value());
+    add_smt.BindBlob(4, "", 0);  // encrypted_value
+  }
+  add_smt.BindString(5, cc.Path());
+  add_smt.BindInt64(6, cc.ExpiryDate().ToInternalValue());
+  add_smt.BindInt(7, cc.IsSecure());
+  add_smt.BindInt(8, cc.IsHttpOnly());
+  add_smt.BindInt64(9, cc.LastAccessDate().ToInternalValue());
+  add_smt.BindInt(10, cc.IsPersistent());
+  add_smt.BindInt(11, cc.IsPersistent());
+  add_smt.BindInt(12, CookiePriorityToDBCookiePriority(cc.Priority()));
+  if (!add_smt.Run()) {
+    NOTREACHED() << "Could not add a cookie to the DB.";
+    return false;
+  }
+  return true;
+}
+
+bool SQLitePersistentCookieStore::Backend::UpdateCookieAccessTimeInBackground(
+    const net::CanonicalCookie& cc,
+    sql::Connection* db) {
+  sql::Statement update_access_smt(db->GetCachedStatement(SQL_FROM_HERE,
       "UPDATE cookies SET last_access_utc=? WHERE creation_utc=?"));
   if (!update_access_smt.is_valid())
-    return;
+    return false;
+
+  update_access_smt.BindInt64(0, cc.LastAccessDate().ToInternalValue());
+  update_access_smt.BindInt64(1, cc.CreationDate().ToInternalValue());
+  if (!update_access_smt.Run()) {
+    NOTREACHED() << "Could not update cookie last access time in the DB.";
+    return false;
+  }
+  return true;
+}
 
-  sql::Statement del_smt(db_->GetCachedStatement(SQL_FROM_HERE,
+bool SQLitePersistentCookieStore::Backend::DeleteCookieInBackground(
+    const net::CanonicalCookie& cc,
+    sql::Connection* db) {
+  sql::Statement del_smt(db->GetCachedStatement(SQL_FROM_HERE,
                          "DELETE FROM cookies WHERE creation_utc=?"));
   if (!del_smt.is_valid())
-    return;
-
-  sql::Transaction transaction(db_.get());
-  if (!transaction.Begin())
-    return;
+    return false;
 
-  for (PendingOperationsList::iterator it = ops.begin();
-       it != ops.end(); ++it) {
-    // Free the cookies as we commit them to the database.
-    scoped_ptr<PendingOperation> po(*it);
-    switch (po->op()) {
-      case PendingOperation::COOKIE_ADD:
-        cookies_per_origin_[
-            CookieOrigin(po->cc().Domain(), po->cc().IsSecure())]++;
-        add_smt.Reset(true);
-        add_smt.BindInt64(0, po->cc().CreationDate().ToInternalValue());
-        add_smt.BindString(1, po->cc().Domain());
-        add_smt.BindString(2, po->cc().Name());
-        if (crypto_) {
-          std::string encrypted_value;
-          add_smt.BindCString(3, "");  // value
-          crypto_->EncryptString(po->cc().Value(), &encrypted_value);
-          // BindBlob() immediately makes an internal copy of the data.
-          add_smt.BindBlob(4, encrypted_value.data(),
-                           static_cast<int>(encrypted_value.length()));
-        } else {
-          add_smt.BindString(3, po->cc().Value());
-          add_smt.BindBlob(4, "", 0);  // encrypted_value
-        }
-        add_smt.BindString(5, po->cc().Path());
-        add_smt.BindInt64(6, po->cc().ExpiryDate().ToInternalValue());
-        add_smt.BindInt(7, po->cc().IsSecure());
-        add_smt.BindInt(8, po->cc().IsHttpOnly());
-        add_smt.BindInt64(9, po->cc().LastAccessDate().ToInternalValue());
-        add_smt.BindInt(10, po->cc().IsPersistent());
-        add_smt.BindInt(11, po->cc().IsPersistent());
-        add_smt.BindInt(
-            12, CookiePriorityToDBCookiePriority(po->cc().Priority()));
-        if (!add_smt.Run())
-          NOTREACHED() << "Could not add a cookie to the DB.";
-        break;
-
-      case PendingOperation::COOKIE_UPDATEACCESS:
-        update_access_smt.Reset(true);
-        update_access_smt.BindInt64(0,
-            po->cc().LastAccessDate().ToInternalValue());
-        update_access_smt.BindInt64(1,
-            po->cc().CreationDate().ToInternalValue());
-        if (!update_access_smt.Run())
-          NOTREACHED() << "Could not update cookie last access time in the DB.";
-        break;
-
-      case PendingOperation::COOKIE_DELETE:
-        cookies_per_origin_[
-            CookieOrigin(po->cc().Domain(), po->cc().IsSecure())]--;
-        del_smt.Reset(true);
-        del_smt.BindInt64(0, po->cc().CreationDate().ToInternalValue());
-        if (!del_smt.Run())
-          NOTREACHED() << "Could not delete a cookie from the DB.";
-        break;
-
-      default:
-        NOTREACHED();
-        break;
-    }
+  cookies_per_origin_[CookieOrigin(cc.Domain(), cc.IsSecure())]--;
+  del_smt.BindInt64(0, cc.CreationDate().ToInternalValue());
+  if (!del_smt.Run()) {
+    NOTREACHED() << "Could not delete a cookie from the DB.";
+    return false;
   }
-  bool succeeded = transaction.Commit();
-  UMA_HISTOGRAM_ENUMERATION("Cookie.BackingStoreUpdateResults",
-                            succeeded ? 0 : 1, 2);
+  return true;
 }
 
 void SQLitePersistentCookieStore::Backend::Flush(
     const base::Closure& callback) {
   DCHECK(!background_task_runner_->RunsTasksOnCurrentThread());
-  PostBackgroundTask(FROM_HERE, base::Bind(&Backend::Commit, this));
+  writer_->Flush(base::Closure());
 
   if (!callback.is_null()) {
-    // We want the completion task to run immediately after Commit() returns.
+    // We want the completion task to run immediately after the commit.
     // Posting it from here means there is less chance of another task getting
-    // onto the message queue first, than if we posted it from Commit() itself.
+    // onto the message queue first, than if we posted it after the commit.
     PostBackgroundTask(FROM_HERE, callback);
   }
 }
@@ -1082,13 +1072,19 @@ void SQLitePersistentCookieStore::Backend::Close() {
 void SQLitePersistentCookieStore::Backend::InternalBackgroundClose() {
   DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
   // Commit any pending operations
-  Commit();
+  writer_->Commit();
 
   if (!force_keep_session_state_ && special_storage_policy_.get() &&
       special_storage_policy_->HasSessionOnlyOrigins()) {
     DeleteSessionCookiesOnShutdown();
   }
 
+  ResetDatabase();
+}
+
+void SQLitePersistentCookieStore::Backend::ResetDatabase() {
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
+  writer_->SetConnection(NULL);
   meta_table_.Reset();
   db_.reset();
 }
@@ -1168,8 +1164,7 @@ void SQLitePersistentCookieStore::Backend::KillDatabase() {
     // the database. Hopefully things go better then!
     bool success = db_->RazeAndClose();
     UMA_HISTOGRAM_BOOLEAN("Cookie.KillDatabaseResult", success);
-    meta_table_.Reset();
-    db_.reset();
+    ResetDatabase();
   }
 }
 
@@ -13,6 +13,7 @@
 #include "base/files/scoped_temp_dir.h"
 #include "base/memory/ref_counted.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/field_trial.h"
 #include "base/sequenced_task_runner.h"
 #include "base/stl_util.h"
 #include "base/synchronization/waitable_event.h"
@@ -358,6 +359,61 @@ TEST_F(SQLitePersistentCookieStoreTest, TestFlush) {
   ASSERT_GT(info.size, base_size);
 }
 
+// The database uses write-ahead logging in the field trial group only, and is
+// converted back when it is opened outside of it.
+TEST_F(SQLitePersistentCookieStoreTest, WriteAheadLoggingFieldTrial) {
+  base::FilePath path = temp_dir_.path().Append(kCookieFilename);
+  {
+    base::FieldTrialList field_trial_list(NULL);
+    base::FieldTrialList::CreateFieldTrial("CookieDBWriteAheadLogging",
+                                           "Enabled");
+    InitializeStore(false, false);
+    AddCookie("A", "B", "foo.bar", "/", base::Time::Now());
+    DestroyStore();
+  }
+
+  // The file format bytes of the header are 2 in WAL mode, and 1 otherwise.
+  std::string header;
+  ASSERT_TRUE(base::ReadFileToString(path, &header));
+  ASSERT_LT(19u, header.size());
+  EXPECT_EQ(2, header[18]);
+  EXPECT_EQ(2, header[19]);
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  EXPECT_EQ(1U, cookies.size());
+  STLDeleteElements(&cookies);
+  DestroyStore();
+
+  ASSERT_TRUE(base::ReadFileToString(path, &header));
+  ASSERT_LT(19u, header.size());
+  EXPECT_EQ(1, header[18]);
+  EXPECT_EQ(1, header[19]);
+}
+
+// Repeated access time updates to a cookie are batched into one write, which
+// must keep the latest time.
+TEST_F(SQLitePersistentCookieStoreTest, TestUpdateAccessTime) {
+  InitializeStore(false, false);
+  const base::Time creation = base::Time::Now();
+  AddCookie("A", "B", "foo.bar", "/", creation);
+  for (int i = 1; i <= 3; ++i) {
+    const base::Time last_access = creation + base::TimeDelta::FromSeconds(i);
+    store_->UpdateCookieAccessTime(
+        net::CanonicalCookie(GURL(), "A", "B", "foo.bar", "/", creation,
+                             creation, last_access, false, false,
+                             net::COOKIE_PRIORITY_DEFAULT));
+  }
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ(creation + base::TimeDelta::FromSeconds(3),
+            cookies[0]->LastAccessDate());
+  STLDeleteElements(&cookies);
+}
+
 // Test loading old session cookies from the disk.
 TEST_F(SQLitePersistentCookieStoreTest, TestLoadOldSessionCookies) {
   InitializeStore(false, true);
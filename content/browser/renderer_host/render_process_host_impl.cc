@@ -563,6 +563,7 @@ bool RenderProcessHostImpl::Init() {
     // Spawn the child process asynchronously to avoid blocking the UI thread.
     // As long as there's no renderer prefix, we can use the zygote process
     // at this stage.
+    launch_start_time_ = base::TimeTicks::Now();
     child_process_launcher_.reset(new ChildProcessLauncher(
 #if defined(OS_WIN)
         new RendererSandboxedProcessLauncherDelegate,
@@ -1062,6 +1063,8 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kMaxUntiledLayerWidth,
     switches::kMaxUntiledLayerHeight,
     switches::kMemoryMetrics,
+    switches::kMSEAudioBufferSizeLimit,
+    switches::kMSEVideoBufferSizeLimit,
     switches::kNoReferrers,
     switches::kNoSandbox,
     switches::kNumRasterThreads,
@@ -1103,7 +1106,9 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     cc::switches::kEnableImplSidePainting,
     cc::switches::kEnableLCDText,
     cc::switches::kEnableMapImage,
+    cc::switches::kEnableOcclusionForTilePrioritization,
     cc::switches::kEnablePinchVirtualViewport,
+    cc::switches::kEnableProgressiveRaster,
     cc::switches::kEnableTopControlsPositionCalculation,
     cc::switches::kMaxTilesForInterestArea,
     cc::switches::kMaxUnusedResourceMemoryUsagePercentage,
@@ -1394,6 +1399,14 @@ bool RenderProcessHostImpl::OnMessageReceived(const IPC::Message& msg) {
 }
 
 void RenderProcessHostImpl::OnChannelConnected(int32 peer_pid) {
+  // Unlike ChildProcessLauncher's launch histograms, this also covers the
+  // renderer's own startup, up to the point where it can handle IPC.
+  if (!launch_start_time_.is_null()) {
+    UMA_HISTOGRAM_TIMES("MPArch.RendererLaunchToChannelConnected",
+                        base::TimeTicks::Now() - launch_start_time_);
+    launch_start_time_ = base::TimeTicks();
+  }
+
 #if defined(IPC_MESSAGE_LOG_ENABLED)
   Send(new ChildProcessMsg_SetIPCLoggingEnabled(
       IPC::Logging::GetInstance()->Enabled()));
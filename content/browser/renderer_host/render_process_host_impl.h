@@ -365,6 +365,10 @@ class CONTENT_EXPORT RenderProcessHostImpl
   // Records the last time we regarded the child process active.
   base::TimeTicks child_process_activity_time_;
 
+  // When the child process launch was started, or null once its channel has
+  // connected. Used to measure how long it takes a new renderer to be ready.
+  base::TimeTicks launch_start_time_;
+
   // Indicates whether this is a RenderProcessHost that has permission to embed
   // Browser Plugins.
   bool supports_browser_plugin_;
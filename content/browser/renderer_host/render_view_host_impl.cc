@@ -233,7 +233,7 @@ RenderViewHostImpl::RenderViewHostImpl(
         BrowserThread::IO, FROM_HERE,
         base::Bind(&ResourceDispatcherHostImpl::OnRenderViewHostCreated,
                    base::Unretained(ResourceDispatcherHostImpl::Get()),
-                   GetProcess()->GetID(), GetRoutingID()));
+                   GetProcess()->GetID(), GetRoutingID(), !is_hidden()));
   }
 
 #if defined(OS_ANDROID)
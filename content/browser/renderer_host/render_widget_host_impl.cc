@@ -30,6 +30,7 @@
 #include "content/browser/gpu/gpu_process_host.h"
 #include "content/browser/gpu/gpu_process_host_ui_shim.h"
 #include "content/browser/gpu/gpu_surface_tracker.h"
+#include "content/browser/loader/resource_dispatcher_host_impl.h"
 #include "content/browser/renderer_host/backing_store.h"
 #include "content/browser/renderer_host/backing_store_manager.h"
 #include "content/browser/renderer_host/dip_util.h"
@@ -555,6 +556,8 @@ void RenderWidgetHostImpl::WasHidden() {
   // Tell the RenderProcessHost we were hidden.
   process_->WidgetHidden();
 
+  NotifyResourceDispatcherHostOfVisibility(false);
+
   bool is_visible = false;
   NotificationService::current()->Notify(
       NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED,
@@ -562,6 +565,18 @@ void RenderWidgetHostImpl::WasHidden() {
       Details<bool>(&is_visible));
 }
 
+void RenderWidgetHostImpl::NotifyResourceDispatcherHostOfVisibility(
+    bool is_visible) {
+  // The ResourceScheduler tracks RenderViews only.
+  if (!IsRenderView() || !ResourceDispatcherHostImpl::Get())
+    return;
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&ResourceDispatcherHostImpl::OnRenderViewHostVisibilityChanged,
+                 base::Unretained(ResourceDispatcherHostImpl::Get()),
+                 process_->GetID(), routing_id_, is_visible));
+}
+
 void RenderWidgetHostImpl::WasShown() {
   if (!is_hidden_)
     return;
@@ -586,6 +601,8 @@ void RenderWidgetHostImpl::WasShown() {
 
   process_->WidgetRestored();
 
+  NotifyResourceDispatcherHostOfVisibility(true);
+
   bool is_visible = true;
   NotificationService::current()->Notify(
       NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED,
@@ -654,6 +654,10 @@ class CONTENT_EXPORT RenderWidgetHostImpl : virtual public RenderWidgetHost,
   // NotifyRendererResponsive.
   void RendererIsResponsive();
 
+  // Tells the ResourceDispatcherHost on the IO thread that this widget was
+  // shown or hidden, so it can schedule the widget's loads accordingly.
+  void NotifyResourceDispatcherHostOfVisibility(bool is_visible);
+
   // IPC message handlers
   void OnRenderViewReady();
   void OnRenderProcessGone(int status, int error_code);
@@ -0,0 +1,103 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/tracing/startup_sampling_profiler.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/debug/sampling_profiler_linux.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/values.h"
+#include "content/public/browser/browser_thread.h"
+
+using base::debug::SamplingProfiler;
+
+namespace content {
+
+namespace {
+
+void RegisterCurrentThread(const std::string& name) {
+  SamplingProfiler::GetInstance()->RegisterCurrentThread(name);
+}
+
+void UnregisterCurrentThread() {
+  SamplingProfiler::GetInstance()->UnregisterCurrentThread();
+}
+
+void WriteProfile(const base::FilePath& output_file,
+                  const std::string& json) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  if (file_util::WriteFile(output_file, json.data(), json.size()) !=
+      static_cast<int>(json.size())) {
+    LOG(ERROR) << "Could not write the sampling profile to "
+               << output_file.value();
+  }
+}
+
+}  // namespace
+
+StartupSamplingProfiler::StartupSamplingProfiler()
+    : running_(false),
+      io_thread_registered_(false) {
+}
+
+StartupSamplingProfiler::~StartupSamplingProfiler() {
+  // The threads must not exit while registered.
+  if (running_)
+    Stop();
+}
+
+bool StartupSamplingProfiler::Start(base::TimeDelta interval) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  DCHECK(!running_);
+  RegisterCurrentThread("CrBrowserMain");
+  running_ = true;
+  if (!SamplingProfiler::GetInstance()->Start(interval)) {
+    Stop();
+    return false;
+  }
+  return true;
+}
+
+void StartupSamplingProfiler::RegisterIOThread() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (!running_ || io_thread_registered_)
+    return;
+  io_thread_registered_ = BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&RegisterCurrentThread, std::string("Chrome_IOThread")));
+}
+
+void StartupSamplingProfiler::StopAndWrite(const base::FilePath& output_file) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  DCHECK(running_);
+  SamplingProfiler::GetInstance()->Stop();
+  SamplingProfiler::Profile profile;
+  SamplingProfiler::GetInstance()->TakeProfile(&profile);
+  Stop();
+
+  std::string json;
+  base::JSONWriter::Write(SamplingProfiler::ProfileToValue(profile).get(),
+                          &json);
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&WriteProfile, output_file, json));
+}
+
+void StartupSamplingProfiler::Stop() {
+  SamplingProfiler::GetInstance()->Stop();
+  UnregisterCurrentThread();
+  if (io_thread_registered_) {
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                            base::Bind(&UnregisterCurrentThread));
+    io_thread_registered_ = false;
+  }
+  running_ = false;
+}
+
+}  // namespace content
@@ -0,0 +1,51 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_TRACING_STARTUP_SAMPLING_PROFILER_H_
+#define CONTENT_BROWSER_TRACING_STARTUP_SAMPLING_PROFILER_H_
+
+#include "base/basictypes.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace base {
+class FilePath;
+}
+
+namespace content {
+
+// Samples the stacks of the browser's UI and IO threads with
+// base::debug::SamplingProfiler while startup tracing runs, for
+// --trace-startup-sampling-profile.  Only built where that profiler exists,
+// on Linux and Android.  Lives on the UI thread.
+class CONTENT_EXPORT StartupSamplingProfiler {
+ public:
+  StartupSamplingProfiler();
+  ~StartupSamplingProfiler();
+
+  // Registers the UI thread and starts sampling every |interval|.  Returns
+  // false if the profiler could not be started.
+  bool Start(base::TimeDelta interval);
+
+  // Adds the IO thread to the sampled threads.  Startup tracing begins before
+  // the browser threads exist, so this is called once they have started.
+  void RegisterIOThread();
+
+  // Stops sampling, unregisters the threads and writes the profile as JSON
+  // to |output_file| on the FILE thread.
+  void StopAndWrite(const base::FilePath& output_file);
+
+ private:
+  // Stops the profiler and unregisters the threads Start() registered.
+  void Stop();
+
+  bool running_;
+  bool io_thread_registered_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupSamplingProfiler);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_TRACING_STARTUP_SAMPLING_PROFILER_H_
@@ -0,0 +1,60 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/tracing/startup_sampling_profiler.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+TEST(StartupSamplingProfilerTest, WritesSamplesOfTheUIThread) {
+  TestBrowserThreadBundle thread_bundle;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath output_file =
+      temp_dir.path().AppendASCII("chrometrace.log.samples");
+
+  StartupSamplingProfiler profiler;
+  ASSERT_TRUE(profiler.Start(base::TimeDelta::FromMilliseconds(1)));
+  profiler.RegisterIOThread();
+  base::RunLoop().RunUntilIdle();
+
+  // Keep the UI thread busy so that it is sampled.
+  const base::TimeTicks end =
+      base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(100);
+  volatile int count = 0;
+  while (base::TimeTicks::Now() < end)
+    ++count;
+
+  profiler.StopAndWrite(output_file);
+  base::RunLoop().RunUntilIdle();
+
+  std::string json;
+  ASSERT_TRUE(base::ReadFileToString(output_file, &json));
+  scoped_ptr<base::Value> value(base::JSONReader::Read(json));
+  base::DictionaryValue* dictionary = NULL;
+  ASSERT_TRUE(value && value->GetAsDictionary(&dictionary));
+  base::ListValue* threads = NULL;
+  ASSERT_TRUE(dictionary->GetList("threads", &threads));
+  // The test's UI and IO threads are the same thread.
+  ASSERT_EQ(1u, threads->GetSize());
+  base::DictionaryValue* thread = NULL;
+  ASSERT_TRUE(threads->GetDictionary(0, &thread));
+  int samples = 0;
+  ASSERT_TRUE(thread->GetInteger("samples", &samples));
+  EXPECT_LT(0, samples);
+}
+
+}  // namespace content
@@ -43,10 +43,12 @@ bool TraceMessageFilter::OnMessageReceived(const IPC::Message& message,
     IPC_MESSAGE_HANDLER(TracingHostMsg_EndTracingAck, OnEndTracingAck)
     IPC_MESSAGE_HANDLER(TracingHostMsg_CaptureMonitoringSnapshotAck,
                         OnCaptureMonitoringSnapshotAcked)
-    IPC_MESSAGE_HANDLER(TracingHostMsg_TraceDataCollected,
-                        OnTraceDataCollected)
-    IPC_MESSAGE_HANDLER(TracingHostMsg_MonitoringTraceDataCollected,
-                        OnMonitoringTraceDataCollected)
+    IPC_MESSAGE_HANDLER_GENERIC(
+        TracingHostMsg_TraceDataCollected,
+        *message_was_ok = OnTraceDataCollected(message))
+    IPC_MESSAGE_HANDLER_GENERIC(
+        TracingHostMsg_MonitoringTraceDataCollected,
+        *message_was_ok = OnMonitoringTraceDataCollected(message))
     IPC_MESSAGE_HANDLER(TracingHostMsg_WatchEventMatched,
                         OnWatchEventMatched)
     IPC_MESSAGE_HANDLER(TracingHostMsg_TraceBufferPercentFullReply,
@@ -139,18 +141,26 @@ void TraceMessageFilter::OnCaptureMonitoringSnapshotAcked() {
   }
 }
 
-void TraceMessageFilter::OnTraceDataCollected(const std::string& data) {
-  scoped_refptr<base::RefCountedString> data_ptr(new base::RefCountedString());
-  data_ptr->data() = data;
+bool TraceMessageFilter::OnTraceDataCollected(const IPC::Message& message) {
+  TracingHostMsg_TraceDataCollected::Param param;
+  if (!TracingHostMsg_TraceDataCollected::Read(&message, &param))
+    return false;
+  scoped_refptr<base::RefCountedString> data_ptr(
+      base::RefCountedString::TakeString(&param.a));
   TracingControllerImpl::GetInstance()->OnTraceDataCollected(data_ptr);
+  return true;
 }
 
-void TraceMessageFilter::OnMonitoringTraceDataCollected(
-    const std::string& data) {
-  scoped_refptr<base::RefCountedString> data_ptr(new base::RefCountedString());
-  data_ptr->data() = data;
+bool TraceMessageFilter::OnMonitoringTraceDataCollected(
+    const IPC::Message& message) {
+  TracingHostMsg_MonitoringTraceDataCollected::Param param;
+  if (!TracingHostMsg_MonitoringTraceDataCollected::Read(&message, &param))
+    return false;
+  scoped_refptr<base::RefCountedString> data_ptr(
+      base::RefCountedString::TakeString(&param.a));
   TracingControllerImpl::GetInstance()->OnMonitoringTraceDataCollected(
       data_ptr);
+  return true;
 }
 
 void TraceMessageFilter::OnWatchEventMatched() {
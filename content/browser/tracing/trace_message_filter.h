@@ -47,8 +47,10 @@ class TraceMessageFilter : public BrowserMessageFilter {
   void OnCaptureMonitoringSnapshotAcked();
   void OnWatchEventMatched();
   void OnTraceBufferPercentFullReply(float percent_full);
-  void OnTraceDataCollected(const std::string& data);
-  void OnMonitoringTraceDataCollected(const std::string& data);
+  // The trace data handlers read their message themselves so that the
+  // string, which can be megabytes, is moved out of it rather than copied.
+  bool OnTraceDataCollected(const IPC::Message& message);
+  bool OnMonitoringTraceDataCollected(const IPC::Message& message);
 
   // ChildTraceMessageFilter exists:
   bool has_child_;
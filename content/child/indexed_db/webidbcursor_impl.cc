@@ -4,6 +4,7 @@
 
 #include "content/child/indexed_db/webidbcursor_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "content/child/indexed_db/indexed_db_dispatcher.h"
@@ -178,8 +179,18 @@ void WebIDBCursorImpl::CachedContinue(WebIDBCallbacks* callbacks) {
 }
 
 void WebIDBCursorImpl::ResetPrefetchCache() {
+  // Size the first prefetch of the next run by how long this run of
+  // continue() calls was, rather than starting over at the minimum, so that a
+  // page that walks the cursor in long runs doesn't have to ramp up again.
+  // A reset without any continue() calls since the last one (e.g. when the
+  // reply to a prefetch arrives after the run ended) keeps the size that the
+  // last run set.
+  if (continue_count_) {
+    prefetch_amount_ = std::max(static_cast<int>(kMinPrefetchAmount),
+                                std::min(continue_count_,
+                                         static_cast<int>(kMaxPrefetchAmount)));
+  }
   continue_count_ = 0;
-  prefetch_amount_ = kMinPrefetchAmount;
 
   if (!prefetch_keys_.size()) {
     // No prefetch cache, so no need to reset the cursor in the back-end.
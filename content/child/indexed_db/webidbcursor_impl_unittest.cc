@@ -312,4 +312,117 @@ TEST_F(WebIDBCursorImplTest, PrefetchReset) {
   EXPECT_EQ(1, dispatcher_->last_used_count());
 }
 
+// Tests that after a reset, the next prefetch is sized by how many records
+// the previous run of continue() calls used.
+TEST_F(WebIDBCursorImplTest, PrefetchAmountAfterReset) {
+  const int64 transaction_id = 1;
+  WebIDBCursorImpl cursor(WebIDBCursorImpl::kInvalidCursorId,
+                          transaction_id,
+                          thread_safe_sender_.get());
+
+  // Call continue() until prefetching should kick in.
+  int run_length = 0;
+  for (int i = 0; i < WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+    ++run_length;
+  }
+
+  // Initiate two prefetches, using all of the first and part of the second.
+  const int kPartialUse = 3;
+  for (int repetitions = 0; repetitions < 2; ++repetitions) {
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+    ++run_length;
+
+    int prefetch_count = dispatcher_->last_prefetch_count();
+    ASSERT_GT(prefetch_count, kPartialUse);
+    std::vector<IndexedDBKey> keys(prefetch_count);
+    std::vector<IndexedDBKey> primary_keys(prefetch_count);
+    std::vector<WebData> values(prefetch_count);
+    cursor.SetPrefetchData(keys, primary_keys, values);
+
+    int uses = repetitions == 0 ? prefetch_count : kPartialUse;
+    for (int i = 0; i < uses; ++i) {
+      cursor.continueFunction(null_key_, new MockContinueCallbacks());
+      ++run_length;
+    }
+  }
+  EXPECT_EQ(2, dispatcher_->prefetch_calls());
+  ASSERT_LT(run_length, static_cast<int>(WebIDBCursorImpl::kMaxPrefetchAmount));
+
+  // A continue() to a key ends the run and resets the cache.
+  cursor.continueFunction(WebIDBKey::createNumber(1),
+                          new MockContinueCallbacks());
+  EXPECT_EQ(1, dispatcher_->reset_calls());
+
+  // The next run starts prefetching at the previous run's length.
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i)
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  EXPECT_EQ(3, dispatcher_->prefetch_calls());
+  EXPECT_EQ(run_length, dispatcher_->last_prefetch_count());
+}
+
+// Tests that the prefetch size carried over from one run survives a prefetch
+// reply that arrives after the run ended, and keeps growing in the next run.
+TEST_F(WebIDBCursorImplTest, PrefetchAmountGrowsAcrossRuns) {
+  const int64 transaction_id = 1;
+  WebIDBCursorImpl cursor(WebIDBCursorImpl::kInvalidCursorId,
+                          transaction_id,
+                          thread_safe_sender_.get());
+
+  // Call continue() until the first prefetch is requested, and use all of it.
+  int run_length = 0;
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+    ++run_length;
+  }
+  EXPECT_EQ(1, dispatcher_->prefetch_calls());
+  int prefetch_count = dispatcher_->last_prefetch_count();
+  EXPECT_EQ(static_cast<int>(WebIDBCursorImpl::kMinPrefetchAmount),
+            prefetch_count);
+  std::vector<IndexedDBKey> keys(prefetch_count);
+  std::vector<IndexedDBKey> primary_keys(prefetch_count);
+  std::vector<WebData> values(prefetch_count);
+  cursor.SetPrefetchData(keys, primary_keys, values);
+  for (int i = 0; i < prefetch_count; ++i) {
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+    ++run_length;
+  }
+
+  // Request a second prefetch, then end the run before its reply arrives.
+  cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  ++run_length;
+  EXPECT_EQ(2, dispatcher_->prefetch_calls());
+  prefetch_count = dispatcher_->last_prefetch_count();
+  cursor.continueFunction(WebIDBKey::createNumber(1),
+                          new MockContinueCallbacks());
+
+  // The real dispatcher would call cursor->CachedContinue() with the reply,
+  // which discards the rest of the cache.
+  keys.resize(prefetch_count);
+  primary_keys.resize(prefetch_count);
+  values.resize(prefetch_count);
+  cursor.SetPrefetchData(keys, primary_keys, values);
+  scoped_ptr<WebIDBCallbacks> callbacks(new MockContinueCallbacks());
+  cursor.CachedContinue(callbacks.get());
+  EXPECT_EQ(1, dispatcher_->reset_calls());
+
+  // The next run starts prefetching at the previous run's length...
+  ASSERT_GT(run_length, static_cast<int>(WebIDBCursorImpl::kMinPrefetchAmount));
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i)
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  EXPECT_EQ(3, dispatcher_->prefetch_calls());
+  EXPECT_EQ(run_length, dispatcher_->last_prefetch_count());
+
+  // ...and grows from there.
+  prefetch_count = dispatcher_->last_prefetch_count();
+  keys.resize(prefetch_count);
+  primary_keys.resize(prefetch_count);
+  values.resize(prefetch_count);
+  cursor.SetPrefetchData(keys, primary_keys, values);
+  for (int i = 0; i <= prefetch_count; ++i)
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  EXPECT_EQ(4, dispatcher_->prefetch_calls());
+  EXPECT_EQ(2 * run_length, dispatcher_->last_prefetch_count());
+}
+
 }  // namespace content
@@ -34,9 +34,13 @@ IPC_STRUCT_TRAITS_BEGIN(tracked_objects::DeathDataSnapshot)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_sum)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_max)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_sample)
+  IPC_STRUCT_TRAITS_MEMBER(run_cpu_duration_sum)
+  IPC_STRUCT_TRAITS_MEMBER(run_cpu_duration_max)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_sum)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_max)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_sample)
+  IPC_STRUCT_TRAITS_MEMBER(run_duration_buckets)
+  IPC_STRUCT_TRAITS_MEMBER(queue_duration_buckets)
 IPC_STRUCT_TRAITS_END()
 
 IPC_STRUCT_TRAITS_BEGIN(tracked_objects::TaskSnapshot)
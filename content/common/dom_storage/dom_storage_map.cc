@@ -99,6 +99,17 @@ bool DOMStorageMap::RemoveItem(
   return true;
 }
 
+bool DOMStorageMap::CanSetItem(const base::string16& key,
+                               const base::string16& value) const {
+  DOMStorageValuesMap::const_iterator found = values_.find(key);
+  size_t old_item_size = found == values_.end() ?
+      0 : size_of_item(key, found->second.string());
+  size_t new_item_size = size_of_item(key, value);
+  // Same rule as SetItem().
+  return new_item_size <= old_item_size ||
+      bytes_used_ - old_item_size + new_item_size <= quota_;
+}
+
 void DOMStorageMap::SwapValues(DOMStorageValuesMap* values) {
   // Note: A pre-existing file may be over the quota budget.
   values_.swap(*values);
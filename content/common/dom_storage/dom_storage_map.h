@@ -30,6 +30,10 @@ class CONTENT_EXPORT DOMStorageMap
                base::NullableString16* old_value);
   bool RemoveItem(const base::string16& key, base::string16* old_value);
 
+  // Returns false if SetItem(|key|, |value|) would fail for lack of quota.
+  bool CanSetItem(const base::string16& key,
+                  const base::string16& value) const;
+
   // Swaps this instances values_ with |map|.
   // Note: to grandfather in pre-existing files that are overbudget,
   // this method does not do quota checking.
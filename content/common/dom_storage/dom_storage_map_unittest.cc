@@ -97,7 +97,9 @@ TEST(DOMStorageMapTest, EnforcesQuota) {
   base::NullableString16 old_nullable_value;
 
   scoped_refptr<DOMStorageMap> map(new DOMStorageMap(kQuota));
+  EXPECT_TRUE(map->CanSetItem(kKey, kValue));
   EXPECT_TRUE(map->SetItem(kKey, kValue, &old_nullable_value));
+  EXPECT_FALSE(map->CanSetItem(kKey2, kValue));
   EXPECT_FALSE(map->SetItem(kKey2, kValue, &old_nullable_value));
   EXPECT_EQ(1u, map->Length());
 
@@ -117,8 +119,10 @@ TEST(DOMStorageMapTest, EnforcesQuota) {
   // When overbudget, a new value of greater size than the existing value can
   // not be set, but a new value of lesser or equal size can be set.
   EXPECT_TRUE(map->SetItem(kKey, kValue, &old_nullable_value));
+  EXPECT_FALSE(map->CanSetItem(kKey, base::string16(kValue + kValue)));
   EXPECT_FALSE(map->SetItem(kKey, base::string16(kValue + kValue),
                             &old_nullable_value));
+  EXPECT_TRUE(map->CanSetItem(kKey, base::string16()));
   EXPECT_TRUE(map->SetItem(kKey, base::string16(), &old_nullable_value));
   EXPECT_EQ(kValue, old_nullable_value.string());
 }
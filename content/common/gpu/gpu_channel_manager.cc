@@ -63,6 +63,7 @@ gpu::gles2::ProgramCache* GpuChannelManager::program_cache() {
       !CommandLine::ForCurrentProcess()->HasSwitch(
           switches::kDisableGpuProgramCache)) {
     program_cache_.reset(new gpu::gles2::MemoryProgramCache());
+    program_cache_->set_driver_identifier(gpu_driver_identifier_);
   }
   return program_cache_.get();
 }
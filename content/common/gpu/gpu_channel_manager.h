@@ -90,6 +90,12 @@ class GpuChannelManager : public IPC::Listener,
 
   gpu::gles2::ProgramCache* program_cache();
 
+  // Identifies the GPU and driver that cached program binaries were built
+  // for. Must be set before the program cache is first used.
+  void set_gpu_driver_identifier(const std::string& gpu_driver_identifier) {
+    gpu_driver_identifier_ = gpu_driver_identifier;
+  }
+
   GpuMemoryManager* gpu_memory_manager() { return &gpu_memory_manager_; }
 
   GpuEventsDispatcher* gpu_devtools_events_dispatcher() {
@@ -151,6 +157,7 @@ class GpuChannelManager : public IPC::Listener,
   GpuWatchdog* watchdog_;
   scoped_refptr<SyncPointManager> sync_point_manager_;
   scoped_ptr<gpu::gles2::ProgramCache> program_cache_;
+  std::string gpu_driver_identifier_;
   scoped_refptr<gfx::GLSurface> default_offscreen_surface_;
   ImageOperationQueue image_operations_;
 
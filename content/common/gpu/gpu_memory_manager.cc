@@ -30,6 +30,9 @@ const int kDelayedScheduleManageTimeoutMs = 67;
 
 const uint64 kBytesAllocatedUnmanagedStep = 16 * 1024 * 1024;
 
+// How long allocations stay restricted after a memory pressure notification.
+const int kMemoryPressureTimeoutSeconds = 10;
+
 void TrackValueChanged(uint64 old_size, uint64 new_size, uint64* total_size) {
   DCHECK(new_size > old_size || *total_size >= (old_size - new_size));
   *total_size += (new_size - old_size);
@@ -99,6 +102,10 @@ GpuMemoryManager::GpuMemoryManager(
     bytes_available_gpu_memory_overridden_ = true;
   } else
     bytes_available_gpu_memory_ = GetDefaultAvailableGpuMemory();
+
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&GpuMemoryManager::OnMemoryPressure,
+                 base::Unretained(this))));
 }
 
 GpuMemoryManager::~GpuMemoryManager() {
@@ -238,6 +245,30 @@ void GpuMemoryManager::ScheduleManage(
   }
 }
 
+void GpuMemoryManager::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  TRACE_EVENT_INSTANT1("gpu",
+                       "GpuMemoryManager::OnMemoryPressure",
+                       TRACE_EVENT_SCOPE_THREAD,
+                       "level",
+                       memory_pressure_level);
+  base::TimeDelta timeout =
+      base::TimeDelta::FromSeconds(kMemoryPressureTimeoutSeconds);
+  memory_pressure_end_time_ = base::TimeTicks::Now() + timeout;
+  ScheduleManage(kScheduleManageNow);
+
+  // Give the clients their full allocations back once the pressure is over.
+  if (!disable_schedule_manage_) {
+    base::MessageLoop::current()->PostDelayedTask(
+        FROM_HERE, base::Bind(&GpuMemoryManager::Manage, AsWeakPtr()),
+        timeout);
+  }
+}
+
+bool GpuMemoryManager::IsUnderMemoryPressure() const {
+  return base::TimeTicks::Now() < memory_pressure_end_time_;
+}
+
 void GpuMemoryManager::TrackMemoryAllocatedChange(
     GpuMemoryTrackingGroup* tracking_group,
     uint64 old_size,
@@ -559,6 +590,11 @@ void GpuMemoryManager::ComputeVisibleSurfacesAllocations() {
     bytes_above_minimum_cap = std::numeric_limits<uint64>::max();
   }
 
+  // Under memory pressure, don't grant anything beyond the required working
+  // set, even if it would fit.
+  if (IsUnderMemoryPressure())
+    bytes_above_required_cap = 0;
+
   // Given those computed limits, set the actual memory allocations for the
   // visible clients, tracking the largest allocation and the total allocation
   // for future use.
@@ -646,8 +682,14 @@ void GpuMemoryManager::AssignSurfacesAllocations() {
   // Compute allocation when for all clients.
   ComputeVisibleSurfacesAllocations();
 
-  // Distribute the remaining memory to visible clients.
-  DistributeRemainingMemoryToVisibleSurfaces();
+  // Distribute the remaining memory to visible clients, unless the system
+  // is asking us to give memory back.
+  bool under_memory_pressure = IsUnderMemoryPressure();
+  if (!under_memory_pressure)
+    DistributeRemainingMemoryToVisibleSurfaces();
+  TRACE_COUNTER1("gpu",
+                 "GpuMemoryManagerUnderMemoryPressure",
+                 under_memory_pressure);
 
   // Send that allocation to the clients.
   ClientStateList clients = clients_visible_mru_;
@@ -672,6 +714,10 @@ void GpuMemoryManager::AssignSurfacesAllocations() {
     allocation.bytes_limit_when_visible =
         client_state->bytes_allocation_when_visible_;
     allocation.priority_cutoff_when_visible = priority_cutoff_;
+    TRACE_COUNTER_ID1("gpu",
+                      "GpuMemoryClientAllocation",
+                      client_state,
+                      allocation.bytes_limit_when_visible);
 
     client_state->client_->SetMemoryAllocation(allocation);
     client_state->client_->SuggestHaveFrontBuffer(!client_state->hibernated_);
@@ -715,12 +761,15 @@ void GpuMemoryManager::SetClientsHibernatedState() const {
     non_hibernated_clients++;
   }
   // Then an additional few clients with surfaces are non-hibernated too, up to
-  // a fixed limit.
+  // a fixed limit. Under memory pressure, only visible clients keep their
+  // frontbuffers.
+  uint64 max_non_hibernated_clients = IsUnderMemoryPressure() ?
+      non_hibernated_clients : max_surfaces_with_frontbuffer_soft_limit_;
   for (ClientStateList::const_iterator it = clients_nonvisible_mru_.begin();
        it != clients_nonvisible_mru_.end();
        ++it) {
     GpuMemoryManagerClientState* client_state = *it;
-    if (non_hibernated_clients < max_surfaces_with_frontbuffer_soft_limit_) {
+    if (non_hibernated_clients < max_non_hibernated_clients) {
       client_state->hibernated_ = false;
       client_state->tracking_group_->hibernated_ = false;
       non_hibernated_clients++;
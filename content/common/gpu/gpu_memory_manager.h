@@ -12,7 +12,10 @@
 #include "base/cancelable_callback.h"
 #include "base/containers/hash_tables.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "content/public/common/gpu_memory_stats.h"
 #include "gpu/command_buffer/common/gpu_memory_allocation.h"
@@ -101,6 +104,8 @@ class CONTENT_EXPORT GpuMemoryManager :
                            UnmanagedTracking);
   FRIEND_TEST_ALL_PREFIXES(GpuMemoryManagerTest,
                            DefaultAllocation);
+  FRIEND_TEST_ALL_PREFIXES(GpuMemoryManagerTest,
+                           MemoryPressure);
 
   typedef std::map<gpu::gles2::MemoryTracker*, GpuMemoryTrackingGroup*>
       TrackingGroupMap;
@@ -130,6 +135,13 @@ class CONTENT_EXPORT GpuMemoryManager :
       uint64 bytes_above_minimum_cap,
       uint64 bytes_overall_cap);
 
+  // Called when the system reports memory pressure. For a while afterwards
+  // visible clients are limited to their required working set, and
+  // nonvisible clients are asked to drop their frontbuffers.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  bool IsUnderMemoryPressure() const;
+
   // Update the amount of GPU memory we think we have in the system, based
   // on what the stubs' contexts report.
   void UpdateAvailableGpuMemory();
@@ -209,6 +221,10 @@ class CONTENT_EXPORT GpuMemoryManager :
     bytes_unmanaged_limit_step_ = bytes;
   }
 
+  void TestingEndMemoryPressure() {
+    memory_pressure_end_time_ = base::TimeTicks();
+  }
+
   GpuChannelManager* channel_manager_;
 
   // A list of all visible and nonvisible clients, in most-recently-used
@@ -254,6 +270,10 @@ class CONTENT_EXPORT GpuMemoryManager :
   // Used to disable automatic changes to Manage() in testing.
   bool disable_schedule_manage_;
 
+  // Allocations are restricted to the clients' working sets until this time.
+  base::TimeTicks memory_pressure_end_time_;
+  scoped_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(GpuMemoryManager);
 };
 
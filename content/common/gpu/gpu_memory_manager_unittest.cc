@@ -609,4 +609,31 @@ TEST_F(GpuMemoryManagerTest, DefaultAllocation) {
             memmgr_.GetDefaultClientAllocation());
 }
 
+// Test that memory pressure limits visible clients to their required working
+// set and hibernates nonvisible clients, until the pressure is over.
+TEST_F(GpuMemoryManagerTest, MemoryPressure) {
+  memmgr_.TestingSetAvailableGpuMemory(64);
+  memmgr_.TestingSetMinimumClientAllocation(8);
+
+  FakeClient stub1(&memmgr_, GenerateUniqueSurfaceId(), true),
+             stub2(&memmgr_, GenerateUniqueSurfaceId(), false);
+  SetClientStats(&stub1, 16, 24);
+
+  Manage();
+  EXPECT_GT(stub1.BytesWhenVisible(), 9u * 16 / 8);
+  EXPECT_TRUE(stub2.suggest_have_frontbuffer_);
+
+  memmgr_.OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_CRITICAL);
+  Manage();
+  EXPECT_EQ(9u * 16 / 8, stub1.BytesWhenVisible());
+  EXPECT_TRUE(stub1.suggest_have_frontbuffer_);
+  EXPECT_FALSE(stub2.suggest_have_frontbuffer_);
+
+  memmgr_.TestingEndMemoryPressure();
+  Manage();
+  EXPECT_GT(stub1.BytesWhenVisible(), 9u * 16 / 8);
+  EXPECT_TRUE(stub2.suggest_have_frontbuffer_);
+}
+
 }  // namespace content
@@ -154,6 +154,9 @@ void GpuChildThread::OnInitialize() {
                             watchdog_thread_.get(),
                             ChildProcess::current()->io_message_loop_proxy(),
                             ChildProcess::current()->GetShutDownEvent()));
+  gpu_channel_manager_->set_gpu_driver_identifier(
+      gpu_info_.gl_vendor + "|" + gpu_info_.gl_renderer + "|" +
+      gpu_info_.gl_version + "|" + gpu_info_.driver_version);
 
   // Ensure the browser process receives the GPU info before a reply to any
   // subsequent IPC it might send.
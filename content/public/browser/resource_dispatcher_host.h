@@ -70,6 +70,13 @@ class CONTENT_EXPORT ResourceDispatcherHost {
   // Resumes any blocked request for the specified route id.
   virtual void ResumeBlockedRequestsForRoute(int child_id, int route_id) = 0;
 
+  // Makes the RenderView identified by |child_id| and |route_id| load as if
+  // it were visible while it is hidden, or stop doing so. This is for views
+  // that are hidden while they load on purpose, like prerenders.
+  virtual void SetRouteExemptFromHiddenLimit(int child_id,
+                                             int route_id,
+                                             bool is_exempt) = 0;
+
  protected:
   virtual ~ResourceDispatcherHost() {}
 };
@@ -905,6 +905,12 @@ const char kTraceStartupDuration[]          = "trace-startup-duration";
 // all events since startup.
 const char kTraceStartupFile[]              = "trace-startup-file";
 
+// Samples the stacks of the browser's UI and IO threads while startup tracing
+// runs, and writes the profile as JSON next to the trace, to
+// <trace file>.samples. Linux and Android only. Has no effect without
+// --trace-startup, or if --trace-startup-file=none was supplied.
+const char kTraceStartupSamplingProfile[]   = "trace-startup-sampling-profile";
+
 
 
 // Prioritizes the UI's command stream in the GPU process
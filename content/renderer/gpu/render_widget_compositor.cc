@@ -234,6 +234,10 @@ scoped_ptr<RenderWidgetCompositor> RenderWidgetCompositor::Create(
 
   settings.strict_layer_property_change_checking =
       cmd->HasSwitch(cc::switches::kStrictLayerPropertyChangeChecking);
+  settings.use_occlusion_for_tile_prioritization =
+      cmd->HasSwitch(cc::switches::kEnableOcclusionForTilePrioritization);
+  settings.use_progressive_raster =
+      cmd->HasSwitch(cc::switches::kEnableProgressiveRaster);
 
   settings.use_map_image = cc::switches::IsMapImageEnabled();
 
@@ -22,6 +22,16 @@ namespace {
 // For the sake of the storage API, make this quite large.
 const int kMaxRecursionDepth = 100;
 
+// Converts |str| to UTF-8 straight into |out|, rather than going through a
+// v8::String::Utf8Value buffer and then copying that.
+void WriteUtf8ToString(v8::Handle<v8::String> str, std::string* out) {
+  out->resize(str->Utf8Length());
+  if (!out->empty()) {
+    str->WriteUtf8(&(*out)[0], static_cast<int>(out->size()), NULL,
+                   v8::String::NO_NULL_TERMINATION);
+  }
+}
+
 }  // namespace
 
 // The state of a call to FromV8Value.
@@ -156,10 +166,11 @@ v8::Local<v8::Value> V8ValueConverterImpl::ToV8ValueImpl(
     }
 
     case base::Value::TYPE_STRING: {
-      std::string val;
-      CHECK(value->GetAsString(&val));
+      const base::StringValue* string_value = NULL;
+      CHECK(value->GetAsString(&string_value));
+      const std::string& val = string_value->GetString();
       return v8::String::NewFromUtf8(
-          isolate, val.c_str(), v8::String::kNormalString, val.length());
+          isolate, val.data(), v8::String::kNormalString, val.length());
     }
 
     case base::Value::TYPE_LIST:
@@ -259,8 +270,9 @@ base::Value* V8ValueConverterImpl::FromV8ValueImpl(
   }
 
   if (val->IsString()) {
-    v8::String::Utf8Value utf8(val->ToString());
-    return new base::StringValue(std::string(*utf8, utf8.length()));
+    base::StringValue* result = new base::StringValue(std::string());
+    WriteUtf8ToString(val->ToString(), result->GetString());
+    return result;
   }
 
   if (val->IsUndefined())
@@ -427,13 +439,14 @@ base::Value* V8ValueConverterImpl::FromV8Object(
       continue;
     }
 
-    v8::String::Utf8Value name_utf8(key->ToString());
+    std::string name;
+    WriteUtf8ToString(key->ToString(), &name);
 
     v8::TryCatch try_catch;
     v8::Handle<v8::Value> child_v8 = val->Get(key);
 
     if (try_catch.HasCaught()) {
-      LOG(WARNING) << "Getter for property " << *name_utf8
+      LOG(WARNING) << "Getter for property " << name
                    << " threw an exception.";
       child_v8 = v8::Null(isolate);
     }
@@ -467,8 +480,7 @@ base::Value* V8ValueConverterImpl::FromV8Object(
     if (strip_null_from_objects_ && child->IsType(base::Value::TYPE_NULL))
       continue;
 
-    result->SetWithoutPathExpansion(std::string(*name_utf8, name_utf8.length()),
-                                    child.release());
+    result->SetWithoutPathExpansion(name, child.release());
   }
 
   return result.release();
@@ -108,6 +108,7 @@
         'streams_unittest.cc',
         'typedrva_unittest.cc',
         'versioning_unittest.cc',
+        'third_party/bsdiff_create_unittest.cc',
         'third_party/paged_array_unittest.cc'
       ],
       'dependencies': [
@@ -14,11 +14,15 @@
 
 #include "courgette/ensemble.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
 #include "base/basictypes.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -238,6 +242,68 @@ void FreeGenerators(std::vector<TransformationPatchGenerator*>* generators) {
   generators->clear();
 }
 
+namespace {
+
+// Transforming an element disassembles both versions of it and adjusts the
+// new one to the old, which is most of the time spent on large executables.
+// Elements are independent, so this many of them are transformed at once.
+// Each one holds both of its programs in memory while it is transformed.
+const int kMaxTransformThreads = 4;
+
+// Runs TransformationPatchGenerator::Transform() for one element, keeping
+// its inputs and outputs until they are written to the patch in order.
+class TransformTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit TransformTask(TransformationPatchGenerator* generator)
+      : generator_(generator),
+        status_(C_GENERAL_ERROR) {
+  }
+
+  virtual void Run() OVERRIDE {
+    status_ = generator_->Transform(&parameters_,
+                                    &predicted_transformed_element_,
+                                    &corrected_transformed_element_);
+  }
+
+  SourceStreamSet* parameters() { return &parameters_; }
+  SinkStreamSet* predicted_transformed_element() {
+    return &predicted_transformed_element_;
+  }
+  SinkStreamSet* corrected_transformed_element() {
+    return &corrected_transformed_element_;
+  }
+  Status status() const { return status_; }
+
+ private:
+  TransformationPatchGenerator* generator_;
+  SourceStreamSet parameters_;
+  SinkStreamSet predicted_transformed_element_;
+  SinkStreamSet corrected_transformed_element_;
+  Status status_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransformTask);
+};
+
+// Runs all of |tasks|, on several threads if there is more than one.
+void RunTransformTasks(const std::vector<TransformTask*>& tasks) {
+  int num_threads = std::min(kMaxTransformThreads,
+                             base::SysInfo::NumberOfProcessors());
+  num_threads = std::min(num_threads, static_cast<int>(tasks.size()));
+  if (num_threads <= 1) {
+    for (size_t i = 0;  i < tasks.size();  ++i)
+      tasks[i]->Run();
+    return;
+  }
+
+  base::DelegateSimpleThreadPool pool("courgette_transform", num_threads);
+  for (size_t i = 0;  i < tasks.size();  ++i)
+    pool.AddWork(tasks[i]);
+  pool.Start();
+  pool.JoinAll();
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Status GenerateEnsemblePatch(SourceStream* base,
@@ -332,34 +398,40 @@ Status GenerateEnsemblePatch(SourceStream* base,
   if (!corrected_parameters_source_set.Init(&corrected_parameters_source))
     return C_STREAM_ERROR;
 
+  ScopedVector<TransformTask> transform_tasks;
+  for (size_t i = 0;  i < number_of_transformations;  ++i) {
+    TransformTask* task = new TransformTask(generators[i]);
+    transform_tasks.push_back(task);
+    if (!corrected_parameters_source_set.ReadSet(task->parameters()))
+      return C_STREAM_ERROR;
+  }
+
+  if (!corrected_parameters_source_set.Empty())
+    return C_STREAM_NOT_CONSUMED;
+
+  RunTransformTasks(transform_tasks.get());
+
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
   for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
-      return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
+    TransformTask* task = transform_tasks[i];
+    if (task->status() != C_OK)
+      return task->status();
+    if (!task->parameters()->Empty())
       return C_STREAM_NOT_CONSUMED;
     if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
+            task->predicted_transformed_element()))
       return C_STREAM_ERROR;
     if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
+            task->corrected_transformed_element()))
       return C_STREAM_ERROR;
+    // The element's streams have been copied into the sets above, so free
+    // them rather than holding every element's output twice.
+    delete task;
+    transform_tasks[i] = NULL;
   }
 
-  if (!corrected_parameters_source_set.Empty())
-    return C_STREAM_NOT_CONSUMED;
-
   SinkStream linearized_predicted_transformed_elements;
   SinkStream linearized_corrected_transformed_elements;
 
@@ -14,6 +14,7 @@ class EnsembleTest : public BaseTest {
   void PeEnsemble() const;
   void Pe64Ensemble() const;
   void Elf32Ensemble() const;
+  void Elf32MultipleElements() const;
 };
 
 void EnsembleTest::TestEnsemble(std::string src_bytes,
@@ -63,6 +64,29 @@ void EnsembleTest::Elf32Ensemble() const {
   TestEnsemble(src_bytes, tgt_bytes);
 }
 
+void EnsembleTest::Elf32MultipleElements() const {
+  std::list<std::string> src_ensemble;
+  std::list<std::string> tgt_ensemble;
+
+  // Several elements, some changed and some not, so that they are
+  // transformed together and written to the patch in order.
+  src_ensemble.push_back("elf-32-1");
+  src_ensemble.push_back("elf-32-1");
+  src_ensemble.push_back("elf-32-2");
+
+  tgt_ensemble.push_back("elf-32-2");
+  tgt_ensemble.push_back("elf-32-1");
+  tgt_ensemble.push_back("elf-32-2");
+
+  std::string src_bytes = FilesContents(src_ensemble);
+  std::string tgt_bytes = FilesContents(tgt_ensemble);
+
+  src_bytes = "aaabbbccc" + src_bytes + "dddeeefff";
+  tgt_bytes = "aaagggccc" + tgt_bytes + "dddeeefff";
+
+  TestEnsemble(src_bytes, tgt_bytes);
+}
+
 void EnsembleTest::PeEnsemble() const {
   std::list<std::string> src_ensemble;
   std::list<std::string> tgt_ensemble;
@@ -117,3 +141,7 @@ TEST_F(EnsembleTest, DISABLED_PE64) {
 TEST_F(EnsembleTest, DISABLED_Elf32) {
   Elf32Ensemble();
 }
+
+TEST_F(EnsembleTest, DISABLED_Elf32MultipleElements) {
+  Elf32MultipleElements();
+}
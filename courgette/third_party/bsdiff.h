@@ -53,6 +53,7 @@ enum BSDiffStatus {
 
 class SourceStream;
 class SinkStream;
+template <typename T> class PagedArray;
 
 // Creates a binary patch.
 //
@@ -73,6 +74,12 @@ BSDiffStatus ApplyBinaryPatch(const base::FilePath& old_stream,
                               const base::FilePath& patch_stream,
                               const base::FilePath& new_stream);
 
+// Fills |I|, which must have room for |oldsize| + 1 entries, with the suffix
+// array of the |oldsize| bytes at |old|.  The empty suffix is included and
+// sorts first.  Returns false if memory runs out.  Exposed for testing.
+bool BuildSuffixArray(PagedArray<int>* I, const unsigned char* old,
+                      int oldsize);
+
 // The following declarations are common to the patch-creation and
 // patch-application code.
 
@@ -28,6 +28,7 @@
  *                --Stephen Adams <sra@chromium.org>
  * 2013-04-10 - Add wrapper method to apply a patch to files directly.
  *                --Joshua Pawlicki <waffles@chromium.org>
+ * 2014-03-20 - Write copied bytes in blocks.
  */
 
 // Copyright (c) 2009 The Chromium Authors. All rights reserved.
@@ -36,12 +37,21 @@
 
 #include "courgette/third_party/bsdiff.h"
 
+#include <algorithm>
+
 #include "base/files/memory_mapped_file.h"
 #include "courgette/crc.h"
 #include "courgette/streams.h"
 
 namespace courgette {
 
+namespace {
+
+// Size of the blocks in which copied bytes are written to the new file.
+const size_t kCopyBlockSize = 4096;
+
+}  // namespace
+
 BSDiffStatus MBS_ReadHeader(SourceStream* stream, MBSPatchHeader* header) {
   if (!stream->Read(header->tag, sizeof(header->tag))) return READ_ERROR;
   if (!stream->ReadVarint32(&header->slen)) return READ_ERROR;
@@ -106,19 +116,24 @@ BSDiffStatus MBS_ApplyPatch(const MBSPatchHeader *header,
     if (copy_count > static_cast<size_t>(old_end - old_position))
       return UNEXPECTED_ERROR;
 
-    // Add together bytes from the 'old' file and the 'diff' stream.
-    for (size_t i = 0;  i < copy_count;  ++i) {
-      uint8 diff_byte = 0;
-      if (pending_diff_zeros) {
-        --pending_diff_zeros;
-      } else {
-        if (!diff_skips->ReadVarint32(&pending_diff_zeros))
-          return UNEXPECTED_ERROR;
-        if (!diff_bytes->Read(&diff_byte, 1))
-          return UNEXPECTED_ERROR;
+    // Add together bytes from the 'old' file and the 'diff' stream, writing
+    // the sums a block at a time rather than a byte at a time.
+    for (size_t i = 0;  i < copy_count;  ) {
+      uint8 block[kCopyBlockSize];
+      size_t block_count = std::min(copy_count - i, sizeof(block));
+      for (size_t j = 0;  j < block_count;  ++j, ++i) {
+        uint8 diff_byte = 0;
+        if (pending_diff_zeros) {
+          --pending_diff_zeros;
+        } else {
+          if (!diff_skips->ReadVarint32(&pending_diff_zeros))
+            return UNEXPECTED_ERROR;
+          if (!diff_bytes->Read(&diff_byte, 1))
+            return UNEXPECTED_ERROR;
+        }
+        block[j] = old_position[i] + diff_byte;
       }
-      uint8 byte = old_position[i] + diff_byte;
-      if (!new_stream->Write(&byte, 1))
+      if (!new_stream->Write(block, block_count))
         return MEM_ERROR;
     }
     old_position += copy_count;
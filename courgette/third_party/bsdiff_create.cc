@@ -20,12 +20,16 @@
   2010-05-26 - Use a paged array for V and I. The address space may be too
                fragmented for these big arrays to be contiguous.
                  --Stephen Adams <sra@chromium.org>
+  2014-03-20 - Replace qsufsort with SA-IS, which runs in linear time and
+               doesn't need V.
 */
 
 #include "courgette/third_party/bsdiff.h"
 
 #include <stdlib.h>
 #include <algorithm>
+#include <new>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -38,118 +42,236 @@
 
 namespace courgette {
 
-// ------------------------------------------------------------------------
-//
-// The following code is taken verbatim from 'bsdiff.c'. Please keep all the
-// code formatting and variable names.  The changes from the original are (1)
-// replacing tabs with spaces, (2) indentation, (3) using 'const', and (4)
-// changing the V and I parameters from int* to PagedArray<int>&.
+namespace {
+
+// Builds the suffix array with the SA-IS algorithm from "Linear Suffix Array
+// Construction by Almost Pure Induced-Sorting" by Ge Nong, Sen Zhang and Wai
+// Hong Chan.  This replaces the original qsufsort, which took O(n log n) time
+// and needed a second array (V) of the same size as the suffix array.  The
+// result is the same: the suffixes of the input plus the empty suffix, which
+// sorts first.
 //
-// The code appears to be a rewritten version of the suffix array algorithm
-// presented in "Faster Suffix Sorting" by N. Jesper Larsson and Kunihiko
-// Sadakane, special cased for bytes.
+// The suffix array is a PagedArray for the same reason as before.  The
+// reduced problem of each level of recursion is stored in the unused part of
+// it, so the extra space is the type bitmaps and the buckets.  The buckets
+// have one entry per character, 257 at the top level and fewer than half the
+// previous level's length below it, so they are a plain std::vector.
+
+// The input bytes followed by a unique, smallest sentinel.  Bytes are shifted
+// up by one to make room for the sentinel.
+class SentinelByteString {
+ public:
+  SentinelByteString(const unsigned char* bytes, int size)
+      : bytes_(bytes), size_(size) {}
+  int operator[](int i) const { return i < size_ ? bytes_[i] + 1 : 0; }
+
+ private:
+  const unsigned char* bytes_;
+  int size_;
+};
+
+// A window of a PagedArray<int> starting at |offset|.
+class PagedArrayWindow {
+ public:
+  PagedArrayWindow(PagedArray<int>* array, int offset)
+      : array_(array), offset_(offset) {}
+  int& operator[](int i) const { return (*array_)[offset_ + i]; }
+
+  // Returns the window starting |offset| entries into this one.
+  PagedArrayWindow Offset(int offset) const {
+    return PagedArrayWindow(array_, offset_ + offset);
+  }
 
-static void
-split(PagedArray<int>& I,PagedArray<int>& V,int start,int len,int h)
-{
-  int i,j,k,x,tmp,jj,kk;
-
-  if(len<16) {
-    for(k=start;k<start+len;k+=j) {
-      j=1;x=V[I[k]+h];
-      for(i=1;k+i<start+len;i++) {
-        if(V[I[k+i]+h]<x) {
-          x=V[I[k+i]+h];
-          j=0;
-        };
-        if(V[I[k+i]+h]==x) {
-          tmp=I[k+j];I[k+j]=I[k+i];I[k+i]=tmp;
-          j++;
-        };
-      };
-      for(i=0;i<j;i++) V[I[k+i]]=k+j-1;
-      if(j==1) I[k]=-1;
-    };
-    return;
-  };
-
-  x=V[I[start+len/2]+h];
-  jj=0;kk=0;
-  for(i=start;i<start+len;i++) {
-    if(V[I[i]+h]<x) jj++;
-    if(V[I[i]+h]==x) kk++;
-  };
-  jj+=start;kk+=jj;
-
-  i=start;j=0;k=0;
-  while(i<jj) {
-    if(V[I[i]+h]<x) {
-      i++;
-    } else if(V[I[i]+h]==x) {
-      tmp=I[i];I[i]=I[jj+j];I[jj+j]=tmp;
-      j++;
-    } else {
-      tmp=I[i];I[i]=I[kk+k];I[kk+k]=tmp;
-      k++;
-    };
-  };
-
-  while(jj+j<kk) {
-    if(V[I[jj+j]+h]==x) {
-      j++;
-    } else {
-      tmp=I[jj+j];I[jj+j]=I[kk+k];I[kk+k]=tmp;
-      k++;
-    };
-  };
+ private:
+  PagedArray<int>* array_;
+  int offset_;
+};
+
+// Whether each position of a string starts an S-type (rather than L-type)
+// suffix, i.e. one that is smaller than the suffix after it.  This is a
+// bitmap rather than a std::vector<bool> so that running out of memory for
+// it fails the diff instead of throwing.
+class SuffixTypes {
+ public:
+  SuffixTypes() {}
+
+  // Allocates |size| entries.  Returns true on success and false if
+  // allocation fails.
+  bool Allocate(int size) {
+    words_.reset(new(std::nothrow) uint32[(size + 31) / 32]);
+    return words_.get() != NULL;
+  }
 
-  if(jj>start) split(I,V,start,jj-start,h);
+  bool operator[](int i) const {
+    return (words_[i >> 5] >> (i & 31)) & 1;
+  }
 
-  for(i=0;i<kk-jj;i++) V[I[jj+i]]=kk-1;
-  if(jj==kk-1) I[jj]=-1;
+  void Set(int i, bool s_type) {
+    if (s_type)
+      words_[i >> 5] |= 1u << (i & 31);
+    else
+      words_[i >> 5] &= ~(1u << (i & 31));
+  }
 
-  if(start+len>kk) split(I,V,kk,start+len-kk,h);
+ private:
+  scoped_ptr<uint32[]> words_;
+
+  DISALLOW_COPY_AND_ASSIGN(SuffixTypes);
+};
+
+bool IsLMS(const SuffixTypes& types, int i) {
+  return i > 0 && types[i] && !types[i - 1];
 }
 
-static void
-qsufsort(PagedArray<int>& I, PagedArray<int>& V,const unsigned char *old,int oldsize)
-{
-  int buckets[256];
-  int i,h,len;
-
-  for(i=0;i<256;i++) buckets[i]=0;
-  for(i=0;i<oldsize;i++) buckets[old[i]]++;
-  for(i=1;i<256;i++) buckets[i]+=buckets[i-1];
-  for(i=255;i>0;i--) buckets[i]=buckets[i-1];
-  buckets[0]=0;
-
-  for(i=0;i<oldsize;i++) I[++buckets[old[i]]]=i;
-  I[0]=oldsize;
-  for(i=0;i<oldsize;i++) V[i]=buckets[old[i]];
-  V[oldsize]=0;
-  for(i=1;i<256;i++) if(buckets[i]==buckets[i-1]+1) I[buckets[i]]=-1;
-  I[0]=-1;
-
-  for(h=1;I[0]!=-(oldsize+1);h+=h) {
-    len=0;
-    for(i=0;i<oldsize+1;) {
-      if(I[i]<0) {
-        len-=I[i];
-        i-=I[i];
-      } else {
-        if(len) I[i-len]=-len;
-        len=V[I[i]]+1-i;
-        split(I,V,i,len,h);
-        i+=len;
-        len=0;
-      };
-    };
-    if(len) I[i-len]=-len;
-  };
+// Fills |buckets| with the start (or end, if |end|) of the bucket of each of
+// the |alphabet_size| characters in the suffix array.
+template<typename String>
+void GetBuckets(const String& s, int n, std::vector<int>* buckets,
+                int alphabet_size, bool end) {
+  for (int c = 0; c < alphabet_size; ++c)
+    (*buckets)[c] = 0;
+  for (int i = 0; i < n; ++i)
+    ++(*buckets)[s[i]];
+  int sum = 0;
+  for (int c = 0; c < alphabet_size; ++c) {
+    sum += (*buckets)[c];
+    (*buckets)[c] = end ? sum : sum - (*buckets)[c];
+  }
+}
 
-  for(i=0;i<oldsize+1;i++) I[V[i]]=i;
+// Induces the order of the L-type suffixes from the sorted suffixes that are
+// already in |sa|, then that of the S-type suffixes from the L-type ones.
+template<typename String>
+void InduceSA(const String& s, int n, const SuffixTypes& types,
+              const PagedArrayWindow& sa, std::vector<int>* buckets,
+              int alphabet_size) {
+  GetBuckets(s, n, buckets, alphabet_size, false);
+  for (int i = 0; i < n; ++i) {
+    int j = sa[i] - 1;
+    if (j >= 0 && !types[j])
+      sa[(*buckets)[s[j]]++] = j;
+  }
+  GetBuckets(s, n, buckets, alphabet_size, true);
+  for (int i = n - 1; i >= 0; --i) {
+    int j = sa[i] - 1;
+    if (j >= 0 && types[j])
+      sa[--(*buckets)[s[j]]] = j;
+  }
 }
 
+// Sorts the suffixes of |s|, which has |n| characters in [0, alphabet_size)
+// and ends with a unique 0, into |sa|.  Returns false if memory runs out.
+template<typename String>
+bool SAIS(const String& s, int n, const PagedArrayWindow& sa,
+          int alphabet_size) {
+  if (n == 1) {
+    sa[0] = 0;
+    return true;
+  }
+
+  SuffixTypes types;
+  if (!types.Allocate(n))
+    return false;
+  types.Set(n - 1, true);
+  types.Set(n - 2, false);
+  for (int i = n - 3; i >= 0; --i)
+    types.Set(i, s[i] < s[i + 1] || (s[i] == s[i + 1] && types[i + 1]));
+
+  std::vector<int> buckets(alphabet_size);
+
+  // Stage 1: sort the LMS substrings.
+  GetBuckets(s, n, &buckets, alphabet_size, true);
+  for (int i = 0; i < n; ++i)
+    sa[i] = -1;
+  for (int i = 1; i < n; ++i) {
+    if (IsLMS(types, i))
+      sa[--buckets[s[i]]] = i;
+  }
+  InduceSA(s, n, types, sa, &buckets, alphabet_size);
+
+  // Move the sorted LMS substrings to the front of |sa| and name them, so
+  // that equal substrings get equal names.  The names are kept in the second
+  // half of |sa|, indexed by position / 2, since LMS positions are at least
+  // two apart.
+  int n1 = 0;
+  for (int i = 0; i < n; ++i) {
+    if (IsLMS(types, sa[i]))
+      sa[n1++] = sa[i];
+  }
+  for (int i = n1; i < n; ++i)
+    sa[i] = -1;
+  int name = 0;
+  int prev = -1;
+  for (int i = 0; i < n1; ++i) {
+    int pos = sa[i];
+    bool diff = false;
+    for (int d = 0; d < n; ++d) {
+      if (prev == -1 || s[pos + d] != s[prev + d] ||
+          types[pos + d] != types[prev + d]) {
+        diff = true;
+        break;
+      }
+      if (d > 0 && (IsLMS(types, pos + d) || IsLMS(types, prev + d)))
+        break;
+    }
+    if (diff) {
+      ++name;
+      prev = pos;
+    }
+    sa[n1 + pos / 2] = name - 1;
+  }
+  for (int i = n - 1, j = n - 1; i >= n1; --i) {
+    if (sa[i] >= 0)
+      sa[j--] = sa[i];
+  }
+
+  // Stage 2: sort the suffixes of the string of names, which is at the end
+  // of |sa|, into the front of |sa|.
+  const PagedArrayWindow& sa1 = sa;
+  PagedArrayWindow s1 = sa.Offset(n - n1);
+  if (name < n1) {
+    if (!SAIS(s1, n1, sa1, name))
+      return false;
+  } else {
+    for (int i = 0; i < n1; ++i)
+      sa1[s1[i]] = i;
+  }
+
+  // Stage 3: place the LMS suffixes in their buckets in sorted order and
+  // induce the rest from them.
+  GetBuckets(s, n, &buckets, alphabet_size, true);
+  for (int i = 1, j = 0; i < n; ++i) {
+    if (IsLMS(types, i))
+      s1[j++] = i;
+  }
+  for (int i = 0; i < n1; ++i)
+    sa1[i] = s1[sa1[i]];
+  for (int i = n1; i < n; ++i)
+    sa[i] = -1;
+  for (int i = n1 - 1; i >= 0; --i) {
+    int j = sa[i];
+    sa[i] = -1;
+    sa[--buckets[s[j]]] = j;
+  }
+  InduceSA(s, n, types, sa, &buckets, alphabet_size);
+  return true;
+}
+
+}  // namespace
+
+bool BuildSuffixArray(PagedArray<int>* I, const unsigned char* old,
+                      int oldsize) {
+  return SAIS(SentinelByteString(old, oldsize), oldsize + 1,
+              PagedArrayWindow(I, 0), 257);
+}
+
+// ------------------------------------------------------------------------
+//
+// The following code is taken verbatim from 'bsdiff.c'. Please keep all the
+// code formatting and variable names.  The changes from the original are (1)
+// replacing tabs with spaces, (2) indentation, (3) using 'const', and (4)
+// changing the I parameter from int* to PagedArray<int>&.
+
 static int
 matchlen(const unsigned char *old,int oldsize,const unsigned char *newbuf,int newsize)
 {
@@ -221,7 +343,6 @@ BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
   uint32 pending_diff_zeros = 0;
 
   PagedArray<int> I;
-  PagedArray<int> V;
 
   if (!I.Allocate(oldsize + 1)) {
     LOG(ERROR) << "Could not allocate I[], " << ((oldsize + 1) * sizeof(int))
@@ -229,17 +350,13 @@ BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
     return MEM_ERROR;
   }
 
-  if (!V.Allocate(oldsize + 1)) {
-    LOG(ERROR) << "Could not allocate V[], " << ((oldsize + 1) * sizeof(int))
-               << " bytes";
+  base::Time q_start_time = base::Time::Now();
+  if (!BuildSuffixArray(&I, old, oldsize)) {
+    LOG(ERROR) << "Could not allocate memory to build the suffix array";
     return MEM_ERROR;
   }
-
-  base::Time q_start_time = base::Time::Now();
-  qsufsort(I, V, old, oldsize);
-  VLOG(1) << " done qsufsort "
+  VLOG(1) << " done suffix sort "
           << (base::Time::Now() - q_start_time).InSecondsF();
-  V.clear();
 
   const uint8* newbuf = new_stream->Buffer();
   const int newsize = static_cast<int>(new_stream->Remaining());
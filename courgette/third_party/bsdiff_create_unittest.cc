@@ -0,0 +1,103 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "courgette/third_party/bsdiff.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "courgette/third_party/paged_array.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Orders suffix start positions of |text| by the suffixes they start.  A
+// suffix that is a prefix of another, such as the empty one, sorts first.
+class SuffixLess {
+ public:
+  explicit SuffixLess(const std::string& text) : text_(text) {}
+  bool operator()(int a, int b) const {
+    return std::lexicographical_compare(
+        text_.begin() + a, text_.end(), text_.begin() + b, text_.end(),
+        UnsignedLess);
+  }
+
+ private:
+  static bool UnsignedLess(char a, char b) {
+    return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+  }
+
+  const std::string& text_;
+};
+
+// Checks BuildSuffixArray() against sorting the suffixes of |text| naively.
+void TestSuffixArray(const std::string& text) {
+  const int size = static_cast<int>(text.size());
+  std::vector<int> expected(size + 1);
+  for (int i = 0; i <= size; ++i)
+    expected[i] = i;
+  std::sort(expected.begin(), expected.end(), SuffixLess(text));
+
+  courgette::PagedArray<int> I;
+  ASSERT_TRUE(I.Allocate(size + 1));
+  ASSERT_TRUE(courgette::BuildSuffixArray(
+      &I, reinterpret_cast<const unsigned char*>(text.data()), size));
+  for (int i = 0; i <= size; ++i)
+    ASSERT_EQ(expected[i], I[i]) << "at " << i << " of " << size;
+}
+
+std::string RandomText(size_t length, int alphabet_size, unsigned seed) {
+  std::string text;
+  while (text.size() < length) {
+    seed = seed * 1103515245 + 12345;
+    text += static_cast<char>((seed >> 16) % alphabet_size);
+  }
+  return text;
+}
+
+std::string PeriodicText(size_t length, const std::string& period) {
+  std::string text;
+  while (text.size() < length)
+    text += period;
+  text.resize(length);
+  return text;
+}
+
+}  // namespace
+
+TEST(BSDiffCreateTest, SuffixArrayShortInputs) {
+  TestSuffixArray(std::string());
+  TestSuffixArray("a");
+  TestSuffixArray(std::string(1, '\0'));
+  TestSuffixArray(std::string(1, '\xff'));
+  TestSuffixArray("ab");
+  TestSuffixArray("ba");
+  TestSuffixArray("aa");
+}
+
+TEST(BSDiffCreateTest, SuffixArrayRandomInputs) {
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    TestSuffixArray(RandomText(seed * 100, 256, seed));
+    // A small alphabet repeats substrings, which exercises the recursion.
+    TestSuffixArray(RandomText(seed * 100, 2, seed));
+    TestSuffixArray(RandomText(seed * 100, 4, seed));
+  }
+}
+
+TEST(BSDiffCreateTest, SuffixArrayPeriodicInputs) {
+  TestSuffixArray(PeriodicText(1000, "ab"));
+  TestSuffixArray(PeriodicText(1001, "abc"));
+  TestSuffixArray(PeriodicText(1000, "abcab"));
+  TestSuffixArray(PeriodicText(999, "mississippi"));
+  TestSuffixArray(PeriodicText(1000, std::string("\xff\0\x7f", 3)));
+}
+
+TEST(BSDiffCreateTest, SuffixArrayAllEqualInputs) {
+  TestSuffixArray(std::string(2, 'a'));
+  TestSuffixArray(std::string(3, 'a'));
+  TestSuffixArray(std::string(1000, 'a'));
+  TestSuffixArray(std::string(1000, '\0'));
+  TestSuffixArray(std::string(1000, '\xff'));
+}
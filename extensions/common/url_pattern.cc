@@ -314,47 +314,78 @@ bool URLPattern::SetPort(const std::string& port) {
   return false;
 }
 
-bool URLPattern::MatchesURL(const GURL& test) const {
-  const GURL* test_url = &test;
-  bool has_inner_url = test.inner_url() != NULL;
+URLPattern::TestURL::TestURL(const GURL& url)
+    : url_(url),
+      test_url_(&url),
+      is_supported_(true),
+      has_path_for_request_(false),
+      has_port_(false) {
+  if (url.inner_url() != NULL) {
+    // The only nested URLs we handle are filesystem URLs.
+    is_supported_ = url.SchemeIsFileSystem();
+    test_url_ = url.inner_url();
+  }
+
+  if (is_supported_) {
+    scheme_ = test_url_->scheme();
+    host_ = test_url_->host();
+  }
+}
+
+URLPattern::TestURL::~TestURL() {
+}
+
+const std::string& URLPattern::TestURL::path_for_request() const {
+  if (!has_path_for_request_) {
+    path_for_request_ = url_.PathForRequest();
+    if (url_.inner_url() != NULL)
+      path_for_request_ = test_url_->path() + path_for_request_;
+    has_path_for_request_ = true;
+  }
+  return path_for_request_;
+}
 
-  if (has_inner_url) {
-    if (!test.SchemeIsFileSystem())
-      return false;  // The only nested URLs we handle are filesystem URLs.
-    test_url = test.inner_url();
+const std::string& URLPattern::TestURL::port() const {
+  if (!has_port_) {
+    port_ = base::IntToString(test_url_->EffectiveIntPort());
+    has_port_ = true;
   }
+  return port_;
+}
+
+bool URLPattern::MatchesURL(const GURL& test) const {
+  return MatchesURL(TestURL(test));
+}
+
+bool URLPattern::MatchesURL(const TestURL& test) const {
+  if (!test.is_supported_)
+    return false;
 
-  if (!MatchesScheme(test_url->scheme()))
+  if (!MatchesScheme(test.scheme_))
     return false;
 
   if (match_all_urls_)
     return true;
 
-  std::string path_for_request = test.PathForRequest();
-  if (has_inner_url)
-    path_for_request = test_url->path() + path_for_request;
-
-  return MatchesSecurityOriginHelper(*test_url) &&
-         MatchesPath(path_for_request);
+  return MatchesSecurityOriginHelper(test) &&
+         MatchesPath(test.path_for_request());
 }
 
 bool URLPattern::MatchesSecurityOrigin(const GURL& test) const {
-  const GURL* test_url = &test;
-  bool has_inner_url = test.inner_url() != NULL;
+  return MatchesSecurityOrigin(TestURL(test));
+}
 
-  if (has_inner_url) {
-    if (!test.SchemeIsFileSystem())
-      return false;  // The only nested URLs we handle are filesystem URLs.
-    test_url = test.inner_url();
-  }
+bool URLPattern::MatchesSecurityOrigin(const TestURL& test) const {
+  if (!test.is_supported_)
+    return false;
 
-  if (!MatchesScheme(test_url->scheme()))
+  if (!MatchesScheme(test.scheme_))
     return false;
 
   if (match_all_urls_)
     return true;
 
-  return MatchesSecurityOriginHelper(*test_url);
+  return MatchesSecurityOriginHelper(test);
 }
 
 bool URLPattern::MatchesScheme(const std::string& test) const {
@@ -373,8 +404,13 @@ bool URLPattern::MatchesHost(const std::string& host) const {
 }
 
 bool URLPattern::MatchesHost(const GURL& test) const {
+  return MatchesHostOf(test.host(), test);
+}
+
+bool URLPattern::MatchesHostOf(const std::string& host,
+                               const GURL& test) const {
   // If the hosts are exactly equal, we have a match.
-  if (test.host() == host_)
+  if (host == host_)
     return true;
 
   // If we're matching subdomains, and we have no host in the match pattern,
@@ -387,26 +423,27 @@ bool URLPattern::MatchesHost(const GURL& test) const {
   if (!match_subdomains_)
     return false;
 
-  // We don't do subdomain matching against IP addresses, so we can give up now
-  // if the test host is an IP address.
-  if (test.HostIsIPAddress())
+  // Check if the test host is a subdomain of our host.
+  if (host.length() <= (host_.length() + 1))
     return false;
 
-  // Check if the test host is a subdomain of our host.
-  if (test.host().length() <= (host_.length() + 1))
+  if (host.compare(host.length() - host_.length(), host_.length(), host_) != 0)
     return false;
 
-  if (test.host().compare(test.host().length() - host_.length(),
-                          host_.length(), host_) != 0)
+  if (host[host.length() - host_.length() - 1] != '.')
     return false;
 
-  return test.host()[test.host().length() - host_.length() - 1] == '.';
+  // We don't do subdomain matching against IP addresses. This is checked last
+  // since it means canonicalizing the host again.
+  return !test.HostIsIPAddress();
 }
 
 bool URLPattern::MatchesPath(const std::string& test) const {
   // Make the behaviour of OverlapsWith consistent with MatchesURL, which is
   // need to match hosted apps on e.g. 'google.com' also run on 'google.com/'.
-  if (test + "/*" == path_escaped_)
+  if (path_escaped_.length() == test.length() + 2 &&
+      path_escaped_.compare(0, test.length(), test) == 0 &&
+      path_escaped_.compare(test.length(), 2, "/*") == 0)
     return true;
 
   return MatchPattern(test, path_escaped_);
@@ -491,12 +528,14 @@ bool URLPattern::MatchesAllSchemes(
   return true;
 }
 
-bool URLPattern::MatchesSecurityOriginHelper(const GURL& test) const {
+bool URLPattern::MatchesSecurityOriginHelper(const TestURL& test) const {
   // Ignore hostname if scheme is file://.
-  if (scheme_ != content::kFileScheme && !MatchesHost(test))
+  if (scheme_ != content::kFileScheme &&
+      !MatchesHostOf(test.host_, *test.test_url_))
     return false;
 
-  if (!MatchesPortPattern(base::IntToString(test.EffectiveIntPort())))
+  // Skip formatting the port for the common wildcard case.
+  if (port_ != "*" && !MatchesPortPattern(test.port()))
     return false;
 
   return true;
@@ -8,6 +8,8 @@
 #include <string>
 #include <vector>
 
+#include "base/basictypes.h"
+
 class GURL;
 
 // A pattern that can be used to match URLs. A URLPattern is a very restricted
@@ -131,11 +133,50 @@ class URLPattern {
   // false otherwise. Uses valid_schemes_ to determine validity.
   bool IsValidScheme(const std::string& scheme) const;
 
+  // The parts of a URL that are looked at when matching it. Extracting them
+  // is most of the cost of MatchesURL(), so callers that test one URL against
+  // many patterns, like URLPatternSet, construct this once and use the
+  // overloads below.
+  class TestURL {
+   public:
+    explicit TestURL(const GURL& url);
+    ~TestURL();
+
+   private:
+    friend class URLPattern;
+
+    // The path and query to match, computed on first use.
+    const std::string& path_for_request() const;
+
+    // The port to match, computed on first use.
+    const std::string& port() const;
+
+    const GURL& url_;
+
+    // |url_|, or its inner URL for filesystem: URLs.
+    const GURL* test_url_;
+
+    // False for nested URLs other than filesystem: URLs, which never match.
+    bool is_supported_;
+
+    std::string scheme_;
+    std::string host_;
+
+    mutable bool has_path_for_request_;
+    mutable std::string path_for_request_;
+    mutable bool has_port_;
+    mutable std::string port_;
+
+    DISALLOW_COPY_AND_ASSIGN(TestURL);
+  };
+
   // Returns true if this instance matches the specified URL.
   bool MatchesURL(const GURL& test) const;
+  bool MatchesURL(const TestURL& test) const;
 
   // Returns true if this instance matches the specified security origin.
   bool MatchesSecurityOrigin(const GURL& test) const;
+  bool MatchesSecurityOrigin(const TestURL& test) const;
 
   // Returns true if |test| matches our scheme.
   // Note that if test is "filesystem", this may fail whereas MatchesURL
@@ -199,7 +240,10 @@ class URLPattern {
   // Returns true if all of the |schemes| items matches our scheme.
   bool MatchesAllSchemes(const std::vector<std::string>& schemes) const;
 
-  bool MatchesSecurityOriginHelper(const GURL& test) const;
+  bool MatchesSecurityOriginHelper(const TestURL& test) const;
+
+  // Returns true if |host|, the host of |test|, matches our host.
+  bool MatchesHostOf(const std::string& host, const GURL& test) const;
 
   // Returns true if our port matches the |port| pattern (it may be "*").
   bool MatchesPortPattern(const std::string& port) const;
@@ -148,9 +148,11 @@ bool URLPatternSet::ContainsPattern(const URLPattern& pattern) const {
 }
 
 bool URLPatternSet::MatchesURL(const GURL& url) const {
+  // Extract the parts of |url| once rather than for every pattern.
+  const URLPattern::TestURL test_url(url);
   for (URLPatternSet::const_iterator pattern = patterns_.begin();
        pattern != patterns_.end(); ++pattern) {
-    if (pattern->MatchesURL(url))
+    if (pattern->MatchesURL(test_url))
       return true;
   }
 
@@ -158,9 +160,10 @@ bool URLPatternSet::MatchesURL(const GURL& url) const {
 }
 
 bool URLPatternSet::MatchesSecurityOrigin(const GURL& origin) const {
+  const URLPattern::TestURL test_origin(origin);
   for (URLPatternSet::const_iterator pattern = patterns_.begin();
        pattern != patterns_.end(); ++pattern) {
-    if (pattern->MatchesSecurityOrigin(origin))
+    if (pattern->MatchesSecurityOrigin(test_origin))
       return true;
   }
 
@@ -60,6 +60,32 @@ TEST(URLPatternSetTest, Two) {
   EXPECT_FALSE(set.MatchesURL(GURL("https://www.apple.com/monkey")));
 }
 
+// The parts of the URL are only extracted once for the whole set, so make
+// sure patterns that look at different parts of it still match correctly.
+TEST(URLPatternSetTest, MatchesURLMixedPatterns) {
+  URLPatternSet set;
+  AddPattern(&set, "http://*.google.com:8080/*");
+  AddPattern(&set, "https://*.yahoo.com/path/*");
+  AddPattern(&set, "http://*.0.0.1/*");
+  AddPattern(&set, "file:///tmp/*");
+
+  EXPECT_TRUE(set.MatchesURL(GURL("http://www.google.com:8080/monkey")));
+  EXPECT_FALSE(set.MatchesURL(GURL("http://www.google.com/monkey")));
+  EXPECT_TRUE(set.MatchesURL(GURL("https://yahoo.com/path")));
+  EXPECT_TRUE(set.MatchesURL(GURL("https://mail.yahoo.com/path/x")));
+  EXPECT_FALSE(set.MatchesURL(GURL("https://mail.yahoo.com/pathx")));
+  EXPECT_FALSE(set.MatchesURL(GURL("http://127.0.0.1/")));
+  EXPECT_TRUE(set.MatchesURL(GURL("file:///tmp/foo")));
+  EXPECT_TRUE(set.MatchesURL(
+      GURL("filesystem:http://www.google.com:8080/temporary/foo")));
+  EXPECT_FALSE(set.MatchesURL(
+      GURL("filesystem:http://www.google.com/temporary/foo")));
+
+  EXPECT_TRUE(set.MatchesSecurityOrigin(GURL("http://a.google.com:8080/")));
+  EXPECT_FALSE(set.MatchesSecurityOrigin(GURL("http://a.google.com:80/")));
+  EXPECT_TRUE(set.MatchesSecurityOrigin(GURL("https://a.yahoo.com/")));
+}
+
 TEST(URLPatternSetTest, OverlapsWith) {
   URLPatternSet set1;
   AddPattern(&set1, "http://www.google.com/f*");
@@ -698,6 +698,22 @@ bool GLES2Implementation::GetHelper(GLenum pname, GLint* params) {
     case GL_ACTIVE_TEXTURE:
       *params = active_texture_unit_ + GL_TEXTURE0;
       return true;
+    case GL_PACK_ALIGNMENT:
+      *params = pack_alignment_;
+      return true;
+    case GL_UNPACK_ALIGNMENT:
+      *params = unpack_alignment_;
+      return true;
+    // The service never sees these, they are handled on the client.
+    case GL_UNPACK_ROW_LENGTH_EXT:
+      *params = unpack_row_length_;
+      return true;
+    case GL_UNPACK_SKIP_ROWS_EXT:
+      *params = unpack_skip_rows_;
+      return true;
+    case GL_UNPACK_SKIP_PIXELS_EXT:
+      *params = unpack_skip_pixels_;
+      return true;
     case GL_TEXTURE_BINDING_2D:
       if (share_group_->bind_generates_resource()) {
         *params = texture_units_[active_texture_unit_].bound_texture_2d;
@@ -1223,10 +1239,17 @@ void GLES2Implementation::PixelStorei(GLenum pname, GLint param) {
       << param << ")");
   switch (pname) {
     case GL_PACK_ALIGNMENT:
-        pack_alignment_ = param;
-        break;
     case GL_UNPACK_ALIGNMENT:
-        unpack_alignment_ = param;
+        // Reject bad alignments here so that the cached values stay in sync
+        // with the service and GetIntegerv can return them.
+        if (param != 1 && param != 2 && param != 4 && param != 8) {
+          SetGLError(GL_INVALID_VALUE, "glPixelStorei", "invalid alignment");
+          return;
+        }
+        if (pname == GL_PACK_ALIGNMENT)
+          pack_alignment_ = param;
+        else
+          unpack_alignment_ = param;
         break;
     case GL_UNPACK_ROW_LENGTH_EXT:
         unpack_row_length_ = param;
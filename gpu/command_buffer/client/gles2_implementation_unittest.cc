@@ -1960,6 +1960,9 @@ TEST_F(GLES2ImplementationTest, GetIntegerCacheRead) {
       {GL_RENDERBUFFER_BINDING, 0, },
       {GL_ARRAY_BUFFER_BINDING, 0, },
       {GL_ELEMENT_ARRAY_BUFFER_BINDING, 0, },
+      {GL_PACK_ALIGNMENT, 4, },
+      {GL_UNPACK_ALIGNMENT, 4, },
+      {GL_UNPACK_ROW_LENGTH_EXT, 0, },
       {GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, kMaxCombinedTextureImageUnits, },
       {GL_MAX_CUBE_MAP_TEXTURE_SIZE, kMaxCubeMapTextureSize, },
       {GL_MAX_FRAGMENT_UNIFORM_VECTORS, kMaxFragmentUniformVectors, },
@@ -2003,6 +2006,9 @@ TEST_F(GLES2ImplementationTest, GetIntegerCacheWrite) {
   gl_->BindTexture(GL_TEXTURE_2D, 6);
   gl_->BindTexture(GL_TEXTURE_CUBE_MAP, 7);
   gl_->BindTexture(GL_TEXTURE_EXTERNAL_OES, 8);
+  gl_->PixelStorei(GL_PACK_ALIGNMENT, 1);
+  gl_->PixelStorei(GL_UNPACK_ALIGNMENT, 8);
+  gl_->PixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 16);
 
   const PNameValue pairs[] = {{GL_ACTIVE_TEXTURE, GL_TEXTURE4, },
                               {GL_ARRAY_BUFFER_BINDING, 2, },
@@ -2011,7 +2017,10 @@ TEST_F(GLES2ImplementationTest, GetIntegerCacheWrite) {
                               {GL_RENDERBUFFER_BINDING, 5, },
                               {GL_TEXTURE_BINDING_2D, 6, },
                               {GL_TEXTURE_BINDING_CUBE_MAP, 7, },
-                              {GL_TEXTURE_BINDING_EXTERNAL_OES, 8, }, };
+                              {GL_TEXTURE_BINDING_EXTERNAL_OES, 8, },
+                              {GL_PACK_ALIGNMENT, 1, },
+                              {GL_UNPACK_ALIGNMENT, 8, },
+                              {GL_UNPACK_ROW_LENGTH_EXT, 16, }, };
   size_t num_pairs = sizeof(pairs) / sizeof(pairs[0]);
   for (size_t ii = 0; ii < num_pairs; ++ii) {
     const PNameValue& pv = pairs[ii];
@@ -2029,6 +2038,19 @@ TEST_F(GLES2ImplementationTest, GetIntegerCacheWrite) {
   EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), gl_->GetError());
 }
 
+TEST_F(GLES2ImplementationTest, PixelStoreiInvalidAlignment) {
+  gl_->PixelStorei(GL_UNPACK_ALIGNMENT, 3);
+  EXPECT_TRUE(NoCommandsWritten());
+  EXPECT_EQ(static_cast<GLenum>(GL_INVALID_VALUE), gl_->GetError());
+
+  // The cached value is unchanged.
+  ClearCommands();
+  GLint v = -1;
+  gl_->GetIntegerv(GL_UNPACK_ALIGNMENT, &v);
+  EXPECT_TRUE(NoCommandsWritten());
+  EXPECT_EQ(4, v);
+}
+
 static bool CheckRect(
     int width, int height, GLenum format, GLenum type, int alignment,
     bool flip_y, const uint8* r1, const uint8* r2) {
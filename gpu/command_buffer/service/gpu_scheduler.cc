@@ -24,6 +24,13 @@ namespace gpu {
 
 const int64 kUnscheduleFenceTimeOutDelay = 10000;
 
+// Preemptible schedulers yield after processing commands for this long, so
+// that a single context issuing heavy work (for example WebGL) cannot hold
+// the GPU thread for a whole frame. The clock is only read every
+// kCommandsPerTimeSliceCheck commands to keep the check cheap.
+const int64 kMaxTimeSliceMs = 8;
+const int kCommandsPerTimeSliceCheck = 64;
+
 #if defined(OS_WIN)
 const int64 kRescheduleTimeOutDelay = 1000;
 #endif
@@ -71,10 +78,21 @@ void GpuScheduler::PutChanged() {
   error::Error error = error::kNoError;
   if (decoder_)
     decoder_->BeginDecoding();
+  int commands_processed = 0;
   while (!parser_->IsEmpty()) {
     if (IsPreempted())
       break;
 
+    if (preemption_flag_.get() &&
+        ++commands_processed % kCommandsPerTimeSliceCheck == 0 &&
+        base::TimeTicks::HighResNow() - begin_time >
+            base::TimeDelta::FromMilliseconds(kMaxTimeSliceMs)) {
+      TRACE_EVENT_INSTANT1("gpu", "GpuScheduler::TimeSliceExpired",
+                           TRACE_EVENT_SCOPE_THREAD,
+                           "commands_processed", commands_processed);
+      break;
+    }
+
     DCHECK(IsScheduled());
     DCHECK(unschedule_fences_.empty());
 
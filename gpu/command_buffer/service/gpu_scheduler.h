@@ -156,7 +156,8 @@ class GPU_EXPORT GpuScheduler
   base::Closure descheduled_callback_;
   base::Closure command_processed_callback_;
 
-  // If non-NULL and |preemption_flag_->IsSet()|, exit PutChanged early.
+  // If non-NULL and |preemption_flag_->IsSet()|, exit PutChanged early. If
+  // non-NULL, PutChanged also exits once its time slice is used up.
   scoped_refptr<PreemptionFlag> preemption_flag_;
   bool was_preempted_;
 
@@ -106,7 +106,9 @@ void ProgramCache::ComputeProgramHash(
   const size_t shader0_size = kHashLength;
   const size_t shader1_size = kHashLength;
   const size_t map_size = CalculateMapSize(bind_attrib_location_map);
-  const size_t total_size = shader0_size + shader1_size + map_size;
+  const size_t driver_size = driver_identifier_.length();
+  const size_t total_size =
+      shader0_size + shader1_size + map_size + driver_size;
 
   scoped_ptr<unsigned char[]> buffer(new unsigned char[total_size]);
   memcpy(buffer.get(), hashed_shader_0, shader0_size);
@@ -128,6 +130,11 @@ void ProgramCache::ComputeProgramHash(
       buffer[current_pos++] = value;
     }
   }
+  if (driver_size != 0) {
+    memcpy(&buffer[shader0_size + shader1_size + map_size],
+           driver_identifier_.c_str(),
+           driver_size);
+  }
   base::SHA1HashBytes(buffer.get(),
                       total_size, reinterpret_cast<unsigned char*>(result));
 }
@@ -74,6 +74,13 @@ class GPU_EXPORT ProgramCache {
   // clears the cache
   void Clear();
 
+  // Mixes |driver_identifier| into every program hash, so that binaries
+  // loaded from disk that were produced by another GPU or driver version are
+  // never handed to glProgramBinary.
+  void set_driver_identifier(const std::string& driver_identifier) {
+    driver_identifier_ = driver_identifier;
+  }
+
   // Only for testing
   void LinkedProgramCacheSuccess(const std::string& shader_a,
                                  const ShaderTranslatorInterface* translator_a,
@@ -108,6 +115,7 @@ class GPU_EXPORT ProgramCache {
   virtual void ClearBackend() = 0;
 
   LinkStatusMap link_status_;
+  std::string driver_identifier_;
 
   DISALLOW_COPY_AND_ASSIGN(ProgramCache);
 };
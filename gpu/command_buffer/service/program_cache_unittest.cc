@@ -108,6 +108,19 @@ TEST_F(ProgramCacheTest, LinkStatusSave) {
                 shader1, NULL, shader2, NULL, NULL));
 }
 
+TEST_F(ProgramCacheTest, LinkUnknownOnDriverChange) {
+  const std::string shader1 = "abcd1234";
+  const std::string shader2 = "abcda sda b1~#4 bbbbb1234";
+  cache_->set_driver_identifier("vendor renderer 1.0");
+  cache_->SaySuccessfullyCached(shader1, NULL, shader2, NULL, NULL);
+  EXPECT_EQ(ProgramCache::LINK_SUCCEEDED,
+            cache_->GetLinkedProgramStatus(shader1, NULL, shader2, NULL, NULL));
+
+  cache_->set_driver_identifier("vendor renderer 2.0");
+  EXPECT_EQ(ProgramCache::LINK_UNKNOWN,
+            cache_->GetLinkedProgramStatus(shader1, NULL, shader2, NULL, NULL));
+}
+
 TEST_F(ProgramCacheTest, LinkUnknownOnFragmentSourceChange) {
   const std::string shader1 = "abcd1234";
   std::string shader2 = "abcda sda b1~#4 bbbbb1234";
@@ -10,13 +10,10 @@
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
-#if defined(OS_OPENBSD)
-#include <sys/uio.h>
-#endif
-
 #include <map>
 #include <string>
 
@@ -387,10 +384,26 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     const char* out_bytes = reinterpret_cast<const char*>(msg->data()) +
         message_send_bytes_written_;
 
+    // Gather the messages queued behind this one into the same write, up to
+    // the next one that carries descriptors: those have to start a sendmsg()
+    // of their own.
+    struct iovec iov[kMaxIOVecsPerWrite];
+    iov[0].iov_base = const_cast<char*>(out_bytes);
+    iov[0].iov_len = amt_to_write;
+    size_t iov_count = 1;
+    for (std::deque<Message*>::const_iterator it = output_queue_.begin() + 1;
+         it != output_queue_.end() && iov_count < kMaxIOVecsPerWrite &&
+             (*it)->file_descriptor_set()->empty();
+         ++it) {
+      iov[iov_count].iov_base = const_cast<void*>((*it)->data());
+      iov[iov_count].iov_len = (*it)->size();
+      amt_to_write += (*it)->size();
+      ++iov_count;
+    }
+
     struct msghdr msgh = {0};
-    struct iovec iov = {const_cast<char*>(out_bytes), amt_to_write};
-    msgh.msg_iov = &iov;
-    msgh.msg_iovlen = 1;
+    msgh.msg_iov = iov;
+    msgh.msg_iovlen = iov_count;
     char buf[CMSG_SPACE(
         sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)];
 
@@ -435,9 +448,11 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         // fd_pipe_ which makes Seccomp sandbox operation more efficient.
         struct iovec fd_pipe_iov = { const_cast<char *>(""), 1 };
         msgh.msg_iov = &fd_pipe_iov;
+        msgh.msg_iovlen = 1;
         fd_written = fd_pipe_;
         bytes_written = HANDLE_EINTR(sendmsg(fd_pipe_, &msgh, MSG_DONTWAIT));
-        msgh.msg_iov = &iov;
+        msgh.msg_iov = iov;
+        msgh.msg_iovlen = iov_count;
         msgh.msg_controllen = 0;
         if (bytes_written > 0) {
           CloseFileDescriptors(msg);
@@ -453,7 +468,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
       }
       if (!msgh.msg_controllen) {
-        bytes_written = HANDLE_EINTR(write(pipe_, out_bytes, amt_to_write));
+        bytes_written = HANDLE_EINTR(writev(pipe_, iov, iov_count));
       } else
 #endif  // IPC_USES_READWRITE
       {
@@ -486,11 +501,24 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       return false;
     }
 
+    // Retire the messages that went out completely.
+    size_t bytes_left = bytes_written > 0 ? bytes_written : 0;
+    for (size_t i = 0; i < iov_count && bytes_left >= iov[i].iov_len; ++i) {
+      bytes_left -= iov[i].iov_len;
+      message_send_bytes_written_ = 0;
+
+      // Message sent OK!
+      Message* sent = output_queue_.front();
+      DVLOG(2) << "sent message @" << sent << " on channel @" << this
+               << " with type " << sent->type() << " on fd " << pipe_;
+      delete sent;
+      output_queue_.pop_front();
+    }
+
     if (static_cast<size_t>(bytes_written) != amt_to_write) {
-      if (bytes_written > 0) {
-        // If write() fails with EAGAIN then bytes_written will be -1.
-        message_send_bytes_written_ += bytes_written;
-      }
+      // If write() fails with EAGAIN then bytes_written will be -1, and
+      // |bytes_left| 0.
+      message_send_bytes_written_ += bytes_left;
 
       // Tell libevent to call us back once things are unblocked.
       is_blocked_on_write_ = true;
@@ -501,14 +529,6 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
           &write_watcher_,
           this);
       return true;
-    } else {
-      message_send_bytes_written_ = 0;
-
-      // Message sent OK!
-      DVLOG(2) << "sent message @" << msg << " on channel @" << this
-               << " with type " << msg->type() << " on fd " << pipe_;
-      delete output_queue_.front();
-      output_queue_.pop();
     }
   }
   return true;
@@ -524,7 +544,7 @@ bool Channel::ChannelImpl::Send(Message* message) {
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
   message->TraceMessageBegin();
-  output_queue_.push(message);
+  output_queue_.push_back(message);
   if (!is_blocked_on_write_ && !waiting_connect_) {
     return ProcessOutgoingMessages();
   }
@@ -594,7 +614,7 @@ void Channel::ChannelImpl::ResetToAcceptingConnectionState() {
 
   while (!output_queue_.empty()) {
     Message* m = output_queue_.front();
-    output_queue_.pop();
+    output_queue_.pop_front();
     delete m;
   }
 
@@ -764,7 +784,7 @@ void Channel::ChannelImpl::QueueHelloMessage() {
     DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
   }
 #endif  // IPC_USES_READWRITE
-  output_queue_.push(msg.release());
+  output_queue_.push_back(msg.release());
 }
 
 Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadData(
@@ -949,7 +969,7 @@ void Channel::ChannelImpl::QueueCloseFDMessage(int fd, int hops) {
         NOTREACHED() << "Unable to pickle close fd.";
       }
       // Send(msg.release());
-      output_queue_.push(msg.release());
+      output_queue_.push_back(msg.release());
       break;
     }
 
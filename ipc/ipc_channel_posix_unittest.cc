@@ -100,6 +100,50 @@ class IPCChannelPosixTestListener : public IPC::Listener {
   bool quit_only_on_message_;
 };
 
+// Checks that messages arrive in the order they were sent, along with their
+// descriptors, and quits the run loop once |expected_count| have.
+class IPCChannelPosixOrderListener : public IPC::Listener {
+ public:
+  explicit IPCChannelPosixOrderListener(int expected_count)
+      : expected_count_(expected_count), received_count_(0) {
+  }
+
+  virtual ~IPCChannelPosixOrderListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    int sequence_number = -1;
+    std::string payload;
+    EXPECT_TRUE(message.ReadInt(&iter, &sequence_number));
+    EXPECT_TRUE(message.ReadString(&iter, &payload));
+    EXPECT_EQ(received_count_, sequence_number);
+    EXPECT_EQ(static_cast<size_t>(message.type()), payload.size());
+    base::FileDescriptor descriptor;
+    if (message.ReadFileDescriptor(&iter, &descriptor)) {
+      EXPECT_EQ(0, received_count_ % kDescriptorInterval);
+      EXPECT_EQ(0, IGNORE_EINTR(close(descriptor.fd)));
+    } else {
+      EXPECT_NE(0, received_count_ % kDescriptorInterval);
+    }
+    if (++received_count_ == expected_count_)
+      base::MessageLoopForIO::current()->QuitNow();
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    base::MessageLoopForIO::current()->QuitNow();
+  }
+
+  int received_count() const { return received_count_; }
+
+  // Every this many messages carries a descriptor.
+  static const int kDescriptorInterval = 7;
+
+ private:
+  const int expected_count_;
+  int received_count_;
+};
+
 class IPCChannelPosixTest : public base::MultiProcessTest {
  public:
   static void SetUpSocket(IPC::ChannelHandle *handle,
@@ -257,6 +301,40 @@ TEST_F(IPCChannelPosixTest, SendHangTest) {
   ASSERT_EQ(IPCChannelPosixTestListener::CHANNEL_ERROR, out_listener.status());
 }
 
+// Messages queued while the channel is blocked go out in batches; make sure
+// they arrive whole and in order, including the ones with descriptors and the
+// ones that span several reads.
+TEST_F(IPCChannelPosixTest, SendManyMessages) {
+  const int kMessageCount = 300;
+  IPCChannelPosixTestListener out_listener(true);
+  IPCChannelPosixOrderListener in_listener(kMessageCount);
+  IPC::ChannelHandle in_handle("IN");
+  IPC::Channel in_chan(in_handle, IPC::Channel::MODE_SERVER, &in_listener);
+  base::FileDescriptor out_fd(in_chan.TakeClientFileDescriptor(), false);
+  IPC::ChannelHandle out_handle("OUT", out_fd);
+  IPC::Channel out_chan(out_handle, IPC::Channel::MODE_CLIENT, &out_listener);
+  ASSERT_TRUE(in_chan.Connect());
+  ASSERT_TRUE(out_chan.Connect());
+
+  for (int i = 0; i < kMessageCount; ++i) {
+    // The type doubles as the payload size, which varies from a few bytes to
+    // several times IPC::Channel::kReadBufferSize.
+    const size_t payload_size = (i * 397) % 20000;
+    IPC::Message* message = new IPC::Message(
+        0, static_cast<uint32>(payload_size), IPC::Message::PRIORITY_NORMAL);
+    message->WriteInt(i);
+    message->WriteString(std::string(payload_size, 'a' + i % 26));
+    if (i % IPCChannelPosixOrderListener::kDescriptorInterval == 0) {
+      int fd = open("/dev/null", O_RDONLY);
+      ASSERT_GE(fd, 0);
+      ASSERT_TRUE(message->WriteFileDescriptor(base::FileDescriptor(fd, true)));
+    }
+    ASSERT_TRUE(out_chan.Send(message));
+  }
+  SpinRunLoop(TestTimeouts::action_max_timeout());
+  EXPECT_EQ(kMessageCount, in_listener.received_count());
+}
+
 // If a connection closes right before a Connect() call, we may end up closing
 // the connection without notifying the listener, which can cause hangs in
 // sync_message_filter and others. Make sure the listener is notified.
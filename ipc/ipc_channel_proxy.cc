@@ -9,6 +9,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/stl_util.h"
 #include "base/thread_task_runner_handle.h"
 #include "ipc/ipc_channel_proxy.h"
 #include "ipc/ipc_listener.h"
@@ -40,13 +41,44 @@ ChannelProxy::MessageFilter::~MessageFilter() {}
 
 //------------------------------------------------------------------------------
 
+ChannelProxy::Context::MessageLanes::MessageLanes() {}
+
+ChannelProxy::Context::MessageLanes::~MessageLanes() {
+  STLDeleteElements(&urgent_);
+  STLDeleteElements(&normal_);
+}
+
+void ChannelProxy::Context::MessageLanes::Push(Message* message) {
+  if (message->priority() == Message::PRIORITY_HIGH)
+    urgent_.push_back(message);
+  else
+    normal_.push_back(message);
+}
+
+Message* ChannelProxy::Context::MessageLanes::Pop() {
+  DCHECK(!empty());
+  std::deque<Message*>* lane = urgent_.empty() ? &normal_ : &urgent_;
+  Message* message = lane->front();
+  lane->pop_front();
+  return message;
+}
+
+void ChannelProxy::Context::MessageLanes::Swap(MessageLanes* other) {
+  urgent_.swap(other->urgent_);
+  normal_.swap(other->normal_);
+}
+
+//------------------------------------------------------------------------------
+
 ChannelProxy::Context::Context(Listener* listener,
                                base::SingleThreadTaskRunner* ipc_task_runner)
     : listener_task_runner_(base::ThreadTaskRunnerHandle::Get()),
       listener_(listener),
       ipc_task_runner_(ipc_task_runner),
       channel_connected_called_(false),
-      peer_pid_(base::kNullProcessId) {
+      peer_pid_(base::kNullProcessId),
+      send_task_pending_(false),
+      dispatch_task_pending_(false) {
   DCHECK(ipc_task_runner_.get());
 }
 
@@ -93,8 +125,17 @@ bool ChannelProxy::Context::OnMessageReceived(const Message& message) {
 
 // Called on the IPC::Channel thread
 bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchMessage, this, message));
+  bool post_task;
+  {
+    base::AutoLock auto_lock(received_messages_lock_);
+    received_messages_.Push(new Message(message));
+    post_task = !dispatch_task_pending_;
+    dispatch_task_pending_ = true;
+  }
+  if (post_task) {
+    listener_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&Context::OnDispatchMessages, this));
+  }
   return true;
 }
 
@@ -170,13 +211,23 @@ void ChannelProxy::Context::Clear() {
 }
 
 // Called on the IPC::Channel thread
-void ChannelProxy::Context::OnSendMessage(scoped_ptr<Message> message) {
-  if (!channel_.get()) {
-    OnChannelClosed();
-    return;
+void ChannelProxy::Context::OnSendMessages() {
+  MessageLanes messages;
+  {
+    base::AutoLock auto_lock(outgoing_messages_lock_);
+    messages.Swap(&outgoing_messages_);
+    send_task_pending_ = false;
+  }
+
+  while (!messages.empty()) {
+    scoped_ptr<Message> message(messages.Pop());
+    if (!channel_.get()) {
+      OnChannelClosed();
+      return;
+    }
+    if (!channel_->Send(message.release()))
+      OnChannelError();
   }
-  if (!channel_->Send(message.release()))
-    OnChannelError();
 }
 
 // Called on the IPC::Channel thread
@@ -216,6 +267,20 @@ void ChannelProxy::Context::OnRemoveFilter(MessageFilter* filter) {
   NOTREACHED() << "filter to be removed not found";
 }
 
+void ChannelProxy::Context::Send(Message* message) {
+  bool post_task;
+  {
+    base::AutoLock auto_lock(outgoing_messages_lock_);
+    outgoing_messages_.Push(message);
+    post_task = !send_task_pending_;
+    send_task_pending_ = true;
+  }
+  if (post_task) {
+    ipc_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&Context::OnSendMessages, this));
+  }
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::AddFilter(MessageFilter* filter) {
   base::AutoLock auto_lock(pending_filters_lock_);
@@ -224,6 +289,34 @@ void ChannelProxy::Context::AddFilter(MessageFilter* filter) {
       FROM_HERE, base::Bind(&Context::OnAddFilter, this));
 }
 
+// Called on the listener's thread
+void ChannelProxy::Context::OnDispatchMessages() {
+  // Each task dispatches a single message, and posts the task for the next one
+  // first. That way, a handler that runs a nested message loop still gets the
+  // messages that follow, and tasks that filters post to this thread run
+  // between the messages they came with, much as if every message had a task
+  // of its own.
+  scoped_ptr<Message> message;
+  bool post_task = false;
+  {
+    base::AutoLock auto_lock(received_messages_lock_);
+    dispatch_task_pending_ = false;
+    // OnDispatchError() may have dispatched everything already.
+    if (received_messages_.empty())
+      return;
+    message.reset(received_messages_.Pop());
+    if (!received_messages_.empty()) {
+      post_task = true;
+      dispatch_task_pending_ = true;
+    }
+  }
+  if (post_task) {
+    listener_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&Context::OnDispatchMessages, this));
+  }
+  OnDispatchMessage(*message);
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
 #ifdef IPC_MESSAGE_LOG_ENABLED
@@ -273,6 +366,19 @@ void ChannelProxy::Context::OnDispatchConnected() {
 
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchError() {
+  // The messages received before the error are dispatched first, even if
+  // their OnDispatchMessages() tasks come after this one.
+  while (true) {
+    scoped_ptr<Message> message;
+    {
+      base::AutoLock auto_lock(received_messages_lock_);
+      if (received_messages_.empty())
+        break;
+      message.reset(received_messages_.Pop());
+    }
+    OnDispatchMessage(*message);
+  }
+
   if (listener_)
     listener_->OnChannelError();
 }
@@ -357,10 +463,7 @@ bool ChannelProxy::Send(Message* message) {
   Logging::GetInstance()->OnSendMessage(message, context_->channel_id());
 #endif
 
-  context_->ipc_task_runner()->PostTask(
-      FROM_HERE,
-      base::Bind(&ChannelProxy::Context::OnSendMessage,
-                 context_, base::Passed(scoped_ptr<Message>(message))));
+  context_->Send(message);
   return true;
 }
 
@@ -5,6 +5,7 @@
 #ifndef IPC_IPC_CHANNEL_PROXY_H_
 #define IPC_IPC_CHANNEL_PROXY_H_
 
+#include <deque>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
@@ -49,6 +50,15 @@ class SendCallbackHelper;
 // be bogged down with other processing.  The result can be greatly improved
 // latency for messages that can be handled on a background thread.
 //
+// Messages crossing between the two threads are queued.  On the IPC thread a
+// single task hands a whole burst of sent messages to the channel.  On the
+// listener thread each task dispatches one received message, so that nested
+// message loops keep dispatching.  Messages sent or received with
+// Message::PRIORITY_HIGH jump ahead of the queued messages of lower priority
+// that have not yet been handed over, but keep their order among themselves.
+// Only use it for messages whose handlers don't depend on the order relative
+// to other messages, such as input events and acks.
+//
 // The consumer of IPC::ChannelProxy is responsible for allocating the Thread
 // instance where the IPC::Channel will be created and operated.
 //
@@ -206,17 +216,47 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
     friend class ChannelProxy;
     friend class SendCallbackHelper;
 
+    // A queue of messages in two lanes: messages with PRIORITY_HIGH, and the
+    // rest.
+    class MessageLanes {
+     public:
+      MessageLanes();
+      ~MessageLanes();
+
+      bool empty() const { return urgent_.empty() && normal_.empty(); }
+
+      // Takes ownership of |message|.
+      void Push(Message* message);
+
+      // Returns the oldest urgent message, or else the oldest message, and
+      // passes its ownership to the caller.  The lanes must not be empty.
+      Message* Pop();
+
+      void Swap(MessageLanes* other);
+
+     private:
+      std::deque<Message*> urgent_;
+      std::deque<Message*> normal_;
+
+      DISALLOW_COPY_AND_ASSIGN(MessageLanes);
+    };
+
     // Create the Channel
     void CreateChannel(const IPC::ChannelHandle& channel_handle,
                        const Channel::Mode& mode);
 
     // Methods called on the IO thread.
-    void OnSendMessage(scoped_ptr<Message> message_ptr);
+    void OnSendMessages();
     void OnAddFilter();
     void OnRemoveFilter(MessageFilter* filter);
 
+    // Queues |message| for the IPC thread.  Called on the listener thread, or
+    // wherever ChannelProxy::Send() is.
+    void Send(Message* message);
+
     // Methods called on the listener thread.
     void AddFilter(MessageFilter* filter);
+    void OnDispatchMessages();
     void OnDispatchConnected();
     void OnDispatchError();
 
@@ -239,6 +279,18 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
     // Cached copy of the peer process ID. Set on IPC but read on both IPC and
     // listener threads.
     base::ProcessId peer_pid_;
+
+    // Messages waiting for OnSendMessages() on the IPC thread, and whether
+    // that task has been posted.
+    MessageLanes outgoing_messages_;
+    bool send_task_pending_;
+    base::Lock outgoing_messages_lock_;
+
+    // Messages waiting for OnDispatchMessages() on the listener thread, and
+    // whether that task has been posted.
+    MessageLanes received_messages_;
+    bool dispatch_task_pending_;
+    base::Lock received_messages_lock_;
   };
 
   Context* context() { return context_.get(); }
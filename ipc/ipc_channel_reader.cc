@@ -4,6 +4,8 @@
 
 #include "ipc/ipc_channel_reader.h"
 
+#include <algorithm>
+
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_logging.h"
 #include "ipc/ipc_message_macros.h"
@@ -51,26 +53,67 @@ bool ChannelReader::IsHelloMessage(const Message& m) const {
 
 bool ChannelReader::DispatchInputData(const char* input_data,
                                       int input_data_len) {
-  const char* p;
-  const char* end;
-
-  // Possibly combine with the overflow buffer to make a larger buffer.
-  if (input_overflow_buf_.empty()) {
-    p = input_data;
-    end = input_data + input_data_len;
-  } else {
-    if (input_overflow_buf_.size() + input_data_len >
-        Channel::kMaximumMessageSize) {
+  const char* p = input_data;
+  const char* end = input_data + input_data_len;
+
+  // Complete the message left over from the previous read, if any.  Only the
+  // bytes it still needs are copied; the messages after it are dispatched
+  // straight from |input_data|.
+  if (!input_overflow_buf_.empty()) {
+    uint64 message_size = Message::GetMessageSize(
+        input_overflow_buf_.data(),
+        input_overflow_buf_.data() + input_overflow_buf_.size());
+    size_t bytes_to_append = static_cast<size_t>(input_data_len);
+    if (message_size) {
+      if (message_size > Channel::kMaximumMessageSize) {
+        input_overflow_buf_.clear();
+        LOG(ERROR) << "IPC message is too big";
+        return false;
+      }
+      // The buffer only ever holds part of a message, but the size came from
+      // the peer, so don't let a bad one underflow.  The buffer isn't
+      // reserved up front: it grows with the bytes that actually arrive.
+      DCHECK_GT(message_size, input_overflow_buf_.size());
+      size_t bytes_missing = static_cast<size_t>(message_size) >
+          input_overflow_buf_.size() ?
+          static_cast<size_t>(message_size) - input_overflow_buf_.size() : 0;
+      bytes_to_append = std::min(bytes_to_append, bytes_missing);
+    } else if (input_overflow_buf_.size() + input_data_len >
+               Channel::kMaximumMessageSize) {
+      // Not even the header is complete yet, so everything is appended.
       input_overflow_buf_.clear();
       LOG(ERROR) << "IPC message is too big";
       return false;
     }
-    input_overflow_buf_.append(input_data, input_data_len);
-    p = input_overflow_buf_.data();
-    end = p + input_overflow_buf_.size();
+    input_overflow_buf_.append(p, bytes_to_append);
+    p += bytes_to_append;
+
+    const char* overflow_p = input_overflow_buf_.data();
+    const char* overflow_end = overflow_p + input_overflow_buf_.size();
+    if (!DispatchMessages(&overflow_p, overflow_end))
+      return false;
+    if (overflow_p != overflow_end) {
+      // Still partial, so all of |input_data| went into the overflow buffer.
+      DCHECK(p == end);
+      input_overflow_buf_.erase(0, overflow_p - input_overflow_buf_.data());
+      return true;
+    }
+    input_overflow_buf_.clear();
   }
 
-  // Dispatch all complete messages in the data buffer.
+  if (!DispatchMessages(&p, end))
+    return false;
+
+  // Save any partial data in the overflow buffer.
+  input_overflow_buf_.assign(p, end - p);
+
+  if (input_overflow_buf_.empty() && !DidEmptyInputBuffers())
+    return false;
+  return true;
+}
+
+bool ChannelReader::DispatchMessages(const char** data, const char* end) {
+  const char* p = *data;
   while (p < end) {
     const char* message_tail = Message::FindNext(p, end);
     if (message_tail) {
@@ -101,15 +144,9 @@ bool ChannelReader::DispatchInputData(const char* input_data,
       break;
     }
   }
-
-  // Save any partial data in the overflow buffer.
-  input_overflow_buf_.assign(p, end - p);
-
-  if (input_overflow_buf_.empty() && !DidEmptyInputBuffers())
-    return false;
+  *data = p;
   return true;
 }
 
-
 }  // namespace internal
 }  // namespace IPC
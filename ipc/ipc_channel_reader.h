@@ -90,6 +90,10 @@ class ChannelReader {
   // Returns true on success. False means channel error.
   bool DispatchInputData(const char* input_data, int input_data_len);
 
+  // Dispatches the complete messages in [*data, end), and advances |*data|
+  // past them.  Returns false on channel error.
+  bool DispatchMessages(const char** data, const char* end);
+
   Listener* listener_;
 
   // We read from the pipe into this buffer. Managed by DispatchInputData, do
@@ -9,10 +9,14 @@
 #endif
 
 #include <string>
+#include <vector>
 
 #include "base/message_loop/message_loop.h"
 #include "base/pickle.h"
+#include "base/run_loop.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/threading/thread.h"
+#include "ipc/ipc_channel_proxy.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_test_base.h"
 
@@ -209,6 +213,175 @@ TEST_F(IPCChannelTest, ChannelProxyTest) {
   thread.Stop();
 }
 
+// Signals |event| once |count| messages have reached the IPC thread.
+class MessageCountingFilter : public IPC::ChannelProxy::MessageFilter {
+ public:
+  MessageCountingFilter(int count, base::WaitableEvent* event)
+      : count_(count), event_(event) {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    if (--count_ == 0)
+      event_->Signal();
+    return false;
+  }
+
+ private:
+  virtual ~MessageCountingFilter() {}
+
+  int count_;
+  base::WaitableEvent* event_;
+};
+
+// Records the ids of the messages it receives, and quits after |count|.
+class MessageOrderListener : public IPC::Listener {
+ public:
+  explicit MessageOrderListener(size_t count) : count_(count) {}
+  virtual ~MessageOrderListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    int id = -1;
+    EXPECT_TRUE(iter.ReadInt(&id));
+    ids_.push_back(id);
+    if (ids_.size() == count_)
+      base::MessageLoop::current()->Quit();
+    return true;
+  }
+
+  const std::vector<int>& ids() const { return ids_; }
+
+ private:
+  const size_t count_;
+  std::vector<int> ids_;
+};
+
+// Messages with PRIORITY_HIGH are dispatched ahead of the ones that were
+// waiting for the listener thread.
+TEST_F(IPCChannelTest, ChannelProxyUrgentMessages) {
+  base::Thread thread("ChannelProxyTestIO");
+  base::Thread::Options options;
+  options.message_loop_type = base::MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+
+  const int kNormalCount = 5;
+  const std::string kChannelName = GetChannelName("ChannelProxyUrgent");
+  base::WaitableEvent normal_received(false, false);
+  base::WaitableEvent urgent_received(false, false);
+  MessageOrderListener server_listener(kNormalCount + 1);
+  scoped_ptr<IPC::ChannelProxy> server(new IPC::ChannelProxy(
+      kChannelName, IPC::Channel::MODE_SERVER, &server_listener,
+      thread.message_loop_proxy().get()));
+  server->AddFilter(new MessageCountingFilter(kNormalCount, &normal_received));
+  server->AddFilter(
+      new MessageCountingFilter(kNormalCount + 1, &urgent_received));
+  MessageOrderListener client_listener(0);
+  scoped_ptr<IPC::ChannelProxy> client(new IPC::ChannelProxy(
+      kChannelName, IPC::Channel::MODE_CLIENT, &client_listener,
+      thread.message_loop_proxy().get()));
+
+  for (int i = 0; i < kNormalCount; ++i) {
+    IPC::Message* message =
+        new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+    message->WriteInt(i);
+    client->Send(message);
+  }
+  // Only send the urgent message once the others reached the server's IPC
+  // thread, so that the client's send queue can't have reordered them.
+  normal_received.Wait();
+  IPC::Message* message = new IPC::Message(0, 2, IPC::Message::PRIORITY_HIGH);
+  message->WriteInt(kNormalCount);
+  client->Send(message);
+
+  // Hold up the listener thread until all the messages are in.
+  urgent_received.Wait();
+  base::MessageLoop::current()->Run();
+
+  const std::vector<int>& ids = server_listener.ids();
+  ASSERT_EQ(static_cast<size_t>(kNormalCount + 1), ids.size());
+  EXPECT_EQ(kNormalCount, ids[0]);
+  for (int i = 1; i <= kNormalCount; ++i)
+    EXPECT_EQ(i - 1, ids[i]);
+
+  // Destroy the channel proxies before shutting down the thread.
+  client.reset();
+  server.reset();
+  thread.Stop();
+}
+
+// Runs a nested message loop for the first message it receives, until the
+// second one arrives.
+class NestedLoopListener : public IPC::Listener {
+ public:
+  NestedLoopListener() : nested_run_loop_(NULL) {}
+  virtual ~NestedLoopListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    int id = -1;
+    EXPECT_TRUE(iter.ReadInt(&id));
+    ids_.push_back(id);
+    if (ids_.size() == 1) {
+      base::MessageLoop::ScopedNestableTaskAllower allow(
+          base::MessageLoop::current());
+      base::RunLoop run_loop;
+      nested_run_loop_ = &run_loop;
+      run_loop.Run();
+      nested_run_loop_ = NULL;
+      base::MessageLoop::current()->Quit();
+    } else if (nested_run_loop_) {
+      nested_run_loop_->Quit();
+    }
+    return true;
+  }
+
+  const std::vector<int>& ids() const { return ids_; }
+
+ private:
+  base::RunLoop* nested_run_loop_;
+  std::vector<int> ids_;
+};
+
+// Messages keep being dispatched while a handler runs a nested message loop.
+TEST_F(IPCChannelTest, ChannelProxyNestedLoop) {
+  base::Thread thread("ChannelProxyTestIO");
+  base::Thread::Options options;
+  options.message_loop_type = base::MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+
+  const std::string kChannelName = GetChannelName("ChannelProxyNestedLoop");
+  base::WaitableEvent received(false, false);
+  NestedLoopListener server_listener;
+  scoped_ptr<IPC::ChannelProxy> server(new IPC::ChannelProxy(
+      kChannelName, IPC::Channel::MODE_SERVER, &server_listener,
+      thread.message_loop_proxy().get()));
+  server->AddFilter(new MessageCountingFilter(2, &received));
+  MessageOrderListener client_listener(0);
+  scoped_ptr<IPC::ChannelProxy> client(new IPC::ChannelProxy(
+      kChannelName, IPC::Channel::MODE_CLIENT, &client_listener,
+      thread.message_loop_proxy().get()));
+
+  for (int i = 0; i < 2; ++i) {
+    IPC::Message* message =
+        new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+    message->WriteInt(i);
+    client->Send(message);
+  }
+
+  // Both messages wait for the listener thread together.
+  received.Wait();
+  base::MessageLoop::current()->Run();
+
+  const std::vector<int>& ids = server_listener.ids();
+  ASSERT_EQ(2u, ids.size());
+  EXPECT_EQ(0, ids[0]);
+  EXPECT_EQ(1, ids[1]);
+
+  // Destroy the channel proxies before shutting down the thread.
+  client.reset();
+  server.reset();
+  thread.Stop();
+}
+
 class ChannelListenerWithOnConnectedSend : public GenericChannelListener {
  public:
   ChannelListenerWithOnConnectedSend() {}
@@ -179,6 +179,18 @@ class IPC_EXPORT Message : public Pickle {
     return Pickle::FindNext(sizeof(Header), range_start, range_end);
   }
 
+  // Returns the size of the message that starts at range_start, or 0 if not
+  // enough of its header is in the given data range to tell.  The size comes
+  // from the peer, so it is computed in 64 bits to keep a bogus payload size
+  // from wrapping around; callers must check it before using it as a size_t.
+  static uint64 GetMessageSize(const char* range_start,
+                               const char* range_end) {
+    if (static_cast<size_t>(range_end - range_start) < sizeof(Header))
+      return 0;
+    const Header* header = reinterpret_cast<const Header*>(range_start);
+    return static_cast<uint64>(sizeof(Header)) + header->payload_size;
+  }
+
 #if defined(OS_POSIX)
   // On POSIX, a message supports reading / writing FileDescriptor objects.
   // This is used to pass a file descriptor to the peer of an IPC channel.
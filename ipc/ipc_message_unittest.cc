@@ -70,4 +70,24 @@ TEST(IPCMessageTest, DictionaryValue) {
   EXPECT_FALSE(IPC::ReadParam(&bad_msg, &iter, &output));
 }
 
+// Tests that a payload size near the 32-bit limit doesn't wrap the message
+// size around to something small.
+TEST(IPCMessageTest, GetMessageSizeDoesNotWrap) {
+  IPC::Message msg(1, 2, IPC::Message::PRIORITY_NORMAL);
+  std::string data(static_cast<const char*>(msg.data()), msg.size());
+  const size_t header_size = msg.size() - msg.payload_size();
+
+  EXPECT_EQ(0u, IPC::Message::GetMessageSize(data.data(),
+                                             data.data() + header_size - 1));
+  EXPECT_EQ(header_size, IPC::Message::GetMessageSize(
+      data.data(), data.data() + data.size()));
+
+  // The payload size is the first field of the header.
+  const uint32 kHugePayload = 0xFFFFFFFFu;
+  memcpy(&data[0], &kHugePayload, sizeof(kHugePayload));
+  EXPECT_EQ(header_size + static_cast<uint64>(kHugePayload),
+            IPC::Message::GetMessageSize(data.data(),
+                                         data.data() + data.size()));
+}
+
 }  // namespace
@@ -63,6 +63,11 @@ class OnMoreDataConverter
 
   const int input_bytes_per_second_;
 
+  // True when the input and output parameters only differ in ways that don't
+  // affect the float data handed around in AudioBus, so |source_callback_| can
+  // render straight into the output stream's buffer.
+  const bool passthrough_;
+
   // Handles resampling, buffering, and channel mixing between input and output
   // parameters.
   AudioConverter audio_converter_;
@@ -327,7 +332,15 @@ OnMoreDataConverter::OnMoreDataConverter(const AudioParameters& input_params,
                 output_params.GetBytesPerSecond()),
       source_callback_(NULL),
       input_bytes_per_second_(input_params.GetBytesPerSecond()),
-      audio_converter_(input_params, output_params, false) {}
+      passthrough_(
+          input_params.sample_rate() == output_params.sample_rate() &&
+          input_params.channel_layout() == output_params.channel_layout() &&
+          input_params.channels() == output_params.channels() &&
+          input_params.frames_per_buffer() ==
+              output_params.frames_per_buffer()),
+      audio_converter_(input_params, output_params, false) {
+  DVLOG_IF(1, passthrough_) << "Output parameters match, not converting.";
+}
 
 OnMoreDataConverter::~OnMoreDataConverter() {
   // Ensure Stop() has been called so we don't end up with an AudioOutputStream
@@ -360,6 +373,23 @@ int OnMoreDataConverter::OnMoreData(AudioBus* dest,
 int OnMoreDataConverter::OnMoreIOData(AudioBus* source,
                                       AudioBus* dest,
                                       AudioBuffersState buffers_state) {
+  // Skip AudioConverter entirely when there's nothing to convert; this saves a
+  // copy per callback and lets unified IO input through.
+  if (passthrough_) {
+    current_buffers_state_ = buffers_state;
+    AudioBuffersState new_buffers_state;
+    new_buffers_state.pending_bytes =
+        io_ratio_ * current_buffers_state_.total_bytes();
+    const int frames =
+        source_callback_->OnMoreIOData(source, dest, new_buffers_state);
+
+    // Match the converter path: always hand back a full buffer, padded with
+    // silence if the source came up short.
+    if (frames < dest->frames())
+      dest->ZeroFramesPartial(frames, dest->frames() - frames);
+    return dest->frames();
+  }
+
   // Note: The input portion of OnMoreIOData() is not supported when a converter
   // has been injected.  Downstream clients prefer silence to potentially split
   // apart input data.
@@ -24,6 +24,15 @@ const char kEnableADTSStreamParser[] = "enable-adts-stream-parser";
 // Enables MP3 stream parser for Media Source Extensions.
 const char kEnableMP3StreamParser[] = "enable-mp3-stream-parser";
 
+// Overrides the amount of audio data, in megabytes, that each Media Source
+// Extensions SourceBuffer keeps in memory before garbage collecting.
+const char kMSEAudioBufferSizeLimit[] = "mse-audio-buffer-size-limit-mb";
+
+// Overrides the amount of video data, in megabytes, that each Media Source
+// Extensions SourceBuffer keeps in memory before garbage collecting.  Useful
+// on memory constrained devices playing long running live streams.
+const char kMSEVideoBufferSizeLimit[] = "mse-video-buffer-size-limit-mb";
+
 #if defined(OS_ANDROID)
 // Disables the infobar popup for accessing protected media identifier.
 const char kDisableInfobarForProtectedMediaIdentifier[] =
@@ -23,6 +23,9 @@ MEDIA_EXPORT extern const char kVideoThreads[];
 MEDIA_EXPORT extern const char kEnableADTSStreamParser[];
 MEDIA_EXPORT extern const char kEnableMP3StreamParser[];
 
+MEDIA_EXPORT extern const char kMSEAudioBufferSizeLimit[];
+MEDIA_EXPORT extern const char kMSEVideoBufferSizeLimit[];
+
 #if defined(OS_ANDROID)
 MEDIA_EXPORT extern const char kDisableInfobarForProtectedMediaIdentifier[];
 MEDIA_EXPORT extern const char kMediaDrmEnableNonCompositing[];
@@ -0,0 +1,73 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <arm_neon.h>
+
+#include "media/base/simd/convert_yuv_to_rgb.h"
+#include "media/base/simd/yuv_to_rgb_table.h"
+
+namespace media {
+
+// Same table driven conversion as ConvertYUVToRGB32Row_C(), but each pixel's
+// four channels are summed, shifted and clamped in a single NEON register, the
+// way the MMX and SSE versions do it.  The output is bit exact with the C
+// version on all platforms, since byte N of each pixel always comes from
+// column N of the coefficient table.
+void ConvertYUVToRGB32Row_NEON(const uint8* y_buf,
+                               const uint8* u_buf,
+                               const uint8* v_buf,
+                               uint8* rgb_buf,
+                               ptrdiff_t width) {
+  const ptrdiff_t last_pair = width & ~1;
+  for (ptrdiff_t x = 0; x < last_pair; x += 2) {
+    const int16x4_t uv = vqadd_s16(
+        vld1_s16(kCoefficientsRgbY[256 + u_buf[x >> 1]]),
+        vld1_s16(kCoefficientsRgbY[512 + v_buf[x >> 1]]));
+    const int16x4_t pixel0 = vshr_n_s16(
+        vqadd_s16(uv, vld1_s16(kCoefficientsRgbY[y_buf[x]])), 6);
+    const int16x4_t pixel1 = vshr_n_s16(
+        vqadd_s16(uv, vld1_s16(kCoefficientsRgbY[y_buf[x + 1]])), 6);
+    vst1_u8(rgb_buf, vqmovun_s16(vcombine_s16(pixel0, pixel1)));
+    rgb_buf += 8;  // Advance 2 pixels.
+  }
+
+  // Handle the last pixel of odd width rows.
+  if (width & 1) {
+    const int16x4_t uv = vqadd_s16(
+        vld1_s16(kCoefficientsRgbY[256 + u_buf[last_pair >> 1]]),
+        vld1_s16(kCoefficientsRgbY[512 + v_buf[last_pair >> 1]]));
+    const int16x4_t pixel = vshr_n_s16(
+        vqadd_s16(uv, vld1_s16(kCoefficientsRgbY[y_buf[last_pair]])), 6);
+    vst1_lane_u32(reinterpret_cast<uint32*>(rgb_buf),
+                  vreinterpret_u32_u8(vqmovun_s16(vcombine_s16(pixel, pixel))),
+                  0);
+  }
+}
+
+void ConvertYUVToRGB32_NEON(const uint8* yplane,
+                            const uint8* uplane,
+                            const uint8* vplane,
+                            uint8* rgbframe,
+                            int width,
+                            int height,
+                            int ystride,
+                            int uvstride,
+                            int rgbstride,
+                            YUVType yuv_type) {
+  unsigned int y_shift = yuv_type;
+  for (int y = 0; y < height; ++y) {
+    uint8* rgb_row = rgbframe + y * rgbstride;
+    const uint8* y_ptr = yplane + y * ystride;
+    const uint8* u_ptr = uplane + (y >> y_shift) * uvstride;
+    const uint8* v_ptr = vplane + (y >> y_shift) * uvstride;
+
+    ConvertYUVToRGB32Row_NEON(y_ptr,
+                              u_ptr,
+                              v_ptr,
+                              rgb_row,
+                              width);
+  }
+}
+
+}  // namespace media
@@ -25,6 +25,7 @@ namespace vector_math {
 #if defined(__SSE__)
 #define FMAC_FUNC FMAC_SSE
 #define FMUL_FUNC FMUL_SSE
+#define DotProduct_FUNC DotProduct_SSE
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_SSE
 void Initialize() {}
 #else
@@ -32,11 +33,14 @@ void Initialize() {}
 // TODO(dalecurtis): Once Chrome moves to an SSE baseline this can be removed.
 #define FMAC_FUNC g_fmac_proc_
 #define FMUL_FUNC g_fmul_proc_
+#define DotProduct_FUNC g_dot_product_proc_
 #define EWMAAndMaxPower_FUNC g_ewma_power_proc_
 
 typedef void (*MathProc)(const float src[], float scale, int len, float dest[]);
 static MathProc g_fmac_proc_ = NULL;
 static MathProc g_fmul_proc_ = NULL;
+typedef float (*DotProductProc)(const float a[], const float b[], int len);
+static DotProductProc g_dot_product_proc_ = NULL;
 typedef std::pair<float, float> (*EWMAAndMaxPowerProc)(
     float initial_value, const float src[], int len, float smoothing_factor);
 static EWMAAndMaxPowerProc g_ewma_power_proc_ = NULL;
@@ -44,22 +48,26 @@ static EWMAAndMaxPowerProc g_ewma_power_proc_ = NULL;
 void Initialize() {
   CHECK(!g_fmac_proc_);
   CHECK(!g_fmul_proc_);
+  CHECK(!g_dot_product_proc_);
   CHECK(!g_ewma_power_proc_);
   const bool kUseSSE = base::CPU().has_sse();
   g_fmac_proc_ = kUseSSE ? FMAC_SSE : FMAC_C;
   g_fmul_proc_ = kUseSSE ? FMUL_SSE : FMUL_C;
+  g_dot_product_proc_ = kUseSSE ? DotProduct_SSE : DotProduct_C;
   g_ewma_power_proc_ = kUseSSE ? EWMAAndMaxPower_SSE : EWMAAndMaxPower_C;
 }
 #endif
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 #define FMAC_FUNC FMAC_NEON
 #define FMUL_FUNC FMUL_NEON
+#define DotProduct_FUNC DotProduct_NEON
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_NEON
 void Initialize() {}
 #else
 // Unknown architecture.
 #define FMAC_FUNC FMAC_C
 #define FMUL_FUNC FMUL_C
+#define DotProduct_FUNC DotProduct_C
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_C
 void Initialize() {}
 #endif
@@ -88,6 +96,19 @@ void FMUL_C(const float src[], float scale, int len, float dest[]) {
     dest[i] = src[i] * scale;
 }
 
+float DotProduct(const float a[], const float b[], int len) {
+  // Ensure |a| is 16-byte aligned.
+  DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(a) & (kRequiredAlignment - 1));
+  return DotProduct_FUNC(a, b, len);
+}
+
+float DotProduct_C(const float a[], const float b[], int len) {
+  float sum = 0.0f;
+  for (int i = 0; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
 std::pair<float, float> EWMAAndMaxPower(
     float initial_value, const float src[], int len, float smoothing_factor) {
   // Ensure |src| is 16-byte aligned.
@@ -136,6 +157,23 @@ void FMUL_NEON(const float src[], float scale, int len, float dest[]) {
     dest[i] = src[i] * scale;
 }
 
+float DotProduct_NEON(const float a[], const float b[], int len) {
+  const int rem = len % 4;
+  const int last_index = len - rem;
+  float32x4_t m_sum = vmovq_n_f32(0);
+  for (int i = 0; i < last_index; i += 4)
+    m_sum = vmlaq_f32(m_sum, vld1q_f32(a + i), vld1q_f32(b + i));
+
+  // Sum components together.
+  float32x2_t m_half = vadd_f32(vget_high_f32(m_sum), vget_low_f32(m_sum));
+  float sum = vget_lane_f32(vpadd_f32(m_half, m_half), 0);
+
+  // Handle any remaining values that wouldn't fit in an NEON pass.
+  for (int i = last_index; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
 std::pair<float, float> EWMAAndMaxPower_NEON(
     float initial_value, const float src[], int len, float smoothing_factor) {
   // When the recurrence is unrolled, we see that we can split it into 4
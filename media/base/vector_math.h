@@ -16,8 +16,8 @@ namespace vector_math {
 enum { kRequiredAlignment = 16 };
 
 // Selects runtime specific optimizations such as SSE.  Must be called prior to
-// calling FMAC() or FMUL().  Called during media library initialization; most
-// users should never have to call this.
+// calling any of the functions below.  Called during media library
+// initialization; most users should never have to call this.
 MEDIA_EXPORT void Initialize();
 
 // Multiply each element of |src| (up to |len|) by |scale| and add to |dest|.
@@ -28,6 +28,11 @@ MEDIA_EXPORT void FMAC(const float src[], float scale, int len, float dest[]);
 // |dest| must be aligned by kRequiredAlignment.
 MEDIA_EXPORT void FMUL(const float src[], float scale, int len, float dest[]);
 
+// Returns the sum of the products of each element of |a| and |b| (up to
+// |len|).  |a| must be aligned by kRequiredAlignment; |b| need not be, so that
+// a fixed block can be correlated against every offset of a search window.
+MEDIA_EXPORT float DotProduct(const float a[], const float b[], int len);
+
 // Computes the exponentially-weighted moving average power of a signal by
 // iterating the recurrence:
 //
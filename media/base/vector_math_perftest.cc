@@ -54,6 +54,26 @@ class VectorMathPerfTest : public testing::Test {
                            true);
   }
 
+  void RunBenchmark(float (*fn)(const float[], const float[], int),
+                    bool aligned,
+                    const std::string& test_name,
+                    const std::string& trace_name) {
+    TimeTicks start = TimeTicks::HighResNow();
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      fn(input_vector_.get(),
+         output_vector_.get(),
+         kVectorSize - (aligned ? 0 : 1));
+    }
+    double total_time_milliseconds =
+        (TimeTicks::HighResNow() - start).InMillisecondsF();
+    perf_test::PrintResult(test_name,
+                           "",
+                           trace_name,
+                           kBenchmarkIterations / total_time_milliseconds,
+                           "runs/ms",
+                           true);
+  }
+
   void RunBenchmark(
       std::pair<float, float> (*fn)(float, const float[], int, float),
       int len,
@@ -142,6 +162,43 @@ TEST_F(VectorMathPerfTest, FMUL) {
 
 #undef FMUL_FUNC
 
+// Define platform independent function name for DotProduct* perf tests.
+#if defined(ARCH_CPU_X86_FAMILY)
+#define DotProduct_FUNC DotProduct_SSE
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#define DotProduct_FUNC DotProduct_NEON
+#endif
+
+// Benchmark for each optimized vector_math::DotProduct() method.
+TEST_F(VectorMathPerfTest, DotProduct) {
+  // Benchmark DotProduct_C().
+  RunBenchmark(vector_math::DotProduct_C,
+               true,
+               "vector_math_dot_product",
+               "unoptimized");
+#if defined(DotProduct_FUNC)
+#if defined(ARCH_CPU_X86_FAMILY)
+  ASSERT_TRUE(base::CPU().has_sse());
+#endif
+  // Benchmark DotProduct_FUNC() with unaligned size.
+  ASSERT_NE((kVectorSize - 1) % (vector_math::kRequiredAlignment /
+                                 sizeof(float)), 0U);
+  RunBenchmark(vector_math::DotProduct_FUNC,
+               false,
+               "vector_math_dot_product",
+               "optimized_unaligned");
+  // Benchmark DotProduct_FUNC() with aligned size.
+  ASSERT_EQ(kVectorSize % (vector_math::kRequiredAlignment / sizeof(float)),
+            0U);
+  RunBenchmark(vector_math::DotProduct_FUNC,
+               true,
+               "vector_math_dot_product",
+               "optimized_aligned");
+#endif
+}
+
+#undef DotProduct_FUNC
+
 #if defined(ARCH_CPU_X86_FAMILY)
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_SSE
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -138,6 +138,52 @@ TEST_F(VectorMathTest, FMUL) {
 #endif
 }
 
+// Ensure each optimized vector_math::DotProduct() method returns the same
+// value, including for lengths which aren't a multiple of the vector width.
+TEST_F(VectorMathTest, DotProduct) {
+  static const int kLength = kVectorSize - 1;
+  static const float kResult = kInputFillValue * kOutputFillValue * kLength;
+  FillTestVectors(kInputFillValue, kOutputFillValue);
+
+  {
+    SCOPED_TRACE("DotProduct");
+    EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct(
+        input_vector_.get(), output_vector_.get(), kLength));
+  }
+
+  {
+    SCOPED_TRACE("DotProduct_C");
+    EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_C(
+        input_vector_.get(), output_vector_.get(), kLength));
+  }
+
+#if defined(ARCH_CPU_X86_FAMILY)
+  {
+    ASSERT_TRUE(base::CPU().has_sse());
+    SCOPED_TRACE("DotProduct_SSE");
+    EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_SSE(
+        input_vector_.get(), output_vector_.get(), kLength));
+  }
+#endif
+
+#if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+  {
+    SCOPED_TRACE("DotProduct_NEON");
+    EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_NEON(
+        input_vector_.get(), output_vector_.get(), kLength));
+  }
+#endif
+
+  // |b| is allowed to be unaligned.
+  {
+    SCOPED_TRACE("DotProduct unaligned");
+    static const float kUnalignedResult =
+        kInputFillValue * kOutputFillValue * (kLength - 1);
+    EXPECT_FLOAT_EQ(kUnalignedResult, vector_math::DotProduct(
+        input_vector_.get(), output_vector_.get() + 1, kLength - 1));
+  }
+}
+
 namespace {
 
 class EWMATestScenario {
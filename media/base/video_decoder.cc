@@ -4,8 +4,39 @@
 
 #include "media/base/video_decoder.h"
 
+#include <algorithm>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
+#include "media/base/media_switches.h"
+#include "media/base/video_decoder_config.h"
+
 namespace media {
 
+// Always use at least two threads for video decoding.  Handling decoding on
+// separate threads frees up the pipeline thread to continue processing, and
+// FFmpeg treats having one thread the same as having zero threads (i.e.,
+// avcodec_decode_video() will execute on the calling thread).
+static const int kMinDecodeThreads = 2;
+static const int kMaxDecodeThreads = 16;
+
+// VP9 tiles are at least 256 pixels wide, and slice and frame threading gain
+// little from more threads than that either.
+static const int kMinPixelsPerDecodeThread = 256;
+
+// Returns the most tile columns a VP9 stream |width| pixels wide can have.
+// libvpx decodes a frame's tile columns in parallel, so threads beyond that
+// sit idle.  The number of tile columns is a power of two, and each is at
+// least kMinPixelsPerDecodeThread wide.
+static int GetVP9TileColumnLimit(int width) {
+  int tile_columns = 1;
+  while (tile_columns * 2 * kMinPixelsPerDecodeThread <= width)
+    tile_columns *= 2;
+  return tile_columns;
+}
+
 VideoDecoder::VideoDecoder() {}
 
 VideoDecoder::~VideoDecoder() {}
@@ -22,4 +53,22 @@ bool VideoDecoder::CanReadWithoutStalling() const {
   return true;
 }
 
+// static
+int VideoDecoder::GetThreadCount(const VideoDecoderConfig& config) {
+  // Refer to http://crbug.com/93932 for tsan suppressions on decoding.
+  const CommandLine* cmd_line = CommandLine::ForCurrentProcess();
+  std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
+  int decode_threads = 0;
+  if (!threads.empty() && base::StringToInt(threads, &decode_threads))
+    return std::min(std::max(decode_threads, 0), kMaxDecodeThreads);
+
+  int width = config.coded_size().width();
+  decode_threads = config.codec() == kCodecVP9 ?
+      GetVP9TileColumnLimit(width) : width / kMinPixelsPerDecodeThread;
+  decode_threads =
+      std::min(decode_threads, base::SysInfo::NumberOfProcessors());
+  decode_threads = std::max(decode_threads, kMinDecodeThreads);
+  return std::min(decode_threads, kMaxDecodeThreads);
+}
+
 }  // namespace media
@@ -86,6 +86,13 @@ class MEDIA_EXPORT VideoDecoder {
   // use a fixed set of VideoFrames for decoding.
   virtual bool CanReadWithoutStalling() const;
 
+  // Returns the number of threads a software decoder should decode |config|
+  // with.  Honors --video-threads if present.  Otherwise the count grows with
+  // the coded width, since both slice and tile threading split frames into
+  // columns, and is capped by the number of processors.  VP9 is also capped
+  // at the number of tile columns its frames can have at that width.
+  static int GetThreadCount(const VideoDecoderConfig& config);
+
  private:
   DISALLOW_COPY_AND_ASSIGN(VideoDecoder);
 };
@@ -0,0 +1,53 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "base/sys_info.h"
+#include "media/base/video_decoder.h"
+#include "media/base/video_decoder_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/rect.h"
+
+namespace media {
+
+static VideoDecoderConfig CreateConfig(VideoCodec codec,
+                                       int width,
+                                       int height) {
+  gfx::Size size(width, height);
+  return VideoDecoderConfig(codec,
+                            VIDEO_CODEC_PROFILE_UNKNOWN,
+                            VideoFrame::YV12,
+                            size,
+                            gfx::Rect(size),
+                            size,
+                            NULL,
+                            0,
+                            false);
+}
+
+TEST(VideoDecoderTest, GetThreadCount) {
+  const int max_threads = std::max(2, base::SysInfo::NumberOfProcessors());
+
+  // Small videos always get the minimum of two threads.
+  EXPECT_EQ(2, VideoDecoder::GetThreadCount(
+      CreateConfig(kCodecVP9, 320, 240)));
+  EXPECT_EQ(2, VideoDecoder::GetThreadCount(
+      CreateConfig(kCodecH264, 320, 240)));
+
+  // Larger videos get more threads, but no more than there are processors.
+  EXPECT_EQ(std::min(1920 / 256, max_threads),
+            VideoDecoder::GetThreadCount(CreateConfig(kCodecH264, 1920, 1080)));
+  EXPECT_EQ(std::min(3840 / 256, max_threads),
+            VideoDecoder::GetThreadCount(CreateConfig(kCodecH264, 3840, 2160)));
+
+  // VP9 gets no more threads than a frame can have tile columns: four at
+  // 1080p and eight at 4K.
+  EXPECT_EQ(std::min(4, max_threads),
+            VideoDecoder::GetThreadCount(CreateConfig(kCodecVP9, 1920, 1080)));
+  EXPECT_EQ(std::min(8, max_threads),
+            VideoDecoder::GetThreadCount(CreateConfig(kCodecVP9, 3840, 2160)));
+}
+
+}  // namespace media
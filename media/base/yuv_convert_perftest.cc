@@ -0,0 +1,138 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/base_paths.h"
+#include "base/cpu.h"
+#include "base/file_util.h"
+#include "base/logging.h"
+#include "base/path_service.h"
+#include "base/time/time.h"
+#include "media/base/simd/convert_yuv_to_rgb.h"
+#include "media/base/yuv_convert.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kBenchmarkIterations = 200;
+
+// Size of the raw test image.
+static const int kSourceWidth = 640;
+static const int kSourceHeight = 360;
+static const int kSourceYSize = kSourceWidth * kSourceHeight;
+static const int kSourceUOffset = kSourceYSize;
+static const int kSourceVOffset = kSourceYSize * 5 / 4;
+static const int kYUV12Size = kSourceYSize * 12 / 8;
+
+// Size of the scaled output, like a 1080p full screen video.
+static const int kScaledWidth = 1920;
+static const int kScaledHeight = 1080;
+static const int kBpp = 4;
+
+typedef void (*ConvertYUVToRGB32RowFn)(const uint8*,
+                                       const uint8*,
+                                       const uint8*,
+                                       uint8*,
+                                       ptrdiff_t);
+
+class YUVConvertPerfTest : public testing::Test {
+ public:
+  YUVConvertPerfTest()
+      : yuv_bytes_(new uint8[kYUV12Size]),
+        rgb_bytes_(new uint8[kScaledWidth * kScaledHeight * kBpp]) {
+    base::FilePath path;
+    CHECK(PathService::Get(base::DIR_SOURCE_ROOT, &path));
+    path = path.Append(FILE_PATH_LITERAL("media"))
+               .Append(FILE_PATH_LITERAL("test"))
+               .Append(FILE_PATH_LITERAL("data"))
+               .Append(FILE_PATH_LITERAL("bali_640x360_P420.yuv"));
+    CHECK_EQ(kYUV12Size,
+             base::ReadFile(path,
+                            reinterpret_cast<char*>(yuv_bytes_.get()),
+                            kYUV12Size));
+  }
+
+  // Converts the whole test image one row at a time with |fn|.
+  void RunConvertRowBenchmark(ConvertYUVToRGB32RowFn fn,
+                              const std::string& trace_name) {
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      for (int row = 0; row < kSourceHeight; ++row) {
+        fn(yuv_bytes_.get() + row * kSourceWidth,
+           yuv_bytes_.get() + kSourceUOffset + (row >> 1) * kSourceWidth / 2,
+           yuv_bytes_.get() + kSourceVOffset + (row >> 1) * kSourceWidth / 2,
+           rgb_bytes_.get() + row * kSourceWidth * kBpp,
+           kSourceWidth);
+      }
+    }
+    EmptyRegisterState();
+    double total_time_milliseconds =
+        (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+    perf_test::PrintResult("yuv_convert_row",
+                           "",
+                           trace_name,
+                           kBenchmarkIterations / total_time_milliseconds,
+                           "frames/ms",
+                           true);
+  }
+
+  // Scales the test image up to 1080p with |filter|, using the conversion
+  // routines selected for this CPU.
+  void RunScaleBenchmark(ScaleFilter filter, const std::string& trace_name) {
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      ScaleYUVToRGB32(yuv_bytes_.get(),
+                      yuv_bytes_.get() + kSourceUOffset,
+                      yuv_bytes_.get() + kSourceVOffset,
+                      rgb_bytes_.get(),
+                      kSourceWidth,
+                      kSourceHeight,
+                      kScaledWidth,
+                      kScaledHeight,
+                      kSourceWidth,
+                      kSourceWidth / 2,
+                      kScaledWidth * kBpp,
+                      YV12,
+                      ROTATE_0,
+                      filter);
+    }
+    double total_time_milliseconds =
+        (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+    perf_test::PrintResult("yuv_scale_to_1080p",
+                           "",
+                           trace_name,
+                           kBenchmarkIterations / total_time_milliseconds,
+                           "frames/ms",
+                           true);
+  }
+
+ protected:
+  scoped_ptr<uint8[]> yuv_bytes_;
+  scoped_ptr<uint8[]> rgb_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(YUVConvertPerfTest);
+};
+
+// Benchmark for each ConvertYUVToRGB32Row() implementation.
+TEST_F(YUVConvertPerfTest, ConvertYUVToRGB32Row) {
+  RunConvertRowBenchmark(ConvertYUVToRGB32Row_C, "unoptimized");
+#if defined(ARCH_CPU_X86_FAMILY)
+  base::CPU cpu;
+  if (cpu.has_mmx())
+    RunConvertRowBenchmark(ConvertYUVToRGB32Row_MMX, "mmx");
+  if (cpu.has_sse())
+    RunConvertRowBenchmark(ConvertYUVToRGB32Row_SSE, "sse");
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+  RunConvertRowBenchmark(ConvertYUVToRGB32Row_NEON, "neon");
+#endif
+}
+
+// Benchmark for the fused scale and convert path used for software decoded
+// frames.
+TEST_F(YUVConvertPerfTest, ScaleYUVToRGB32) {
+  RunScaleBenchmark(FILTER_NONE, "point");
+  RunScaleBenchmark(FILTER_BILINEAR, "bilinear");
+}
+
+}  // namespace media
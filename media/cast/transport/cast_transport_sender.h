@@ -80,6 +80,10 @@ class CastTransportSender : public base::NonThreadSafe {
       bool is_audio,
       const MissingFramesAndPacketsMap& missing_packets) = 0;
 
+  // Informs the transport of the current video bitrate estimate from
+  // congestion control, so that packets can be paced to match it.
+  virtual void SetVideoBitrate(int bits_per_second) = 0;
+
   // Audio/Video RTP statistics.
   // RTP statistics will be returned on a regular interval on the designated
   // callback.
@@ -85,6 +85,10 @@ void CastTransportSenderImpl::ResendPackets(
   }
 }
 
+void CastTransportSenderImpl::SetVideoBitrate(int bits_per_second) {
+  pacer_.SetTargetBitrate(bits_per_second);
+}
+
 void CastTransportSenderImpl::SubscribeAudioRtpStatsCallback(
     const CastTransportRtpStatistics& callback) {
   audio_sender_.SubscribeAudioRtpStatsCallback(callback);
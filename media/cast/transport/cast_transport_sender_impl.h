@@ -58,6 +58,8 @@ class CastTransportSenderImpl : public CastTransportSender {
                              const MissingFramesAndPacketsMap& missing_packets)
       OVERRIDE;
 
+  virtual void SetVideoBitrate(int bits_per_second) OVERRIDE;
+
   virtual void SubscribeAudioRtpStatsCallback(
       const CastTransportRtpStatistics& callback) OVERRIDE;
 
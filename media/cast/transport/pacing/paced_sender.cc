@@ -16,6 +16,9 @@ static const int64 kPacingIntervalMs = 10;
 // Each frame will be split into no more than kPacingMaxBurstsPerFrame
 // bursts of packets.
 static const size_t kPacingMaxBurstsPerFrame = 3;
+// When a target bitrate is set, bursts are limited to this multiple of the
+// target rate over one pacing interval.
+static const int kPacingBitrateHeadroom = 3;
 
 }  // namespace
 
@@ -27,6 +30,7 @@ PacedSender::PacedSender(
       transport_(transport),
       transport_task_runner_(transport_task_runner),
       burst_size_(1),
+      max_burst_size_(0),
       packets_sent_in_burst_(0),
       weak_factory_(this) {
   ScheduleNextSend();
@@ -42,6 +46,22 @@ bool PacedSender::ResendPackets(const PacketList& packets) {
   return SendPacketsToTransport(packets, &resend_packet_list_);
 }
 
+void PacedSender::SetTargetBitrate(int bits_per_second) {
+  DCHECK_GE(bits_per_second, 0);
+  if (bits_per_second == 0) {
+    max_burst_size_ = 0;
+    return;
+  }
+  const int64 bits_per_burst = static_cast<int64>(bits_per_second) *
+                               kPacingBitrateHeadroom * kPacingIntervalMs /
+                               base::Time::kMillisecondsPerSecond;
+  const int64 bits_per_packet = kMaxIpPacketSize * 8;
+  max_burst_size_ = std::max<size_t>(
+      1, static_cast<size_t>((bits_per_burst + bits_per_packet - 1) /
+                             bits_per_packet));
+  burst_size_ = std::min(burst_size_, max_burst_size_);
+}
+
 bool PacedSender::SendPacketsToTransport(const PacketList& packets,
                                          PacketList* packets_not_sent) {
   UpdateBurstSize(packets.size());
@@ -55,7 +75,10 @@ bool PacedSender::SendPacketsToTransport(const PacketList& packets,
   PacketList packets_to_send;
   PacketList::const_iterator first_to_store_it = packets.begin();
 
-  size_t max_packets_to_send_now = burst_size_ - packets_sent_in_burst_;
+  // |burst_size_| may have been lowered by SetTargetBitrate() in the middle of
+  // a burst.
+  size_t max_packets_to_send_now = burst_size_ > packets_sent_in_burst_ ?
+      burst_size_ - packets_sent_in_burst_ : 0;
 
   if (max_packets_to_send_now > 0) {
     size_t packets_to_send_now =
@@ -149,6 +172,8 @@ void PacedSender::UpdateBurstSize(size_t packets_to_send) {
   packets_to_send += (kPacingMaxBurstsPerFrame - 1);  // Round up.
   burst_size_ =
       std::max(packets_to_send / kPacingMaxBurstsPerFrame, burst_size_);
+  if (max_burst_size_ > 0)
+    burst_size_ = std::min(burst_size_, max_burst_size_);
 }
 
 }  // namespace transport
@@ -56,6 +56,12 @@ class PacedSender : public PacedPacketSender,
 
   virtual bool SendRtcpPacket(const Packet& packet) OVERRIDE;
 
+  // Limits each burst to the number of packets that can be sent at a small
+  // multiple of |bits_per_second| within one pacing interval, so that large
+  // key frames are spread out instead of overflowing network queues. A value
+  // of 0 removes the limit.
+  void SetTargetBitrate(int bits_per_second);
+
  protected:
   // Schedule a delayed task on the main cast thread when it's time to send the
   // next packet burst.
@@ -78,6 +84,7 @@ class PacedSender : public PacedPacketSender,
   PacketSender* transport_;  // Not owned by this class.
   scoped_refptr<base::TaskRunner> transport_task_runner_;
   size_t burst_size_;
+  size_t max_burst_size_;  // 0 when there is no target bitrate.
   size_t packets_sent_in_burst_;
   base::TimeTicks time_last_process_;
   // Note: We can't combine the |packet_list_| and the |resend_packet_list_|
@@ -117,6 +117,41 @@ TEST_F(PacedSenderTest, BasicPace) {
   task_runner_->RunTasks();
 }
 
+TEST_F(PacedSenderTest, PaceAtTargetBitrate) {
+  // 2 Mbps allows 5 full size packets in each 10 ms burst.
+  paced_sender_->SetTargetBitrate(2000000);
+
+  int num_of_packets = 30;
+  PacketList packets = CreatePacketList(kSize1, num_of_packets);
+
+  // Without a target bitrate the frame would go out in three bursts of 10.
+  mock_transport_.AddExpectedSize(kSize1, 5);
+  EXPECT_TRUE(paced_sender_->SendPackets(packets));
+
+  base::TimeDelta timeout = base::TimeDelta::FromMilliseconds(10);
+  for (int i = 0; i < 5; ++i) {
+    mock_transport_.AddExpectedSize(kSize1, 5);
+    testing_clock_.Advance(timeout);
+    task_runner_->RunTasks();
+  }
+
+  // Check that we don't get any more packets.
+  testing_clock_.Advance(timeout);
+  task_runner_->RunTasks();
+
+  // Removing the target bitrate restores per frame pacing.
+  paced_sender_->SetTargetBitrate(0);
+  mock_transport_.AddExpectedSize(kSize2, 10);
+  EXPECT_TRUE(paced_sender_->SendPackets(CreatePacketList(kSize2, 30)));
+  for (int i = 0; i < 2; ++i) {
+    mock_transport_.AddExpectedSize(kSize2, 10);
+    testing_clock_.Advance(timeout);
+    task_runner_->RunTasks();
+  }
+  testing_clock_.Advance(timeout);
+  task_runner_->RunTasks();
+}
+
 TEST_F(PacedSenderTest, PaceWithNack) {
   // Testing what happen when we get multiple NACK requests for a fully lost
   // frames just as we sent the first packets in a frame.
@@ -7,6 +7,7 @@
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/callback.h"
+#include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 #include "media/base/video_frame.h"
@@ -18,6 +19,9 @@ namespace cast {
 
 namespace {
 
+// One frame being encoded, plus one waiting on the video encoder thread.
+const int kMaxFramesInEncoder = 2;
+
 typedef base::Callback<void(Vp8Encoder*)> PassEncoderCallback;
 
 void InitializeVp8EncoderOnEncoderThread(
@@ -33,8 +37,11 @@ void EncodeVideoFrameOnEncoderThread(
     const scoped_refptr<media::VideoFrame>& video_frame,
     const base::TimeTicks& capture_time,
     const VideoEncoderImpl::CodecDynamicConfig& dynamic_config,
-    const VideoEncoderImpl::FrameEncodedCallback& frame_encoded_callback) {
+    const VideoEncoderImpl::FrameEncodedCallback& frame_encoded_callback,
+    const base::Closure& encode_done_callback) {
   DCHECK(environment->CurrentlyOn(CastEnvironment::VIDEO_ENCODER));
+  TRACE_EVENT1("cast_perf", "EncodeVideoFrameOnEncoderThread",
+               "rtp_timestamp", GetVideoRtpTimestamp(capture_time));
   if (dynamic_config.key_frame_requested) {
     vp8_encoder->GenerateKeyFrame();
   }
@@ -50,17 +57,18 @@ void EncodeVideoFrameOnEncoderThread(
 
   if (!retval) {
     VLOG(1) << "Encoding failed";
-    return;
-  }
-  if (encoded_frame->data.size() <= 0) {
+  } else if (encoded_frame->data.size() <= 0) {
     VLOG(1) << "Encoding resulted in an empty frame";
-    return;
+  } else {
+    environment->PostTask(
+        CastEnvironment::MAIN,
+        FROM_HERE,
+        base::Bind(frame_encoded_callback,
+                   base::Passed(&encoded_frame),
+                   capture_time));
   }
-  environment->PostTask(
-      CastEnvironment::MAIN,
-      FROM_HERE,
-      base::Bind(
-          frame_encoded_callback, base::Passed(&encoded_frame), capture_time));
+  environment->PostTask(CastEnvironment::MAIN, FROM_HERE,
+                        encode_done_callback);
 }
 }  // namespace
 
@@ -71,7 +79,9 @@ VideoEncoderImpl::VideoEncoderImpl(
     : video_config_(video_config),
       cast_environment_(cast_environment),
       skip_next_frame_(false),
-      skip_count_(0) {
+      skip_count_(0),
+      frames_in_encoder_(0),
+      weak_factory_(this) {
   if (video_config.codec == transport::kVp8) {
     vp8_encoder_.reset(new Vp8Encoder(video_config, max_unacked_frames));
     cast_environment_->PostTask(CastEnvironment::VIDEO_ENCODER,
@@ -113,6 +123,12 @@ bool VideoEncoderImpl::EncodeVideoFrame(
     return false;
   }
 
+  if (frames_in_encoder_ >= kMaxFramesInEncoder) {
+    ++skip_count_;
+    VLOG(1) << "Dropping frame, the encoder is falling behind";
+    return false;
+  }
+
   base::TimeTicks now = cast_environment_->Clock()->NowTicks();
   cast_environment_->Logging()->InsertFrameEvent(
       now,
@@ -127,12 +143,22 @@ bool VideoEncoderImpl::EncodeVideoFrame(
                                          video_frame,
                                          capture_time,
                                          dynamic_config_,
-                                         frame_encoded_callback));
+                                         frame_encoded_callback,
+                                         base::Bind(
+                                             &VideoEncoderImpl::OnEncodeDone,
+                                             weak_factory_.GetWeakPtr())));
 
+  ++frames_in_encoder_;
   dynamic_config_.key_frame_requested = false;
   return true;
 }
 
+void VideoEncoderImpl::OnEncodeDone() {
+  DCHECK(cast_environment_->CurrentlyOn(CastEnvironment::MAIN));
+  DCHECK_GT(frames_in_encoder_, 0);
+  --frames_in_encoder_;
+}
+
 // Inform the encoder about the new target bit rate.
 void VideoEncoderImpl::SetBitRate(int new_bit_rate) {
   dynamic_config_.bit_rate = new_bit_rate;
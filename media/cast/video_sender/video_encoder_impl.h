@@ -6,6 +6,7 @@
 #define MEDIA_CAST_VIDEO_SENDER_VIDEO_ENCODER_IMPL_H_
 
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "media/cast/cast_config.h"
 #include "media/cast/cast_environment.h"
 #include "media/cast/video_sender/codecs/vp8/vp8_encoder.h"
@@ -55,18 +56,30 @@ class VideoEncoderImpl : public VideoEncoder {
   virtual int NumberOfSkippedFrames() const OVERRIDE;
 
  private:
+  // Called on the main cast thread once the video encoder thread is done with
+  // a frame, whether or not it produced any output.
+  void OnEncodeDone();
+
   const VideoSenderConfig video_config_;
   scoped_refptr<CastEnvironment> cast_environment_;
   CodecDynamicConfig dynamic_config_;
   bool skip_next_frame_;
   int skip_count_;
 
+  // Number of frames posted to the video encoder thread that it has not
+  // finished with yet. New frames are dropped while the encoder is this far
+  // behind, rather than queuing up and adding latency.
+  int frames_in_encoder_;
+
   // This member belongs to the video encoder thread. It must not be
   // dereferenced on the main thread. We manage the lifetime of this member
   // manually because it needs to be initialize, used and destroyed on the
   // video encoder thread and video encoder thread can out-live the main thread.
   scoped_ptr<Vp8Encoder> vp8_encoder_;
 
+  // NOTE: Weak pointers must be invalidated before all other member variables.
+  base::WeakPtrFactory<VideoEncoderImpl> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(VideoEncoderImpl);
 };
 
@@ -64,7 +64,8 @@ class TestVideoEncoderCallback
 class VideoEncoderImplTest : public ::testing::Test {
  protected:
   VideoEncoderImplTest()
-      : test_video_encoder_callback_(new TestVideoEncoderCallback()) {
+      : test_video_encoder_callback_(new TestVideoEncoderCallback()),
+        encoded_frame_count_(0) {
     video_config_.sender_ssrc = 1;
     video_config_.incoming_feedback_ssrc = 2;
     video_config_.rtp_config.payload_type = 127;
@@ -111,12 +112,18 @@ class VideoEncoderImplTest : public ::testing::Test {
         cast_environment_, video_config_, max_unacked_frames));
   }
 
+  void CountEncodedFrame(scoped_ptr<transport::EncodedVideoFrame> encoded_frame,
+                         const base::TimeTicks& capture_time) {
+    ++encoded_frame_count_;
+  }
+
   base::SimpleTestTickClock* testing_clock_;  // Owned by CastEnvironment.
   scoped_refptr<TestVideoEncoderCallback> test_video_encoder_callback_;
   VideoSenderConfig video_config_;
   scoped_refptr<test::FakeSingleThreadTaskRunner> task_runner_;
   scoped_ptr<VideoEncoder> video_encoder_;
   scoped_refptr<media::VideoFrame> video_frame_;
+  int encoded_frame_count_;
 
   scoped_refptr<CastEnvironment> cast_environment_;
 
@@ -162,6 +169,36 @@ TEST_F(VideoEncoderImplTest, EncodePattern30fpsRunningOutOfAck) {
   }
 }
 
+TEST_F(VideoEncoderImplTest, DropFramesWhenEncoderFallsBehind) {
+  Configure(3);
+
+  VideoEncoder::FrameEncodedCallback frame_encoded_callback =
+      base::Bind(&VideoEncoderImplTest::CountEncodedFrame,
+                 base::Unretained(this));
+
+  // Queue frames faster than the encoder thread gets to run. Only two frames
+  // may be outstanding at a time; the rest are dropped.
+  base::TimeTicks capture_time;
+  for (int i = 0; i < 4; ++i) {
+    capture_time += base::TimeDelta::FromMilliseconds(33);
+    EXPECT_EQ(i < 2,
+              video_encoder_->EncodeVideoFrame(
+                  video_frame_, capture_time, frame_encoded_callback));
+  }
+  EXPECT_EQ(2, video_encoder_->NumberOfSkippedFrames());
+
+  task_runner_->RunTasks();
+  EXPECT_EQ(2, encoded_frame_count_);
+
+  // Once the encoder has caught up new frames are accepted again.
+  capture_time += base::TimeDelta::FromMilliseconds(33);
+  EXPECT_TRUE(video_encoder_->EncodeVideoFrame(
+      video_frame_, capture_time, frame_encoded_callback));
+  task_runner_->RunTasks();
+  EXPECT_EQ(3, encoded_frame_count_);
+  EXPECT_EQ(2, video_encoder_->NumberOfSkippedFrames());
+}
+
 // TODO(pwestin): Re-enabled after redesign the encoder to control number of
 // frames in flight.
 TEST_F(VideoEncoderImplTest, DISABLED_EncodePattern60fpsRunningOutOfAck) {
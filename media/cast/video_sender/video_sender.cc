@@ -396,7 +396,7 @@ void VideoSender::OnReceivedCastFeedback(const RtcpCastMessage& cast_feedback) {
         cast_feedback.ack_frame_id_) {
       uint32 new_bitrate = 0;
       if (congestion_control_.OnAck(rtt, &new_bitrate)) {
-        video_encoder_->SetBitRate(new_bitrate);
+        UpdateBitrate(new_bitrate);
       }
     }
     // We only count duplicate ACKs when we have sent newer frames.
@@ -427,7 +427,7 @@ void VideoSender::OnReceivedCastFeedback(const RtcpCastMessage& cast_feedback) {
 
     uint32 new_bitrate = 0;
     if (congestion_control_.OnNack(rtt, &new_bitrate)) {
-      video_encoder_->SetBitRate(new_bitrate);
+      UpdateBitrate(new_bitrate);
     }
   }
   ReceivedAck(cast_feedback.ack_frame_id_);
@@ -479,6 +479,17 @@ void VideoSender::ResendFrame(uint32 resend_frame_id) {
                  missing_frames_and_packets));
 }
 
+void VideoSender::UpdateBitrate(uint32 new_bitrate) {
+  DCHECK(cast_environment_->CurrentlyOn(CastEnvironment::MAIN));
+  video_encoder_->SetBitRate(new_bitrate);
+  cast_environment_->PostTask(
+      CastEnvironment::TRANSPORT,
+      FROM_HERE,
+      base::Bind(&transport::CastTransportSender::SetVideoBitrate,
+                 base::Unretained(transport_sender_),
+                 static_cast<int>(new_bitrate)));
+}
+
 void VideoSender::ResendPacketsOnTransportThread(
     const transport::MissingFramesAndPacketsMap& missing_packets) {
   DCHECK(cast_environment_->CurrentlyOn(CastEnvironment::TRANSPORT));
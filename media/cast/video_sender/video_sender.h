@@ -106,6 +106,10 @@ class VideoSender : public base::NonThreadSafe,
   void ResendPacketsOnTransportThread(
       const transport::MissingFramesAndPacketsMap& missing_packets);
 
+  // Passes a new bitrate from |congestion_control_| to the encoder, and to
+  // the transport so it can pace packets to match.
+  void UpdateBitrate(uint32 new_bitrate);
+
   const base::TimeDelta rtp_max_delay_;
   const int max_frame_rate_;
 
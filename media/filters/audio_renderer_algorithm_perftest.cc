@@ -0,0 +1,73 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "media/base/audio_buffer.h"
+#include "media/base/audio_bus.h"
+#include "media/base/buffers.h"
+#include "media/base/channel_layout.h"
+#include "media/base/test_helpers.h"
+#include "media/filters/audio_renderer_algorithm.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kBenchmarkIterations = 2000;
+static const int kSampleRate = 48000;
+static const int kFramesPerBuffer = 480;
+static const int kInputFrames = 1024;
+
+// Measures how quickly AudioRendererAlgorithm produces 10ms output buffers of
+// 48kHz stereo audio at various playback rates.  A rate of 1 is a straight
+// copy; every other rate runs the WSOLA similarity search.
+static void RunFillBufferBenchmark(float playback_rate) {
+  AudioParameters params(AudioParameters::AUDIO_PCM_LINEAR,
+                         CHANNEL_LAYOUT_STEREO,
+                         kSampleRate,
+                         16,
+                         kFramesPerBuffer);
+  AudioRendererAlgorithm algorithm;
+  algorithm.Initialize(playback_rate, params);
+
+  // Use a ramp rather than silence so the algorithm doesn't take its muted
+  // shortcut.
+  scoped_refptr<AudioBuffer> input =
+      MakeInterleavedAudioBuffer<int16>(kSampleFormatS16,
+                                        params.channels(),
+                                        1,
+                                        1,
+                                        kInputFrames,
+                                        kNoTimestamp(),
+                                        kNoTimestamp());
+  scoped_ptr<AudioBus> output =
+      AudioBus::Create(params.channels(), kFramesPerBuffer);
+
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = 0; i < kBenchmarkIterations; ++i) {
+    while (!algorithm.IsQueueFull())
+      algorithm.EnqueueBuffer(input);
+    algorithm.FillBuffer(output.get(), kFramesPerBuffer);
+  }
+  double total_time_milliseconds =
+      (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+  perf_test::PrintResult("audio_renderer_algorithm",
+                         "",
+                         base::StringPrintf("playback_rate_%.2fx",
+                                            playback_rate),
+                         kBenchmarkIterations / total_time_milliseconds,
+                         "runs/ms",
+                         true);
+}
+
+TEST(AudioRendererAlgorithmPerfTest, FillBuffer) {
+  static const float kPlaybackRates[] = { 0.5f, 0.75f, 1.0f, 1.25f, 1.5f,
+                                          2.0f, 3.0f, 4.0f };
+  for (size_t i = 0; i < arraysize(kPlaybackRates); ++i)
+    RunFillBufferBenchmark(kPlaybackRates[i]);
+}
+
+}  // namespace media
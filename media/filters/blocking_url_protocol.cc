@@ -4,21 +4,75 @@
 
 #include "media/filters/blocking_url_protocol.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "base/bind.h"
+#include "base/metrics/histogram.h"
+#include "base/time/time.h"
 #include "media/base/data_source.h"
 #include "media/ffmpeg/ffmpeg_common.h"
 
 namespace media {
 
+// A single DataSource::Read() and the bytes it produced.
+class BlockingUrlProtocol::ReadChunk
+    : public base::RefCountedThreadSafe<ReadChunk> {
+ public:
+  ReadChunk(int64 position, int size)
+      : position_(position),
+        data_(size),
+        bytes_read_(0),
+        read_complete_(false, false) {}
+
+  int64 position() const { return position_; }
+  uint8* data() { return data_.empty() ? NULL : &data_[0]; }
+  int bytes_read() const { return bytes_read_; }
+  base::WaitableEvent* read_complete() { return &read_complete_; }
+
+  bool Contains(int64 position) const {
+    return position >= position_ && position < position_ + bytes_read_;
+  }
+
+  // Whether the read can produce the byte at |position| once it completes.
+  bool MayContain(int64 position) const {
+    return position >= position_ &&
+           position < position_ + static_cast<int64>(data_.size());
+  }
+
+  // Issues the read for this chunk on |data_source|.
+  void Start(DataSource* data_source) {
+    data_source->Read(position_, static_cast<int>(data_.size()), data(),
+                      base::Bind(&ReadChunk::OnReadCompleted, this));
+  }
+
+  // Runs on whichever thread the DataSource completes reads on, possibly
+  // with the DataSource's own lock held, so it must not call back into it.
+  void OnReadCompleted(int size) {
+    bytes_read_ = size;
+    read_complete_.Signal();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<ReadChunk>;
+  ~ReadChunk() {}
+
+  const int64 position_;
+  std::vector<uint8> data_;
+  int bytes_read_;
+  base::WaitableEvent read_complete_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadChunk);
+};
+
 BlockingUrlProtocol::BlockingUrlProtocol(
     DataSource* data_source,
     const base::Closure& error_cb)
     : data_source_(data_source),
       error_cb_(error_cb),
       aborted_(true, false),  // We never want to reset |aborted_|.
-      read_complete_(false, false),
-      last_read_bytes_(0),
-      read_position_(0) {
+      read_position_(0),
+      read_ahead_size_(kDefaultReadAheadSize) {
 }
 
 BlockingUrlProtocol::~BlockingUrlProtocol() {}
@@ -35,29 +89,94 @@ int BlockingUrlProtocol::Read(int size, uint8* data) {
   // Even though FFmpeg defines AVERROR_EOF, it's not to be used with I/O
   // routines. Instead return 0 for any read at or past EOF.
   int64 file_size;
-  if (data_source_->GetSize(&file_size) && read_position_ >= file_size)
+  const bool has_size = data_source_->GetSize(&file_size);
+  if (has_size && read_position_ >= file_size)
     return 0;
 
-  // Blocking read from data source until either:
-  //   1) |last_read_bytes_| is set and |read_complete_| is signalled
-  //   2) |aborted_| is signalled
-  data_source_->Read(read_position_, size, data, base::Bind(
-      &BlockingUrlProtocol::SignalReadCompleted, base::Unretained(this)));
+  while (true) {
+    if (cached_chunk_ && cached_chunk_->Contains(read_position_)) {
+      const int offset = read_position_ - cached_chunk_->position();
+      const int bytes_copied =
+          std::min(size, cached_chunk_->bytes_read() - offset);
+      memcpy(data, cached_chunk_->data() + offset, bytes_copied);
+      read_position_ += bytes_copied;
+
+      // Fetch the next chunk while FFmpeg works on the end of this one.  Doing
+      // it any earlier would waste the read if FFmpeg seeks away in between.
+      const int64 next_position =
+          cached_chunk_->position() + cached_chunk_->bytes_read();
+      if (!pending_chunk_ && read_ahead_size_ > 0 &&
+          next_position - read_position_ <= read_ahead_size_ / 2 &&
+          (!has_size || next_position < file_size)) {
+        StartRead(next_position, read_ahead_size_);
+      }
+      return bytes_copied;
+    }
+
+    const int read_size = std::max(size, read_ahead_size_);
+    if (!pending_chunk_) {
+      StartRead(read_position_, read_size);
+    } else if (!pending_chunk_->MayContain(read_position_)) {
+      // The read in flight is of no use here.  A DataSource only takes one
+      // read at a time, so queue the one that is needed and have
+      // WaitForPendingRead() start it as soon as the stale one completes.
+      queued_chunk_ = new ReadChunk(read_position_, read_size);
+    }
+    if (!WaitForPendingRead())
+      return AVERROR(EIO);
+
+    // An empty read at the current position means end of stream.
+    if (cached_chunk_->position() == read_position_ &&
+        cached_chunk_->bytes_read() == 0) {
+      return 0;
+    }
+  }
+}
+
+void BlockingUrlProtocol::StartRead(int64 position, int size) {
+  DCHECK(!pending_chunk_);
+  pending_chunk_ = new ReadChunk(position, size);
+  pending_chunk_->Start(data_source_);
+}
 
-  base::WaitableEvent* events[] = { &aborted_, &read_complete_ };
-  size_t index = base::WaitableEvent::WaitMany(events, arraysize(events));
+bool BlockingUrlProtocol::WaitForPendingRead() {
+  DCHECK(pending_chunk_);
 
-  if (events[index] == &aborted_)
-    return AVERROR(EIO);
+  // Block until either:
+  //   1) |pending_chunk_| signals that its read has completed
+  //   2) |aborted_| is signalled
+  base::TimeTicks start = base::TimeTicks::Now();
+  while (true) {
+    base::WaitableEvent* events[] = {
+      &aborted_, pending_chunk_->read_complete()
+    };
+    size_t index = base::WaitableEvent::WaitMany(events, arraysize(events));
+    if (events[index] == &aborted_) {
+      queued_chunk_ = NULL;
+      return false;
+    }
+    if (!queued_chunk_)
+      break;
+
+    // Start the queued read from this thread rather than from the completion
+    // callback, which may run with the DataSource's lock held.
+    pending_chunk_.swap(queued_chunk_);
+    queued_chunk_ = NULL;
+    pending_chunk_->Start(data_source_);
+  }
+  UMA_HISTOGRAM_TIMES("Media.BlockingUrlProtocol.ReadStallTime",
+                      base::TimeTicks::Now() - start);
+
+  cached_chunk_.swap(pending_chunk_);
+  pending_chunk_ = NULL;
 
-  if (last_read_bytes_ == DataSource::kReadError) {
+  if (cached_chunk_->bytes_read() == DataSource::kReadError) {
+    cached_chunk_ = NULL;
     aborted_.Signal();
     error_cb_.Run();
-    return AVERROR(EIO);
+    return false;
   }
-
-  read_position_ += last_read_bytes_;
-  return last_read_bytes_;
+  return true;
 }
 
 bool BlockingUrlProtocol::GetPosition(int64* position_out) {
@@ -84,9 +203,4 @@ bool BlockingUrlProtocol::IsStreaming() {
   return data_source_->IsStreaming();
 }
 
-void BlockingUrlProtocol::SignalReadCompleted(int size) {
-  last_read_bytes_ = size;
-  read_complete_.Signal();
-}
-
 }  // namespace media
@@ -7,6 +7,7 @@
 
 #include "base/basictypes.h"
 #include "base/callback.h"
+#include "base/memory/ref_counted.h"
 #include "base/synchronization/waitable_event.h"
 #include "media/filters/ffmpeg_glue.h"
 
@@ -16,8 +17,16 @@ class DataSource;
 
 // An implementation of FFmpegURLProtocol that blocks until the underlying
 // asynchronous DataSource::Read() operation completes.
+//
+// Reads are issued in chunks of at least |read_ahead_size| bytes and the most
+// recent chunk is kept in memory, so small FFmpeg reads and seeks back into it
+// don't round trip to the DataSource.  Once FFmpeg nears the end of a chunk the
+// next one is read in the background.
 class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
  public:
+  // Default size of each read issued to the DataSource.
+  enum { kDefaultReadAheadSize = 64 * 1024 };
+
   // Implements FFmpegURLProtocol using the given |data_source|. |error_cb| is
   // fired any time DataSource::Read() returns an error.
   //
@@ -30,6 +39,12 @@ class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
   // returns all subsequent calls to Read() will immediately fail.
   void Abort();
 
+  // Sets the minimum number of bytes requested from the DataSource at a time.
+  // Zero disables read ahead: every Read() is passed straight through.
+  void set_read_ahead_size(int read_ahead_size) {
+    read_ahead_size_ = read_ahead_size;
+  }
+
   // FFmpegURLProtocol implementation.
   virtual int Read(int size, uint8* data) OVERRIDE;
   virtual bool GetPosition(int64* position_out) OVERRIDE;
@@ -38,23 +53,39 @@ class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
   virtual bool IsStreaming() OVERRIDE;
 
  private:
-  // Sets |last_read_bytes_| and signals the blocked thread that the read
-  // has completed.
-  void SignalReadCompleted(int size);
+  class ReadChunk;
+
+  // Issues an asynchronous DataSource::Read() of |size| bytes at |position|
+  // into |pending_chunk_|.  There is never more than one read outstanding.
+  void StartRead(int64 position, int size);
+
+  // Blocks until |pending_chunk_| completes or Abort() is called, then moves
+  // it into |cached_chunk_|.  If |queued_chunk_| is set, it is started once
+  // |pending_chunk_| completes and waited for in its place.  Returns false if
+  // aborted or the read failed.
+  bool WaitForPendingRead();
 
   DataSource* data_source_;
   base::Closure error_cb_;
 
-  // Used to unblock the thread during shutdown and when reads complete.
+  // Used to unblock the thread during shutdown.
   base::WaitableEvent aborted_;
-  base::WaitableEvent read_complete_;
-
-  // Cached number of bytes last read from the data source.
-  int last_read_bytes_;
 
   // Cached position within the data source.
   int64 read_position_;
 
+  int read_ahead_size_;
+
+  // The last completed read, if any, and the read in flight, if any.  These
+  // are reference counted so that a read which completes after Abort() never
+  // writes into freed memory.
+  scoped_refptr<ReadChunk> cached_chunk_;
+  scoped_refptr<ReadChunk> pending_chunk_;
+
+  // A read to issue once |pending_chunk_| completes, when the read in flight
+  // turned out not to cover the position FFmpeg wants.
+  scoped_refptr<ReadChunk> queued_chunk_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BlockingUrlProtocol);
 };
 
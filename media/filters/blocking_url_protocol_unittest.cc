@@ -14,6 +14,57 @@
 
 namespace media {
 
+// Passes reads through to another DataSource and counts them.
+class CountingDataSource : public DataSource {
+ public:
+  explicit CountingDataSource(DataSource* data_source)
+      : data_source_(data_source),
+        reads_(0),
+        in_read_cb_(false) {}
+  virtual ~CountingDataSource() {}
+
+  int reads() const { return reads_; }
+
+  // DataSource implementation.
+  virtual void Read(int64 position, int size, uint8* data,
+                    const DataSource::ReadCB& read_cb) OVERRIDE {
+    // Real DataSources complete reads with their own lock held, so a read
+    // issued from a read callback would deadlock.
+    EXPECT_FALSE(in_read_cb_) << "Read() issued from a read callback";
+    ++reads_;
+    data_source_->Read(position, size, data,
+                       base::Bind(&CountingDataSource::OnReadDone,
+                                  base::Unretained(this), read_cb));
+  }
+  virtual void Stop(const base::Closure& callback) OVERRIDE {
+    callback.Run();
+  }
+  virtual bool GetSize(int64* size_out) OVERRIDE {
+    return data_source_->GetSize(size_out);
+  }
+  virtual bool IsStreaming() OVERRIDE {
+    return data_source_->IsStreaming();
+  }
+  virtual void SetBitrate(int bitrate) OVERRIDE {}
+
+ private:
+  void OnReadDone(const DataSource::ReadCB& read_cb, int size) {
+    in_read_cb_ = true;
+    read_cb.Run(size);
+    in_read_cb_ = false;
+  }
+
+  DataSource* data_source_;
+  int reads_;
+  bool in_read_cb_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingDataSource);
+};
+
+static void SaveBytesRead(int* bytes_read_out, int bytes_read) {
+  *bytes_read_out = bytes_read;
+}
+
 class BlockingUrlProtocolTest : public testing::Test {
  public:
   BlockingUrlProtocolTest()
@@ -83,6 +134,92 @@ TEST_F(BlockingUrlProtocolTest, ReadError) {
   EXPECT_EQ(AVERROR(EIO), url_protocol_.Read(32, buffer));
 }
 
+TEST_F(BlockingUrlProtocolTest, SeekBackServedFromReadAhead) {
+  uint8 first_read[32];
+  EXPECT_TRUE(url_protocol_.SetPosition(0));
+  EXPECT_EQ(32, url_protocol_.Read(32, first_read));
+
+  // Seeking back within the chunk that was just read must not touch the data
+  // source again.
+  data_source_.force_read_errors_for_testing();
+  uint8 second_read[32];
+  EXPECT_TRUE(url_protocol_.SetPosition(0));
+  EXPECT_EQ(32, url_protocol_.Read(32, second_read));
+  EXPECT_EQ(0, memcmp(first_read, second_read, sizeof(first_read)));
+}
+
+TEST_F(BlockingUrlProtocolTest, ReadAheadNearEndOfChunk) {
+  CountingDataSource data_source(&data_source_);
+  BlockingUrlProtocol url_protocol(
+      &data_source,
+      base::Bind(&BlockingUrlProtocolTest::OnDataSourceError,
+                 base::Unretained(this)));
+
+  uint8 buffer[32];
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_EQ(1, data_source.reads());
+
+  // Far from the end of the chunk nothing else is read, since FFmpeg may seek
+  // away before it needs more.
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_EQ(1, data_source.reads());
+
+  // Near its end the next chunk is read ahead, and serves the reads after it.
+  EXPECT_TRUE(url_protocol.SetPosition(
+      BlockingUrlProtocol::kDefaultReadAheadSize - 32));
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_EQ(2, data_source.reads());
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_EQ(2, data_source.reads());
+}
+
+TEST_F(BlockingUrlProtocolTest, SeekAwayFromReadAhead) {
+  CountingDataSource data_source(&data_source_);
+  BlockingUrlProtocol url_protocol(
+      &data_source,
+      base::Bind(&BlockingUrlProtocolTest::OnDataSourceError,
+                 base::Unretained(this)));
+
+  // Read a chunk at 1000, then near its end so that the next one is read
+  // ahead.
+  const int kFirstChunk = 1000;
+  uint8 buffer[32];
+  EXPECT_TRUE(url_protocol.SetPosition(kFirstChunk));
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_TRUE(url_protocol.SetPosition(
+      kFirstChunk + BlockingUrlProtocol::kDefaultReadAheadSize - 32));
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_EQ(2, data_source.reads());
+
+  // Neither chunk covers a seek before them, so the bytes there are read anew
+  // rather than taken from the read ahead.
+  const int kSeekPosition = 500;
+  EXPECT_TRUE(url_protocol.SetPosition(kSeekPosition));
+  EXPECT_EQ(32, url_protocol.Read(32, buffer));
+  EXPECT_EQ(3, data_source.reads());
+
+  uint8 expected[32];
+  int bytes_read = 0;
+  data_source_.Read(kSeekPosition, sizeof(expected), expected,
+                    base::Bind(&SaveBytesRead, &bytes_read));
+  EXPECT_EQ(32, bytes_read);
+  EXPECT_EQ(0, memcmp(expected, buffer, sizeof(buffer)));
+}
+
+TEST_F(BlockingUrlProtocolTest, ReadAheadDisabled) {
+  url_protocol_.set_read_ahead_size(0);
+
+  uint8 buffer[32];
+  EXPECT_TRUE(url_protocol_.SetPosition(0));
+  EXPECT_EQ(32, url_protocol_.Read(32, buffer));
+
+  // Without read ahead only the bytes asked for are kept, so reading past them
+  // goes to the data source.
+  data_source_.force_read_errors_for_testing();
+  EXPECT_CALL(*this, OnDataSourceError());
+  EXPECT_EQ(AVERROR(EIO), url_protocol_.Read(32, buffer));
+}
+
 TEST_F(BlockingUrlProtocolTest, GetSetPosition) {
   int64 size;
   int64 position;
@@ -8,8 +8,11 @@
 #include <map>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "media/base/media_switches.h"
 
 namespace media {
 
@@ -327,6 +330,27 @@ static base::TimeDelta kSeekToStartFudgeRoom() {
 static int kDefaultAudioMemoryLimit = 12 * 1024 * 1024;
 static int kDefaultVideoMemoryLimit = 150 * 1024 * 1024;
 
+// Upper bound for the memory limits that can be set from the command line, so
+// that the byte counts used during garbage collection can't overflow.
+static const int kMaxMemoryLimitMB = 1024;
+
+// Returns the memory limit given in megabytes by |switch_name|, or
+// |default_limit| if the switch is absent or invalid.
+static int GetMemoryLimit(const char* switch_name, int default_limit) {
+  const CommandLine* cmd_line = CommandLine::ForCurrentProcess();
+  if (!cmd_line->HasSwitch(switch_name))
+    return default_limit;
+
+  int limit_mb = 0;
+  if (!base::StringToInt(cmd_line->GetSwitchValueASCII(switch_name),
+                         &limit_mb) ||
+      limit_mb <= 0 || limit_mb > kMaxMemoryLimitMB) {
+    LOG(WARNING) << "Ignoring invalid --" << switch_name;
+    return default_limit;
+  }
+  return limit_mb * 1024 * 1024;
+}
+
 namespace media {
 
 SourceBufferStream::SourceBufferStream(const AudioDecoderConfig& audio_config,
@@ -345,7 +369,8 @@ SourceBufferStream::SourceBufferStream(const AudioDecoderConfig& audio_config,
       last_appended_buffer_is_keyframe_(false),
       last_output_buffer_timestamp_(kNoTimestamp()),
       max_interbuffer_distance_(kNoTimestamp()),
-      memory_limit_(kDefaultAudioMemoryLimit),
+      memory_limit_(GetMemoryLimit(switches::kMSEAudioBufferSizeLimit,
+                                   kDefaultAudioMemoryLimit)),
       config_change_pending_(false),
       fade_out_preroll_index_(0) {
   DCHECK(audio_config.IsValidConfig());
@@ -368,7 +393,8 @@ SourceBufferStream::SourceBufferStream(const VideoDecoderConfig& video_config,
       last_appended_buffer_is_keyframe_(false),
       last_output_buffer_timestamp_(kNoTimestamp()),
       max_interbuffer_distance_(kNoTimestamp()),
-      memory_limit_(kDefaultVideoMemoryLimit),
+      memory_limit_(GetMemoryLimit(switches::kMSEVideoBufferSizeLimit,
+                                   kDefaultVideoMemoryLimit)),
       config_change_pending_(false),
       fade_out_preroll_index_(0) {
   DCHECK(video_config.IsValidConfig());
@@ -392,7 +418,8 @@ SourceBufferStream::SourceBufferStream(const TextTrackConfig& text_config,
       last_appended_buffer_is_keyframe_(false),
       last_output_buffer_timestamp_(kNoTimestamp()),
       max_interbuffer_distance_(kNoTimestamp()),
-      memory_limit_(kDefaultAudioMemoryLimit),
+      memory_limit_(GetMemoryLimit(switches::kMSEAudioBufferSizeLimit,
+                                   kDefaultAudioMemoryLimit)),
       config_change_pending_(false),
       fade_out_preroll_index_(0) {
 }
@@ -769,15 +796,16 @@ void SourceBufferStream::SetConfigIds(const BufferQueue& buffers) {
 
 void SourceBufferStream::GarbageCollectIfNeeded() {
   // Compute size of |ranges_|.
-  int ranges_size = 0;
-  for (RangeList::iterator itr = ranges_.begin(); itr != ranges_.end(); ++itr)
-    ranges_size += (*itr)->size_in_bytes();
+  int ranges_size = GetBufferedSize();
 
   // Return if we're under or at the memory limit.
   if (ranges_size <= memory_limit_)
     return;
 
   int bytes_to_free = ranges_size - memory_limit_;
+  TRACE_EVENT2("media", "SourceBufferStream::GarbageCollectIfNeeded",
+               "buffered bytes", ranges_size,
+               "memory limit", memory_limit_);
 
   // Begin deleting after the last appended buffer.
   int bytes_freed = FreeBuffersAfterLastAppended(bytes_to_free);
@@ -788,7 +816,22 @@ void SourceBufferStream::GarbageCollectIfNeeded() {
 
   // Begin deleting from the back.
   if (bytes_to_free - bytes_freed > 0)
-    FreeBuffers(bytes_to_free - bytes_freed, true);
+    bytes_freed += FreeBuffers(bytes_to_free - bytes_freed, true);
+
+  DVLOG(1) << __FUNCTION__ << " : freed " << bytes_freed << " of "
+           << bytes_to_free << " bytes, now buffering " << GetBufferedSize()
+           << " bytes in " << ranges_.size() << " ranges.";
+  TRACE_COUNTER_ID1("media", "SourceBufferStreamBufferedBytes", this,
+                    GetBufferedSize());
+}
+
+int SourceBufferStream::GetBufferedSize() const {
+  int ranges_size = 0;
+  for (RangeList::const_iterator itr = ranges_.begin(); itr != ranges_.end();
+       ++itr) {
+    ranges_size += (*itr)->size_in_bytes();
+  }
+  return ranges_size;
 }
 
 int SourceBufferStream::FreeBuffersAfterLastAppended(int total_bytes_to_free) {
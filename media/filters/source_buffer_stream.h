@@ -136,6 +136,9 @@ class MEDIA_EXPORT SourceBufferStream {
   // yet.
   base::TimeDelta GetMaxInterbufferDistance() const;
 
+  // Returns the number of bytes of buffer data currently held by this stream.
+  int GetBufferedSize() const;
+
   void set_memory_limit_for_testing(int memory_limit) {
     memory_limit_ = memory_limit;
   }
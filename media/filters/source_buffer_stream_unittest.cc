@@ -2281,6 +2281,21 @@ TEST_F(SourceBufferStreamTest, GarbageCollection_DeleteSeveralRanges) {
   CheckNoNextBuffer();
 }
 
+TEST_F(SourceBufferStreamTest, GarbageCollection_BufferedSize) {
+  NewSegmentAppend(0, 5);
+  NewSegmentAppend(10, 3);
+  NewSegmentAppend(20, 8);
+  CheckExpectedRanges("{ [0,4) [10,12) [20,27) }");
+
+  EXPECT_EQ(16 * kDataSize, stream_->GetBufferedSize());
+
+  // Garbage collection should bring the buffered size back under the limit.
+  Seek(20);
+  SetMemoryLimit(10);
+  AppendBuffers(28, 2);
+  EXPECT_LE(stream_->GetBufferedSize(), 10 * kDataSize);
+}
+
 TEST_F(SourceBufferStreamTest, GarbageCollection_DeleteAfterLastAppend) {
   // Set memory limit to 10 buffers.
   SetMemoryLimit(10);
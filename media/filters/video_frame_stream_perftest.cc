@@ -0,0 +1,161 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+#include "media/base/media_log.h"
+#include "media/base/mock_demuxer_host.h"
+#include "media/base/test_data_util.h"
+#include "media/base/test_helpers.h"
+#include "media/base/video_frame.h"
+#include "media/filters/ffmpeg_demuxer.h"
+#include "media/filters/ffmpeg_video_decoder.h"
+#include "media/filters/file_data_source.h"
+#include "media/filters/video_frame_stream.h"
+#include "media/filters/vpx_video_decoder.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+using ::testing::NiceMock;
+
+namespace media {
+
+static const int kBenchmarkIterations = 20;
+
+// Demuxes and decodes a whole file through VideoFrameStream as fast as frames
+// can be pulled, with no renderer, clock or paint callback in the way.  This
+// is the floor for offline work like thumbnailing; compare against the
+// clockless_video_playback results from pipeline_integration_perftest.cc to
+// see what the rest of the pipeline costs.
+class VideoFrameStreamPerfTest : public testing::Test {
+ public:
+  VideoFrameStreamPerfTest() : frame_count_(0) {}
+
+ protected:
+  // Decodes every frame in |filename| once and returns the number of frames
+  // produced.
+  int DecodeFile(const std::string& filename) {
+    FileDataSource data_source;
+    CHECK(data_source.Initialize(GetTestDataFilePath(filename)));
+
+    FFmpegDemuxer demuxer(message_loop_.message_loop_proxy(),
+                          &data_source,
+                          Demuxer::NeedKeyCB(),
+                          new MediaLog());
+    NiceMock<MockDemuxerHost> host;
+    {
+      WaitableMessageLoopEvent event;
+      demuxer.Initialize(&host, event.GetPipelineStatusCB(), false);
+      event.RunAndWaitForStatus(PIPELINE_OK);
+    }
+
+    ScopedVector<VideoDecoder> decoders;
+    decoders.push_back(new VpxVideoDecoder(message_loop_.message_loop_proxy()));
+    decoders.push_back(
+        new FFmpegVideoDecoder(message_loop_.message_loop_proxy()));
+    VideoFrameStream stream(message_loop_.message_loop_proxy(),
+                            decoders.Pass(),
+                            SetDecryptorReadyCB());
+    stream.Initialize(demuxer.GetStream(DemuxerStream::VIDEO),
+                      base::Bind(&VideoFrameStreamPerfTest::OnStatistics,
+                                 base::Unretained(this)),
+                      base::Bind(&VideoFrameStreamPerfTest::OnInitialized,
+                                 base::Unretained(this),
+                                 &stream));
+
+    frame_count_ = 0;
+    message_loop_.Run();
+
+    {
+      WaitableMessageLoopEvent event;
+      stream.Stop(event.GetClosure());
+      event.RunAndWait();
+    }
+    {
+      WaitableMessageLoopEvent event;
+      demuxer.Stop(event.GetClosure());
+      event.RunAndWait();
+    }
+    return frame_count_;
+  }
+
+  void OnStatistics(const PipelineStatistics& stats) {}
+
+  void OnInitialized(VideoFrameStream* stream, bool success, bool has_alpha) {
+    CHECK(success);
+    stream->Read(base::Bind(&VideoFrameStreamPerfTest::OnFrameRead,
+                            base::Unretained(this),
+                            stream));
+  }
+
+  // Keeps exactly one read outstanding, like VideoRendererImpl does, until the
+  // end of stream frame arrives.
+  void OnFrameRead(VideoFrameStream* stream,
+                   VideoFrameStream::Status status,
+                   const scoped_refptr<VideoFrame>& frame) {
+    CHECK_EQ(status, VideoFrameStream::OK);
+    if (frame->end_of_stream()) {
+      message_loop_.PostTask(FROM_HERE, base::MessageLoop::QuitClosure());
+      return;
+    }
+    ++frame_count_;
+    stream->Read(base::Bind(&VideoFrameStreamPerfTest::OnFrameRead,
+                            base::Unretained(this),
+                            stream));
+  }
+
+  void RunDecodeBenchmark(const std::string& filename,
+                          const std::string& name) {
+    int total_frames = 0;
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int i = 0; i < kBenchmarkIterations; ++i)
+      total_frames += DecodeFile(filename);
+    double total_time_seconds =
+        (base::TimeTicks::HighResNow() - start).InSecondsF();
+    CHECK_GT(total_frames, 0);
+
+    perf_test::PrintResult(name,
+                           "",
+                           filename,
+                           kBenchmarkIterations / total_time_seconds,
+                           "runs/s",
+                           true);
+    perf_test::PrintResult(name + "_frames",
+                           "",
+                           filename,
+                           total_frames / total_time_seconds,
+                           "frames/s",
+                           true);
+  }
+
+  base::MessageLoop message_loop_;
+  int frame_count_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(VideoFrameStreamPerfTest);
+};
+
+TEST_F(VideoFrameStreamPerfTest, VP8DecodeBenchmark) {
+  RunDecodeBenchmark("bear-640x360.webm", "video_frame_stream_decode_vp8");
+  RunDecodeBenchmark("bear-320x240.webm", "video_frame_stream_decode_vp8");
+}
+
+TEST_F(VideoFrameStreamPerfTest, VP9DecodeBenchmark) {
+  RunDecodeBenchmark("bear-vp9.webm", "video_frame_stream_decode_vp9");
+}
+
+TEST_F(VideoFrameStreamPerfTest, TheoraDecodeBenchmark) {
+  RunDecodeBenchmark("bear.ogv", "video_frame_stream_decode_theora");
+}
+
+#if defined(USE_PROPRIETARY_CODECS)
+TEST_F(VideoFrameStreamPerfTest, MP4DecodeBenchmark) {
+  RunDecodeBenchmark("bear-1280x720.mp4", "video_frame_stream_decode_mp4");
+}
+#endif
+
+}  // namespace media
@@ -6,15 +6,19 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/histogram.h"
 #include "base/single_thread_task_runner.h"
-#include "base/strings/string_number_conversions.h"
+#include "base/stl_util.h"
+#include "base/synchronization/lock.h"
 #include "base/sys_byteorder.h"
+#include "base/time/time.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/demuxer_stream.h"
@@ -30,41 +34,140 @@
 #define VPX_CODEC_DISABLE_COMPAT 1
 extern "C" {
 #include "third_party/libvpx/source/libvpx/vpx/vpx_decoder.h"
+#include "third_party/libvpx/source/libvpx/vpx/vpx_frame_buffer.h"
 #include "third_party/libvpx/source/libvpx/vpx/vp8dx.h"
 }
 
 namespace media {
 
-// Always try to use three threads for video decoding.  There is little reason
-// not to since current day CPUs tend to be multi-core and we measured
-// performance benefits on older machines such as P4s with hyperthreading.
-static const int kDecodeThreads = 2;
-static const int kMaxDecodeThreads = 16;
+// Pool of frame buffers libvpx decodes VP9 frames into.  A buffer is handed
+// out again only once both libvpx and every VideoFrame wrapping it have
+// released it, so decoded frames can be passed on without copying their
+// planes.  The pool outlives the decoder for as long as such frames exist.
+class VpxVideoDecoder::MemoryPool
+    : public base::RefCountedThreadSafe<VpxVideoDecoder::MemoryPool> {
+ public:
+  MemoryPool() {}
+
+  // Called by libvpx when it needs a frame buffer of at least |min_size|
+  // bytes.  |user_priv| is the pool.  Returns 0 on success.
+  static int32 GetVP9FrameBuffer(void* user_priv, size_t min_size,
+                                 vpx_codec_frame_buffer* fb);
+
+  // Called by libvpx when it no longer references |fb|.  Returns 0 on success.
+  static int32 ReleaseVP9FrameBuffer(void* user_priv,
+                                     vpx_codec_frame_buffer* fb);
+
+  // Returns a closure which keeps the pool and the frame buffer identified by
+  // |fb_priv_data| alive until it is run.  Used as the "no longer needed"
+  // callback of VideoFrames wrapping the buffer.
+  base::Closure CreateFrameCallback(void* fb_priv_data);
+
+ private:
+  friend class base::RefCountedThreadSafe<VpxVideoDecoder::MemoryPool>;
+  ~MemoryPool();
+
+  // Frame buffers are reference counted by hand since both libvpx and the
+  // VideoFrames may hold on to them.
+  struct VP9FrameBuffer {
+    VP9FrameBuffer() : ref_cnt(0) {}
+    std::vector<uint8> data;
+    uint32 ref_cnt;
+  };
+
+  // Returns an unused frame buffer of at least |min_size| bytes.
+  VP9FrameBuffer* GetFreeFrameBuffer(size_t min_size);
+
+  // Called when a VideoFrame wrapping |frame_buffer| is destroyed, which may
+  // happen on any thread.
+  void OnVideoFrameDestroyed(VP9FrameBuffer* frame_buffer);
+
+  // Guards |frame_buffers_| and their reference counts.
+  base::Lock lock_;
+  std::vector<VP9FrameBuffer*> frame_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryPool);
+};
+
+VpxVideoDecoder::MemoryPool::~MemoryPool() {
+  STLDeleteElements(&frame_buffers_);
+}
 
-// Returns the number of threads.
-static int GetThreadCount(const VideoDecoderConfig& config) {
-  // Refer to http://crbug.com/93932 for tsan suppressions on decoding.
-  int decode_threads = kDecodeThreads;
+VpxVideoDecoder::MemoryPool::VP9FrameBuffer*
+    VpxVideoDecoder::MemoryPool::GetFreeFrameBuffer(size_t min_size) {
+  lock_.AssertAcquired();
 
-  const CommandLine* cmd_line = CommandLine::ForCurrentProcess();
-  std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
-  if (threads.empty() || !base::StringToInt(threads, &decode_threads)) {
-    if (config.codec() == kCodecVP9) {
-      // For VP9 decode when using the default thread count, increase the number
-      // of decode threads to equal the maximum number of tiles possible for
-      // higher resolution streams.
-      if (config.coded_size().width() >= 2048)
-        decode_threads = 8;
-      else if (config.coded_size().width() >= 1024)
-        decode_threads = 4;
-    }
+  // Reuse an unused buffer if there is one, otherwise allocate a new one.
+  size_t i = 0;
+  for (; i < frame_buffers_.size(); ++i) {
+    if (frame_buffers_[i]->ref_cnt == 0)
+      break;
+  }
+  if (i == frame_buffers_.size())
+    frame_buffers_.push_back(new VP9FrameBuffer());
+
+  // Resize the buffer if it's too small.  Contents don't need preserving.
+  if (frame_buffers_[i]->data.size() < min_size)
+    frame_buffers_[i]->data.resize(min_size);
+  return frame_buffers_[i];
+}
+
+int32 VpxVideoDecoder::MemoryPool::GetVP9FrameBuffer(
+    void* user_priv, size_t min_size, vpx_codec_frame_buffer* fb) {
+  DCHECK(user_priv);
+  DCHECK(fb);
+
+  VpxVideoDecoder::MemoryPool* memory_pool =
+      static_cast<VpxVideoDecoder::MemoryPool*>(user_priv);
 
-    return decode_threads;
+  base::AutoLock auto_lock(memory_pool->lock_);
+  VP9FrameBuffer* fb_to_use = memory_pool->GetFreeFrameBuffer(min_size);
+  if (!fb_to_use)
+    return -1;
+
+  fb->data = &fb_to_use->data[0];
+  fb->size = fb_to_use->data.size();
+  ++fb_to_use->ref_cnt;
+
+  // Set the frame buffer's private data to point at the buffer so it can be
+  // found again from the decoded vpx_image.
+  fb->priv = static_cast<void*>(fb_to_use);
+  return 0;
+}
+
+int32 VpxVideoDecoder::MemoryPool::ReleaseVP9FrameBuffer(
+    void* user_priv, vpx_codec_frame_buffer* fb) {
+  DCHECK(user_priv);
+  DCHECK(fb);
+
+  // libvpx may release a buffer it never received a frame in.
+  if (!fb->priv)
+    return 0;
+
+  VpxVideoDecoder::MemoryPool* memory_pool =
+      static_cast<VpxVideoDecoder::MemoryPool*>(user_priv);
+  base::AutoLock auto_lock(memory_pool->lock_);
+  VP9FrameBuffer* frame_buffer = static_cast<VP9FrameBuffer*>(fb->priv);
+  DCHECK_GT(frame_buffer->ref_cnt, 0u);
+  --frame_buffer->ref_cnt;
+  return 0;
+}
+
+base::Closure VpxVideoDecoder::MemoryPool::CreateFrameCallback(
+    void* fb_priv_data) {
+  VP9FrameBuffer* frame_buffer = static_cast<VP9FrameBuffer*>(fb_priv_data);
+  {
+    base::AutoLock auto_lock(lock_);
+    ++frame_buffer->ref_cnt;
   }
+  return base::Bind(&MemoryPool::OnVideoFrameDestroyed, this, frame_buffer);
+}
 
-  decode_threads = std::max(decode_threads, 0);
-  decode_threads = std::min(decode_threads, kMaxDecodeThreads);
-  return decode_threads;
+void VpxVideoDecoder::MemoryPool::OnVideoFrameDestroyed(
+    VP9FrameBuffer* frame_buffer) {
+  base::AutoLock auto_lock(lock_);
+  DCHECK_GT(frame_buffer->ref_cnt, 0u);
+  --frame_buffer->ref_cnt;
 }
 
 VpxVideoDecoder::VpxVideoDecoder(
@@ -108,7 +211,7 @@ static vpx_codec_ctx* InitializeVpxContext(vpx_codec_ctx* context,
   vpx_codec_dec_cfg_t vpx_config = {0};
   vpx_config.w = config.coded_size().width();
   vpx_config.h = config.coded_size().height();
-  vpx_config.threads = GetThreadCount(config);
+  vpx_config.threads = VideoDecoder::GetThreadCount(config);
 
   vpx_codec_err_t status = vpx_codec_dec_init(context,
                                               config.codec() == kCodecVP9 ?
@@ -142,6 +245,22 @@ bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
   if (!vpx_codec_)
     return false;
 
+  // Decode VP9 frames straight into pooled buffers which the output frames
+  // then reference, avoiding a copy of every decoded frame.  VP8 doesn't
+  // support external frame buffers, and the alpha plane needs the frames to
+  // be combined anyway.
+  if (config.codec() == kCodecVP9 && config.format() != VideoFrame::YV12A) {
+    memory_pool_ = new MemoryPool();
+    if (vpx_codec_set_frame_buffer_functions(
+            vpx_codec_,
+            &MemoryPool::GetVP9FrameBuffer,
+            &MemoryPool::ReleaseVP9FrameBuffer,
+            memory_pool_.get())) {
+      LOG(ERROR) << "Failed to configure external buffers.";
+      return false;
+    }
+  }
+
   if (config.format() == VideoFrame::YV12A) {
     vpx_codec_alpha_ = InitializeVpxContext(vpx_codec_alpha_, config);
     if (!vpx_codec_alpha_)
@@ -162,6 +281,9 @@ void VpxVideoDecoder::CloseDecoder() {
     delete vpx_codec_alpha_;
     vpx_codec_alpha_ = NULL;
   }
+
+  // Frames still referencing the pool keep it alive until they're destroyed.
+  memory_pool_ = NULL;
 }
 
 void VpxVideoDecoder::Decode(const scoped_refptr<DecoderBuffer>& buffer,
@@ -260,11 +382,14 @@ bool VpxVideoDecoder::VpxDecode(const scoped_refptr<DecoderBuffer>& buffer,
   // Pass |buffer| to libvpx.
   int64 timestamp = buffer->timestamp().InMicroseconds();
   void* user_priv = reinterpret_cast<void*>(&timestamp);
+  base::TimeTicks decode_start = base::TimeTicks::Now();
   vpx_codec_err_t status = vpx_codec_decode(vpx_codec_,
                                             buffer->data(),
                                             buffer->data_size(),
                                             user_priv,
                                             0);
+  UMA_HISTOGRAM_TIMES("Media.VpxVideoDecoder.DecodeTime",
+                      base::TimeTicks::Now() - decode_start);
   if (status != VPX_CODEC_OK) {
     LOG(ERROR) << "vpx_codec_decode() failed, status=" << status;
     return false;
@@ -320,7 +445,10 @@ bool VpxVideoDecoder::VpxDecode(const scoped_refptr<DecoderBuffer>& buffer,
     }
   }
 
-  CopyVpxImageTo(vpx_image, vpx_image_alpha, video_frame);
+  if (memory_pool_ && vpx_image->fb_priv)
+    WrapVpxImage(vpx_image, video_frame);
+  else
+    CopyVpxImageTo(vpx_image, vpx_image_alpha, video_frame);
   (*video_frame)->SetTimestamp(base::TimeDelta::FromMicroseconds(timestamp));
   return true;
 }
@@ -333,6 +461,30 @@ void VpxVideoDecoder::DoReset() {
   reset_cb_.Reset();
 }
 
+void VpxVideoDecoder::WrapVpxImage(const vpx_image* vpx_image,
+                                   scoped_refptr<VideoFrame>* video_frame) {
+  CHECK(vpx_image);
+  CHECK(vpx_image->fmt == VPX_IMG_FMT_I420 ||
+        vpx_image->fmt == VPX_IMG_FMT_YV12);
+  DCHECK(memory_pool_);
+
+  gfx::Size size(vpx_image->d_w, vpx_image->d_h);
+
+  *video_frame = VideoFrame::WrapExternalYuvData(
+      VideoFrame::YV12,
+      size,
+      gfx::Rect(size),
+      config_.natural_size(),
+      vpx_image->stride[VPX_PLANE_Y],
+      vpx_image->stride[VPX_PLANE_U],
+      vpx_image->stride[VPX_PLANE_V],
+      vpx_image->planes[VPX_PLANE_Y],
+      vpx_image->planes[VPX_PLANE_U],
+      vpx_image->planes[VPX_PLANE_V],
+      kNoTimestamp(),
+      memory_pool_->CreateFrameCallback(vpx_image->fb_priv));
+}
+
 void VpxVideoDecoder::CopyVpxImageTo(const vpx_image* vpx_image,
                                      const struct vpx_image* vpx_image_alpha,
                                      scoped_refptr<VideoFrame>* video_frame) {
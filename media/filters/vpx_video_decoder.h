@@ -6,6 +6,7 @@
 #define MEDIA_FILTERS_VPX_VIDEO_DECODER_H_
 
 #include "base/callback.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "media/base/demuxer_stream.h"
 #include "media/base/video_decoder.h"
@@ -67,6 +68,11 @@ class MEDIA_EXPORT VpxVideoDecoder : public VideoDecoder {
                       const struct vpx_image* vpx_image_alpha,
                       scoped_refptr<VideoFrame>* video_frame);
 
+  // Wraps the planes of |vpx_image| in a VideoFrame without copying them.
+  // Only possible when |vpx_image| was decoded into |memory_pool_|.
+  void WrapVpxImage(const vpx_image* vpx_image,
+                    scoped_refptr<VideoFrame>* video_frame);
+
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   base::WeakPtrFactory<VpxVideoDecoder> weak_factory_;
   base::WeakPtr<VpxVideoDecoder> weak_this_;
@@ -81,6 +87,11 @@ class MEDIA_EXPORT VpxVideoDecoder : public VideoDecoder {
   vpx_codec_ctx* vpx_codec_;
   vpx_codec_ctx* vpx_codec_alpha_;
 
+  // Frame buffers VP9 frames are decoded into.  Decoded VP9 frames reference
+  // this pool instead of being copied into |frame_pool_|.
+  class MemoryPool;
+  scoped_refptr<MemoryPool> memory_pool_;
+
   VideoFramePool frame_pool_;
 
   DISALLOW_COPY_AND_ASSIGN(VpxVideoDecoder);
@@ -14,6 +14,7 @@
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "media/base/audio_bus.h"
+#include "media/base/vector_math.h"
 
 namespace media {
 
@@ -23,6 +24,11 @@ bool InInterval(int n, Interval q) {
   return n >= q.first && n <= q.second;
 }
 
+static bool IsAligned(const float* p) {
+  return (reinterpret_cast<uintptr_t>(p) &
+          (vector_math::kRequiredAlignment - 1)) == 0;
+}
+
 float MultiChannelSimilarityMeasure(const float* dot_prod_a_b,
                                     const float* energy_a,
                                     const float* energy_b,
@@ -48,12 +54,21 @@ void MultiChannelDotProduct(const AudioBus* a,
   DCHECK_LE(frame_offset_a + num_frames, a->frames());
   DCHECK_LE(frame_offset_b + num_frames, b->frames());
 
-  memset(dot_product, 0, sizeof(*dot_product) * a->channels());
   for (int k = 0; k < a->channels(); ++k) {
     const float* ch_a = a->channel(k) + frame_offset_a;
     const float* ch_b = b->channel(k) + frame_offset_b;
-    for (int n = 0; n < num_frames; ++n) {
-      dot_product[k] += *ch_a++ * *ch_b++;
+
+    // vector_math::DotProduct() needs its first argument to be aligned.  The
+    // target block is normally read from offset zero, so that's the usual
+    // case; otherwise try the other order before falling back to scalar math.
+    if (IsAligned(ch_a)) {
+      dot_product[k] = vector_math::DotProduct(ch_a, ch_b, num_frames);
+    } else if (IsAligned(ch_b)) {
+      dot_product[k] = vector_math::DotProduct(ch_b, ch_a, num_frames);
+    } else {
+      dot_product[k] = 0;
+      for (int n = 0; n < num_frames; ++n)
+        dot_product[k] += *ch_a++ * *ch_b++;
     }
   }
 }
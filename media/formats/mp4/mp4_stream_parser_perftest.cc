@@ -0,0 +1,129 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "media/base/audio_decoder_config.h"
+#include "media/base/decoder_buffer.h"
+#include "media/base/stream_parser_buffer.h"
+#include "media/base/test_data_util.h"
+#include "media/base/text_track_config.h"
+#include "media/base/video_decoder_config.h"
+#include "media/formats/mp4/es_descriptor.h"
+#include "media/formats/mp4/mp4_stream_parser.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+namespace mp4 {
+
+static const int kBenchmarkIterations = 100;
+
+// Appends fragmented MP4 files to an MP4StreamParser in fixed size pieces, the
+// way MSE clients append network chunks, and measures parse throughput.
+class MP4StreamParserPerfTest : public testing::Test {
+ public:
+  MP4StreamParserPerfTest() : buffer_count_(0) {}
+
+ protected:
+  void InitF(bool init_ok, base::TimeDelta duration) { CHECK(init_ok); }
+
+  bool NewConfigF(const AudioDecoderConfig& ac,
+                  const VideoDecoderConfig& vc,
+                  const StreamParser::TextTrackConfigMap& tc) {
+    return true;
+  }
+
+  bool NewBuffersF(const StreamParser::BufferQueue& audio_buffers,
+                   const StreamParser::BufferQueue& video_buffers,
+                   const StreamParser::TextBufferQueueMap& text_map) {
+    buffer_count_ += audio_buffers.size() + video_buffers.size();
+    return true;
+  }
+
+  void KeyNeededF(const std::string& type,
+                  const std::vector<uint8>& init_data) {}
+  void NewSegmentF() {}
+  void EndOfSegmentF() {}
+
+  // Creates a fresh parser and feeds it all of |data| in |piece_size| chunks.
+  void ParseInPieces(const uint8* data, size_t length, size_t piece_size) {
+    std::set<int> audio_object_types;
+    audio_object_types.insert(kISO_14496_3);
+    MP4StreamParser parser(audio_object_types, false);
+    parser.Init(
+        base::Bind(&MP4StreamParserPerfTest::InitF, base::Unretained(this)),
+        base::Bind(&MP4StreamParserPerfTest::NewConfigF,
+                   base::Unretained(this)),
+        base::Bind(&MP4StreamParserPerfTest::NewBuffersF,
+                   base::Unretained(this)),
+        true,
+        base::Bind(&MP4StreamParserPerfTest::KeyNeededF,
+                   base::Unretained(this)),
+        base::Bind(&MP4StreamParserPerfTest::NewSegmentF,
+                   base::Unretained(this)),
+        base::Bind(&MP4StreamParserPerfTest::EndOfSegmentF,
+                   base::Unretained(this)),
+        LogCB());
+
+    const uint8* start = data;
+    const uint8* end = data + length;
+    while (start < end) {
+      size_t append_size =
+          std::min(piece_size, static_cast<size_t>(end - start));
+      CHECK(parser.Parse(start, append_size));
+      start += append_size;
+    }
+  }
+
+  void RunParseBenchmark(const std::string& filename, size_t piece_size) {
+    scoped_refptr<DecoderBuffer> buffer = ReadTestDataFile(filename);
+
+    buffer_count_ = 0;
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int i = 0; i < kBenchmarkIterations; ++i)
+      ParseInPieces(buffer->data(), buffer->data_size(), piece_size);
+    double total_time_seconds =
+        (base::TimeTicks::HighResNow() - start).InSecondsF();
+    CHECK_GT(buffer_count_, 0u);
+
+    const std::string trace_name =
+        filename + "_" + base::Uint64ToString(piece_size) + "_byte_appends";
+    perf_test::PrintResult("mp4_parse_throughput",
+                           "",
+                           trace_name,
+                           kBenchmarkIterations * buffer->data_size() /
+                               (1024 * 1024 * total_time_seconds),
+                           "MB/s",
+                           true);
+    perf_test::PrintResult("mp4_parse_samples",
+                           "",
+                           trace_name,
+                           buffer_count_ / total_time_seconds,
+                           "samples/s",
+                           true);
+  }
+
+  size_t buffer_count_;
+};
+
+TEST_F(MP4StreamParserPerfTest, FragmentedAppends) {
+  // Small appends exercise the partial box and partial sample paths; large
+  // appends hand the parser whole fragments at once.
+  RunParseBenchmark("bear-1280x720-av_frag.mp4", 512);
+  RunParseBenchmark("bear-1280x720-av_frag.mp4", 16 * 1024);
+  RunParseBenchmark("bear-1280x720-av_frag.mp4", 1024 * 1024);
+  RunParseBenchmark("bear-mpeg2-aac-only_frag.mp4", 512);
+}
+
+}  // namespace mp4
+}  // namespace media
@@ -11,6 +11,11 @@
 namespace mojo {
 namespace internal {
 
+// Most messages fit in this much space, so we can usually read them with a
+// single |ReadMessageRaw()| instead of querying their size first.
+const uint32_t kInitialReadNumBytes = 256;
+const uint32_t kInitialReadNumHandles = 4;
+
 // ----------------------------------------------------------------------------
 
 Connector::Connector(ScopedMessagePipeHandle message_pipe,
@@ -101,22 +106,8 @@ void Connector::ReadMore() {
   for (;;) {
     MojoResult rv;
 
-    uint32_t num_bytes = 0, num_handles = 0;
-    rv = ReadMessageRaw(message_pipe_.get(),
-                        NULL,
-                        &num_bytes,
-                        NULL,
-                        &num_handles,
-                        MOJO_READ_MESSAGE_FLAG_NONE);
-    if (rv == MOJO_RESULT_SHOULD_WAIT) {
-      WaitToReadMore();
-      break;
-    }
-    if (rv != MOJO_RESULT_RESOURCE_EXHAUSTED) {
-      error_ = true;
-      break;
-    }
-
+    uint32_t num_bytes = kInitialReadNumBytes;
+    uint32_t num_handles = kInitialReadNumHandles;
     Message message;
     message.data = static_cast<MessageData*>(malloc(num_bytes));
     message.handles.resize(num_handles);
@@ -124,14 +115,34 @@ void Connector::ReadMore() {
     rv = ReadMessageRaw(message_pipe_.get(),
                         message.data,
                         &num_bytes,
-                        message.handles.empty() ? NULL :
-                            reinterpret_cast<MojoHandle*>(&message.handles[0]),
+                        reinterpret_cast<MojoHandle*>(&message.handles[0]),
                         &num_handles,
                         MOJO_READ_MESSAGE_FLAG_NONE);
+    if (rv == MOJO_RESULT_RESOURCE_EXHAUSTED) {
+      // The message is bigger than our guess; |num_bytes| and |num_handles|
+      // now hold its actual size, so try again with enough room.
+      free(message.data);
+      message.data = static_cast<MessageData*>(malloc(num_bytes));
+      message.handles.resize(num_handles);
+
+      rv = ReadMessageRaw(message_pipe_.get(),
+                          message.data,
+                          &num_bytes,
+                          message.handles.empty() ? NULL :
+                              reinterpret_cast<MojoHandle*>(
+                                  &message.handles[0]),
+                          &num_handles,
+                          MOJO_READ_MESSAGE_FLAG_NONE);
+    }
+    if (rv == MOJO_RESULT_SHOULD_WAIT) {
+      WaitToReadMore();
+      break;
+    }
     if (rv != MOJO_RESULT_OK) {
       error_ = true;
       break;
     }
+    message.handles.resize(num_handles);
 
     if (incoming_receiver_)
       incoming_receiver_->Accept(&message);
@@ -10,6 +10,9 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+
+#include <vector>
 
 #include "mojo/public/system/macros.h"
 #include "mojo/public/tests/test_support.h"
@@ -158,6 +161,48 @@ class CorePerftest : public testing::Test {
     assert(result == MOJO_RESULT_SHOULD_WAIT);
   }
 
+  static void DataPipe_WriteAndRead(void* closure) {
+    CorePerftest* self = static_cast<CorePerftest*>(closure);
+    MojoResult result MOJO_ALLOW_UNUSED;
+    uint32_t num_bytes = self->num_bytes_;
+    result = MojoWriteData(self->h0_,
+                           self->buffer_, &num_bytes,
+                           MOJO_WRITE_DATA_FLAG_ALL_OR_NONE);
+    assert(result == MOJO_RESULT_OK);
+    num_bytes = self->num_bytes_;
+    result = MojoReadData(self->h1_,
+                          self->buffer_, &num_bytes,
+                          MOJO_READ_DATA_FLAG_ALL_OR_NONE);
+    assert(result == MOJO_RESULT_OK);
+  }
+
+  // Like |DataPipe_WriteAndRead()|, but the producer copies straight into the
+  // pipe's buffer and the consumer reads the data in place, so there is one
+  // copy instead of two.
+  static void DataPipe_TwoPhaseWriteAndRead(void* closure) {
+    CorePerftest* self = static_cast<CorePerftest*>(closure);
+    MojoResult result MOJO_ALLOW_UNUSED;
+    void* write_ptr = NULL;
+    uint32_t num_bytes = 0;
+    result = MojoBeginWriteData(self->h0_, &write_ptr, &num_bytes,
+                                MOJO_WRITE_DATA_FLAG_NONE);
+    assert(result == MOJO_RESULT_OK);
+    // Near the end of the circular buffer we may be offered less than we want.
+    if (num_bytes > self->num_bytes_)
+      num_bytes = self->num_bytes_;
+    memcpy(write_ptr, self->buffer_, num_bytes);
+    result = MojoEndWriteData(self->h0_, num_bytes);
+    assert(result == MOJO_RESULT_OK);
+
+    const void* read_ptr = NULL;
+    num_bytes = 0;
+    result = MojoBeginReadData(self->h1_, &read_ptr, &num_bytes,
+                               MOJO_READ_DATA_FLAG_NONE);
+    assert(result == MOJO_RESULT_OK);
+    result = MojoEndReadData(self->h1_, num_bytes);
+    assert(result == MOJO_RESULT_OK);
+  }
+
  protected:
 #if !defined(WIN32)
   void DoMessagePipeThreadedTest(unsigned num_writers,
@@ -312,6 +357,34 @@ TEST_F(CorePerftest, MessagePipe_EmptyRead) {
   assert(result == MOJO_RESULT_OK);
 }
 
+TEST_F(CorePerftest, DataPipe_WriteAndRead) {
+  MojoResult result MOJO_ALLOW_UNUSED;
+  result = MojoCreateDataPipe(NULL, &h0_, &h1_);
+  assert(result == MOJO_RESULT_OK);
+  char buffer[10000] = { 0 };
+  buffer_ = buffer;
+  num_bytes_ = 100u;
+  mojo::test::IterateAndReportPerf("DataPipe_WriteAndRead_100bytes",
+                                   &CorePerftest::DataPipe_WriteAndRead,
+                                   this);
+  mojo::test::IterateAndReportPerf(
+      "DataPipe_TwoPhaseWriteAndRead_100bytes",
+      &CorePerftest::DataPipe_TwoPhaseWriteAndRead,
+      this);
+  num_bytes_ = 10000u;
+  mojo::test::IterateAndReportPerf("DataPipe_WriteAndRead_10000bytes",
+                                   &CorePerftest::DataPipe_WriteAndRead,
+                                   this);
+  mojo::test::IterateAndReportPerf(
+      "DataPipe_TwoPhaseWriteAndRead_10000bytes",
+      &CorePerftest::DataPipe_TwoPhaseWriteAndRead,
+      this);
+  result = MojoClose(h0_);
+  assert(result == MOJO_RESULT_OK);
+  result = MojoClose(h1_);
+  assert(result == MOJO_RESULT_OK);
+}
+
 #if !defined(WIN32)
 TEST_F(CorePerftest, MessagePipe_Threaded) {
   DoMessagePipeThreadedTest(1u, 1u, 100u);
@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -32,6 +33,9 @@ namespace {
 
 const size_t kReadSize = 4096;
 
+// The maximum number of queued messages to hand to a single |writev()|.
+const size_t kMaxWriteMessages = 16;
+
 class RawChannelPosix : public RawChannel,
                         public base::MessageLoopForIO::Watcher {
  public:
@@ -57,11 +61,12 @@ class RawChannelPosix : public RawChannel,
   // thread WITHOUT |write_lock_| held.
   void CallOnFatalError(Delegate::FatalError fatal_error);
 
-  // Writes the message at the front of |write_message_queue_|, starting at
-  // |write_message_offset_|. It removes and destroys if the write completes and
-  // otherwise updates |write_message_offset_|. Returns true on success. Must be
+  // Writes as many messages from the front of |write_message_queue_| as it can
+  // with a single |writev()|, starting at |write_message_offset_| in the front
+  // message. It removes and destroys the messages that were completely written
+  // and updates |write_message_offset_|. Returns true on success. Must be
   // called under |write_lock_|.
-  bool WriteFrontMessageNoLock();
+  bool WriteFrontMessagesNoLock();
 
   // Cancels all pending writes and destroys the contents of
   // |write_message_queue_|. Should only be called if |write_stopped_| is false;
@@ -176,7 +181,7 @@ bool RawChannelPosix::WriteMessage(MessageInTransit* message) {
 
   write_message_queue_.push_front(message);
   DCHECK_EQ(write_message_offset_, 0u);
-  bool result = WriteFrontMessageNoLock();
+  bool result = WriteFrontMessagesNoLock();
   DCHECK(result || write_message_queue_.empty());
 
   if (!result) {
@@ -321,7 +326,7 @@ void RawChannelPosix::OnFileCanWriteWithoutBlocking(int fd) {
       return;
     }
 
-    bool result = WriteFrontMessageNoLock();
+    bool result = WriteFrontMessagesNoLock();
     DCHECK(result || write_message_queue_.empty());
 
     if (!result) {
@@ -351,23 +356,35 @@ void RawChannelPosix::CallOnFatalError(Delegate::FatalError fatal_error) {
   delegate()->OnFatalError(fatal_error);
 }
 
-bool RawChannelPosix::WriteFrontMessageNoLock() {
+bool RawChannelPosix::WriteFrontMessagesNoLock() {
   write_lock_.AssertAcquired();
 
   DCHECK(!write_stopped_);
   DCHECK(!write_message_queue_.empty());
 
-  MessageInTransit* message = write_message_queue_.front();
-  DCHECK_LT(write_message_offset_, message->main_buffer_size());
-  size_t bytes_to_write = message->main_buffer_size() - write_message_offset_;
+  // Gather the queued messages, so that a burst of small messages doesn't cost
+  // a system call each.
+  struct iovec iov[kMaxWriteMessages];
+  size_t num_iov = 0;
+  size_t bytes_to_write = 0;
+  for (std::deque<MessageInTransit*>::const_iterator it =
+           write_message_queue_.begin();
+       it != write_message_queue_.end() && num_iov < kMaxWriteMessages;
+       ++it) {
+    size_t offset = (num_iov == 0) ? write_message_offset_ : 0;
+    DCHECK_LT(offset, (*it)->main_buffer_size());
+    iov[num_iov].iov_base = const_cast<char*>(
+        static_cast<const char*>((*it)->main_buffer()) + offset);
+    iov[num_iov].iov_len = (*it)->main_buffer_size() - offset;
+    bytes_to_write += iov[num_iov].iov_len;
+    num_iov++;
+  }
+
   ssize_t bytes_written = HANDLE_EINTR(
-      write(fd_.get().fd,
-            static_cast<const char*>(message->main_buffer()) +
-                write_message_offset_,
-            bytes_to_write));
+      writev(fd_.get().fd, iov, static_cast<int>(num_iov)));
   if (bytes_written < 0) {
     if (errno != EAGAIN && errno != EWOULDBLOCK) {
-      PLOG(ERROR) << "write of size " << bytes_to_write;
+      PLOG(ERROR) << "writev of size " << bytes_to_write;
       CancelPendingWritesNoLock();
       return false;
     }
@@ -378,12 +395,20 @@ bool RawChannelPosix::WriteFrontMessageNoLock() {
   }
 
   DCHECK_GE(bytes_written, 0);
-  if (static_cast<size_t>(bytes_written) < bytes_to_write) {
-    // Partial (or no) write.
-    write_message_offset_ += static_cast<size_t>(bytes_written);
-  } else {
-    // Complete write.
-    DCHECK_EQ(static_cast<size_t>(bytes_written), bytes_to_write);
+  DCHECK_LE(static_cast<size_t>(bytes_written), bytes_to_write);
+  size_t bytes_remaining = static_cast<size_t>(bytes_written);
+  while (bytes_remaining > 0) {
+    MessageInTransit* message = write_message_queue_.front();
+    size_t message_bytes_left =
+        message->main_buffer_size() - write_message_offset_;
+    if (bytes_remaining < message_bytes_left) {
+      // Partial write of this message.
+      write_message_offset_ += bytes_remaining;
+      break;
+    }
+
+    // Complete write of this message.
+    bytes_remaining -= message_bytes_left;
     write_message_queue_.pop_front();
     write_message_offset_ = 0;
     message->Destroy();
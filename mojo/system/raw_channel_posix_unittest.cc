@@ -224,6 +224,36 @@ TEST_F(RawChannelPosixTest, WriteMessage) {
                                    base::Unretained(rc.get())));
 }
 
+// Tests that many small messages queued behind a large one (so that they get
+// written together) arrive intact and in order.
+TEST_F(RawChannelPosixTest, WriteQueuedSmallMessages) {
+  WriteOnlyRawChannelDelegate delegate;
+  scoped_ptr<RawChannel> rc(RawChannel::Create(handles[0].Pass(),
+                                               &delegate,
+                                               io_thread_message_loop()));
+
+  TestMessageReaderAndChecker checker(handles[1].get());
+
+  test::PostTaskAndWait(io_thread_task_runner(),
+                        FROM_HERE,
+                        base::Bind(&InitOnIOThread, rc.get()));
+
+  // The large message won't fit in the socket buffer, so the rest are queued.
+  const uint32_t kLargeSize = 4 * 1000 * 1000;
+  EXPECT_TRUE(rc->WriteMessage(MakeTestMessage(kLargeSize)));
+  for (uint32_t size = 1; size <= 100; size++)
+    EXPECT_TRUE(rc->WriteMessage(MakeTestMessage(size)));
+
+  EXPECT_TRUE(checker.ReadAndCheckNextMessage(kLargeSize));
+  for (uint32_t size = 1; size <= 100; size++)
+    EXPECT_TRUE(checker.ReadAndCheckNextMessage(size)) << size;
+
+  test::PostTaskAndWait(io_thread_task_runner(),
+                        FROM_HERE,
+                        base::Bind(&RawChannel::Shutdown,
+                                   base::Unretained(rc.get())));
+}
+
 // RawChannelPosixTest.OnReadMessage -------------------------------------------
 
 class ReadCheckerRawChannelDelegate : public RawChannel::Delegate {
@@ -52,12 +52,26 @@ void NetLogLogger::OnAddEntry(const net::NetLog::Entry& entry) {
   // Add a comma and newline for every event but the first.  Newlines are needed
   // so can load partial log files by just ignoring the last line.  For this to
   // work, lines cannot be pretty printed.
-  scoped_ptr<base::Value> value(entry.ToValue());
-  std::string json;
-  base::JSONWriter::Write(value.get(), &json);
-  fprintf(file_.get(), "%s%s",
+  //
+  // The fixed fields are written directly rather than through
+  // Entry::ToValue(), so that only the event parameters are built as a
+  // Value.  Keys are in the same order base::JSONWriter would use.
+  std::string params_json;
+  scoped_ptr<base::Value> params(entry.ParametersToValue());
+  if (params) {
+    base::JSONWriter::Write(params.get(), &params_json);
+    params_json = "\"params\":" + params_json + ",";
+  }
+  fprintf(file_.get(),
+          "%s{%s\"phase\":%d,\"source\":{\"id\":%d,\"type\":%d},"
+          "\"time\":\"%s\",\"type\":%d}",
           (added_events_ ? ",\n" : ""),
-          json.c_str());
+          params_json.c_str(),
+          static_cast<int>(entry.phase()),
+          static_cast<int>(entry.source().id),
+          static_cast<int>(entry.source().type),
+          NetLog::TickCountToString(entry.time()).c_str(),
+          static_cast<int>(entry.type()));
   added_events_ = true;
 }
 
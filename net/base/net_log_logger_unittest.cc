@@ -4,6 +4,7 @@
 
 #include "net/base/net_log_logger.h"
 
+#include "base/callback.h"
 #include "base/file_util.h"
 #include "base/files/file_path.h"
 #include "base/files/scoped_temp_dir.h"
@@ -115,4 +116,41 @@ TEST_F(NetLogLoggerTest, GeneratesValidJSONWithMultipleEvents) {
   ASSERT_EQ(2u, events->GetSize());
 }
 
+TEST_F(NetLogLoggerTest, EventsMatchEntryToValue) {
+  const std::string kValue = "value";
+  NetLog::ParametersCallback callback =
+      NetLog::StringCallback("name", &kValue);
+  NetLog::Source source(NetLog::SOURCE_SPDY_SESSION, 1);
+  NetLog::Entry entry(NetLog::TYPE_PROXY_SERVICE,
+                      source,
+                      NetLog::PHASE_END,
+                      base::TimeTicks::Now(),
+                      &callback,
+                      NetLog::LOG_BASIC);
+  {
+    FILE* file = base::OpenFile(log_path_, "w");
+    ASSERT_TRUE(file);
+    scoped_ptr<base::Value> constants(NetLogLogger::GetConstants());
+    NetLogLogger logger(file, *constants);
+    logger.OnAddEntry(entry);
+  }
+
+  std::string input;
+  ASSERT_TRUE(base::ReadFileToString(log_path_, &input));
+
+  base::JSONReader reader;
+  scoped_ptr<base::Value> root(reader.ReadToValue(input));
+  ASSERT_TRUE(root) << reader.GetErrorMessage();
+
+  base::DictionaryValue* dict;
+  ASSERT_TRUE(root->GetAsDictionary(&dict));
+  base::ListValue* events;
+  ASSERT_TRUE(dict->GetList("events", &events));
+  ASSERT_EQ(1u, events->GetSize());
+  base::Value* event;
+  ASSERT_TRUE(events->Get(0, &event));
+  scoped_ptr<base::Value> expected(entry.ToValue());
+  EXPECT_TRUE(expected->Equals(event));
+}
+
 }  // namespace net
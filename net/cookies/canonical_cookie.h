@@ -123,6 +123,14 @@ class NET_EXPORT CanonicalCookie {
   bool IncludeForRequestURL(const GURL& url,
                             const CookieOptions& options) const;
 
+  // Same as IncludeForRequestURL(), for callers that match many cookies
+  // against one request and so extract the request URL's |host|, |path| and
+  // whether its scheme is secure only once.
+  bool IncludeForRequest(const std::string& host,
+                         const std::string& path,
+                         bool secure_scheme,
+                         const CookieOptions& options) const;
+
   std::string DebugString() const;
 
   // Returns the cookie source when cookies are set for |url|. This function
@@ -315,6 +315,9 @@ TEST(CanonicalCookieTest, IsOnPath) {
   EXPECT_TRUE(cookie->IsOnPath("/test"));
   EXPECT_TRUE(cookie->IsOnPath("/test/bar.html"));
   EXPECT_TRUE(cookie->IsOnPath("/test/sample/bar.html"));
+  EXPECT_FALSE(cookie->IsOnPath("/tes"));
+  EXPECT_FALSE(cookie->IsOnPath("/testing"));
+  EXPECT_FALSE(cookie->IsOnPath("/foo/test"));
 }
 
 TEST(CanonicalCookieTest, IncludeForRequestURL) {
@@ -1699,6 +1699,12 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
                                       std::vector<CanonicalCookie*>* cookies) {
   lock_.AssertAcquired();
 
+  // GURL hands out copies of its components, so extract them once rather than
+  // for every candidate cookie.
+  const std::string host(url.host());
+  const std::string path(url.path());
+  const bool secure_scheme = url.SchemeIsSecure();
+
   for (CookieMapItPair its = cookies_.equal_range(key);
        its.first != its.second; ) {
     CookieMap::iterator curit = its.first;
@@ -1714,7 +1720,7 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
     // Filter out cookies that should not be included for a request to the
     // given |url|. HTTP only cookies are filtered depending on the passed
     // cookie |options|.
-    if (!cc->IncludeForRequestURL(url, options))
+    if (!cc->IncludeForRequest(host, path, secure_scheme, options))
       continue;
 
     // Add this cookie to the set of matching cookies. Update the access
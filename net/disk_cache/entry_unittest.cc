@@ -64,6 +64,9 @@ class DiskCacheEntryTest : public DiskCacheTestWithCache {
   void DoomSparseEntry();
   void PartialSparseEntry();
   bool SimpleCacheMakeBadChecksumEntry(const std::string& key, int* data_size);
+  bool SimpleCacheOpenAndOverwriteStream1(const std::string& key,
+                                          int data_size,
+                                          disk_cache::Entry** entry);
   bool SimpleCacheThirdStreamFileExists(const char* key);
   void SyncDoomEntry(const char* key);
 };
@@ -2545,6 +2548,76 @@ TEST_F(DiskCacheEntryTest, SimpleCacheBadChecksum) {
             ReadData(entry, 1, 0, read_buffer.get(), kReadBufferSize));
 }
 
+// Creates an entry with |data_size| bytes of 'a' in stream 1, opens it again
+// and then overwrites the first byte of stream 1 with 'X' behind the cache's
+// back, so that reads tell whether they came from the file or from memory.
+bool DiskCacheEntryTest::SimpleCacheOpenAndOverwriteStream1(
+    const std::string& key,
+    int data_size,
+    disk_cache::Entry** entry) {
+  if (CreateEntry(key, entry) != net::OK || !*entry) {
+    LOG(ERROR) << "Could not create entry";
+    return false;
+  }
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(data_size));
+  memset(buffer->data(), 'a', data_size);
+  EXPECT_EQ(data_size, WriteData(*entry, 1, 0, buffer.get(), data_size, false));
+  (*entry)->Close();
+  *entry = NULL;
+
+  if (OpenEntry(key, entry) != net::OK || !*entry) {
+    LOG(ERROR) << "Could not open entry";
+    return false;
+  }
+
+  base::FilePath entry_file0_path = cache_path_.AppendASCII(
+      disk_cache::simple_util::GetFilenameFromKeyAndFileIndex(key, 0));
+  int flags = base::PLATFORM_FILE_WRITE | base::PLATFORM_FILE_OPEN;
+  base::PlatformFile entry_file0 =
+      base::CreatePlatformFile(entry_file0_path, flags, NULL, NULL);
+  if (entry_file0 == base::kInvalidPlatformFileValue)
+    return false;
+  int64 file_offset = sizeof(disk_cache::SimpleFileHeader) + key.size();
+  EXPECT_EQ(1, base::WritePlatformFile(entry_file0, file_offset, "X", 1));
+  return base::ClosePlatformFile(entry_file0);
+}
+
+// Tests that the first read of a small entry is served from what was read on
+// open, and that later reads go to the file again.
+TEST_F(DiskCacheEntryTest, SimpleCachePrefetchHit) {
+  SetSimpleCacheMode();
+  InitCache();
+
+  const char key[] = "the first key";
+  disk_cache::Entry* entry = NULL;
+  ASSERT_TRUE(SimpleCacheOpenAndOverwriteStream1(key, 1000, &entry));
+  ScopedEntryPtr entry_closer(entry);
+
+  // Short reads, so that no checksum is checked.
+  const int kReadSize = 10;
+  scoped_refptr<net::IOBuffer> read_buffer(new net::IOBuffer(kReadSize));
+  EXPECT_EQ(kReadSize, ReadData(entry, 1, 0, read_buffer.get(), kReadSize));
+  EXPECT_EQ('a', read_buffer->data()[0]);
+  EXPECT_EQ(kReadSize, ReadData(entry, 1, 0, read_buffer.get(), kReadSize));
+  EXPECT_EQ('X', read_buffer->data()[0]);
+}
+
+// Tests that entries too big to be read whole on open are read from the file.
+TEST_F(DiskCacheEntryTest, SimpleCachePrefetchMiss) {
+  SetSimpleCacheMode();
+  InitCache();
+
+  const char key[] = "the first key";
+  disk_cache::Entry* entry = NULL;
+  ASSERT_TRUE(SimpleCacheOpenAndOverwriteStream1(key, 64 * 1024, &entry));
+  ScopedEntryPtr entry_closer(entry);
+
+  const int kReadSize = 10;
+  scoped_refptr<net::IOBuffer> read_buffer(new net::IOBuffer(kReadSize));
+  EXPECT_EQ(kReadSize, ReadData(entry, 1, 0, read_buffer.get(), kReadSize));
+  EXPECT_EQ('X', read_buffer->data()[0]);
+}
+
 // Tests that an entry that has had an IO error occur can still be Doomed().
 TEST_F(DiskCacheEntryTest, SimpleCacheErrorThenDoom) {
   SetSimpleCacheMode();
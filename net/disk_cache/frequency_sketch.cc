@@ -0,0 +1,118 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/frequency_sketch.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace {
+
+const int kCounterBits = 4;
+const int kCountersPerWord = 64 / kCounterBits;
+const uint64 kCounterMask = 0xf;
+
+// Clears the top bit of every counter after a shift to the right.
+const uint64 kAgingMask = GG_UINT64_C(0x7777777777777777);
+
+// Each hash has this many counters, which all the hashes share.  There are as
+// many counters per expected entry, so that each counter is used by one
+// expected entry on average.
+const int kRows = 4;
+
+// Added to the hash to derive a different counter for every row.
+const uint64 kRowSeeds[kRows] = {
+  GG_UINT64_C(0x9e3779b97f4a7c15),
+  GG_UINT64_C(0xc2b2ae3d27d4eb4f),
+  GG_UINT64_C(0x165667b19e3779f9),
+  GG_UINT64_C(0xd6e8feb86659fd93),
+};
+
+// The counters are aged after this many uses per expected entry.
+const size_t kSampleSizeFactor = 10;
+
+const size_t kMinCounters = 64;
+
+}  // namespace
+
+namespace disk_cache {
+
+const int FrequencySketch::kMaxFrequency;
+
+FrequencySketch::FrequencySketch(size_t expected_entries)
+    : counter_mask_(0),
+      additions_(0),
+      sample_size_(0) {
+  Resize(expected_entries);
+}
+
+FrequencySketch::~FrequencySketch() {
+}
+
+void FrequencySketch::EnsureCapacity(size_t expected_entries) {
+  if (expected_entries * kRows > counter_mask_ + 1)
+    Resize(expected_entries);
+}
+
+void FrequencySketch::Increment(uint64 hash) {
+  bool incremented = false;
+  for (int row = 0; row < kRows; ++row) {
+    size_t index = CounterIndex(hash, row);
+    uint64& word = table_[index / kCountersPerWord];
+    int shift = (index % kCountersPerWord) * kCounterBits;
+    if (((word >> shift) & kCounterMask) != kCounterMask) {
+      word += GG_UINT64_C(1) << shift;
+      incremented = true;
+    }
+  }
+  if (incremented && ++additions_ >= sample_size_)
+    Age();
+}
+
+int FrequencySketch::Estimate(uint64 hash) const {
+  int frequency = kMaxFrequency;
+  for (int row = 0; row < kRows; ++row) {
+    size_t index = CounterIndex(hash, row);
+    uint64 word = table_[index / kCountersPerWord];
+    int shift = (index % kCountersPerWord) * kCounterBits;
+    frequency = std::min(frequency,
+                         static_cast<int>((word >> shift) & kCounterMask));
+  }
+  return frequency;
+}
+
+void FrequencySketch::Clear() {
+  std::fill(table_.begin(), table_.end(), 0);
+  additions_ = 0;
+}
+
+void FrequencySketch::Resize(size_t expected_entries) {
+  size_t counters = kMinCounters;
+  while (counters < expected_entries * kRows)
+    counters *= 2;
+  table_.assign(counters / kCountersPerWord, 0);
+  counter_mask_ = counters - 1;
+  additions_ = 0;
+  sample_size_ = counters / kRows * kSampleSizeFactor;
+}
+
+size_t FrequencySketch::CounterIndex(uint64 hash, int row) const {
+  // The finalizer of MurmurHash3, so that every bit of the hash counts.
+  uint64 mixed = hash + kRowSeeds[row];
+  mixed ^= mixed >> 33;
+  mixed *= GG_UINT64_C(0xff51afd7ed558ccd);
+  mixed ^= mixed >> 33;
+  mixed *= GG_UINT64_C(0xc4ceb9fe1a85ec53);
+  mixed ^= mixed >> 33;
+  return static_cast<size_t>(mixed) & counter_mask_;
+}
+
+void FrequencySketch::Age() {
+  for (size_t i = 0; i < table_.size(); ++i)
+    table_[i] = (table_[i] >> 1) & kAgingMask;
+  additions_ /= 2;
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,72 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_FREQUENCY_SKETCH_H_
+#define NET_DISK_CACHE_FREQUENCY_SKETCH_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+
+namespace disk_cache {
+
+// Estimates how often each entry hash has been used recently, in a fixed
+// amount of memory, as the frequency filter of TinyLFU does.  This is a
+// count-min sketch of 4-bit counters: an estimate can be too high because of
+// collisions, but never too low.  Once the sketch has seen ten uses per
+// expected entry, every counter is halved, so old popularity fades away.
+//
+// The hashes are expected to be uniformly distributed already, as the entry
+// hashes of the caches are.
+class NET_EXPORT_PRIVATE FrequencySketch {
+ public:
+  // The largest estimate that can be returned.
+  static const int kMaxFrequency = 15;
+
+  // Sizes the sketch to tell apart the frequencies of about |expected_entries|
+  // entries.
+  explicit FrequencySketch(size_t expected_entries);
+  ~FrequencySketch();
+
+  // Grows the sketch if it was sized for fewer than |expected_entries|.  All
+  // the counts are lost when it does.
+  void EnsureCapacity(size_t expected_entries);
+
+  // Records one use of |hash|.
+  void Increment(uint64 hash);
+
+  // Returns how many times |hash| has been used recently, up to
+  // kMaxFrequency.
+  int Estimate(uint64 hash) const;
+
+  void Clear();
+
+ private:
+  void Resize(size_t expected_entries);
+
+  // Returns the index of the counter of |hash| in row |row|.
+  size_t CounterIndex(uint64 hash, int row) const;
+
+  // Halves every counter.
+  void Age();
+
+  // Sixteen 4-bit counters per word.
+  std::vector<uint64> table_;
+
+  // Number of counters, minus one, to map hashes to counters.  The number of
+  // counters is a power of two.
+  size_t counter_mask_;
+
+  // Number of increments since the last aging of the counters, and the number
+  // at which they are aged.
+  size_t additions_;
+  size_t sample_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrequencySketch);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_FREQUENCY_SKETCH_H_
@@ -0,0 +1,79 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/frequency_sketch.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Spreads small integers over the whole range, like the entry hashes are.
+uint64 TestHash(uint64 i) {
+  return (i + 1) * GG_UINT64_C(0x9e3779b97f4a7c15);
+}
+
+}  // namespace
+
+TEST(FrequencySketchTest, Basics) {
+  disk_cache::FrequencySketch sketch(1000);
+  EXPECT_EQ(0, sketch.Estimate(TestHash(1)));
+
+  sketch.Increment(TestHash(1));
+  sketch.Increment(TestHash(1));
+  sketch.Increment(TestHash(2));
+  EXPECT_LE(2, sketch.Estimate(TestHash(1)));
+  EXPECT_LE(1, sketch.Estimate(TestHash(2)));
+
+  for (int i = 0; i < 100; ++i)
+    sketch.Increment(TestHash(3));
+  EXPECT_EQ(disk_cache::FrequencySketch::kMaxFrequency,
+            sketch.Estimate(TestHash(3)));
+
+  sketch.Clear();
+  EXPECT_EQ(0, sketch.Estimate(TestHash(1)));
+  EXPECT_EQ(0, sketch.Estimate(TestHash(3)));
+}
+
+TEST(FrequencySketchTest, FewCollisions) {
+  const int kEntries = 1024;
+  disk_cache::FrequencySketch sketch(kEntries);
+  for (int i = 0; i < kEntries; ++i)
+    sketch.Increment(TestHash(i));
+
+  // Each entry was used once, so most estimates are exact.
+  int exact = 0;
+  for (int i = 0; i < kEntries; ++i) {
+    int estimate = sketch.Estimate(TestHash(i));
+    EXPECT_LE(1, estimate);
+    if (estimate == 1)
+      exact++;
+  }
+  EXPECT_LT(kEntries * 3 / 4, exact);
+}
+
+TEST(FrequencySketchTest, Aging) {
+  const int kEntries = 1024;
+  disk_cache::FrequencySketch sketch(kEntries);
+  for (int i = 0; i < 20; ++i)
+    sketch.Increment(TestHash(0));
+  EXPECT_EQ(disk_cache::FrequencySketch::kMaxFrequency,
+            sketch.Estimate(TestHash(0)));
+
+  // Ten uses per counter halve the old counts.
+  for (int i = 1; i <= kEntries * 10; ++i)
+    sketch.Increment(TestHash(i));
+  EXPECT_GT(disk_cache::FrequencySketch::kMaxFrequency,
+            sketch.Estimate(TestHash(0)));
+}
+
+TEST(FrequencySketchTest, EnsureCapacity) {
+  disk_cache::FrequencySketch sketch(64);
+  sketch.Increment(TestHash(1));
+  sketch.EnsureCapacity(32);
+  EXPECT_LE(1, sketch.Estimate(TestHash(1)));
+
+  // Growing starts over.
+  sketch.EnsureCapacity(4096);
+  EXPECT_EQ(0, sketch.Estimate(TestHash(1)));
+}
@@ -16,12 +16,16 @@ namespace disk_cache {
 //     |kSimpleVersion - 1| then the whole cache directory will be cleared.
 //   * Dropping cache data on disk or some of its parts can be a valid way to
 //     Upgrade.
-const uint32 kSimpleVersion = 6;
+const uint32 kSimpleVersion = 7;
 
 // The version of the entry file(s) as written to disk. Must be updated iff the
 // entry format changes with the overall backend version update.
 const uint32 kSimpleEntryVersionOnDisk = 5;
 
+// The version of the sparse entry file as written to disk. Must be updated iff
+// the sparse file format changes with the overall backend version update.
+const uint32 kSimpleSparseEntryVersionOnDisk = 6;
+
 }  // namespace disk_cache
 
 #endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_BACKEND_VERSION_H_
@@ -16,13 +16,13 @@
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/field_trial.h"
-#include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/task_runner.h"
 #include "base/threading/worker_pool.h"
 #include "base/time/time.h"
 #include "net/base/net_errors.h"
+#include "net/disk_cache/frequency_sketch.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
@@ -48,6 +48,10 @@ const uint32 kEvictionMarginDivisor = 20;
 
 const uint32 kBytesInKb = 1024;
 
+// With frequency aware eviction, entries used at most this many times recently
+// are evicted before any other entry.
+const int kProbationaryFrequency = 1;
+
 // Utility class used for timestamp comparisons in entry metadata while sorting.
 class CompareHashesForTimestamp {
   typedef disk_cache::SimpleIndex SimpleIndex;
@@ -72,6 +76,21 @@ bool CompareHashesForTimestamp::operator()(uint64 hash1, uint64 hash2) {
   return it1->second.GetLastUsedTime() < it2->second.GetLastUsedTime();
 }
 
+// Utility class to put the entries that have been used rarely first, during
+// frequency aware eviction.
+class IsProbationaryHash {
+ public:
+  explicit IsProbationaryHash(const disk_cache::FrequencySketch& sketch)
+      : sketch_(sketch) {}
+
+  bool operator()(uint64 hash) const {
+    return sketch_.Estimate(hash) <= kProbationaryFrequency;
+  }
+
+ private:
+  const disk_cache::FrequencySketch& sketch_;
+};
+
 }  // namespace
 
 namespace disk_cache {
@@ -117,24 +136,6 @@ void EntryMetadata::SetLastUsedTime(const base::Time& last_used_time) {
     last_used_time_seconds_since_epoch_ = 1;
 }
 
-void EntryMetadata::Serialize(Pickle* pickle) const {
-  DCHECK(pickle);
-  int64 internal_last_used_time = GetLastUsedTime().ToInternalValue();
-  pickle->WriteInt64(internal_last_used_time);
-  pickle->WriteUInt64(entry_size_);
-}
-
-bool EntryMetadata::Deserialize(PickleIterator* it) {
-  DCHECK(it);
-  int64 tmp_last_used_time;
-  uint64 tmp_entry_size;
-  if (!it->ReadInt64(&tmp_last_used_time) || !it->ReadUInt64(&tmp_entry_size))
-    return false;
-  SetLastUsedTime(base::Time::FromInternalValue(tmp_last_used_time));
-  entry_size_ = tmp_entry_size;
-  return true;
-}
-
 SimpleIndex::SimpleIndex(base::SingleThreadTaskRunner* io_thread,
                          SimpleIndexDelegate* delegate,
                          net::CacheType cache_type,
@@ -185,6 +186,11 @@ void SimpleIndex::Initialize(base::Time cache_mtime) {
     }
   }
 
+  if (base::FieldTrialList::FindFullName("SimpleCacheEvictionPolicy") ==
+      "FrequencyAware") {
+    frequency_sketch_.reset(new FrequencySketch(entries_set_.size()));
+  }
+
 #if defined(OS_ANDROID)
   if (base::android::IsVMInitialized()) {
     activity_status_listener_.reset(new base::android::ActivityStatus::Listener(
@@ -264,6 +270,10 @@ void SimpleIndex::Insert(uint64 entry_hash) {
   // creating the new entry, and then UpdateEntrySize will be called.
   InsertInEntrySet(
       entry_hash, EntryMetadata(base::Time::Now(), 0), &entries_set_);
+  if (frequency_sketch_) {
+    frequency_sketch_->EnsureCapacity(entries_set_.size());
+    frequency_sketch_->Increment(entry_hash);
+  }
   if (!initialized_)
     removed_entries_.erase(entry_hash);
   PostponeWritingToDisk();
@@ -297,6 +307,8 @@ bool SimpleIndex::UseIfExists(uint64 entry_hash) {
     // If not initialized, always return true, forcing it to go to the disk.
     return !initialized_;
   it->second.SetLastUsedTime(base::Time::Now());
+  if (frequency_sketch_)
+    frequency_sketch_->Increment(entry_hash);
   PostponeWritingToDisk();
   return true;
 }
@@ -322,6 +334,12 @@ void SimpleIndex::StartEvictionIfNeeded() {
   }
   std::sort(entry_hashes.begin(), entry_hashes.end(),
             CompareHashesForTimestamp(entries_set_));
+  // A segmented LRU: the entries that have been used rarely go first, so that
+  // a burst of entries used once can't flush out the popular ones.
+  if (frequency_sketch_) {
+    std::stable_partition(entry_hashes.begin(), entry_hashes.end(),
+                          IsProbationaryHash(*frequency_sketch_));
+  }
 
   // Remove as many entries from the index to get below |low_watermark_|.
   std::vector<uint64>::iterator it = entry_hashes.begin();
@@ -437,6 +455,8 @@ void SimpleIndex::MergeInitializingSet(
   entries_set_.swap(*index_file_entries);
   cache_size_ = merged_cache_size;
   initialized_ = true;
+  if (frequency_sketch_)
+    frequency_sketch_->EnsureCapacity(entries_set_.size());
 
   // The actual IO is asynchronous, so calling WriteToDisk() shouldn't slow the
   // merge down much.
@@ -28,11 +28,9 @@
 #include "base/android/activity_status.h"
 #endif
 
-class Pickle;
-class PickleIterator;
-
 namespace disk_cache {
 
+class FrequencySketch;
 class SimpleIndexDelegate;
 class SimpleIndexFile;
 struct SimpleIndexLoadResult;
@@ -48,10 +46,6 @@ class NET_EXPORT_PRIVATE EntryMetadata {
   int GetEntrySize() const { return entry_size_; }
   void SetEntrySize(int entry_size) { entry_size_ = entry_size; }
 
-  // Serialize the data into the provided pickle.
-  void Serialize(Pickle* pickle) const;
-  bool Deserialize(PickleIterator* it);
-
   static base::TimeDelta GetLowerEpsilonForTimeComparisons() {
     return base::TimeDelta::FromSeconds(1);
   }
@@ -60,10 +54,11 @@ class NET_EXPORT_PRIVATE EntryMetadata {
   }
 
  private:
+  friend class SimpleIndexFile;
   friend class SimpleIndexFileTest;
 
-  // When adding new members here, you should update the Serialize() and
-  // Deserialize() methods.
+  // When adding new members here, you should update the entry records of
+  // SimpleIndexFile.
 
   uint32 last_used_time_seconds_since_epoch_;
 
@@ -167,6 +162,12 @@ class NET_EXPORT_PRIVATE SimpleIndex
   bool eviction_in_progress_;
   base::TimeTicks eviction_start_time_;
 
+  // How often the entries have been used recently, when the
+  // SimpleCacheEvictionPolicy field trial makes eviction frequency aware.
+  // The use counts aren't saved with the index, and are lost when the sketch
+  // grows.
+  scoped_ptr<FrequencySketch> frequency_sketch_;
+
   // This stores all the entry_hash of entries that are removed during
   // initialization.
   base::hash_set<uint64> removed_entries_;
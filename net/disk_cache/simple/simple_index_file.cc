@@ -4,6 +4,8 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <string.h>
+
 #include <vector>
 
 #include "base/file_util.h"
@@ -358,8 +360,12 @@ scoped_ptr<Pickle> SimpleIndexFile::Serialize(
   index_metadata.Serialize(pickle.get());
   for (SimpleIndex::EntrySet::const_iterator it = entries.begin();
        it != entries.end(); ++it) {
-    pickle->WriteUInt64(it->first);
-    it->second.Serialize(pickle.get());
+    EntryRecord record;
+    record.hash_key = it->first;
+    record.last_used_time_seconds_since_epoch =
+        it->second.last_used_time_seconds_since_epoch_;
+    record.entry_size = it->second.entry_size_;
+    pickle->WriteBytes(&record, sizeof(record));
   }
   return pickle.Pass();
 }
@@ -401,20 +407,31 @@ void SimpleIndexFile::Deserialize(const char* data, int data_len,
     return;
   }
 
+  // The records follow back to back: WriteBytes() pads to a multiple of four
+  // bytes, which their size already is.
+  COMPILE_ASSERT(sizeof(EntryRecord) % sizeof(uint32) == 0,
+                 entry_records_must_not_need_padding);
+  const uint64 number_of_entries = index_metadata.GetNumberOfEntries();
+  const char* records;
+  if (!pickle_it.ReadBytes(
+          &records, static_cast<int>(number_of_entries * sizeof(EntryRecord)))) {
+    LOG(WARNING) << "Invalid EntryMetadata in Simple Index file.";
+    return;
+  }
+
 #if !defined(OS_WIN)
   // TODO(gavinp): Consider using std::unordered_map.
-  entries->resize(index_metadata.GetNumberOfEntries() + kExtraSizeForMerge);
+  entries->resize(number_of_entries + kExtraSizeForMerge);
 #endif
-  while (entries->size() < index_metadata.GetNumberOfEntries()) {
-    uint64 hash_key;
+  for (uint64 i = 0; i < number_of_entries; ++i) {
+    // The records need not be aligned in the mapped file.
+    EntryRecord record;
+    memcpy(&record, records + i * sizeof(record), sizeof(record));
     EntryMetadata entry_metadata;
-    if (!pickle_it.ReadUInt64(&hash_key) ||
-        !entry_metadata.Deserialize(&pickle_it)) {
-      LOG(WARNING) << "Invalid EntryMetadata in Simple Index file.";
-      entries->clear();
-      return;
-    }
-    SimpleIndex::InsertInEntrySet(hash_key, entry_metadata, entries);
+    entry_metadata.last_used_time_seconds_since_epoch_ =
+        record.last_used_time_seconds_since_epoch;
+    entry_metadata.entry_size_ = record.entry_size;
+    SimpleIndex::InsertInEntrySet(record.hash_key, entry_metadata, entries);
   }
 
   int64 cache_last_modified;
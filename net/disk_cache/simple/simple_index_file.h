@@ -41,10 +41,12 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 
 // Simple Index File format is a pickle serialized data of IndexMetadata and
 // EntryMetadata objects. The file format is as follows: one instance of
-// serialized |IndexMetadata| followed serialized |EntryMetadata| entries
-// repeated |number_of_entries| amount of times. To know more about the format,
-// see SimpleIndexFile::Serialize() and SeeSimpleIndexFile::LoadFromDisk()
-// methods.
+// serialized |IndexMetadata| followed by |number_of_entries| fixed-size
+// records, one per entry, each holding the hash of the entry key and the
+// fields of its |EntryMetadata|. The records are laid out back to back, so
+// that they are read in one go from the mapped file rather than field by
+// field. To know more about the format, see SimpleIndexFile::Serialize() and
+// SeeSimpleIndexFile::LoadFromDisk() methods.
 //
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
@@ -168,6 +170,13 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
     uint32 crc;
   };
 
+  // The on-disk form of an entry. The fields are those of EntryMetadata.
+  struct EntryRecord {
+    uint64 hash_key;
+    uint32 last_used_time_seconds_since_epoch;
+    int32 entry_size;
+  };
+
   const scoped_refptr<base::SingleThreadTaskRunner> cache_thread_;
   const scoped_refptr<base::TaskRunner> worker_pool_;
   const net::CacheType cache_type_;
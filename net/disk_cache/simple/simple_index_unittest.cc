@@ -9,7 +9,7 @@
 #include "base/hash.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
-#include "base/pickle.h"
+#include "base/metrics/field_trial.h"
 #include "base/sha1.h"
 #include "base/strings/stringprintf.h"
 #include "base/task_runner.h"
@@ -185,18 +185,6 @@ TEST_F(EntryMetadataTest, Basics) {
             entry_metadata.GetLastUsedTime());
 }
 
-TEST_F(EntryMetadataTest, Serialize) {
-  EntryMetadata entry_metadata = NewEntryMetadataWithValues();
-
-  Pickle pickle;
-  entry_metadata.Serialize(&pickle);
-
-  PickleIterator it(pickle);
-  EntryMetadata new_entry_metadata;
-  new_entry_metadata.Deserialize(&it);
-  CheckEntryMetadataValues(new_entry_metadata);
-}
-
 TEST_F(SimpleIndexTest, IndexSizeCorrectOnMerge) {
   typedef disk_cache::SimpleIndex::EntrySet EntrySet;
   index()->SetMaxSize(100);
@@ -549,6 +537,38 @@ TEST_F(SimpleIndexTest, BasicEviction) {
   ASSERT_EQ(2u, last_doom_entry_hashes().size());
 }
 
+// Confirm that with frequency aware eviction, an entry used once is evicted
+// before an older entry that has been used many times.
+TEST_F(SimpleIndexTest, FrequencyAwareEviction) {
+  base::FieldTrialList field_trial_list(NULL);
+  base::FieldTrialList::CreateFieldTrial("SimpleCacheEvictionPolicy",
+                                         "FrequencyAware");
+  // Recreate the index with the field trial in place.
+  SetUp();
+  index()->SetMaxSize(1000);
+  ReturnIndexFile();
+
+  index()->Insert(hashes_.at<1>());
+  index()->UpdateEntrySize(hashes_.at<1>(), 300);
+  index()->UseIfExists(hashes_.at<1>());
+  index()->UseIfExists(hashes_.at<1>());
+  WaitForTimeChange();
+  index()->Insert(hashes_.at<2>());
+  index()->UpdateEntrySize(hashes_.at<2>(), 300);
+  WaitForTimeChange();
+  index()->Insert(hashes_.at<3>());
+  EXPECT_EQ(0, doom_entries_calls());
+
+  // The least recently used entry stays, since it was used the most.
+  index()->UpdateEntrySize(hashes_.at<3>(), 475);
+  EXPECT_EQ(1, doom_entries_calls());
+  ASSERT_EQ(1u, last_doom_entry_hashes().size());
+  EXPECT_EQ(hashes_.at<2>(), last_doom_entry_hashes()[0]);
+  EXPECT_TRUE(index()->Has(hashes_.at<1>()));
+  EXPECT_FALSE(index()->Has(hashes_.at<2>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+}
+
 // Confirm all the operations queue a disk write at some point in the
 // future.
 TEST_F(SimpleIndexTest, DiskWriteQueued) {
@@ -103,6 +103,10 @@ void RecordCloseResult(net::CacheType cache_type, CloseResult result) {
                    "SyncCloseResult", cache_type, result, WRITE_RESULT_MAX);
 }
 
+// Files 0 up to this size are read whole on open, so that the header, the key,
+// stream 0, the EOF records and a short stream 1 all come from a single read.
+const int64 kMaxPrefetchedFileSize = 32 * 1024;
+
 bool CanOmitEmptyFile(int file_index) {
   DCHECK_LE(0, file_index);
   DCHECK_GT(disk_cache::kSimpleEntryFileCount, file_index);
@@ -286,9 +290,12 @@ void SimpleSynchronousEntry::ReadData(const EntryOperationData& in_entry_op,
   // be handled in the SimpleEntryImpl.
   DCHECK_LT(0, in_entry_op.buf_len);
   DCHECK(!empty_file_omitted_[file_index]);
-  File* file = const_cast<File*>(&files_[file_index]);
-  int bytes_read =
-      file->Read(file_offset, out_buf->data(), in_entry_op.buf_len);
+  int bytes_read = ReadFromFile(
+      file_index, file_offset, out_buf->data(), in_entry_op.buf_len);
+  // The prefetched copy of file 0 is there for the open and the first read
+  // after it, typically of the whole of a short stream 1.
+  if (file_index == 0)
+    std::string().swap(prefetched_file_0_);
   if (bytes_read > 0) {
     entry_stat->set_last_used(Time::Now());
     *out_crc32 = crc32(crc32(0L, Z_NULL, 0),
@@ -318,6 +325,8 @@ void SimpleSynchronousEntry::WriteData(const EntryOperationData& in_entry_op,
   const int64 file_offset = out_entry_stat->GetOffsetInFile(
       key_, in_entry_op.offset, in_entry_op.index);
   bool extending_by_write = offset + buf_len > out_entry_stat->data_size(index);
+  if (file_index == 0)
+    std::string().swap(prefetched_file_0_);
 
   if (empty_file_omitted_[file_index]) {
     // Don't create a new file if the entry has been doomed, to avoid it being
@@ -904,13 +913,22 @@ int SimpleSynchronousEntry::InitializeForOpen(
     DLOG(WARNING) << "Could not open platform files for entry.";
     return net::ERR_FAILED;
   }
+  // File size for stream 0 has been stored temporarily in data_size[1].
+  const int64 file_0_size = out_entry_stat->data_size(1);
+  if (file_0_size > 0 && file_0_size <= kMaxPrefetchedFileSize) {
+    prefetched_file_0_.resize(file_0_size);
+    if (files_[0].Read(0, &prefetched_file_0_[0], file_0_size) !=
+        file_0_size) {
+      prefetched_file_0_.clear();
+    }
+  }
   for (int i = 0; i < kSimpleEntryFileCount; ++i) {
     if (empty_file_omitted_[i])
       continue;
 
     SimpleFileHeader header;
     int header_read_result =
-        files_[i].Read(0, reinterpret_cast<char*>(&header), sizeof(header));
+        ReadFromFile(i, 0, reinterpret_cast<char*>(&header), sizeof(header));
     if (header_read_result != sizeof(header)) {
       DLOG(WARNING) << "Cannot read header from entry.";
       RecordSyncOpenResult(cache_type_, OPEN_ENTRY_CANT_READ_HEADER, had_index);
@@ -933,8 +951,8 @@ int SimpleSynchronousEntry::InitializeForOpen(
     }
 
     scoped_ptr<char[]> key(new char[header.key_length]);
-    int key_read_result = files_[i].Read(sizeof(header), key.get(),
-                                         header.key_length);
+    int key_read_result = ReadFromFile(i, sizeof(header), key.get(),
+                                       header.key_length);
     if (key_read_result != implicit_cast<int>(header.key_length)) {
       DLOG(WARNING) << "Cannot read key from entry.";
       RecordSyncOpenResult(cache_type_, OPEN_ENTRY_CANT_READ_KEY, had_index);
@@ -1075,9 +1093,8 @@ int SimpleSynchronousEntry::ReadAndValidateStream0(
   *stream_0_data = new net::GrowableIOBuffer();
   (*stream_0_data)->SetCapacity(stream_0_size);
   int file_offset = out_entry_stat->GetOffsetInFile(key_, 0, 0);
-  File* file = const_cast<File*>(&files_[0]);
   int bytes_read =
-      file->Read(file_offset, (*stream_0_data)->data(), stream_0_size);
+      ReadFromFile(0, file_offset, (*stream_0_data)->data(), stream_0_size);
   if (bytes_read != stream_0_size)
     return net::ERR_FAILED;
 
@@ -1106,9 +1123,9 @@ int SimpleSynchronousEntry::GetEOFRecordData(int index,
   SimpleFileEOF eof_record;
   int file_offset = entry_stat.GetEOFOffsetInFile(key_, index);
   int file_index = GetFileIndexFromStreamIndex(index);
-  File* file = const_cast<File*>(&files_[file_index]);
-  if (file->Read(file_offset, reinterpret_cast<char*>(&eof_record),
-                 sizeof(eof_record)) !=
+  if (ReadFromFile(file_index, file_offset,
+                   reinterpret_cast<char*>(&eof_record),
+                   sizeof(eof_record)) !=
       sizeof(eof_record)) {
     RecordCheckEOFResult(cache_type_, CHECK_EOF_RESULT_READ_FAILURE);
     return net::ERR_CACHE_CHECKSUM_READ_FAILURE;
@@ -1128,6 +1145,20 @@ int SimpleSynchronousEntry::GetEOFRecordData(int index,
   return net::OK;
 }
 
+int SimpleSynchronousEntry::ReadFromFile(int file_index,
+                                         int64 offset,
+                                         char* data,
+                                         int length) const {
+  if (file_index == 0 && offset >= 0 && length >= 0 &&
+      offset + length <= static_cast<int64>(prefetched_file_0_.size())) {
+    if (length > 0)
+      std::memcpy(data, prefetched_file_0_.data() + offset, length);
+    return length;
+  }
+  File* file = const_cast<File*>(&files_[file_index]);
+  return file->Read(offset, data, length);
+}
+
 void SimpleSynchronousEntry::Doom() const {
   DeleteFilesForEntryHash(path_, entry_hash_);
 }
@@ -1229,7 +1260,7 @@ bool SimpleSynchronousEntry::InitializeSparseFile() {
 
   SimpleFileHeader header;
   header.initial_magic_number = kSimpleInitialMagicNumber;
-  header.version = kSimpleVersion;
+  header.version = kSimpleSparseEntryVersionOnDisk;
   header.key_length = key_.size();
   header.key_hash = base::Hash(key_);
 
@@ -1271,7 +1302,7 @@ bool SimpleSynchronousEntry::ScanSparseFile(int32* out_sparse_data_size) {
     return false;
   }
 
-  if (header.version != kSimpleVersion) {
+  if (header.version != kSimpleSparseEntryVersionOnDisk) {
     DLOG(WARNING) << "Sparse file unreadable version.";
     return false;
   }
@@ -259,6 +259,15 @@ class SimpleSynchronousEntry {
                        bool* out_has_crc32,
                        uint32* out_crc32,
                        int* out_data_size) const;
+
+  // Reads |length| bytes at |offset| of file |file_index|, from the
+  // prefetched copy of file 0 when it covers the range.  Returns the number of
+  // bytes read, or a negative value on error, like File::Read().
+  int ReadFromFile(int file_index,
+                   int64 offset,
+                   char* data,
+                   int length) const;
+
   void Doom() const;
 
   // Opens the sparse data file and scans it if it exists.
@@ -322,6 +331,11 @@ class SimpleSynchronousEntry {
   // was created to store it.
   bool empty_file_omitted_[kSimpleEntryFileCount];
 
+  // The whole of file 0 when it was small enough to read in one go on open,
+  // until the first ReadData() or WriteData() on it.  Mutable, as ReadData()
+  // releases it.
+  mutable std::string prefetched_file_0_;
+
   typedef std::map<int64, SparseRange> SparseRangeOffsetMap;
   typedef SparseRangeOffsetMap::iterator SparseRangeIterator;
   SparseRangeOffsetMap sparse_ranges_;
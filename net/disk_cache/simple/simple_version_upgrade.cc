@@ -23,6 +23,7 @@ namespace {
 const uint32 kMinVersionAbleToUpgrade = 5;
 
 const char kFakeIndexFileName[] = "index";
+const char kIndexDirectory[] = "index-dir";
 const char kIndexFileName[] = "the-real-index";
 
 void LogMessageFailedUpgradeFromVersion(int version) {
@@ -107,6 +108,37 @@ bool UpgradeIndexV5V6(const base::FilePath& cache_directory) {
   return true;
 }
 
+// Migrates the cache directory from version 6 to version 7.
+// Returns true iff it succeeds.
+//
+// The V6 and V7 caches differ only in the file format of the index, and like
+// UpgradeIndexV5V6() the upgrade *deletes* the old index file. The index is
+// then restored from the entry files on the next load.
+//
+// Pickled file format:
+//   <v7-index> ::= <v7-index-metadata>
+//                  <v7-entry-info>*
+//                  Int64(<cache-dir-mtime>)
+//   <v7-index-metadata> ::= UInt64(kSimpleIndexMagicNumber)
+//                           UInt32(7)
+//                           UInt64(<number-of-entries>)
+//                           UInt64(<cache-size-in-bytes>)
+//   <v7-entry-info> ::= 16 bytes, not padded:
+//                       uint64(<hash-of-the-key>)
+//                       uint32(<entry-last-used-time-in-seconds>)
+//                       int32(<entry-size-in-bytes>)
+//   Where:
+//     <entry-last-used-time-in-seconds> counts from the Unix epoch, or is 0
+//       for a null time.
+//     The remaining fields are as in the V6 format.
+bool UpgradeIndexV6V7(const base::FilePath& cache_directory) {
+  const base::FilePath old_index_file =
+      cache_directory.AppendASCII(kIndexDirectory).AppendASCII(kIndexFileName);
+  if (!base::DeleteFile(old_index_file, /* recursive = */ false))
+    return false;
+  return true;
+}
+
 // Some points about the Upgrade process are still not clear:
 // 1. if the upgrade path requires dropping cache it would be faster to just
 //    return an initialization error here and proceed with asynchronous cache
@@ -170,6 +202,14 @@ bool UpgradeSimpleCacheOnDisk(const base::FilePath& path) {
     }
     version_from++;
   }
+  if (version_from == 6) {
+    // Upgrade only the index for V6 -> V7 move.
+    if (!UpgradeIndexV6V7(path)) {
+      LogMessageFailedUpgradeFromVersion(file_header.version);
+      return false;
+    }
+    version_from++;
+  }
   if (version_from == kSimpleVersion) {
     if (!upgrade_needed) {
       return true;
@@ -44,6 +44,7 @@ struct NET_EXPORT_PRIVATE FakeIndexData {
 
 // Exposed for testing.
 NET_EXPORT_PRIVATE bool UpgradeIndexV5V6(const base::FilePath& cache_directory);
+NET_EXPORT_PRIVATE bool UpgradeIndexV6V7(const base::FilePath& cache_directory);
 
 }  // namespace disk_cache
 
@@ -28,12 +28,15 @@ const uint64 kSimpleInitialMagicNumber = GG_UINT64_C(0xfcfb6d1ba7725c30);
 // cache belongs to one backend or another.
 const char kFakeIndexFileName[] = "index";
 
+// Same as |SimpleIndexFile::kIndexDirectory|.
+const char kIndexDirectory[] = "index-dir";
+
 // Same as |SimpleIndexFile::kIndexFileName|.
 const char kIndexFileName[] = "the-real-index";
 
-bool WriteFakeIndexFileV5(const base::FilePath& cache_path) {
+bool WriteFakeIndexFile(const base::FilePath& cache_path, uint32 version) {
   disk_cache::FakeIndexData data;
-  data.version = 5;
+  data.version = version;
   data.initial_magic_number = kSimpleInitialMagicNumber;
   data.unused_must_be_zero1 = 0;
   data.unused_must_be_zero2 = 0;
@@ -43,6 +46,10 @@ bool WriteFakeIndexFileV5(const base::FilePath& cache_path) {
              file_name, reinterpret_cast<const char*>(&data), sizeof(data));
 }
 
+bool WriteFakeIndexFileV5(const base::FilePath& cache_path) {
+  return WriteFakeIndexFile(cache_path, 5);
+}
+
 TEST(SimpleVersionUpgradeTest, FailsToMigrateBackwards) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -135,6 +142,35 @@ TEST(SimpleVersionUpgradeTest, UpgradeV5V6IndexMustDisappear) {
   }
 }
 
+TEST(SimpleVersionUpgradeTest, UpgradeV6V7IndexMustDisappear) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  const base::FilePath cache_path = cache_dir.path();
+
+  ASSERT_TRUE(WriteFakeIndexFile(cache_path, 6));
+  const std::string file_contents("index in the V6 format");
+  const base::FilePath index_file =
+      cache_path.AppendASCII(kIndexDirectory).AppendASCII(kIndexFileName);
+  ASSERT_TRUE(base::CreateDirectory(index_file.DirName()));
+  ASSERT_EQ(implicit_cast<int>(file_contents.size()),
+            file_util::WriteFile(
+                index_file, file_contents.data(), file_contents.size()));
+
+  // Upgrade.
+  ASSERT_TRUE(disk_cache::UpgradeSimpleCacheOnDisk(cache_path));
+
+  // Check that the old index disappeared and the fake index is updated.
+  EXPECT_FALSE(base::PathExists(index_file));
+  std::string new_fake_index_contents;
+  ASSERT_TRUE(base::ReadFileToString(cache_path.AppendASCII(kFakeIndexFileName),
+                                     &new_fake_index_contents));
+  ASSERT_EQ(sizeof(disk_cache::FakeIndexData), new_fake_index_contents.size());
+  const disk_cache::FakeIndexData* fake_index_header =
+      reinterpret_cast<const disk_cache::FakeIndexData*>(
+          new_fake_index_contents.data());
+  EXPECT_EQ(disk_cache::kSimpleVersion, fake_index_header->version);
+}
+
 }  // namespace
 
 #endif  // defined(OS_POSIX)
@@ -0,0 +1,538 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiered_backend.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/frequency_sketch.h"
+#include "net/disk_cache/mem_backend_impl.h"
+#include "net/disk_cache/simple/simple_util.h"
+
+namespace {
+
+const int kNumStreams = 3;
+
+// The number of recent opens after which an entry is copied into memory as it
+// is read.
+const int kPromotionFrequency = 2;
+
+// The sketch is grown to the entry count of the disk backend as needed.
+const size_t kMinExpectedEntries = 1024;
+
+}  // namespace
+
+namespace disk_cache {
+
+// The state of an operation handing out an entry while the disk backend is
+// opening it.
+struct TieredBackend::PendingOpen {
+  PendingOpen(const std::string& key,
+              OpenMode mode,
+              Entry** entry,
+              const CompletionCallback& callback)
+      : key(key),
+        mode(mode),
+        disk_entry(NULL),
+        entry(entry),
+        callback(callback) {
+  }
+
+  const std::string key;
+  const OpenMode mode;
+  Entry* disk_entry;
+  Entry** entry;
+  const CompletionCallback callback;
+};
+
+// The entry handed out by TieredBackend. It forwards everything to the entry
+// of the disk backend, except for reads of a valid copy in memory.
+//
+// When |capturing_| is set, |streams_| holds the beginning of the data of each
+// stream, as seen through the reads and writes of this entry. If the data of
+// every stream went through by the time the entry is closed, the entry is
+// copied into memory.
+class TieredBackend::TieredEntry : public Entry {
+ public:
+  TieredEntry(const base::WeakPtr<TieredBackend>& backend,
+              Entry* disk_entry,
+              Entry* memory_entry,
+              bool capture,
+              int max_capture_size)
+      : backend_(backend),
+        disk_entry_(disk_entry),
+        memory_entry_(memory_entry),
+        capturing_(capture),
+        max_capture_size_(max_capture_size),
+        captured_size_(0),
+        pending_writes_(0),
+        weak_factory_(this) {
+    DCHECK(!memory_entry_ || !capturing_);
+  }
+
+  // Entry interface.
+  virtual void Doom() OVERRIDE {
+    DropMemoryEntry();
+    StopCapturing();
+    disk_entry_->Doom();
+  }
+
+  virtual void Close() OVERRIDE {
+    if (capturing_ && !pending_writes_ && backend_ && HasAllData())
+      backend_->AdmitEntry(disk_entry_->GetKey(), streams_);
+    if (memory_entry_)
+      memory_entry_->Close();
+    disk_entry_->Close();
+    delete this;
+  }
+
+  virtual std::string GetKey() const OVERRIDE {
+    return disk_entry_->GetKey();
+  }
+
+  virtual base::Time GetLastUsed() const OVERRIDE {
+    return disk_entry_->GetLastUsed();
+  }
+
+  virtual base::Time GetLastModified() const OVERRIDE {
+    return disk_entry_->GetLastModified();
+  }
+
+  virtual int32 GetDataSize(int index) const OVERRIDE {
+    return disk_entry_->GetDataSize(index);
+  }
+
+  virtual int ReadData(int index, int offset, IOBuffer* buf, int buf_len,
+                       const CompletionCallback& callback) OVERRIDE {
+    if (memory_entry_)
+      return memory_entry_->ReadData(index, offset, buf, buf_len, callback);
+    if (!capturing_)
+      return disk_entry_->ReadData(index, offset, buf, buf_len, callback);
+
+    int rv = disk_entry_->ReadData(
+        index, offset, buf, buf_len,
+        base::Bind(&TieredEntry::OnReadComplete, weak_factory_.GetWeakPtr(),
+                   index, offset, make_scoped_refptr(buf), callback));
+    if (rv > 0)
+      CaptureRead(index, offset, buf->data(), rv);
+    return rv;
+  }
+
+  virtual int WriteData(int index, int offset, IOBuffer* buf, int buf_len,
+                        const CompletionCallback& callback,
+                        bool truncate) OVERRIDE {
+    DropMemoryEntry();
+    if (!capturing_) {
+      return disk_entry_->WriteData(index, offset, buf, buf_len, callback,
+                                    truncate);
+    }
+
+    CaptureWrite(index, offset, buf ? buf->data() : NULL, buf_len, truncate);
+    ++pending_writes_;
+    int rv = disk_entry_->WriteData(
+        index, offset, buf, buf_len,
+        base::Bind(&TieredEntry::OnWriteComplete, weak_factory_.GetWeakPtr(),
+                   buf_len, callback),
+        truncate);
+    if (rv != net::ERR_IO_PENDING)
+      DidWrite(buf_len, rv);
+    return rv;
+  }
+
+  virtual int ReadSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                             const CompletionCallback& callback) OVERRIDE {
+    return disk_entry_->ReadSparseData(offset, buf, buf_len, callback);
+  }
+
+  virtual int WriteSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                              const CompletionCallback& callback) OVERRIDE {
+    DropMemoryEntry();
+    StopCapturing();
+    return disk_entry_->WriteSparseData(offset, buf, buf_len, callback);
+  }
+
+  virtual int GetAvailableRange(int64 offset, int len, int64* start,
+                                const CompletionCallback& callback) OVERRIDE {
+    return disk_entry_->GetAvailableRange(offset, len, start, callback);
+  }
+
+  virtual bool CouldBeSparse() const OVERRIDE {
+    return disk_entry_->CouldBeSparse();
+  }
+
+  virtual void CancelSparseIO() OVERRIDE {
+    disk_entry_->CancelSparseIO();
+  }
+
+  virtual int ReadyForSparseIO(const CompletionCallback& callback) OVERRIDE {
+    return disk_entry_->ReadyForSparseIO(callback);
+  }
+
+ private:
+  virtual ~TieredEntry() {}
+
+  // These run even after the entry is closed, as the disk backend promises to
+  // call |callback| in that case.
+  static void OnReadComplete(const base::WeakPtr<TieredEntry>& entry,
+                             int index,
+                             int offset,
+                             const scoped_refptr<IOBuffer>& buf,
+                             const CompletionCallback& callback,
+                             int result) {
+    if (entry && result > 0)
+      entry->CaptureRead(index, offset, buf->data(), result);
+    if (!callback.is_null())
+      callback.Run(result);
+  }
+
+  static void OnWriteComplete(const base::WeakPtr<TieredEntry>& entry,
+                              int buf_len,
+                              const CompletionCallback& callback,
+                              int result) {
+    if (entry)
+      entry->DidWrite(buf_len, result);
+    if (!callback.is_null())
+      callback.Run(result);
+  }
+
+  void DidWrite(int buf_len, int result) {
+    DCHECK_GT(pending_writes_, 0);
+    --pending_writes_;
+    if (result != buf_len)
+      StopCapturing();
+  }
+
+  // Stops serving reads from memory before the entry is changed. The data of
+  // the copy starts the capture of the new version of the entry.
+  void DropMemoryEntry() {
+    if (!memory_entry_)
+      return;
+
+    capturing_ = true;
+    for (int i = 0; i < kNumStreams && capturing_; ++i) {
+      int size = memory_entry_->GetDataSize(i);
+      if (!size)
+        continue;
+      scoped_refptr<IOBuffer> buf(new IOBuffer(size));
+      int rv = memory_entry_->ReadData(i, 0, buf.get(), size,
+                                       CompletionCallback());
+      if (rv != size) {
+        StopCapturing();
+        break;
+      }
+      CaptureRead(i, 0, buf->data(), size);
+    }
+    memory_entry_->Doom();
+    memory_entry_->Close();
+    memory_entry_ = NULL;
+  }
+
+  // Each stream of |streams_| is kept a prefix of the actual data, which grows
+  // as reads reach past its end and follows the writes that start within it.
+  void CaptureRead(int index, int offset, const char* data, int len) {
+    if (!capturing_ || index < 0 || index >= kNumStreams || offset < 0)
+      return;
+
+    std::string& stream = streams_[index];
+    size_t start = offset;
+    size_t end = start + len;
+    if (start > stream.size() || end <= stream.size())
+      return;
+
+    size_t old_size = stream.size();
+    stream.append(data + (old_size - start), end - old_size);
+    AddCapturedSize(end - old_size);
+  }
+
+  void CaptureWrite(int index, int offset, const char* data, int len,
+                    bool truncate) {
+    if (!capturing_)
+      return;
+
+    if (index < 0 || index >= kNumStreams || offset < 0 || len < 0 ||
+        static_cast<size_t>(offset) > streams_[index].size()) {
+      StopCapturing();
+      return;
+    }
+
+    std::string& stream = streams_[index];
+    size_t start = offset;
+    size_t end = start + len;
+    size_t old_size = stream.size();
+    if (truncate || end > old_size)
+      stream.resize(end);
+    if (len)
+      stream.replace(start, len, data, len);
+    AddCapturedSize(static_cast<int>(stream.size()) -
+                    static_cast<int>(old_size));
+  }
+
+  void AddCapturedSize(int bytes) {
+    captured_size_ += bytes;
+    if (captured_size_ > max_capture_size_)
+      StopCapturing();
+  }
+
+  void StopCapturing() {
+    capturing_ = false;
+    for (int i = 0; i < kNumStreams; ++i)
+      std::string().swap(streams_[i]);
+    captured_size_ = 0;
+  }
+
+  // Returns true if |streams_| holds all the data of the entry.
+  bool HasAllData() const {
+    if (!captured_size_ || disk_entry_->CouldBeSparse())
+      return false;
+    for (int i = 0; i < kNumStreams; ++i) {
+      if (static_cast<int32>(streams_[i].size()) !=
+          disk_entry_->GetDataSize(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  base::WeakPtr<TieredBackend> backend_;
+  Entry* disk_entry_;
+  Entry* memory_entry_;
+
+  bool capturing_;
+  int max_capture_size_;
+  int captured_size_;
+  std::string streams_[kNumStreams];
+
+  // Writes are only known to have made it to the disk entry when they
+  // complete.
+  int pending_writes_;
+
+  base::WeakPtrFactory<TieredEntry> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TieredEntry);
+};
+
+TieredBackend::TieredBackend(scoped_ptr<Backend> disk_backend,
+                             int memory_tier_bytes,
+                             net::NetLog* net_log)
+    : disk_backend_(disk_backend.Pass()),
+      memory_backend_(MemBackendImpl::CreateBackend(memory_tier_bytes,
+                                                    net_log)),
+      frequency_sketch_(new FrequencySketch(kMinExpectedEntries)),
+      max_entry_size_(memory_tier_bytes / 8),
+      weak_factory_(this) {
+  DCHECK(disk_backend_);
+  DCHECK_GT(memory_tier_bytes, 0);
+  DCHECK(memory_backend_);
+}
+
+TieredBackend::~TieredBackend() {
+  // Outstanding callbacks of the disk backend are dropped along with it.
+  disk_backend_.reset();
+}
+
+net::CacheType TieredBackend::GetCacheType() const {
+  return disk_backend_->GetCacheType();
+}
+
+int32 TieredBackend::GetEntryCount() const {
+  return disk_backend_->GetEntryCount();
+}
+
+int TieredBackend::OpenEntry(const std::string& key, Entry** entry,
+                             const CompletionCallback& callback) {
+  frequency_sketch_->EnsureCapacity(
+      std::max(kMinExpectedEntries,
+               static_cast<size_t>(std::max(0, GetEntryCount()))));
+  frequency_sketch_->Increment(simple_util::GetEntryHashKey(key));
+
+  return OpenDiskEntry(new PendingOpen(key, OPEN_EXISTING, entry, callback),
+                       &Backend::OpenEntry);
+}
+
+int TieredBackend::CreateEntry(const std::string& key, Entry** entry,
+                               const CompletionCallback& callback) {
+  memory_backend_->DoomEntry(key, CompletionCallback());
+  return OpenDiskEntry(new PendingOpen(key, OPEN_CREATED, entry, callback),
+                       &Backend::CreateEntry);
+}
+
+int TieredBackend::DoomEntry(const std::string& key,
+                             const CompletionCallback& callback) {
+  memory_backend_->DoomEntry(key, CompletionCallback());
+  return disk_backend_->DoomEntry(key, callback);
+}
+
+int TieredBackend::DoomAllEntries(const CompletionCallback& callback) {
+  memory_backend_->DoomAllEntries(CompletionCallback());
+  return disk_backend_->DoomAllEntries(callback);
+}
+
+int TieredBackend::DoomEntriesBetween(base::Time initial_time,
+                                      base::Time end_time,
+                                      const CompletionCallback& callback) {
+  memory_backend_->DoomEntriesBetween(initial_time, end_time,
+                                      CompletionCallback());
+  return disk_backend_->DoomEntriesBetween(initial_time, end_time, callback);
+}
+
+int TieredBackend::DoomEntriesSince(base::Time initial_time,
+                                    const CompletionCallback& callback) {
+  memory_backend_->DoomEntriesSince(initial_time, CompletionCallback());
+  return disk_backend_->DoomEntriesSince(initial_time, callback);
+}
+
+int TieredBackend::OpenNextEntry(void** iter, Entry** next_entry,
+                                 const CompletionCallback& callback) {
+  PendingOpen* pending_open =
+      new PendingOpen(std::string(), OPEN_ENUMERATED, next_entry, callback);
+  // The callback owns |pending_open|, and |open_callback| keeps it alive if
+  // the disk backend finishes synchronously.
+  CompletionCallback open_callback =
+      base::Bind(&TieredBackend::OnDiskEntryOpened, weak_factory_.GetWeakPtr(),
+                 base::Owned(pending_open));
+  int rv = disk_backend_->OpenNextEntry(iter, &pending_open->disk_entry,
+                                        open_callback);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+  return FinishOpen(pending_open, rv);
+}
+
+void TieredBackend::EndEnumeration(void** iter) {
+  disk_backend_->EndEnumeration(iter);
+}
+
+void TieredBackend::GetStats(
+    std::vector<std::pair<std::string, std::string> >* stats) {
+  disk_backend_->GetStats(stats);
+  stats->push_back(std::make_pair(
+      std::string("Memory tier entries"),
+      base::IntToString(memory_backend_->GetEntryCount())));
+}
+
+void TieredBackend::OnExternalCacheHit(const std::string& key) {
+  frequency_sketch_->Increment(simple_util::GetEntryHashKey(key));
+  disk_backend_->OnExternalCacheHit(key);
+}
+
+// static
+bool TieredBackend::IsCopyCurrent(base::Time copy_time,
+                                  base::Time disk_last_modified) {
+  return disk_last_modified <= copy_time;
+}
+
+int TieredBackend::OpenDiskEntry(PendingOpen* pending_open,
+                                 OpenFunction open_function) {
+  // The callback owns |pending_open|, and |open_callback| keeps it alive if
+  // the disk backend finishes synchronously.
+  CompletionCallback open_callback =
+      base::Bind(&TieredBackend::OnDiskEntryOpened, weak_factory_.GetWeakPtr(),
+                 base::Owned(pending_open));
+  int rv = (disk_backend_.get()->*open_function)(
+      pending_open->key, &pending_open->disk_entry, open_callback);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+  return FinishOpen(pending_open, rv);
+}
+
+int TieredBackend::FinishOpen(PendingOpen* pending_open, int result) {
+  // The copy is looked up only now, so that it can't be admitted between the
+  // start of the open and its end.
+  Entry* memory_entry = NULL;
+  if (pending_open->mode == OPEN_EXISTING &&
+      memory_backend_->OpenEntry(pending_open->key, &memory_entry,
+                                 CompletionCallback()) != net::OK) {
+    memory_entry = NULL;
+  }
+
+  if (result != net::OK) {
+    // The disk backend doesn't have the entry anymore, so neither should the
+    // memory tier.
+    if (memory_entry) {
+      memory_entry->Doom();
+      memory_entry->Close();
+    }
+    return result;
+  }
+
+  Entry* disk_entry = pending_open->disk_entry;
+  if (memory_entry && !IsCopyOf(memory_entry, disk_entry)) {
+    memory_entry->Doom();
+    memory_entry->Close();
+    memory_entry = NULL;
+  }
+
+  bool capture = false;
+  if (pending_open->mode == OPEN_CREATED)
+    capture = true;
+  else if (pending_open->mode == OPEN_EXISTING && !memory_entry)
+    capture = ShouldPromote(pending_open->key, disk_entry);
+
+  *pending_open->entry = new TieredEntry(weak_factory_.GetWeakPtr(),
+                                         disk_entry, memory_entry, capture,
+                                         max_entry_size_);
+  return net::OK;
+}
+
+// static
+bool TieredBackend::IsCopyOf(Entry* memory_entry, Entry* disk_entry) {
+  // The copy is written when it is made, and never after.
+  if (!IsCopyCurrent(memory_entry->GetLastModified(),
+                     disk_entry->GetLastModified())) {
+    return false;
+  }
+  for (int i = 0; i < kNumStreams; ++i) {
+    if (memory_entry->GetDataSize(i) != disk_entry->GetDataSize(i))
+      return false;
+  }
+  return true;
+}
+
+void TieredBackend::OnDiskEntryOpened(PendingOpen* pending_open, int result) {
+  int rv = FinishOpen(pending_open, result);
+  if (!pending_open->callback.is_null())
+    pending_open->callback.Run(rv);
+}
+
+bool TieredBackend::ShouldPromote(const std::string& key,
+                                  Entry* disk_entry) const {
+  if (frequency_sketch_->Estimate(simple_util::GetEntryHashKey(key)) <
+      kPromotionFrequency) {
+    return false;
+  }
+
+  int64 size = 0;
+  for (int i = 0; i < kNumStreams; ++i)
+    size += disk_entry->GetDataSize(i);
+  return size > 0 && size <= max_entry_size_;
+}
+
+void TieredBackend::AdmitEntry(const std::string& key,
+                               const std::string* streams) {
+  memory_backend_->DoomEntry(key, CompletionCallback());
+  Entry* entry = NULL;
+  if (memory_backend_->CreateEntry(key, &entry, CompletionCallback()) !=
+      net::OK) {
+    return;
+  }
+
+  for (int i = 0; i < kNumStreams; ++i) {
+    if (streams[i].empty())
+      continue;
+    scoped_refptr<net::StringIOBuffer> buf(
+        new net::StringIOBuffer(streams[i]));
+    if (entry->WriteData(i, 0, buf.get(), buf->size(), CompletionCallback(),
+                         false) != buf->size()) {
+      entry->Doom();
+      break;
+    }
+  }
+  entry->Close();
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,132 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// See net/disk_cache/disk_cache.h for the public interface of the cache.
+
+#ifndef NET_DISK_CACHE_TIERED_BACKEND_H_
+#define NET_DISK_CACHE_TIERED_BACKEND_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/disk_cache.h"
+
+namespace net {
+class NetLog;
+}  // namespace net
+
+namespace disk_cache {
+
+class FrequencySketch;
+
+// This class implements the Backend interface on top of another backend,
+// usually a disk cache, keeping copies of small entries in memory so that
+// reading them back doesn't have to wait for the disk.
+//
+// The wrapped backend stays the authority on what the cache holds: every
+// operation is performed on it, and the memory tier only serves the reads of
+// entries whose copy matches what the wrapped backend has. An entry is copied
+// into memory when it is closed after all of its data went through the entry,
+// either because it was written (a new entry, prefetched for instance) or
+// because it was read after being opened often enough recently to be hot.
+// Writing to an entry drops its copy until it is closed again. Once the memory
+// tier is full, the least recently used copies are evicted.
+class NET_EXPORT_PRIVATE TieredBackend : public Backend {
+ public:
+  // Up to |memory_tier_bytes| of entries of |disk_backend| will be kept in
+  // memory.
+  TieredBackend(scoped_ptr<Backend> disk_backend,
+                int memory_tier_bytes,
+                net::NetLog* net_log);
+  virtual ~TieredBackend();
+
+  // Backend interface.
+  virtual net::CacheType GetCacheType() const OVERRIDE;
+  virtual int32 GetEntryCount() const OVERRIDE;
+  virtual int OpenEntry(const std::string& key, Entry** entry,
+                        const CompletionCallback& callback) OVERRIDE;
+  virtual int CreateEntry(const std::string& key, Entry** entry,
+                          const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntry(const std::string& key,
+                        const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomAllEntries(const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntriesBetween(base::Time initial_time,
+                                 base::Time end_time,
+                                 const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntriesSince(base::Time initial_time,
+                               const CompletionCallback& callback) OVERRIDE;
+  virtual int OpenNextEntry(void** iter, Entry** next_entry,
+                            const CompletionCallback& callback) OVERRIDE;
+  virtual void EndEnumeration(void** iter) OVERRIDE;
+  virtual void GetStats(
+      std::vector<std::pair<std::string, std::string> >* stats) OVERRIDE;
+  virtual void OnExternalCacheHit(const std::string& key) OVERRIDE;
+
+  // Returns true if a copy made at |copy_time| still holds the data of a disk
+  // entry last modified at |disk_last_modified|, that is, if the disk entry
+  // was not modified after the copy was made. A copy made at the very time of
+  // the last modification is current, as copies are only made once the writes
+  // are done. A disk entry modified after the copy, which the clock going
+  // backwards looks like too, makes the copy stale.
+  static bool IsCopyCurrent(base::Time copy_time,
+                            base::Time disk_last_modified);
+
+ private:
+  class TieredEntry;
+  struct PendingOpen;
+
+  enum OpenMode {
+    // The entry was opened by OpenEntry(), and may be served from memory.
+    OPEN_EXISTING,
+    // The entry was created by CreateEntry().
+    OPEN_CREATED,
+    // The entry was returned by OpenNextEntry().
+    OPEN_ENUMERATED,
+  };
+
+  // Issues |pending_open| on the disk backend with |open_function|.
+  typedef int (Backend::*OpenFunction)(const std::string& key,
+                                       Entry** entry,
+                                       const CompletionCallback& callback);
+  int OpenDiskEntry(PendingOpen* pending_open, OpenFunction open_function);
+
+  // Wraps the disk entry opened for |pending_open|, along with its copy in
+  // memory if there is one, and hands it out.
+  int FinishOpen(PendingOpen* pending_open, int result);
+  void OnDiskEntryOpened(PendingOpen* pending_open, int result);
+
+  // Returns true if |memory_entry| can serve the reads of |disk_entry|.
+  static bool IsCopyOf(Entry* memory_entry, Entry* disk_entry);
+
+  // Returns true if |disk_entry|, which was just opened with |key|, should be
+  // copied into memory as it is read.
+  bool ShouldPromote(const std::string& key, Entry* disk_entry) const;
+
+  // Called when a TieredEntry holding all the data of the entry |key| is
+  // closed. |streams| has the data of each stream.
+  void AdmitEntry(const std::string& key, const std::string* streams);
+
+  scoped_ptr<Backend> disk_backend_;
+  scoped_ptr<Backend> memory_backend_;
+
+  // How often each key has been opened recently.
+  scoped_ptr<FrequencySketch> frequency_sketch_;
+
+  // The largest entry copied into memory.
+  int max_entry_size_;
+
+  base::WeakPtrFactory<TieredBackend> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TieredBackend);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_TIERED_BACKEND_H_
@@ -0,0 +1,255 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiered_backend.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/disk_cache/mem_backend_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+const int kMemoryTierSize = 64 * 1024;
+
+class TieredBackendTest : public testing::Test {
+ protected:
+  TieredBackendTest() {
+    // The disk backend is simulated by another memory backend, so that the
+    // test can look at what it holds.
+    scoped_ptr<Backend> disk_backend(
+        MemBackendImpl::CreateBackend(1024 * 1024, NULL));
+    disk_backend_ = disk_backend.get();
+    backend_.reset(
+        new TieredBackend(disk_backend.Pass(), kMemoryTierSize, NULL));
+  }
+
+  // Returns the number of entries copied into memory.
+  int MemoryTierEntryCount() {
+    std::vector<std::pair<std::string, std::string> > stats;
+    backend_->GetStats(&stats);
+    for (size_t i = 0; i < stats.size(); ++i) {
+      int count = -1;
+      if (stats[i].first == "Memory tier entries" &&
+          base::StringToInt(stats[i].second, &count)) {
+        return count;
+      }
+    }
+    ADD_FAILURE() << "No memory tier stats";
+    return -1;
+  }
+
+  static void WriteStream(Entry* entry, int index, const std::string& data) {
+    scoped_refptr<net::StringIOBuffer> buf(new net::StringIOBuffer(data));
+    net::TestCompletionCallback cb;
+    EXPECT_EQ(buf->size(), cb.GetResult(entry->WriteData(
+        index, 0, buf.get(), buf->size(), cb.callback(), true)));
+  }
+
+  static std::string ReadStream(Entry* entry, int index) {
+    int size = entry->GetDataSize(index);
+    scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(size + 1));
+    net::TestCompletionCallback cb;
+    int rv = cb.GetResult(entry->ReadData(index, 0, buf.get(), size,
+                                          cb.callback()));
+    EXPECT_EQ(size, rv);
+    return rv > 0 ? std::string(buf->data(), rv) : std::string();
+  }
+
+  // Writes an entry directly to the disk backend.
+  void CreateDiskEntry(const std::string& key,
+                       const std::string& headers,
+                       const std::string& body) {
+    Entry* entry = NULL;
+    net::TestCompletionCallback cb;
+    ASSERT_EQ(net::OK, cb.GetResult(
+        disk_backend_->CreateEntry(key, &entry, cb.callback())));
+    WriteStream(entry, 0, headers);
+    WriteStream(entry, 1, body);
+    entry->Close();
+  }
+
+  Entry* OpenEntry(const std::string& key) {
+    Entry* entry = NULL;
+    net::TestCompletionCallback cb;
+    EXPECT_EQ(net::OK, cb.GetResult(
+        backend_->OpenEntry(key, &entry, cb.callback())));
+    return entry;
+  }
+
+  // Opens |key| through the tiered backend, and reads all of it.
+  void ReadEntry(const std::string& key,
+                 const std::string& headers,
+                 const std::string& body) {
+    Entry* entry = OpenEntry(key);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(headers, ReadStream(entry, 0));
+    EXPECT_EQ(body, ReadStream(entry, 1));
+    entry->Close();
+  }
+
+  Backend* disk_backend_;
+  scoped_ptr<TieredBackend> backend_;
+};
+
+}  // namespace
+
+TEST_F(TieredBackendTest, CreatedEntryIsCopied) {
+  Entry* entry = NULL;
+  net::TestCompletionCallback cb;
+  ASSERT_EQ(net::OK, cb.GetResult(
+      backend_->CreateEntry("key", &entry, cb.callback())));
+  WriteStream(entry, 0, "headers");
+  WriteStream(entry, 1, "body");
+  entry->Close();
+  EXPECT_EQ(1, MemoryTierEntryCount());
+  EXPECT_EQ(1, disk_backend_->GetEntryCount());
+
+  ReadEntry("key", "headers", "body");
+}
+
+TEST_F(TieredBackendTest, HotEntryIsPromoted) {
+  CreateDiskEntry("key", "headers", "body");
+
+  ReadEntry("key", "headers", "body");
+  EXPECT_EQ(0, MemoryTierEntryCount());
+
+  ReadEntry("key", "headers", "body");
+  EXPECT_EQ(1, MemoryTierEntryCount());
+
+  ReadEntry("key", "headers", "body");
+  EXPECT_EQ(1, MemoryTierEntryCount());
+}
+
+TEST_F(TieredBackendTest, PartiallyReadEntryIsNotPromoted) {
+  CreateDiskEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+
+  Entry* entry = OpenEntry("key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("headers", ReadStream(entry, 0));
+  entry->Close();
+  EXPECT_EQ(0, MemoryTierEntryCount());
+}
+
+TEST_F(TieredBackendTest, LargeEntryIsNotCopied) {
+  Entry* entry = NULL;
+  net::TestCompletionCallback cb;
+  ASSERT_EQ(net::OK, cb.GetResult(
+      backend_->CreateEntry("key", &entry, cb.callback())));
+  WriteStream(entry, 0, "headers");
+  WriteStream(entry, 1, std::string(kMemoryTierSize, 'a'));
+  entry->Close();
+  EXPECT_EQ(0, MemoryTierEntryCount());
+  EXPECT_EQ(1, disk_backend_->GetEntryCount());
+}
+
+TEST_F(TieredBackendTest, WriteUpdatesCopy) {
+  CreateDiskEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ASSERT_EQ(1, MemoryTierEntryCount());
+
+  // Revalidating an entry rewrites its headers.
+  Entry* entry = OpenEntry("key");
+  ASSERT_TRUE(entry);
+  WriteStream(entry, 0, "new headers");
+  EXPECT_EQ(0, MemoryTierEntryCount());
+  EXPECT_EQ("new headers", ReadStream(entry, 0));
+  EXPECT_EQ("body", ReadStream(entry, 1));
+  entry->Close();
+  EXPECT_EQ(1, MemoryTierEntryCount());
+
+  ReadEntry("key", "new headers", "body");
+
+  Entry* disk_entry = NULL;
+  net::TestCompletionCallback cb;
+  ASSERT_EQ(net::OK, cb.GetResult(
+      disk_backend_->OpenEntry("key", &disk_entry, cb.callback())));
+  EXPECT_EQ("new headers", ReadStream(disk_entry, 0));
+  disk_entry->Close();
+}
+
+TEST_F(TieredBackendTest, DoomRemovesCopy) {
+  CreateDiskEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ASSERT_EQ(1, MemoryTierEntryCount());
+
+  net::TestCompletionCallback cb;
+  EXPECT_EQ(net::OK, cb.GetResult(backend_->DoomEntry("key", cb.callback())));
+  EXPECT_EQ(0, MemoryTierEntryCount());
+  EXPECT_EQ(0, disk_backend_->GetEntryCount());
+
+  Entry* entry = NULL;
+  EXPECT_NE(net::OK, cb.GetResult(
+      backend_->OpenEntry("key", &entry, cb.callback())));
+}
+
+TEST_F(TieredBackendTest, CopyOfEvictedEntryIsDropped) {
+  CreateDiskEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ASSERT_EQ(1, MemoryTierEntryCount());
+
+  // The disk backend evicts the entry on its own.
+  net::TestCompletionCallback cb;
+  EXPECT_EQ(net::OK, cb.GetResult(
+      disk_backend_->DoomEntry("key", cb.callback())));
+
+  Entry* entry = NULL;
+  EXPECT_NE(net::OK, cb.GetResult(
+      backend_->OpenEntry("key", &entry, cb.callback())));
+  EXPECT_EQ(0, MemoryTierEntryCount());
+}
+
+TEST_F(TieredBackendTest, CopyOfRewrittenEntryIsDropped) {
+  CreateDiskEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ReadEntry("key", "headers", "body");
+  ASSERT_EQ(1, MemoryTierEntryCount());
+
+  // The disk entry is rewritten behind the tier's back, with data of the same
+  // size, once the clock has moved past the time the copy was made.
+  const base::Time copy_time = base::Time::Now();
+  while (base::Time::Now() <= copy_time) {
+  }
+  Entry* disk_entry = NULL;
+  net::TestCompletionCallback cb;
+  ASSERT_EQ(net::OK, cb.GetResult(
+      disk_backend_->OpenEntry("key", &disk_entry, cb.callback())));
+  WriteStream(disk_entry, 1, "BODY");
+  disk_entry->Close();
+
+  ReadEntry("key", "headers", "BODY");
+}
+
+TEST(TieredBackendCopyTest, CopyMadeAtLastModificationIsCurrent) {
+  const base::Time now = base::Time::Now();
+  EXPECT_TRUE(TieredBackend::IsCopyCurrent(now, now));
+  EXPECT_TRUE(TieredBackend::IsCopyCurrent(
+      now, now - base::TimeDelta::FromMicroseconds(1)));
+}
+
+TEST(TieredBackendCopyTest, CopyOlderThanDiskEntryIsStale) {
+  // A disk entry last modified after the copy was made, which is also what a
+  // clock that went backwards between the two looks like.
+  const base::Time now = base::Time::Now();
+  EXPECT_FALSE(TieredBackend::IsCopyCurrent(
+      now, now + base::TimeDelta::FromMicroseconds(1)));
+  EXPECT_FALSE(TieredBackend::IsCopyCurrent(
+      now - base::TimeDelta::FromHours(1), now));
+}
+
+}  // namespace disk_cache
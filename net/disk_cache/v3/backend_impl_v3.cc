@@ -84,7 +84,9 @@ int BackendImplV3::Init(const CompletionCallback& callback) {
   if (init_)
     return net::ERR_FAILED;
 
-  return net::ERR_IO_PENDING;
+  // The backend can't open a cache yet, so fail right away rather than leave
+  // |callback| pending forever.
+  return net::ERR_NOT_IMPLEMENTED;
 }
 
 // ------------------------------------------------------------------------
@@ -29,6 +29,9 @@ class EntryImplV3;
 
 // This class implements the Backend interface. An object of this
 // class handles the operations of the cache for a particular profile.
+//
+// This backend is still under construction: most of it is compiled out behind
+// V3_NOT_JUST_YET_READY, Init() fails and cache_creator.cc never creates it.
 class NET_EXPORT_PRIVATE BackendImplV3 : public Backend {
  public:
   enum BackendFlags {
@@ -48,6 +51,7 @@ class NET_EXPORT_PRIVATE BackendImplV3 : public Backend {
   virtual ~BackendImplV3();
 
   // Performs general initialization for this current instance of the cache.
+  // Currently always fails with net::ERR_NOT_IMPLEMENTED.
   int Init(const CompletionCallback& callback);
 
   // Same behavior as OpenNextEntry but walks the list from back to front.
@@ -85,6 +85,40 @@ TEST(HostCacheTest, Basic) {
   EXPECT_FALSE(cache.Lookup(key2, now));
 }
 
+// Stale lookups return expired entries until they are too old, and leave them
+// in the cache.
+TEST(HostCacheTest, LookupStale) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  const base::TimeDelta kMaxStaleAge = base::TimeDelta::FromSeconds(20);
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Start at t=0.
+  base::TimeTicks now;
+
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Entry entry = HostCache::Entry(OK, AddressList());
+  cache.Set(key1, entry, now, kTTL);
+
+  bool is_stale = true;
+  EXPECT_TRUE(cache.LookupStale(key1, now, kMaxStaleAge, &is_stale));
+  EXPECT_FALSE(is_stale);
+
+  // Advance to t=15; the entry is expired, but still stale-servable.
+  now += base::TimeDelta::FromSeconds(15);
+
+  EXPECT_TRUE(cache.LookupStale(key1, now, kMaxStaleAge, &is_stale));
+  EXPECT_TRUE(is_stale);
+  EXPECT_EQ(1U, cache.size());
+
+  // Advance to t=30; the entry is too old to serve.
+  now += base::TimeDelta::FromSeconds(15);
+
+  EXPECT_FALSE(cache.LookupStale(key1, now, kMaxStaleAge, &is_stale));
+  EXPECT_FALSE(cache.Lookup(key1, now));
+  EXPECT_EQ(0U, cache.size());
+}
+
 // Try caching entries for a failed resolve attempt -- since we set the TTL of
 // such entries to 0 it won't store, but it will kick out the previous result.
 TEST(HostCacheTest, NoCacheZeroTTL) {
@@ -403,6 +403,9 @@ void LogCancelRequest(const BoundNetLog& source_net_log,
   source_net_log.EndEvent(NetLog::TYPE_HOST_RESOLVER_IMPL);
 }
 
+// Completion callback for the requests that refresh stale cache entries.
+void IgnoreStaleRefreshResult(AddressList* addresses, int result) {}
+
 //-----------------------------------------------------------------------------
 
 // Keeps track of the highest priority.
@@ -1857,6 +1860,11 @@ void HostResolverImpl::SetMaxQueuedJobs(size_t value) {
   max_queued_jobs_ = value;
 }
 
+void HostResolverImpl::SetMaxStaleAge(base::TimeDelta max_stale_age) {
+  DCHECK(max_stale_age >= base::TimeDelta());
+  max_stale_age_ = max_stale_age;
+}
+
 int HostResolverImpl::Resolve(const RequestInfo& info,
                               RequestPriority priority,
                               AddressList* addresses,
@@ -1883,6 +1891,12 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
   Key key = GetEffectiveKeyForRequest(info, request_net_log);
 
   int rv = ResolveHelper(key, info, addresses, request_net_log);
+  if (rv == ERR_DNS_CACHE_MISS &&
+      ServeStaleFromCache(key, info, addresses)) {
+    request_net_log.AddEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_STALE_CACHE_HIT);
+    RefreshStaleEntry(key, info);
+    rv = OK;
+  }
   if (rv != ERR_DNS_CACHE_MISS) {
     LogFinishRequest(source_net_log, request_net_log, info, rv);
     RecordTotalTime(HaveDnsConfig(), info.is_speculative(), base::TimeDelta());
@@ -2056,8 +2070,17 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
   if (!info.allow_cached_response() || !cache_.get())
     return false;
 
-  const HostCache::Entry* cache_entry = cache_->Lookup(
-      key, base::TimeTicks::Now());
+  const HostCache::Entry* cache_entry = NULL;
+  if (max_stale_age_ > base::TimeDelta()) {
+    // Leave expired entries in the cache for ServeStaleFromCache().
+    bool is_stale = false;
+    cache_entry = cache_->LookupStale(
+        key, base::TimeTicks::Now(), max_stale_age_, &is_stale);
+    if (is_stale)
+      return false;
+  } else {
+    cache_entry = cache_->Lookup(key, base::TimeTicks::Now());
+  }
   if (!cache_entry)
     return false;
 
@@ -2070,6 +2093,43 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
   return true;
 }
 
+bool HostResolverImpl::ServeStaleFromCache(const Key& key,
+                                           const RequestInfo& info,
+                                           AddressList* addresses) {
+  DCHECK(addresses);
+  if (max_stale_age_ == base::TimeDelta() || !info.allow_cached_response() ||
+      !cache_.get()) {
+    return false;
+  }
+
+  bool is_stale = false;
+  const HostCache::Entry* cache_entry = cache_->LookupStale(
+      key, base::TimeTicks::Now(), max_stale_age_, &is_stale);
+  // Failures are not served stale, so that they are retried promptly.
+  if (!cache_entry || !is_stale || cache_entry->error != OK)
+    return false;
+
+  *addresses = EnsurePortOnAddressList(cache_entry->addrlist, info.port());
+  return true;
+}
+
+void HostResolverImpl::RefreshStaleEntry(const Key& key,
+                                         const RequestInfo& info) {
+  if (jobs_.count(key))
+    return;
+
+  RequestInfo refresh_info(info);
+  refresh_info.set_allow_cached_response(false);
+  refresh_info.set_is_speculative(true);
+
+  // The job caches its result; the refreshed addresses themselves are not
+  // needed, so they are owned by the callback and dropped with it.
+  AddressList* addresses = new AddressList();
+  Resolve(refresh_info, IDLE, addresses,
+          base::Bind(&IgnoreStaleRefreshResult, base::Owned(addresses)),
+          NULL, BoundNetLog());
+}
+
 bool HostResolverImpl::ServeFromHosts(const Key& key,
                                       const RequestInfo& info,
                                       AddressList* addresses) {
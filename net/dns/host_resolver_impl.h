@@ -123,6 +123,11 @@ class NET_EXPORT HostResolverImpl
   // Only allowed when the queue is empty.
   void SetMaxQueuedJobs(size_t value);
 
+  // Configures how long after expiring a positive cache entry may still be
+  // used to answer Resolve() immediately, while a background job refreshes
+  // it. Zero, the default, disables serving stale entries.
+  void SetMaxStaleAge(base::TimeDelta max_stale_age);
+
   // Set the DnsClient to be used for resolution. In case of failure, the
   // HostResolverProc from ProcTaskParams will be queried. If the DnsClient is
   // not pre-configured with a valid DnsConfig, a new config is fetched from
@@ -185,6 +190,17 @@ class NET_EXPORT HostResolverImpl
                       int* net_error,
                       AddressList* addresses);
 
+  // If serving stale entries is enabled and |key| has an expired positive
+  // entry in cache that is not too old, returns true and fills |addresses|.
+  // Otherwise returns false.
+  bool ServeStaleFromCache(const Key& key,
+                           const RequestInfo& info,
+                           AddressList* addresses);
+
+  // Unless a job for |key| is already running, starts a speculative request
+  // that bypasses the cache, so that its result replaces the stale entry.
+  void RefreshStaleEntry(const Key& key, const RequestInfo& info);
+
   // If we have a DnsClient with a valid DnsConfig, and |key| is found in the
   // HOSTS file, returns true and fills |addresses|. Otherwise returns false.
   bool ServeFromHosts(const Key& key,
@@ -253,6 +269,9 @@ class NET_EXPORT HostResolverImpl
   // Limit on the maximum number of jobs queued in |dispatcher_|.
   size_t max_queued_jobs_;
 
+  // How long after expiring a cache entry may be served. See SetMaxStaleAge.
+  base::TimeDelta max_stale_age_;
+
   // Parameters for ProcTask.
   ProcTaskParams proc_params_;
 
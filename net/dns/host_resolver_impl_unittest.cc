@@ -22,6 +22,7 @@
 #include "net/base/address_list.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_util.h"
+#include "net/base/test_completion_callback.h"
 #include "net/dns/dns_client.h"
 #include "net/dns/dns_test_util.h"
 #include "net/dns/host_cache.h"
@@ -1252,6 +1253,86 @@ TEST_F(HostResolverImplTest, ResolveFromCache) {
   EXPECT_TRUE(requests_[2]->HasOneAddress("192.168.1.42", 80));
 }
 
+// Test that an expired entry is served while it is refreshed in the background.
+TEST_F(HostResolverImplTest, ServeStaleWhileRefreshing) {
+  resolver_->SetMaxStaleAge(base::TimeDelta::FromMinutes(5));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  // Make the cached entry expire a minute ago.
+  HostCache* cache = resolver_->GetHostCache();
+  ASSERT_EQ(1u, cache->size());
+  HostCache::EntryMap::Iterator it(cache->entries());
+  HostCache::Key key = it.key();
+  HostCache::Entry entry = it.value();
+  cache->Set(key, entry,
+             base::TimeTicks::Now() - base::TimeDelta::FromMinutes(2),
+             base::TimeDelta::FromMinutes(1));
+
+  // The stale entry completes synchronously and starts a refresh.
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 80));
+  EXPECT_TRUE(proc_->WaitFor(1u));
+
+  // A request that bypasses the cache joins the refresh.
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 80));
+  info.set_allow_cached_response(false);
+  req = CreateRequest(info, DEFAULT_PRIORITY);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 80));
+
+  // The refreshed entry replaced the stale one.
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 80));
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+}
+
+// Test that CreateSystemResolver() passes |max_stale_age| on.
+TEST(HostResolverTest, SystemResolverServesStale) {
+  scoped_refptr<RuleBasedHostResolverProc> proc(
+      new RuleBasedHostResolverProc(NULL));
+  proc->AddRule("just.testing", "192.168.1.42");
+  ScopedDefaultHostResolverProc scoped_proc(proc.get());
+
+  HostResolver::Options options;
+  options.max_stale_age = base::TimeDelta::FromMinutes(5);
+  scoped_ptr<HostResolver> resolver(
+      HostResolver::CreateSystemResolver(options, NULL));
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 80));
+  AddressList addresses;
+  TestCompletionCallback callback;
+  HostResolver::RequestHandle handle = NULL;
+  int rv = resolver->Resolve(info, DEFAULT_PRIORITY, &addresses,
+                             callback.callback(), &handle, BoundNetLog());
+  EXPECT_EQ(OK, callback.GetResult(rv));
+
+  // Make the cached entry expire a minute ago.
+  HostCache* cache = resolver->GetHostCache();
+  ASSERT_EQ(1u, cache->size());
+  HostCache::EntryMap::Iterator it(cache->entries());
+  HostCache::Key key = it.key();
+  HostCache::Entry entry = it.value();
+  cache->Set(key, entry,
+             base::TimeTicks::Now() - base::TimeDelta::FromMinutes(2),
+             base::TimeDelta::FromMinutes(1));
+
+  addresses = AddressList();
+  EXPECT_EQ(OK, resolver->Resolve(info, DEFAULT_PRIORITY, &addresses,
+                                  callback.callback(), &handle,
+                                  BoundNetLog()));
+  ASSERT_EQ(1u, addresses.size());
+  EXPECT_EQ("192.168.1.42:80", addresses.front().ToString());
+}
+
 // Test the retry attempts simulating host resolver proc that takes too long.
 TEST_F(HostResolverImplTest, MultipleAttempts) {
   // Total number of attempts would be 3 and we want the 3rd attempt to resolve
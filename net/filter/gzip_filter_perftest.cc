@@ -0,0 +1,115 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "net/base/io_buffer.h"
+#include "net/filter/filter.h"
+#include "net/filter/mock_filter_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+namespace net {
+
+namespace {
+
+const int kOutputBufferSize = 32 * 1024;
+
+// Builds |size| bytes of markup that compresses about as well as a typical
+// HTML page.
+std::string MakeBody(size_t size) {
+  std::string body;
+  body.reserve(size + 128);
+  for (int i = 0; body.size() < size; ++i) {
+    body += base::StringPrintf(
+        "<div class=\"item item-%d\"><a href=\"/articles/%d?ref=list\">"
+        "Article number %d</a><span class=\"meta\">%d comments</span></div>\n",
+        i % 7, i, i, (i * 31) % 101);
+  }
+  body.resize(size);
+  return body;
+}
+
+// Compresses |input| with a gzip wrapper (windowBits 16 + MAX_WBITS).
+std::string GZipCompress(const std::string& input) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                               16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+  std::string output(deflateBound(&stream, input.size()) + 32, '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  stream.avail_in = input.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+  stream.avail_out = output.size();
+  EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+  return output;
+}
+
+// Runs |encoded| through a new gzip filter the way URLRequestJob does, and
+// returns the number of decoded bytes.
+size_t DecodeWithFilter(const std::string& encoded,
+                        MockFilterContext* filter_context,
+                        char* output_buffer) {
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(Filter::FILTER_TYPE_GZIP);
+  scoped_ptr<Filter> filter(Filter::Factory(filter_types, *filter_context));
+  EXPECT_TRUE(filter.get());
+
+  size_t decoded = 0;
+  size_t offset = 0;
+  Filter::FilterStatus status = Filter::FILTER_NEED_MORE_DATA;
+  while (status != Filter::FILTER_DONE && status != Filter::FILTER_ERROR) {
+    if (status == Filter::FILTER_NEED_MORE_DATA) {
+      if (offset == encoded.size())
+        break;
+      int chunk = std::min(static_cast<int>(encoded.size() - offset),
+                           filter->stream_buffer_size());
+      memcpy(filter->stream_buffer()->data(), encoded.data() + offset, chunk);
+      filter->FlushStreamBuffer(chunk);
+      offset += chunk;
+    }
+    int output_len = kOutputBufferSize;
+    status = filter->ReadData(output_buffer, &output_len);
+    decoded += output_len;
+  }
+  EXPECT_EQ(Filter::FILTER_DONE, status);
+  return decoded;
+}
+
+void RunDecodeTest(const char* name, size_t body_size, int iterations) {
+  std::string body = MakeBody(body_size);
+  std::string encoded = GZipCompress(body);
+  MockFilterContext filter_context;
+  scoped_ptr<char[]> output_buffer(new char[kOutputBufferSize]);
+
+  base::PerfTimeLogger timer(name);
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_EQ(body.size(), DecodeWithFilter(encoded, &filter_context,
+                                            output_buffer.get()));
+  }
+  timer.Done();
+}
+
+}  // namespace
+
+// Many small responses: dominated by per-filter setup (z_stream allocation,
+// inflateInit2 and header parsing).
+TEST(GZipFilterPerfTest, DecodeSmallResponses) {
+  RunDecodeTest("GZipFilter_decode_2KB_x20000", 2 * 1024, 20000);
+}
+
+// A few large responses: dominated by inflate throughput and the copy from
+// the network read buffer into the filter's stream buffer.
+TEST(GZipFilterPerfTest, DecodeLargeResponses) {
+  RunDecodeTest("GZipFilter_decode_4MB_x20", 4 * 1024 * 1024, 20);
+}
+
+}  // namespace net
@@ -33,6 +33,7 @@
 #include "net/base/net_errors.h"
 #include "net/base/upload_data_stream.h"
 #include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/tiered_backend.h"
 #include "net/http/disk_cache_based_quic_server_info.h"
 #include "net/http/http_cache_transaction.h"
 #include "net/http/http_network_layer.h"
@@ -50,6 +51,26 @@ void DeletePath(base::FilePath path) {
   base::DeleteFile(path, false);
 }
 
+// Puts a memory tier of |memory_tier_bytes| in front of |disk_backend|.
+void WrapInMemoryTier(int memory_tier_bytes,
+                      net::NetLog* net_log,
+                      scoped_ptr<disk_cache::Backend>* disk_backend,
+                      scoped_ptr<disk_cache::Backend>* backend) {
+  backend->reset(new disk_cache::TieredBackend(
+      disk_backend->Pass(), memory_tier_bytes, net_log));
+}
+
+void OnDiskBackendCreated(int memory_tier_bytes,
+                          net::NetLog* net_log,
+                          scoped_ptr<disk_cache::Backend>* disk_backend,
+                          scoped_ptr<disk_cache::Backend>* backend,
+                          const net::CompletionCallback& callback,
+                          int result) {
+  if (result == net::OK)
+    WrapInMemoryTier(memory_tier_bytes, net_log, disk_backend, backend);
+  callback.Run(result);
+}
+
 }  // namespace
 
 namespace net {
@@ -63,6 +84,7 @@ HttpCache::DefaultBackend::DefaultBackend(CacheType type,
       backend_type_(backend_type),
       path_(path),
       max_bytes_(max_bytes),
+      memory_tier_bytes_(0),
       thread_(thread) {
 }
 
@@ -78,15 +100,37 @@ int HttpCache::DefaultBackend::CreateBackend(
     NetLog* net_log, scoped_ptr<disk_cache::Backend>* backend,
     const CompletionCallback& callback) {
   DCHECK_GE(max_bytes_, 0);
-  return disk_cache::CreateCacheBackend(type_,
-                                        backend_type_,
-                                        path_,
-                                        max_bytes_,
-                                        true,
-                                        thread_.get(),
-                                        net_log,
-                                        backend,
-                                        callback);
+  if (!memory_tier_bytes_ || type_ == MEMORY_CACHE) {
+    return disk_cache::CreateCacheBackend(type_,
+                                          backend_type_,
+                                          path_,
+                                          max_bytes_,
+                                          true,
+                                          thread_.get(),
+                                          net_log,
+                                          backend,
+                                          callback);
+  }
+
+  // |disk_callback| owns |disk_backend|, and keeps it alive if the backend is
+  // created synchronously.
+  scoped_ptr<disk_cache::Backend>* disk_backend =
+      new scoped_ptr<disk_cache::Backend>;
+  CompletionCallback disk_callback =
+      base::Bind(&OnDiskBackendCreated, memory_tier_bytes_, net_log,
+                 base::Owned(disk_backend), backend, callback);
+  int rv = disk_cache::CreateCacheBackend(type_,
+                                          backend_type_,
+                                          path_,
+                                          max_bytes_,
+                                          true,
+                                          thread_.get(),
+                                          net_log,
+                                          disk_backend,
+                                          disk_callback);
+  if (rv == OK)
+    WrapInMemoryTier(memory_tier_bytes_, net_log, disk_backend, backend);
+  return rv;
 }
 
 //-----------------------------------------------------------------------------
@@ -290,6 +334,7 @@ HttpCache::HttpCache(const net::HttpNetworkSession::Params& params,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      bypass_lock_for_test_(false),
       quic_server_info_factory_(new QuicServerInfoFactoryAdaptor(this)),
       network_layer_(new HttpNetworkLayer(new HttpNetworkSession(params))) {
 }
@@ -301,6 +346,7 @@ HttpCache::HttpCache(HttpNetworkSession* session,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      bypass_lock_for_test_(false),
       quic_server_info_factory_(new QuicServerInfoFactoryAdaptor(this)),
       network_layer_(new HttpNetworkLayer(session)) {
 }
@@ -312,6 +358,7 @@ HttpCache::HttpCache(HttpTransactionFactory* network_layer,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      bypass_lock_for_test_(false),
       network_layer_(network_layer) {
 }
 
@@ -107,6 +107,11 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
     // Returns a factory for an in-memory cache.
     static BackendFactory* InMemory(int max_bytes);
 
+    // Keeps copies of small entries that were just written or are read often
+    // in up to |bytes| of memory, in front of the disk cache, so that reading
+    // them doesn't wait for the disk. See disk_cache::TieredBackend.
+    void set_memory_tier_size(int bytes) { memory_tier_bytes_ = bytes; }
+
     // BackendFactory implementation.
     virtual int CreateBackend(NetLog* net_log,
                               scoped_ptr<disk_cache::Backend>* backend,
@@ -117,6 +122,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
     BackendType backend_type_;
     const base::FilePath path_;
     int max_bytes_;
+    int memory_tier_bytes_;
     scoped_refptr<base::MessageLoopProxy> thread_;
   };
 
@@ -203,6 +209,12 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
       SetHttpNetworkTransactionFactoryForTesting(
           scoped_ptr<HttpTransactionFactory> new_network_layer);
 
+  // Makes transactions give up waiting for an entry that is in use right away,
+  // instead of after the cache lock timeout.
+  void BypassLockForTest() {
+    bypass_lock_for_test_ = true;
+  }
+
  protected:
   // Disk cache entry data indices.
   enum {
@@ -390,6 +402,9 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
 
   Mode mode_;
 
+  // True if the cache lock timeout fires as soon as a transaction has to wait.
+  bool bypass_lock_for_test_;
+
   const scoped_ptr<QuicServerInfoFactoryAdaptor> quic_server_info_factory_;
 
   scoped_ptr<HttpTransactionFactory> network_layer_;
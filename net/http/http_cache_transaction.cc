@@ -16,6 +16,7 @@
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/sparse_histogram.h"
@@ -47,6 +48,10 @@ using base::TimeTicks;
 
 namespace {
 
+// How long a transaction waits for a cache entry that another transaction is
+// using before sending its request to the network without the cache.
+const int kCacheLockTimeoutSecs = 20;
+
 // From http://tools.ietf.org/html/draft-ietf-httpbis-p6-cache-21#section-6
 //      a "non-error response" is one with a 2xx (Successful) or 3xx
 //      (Redirection) status code.
@@ -1197,7 +1202,19 @@ int HttpCache::Transaction::DoAddToEntry() {
   net_log_.BeginEvent(NetLog::TYPE_HTTP_CACHE_ADD_TO_ENTRY);
   DCHECK(entry_lock_waiting_since_.is_null());
   entry_lock_waiting_since_ = TimeTicks::Now();
-  return cache_->AddTransactionToEntry(new_entry_, this);
+  int rv = cache_->AddTransactionToEntry(new_entry_, this);
+  if (rv == ERR_IO_PENDING) {
+    // Don't wait for a slow writer indefinitely: the network is likely to be
+    // faster than waiting for the whole response to be cached.
+    TimeDelta timeout = cache_->bypass_lock_for_test_ ?
+        TimeDelta() : TimeDelta::FromSeconds(kCacheLockTimeoutSecs);
+    base::MessageLoop::current()->PostDelayedTask(
+        FROM_HERE,
+        base::Bind(&HttpCache::Transaction::OnAddToEntryTimeout,
+                   weak_factory_.GetWeakPtr(), entry_lock_waiting_since_),
+        timeout);
+  }
+  return rv;
 }
 
 int HttpCache::Transaction::DoAddToEntryComplete(int result) {
@@ -1222,6 +1239,21 @@ int HttpCache::Transaction::DoAddToEntryComplete(int result) {
     return OK;
   }
 
+  if (result == ERR_CACHE_LOCK_TIMEOUT) {
+    // A transaction that can only read has nowhere else to go.
+    if (mode_ == READ)
+      return ERR_CACHE_MISS;
+
+    // The cache is busy, bypass it for this transaction.
+    mode_ = NONE;
+    if (partial_.get()) {
+      partial_->RestoreHeaders(&custom_request_->extra_headers);
+      partial_.reset();
+    }
+    next_state_ = STATE_SEND_REQUEST;
+    return OK;
+  }
+
   if (result != OK) {
     NOTREACHED();
     return result;
@@ -2519,6 +2551,19 @@ void HttpCache::Transaction::RecordHistograms() {
   }
 }
 
+void HttpCache::Transaction::OnAddToEntryTimeout(base::TimeTicks start_time) {
+  // We may have received the entry already, or be waiting for another one.
+  if (entry_lock_waiting_since_ != start_time)
+    return;
+
+  DCHECK_EQ(STATE_ADD_TO_ENTRY_COMPLETE, next_state_);
+  if (!cache_.get())
+    return;
+
+  cache_->RemovePendingTransaction(this);
+  OnIOComplete(ERR_CACHE_LOCK_TIMEOUT);
+}
+
 void HttpCache::Transaction::OnIOComplete(int result) {
   DoLoop(result);
 }
@@ -382,6 +382,10 @@ class HttpCache::Transaction : public HttpTransaction {
   // Called to signal completion of asynchronous IO.
   void OnIOComplete(int result);
 
+  // Gives up waiting for the entry that was requested at |start_time|, if it
+  // hasn't been made available to this transaction yet.
+  void OnAddToEntryTimeout(base::TimeTicks start_time);
+
   State next_state_;
   const HttpRequestInfo* request_;
   RequestPriority priority_;
@@ -1305,6 +1305,65 @@ TEST(HttpCache, SimpleGET_ManyReaders) {
   }
 }
 
+// Tests that a (simulated) timeout allows transactions waiting on the cache
+// lock to continue.
+TEST(HttpCache, SimpleGET_WriterTimeout) {
+  MockHttpCache cache;
+  cache.BypassCacheLock();
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+  Context c1, c2;
+  ASSERT_EQ(net::OK, cache.CreateTransaction(&c1.trans));
+  ASSERT_EQ(net::ERR_IO_PENDING,
+            c1.trans->Start(&request, c1.callback.callback(),
+                            net::BoundNetLog()));
+  ASSERT_EQ(net::OK, cache.CreateTransaction(&c2.trans));
+  ASSERT_EQ(net::ERR_IO_PENDING,
+            c2.trans->Start(&request, c2.callback.callback(),
+                            net::BoundNetLog()));
+
+  // The second request is queued after the first one, and goes to the network
+  // when the timeout fires.
+  EXPECT_EQ(net::OK, c2.callback.WaitForResult());
+  ReadAndVerifyTransaction(c2.trans.get(), kSimpleGET_Transaction);
+
+  // Complete the first transaction.
+  EXPECT_EQ(net::OK, c1.callback.WaitForResult());
+  ReadAndVerifyTransaction(c1.trans.get(), kSimpleGET_Transaction);
+
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
+// Tests that a transaction that can only read from the cache fails when the
+// cache lock timeout fires.
+TEST(HttpCache, SimpleGET_WriterTimeoutOnlyFromCache) {
+  MockHttpCache cache;
+  cache.BypassCacheLock();
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.load_flags |= net::LOAD_ONLY_FROM_CACHE;
+  MockHttpRequest reader_request(transaction);
+
+  Context c1, c2;
+  ASSERT_EQ(net::OK, cache.CreateTransaction(&c1.trans));
+  ASSERT_EQ(net::ERR_IO_PENDING,
+            c1.trans->Start(&request, c1.callback.callback(),
+                            net::BoundNetLog()));
+  EXPECT_EQ(net::OK, c1.callback.WaitForResult());
+
+  ASSERT_EQ(net::OK, cache.CreateTransaction(&c2.trans));
+  ASSERT_EQ(net::ERR_IO_PENDING,
+            c2.trans->Start(&reader_request, c2.callback.callback(),
+                            net::BoundNetLog()));
+  EXPECT_EQ(net::ERR_CACHE_MISS, c2.callback.WaitForResult());
+
+  ReadAndVerifyTransaction(c1.trans.get(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+}
+
 // This is a test for http://code.google.com/p/chromium/issues/detail?id=4769.
 // If cancelling a request is racing with another request for the same resource
 // finishing, we have to make sure that we remove both transactions from the
@@ -69,32 +69,43 @@ HttpChunkedDecoder::HttpChunkedDecoder()
 int HttpChunkedDecoder::FilterBuf(char* buf, int buf_len) {
   int result = 0;
 
+  // The decoded data is compacted towards the start of |buf| as chunk markers
+  // are skipped, so that each byte is moved at most once however many chunks
+  // the buffer holds.
+  const char* in = buf;
+  char* out = buf;
+
   while (buf_len) {
     if (chunk_remaining_) {
       int num = std::min(chunk_remaining_, buf_len);
+      if (out != in)
+        memmove(out, in, num);
 
       buf_len -= num;
       chunk_remaining_ -= num;
 
       result += num;
-      buf += num;
+      in += num;
+      out += num;
 
       // After each chunk's data there should be a CRLF
       if (!chunk_remaining_)
         chunk_terminator_remaining_ = true;
       continue;
     } else if (reached_eof_) {
+      // Keep the extra data right after the decoded data.
+      if (out != in)
+        memmove(out, in, buf_len);
       bytes_after_eof_ += buf_len;
       break;  // Done!
     }
 
-    int bytes_consumed = ScanForChunkRemaining(buf, buf_len);
+    int bytes_consumed = ScanForChunkRemaining(in, buf_len);
     if (bytes_consumed < 0)
       return bytes_consumed; // Error
 
     buf_len -= bytes_consumed;
-    if (buf_len)
-      memmove(buf, buf + bytes_consumed, buf_len);
+    in += bytes_consumed;
   }
 
   return result;
@@ -93,7 +93,8 @@ class NET_EXPORT_PRIVATE HttpChunkedDecoder {
   // file.  This method modifies |buf| inline if necessary to remove chunk
   // markers.  The return value indicates the final size of decoded data stored
   // in |buf|.  Call reached_eof() after this method to check if end-of-file
-  // was encountered.
+  // was encountered.  Any data after end-of-file follows the decoded data in
+  // |buf|.
   int FilterBuf(char* buf, int buf_len);
 
  private:
@@ -324,6 +324,19 @@ TEST(HttpChunkedDecoderTest, MultipleExtraDataBlocks) {
   RunTest(inputs, arraysize(inputs), "hello", true, 11);
 }
 
+// The extra data after the last chunk should be right after the decoded data,
+// also when many chunks come in the same buffer.
+TEST(HttpChunkedDecoderTest, ExtraDataFollowsDecodedData) {
+  HttpChunkedDecoder decoder;
+  std::string input = "5\r\nhello\r\n1\r\n \r\n5\r\nworld\r\n0\r\n\r\nextra";
+  int n = decoder.FilterBuf(&input[0], static_cast<int>(input.size()));
+  ASSERT_EQ(11, n);
+  EXPECT_TRUE(decoder.reached_eof());
+  EXPECT_EQ(5, decoder.bytes_after_eof());
+  EXPECT_EQ("hello world", input.substr(0, n));
+  EXPECT_EQ("extra", input.substr(n, decoder.bytes_after_eof()));
+}
+
 // Test when the line with the chunk length is too long.
 TEST(HttpChunkedDecoderTest, LongChunkLengthLine) {
   int big_chunk_length = HttpChunkedDecoder::kMaxLineBufLen;
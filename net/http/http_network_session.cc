@@ -84,6 +84,7 @@ HttpNetworkSession::Params::Params()
       enable_quic(false),
       enable_quic_https(false),
       enable_quic_port_selection(true),
+      enable_quic_pacing(false),
       quic_clock(NULL),
       quic_random(NULL),
       quic_max_packet_length(kDefaultMaxPacketSize),
@@ -121,7 +122,8 @@ HttpNetworkSession::HttpNetworkSession(const Params& params)
                                new QuicClock(),
                            params.quic_max_packet_length,
                            params.quic_supported_versions,
-                           params.enable_quic_port_selection),
+                           params.enable_quic_port_selection,
+                           params.enable_quic_pacing),
       spdy_session_pool_(params.host_resolver,
                          params.ssl_config_service,
                          params.http_server_properties,
@@ -206,6 +208,7 @@ base::Value* HttpNetworkSession::QuicInfoToValue() const {
   dict->SetBoolean("quic_enabled_https", params_.enable_quic_https);
   dict->SetBoolean("enable_quic_port_selection",
                    params_.enable_quic_port_selection);
+  dict->SetBoolean("enable_quic_pacing", params_.enable_quic_pacing);
   dict->SetString("origin_to_force_quic_on",
                   params_.origin_to_force_quic_on.ToString());
   return dict;
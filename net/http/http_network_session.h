@@ -91,6 +91,7 @@ class NET_EXPORT HttpNetworkSession
     bool enable_quic;
     bool enable_quic_https;
     bool enable_quic_port_selection;
+    bool enable_quic_pacing;
     HostPortPair origin_to_force_quic_on;
     QuicClock* quic_clock;  // Will be owned by QuicStreamFactory.
     QuicRandom* quic_random;
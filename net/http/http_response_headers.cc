@@ -376,6 +376,9 @@ void HttpResponseHeaders::ReplaceStatusLine(const std::string& new_status) {
 
 void HttpResponseHeaders::Parse(const std::string& raw_input) {
   raw_headers_.reserve(raw_input.size());
+  // Each header line is null-terminated, so this sizes parsed_ for the usual
+  // case of one value per line and avoids regrowing it while parsing.
+  parsed_.reserve(std::count(raw_input.begin(), raw_input.end(), '\0'));
 
   // ParseStatusLine adds a normalized status line to raw_headers_
   std::string::const_iterator line_begin = raw_input.begin();
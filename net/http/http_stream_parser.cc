@@ -23,6 +23,10 @@ namespace {
 
 const size_t kMaxMergedHeaderAndBodySize = 1400;
 const size_t kRequestBodyBufferSize = 1 << 14;  // 16KB
+// Request bodies of known size larger than kRequestBodyBufferSize get a
+// buffer of up to this size, so that large uploads need fewer round trips
+// between the upload reader and the socket.
+const size_t kMaxRequestBodyBufferSize = 1 << 18;  // 256KB
 
 std::string GetResponseHeaderLines(const net::HttpResponseHeaders& headers) {
   std::string raw_headers = headers.raw_headers();
@@ -225,7 +229,15 @@ int HttpStreamParser::SendRequest(const std::string& request_line,
   std::string request = request_line + headers.ToString();
 
   if (request_->upload_data_stream != NULL) {
-    request_body_send_buf_ = new SeekableIOBuffer(kRequestBodyBufferSize);
+    size_t body_buffer_size = kRequestBodyBufferSize;
+    if (!request_->upload_data_stream->is_chunked()) {
+      body_buffer_size = std::max(
+          kRequestBodyBufferSize,
+          static_cast<size_t>(std::min<uint64>(
+              request_->upload_data_stream->size(),
+              kMaxRequestBodyBufferSize)));
+    }
+    request_body_send_buf_ = new SeekableIOBuffer(body_buffer_size);
     if (request_->upload_data_stream->is_chunked()) {
       // Read buffer is adjusted to guarantee that |request_body_send_buf_| is
       // large enough to hold the encoded chunk.
@@ -177,6 +177,9 @@ class MockHttpCache {
   // Wrapper around http_cache()->CreateTransaction(net::DEFAULT_PRIORITY...)
   int CreateTransaction(scoped_ptr<net::HttpTransaction>* trans);
 
+  // Wrapper to bypass the cache lock for new transactions.
+  void BypassCacheLock();
+
   // Helper function for reading response info from the disk cache.
   static bool ReadResponseInfo(disk_cache::Entry* disk_entry,
                                net::HttpResponseInfo* response_info,
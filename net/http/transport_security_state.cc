@@ -759,22 +759,19 @@ bool TransportSecurityState::GetStaticDomainState(
   out->sts_include_subdomains = false;
   out->pkp_include_subdomains = false;
 
-  const bool is_build_timely = IsBuildTimely();
+  if (!IsBuildTimely())
+    return false;
 
   for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    std::string host_sub_chunk(&canonicalized_host[i],
-                               canonicalized_host.size() - i);
-    out->domain = DNSDomainToString(host_sub_chunk);
     bool ret;
-    if (is_build_timely &&
-        HasPreload(kPreloadedSTS, kNumPreloadedSTS, canonicalized_host, i, out,
-                   &ret)) {
-      return ret;
-    }
-    if (sni_enabled &&
-        is_build_timely &&
-        HasPreload(kPreloadedSNISTS, kNumPreloadedSNISTS, canonicalized_host, i,
-                   out, &ret)) {
+    // Only the matching suffix is converted back to a dotted domain, rather
+    // than building a string for every label that is tried.
+    if (HasPreload(kPreloadedSTS, kNumPreloadedSTS, canonicalized_host, i, out,
+                   &ret) ||
+        (sni_enabled &&
+         HasPreload(kPreloadedSNISTS, kNumPreloadedSNISTS, canonicalized_host,
+                    i, out, &ret))) {
+      out->domain = DNSDomainToString(canonicalized_host.substr(i));
       return ret;
     }
   }
@@ -812,6 +812,11 @@ class ProxyService::PacRequest
   int QueryDidComplete(int result_code) {
     DCHECK(!was_cancelled());
 
+    // |config_id_| is only set once the request was started on the
+    // resolver, so this skips results that were completed synchronously.
+    if (result_code == OK && config_id_ != ProxyConfig::kInvalidConfigID)
+      service_->AddToPacResultCache(url_, *results_);
+
     // Note that DidFinishResolvingProxy might modify |results_|.
     int rv = service_->DidFinishResolvingProxy(results_, result_code, net_log_);
 
@@ -1032,8 +1037,20 @@ int ProxyService::TryToCompleteSynchronously(const GURL& url,
   if (permanent_error_ != OK)
     return permanent_error_;
 
-  if (config_.HasAutomaticSettings())
-    return ERR_IO_PENDING;  // Must submit the request to the proxy resolver.
+  if (config_.HasAutomaticSettings()) {
+    const ProxyInfo* cached_result = pac_result_cache_ ?
+        pac_result_cache_->Get(url.GetOrigin().spec(), TimeTicks::Now()) :
+        NULL;
+    if (!cached_result)
+      return ERR_IO_PENDING;  // Must submit the request to the proxy resolver.
+    result->Use(*cached_result);
+    result->config_source_ = config_.source();
+    result->config_id_ = config_.id();
+    result->did_use_pac_script_ = true;
+    result->proxy_resolve_start_time_ = TimeTicks::Now();
+    result->proxy_resolve_end_time_ = result->proxy_resolve_start_time_;
+    return OK;
+  }
 
   // Use the manual proxy settings.
   config_.proxy_rules().Apply(url, result);
@@ -1042,6 +1059,15 @@ int ProxyService::TryToCompleteSynchronously(const GURL& url,
   return OK;
 }
 
+void ProxyService::AddToPacResultCache(const GURL& url,
+                                       const ProxyInfo& result) {
+  if (!pac_result_cache_)
+    return;
+  TimeTicks now = TimeTicks::Now();
+  pac_result_cache_->Put(url.GetOrigin().spec(), result, now,
+                         now + pac_result_cache_ttl_);
+}
+
 ProxyService::~ProxyService() {
   NetworkChangeNotifier::RemoveIPAddressObserver(this);
   NetworkChangeNotifier::RemoveDNSObserver(this);
@@ -1317,12 +1343,21 @@ ProxyScriptFetcher* ProxyService::GetProxyScriptFetcher() const {
   return proxy_script_fetcher_.get();
 }
 
+void ProxyService::EnablePacResultCache(size_t max_entries,
+                                        base::TimeDelta ttl) {
+  DCHECK(CalledOnValidThread());
+  pac_result_cache_.reset(new PacResultCache(max_entries));
+  pac_result_cache_ttl_ = ttl;
+}
+
 ProxyService::State ProxyService::ResetProxyConfig(bool reset_fetched_config) {
   DCHECK(CalledOnValidThread());
   State previous_state = current_state_;
 
   permanent_error_ = OK;
   proxy_retry_info_.clear();
+  if (pac_result_cache_)
+    pac_result_cache_->Clear();
   script_poller_.reset();
   init_proxy_resolver_.reset();
   SuspendAllPendingRequests();
@@ -14,6 +14,7 @@
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/non_thread_safe.h"
 #include "net/base/completion_callback.h"
+#include "net/base/expiring_cache.h"
 #include "net/base/load_states.h"
 #include "net/base/net_export.h"
 #include "net/base/net_log.h"
@@ -269,6 +270,18 @@ class NET_EXPORT ProxyService : public NetworkChangeNotifier::IPAddressObserver,
 
   bool quick_check_enabled() const { return quick_check_enabled_; }
 
+  // Enables caching of PAC script results by the scheme, host and port of the
+  // URL being resolved, holding up to |max_entries| results for |ttl| each.
+  // This is only correct for PAC scripts whose FindProxyForURL() decisions do
+  // not depend on the path or query of the URL, which is why it is off by
+  // default. Cached results are dropped whenever the proxy configuration is
+  // reset, including after IP address and DNS changes.
+  void EnablePacResultCache(size_t max_entries, base::TimeDelta ttl);
+
+  bool pac_result_cache_enabled() const {
+    return pac_result_cache_.get() != NULL;
+  }
+
 #if defined(SPDY_PROXY_AUTH_ORIGIN)
   // Values of the UMA DataReductionProxy.BypassInfo{Primary|Fallback}
   // histograms. This enum must remain synchronized with the enum of the same
@@ -339,9 +352,13 @@ class NET_EXPORT ProxyService : public NetworkChangeNotifier::IPAddressObserver,
 
   // Returns ERR_IO_PENDING if the request cannot be completed synchronously.
   // Otherwise it fills |result| with the proxy information for |url|.
-  // Completing synchronously means we don't need to query ProxyResolver.
+  // Completing synchronously means we don't need to query ProxyResolver,
+  // either because of manual settings or a hit in |pac_result_cache_|.
   int TryToCompleteSynchronously(const GURL& url, ProxyInfo* result);
 
+  // Adds the PAC script result for |url| to |pac_result_cache_|, if enabled.
+  void AddToPacResultCache(const GURL& url, const ProxyInfo& result);
+
   // Cancels all of the requests sent to the ProxyResolver. These will be
   // restarted when calling SetReady().
   void SuspendAllPendingRequests();
@@ -447,6 +464,13 @@ class NET_EXPORT ProxyService : public NetworkChangeNotifier::IPAddressObserver,
   // Whether child ProxyScriptDeciders should use QuickCheck
   bool quick_check_enabled_;
 
+  // PAC script results keyed by the origin of the resolved URL. NULL unless
+  // EnablePacResultCache() was called.
+  typedef ExpiringCache<std::string, ProxyInfo, base::TimeTicks,
+                        std::less<base::TimeTicks> > PacResultCache;
+  scoped_ptr<PacResultCache> pac_result_cache_;
+  base::TimeDelta pac_result_cache_ttl_;
+
   DISALLOW_COPY_AND_ASSIGN(ProxyService);
 };
 
@@ -12,6 +12,8 @@
 
 #if defined(USE_OPENSSL)
 #include "net/quic/crypto/scoped_evp_aead_ctx.h"
+#else
+#include "crypto/scoped_nss_types.h"
 #endif
 
 namespace net {
@@ -47,9 +49,12 @@ class NET_EXPORT_PRIVATE Aes128Gcm12Decrypter : public QuicDecrypter {
                        base::StringPiece ciphertext,
                        unsigned char* output,
                        size_t* output_length) OVERRIDE;
-  virtual QuicData* DecryptPacket(QuicPacketSequenceNumber sequence_number,
-                                  base::StringPiece associated_data,
-                                  base::StringPiece ciphertext) OVERRIDE;
+  virtual bool DecryptPacket(QuicPacketSequenceNumber sequence_number,
+                             base::StringPiece associated_data,
+                             base::StringPiece ciphertext,
+                             char* output,
+                             size_t* output_length,
+                             size_t max_output_length) OVERRIDE;
   virtual base::StringPiece GetKey() const OVERRIDE;
   virtual base::StringPiece GetNoncePrefix() const OVERRIDE;
 
@@ -61,6 +66,9 @@ class NET_EXPORT_PRIVATE Aes128Gcm12Decrypter : public QuicDecrypter {
 
 #if defined(USE_OPENSSL)
   ScopedEVPAEADCtx ctx_;
+#else
+  // |key_| imported into NSS by SetKey(), rather than once per packet.
+  crypto::ScopedPK11SymKey aes_key_;
 #endif
 };
 
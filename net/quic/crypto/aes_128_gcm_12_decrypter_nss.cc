@@ -9,7 +9,6 @@
 #include <secerr.h>
 
 #include "base/lazy_instance.h"
-#include "base/memory/scoped_ptr.h"
 #include "crypto/ghash.h"
 #include "crypto/scoped_nss_types.h"
 
@@ -270,6 +269,25 @@ bool Aes128Gcm12Decrypter::SetKey(StringPiece key) {
     return false;
   }
   memcpy(key_, key.data(), key.size());
+
+  // Import key_ into NSS.
+  SECItem key_item;
+  key_item.type = siBuffer;
+  key_item.data = key_;
+  key_item.len = sizeof(key_);
+  PK11SlotInfo* slot = PK11_GetInternalSlot();
+  // The exact value of the |origin| argument doesn't matter to NSS as long as
+  // it's not PK11_OriginFortezzaHack, so pass PK11_OriginUnwrap as a
+  // placeholder.
+  aes_key_.reset(PK11_ImportSymKey(
+      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
+      CKA_DECRYPT, &key_item, NULL));
+  PK11_FreeSlot(slot);
+  slot = NULL;
+  if (!aes_key_) {
+    DVLOG(1) << "PK11_ImportSymKey failed";
+    return false;
+  }
   return true;
 }
 
@@ -299,22 +317,8 @@ bool Aes128Gcm12Decrypter::Decrypt(StringPiece nonce,
   // |ciphertext| on entry.
   size_t plaintext_size = ciphertext.length() - kAuthTagSize;
 
-  // Import key_ into NSS.
-  SECItem key_item;
-  key_item.type = siBuffer;
-  key_item.data = key_;
-  key_item.len = sizeof(key_);
-  PK11SlotInfo* slot = PK11_GetInternalSlot();
-  // The exact value of the |origin| argument doesn't matter to NSS as long as
-  // it's not PK11_OriginFortezzaHack, so pass PK11_OriginUnwrap as a
-  // placeholder.
-  crypto::ScopedPK11SymKey aes_key(PK11_ImportSymKey(
-      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
-      CKA_DECRYPT, &key_item, NULL));
-  PK11_FreeSlot(slot);
-  slot = NULL;
-  if (!aes_key) {
-    DVLOG(1) << "PK11_ImportSymKey failed";
+  if (!aes_key_) {
+    DVLOG(1) << "No key set";
     return false;
   }
 
@@ -333,7 +337,7 @@ bool Aes128Gcm12Decrypter::Decrypt(StringPiece nonce,
   param.len = sizeof(gcm_params);
 
   unsigned int output_len;
-  if (My_Decrypt(aes_key.get(), CKM_AES_GCM, &param,
+  if (My_Decrypt(aes_key_.get(), CKM_AES_GCM, &param,
                  output, &output_len, ciphertext.length(),
                  reinterpret_cast<const unsigned char*>(ciphertext.data()),
                  ciphertext.length()) != SECSuccess) {
@@ -348,27 +352,25 @@ bool Aes128Gcm12Decrypter::Decrypt(StringPiece nonce,
   return true;
 }
 
-QuicData* Aes128Gcm12Decrypter::DecryptPacket(
+bool Aes128Gcm12Decrypter::DecryptPacket(
     QuicPacketSequenceNumber sequence_number,
     StringPiece associated_data,
-    StringPiece ciphertext) {
-  if (ciphertext.length() < kAuthTagSize) {
-    return NULL;
+    StringPiece ciphertext,
+    char* output,
+    size_t* output_length,
+    size_t max_output_length) {
+  if (ciphertext.length() < kAuthTagSize ||
+      ciphertext.length() > max_output_length) {
+    return false;
   }
-  size_t plaintext_size;
-  scoped_ptr<char[]> plaintext(new char[ciphertext.length()]);
 
   uint8 nonce[kNoncePrefixSize + sizeof(sequence_number)];
   COMPILE_ASSERT(sizeof(nonce) == kAESNonceSize, bad_sequence_number_size);
   memcpy(nonce, nonce_prefix_, kNoncePrefixSize);
   memcpy(nonce + kNoncePrefixSize, &sequence_number, sizeof(sequence_number));
-  if (!Decrypt(StringPiece(reinterpret_cast<char*>(nonce), sizeof(nonce)),
-               associated_data, ciphertext,
-               reinterpret_cast<uint8*>(plaintext.get()),
-               &plaintext_size)) {
-    return NULL;
-  }
-  return new QuicData(plaintext.release(), plaintext_size, true);
+  return Decrypt(StringPiece(reinterpret_cast<char*>(nonce), sizeof(nonce)),
+                 associated_data, ciphertext,
+                 reinterpret_cast<uint8*>(output), output_length);
 }
 
 StringPiece Aes128Gcm12Decrypter::GetKey() const {
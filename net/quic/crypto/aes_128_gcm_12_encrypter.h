@@ -12,6 +12,8 @@
 
 #if defined(USE_OPENSSL)
 #include "net/quic/crypto/scoped_evp_aead_ctx.h"
+#else
+#include "crypto/scoped_nss_types.h"
 #endif
 
 namespace net {
@@ -61,6 +63,9 @@ class NET_EXPORT_PRIVATE Aes128Gcm12Encrypter : public QuicEncrypter {
 
 #if defined(USE_OPENSSL)
   ScopedEVPAEADCtx ctx_;
+#else
+  // |key_| imported into NSS by SetKey(), rather than once per packet.
+  crypto::ScopedPK11SymKey aes_key_;
 #endif
 };
 
@@ -262,6 +262,25 @@ bool Aes128Gcm12Encrypter::SetKey(StringPiece key) {
     return false;
   }
   memcpy(key_, key.data(), key.size());
+
+  // Import key_ into NSS.
+  SECItem key_item;
+  key_item.type = siBuffer;
+  key_item.data = key_;
+  key_item.len = sizeof(key_);
+  PK11SlotInfo* slot = PK11_GetInternalSlot();
+  // The exact value of the |origin| argument doesn't matter to NSS as long as
+  // it's not PK11_OriginFortezzaHack, so we pass PK11_OriginUnwrap as a
+  // placeholder.
+  aes_key_.reset(PK11_ImportSymKey(
+      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
+      CKA_ENCRYPT, &key_item, NULL));
+  PK11_FreeSlot(slot);
+  slot = NULL;
+  if (!aes_key_) {
+    DVLOG(1) << "PK11_ImportSymKey failed";
+    return false;
+  }
   return true;
 }
 
@@ -283,27 +302,13 @@ bool Aes128Gcm12Encrypter::Encrypt(StringPiece nonce,
     return false;
   }
 
-  size_t ciphertext_size = GetCiphertextSize(plaintext.length());
-
-  // Import key_ into NSS.
-  SECItem key_item;
-  key_item.type = siBuffer;
-  key_item.data = key_;
-  key_item.len = sizeof(key_);
-  PK11SlotInfo* slot = PK11_GetInternalSlot();
-  // The exact value of the |origin| argument doesn't matter to NSS as long as
-  // it's not PK11_OriginFortezzaHack, so we pass PK11_OriginUnwrap as a
-  // placeholder.
-  crypto::ScopedPK11SymKey aes_key(PK11_ImportSymKey(
-      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
-      CKA_ENCRYPT, &key_item, NULL));
-  PK11_FreeSlot(slot);
-  slot = NULL;
-  if (!aes_key) {
-    DVLOG(1) << "PK11_ImportSymKey failed";
+  if (!aes_key_) {
+    DVLOG(1) << "No key set";
     return false;
   }
 
+  size_t ciphertext_size = GetCiphertextSize(plaintext.length());
+
   CK_GCM_PARAMS gcm_params = {0};
   gcm_params.pIv =
       reinterpret_cast<CK_BYTE*>(const_cast<char*>(nonce.data()));
@@ -319,7 +324,7 @@ bool Aes128Gcm12Encrypter::Encrypt(StringPiece nonce,
   param.len = sizeof(gcm_params);
 
   unsigned int output_len;
-  if (My_Encrypt(aes_key.get(), CKM_AES_GCM, &param,
+  if (My_Encrypt(aes_key_.get(), CKM_AES_GCM, &param,
                  output, &output_len, ciphertext_size,
                  reinterpret_cast<const unsigned char*>(plaintext.data()),
                  plaintext.size()) != SECSuccess) {
@@ -22,7 +22,8 @@ LocalStrikeRegisterClient::LocalStrikeRegisterClient(
 }
 
 bool LocalStrikeRegisterClient::IsKnownOrbit(StringPiece orbit) const {
-  base::AutoLock lock(m_);
+  // The orbit is fixed when |strike_register_| is constructed, so unlike
+  // Insert() this doesn't need |m_| and never waits on other handshakes.
   if (orbit.length() != kOrbitSize) {
     return false;
   }
@@ -32,7 +32,8 @@ class NET_EXPORT_PRIVATE LocalStrikeRegisterClient
                                            ResultCallback* cb) OVERRIDE;
 
  private:
-  mutable base::Lock m_;
+  // Protects |strike_register_|'s nonce tree.
+  base::Lock m_;
   StrikeRegister strike_register_;
 
   DISALLOW_COPY_AND_ASSIGN(LocalStrikeRegisterClient);
@@ -44,28 +44,17 @@ bool NullDecrypter::Decrypt(StringPiece /*nonce*/,
   return true;
 }
 
-QuicData* NullDecrypter::DecryptPacket(QuicPacketSequenceNumber /*seq_number*/,
-                                       StringPiece associated_data,
-                                       StringPiece ciphertext) {
-  // It's worth duplicating |Decrypt|, above, in order to save a copy by using
-  // the shared-data QuicData constructor directly.
-  QuicDataReader reader(ciphertext.data(), ciphertext.length());
-
-  uint128 hash;
-  if (!ReadHash(&reader, &hash)) {
-    return NULL;
-  }
-
-  StringPiece plaintext = reader.ReadRemainingPayload();
-
-  // TODO(rch): avoid buffer copy here
-  string buffer = associated_data.as_string();
-  plaintext.AppendToString(&buffer);
-
-  if (hash != ComputeHash(buffer)) {
-    return NULL;
+bool NullDecrypter::DecryptPacket(QuicPacketSequenceNumber /*seq_number*/,
+                                  StringPiece associated_data,
+                                  StringPiece ciphertext,
+                                  char* output,
+                                  size_t* output_length,
+                                  size_t max_output_length) {
+  if (ciphertext.length() > max_output_length) {
+    return false;
   }
-  return new QuicData(plaintext.data(), plaintext.length());
+  return Decrypt(StringPiece(), associated_data, ciphertext,
+                 reinterpret_cast<unsigned char*>(output), output_length);
 }
 
 StringPiece NullDecrypter::GetKey() const { return StringPiece(); }
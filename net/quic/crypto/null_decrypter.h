@@ -29,9 +29,12 @@ class NET_EXPORT_PRIVATE NullDecrypter : public QuicDecrypter {
                        base::StringPiece ciphertext,
                        unsigned char* output,
                        size_t* output_length) OVERRIDE;
-  virtual QuicData* DecryptPacket(QuicPacketSequenceNumber sequence_number,
-                                  base::StringPiece associated_data,
-                                  base::StringPiece ciphertext) OVERRIDE;
+  virtual bool DecryptPacket(QuicPacketSequenceNumber sequence_number,
+                             base::StringPiece associated_data,
+                             base::StringPiece ciphertext,
+                             char* output,
+                             size_t* output_length,
+                             size_t max_output_length) OVERRIDE;
   virtual base::StringPiece GetKey() const OVERRIDE;
   virtual base::StringPiece GetNoncePrefix() const OVERRIDE;
 
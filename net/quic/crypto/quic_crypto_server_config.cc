@@ -632,16 +632,18 @@ QuicErrorCode QuicCryptoServerConfig::ProcessClientHello(
       return QUIC_CRYPTO_SYMMETRIC_KEY_SETUP_FAILED;
     }
 
-    scoped_ptr<QuicData> cetv_plaintext(crypters.decrypter->DecryptPacket(
-        0 /* sequence number */, StringPiece() /* associated data */,
-        cetv_ciphertext));
-    if (!cetv_plaintext.get()) {
+    scoped_ptr<char[]> cetv_plaintext(new char[cetv_ciphertext.length()]);
+    size_t cetv_plaintext_length = 0;
+    if (!crypters.decrypter->DecryptPacket(
+            0 /* sequence number */, StringPiece() /* associated data */,
+            cetv_ciphertext, cetv_plaintext.get(), &cetv_plaintext_length,
+            cetv_ciphertext.length())) {
       *error_details = "CETV decryption failure";
       return QUIC_INVALID_CRYPTO_MESSAGE_PARAMETER;
     }
 
     scoped_ptr<CryptoHandshakeMessage> cetv(CryptoFramer::ParseMessage(
-        cetv_plaintext->AsStringPiece()));
+        StringPiece(cetv_plaintext.get(), cetv_plaintext_length)));
     if (!cetv.get()) {
       *error_details = "CETV parse error";
       return QUIC_INVALID_CRYPTO_MESSAGE_PARAMETER;
@@ -52,15 +52,19 @@ class NET_EXPORT_PRIVATE QuicDecrypter {
                        unsigned char* output,
                        size_t* output_length) = 0;
 
-  // Returns a newly created QuicData object containing the decrypted
-  // |ciphertext| or NULL if there is an error. |sequence_number| is
-  // appended to the |nonce_prefix| value provided in SetNoncePrefix()
-  // to form the nonce.
+  // Decrypts |ciphertext| into |output|, which is |max_output_length| bytes
+  // long, and writes the length of the plaintext to |*output_length|.
+  // Returns false if there is an error, or if |output| is shorter than
+  // |ciphertext|. |sequence_number| is appended to the |nonce_prefix| value
+  // provided in SetNoncePrefix() to form the nonce.
   // TODO(wtc): add a way for DecryptPacket to report decryption failure due
   // to non-authentic inputs, as opposed to other reasons for failure.
-  virtual QuicData* DecryptPacket(QuicPacketSequenceNumber sequence_number,
-                                  base::StringPiece associated_data,
-                                  base::StringPiece ciphertext) = 0;
+  virtual bool DecryptPacket(QuicPacketSequenceNumber sequence_number,
+                             base::StringPiece associated_data,
+                             base::StringPiece ciphertext,
+                             char* output,
+                             size_t* output_length,
+                             size_t max_output_length) = 0;
 
   // For use by unit tests only.
   virtual base::StringPiece GetKey() const = 0;
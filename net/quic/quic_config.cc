@@ -253,6 +253,15 @@ QuicTag QuicConfig::congestion_control() const {
   return congestion_control_.GetTag();
 }
 
+void QuicConfig::EnablePacing(bool enable_pacing) {
+  QuicTagVector congestion_control;
+  if (enable_pacing) {
+    congestion_control.push_back(kPACE);
+  }
+  congestion_control.push_back(kQBIC);
+  congestion_control_.set(congestion_control, kQBIC);
+}
+
 void QuicConfig::set_idle_connection_state_lifetime(
     QuicTime::Delta max_idle_connection_state_lifetime,
     QuicTime::Delta default_idle_conection_state_lifetime) {
@@ -321,12 +330,7 @@ bool QuicConfig::negotiated() {
 }
 
 void QuicConfig::SetDefaults() {
-  QuicTagVector congestion_control;
-  if (FLAGS_enable_quic_pacing) {
-    congestion_control.push_back(kPACE);
-  }
-  congestion_control.push_back(kQBIC);
-  congestion_control_.set(congestion_control, kQBIC);
+  EnablePacing(FLAGS_enable_quic_pacing);
   idle_connection_state_lifetime_seconds_.set(kDefaultTimeoutSecs,
                                               kDefaultInitialTimeoutSecs);
   // kKATO is optional. Return 0 if not negotiated.
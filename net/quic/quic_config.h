@@ -141,6 +141,9 @@ class NET_EXPORT_PRIVATE QuicConfig {
 
   QuicTag congestion_control() const;
 
+  // Offers the paced TCP sender ahead of the plain one, or stops offering it.
+  void EnablePacing(bool enable_pacing);
+
   void set_idle_connection_state_lifetime(
       QuicTime::Delta max_idle_connection_state_lifetime,
       QuicTime::Delta default_idle_conection_state_lifetime);
@@ -69,6 +69,28 @@ TEST_F(QuicConfigTest, ToHandshakeMessageWithPacing) {
   EXPECT_EQ(kQBIC, out[1]);
 }
 
+TEST_F(QuicConfigTest, EnablePacing) {
+  ValueRestore<bool> old_flag(&FLAGS_enable_quic_pacing, false);
+
+  config_.SetDefaults();
+  config_.EnablePacing(true);
+  CryptoHandshakeMessage msg;
+  config_.ToHandshakeMessage(&msg);
+
+  const QuicTag* out;
+  size_t out_len;
+  EXPECT_EQ(QUIC_NO_ERROR, msg.GetTaglist(kCGST, &out, &out_len));
+  EXPECT_EQ(2u, out_len);
+  EXPECT_EQ(kPACE, out[0]);
+  EXPECT_EQ(kQBIC, out[1]);
+
+  config_.EnablePacing(false);
+  config_.ToHandshakeMessage(&msg);
+  EXPECT_EQ(QUIC_NO_ERROR, msg.GetTaglist(kCGST, &out, &out_len));
+  EXPECT_EQ(1u, out_len);
+  EXPECT_EQ(kQBIC, out[0]);
+}
+
 TEST_F(QuicConfigTest, ProcessClientHello) {
   QuicConfig client_config;
   QuicTagVector cgst;
@@ -175,20 +175,17 @@ class TaggingDecrypter : public QuicDecrypter {
     return true;
   }
 
-  virtual QuicData* DecryptPacket(QuicPacketSequenceNumber sequence_number,
-                                  StringPiece associated_data,
-                                  StringPiece ciphertext) OVERRIDE {
-    if (ciphertext.size() < kTagSize) {
-      return NULL;
-    }
-    if (!CheckTag(ciphertext, GetTag(ciphertext))) {
-      return NULL;
+  virtual bool DecryptPacket(QuicPacketSequenceNumber sequence_number,
+                             StringPiece associated_data,
+                             StringPiece ciphertext,
+                             char* output,
+                             size_t* output_length,
+                             size_t max_output_length) OVERRIDE {
+    if (ciphertext.size() > max_output_length) {
+      return false;
     }
-    const size_t len = ciphertext.size() - kTagSize;
-    uint8* buf = new uint8[len];
-    memcpy(buf, ciphertext.data(), len);
-    return new QuicData(reinterpret_cast<char*>(buf), len,
-                        true /* owns buffer */);
+    return Decrypt(StringPiece(), associated_data, ciphertext,
+                   reinterpret_cast<unsigned char*>(output), output_length);
   }
 
   virtual StringPiece GetKey() const OVERRIDE { return StringPiece(); }
@@ -27,8 +27,10 @@ WriteResult QuicDefaultPacketWriter::WritePacket(
     const char* buffer, size_t buf_len,
     const net::IPAddressNumber& self_address,
     const net::IPEndPoint& peer_address) {
-  scoped_refptr<StringIOBuffer> buf(
-      new StringIOBuffer(std::string(buffer, buf_len)));
+  // The socket may hold on to the buffer until a blocked write completes, so
+  // the packet is copied once, straight into an IOBuffer.
+  scoped_refptr<IOBuffer> buf(new IOBuffer(buf_len));
+  memcpy(buf->data(), buffer, buf_len);
   DCHECK(!IsWriteBlocked());
   int rv = socket_->Write(buf.get(),
                           buf_len,
@@ -1748,24 +1748,31 @@ bool QuicFramer::DecryptPayload(const QuicPacketHeader& header,
     return false;
   }
   DCHECK(decrypter_.get() != NULL);
-  decrypted_.reset(decrypter_->DecryptPacket(
+  size_t decrypted_length = 0;
+  bool success = decrypter_->DecryptPacket(
       header.packet_sequence_number,
       GetAssociatedDataFromEncryptedPacket(
           packet,
           header.public_header.guid_length,
           header.public_header.version_flag,
           header.public_header.sequence_number_length),
-      encrypted));
-  if  (decrypted_.get() == NULL && alternative_decrypter_.get() != NULL) {
-    decrypted_.reset(alternative_decrypter_->DecryptPacket(
+      encrypted,
+      decrypted_buffer_,
+      &decrypted_length,
+      arraysize(decrypted_buffer_));
+  if (!success && alternative_decrypter_.get() != NULL) {
+    success = alternative_decrypter_->DecryptPacket(
         header.packet_sequence_number,
         GetAssociatedDataFromEncryptedPacket(
             packet,
             header.public_header.guid_length,
             header.public_header.version_flag,
             header.public_header.sequence_number_length),
-        encrypted));
-    if (decrypted_.get() != NULL) {
+        encrypted,
+        decrypted_buffer_,
+        &decrypted_length,
+        arraysize(decrypted_buffer_));
+    if (success) {
       if (alternative_decrypter_latch_) {
         // Switch to the alternative decrypter and latch so that we cannot
         // switch back.
@@ -1777,11 +1784,11 @@ bool QuicFramer::DecryptPayload(const QuicPacketHeader& header,
     }
   }
 
-  if  (decrypted_.get() == NULL) {
+  if (!success) {
     return false;
   }
 
-  reader_.reset(new QuicDataReader(decrypted_->data(), decrypted_->length()));
+  reader_.reset(new QuicDataReader(decrypted_buffer_, decrypted_length));
   return true;
 }
 
@@ -485,8 +485,9 @@ class NET_EXPORT_PRIVATE QuicFramer {
   QuicPacketSequenceNumber last_sequence_number_;
   // Updated by WritePacketHeader.
   QuicGuid last_serialized_guid_;
-  // Buffer containing decrypted payload data during parsing.
-  scoped_ptr<QuicData> decrypted_;
+  // Buffer containing decrypted payload data during parsing.  It is reused
+  // for every packet, so frames only point into it until the next packet.
+  char decrypted_buffer_[kMaxPacketSize];
   // Version of the protocol being used.
   QuicVersion quic_version_;
   // This vector contains QUIC versions which we currently support.
@@ -174,13 +174,18 @@ class TestDecrypter : public QuicDecrypter {
     CHECK(false) << "Not implemented";
     return false;
   }
-  virtual QuicData* DecryptPacket(QuicPacketSequenceNumber sequence_number,
-                                  StringPiece associated_data,
-                                  StringPiece ciphertext) OVERRIDE {
+  virtual bool DecryptPacket(QuicPacketSequenceNumber sequence_number,
+                             StringPiece associated_data,
+                             StringPiece ciphertext,
+                             char* output,
+                             size_t* output_length,
+                             size_t max_output_length) OVERRIDE {
     sequence_number_ = sequence_number;
     associated_data_ = associated_data.as_string();
     ciphertext_ = ciphertext.as_string();
-    return new QuicData(ciphertext.data(), ciphertext.length());
+    memcpy(output, ciphertext.data(), ciphertext.length());
+    *output_length = ciphertext.length();
+    return true;
   }
   virtual StringPiece GetKey() const OVERRIDE {
     return StringPiece();
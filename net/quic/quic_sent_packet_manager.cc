@@ -98,7 +98,9 @@ void QuicSentPacketManager::SetFromConfig(const QuicConfig& config) {
     send_algorithm_->UpdateRtt(rtt_sample_);
   }
   if (config.congestion_control() == kPACE) {
-    MaybeEnablePacing();
+    // Pacing is only offered by an endpoint that wants it, so once both ends
+    // have agreed on it there is nothing left to check.
+    EnablePacing();
   }
   send_algorithm_->SetFromConfig(config, is_server_);
 }
@@ -760,6 +762,10 @@ void QuicSentPacketManager::MaybeEnablePacing() {
     return;
   }
 
+  EnablePacing();
+}
+
+void QuicSentPacketManager::EnablePacing() {
   if (using_pacing_) {
     return;
   }
@@ -282,7 +282,8 @@ QuicStreamFactory::QuicStreamFactory(
     QuicClock* clock,
     size_t max_packet_length,
     const QuicVersionVector& supported_versions,
-    bool enable_port_selection)
+    bool enable_port_selection,
+    bool enable_pacing)
     : require_confirmation_(true),
       host_resolver_(host_resolver),
       client_socket_factory_(client_socket_factory),
@@ -297,6 +298,7 @@ QuicStreamFactory::QuicStreamFactory(
       port_seed_(random_generator_->RandUint64()),
       weak_factory_(this) {
   config_.SetDefaults();
+  config_.EnablePacing(enable_pacing);
   config_.set_idle_connection_state_lifetime(
       QuicTime::Delta::FromSeconds(30),
       QuicTime::Delta::FromSeconds(30));
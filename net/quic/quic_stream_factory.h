@@ -94,7 +94,8 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
       QuicClock* clock,
       size_t max_packet_length,
       const QuicVersionVector& supported_versions,
-      bool enable_port_selection);
+      bool enable_port_selection,
+      bool enable_pacing);
   virtual ~QuicStreamFactory();
 
   // Creates a new QuicHttpStream to |host_port_proxy_pair| which will be
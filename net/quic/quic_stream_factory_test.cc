@@ -80,7 +80,7 @@ class QuicStreamFactoryTest : public ::testing::TestWithParam<QuicVersion> {
                  NULL,  // quic_server_info_factory
                  &crypto_client_stream_factory_,
                  &random_generator_, clock_, kDefaultMaxPacketSize,
-                 SupportedVersions(GetParam()), true),
+                 SupportedVersions(GetParam()), true, false),
         host_port_proxy_pair_(HostPortPair(kDefaultServerHostName,
                                            kDefaultServerPort),
                               ProxyServer::Direct()),
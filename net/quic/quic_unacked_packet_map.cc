@@ -56,6 +56,7 @@ QuicUnackedPacketMap::TransmissionInfo::TransmissionInfo(
 QuicUnackedPacketMap::QuicUnackedPacketMap(bool is_server)
     : largest_sent_packet_(0),
       bytes_in_flight_(0),
+      num_pending_packets_(0),
       is_server_(is_server) {
 }
 
@@ -163,6 +164,9 @@ void QuicUnackedPacketMap::RemovePacket(
     return;
   }
   const TransmissionInfo& transmission_info = it->second;
+  if (transmission_info.pending) {
+    --num_pending_packets_;
+  }
   transmission_info.all_transmissions->erase(sequence_number);
   if (transmission_info.all_transmissions->empty()) {
     delete transmission_info.all_transmissions;
@@ -208,11 +212,17 @@ bool QuicUnackedPacketMap::IsPending(
 
 void QuicUnackedPacketMap::SetNotPending(
     QuicPacketSequenceNumber sequence_number) {
-  if (unacked_packets_[sequence_number].pending) {
-    LOG_IF(DFATAL,
-           bytes_in_flight_ < unacked_packets_[sequence_number].bytes_sent);
-    bytes_in_flight_ -= unacked_packets_[sequence_number].bytes_sent;
-    unacked_packets_[sequence_number].pending = false;
+  UnackedPacketMap::iterator it = unacked_packets_.find(sequence_number);
+  if (it == unacked_packets_.end()) {
+    LOG(DFATAL) << "packet is not unacked: " << sequence_number;
+    return;
+  }
+  TransmissionInfo* transmission_info = &it->second;
+  if (transmission_info->pending) {
+    LOG_IF(DFATAL, bytes_in_flight_ < transmission_info->bytes_sent);
+    bytes_in_flight_ -= transmission_info->bytes_sent;
+    transmission_info->pending = false;
+    --num_pending_packets_;
   }
 }
 
@@ -221,13 +231,7 @@ bool QuicUnackedPacketMap::HasUnackedPackets() const {
 }
 
 bool QuicUnackedPacketMap::HasPendingPackets() const {
-  for (UnackedPacketMap::const_reverse_iterator it =
-           unacked_packets_.rbegin(); it != unacked_packets_.rend(); ++it) {
-    if (it->second.pending) {
-      return true;
-    }
-  }
-  return false;
+  return num_pending_packets_ > 0;
 }
 
 const QuicUnackedPacketMap::TransmissionInfo&
@@ -267,17 +271,7 @@ size_t QuicUnackedPacketMap::GetNumUnackedPackets() const {
 }
 
 bool QuicUnackedPacketMap::HasMultiplePendingPackets() const {
-  size_t num_pending = 0;
-  for (UnackedPacketMap::const_reverse_iterator it = unacked_packets_.rbegin();
-       it != unacked_packets_.rend(); ++it) {
-    if (it->second.pending) {
-      ++num_pending;
-    }
-    if (num_pending > 1) {
-      return true;
-    }
-  }
-  return false;
+  return num_pending_packets_ > 1;
 }
 
 bool QuicUnackedPacketMap::HasUnackedRetransmittableFrames() const {
@@ -334,6 +328,7 @@ void QuicUnackedPacketMap::SetPending(QuicPacketSequenceNumber sequence_number,
 
   largest_sent_packet_ = max(sequence_number, largest_sent_packet_);
   bytes_in_flight_ += bytes_sent;
+  ++num_pending_packets_;
   it->second.sent_time = sent_time;
   it->second.bytes_sent = bytes_sent;
   it->second.pending = true;
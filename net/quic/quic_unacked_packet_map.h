@@ -167,6 +167,9 @@ class NET_EXPORT_PRIVATE QuicUnackedPacketMap {
   UnackedPacketMap unacked_packets_;
 
   size_t bytes_in_flight_;
+  // Number of packets in |unacked_packets_| which are pending, so that
+  // checking for them doesn't walk every unacked packet on each ack.
+  size_t num_pending_packets_;
 
   bool is_server_;
 
@@ -157,6 +157,8 @@ ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
     : idle_socket_count_(0),
       connecting_socket_count_(0),
       handed_out_socket_count_(0),
+      unused_idle_sockets_reused_(0),
+      unused_idle_sockets_discarded_(0),
       max_sockets_(max_sockets),
       max_sockets_per_group_(max_sockets_per_group),
       use_cleanup_timer_(g_cleanup_timer_enabled),
@@ -450,6 +452,8 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
   for (std::list<IdleSocket>::iterator it = idle_sockets->begin();
        it != idle_sockets->end();) {
     if (!it->socket->IsConnectedAndIdle()) {
+      if (!it->socket->WasEverUsed())
+        unused_idle_sockets_discarded_++;
       DecrementIdleCount();
       delete it->socket;
       it = idle_sockets->erase(it);
@@ -476,6 +480,8 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
         base::TimeTicks::Now() - idle_socket_it->start_time;
     IdleSocket idle_socket = *idle_socket_it;
     idle_sockets->erase(idle_socket_it);
+    if (!idle_socket.socket->WasEverUsed())
+      unused_idle_sockets_reused_++;
     HandOutSocket(
         scoped_ptr<StreamSocket>(idle_socket.socket),
         idle_socket.socket->WasEverUsed(),
@@ -589,6 +595,9 @@ base::DictionaryValue* ClientSocketPoolBaseHelper::GetInfoAsValue(
   dict->SetInteger("handed_out_socket_count", handed_out_socket_count_);
   dict->SetInteger("connecting_socket_count", connecting_socket_count_);
   dict->SetInteger("idle_socket_count", idle_socket_count_);
+  dict->SetInteger("unused_idle_sockets_reused", unused_idle_sockets_reused_);
+  dict->SetInteger("unused_idle_sockets_discarded",
+                   unused_idle_sockets_discarded_);
   dict->SetInteger("max_socket_count", max_sockets_);
   dict->SetInteger("max_sockets_per_group", max_sockets_per_group_);
   dict->SetInteger("pool_generation_number", pool_generation_number_);
@@ -671,6 +680,8 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
           j->socket->WasEverUsed() ?
           used_idle_socket_timeout_ : unused_idle_socket_timeout_;
       if (force || j->ShouldCleanup(now, timeout)) {
+        if (!force && !j->socket->WasEverUsed())
+          unused_idle_sockets_discarded_++;
         delete j->socket;
         j = group->mutable_idle_sockets()->erase(j);
         DecrementIdleCount();
@@ -607,6 +607,13 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // Number of connected sockets we handed out across all groups.
   int handed_out_socket_count_;
 
+  // Number of idle sockets that were handed out before ever being used, and
+  // number that were cleaned up without ever being used.  Such sockets are
+  // mostly the result of preconnects, so together these give the preconnect
+  // hit ratio.
+  int unused_idle_sockets_reused_;
+  int unused_idle_sockets_discarded_;
+
   // The maximum total number of sockets. See ReachedMaxSocketsLimit.
   const int max_sockets_;
 
@@ -2382,6 +2382,15 @@ TEST_F(ClientSocketPoolBaseTest, CleanupTimedOutIdleSockets) {
   log.GetEntries(&entries);
   EXPECT_TRUE(LogContainsEntryWithType(
       entries, 1, NetLog::TYPE_SOCKET_POOL_REUSED_AN_EXISTING_SOCKET));
+
+  // The unused socket timing out counts against the unused socket hit ratio.
+  scoped_ptr<base::DictionaryValue> info(
+      pool_->GetInfoAsValue("pool", "type", false));
+  int count = -1;
+  EXPECT_TRUE(info->GetInteger("unused_idle_sockets_reused", &count));
+  EXPECT_EQ(0, count);
+  EXPECT_TRUE(info->GetInteger("unused_idle_sockets_discarded", &count));
+  EXPECT_EQ(1, count);
 }
 
 // Make sure that we process all pending requests even when we're stalling
@@ -3191,6 +3200,33 @@ TEST_F(ClientSocketPoolBaseTest, RequestSockets) {
   EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
 }
 
+// Preconnected sockets that are later handed out count as reused.
+TEST_F(ClientSocketPoolBaseTest, RequestSocketsCountsReusedSockets) {
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  pool_->RequestSockets("a", &params_, 2, BoundNetLog());
+  EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+
+  ClientSocketHandle handle;
+  TestCompletionCallback callback;
+  EXPECT_EQ(OK, handle.Init("a",
+                            params_,
+                            DEFAULT_PRIORITY,
+                            callback.callback(),
+                            pool_.get(),
+                            BoundNetLog()));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+
+  scoped_ptr<base::DictionaryValue> info(
+      pool_->GetInfoAsValue("pool", "type", false));
+  int count = -1;
+  EXPECT_TRUE(info->GetInteger("unused_idle_sockets_reused", &count));
+  EXPECT_EQ(1, count);
+  EXPECT_TRUE(info->GetInteger("unused_idle_sockets_discarded", &count));
+  EXPECT_EQ(0, count);
+}
+
 TEST_F(ClientSocketPoolBaseTest, RequestSocketsWhenAlreadyHaveAConnectJob) {
   CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
   connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/message_loop/message_loop.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/sparse_histogram.h"
@@ -97,6 +98,78 @@ SSLSocketParams::GetHttpProxyConnectionParams() const {
 // Timeout for the SSL handshake portion of the connect.
 static const int kSSLHandshakeTimeoutInSeconds = 30;
 
+// How long a connect job waits for the handshake of another job with the same
+// session cache key before doing its own. A full handshake takes two round
+// trips, so this covers most of them without holding the socket back for long
+// when the first handshake stalls.
+static const int kSessionWaitTimeoutInMilliseconds = 1000;
+
+// Past this many keys with sessions, SSLHandshakeCoalescer forgets them all.
+static const size_t kMaxEstablishedSessionKeys = 1000;
+
+static bool g_handshake_coalescing_enabled = false;
+
+SSLHandshakeCoalescer::PendingHandshake::PendingHandshake() : leader(NULL) {}
+
+SSLHandshakeCoalescer::PendingHandshake::~PendingHandshake() {}
+
+SSLHandshakeCoalescer::SSLHandshakeCoalescer() {}
+
+SSLHandshakeCoalescer::~SSLHandshakeCoalescer() {
+  DCHECK(pending_handshakes_.empty());
+}
+
+bool SSLHandshakeCoalescer::StartHandshake(const std::string& key,
+                                           const SSLConnectJob* job,
+                                           const base::Closure& callback) {
+  if (established_keys_.count(key))
+    return true;
+
+  PendingHandshakeMap::iterator it = pending_handshakes_.find(key);
+  if (it == pending_handshakes_.end()) {
+    pending_handshakes_[key].leader = job;
+    return true;
+  }
+  it->second.waiting_jobs.push_back(WaitingJob(job, callback));
+  return false;
+}
+
+void SSLHandshakeCoalescer::EndHandshake(const std::string& key,
+                                         const SSLConnectJob* job,
+                                         bool established_session) {
+  if (established_session) {
+    if (established_keys_.size() >= kMaxEstablishedSessionKeys)
+      established_keys_.clear();
+    established_keys_.insert(key);
+  }
+
+  PendingHandshakeMap::iterator it = pending_handshakes_.find(key);
+  if (it == pending_handshakes_.end())
+    return;
+
+  std::vector<WaitingJob>& waiting_jobs = it->second.waiting_jobs;
+  if (it->second.leader != job) {
+    for (std::vector<WaitingJob>::iterator waiting_job = waiting_jobs.begin();
+         waiting_job != waiting_jobs.end(); ++waiting_job) {
+      if (waiting_job->first == job) {
+        waiting_jobs.erase(waiting_job);
+        break;
+      }
+    }
+    return;
+  }
+
+  // The waiting jobs go on whether or not the first handshake succeeded. If
+  // it didn't, they do full handshakes of their own.
+  std::vector<WaitingJob> jobs_to_resume;
+  jobs_to_resume.swap(waiting_jobs);
+  pending_handshakes_.erase(it);
+  for (size_t i = 0; i < jobs_to_resume.size(); ++i) {
+    base::MessageLoop::current()->PostTask(FROM_HERE,
+                                           jobs_to_resume[i].second);
+  }
+}
+
 SSLConnectJob::SSLConnectJob(const std::string& group_name,
                              RequestPriority priority,
                              const scoped_refptr<SSLSocketParams>& params,
@@ -107,6 +180,7 @@ SSLConnectJob::SSLConnectJob(const std::string& group_name,
                              ClientSocketFactory* client_socket_factory,
                              HostResolver* host_resolver,
                              const SSLClientSocketContext& context,
+                             SSLHandshakeCoalescer* handshake_coalescer,
                              Delegate* delegate,
                              NetLog* net_log)
     : ConnectJob(group_name,
@@ -127,10 +201,16 @@ SSLConnectJob::SSLConnectJob(const std::string& group_name,
                (params->privacy_mode() == kPrivacyModeEnabled
                     ? "pm/" + context.ssl_session_cache_shard
                     : context.ssl_session_cache_shard)),
+      handshake_coalescer_(handshake_coalescer),
+      in_handshake_coalescer_(false),
+      waited_for_session_(false),
       callback_(base::Bind(&SSLConnectJob::OnIOComplete,
-                           base::Unretained(this))) {}
+                           base::Unretained(this))),
+      weak_factory_(this) {}
 
-SSLConnectJob::~SSLConnectJob() {}
+SSLConnectJob::~SSLConnectJob() {
+  EndCoalescedHandshake(false);
+}
 
 LoadState SSLConnectJob::GetLoadState() const {
   switch (next_state_) {
@@ -144,6 +224,7 @@ LoadState SSLConnectJob::GetLoadState() const {
     case STATE_SOCKS_CONNECT_COMPLETE:
     case STATE_TUNNEL_CONNECT:
       return transport_socket_handle_->GetLoadState();
+    case STATE_SSL_WAIT_FOR_SESSION:
     case STATE_SSL_CONNECT:
     case STATE_SSL_CONNECT_COMPLETE:
       return LOAD_STATE_SSL_HANDSHAKE;
@@ -200,6 +281,10 @@ int SSLConnectJob::DoLoop(int result) {
       case STATE_TUNNEL_CONNECT_COMPLETE:
         rv = DoTunnelConnectComplete(rv);
         break;
+      case STATE_SSL_WAIT_FOR_SESSION:
+        DCHECK_EQ(OK, rv);
+        rv = DoSSLWaitForSession();
+        break;
       case STATE_SSL_CONNECT:
         DCHECK_EQ(OK, rv);
         rv = DoSSLConnect();
@@ -234,7 +319,7 @@ int SSLConnectJob::DoTransportConnect() {
 
 int SSLConnectJob::DoTransportConnectComplete(int result) {
   if (result == OK)
-    next_state_ = STATE_SSL_CONNECT;
+    next_state_ = STATE_SSL_WAIT_FOR_SESSION;
 
   return result;
 }
@@ -255,7 +340,7 @@ int SSLConnectJob::DoSOCKSConnect() {
 
 int SSLConnectJob::DoSOCKSConnectComplete(int result) {
   if (result == OK)
-    next_state_ = STATE_SSL_CONNECT;
+    next_state_ = STATE_SSL_WAIT_FOR_SESSION;
 
   return result;
 }
@@ -291,10 +376,31 @@ int SSLConnectJob::DoTunnelConnectComplete(int result) {
   if (result < 0)
     return result;
 
-  next_state_ = STATE_SSL_CONNECT;
+  next_state_ = STATE_SSL_WAIT_FOR_SESSION;
   return result;
 }
 
+int SSLConnectJob::DoSSLWaitForSession() {
+  next_state_ = STATE_SSL_CONNECT;
+  if (!handshake_coalescer_)
+    return OK;
+
+  in_handshake_coalescer_ = true;
+  if (handshake_coalescer_->StartHandshake(
+          GetSessionCacheKey(), this,
+          base::Bind(&SSLConnectJob::OnSessionAvailable,
+                     weak_factory_.GetWeakPtr()))) {
+    return OK;
+  }
+
+  waited_for_session_ = true;
+  session_wait_timer_.Start(
+      FROM_HERE,
+      base::TimeDelta::FromMilliseconds(kSessionWaitTimeoutInMilliseconds),
+      this, &SSLConnectJob::OnSessionWaitTimeout);
+  return ERR_IO_PENDING;
+}
+
 int SSLConnectJob::DoSSLConnect() {
   next_state_ = STATE_SSL_CONNECT_COMPLETE;
   // Reset the timeout to just the time allowed for the SSL handshake.
@@ -326,6 +432,7 @@ int SSLConnectJob::DoSSLConnect() {
 
 int SSLConnectJob::DoSSLConnectComplete(int result) {
   connect_timing_.ssl_end = base::TimeTicks::Now();
+  EndCoalescedHandshake(result == OK);
 
   SSLClientSocket::NextProtoStatus status =
       SSLClientSocket::kNextProtoUnsupported;
@@ -396,6 +503,12 @@ int SSLConnectJob::DoSSLConnectComplete(int result) {
                                 SSLConnectionStatusToCipherSuite(
                                     ssl_info.connection_status));
 
+    if (waited_for_session_) {
+      UMA_HISTOGRAM_BOOLEAN("Net.SSL_CoalescedHandshakeResumed",
+                            ssl_info.handshake_type ==
+                                SSLInfo::HANDSHAKE_RESUME);
+    }
+
     if (ssl_info.handshake_type == SSLInfo::HANDSHAKE_RESUME) {
       UMA_HISTOGRAM_CUSTOM_TIMES("Net.SSL_Connection_Latency_Resume_Handshake",
                                  connect_duration,
@@ -463,6 +576,32 @@ SSLConnectJob::State SSLConnectJob::GetInitialState(
   return STATE_NONE;
 }
 
+void SSLConnectJob::OnSessionAvailable() {
+  session_wait_timer_.Stop();
+  OnIOComplete(OK);
+}
+
+void SSLConnectJob::OnSessionWaitTimeout() {
+  // Stop waiting, and make sure the end of the other handshake doesn't resume
+  // this job again.
+  weak_factory_.InvalidateWeakPtrs();
+  handshake_coalescer_->EndHandshake(GetSessionCacheKey(), this, false);
+  OnIOComplete(OK);
+}
+
+std::string SSLConnectJob::GetSessionCacheKey() const {
+  return params_->host_and_port().ToString() + "/" +
+      context_.ssl_session_cache_shard;
+}
+
+void SSLConnectJob::EndCoalescedHandshake(bool established_session) {
+  if (!in_handshake_coalescer_)
+    return;
+  in_handshake_coalescer_ = false;
+  handshake_coalescer_->EndHandshake(GetSessionCacheKey(), this,
+                                     established_session);
+}
+
 int SSLConnectJob::ConnectInternal() {
   next_state_ = GetInitialState(params_->GetConnectionType());
   return DoLoop(OK);
@@ -483,6 +622,9 @@ SSLClientSocketPool::SSLConnectJobFactory::SSLConnectJobFactory(
       host_resolver_(host_resolver),
       context_(context),
       net_log_(net_log) {
+  if (g_handshake_coalescing_enabled)
+    handshake_coalescer_.reset(new SSLHandshakeCoalescer());
+
   base::TimeDelta max_transport_timeout = base::TimeDelta();
   base::TimeDelta pool_timeout;
   if (transport_pool_)
@@ -551,6 +693,13 @@ SSLClientSocketPool::~SSLClientSocketPool() {
     ssl_config_service_->RemoveObserver(this);
 }
 
+// static
+bool SSLClientSocketPool::set_handshake_coalescing_enabled(bool enabled) {
+  bool old_value = g_handshake_coalescing_enabled;
+  g_handshake_coalescing_enabled = enabled;
+  return old_value;
+}
+
 scoped_ptr<ConnectJob>
 SSLClientSocketPool::SSLConnectJobFactory::NewConnectJob(
     const std::string& group_name,
@@ -560,7 +709,8 @@ SSLClientSocketPool::SSLConnectJobFactory::NewConnectJob(
       new SSLConnectJob(group_name, request.priority(), request.params(),
                         ConnectionTimeout(), transport_pool_, socks_pool_,
                         http_proxy_pool_, client_socket_factory_,
-                        host_resolver_, context_, delegate, net_log_));
+                        host_resolver_, context_, handshake_coalescer_.get(),
+                        delegate, net_log_));
 }
 
 base::TimeDelta
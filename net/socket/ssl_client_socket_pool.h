@@ -5,11 +5,17 @@
 #ifndef NET_SOCKET_SSL_CLIENT_SOCKET_POOL_H_
 #define NET_SOCKET_SSL_CLIENT_SOCKET_POOL_H_
 
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "net/base/privacy_mode.h"
 #include "net/dns/host_resolver.h"
 #include "net/http/http_response_info.h"
@@ -31,6 +37,7 @@ class HttpProxySocketParams;
 class SOCKSClientSocketPool;
 class SOCKSSocketParams;
 class SSLClientSocket;
+class SSLConnectJob;
 class TransportClientSocketPool;
 class TransportSecurityState;
 class TransportSocketParams;
@@ -94,6 +101,55 @@ class NET_EXPORT_PRIVATE SSLSocketParams
   DISALLOW_COPY_AND_ASSIGN(SSLSocketParams);
 };
 
+// SSLHandshakeCoalescer lets the connect jobs of a pool that open several
+// sockets at once to a server the pool has no session for yet do a single full
+// handshake: the first job does it, and the others wait for it to finish, for
+// a short while at most, so that they can resume the session it established.
+class NET_EXPORT_PRIVATE SSLHandshakeCoalescer {
+ public:
+  SSLHandshakeCoalescer();
+  ~SSLHandshakeCoalescer();
+
+  // Called by |job| before it starts a handshake for the session cache key
+  // |key|. Returns true if the handshake can start right away. Otherwise,
+  // another job is doing the first handshake for |key|, and |callback| will be
+  // posted once that handshake is over.
+  bool StartHandshake(const std::string& key,
+                      const SSLConnectJob* job,
+                      const base::Closure& callback);
+
+  // Called when |job|, which called StartHandshake() for |key|, is done with
+  // the handshake or no longer waits to start it. |established_session| is
+  // true if the handshake of |job| succeeded, so later handshakes for |key|
+  // can resume its session without waiting.
+  void EndHandshake(const std::string& key,
+                    const SSLConnectJob* job,
+                    bool established_session);
+
+ private:
+  typedef std::pair<const SSLConnectJob*, base::Closure> WaitingJob;
+
+  struct PendingHandshake {
+    PendingHandshake();
+    ~PendingHandshake();
+
+    // The job doing the first handshake for the key.
+    const SSLConnectJob* leader;
+    std::vector<WaitingJob> waiting_jobs;
+  };
+
+  typedef std::map<std::string, PendingHandshake> PendingHandshakeMap;
+
+  PendingHandshakeMap pending_handshakes_;
+
+  // Keys with a session to resume. Sessions may have been evicted from the
+  // session cache since; the handshake is then a full one, as it would have
+  // been without coalescing.
+  std::set<std::string> established_keys_;
+
+  DISALLOW_COPY_AND_ASSIGN(SSLHandshakeCoalescer);
+};
+
 // SSLConnectJob handles the SSL handshake after setting up the underlying
 // connection as specified in the params.
 class SSLConnectJob : public ConnectJob {
@@ -109,6 +165,7 @@ class SSLConnectJob : public ConnectJob {
       ClientSocketFactory* client_socket_factory,
       HostResolver* host_resolver,
       const SSLClientSocketContext& context,
+      SSLHandshakeCoalescer* handshake_coalescer,
       Delegate* delegate,
       NetLog* net_log);
   virtual ~SSLConnectJob();
@@ -126,6 +183,7 @@ class SSLConnectJob : public ConnectJob {
     STATE_SOCKS_CONNECT_COMPLETE,
     STATE_TUNNEL_CONNECT,
     STATE_TUNNEL_CONNECT_COMPLETE,
+    STATE_SSL_WAIT_FOR_SESSION,
     STATE_SSL_CONNECT,
     STATE_SSL_CONNECT_COMPLETE,
     STATE_NONE,
@@ -142,6 +200,7 @@ class SSLConnectJob : public ConnectJob {
   int DoSOCKSConnectComplete(int result);
   int DoTunnelConnect();
   int DoTunnelConnectComplete(int result);
+  int DoSSLWaitForSession();
   int DoSSLConnect();
   int DoSSLConnectComplete(int result);
 
@@ -149,6 +208,18 @@ class SSLConnectJob : public ConnectJob {
   // |connection_type|.
   static State GetInitialState(SSLSocketParams::ConnectionType connection_type);
 
+  // Called when the handshake this job waited for is over, or when it waited
+  // long enough, to go on with its own handshake.
+  void OnSessionAvailable();
+  void OnSessionWaitTimeout();
+
+  // Returns the key of the session of this job in the SSL session cache.
+  std::string GetSessionCacheKey() const;
+
+  // Tells |handshake_coalescer_|, if this job is known to it, that the
+  // handshake is over.
+  void EndCoalescedHandshake(bool established_session);
+
   // Starts the SSL connection process.  Returns OK on success and
   // ERR_IO_PENDING if it cannot immediately service the request.
   // Otherwise, it returns a net error code.
@@ -163,6 +234,15 @@ class SSLConnectJob : public ConnectJob {
 
   const SSLClientSocketContext context_;
 
+  // NULL unless handshake coalescing is enabled.
+  SSLHandshakeCoalescer* const handshake_coalescer_;
+  // True if this job called StartHandshake() on |handshake_coalescer_|, and
+  // hasn't yet ended its handshake.
+  bool in_handshake_coalescer_;
+  // True if this job waited for the handshake of another job.
+  bool waited_for_session_;
+  base::OneShotTimer<SSLConnectJob> session_wait_timer_;
+
   State next_state_;
   CompletionCallback callback_;
   scoped_ptr<ClientSocketHandle> transport_socket_handle_;
@@ -170,6 +250,8 @@ class SSLConnectJob : public ConnectJob {
 
   HttpResponseInfo error_response_info_;
 
+  base::WeakPtrFactory<SSLConnectJob> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(SSLConnectJob);
 };
 
@@ -201,6 +283,11 @@ class NET_EXPORT_PRIVATE SSLClientSocketPool
 
   virtual ~SSLClientSocketPool();
 
+  // When enabled, pools created afterwards coalesce the handshakes of the
+  // sockets they open at once to the same server. See SSLHandshakeCoalescer.
+  // Returns the previous setting.
+  static bool set_handshake_coalescing_enabled(bool enabled);
+
   // ClientSocketPool implementation.
   virtual int RequestSocket(const std::string& group_name,
                             const void* connect_params,
@@ -292,6 +379,8 @@ class NET_EXPORT_PRIVATE SSLClientSocketPool
     const SSLClientSocketContext context_;
     base::TimeDelta timeout_;
     NetLog* net_log_;
+    // Shared by the jobs of the pool, NULL unless coalescing is enabled.
+    scoped_ptr<SSLHandshakeCoalescer> handshake_coalescer_;
 
     DISALLOW_COPY_AND_ASSIGN(SSLConnectJobFactory);
   };
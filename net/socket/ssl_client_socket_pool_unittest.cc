@@ -6,6 +6,7 @@
 
 #include "base/callback.h"
 #include "base/compiler_specific.h"
+#include "base/run_loop.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
@@ -388,6 +389,43 @@ TEST_P(SSLClientSocketPoolTest, DirectSSLError) {
   EXPECT_TRUE(handle.is_ssl_error());
 }
 
+// With handshake coalescing, the second job waits for the handshake of the
+// first one, and still does its own when the first fails.
+TEST_P(SSLClientSocketPoolTest, CoalescedHandshakeAfterSSLError) {
+  bool was_enabled =
+      SSLClientSocketPool::set_handshake_coalescing_enabled(true);
+
+  StaticSocketDataProvider data1;
+  socket_factory_.AddSocketDataProvider(&data1);
+  StaticSocketDataProvider data2;
+  socket_factory_.AddSocketDataProvider(&data2);
+  SSLSocketDataProvider ssl1(ASYNC, ERR_SSL_PROTOCOL_ERROR);
+  socket_factory_.AddSSLSocketDataProvider(&ssl1);
+  SSLSocketDataProvider ssl2(ASYNC, OK);
+  socket_factory_.AddSSLSocketDataProvider(&ssl2);
+
+  CreatePool(true /* tcp pool */, false, false);
+  scoped_refptr<SSLSocketParams> params = SSLParams(ProxyServer::SCHEME_DIRECT,
+                                                    false);
+
+  ClientSocketHandle handle1;
+  TestCompletionCallback callback1;
+  EXPECT_EQ(ERR_IO_PENDING, handle1.Init(
+      "a", params, MEDIUM, callback1.callback(), pool_.get(), BoundNetLog()));
+  ClientSocketHandle handle2;
+  TestCompletionCallback callback2;
+  EXPECT_EQ(ERR_IO_PENDING, handle2.Init(
+      "a", params, MEDIUM, callback2.callback(), pool_.get(), BoundNetLog()));
+
+  EXPECT_EQ(ERR_SSL_PROTOCOL_ERROR, callback1.WaitForResult());
+  EXPECT_FALSE(handle1.is_initialized());
+  EXPECT_EQ(OK, callback2.WaitForResult());
+  EXPECT_TRUE(handle2.is_initialized());
+  EXPECT_TRUE(handle2.socket());
+
+  SSLClientSocketPool::set_handshake_coalescing_enabled(was_enabled);
+}
+
 TEST_P(SSLClientSocketPoolTest, DirectWithNPN) {
   StaticSocketDataProvider data;
   socket_factory_.AddSocketDataProvider(&data);
@@ -932,6 +970,70 @@ TEST_P(SSLClientSocketPoolTest, IPPoolingChannelID) {
   TestIPPoolingDisabled(&ssl);
 }
 
+// The jobs are only used as keys by SSLHandshakeCoalescer.
+const SSLConnectJob* FakeJob(intptr_t id) {
+  return reinterpret_cast<const SSLConnectJob*>(id);
+}
+
+void Increment(int* count) {
+  ++*count;
+}
+
+TEST(SSLHandshakeCoalescerTest, LaterHandshakesWaitForFirst) {
+  SSLHandshakeCoalescer coalescer;
+  int resumed = 0;
+  base::Closure callback = base::Bind(&Increment, &resumed);
+
+  EXPECT_TRUE(coalescer.StartHandshake("host:443", FakeJob(1), callback));
+  EXPECT_FALSE(coalescer.StartHandshake("host:443", FakeJob(2), callback));
+  EXPECT_FALSE(coalescer.StartHandshake("host:443", FakeJob(3), callback));
+  EXPECT_TRUE(coalescer.StartHandshake("other:443", FakeJob(4), callback));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, resumed);
+
+  coalescer.EndHandshake("host:443", FakeJob(1), true);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, resumed);
+
+  // Once there is a session to resume, handshakes start right away.
+  EXPECT_TRUE(coalescer.StartHandshake("host:443", FakeJob(5), callback));
+  EXPECT_TRUE(coalescer.StartHandshake("host:443", FakeJob(6), callback));
+
+  coalescer.EndHandshake("other:443", FakeJob(4), false);
+}
+
+TEST(SSLHandshakeCoalescerTest, FailedHandshakeReleasesWaitingJobs) {
+  SSLHandshakeCoalescer coalescer;
+  int resumed = 0;
+  base::Closure callback = base::Bind(&Increment, &resumed);
+
+  EXPECT_TRUE(coalescer.StartHandshake("host:443", FakeJob(1), callback));
+  EXPECT_FALSE(coalescer.StartHandshake("host:443", FakeJob(2), callback));
+  coalescer.EndHandshake("host:443", FakeJob(1), false);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, resumed);
+
+  // Without a session, the next handshake leads again.
+  EXPECT_TRUE(coalescer.StartHandshake("host:443", FakeJob(3), callback));
+  EXPECT_FALSE(coalescer.StartHandshake("host:443", FakeJob(4), callback));
+  coalescer.EndHandshake("host:443", FakeJob(3), true);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, resumed);
+}
+
+TEST(SSLHandshakeCoalescerTest, WaitingJobLeaves) {
+  SSLHandshakeCoalescer coalescer;
+  int resumed = 0;
+  base::Closure callback = base::Bind(&Increment, &resumed);
+
+  EXPECT_TRUE(coalescer.StartHandshake("host:443", FakeJob(1), callback));
+  EXPECT_FALSE(coalescer.StartHandshake("host:443", FakeJob(2), callback));
+  coalescer.EndHandshake("host:443", FakeJob(2), false);
+  coalescer.EndHandshake("host:443", FakeJob(1), true);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, resumed);
+}
+
 // It would be nice to also test the timeouts in SSLClientSocketPool.
 
 }  // namespace
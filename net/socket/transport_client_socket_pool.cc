@@ -33,6 +33,10 @@ namespace net {
 // don't synchronize.
 const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
 
+// Used once IPv4 has won a race, when waiting the full 300ms again would most
+// likely just delay the connection.
+const int TransportConnectJob::kIPv6BrokenFallbackTimerInMs = 50;
+
 namespace {
 
 // Returns true iff all addresses in |list| are in the IPv6 family.
@@ -70,6 +74,24 @@ TransportSocketParams::TransportSocketParams(
 
 TransportSocketParams::~TransportSocketParams() {}
 
+TransportConnectRaceHistory::TransportConnectRaceHistory()
+    : ipv4_won_last_race_(false) {
+}
+
+base::TimeDelta TransportConnectRaceHistory::GetIPv6FallbackDelay() const {
+  return base::TimeDelta::FromMilliseconds(
+      ipv4_won_last_race_ ? TransportConnectJob::kIPv6BrokenFallbackTimerInMs
+                          : TransportConnectJob::kIPv6FallbackTimerInMs);
+}
+
+void TransportConnectRaceHistory::OnIPv4WonRace() {
+  ipv4_won_last_race_ = true;
+}
+
+void TransportConnectRaceHistory::OnIPv6Connected() {
+  ipv4_won_last_race_ = false;
+}
+
 // TransportConnectJobs will time out after this many seconds.  Note this is
 // the total time, including both host resolution and TCP connect() times.
 //
@@ -88,6 +110,7 @@ TransportConnectJob::TransportConnectJob(
     base::TimeDelta timeout_duration,
     ClientSocketFactory* client_socket_factory,
     HostResolver* host_resolver,
+    TransportConnectRaceHistory* race_history,
     Delegate* delegate,
     NetLog* net_log)
     : ConnectJob(group_name, timeout_duration, priority, delegate,
@@ -95,6 +118,7 @@ TransportConnectJob::TransportConnectJob(
       params_(params),
       client_socket_factory_(client_socket_factory),
       resolver_(host_resolver),
+      race_history_(race_history),
       next_state_(STATE_NONE),
       interval_between_connects_(CONNECT_INTERVAL_GT_20MS) {
 }
@@ -225,7 +249,7 @@ int TransportConnectJob::DoTransportConnect() {
       addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
       !AddressListOnlyContainsIPv6(addresses_)) {
     fallback_timer_.Start(FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
+        race_history_->GetIPv6FallbackDelay(),
         this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
   }
   return rv;
@@ -303,6 +327,11 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
                                    100);
       }
     }
+    IPEndPoint local_address;
+    if (transport_socket_->GetLocalAddress(&local_address) == OK &&
+        local_address.GetFamily() == ADDRESS_FAMILY_IPV6) {
+      race_history_->OnIPv6Connected();
+    }
     SetSocket(transport_socket_.Pass());
     fallback_timer_.Stop();
   } else {
@@ -374,15 +403,19 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
         base::TimeDelta::FromMilliseconds(1),
         base::TimeDelta::FromMinutes(10),
         100);
+    race_history_->OnIPv4WonRace();
     SetSocket(fallback_transport_socket_.Pass());
     next_state_ = STATE_NONE;
     transport_socket_.reset();
-  } else {
-    // Be a bit paranoid and kill off the fallback members to prevent reuse.
-    fallback_transport_socket_.reset();
-    fallback_addresses_.reset();
+    NotifyDelegateOfCompletion(result);  // Deletes |this|
+    return;
   }
-  NotifyDelegateOfCompletion(result);  // Deletes |this|
+
+  // The main connect is still pending and may yet succeed, so keep waiting
+  // for it rather than failing the whole job. Be a bit paranoid and kill off
+  // the fallback members to prevent reuse.
+  fallback_transport_socket_.reset();
+  fallback_addresses_.reset();
 }
 
 int TransportConnectJob::ConnectInternal() {
@@ -402,6 +435,7 @@ scoped_ptr<ConnectJob>
                               ConnectionTimeout(),
                               client_socket_factory_,
                               host_resolver_,
+                              race_history_,
                               delegate,
                               net_log_));
 }
@@ -423,7 +457,9 @@ TransportClientSocketPool::TransportClientSocketPool(
             ClientSocketPool::unused_idle_socket_timeout(),
             ClientSocketPool::used_idle_socket_timeout(),
             new TransportConnectJobFactory(client_socket_factory,
-                                           host_resolver, net_log)) {
+                                           host_resolver,
+                                           &race_history_,
+                                           net_log)) {
   base_.EnableConnectBackupJobs();
 }
 
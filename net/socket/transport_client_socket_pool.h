@@ -55,6 +55,27 @@ class NET_EXPORT_PRIVATE TransportSocketParams
   DISALLOW_COPY_AND_ASSIGN(TransportSocketParams);
 };
 
+// Remembers how a pool's recent IPv6/IPv4 connect races turned out. An IPv6
+// connect that loses to the IPv4 fallback usually means IPv6 is broken on the
+// current network, so until an IPv6 connect succeeds again, jobs start their
+// IPv4 fallback after a much shorter delay.
+class NET_EXPORT_PRIVATE TransportConnectRaceHistory {
+ public:
+  TransportConnectRaceHistory();
+
+  // Returns how long a job should wait on an IPv6 connect before also
+  // starting one to an IPv4 address.
+  base::TimeDelta GetIPv6FallbackDelay() const;
+
+  void OnIPv4WonRace();
+  void OnIPv6Connected();
+
+ private:
+  bool ipv4_won_last_race_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransportConnectRaceHistory);
+};
+
 // TransportConnectJob handles the host resolution necessary for socket creation
 // and the transport (likely TCP) connect. TransportConnectJob also has fallback
 // logic for IPv6 connect() timeouts (which may happen due to networks / routers
@@ -63,6 +84,8 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 // (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
 // fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
 // a headstart) and return the one that completes first to the socket pool.
+// The fallback timer is shortened while |race_history| says IPv4 has recently
+// won a race.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   TransportConnectJob(const std::string& group_name,
@@ -71,6 +94,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
                       base::TimeDelta timeout_duration,
                       ClientSocketFactory* client_socket_factory,
                       HostResolver* host_resolver,
+                      TransportConnectRaceHistory* race_history,
                       Delegate* delegate,
                       NetLog* net_log);
   virtual ~TransportConnectJob();
@@ -83,6 +107,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
   static const int kIPv6FallbackTimerInMs;
+  static const int kIPv6BrokenFallbackTimerInMs;
 
  private:
   enum State {
@@ -121,6 +146,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   scoped_refptr<TransportSocketParams> params_;
   ClientSocketFactory* const client_socket_factory_;
   SingleRequestHostResolver resolver_;
+  TransportConnectRaceHistory* const race_history_;
   AddressList addresses_;
   State next_state_;
 
@@ -195,9 +221,11 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
    public:
     TransportConnectJobFactory(ClientSocketFactory* client_socket_factory,
                          HostResolver* host_resolver,
+                         TransportConnectRaceHistory* race_history,
                          NetLog* net_log)
         : client_socket_factory_(client_socket_factory),
           host_resolver_(host_resolver),
+          race_history_(race_history),
           net_log_(net_log) {}
 
     virtual ~TransportConnectJobFactory() {}
@@ -214,11 +242,14 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
    private:
     ClientSocketFactory* const client_socket_factory_;
     HostResolver* const host_resolver_;
+    TransportConnectRaceHistory* const race_history_;
     NetLog* net_log_;
 
     DISALLOW_COPY_AND_ASSIGN(TransportConnectJobFactory);
   };
 
+  // Declared before |base_| so that it outlives every ConnectJob.
+  TransportConnectRaceHistory race_history_;
   PoolBase base_;
 
   DISALLOW_COPY_AND_ASSIGN(TransportClientSocketPool);
@@ -0,0 +1,108 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/test/perf_time_logger.h"
+#include "net/spdy/hpack_decoder.h"
+#include "net/spdy/hpack_encoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+using std::map;
+using std::string;
+
+const int kNumIterations = 20000;
+
+// Header sets modelled on what a browser sends while loading a page: the
+// main resource, then subresources with the same origin and cookies.
+std::vector<map<string, string> > MakeRequestCorpus() {
+  const char* const kPaths[] = {
+    "/",
+    "/static/css/main.css",
+    "/static/js/jquery.min.js",
+    "/static/js/app.js?v=20140301",
+    "/images/logo.png",
+    "/images/sprites/icons-2x.png",
+    "/api/v1/notifications?since=1393632000&limit=20",
+    "/favicon.ico",
+  };
+  const char* const kAccepts[] = {
+    "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8",
+    "text/css,*/*;q=0.1",
+    "*/*",
+    "*/*",
+    "image/webp,*/*;q=0.8",
+    "image/webp,*/*;q=0.8",
+    "application/json, text/javascript, */*; q=0.01",
+    "image/webp,*/*;q=0.8",
+  };
+  COMPILE_ASSERT(arraysize(kPaths) == arraysize(kAccepts),
+                 corpus_arrays_must_match);
+
+  std::vector<map<string, string> > corpus;
+  for (size_t i = 0; i < arraysize(kPaths); ++i) {
+    map<string, string> headers;
+    headers[":method"] = "GET";
+    headers[":scheme"] = "https";
+    headers[":authority"] = "www.example.com";
+    headers[":path"] = kPaths[i];
+    headers["accept"] = kAccepts[i];
+    headers["accept-encoding"] = "gzip,deflate,sdch";
+    headers["accept-language"] = "en-US,en;q=0.8";
+    headers["user-agent"] =
+        "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 "
+        "(KHTML, like Gecko) Chrome/33.0.1750.117 Safari/537.36";
+    headers["cookie"] =
+        "PREF=ID=2a7b4c1de9f03561:U=83b1c2d4e5f60718:FF=0:TM=1393632000:"
+        "LM=1393632000:S=AbCdEfGhIjKlMnOp; session=8f14e45fceea167a5a36dedd"
+        "4bea2543; _ga=GA1.2.1234567890.1393632000";
+    if (i > 0)
+      headers["referer"] = "https://www.example.com/";
+    corpus.push_back(headers);
+  }
+  return corpus;
+}
+
+}  // namespace
+
+TEST(HpackPerfTest, EncodeRequestHeaders) {
+  std::vector<map<string, string> > corpus = MakeRequestCorpus();
+  HpackEncoder encoder(kuint32max);
+  string output;
+
+  base::PerfTimeLogger timer("Hpack_encode_request_headers");
+  for (int i = 0; i < kNumIterations; ++i) {
+    EXPECT_TRUE(encoder.EncodeHeaderSet(corpus[i % corpus.size()], &output));
+  }
+  timer.Done();
+}
+
+TEST(HpackPerfTest, DecodeRequestHeaders) {
+  std::vector<map<string, string> > corpus = MakeRequestCorpus();
+  HpackEncoder encoder(kuint32max);
+  std::vector<string> encoded(corpus.size());
+  for (size_t i = 0; i < corpus.size(); ++i) {
+    ASSERT_TRUE(encoder.EncodeHeaderSet(corpus[i], &encoded[i]));
+  }
+  HpackDecoder decoder(kuint32max);
+
+  base::PerfTimeLogger timer("Hpack_decode_request_headers");
+  for (int i = 0; i < kNumIterations; ++i) {
+    const map<string, string>& headers = corpus[i % corpus.size()];
+    HpackHeaderPairVector header_list;
+    EXPECT_TRUE(decoder.DecodeHeaderSet(encoded[i % encoded.size()],
+                                        &header_list));
+    EXPECT_EQ(headers.size(), header_list.size());
+  }
+  timer.Done();
+}
+
+}  // namespace net
@@ -68,6 +68,13 @@ class QuicServer : public EpollCallbackInterface {
     crypto_config_.set_strike_register_no_startup_period();
   }
 
+  // Sets SO_REUSEPORT on the listening socket, so that several servers, each
+  // on its own thread, can listen on the same port.  The kernel hashes each
+  // client's address to pick one of them, so a client keeps reaching the same
+  // server as long as its address doesn't change.  Must be called before
+  // Listen().
+  void SetReusePort() { reuse_port_ = true; }
+
   bool overflow_supported() { return overflow_supported_; }
 
   uint32 packets_dropped() { return packets_dropped_; }
@@ -103,6 +110,9 @@ class QuicServer : public EpollCallbackInterface {
   // If true, use recvmmsg for reading.
   bool use_recvmmsg_;
 
+  // If true, the listening socket is bound with SO_REUSEPORT.
+  bool reuse_port_;
+
   // config_ contains non-crypto parameters that are negotiated in the crypto
   // handshake.
   QuicConfig config_;
@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 //
 // A binary wrapper for QuicServer.  It listens forever on --port
-// (default 6121) until it's killed or ctrl-cd to death.
+// (default 6121) until it's killed or ctrl-cd to death.  With
+// --num_workers, that many servers share the port through SO_REUSEPORT, each
+// running its own event loop on its own thread.
 
 #include <iostream>
 
@@ -11,7 +13,9 @@
 #include "base/basictypes.h"
 #include "base/command_line.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/simple_thread.h"
 #include "net/base/ip_endpoint.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
 #include "net/tools/quic/quic_server.h"
@@ -20,6 +24,33 @@
 
 int32 FLAGS_port = 6121;
 
+// The number of servers, each with its own thread, that share the port.
+int32 FLAGS_num_workers = 1;
+
+namespace {
+
+// Runs the event loop of one of the servers forever.
+class ServerWorker : public base::SimpleThread {
+ public:
+  explicit ServerWorker(net::tools::QuicServer* server)
+      : base::SimpleThread("QuicServerWorker"),
+        server_(server) {
+  }
+
+  virtual void Run() OVERRIDE {
+    while (1) {
+      server_->WaitForEvents();
+    }
+  }
+
+ private:
+  net::tools::QuicServer* server_;
+
+  DISALLOW_COPY_AND_ASSIGN(ServerWorker);
+};
+
+}  // namespace
+
 int main(int argc, char *argv[]) {
   CommandLine::Init(argc, argv);
   CommandLine* line = CommandLine::ForCurrentProcess();
@@ -35,6 +66,7 @@ int main(int argc, char *argv[]) {
         "Options:\n"
         "-h, --help                  show this help message and exit\n"
         "--port=<port>               specify the port to listen on\n"
+        "--num_workers=<n>           number of threads serving the port\n"
         "--quic_in_memory_cache_dir  directory containing response data\n"
         "                            to load\n";
     std::cout << help_str;
@@ -53,19 +85,40 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (line->HasSwitch("num_workers")) {
+    int num_workers;
+    if (base::StringToInt(line->GetSwitchValueASCII("num_workers"),
+                          &num_workers) && num_workers > 0) {
+      FLAGS_num_workers = num_workers;
+    }
+  }
+
   base::AtExitManager exit_manager;
 
   net::IPAddressNumber ip;
   CHECK(net::ParseIPLiteralToNumber("::", &ip));
 
-  net::tools::QuicServer server;
+  ScopedVector<net::tools::QuicServer> servers;
+  for (int i = 0; i < FLAGS_num_workers; ++i) {
+    net::tools::QuicServer* server = new net::tools::QuicServer();
+    servers.push_back(server);
+    if (FLAGS_num_workers > 1) {
+      server->SetReusePort();
+    }
+    if (!server->Listen(net::IPEndPoint(ip, FLAGS_port))) {
+      return 1;
+    }
+  }
 
-  if (!server.Listen(net::IPEndPoint(ip, FLAGS_port))) {
-    return 1;
+  // The first server runs on the main thread.
+  ScopedVector<ServerWorker> workers;
+  for (size_t i = 1; i < servers.size(); ++i) {
+    workers.push_back(new ServerWorker(servers[i]));
+    workers.back()->Start();
   }
 
   while (1) {
-    server.WaitForEvents();
+    servers[0]->WaitForEvents();
   }
 
   return 0;
@@ -4,6 +4,7 @@
 
 #include "net/tools/quic/quic_server.h"
 
+#include "net/base/net_util.h"
 #include "net/quic/crypto/quic_random.h"
 #include "net/quic/quic_utils.h"
 #include "net/tools/quic/test_tools/mock_quic_dispatcher.h"
@@ -56,6 +57,25 @@ TEST_F(QuicServerDispatchPacketTest, DispatchPacket) {
   DispatchPacket(encrypted_valid_packet);
 }
 
+TEST(QuicServerTest, ReusePort) {
+  IPAddressNumber ip;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &ip));
+
+  QuicServer first;
+  first.SetReusePort();
+  ASSERT_TRUE(first.Listen(IPEndPoint(ip, 0)));
+
+  // Servers that ask for it share the port, and others are kept out.
+  QuicServer second;
+  second.SetReusePort();
+  EXPECT_TRUE(second.Listen(IPEndPoint(ip, first.port())));
+  QuicServer third;
+  EXPECT_FALSE(third.Listen(IPEndPoint(ip, first.port())));
+
+  first.Shutdown();
+  second.Shutdown();
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace tools
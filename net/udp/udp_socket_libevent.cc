@@ -12,6 +12,8 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
+#include <algorithm>
+
 #include "base/callback.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
@@ -57,8 +59,85 @@ int GetIPv4AddressFromIndex(int socket, uint32 index, uint32* address){
 
 #endif  // OS_MACOSX
 
+#if defined(OS_LINUX)
+
+// Datagrams received with a single recvmmsg(). The slots are sized for QUIC
+// packets, which are well below the MTU.
+const int kMaxDatagramsPerBatch = 16;
+const int kMaxBatchedDatagramSize = 2048;
+
+// Number of reads in a row that must find a datagram waiting before the
+// socket switches to batched reads.
+const int kReadsBeforeBatching = 4;
+
+#endif  // OS_LINUX
+
 }  // namespace
 
+#if defined(OS_LINUX)
+
+class UDPSocketLibevent::ReceiveBatch {
+ public:
+  ReceiveBatch() : count_(0), next_(0) {
+    memset(messages_, 0, sizeof(messages_));
+    for (int i = 0; i < kMaxDatagramsPerBatch; ++i) {
+      iovecs_[i].iov_base = buffers_[i];
+      iovecs_[i].iov_len = kMaxBatchedDatagramSize;
+      messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+      messages_[i].msg_hdr.msg_iovlen = 1;
+      messages_[i].msg_hdr.msg_name = &addresses_[i];
+    }
+  }
+
+  bool empty() const { return next_ == count_; }
+
+  // Receives as many datagrams as are waiting on |socket|, up to
+  // kMaxDatagramsPerBatch.  Returns the number received, or -1 with errno set.
+  int Receive(int socket) {
+    DCHECK(empty());
+    for (int i = 0; i < kMaxDatagramsPerBatch; ++i)
+      messages_[i].msg_hdr.msg_namelen = sizeof(addresses_[i]);
+    int rv = HANDLE_EINTR(
+        recvmmsg(socket, messages_, kMaxDatagramsPerBatch, 0, NULL));
+    count_ = std::max(rv, 0);
+    next_ = 0;
+    return rv;
+  }
+
+  // Copies the next datagram into |buf|, truncated to |buf_len| like
+  // recvfrom() would, and returns the number of bytes copied.  |addr| is left
+  // pointing at the sender's address, which is valid until the next Receive().
+  int Pop(char* buf, int buf_len, const sockaddr** addr, socklen_t* addr_len) {
+    DCHECK(!empty());
+    const mmsghdr& message = messages_[next_];
+    int len = std::min(static_cast<int>(message.msg_len), buf_len);
+    memcpy(buf, buffers_[next_], len);
+    *addr = reinterpret_cast<const sockaddr*>(&addresses_[next_]);
+    *addr_len = message.msg_hdr.msg_namelen;
+    ++next_;
+    return len;
+  }
+
+  void Clear() {
+    count_ = 0;
+    next_ = 0;
+  }
+
+ private:
+  char buffers_[kMaxDatagramsPerBatch][kMaxBatchedDatagramSize];
+  iovec iovecs_[kMaxDatagramsPerBatch];
+  sockaddr_storage addresses_[kMaxDatagramsPerBatch];
+  mmsghdr messages_[kMaxDatagramsPerBatch];
+
+  // Number of datagrams received, and the index of the next one to hand out.
+  int count_;
+  int next_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReceiveBatch);
+};
+
+#endif  // OS_LINUX
+
 UDPSocketLibevent::UDPSocketLibevent(
     DatagramSocket::BindType bind_type,
     const RandIntCallback& rand_int_cb,
@@ -75,6 +154,9 @@ UDPSocketLibevent::UDPSocketLibevent(
           write_watcher_(this),
           read_buf_len_(0),
           recv_from_address_(NULL),
+#if defined(OS_LINUX)
+          consecutive_reads_(0),
+#endif
           write_buf_len_(0),
           net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_UDP_SOCKET)) {
   net_log_.BeginEvent(NetLog::TYPE_SOCKET_ALIVE,
@@ -103,6 +185,11 @@ void UDPSocketLibevent::Close() {
   write_buf_len_ = 0;
   write_callback_.Reset();
   send_to_address_.reset();
+#if defined(OS_LINUX)
+  // Datagrams that were received but not read yet go away with the socket.
+  consecutive_reads_ = 0;
+  receive_batch_.reset();
+#endif
 
   bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
   DCHECK(ok);
@@ -460,6 +547,15 @@ void UDPSocketLibevent::LogWrite(int result,
 
 int UDPSocketLibevent::InternalRecvFrom(IOBuffer* buf, int buf_len,
                                         IPEndPoint* address) {
+#if defined(OS_LINUX)
+  // Datagrams already in the batch have to be handed out first, to keep them
+  // in order, even if the caller would have taken a larger one.
+  if (receive_batch_ &&
+      (!receive_batch_->empty() || buf_len <= kMaxBatchedDatagramSize)) {
+    return InternalRecvFromBatch(buf, buf_len, address);
+  }
+#endif
+
   int bytes_transferred;
   int flags = 0;
 
@@ -482,9 +578,42 @@ int UDPSocketLibevent::InternalRecvFrom(IOBuffer* buf, int buf_len,
   }
   if (result != ERR_IO_PENDING)
     LogRead(result, buf->data(), storage.addr_len, storage.addr);
+
+#if defined(OS_LINUX)
+  if (bytes_transferred < 0) {
+    consecutive_reads_ = 0;
+  } else if (++consecutive_reads_ >= kReadsBeforeBatching && !receive_batch_) {
+    receive_batch_.reset(new ReceiveBatch());
+  }
+#endif
   return result;
 }
 
+#if defined(OS_LINUX)
+int UDPSocketLibevent::InternalRecvFromBatch(IOBuffer* buf, int buf_len,
+                                             IPEndPoint* address) {
+  if (receive_batch_->empty()) {
+    int rv = receive_batch_->Receive(socket_);
+    if (rv == 0)
+      return ERR_IO_PENDING;
+    if (rv < 0) {
+      int result = MapSystemError(errno);
+      if (result != ERR_IO_PENDING)
+        LogRead(result, NULL, 0, NULL);
+      return result;
+    }
+  }
+
+  const sockaddr* addr = NULL;
+  socklen_t addr_len = 0;
+  int result = receive_batch_->Pop(buf->data(), buf_len, &addr, &addr_len);
+  if (address && !address->FromSockAddr(addr, addr_len))
+    result = ERR_FAILED;
+  LogRead(result, buf->data(), addr_len, addr);
+  return result;
+}
+#endif
+
 int UDPSocketLibevent::InternalSendTo(IOBuffer* buf, int buf_len,
                                       const IPEndPoint* address) {
   SockaddrStorage storage;
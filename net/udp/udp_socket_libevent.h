@@ -228,6 +228,11 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
 
   int InternalConnect(const IPEndPoint& address);
   int InternalRecvFrom(IOBuffer* buf, int buf_len, IPEndPoint* address);
+#if defined(OS_LINUX)
+  // Like InternalRecvFrom(), but hands out the datagrams of |receive_batch_|,
+  // refilling it with a single recvmmsg() once it runs out.
+  int InternalRecvFromBatch(IOBuffer* buf, int buf_len, IPEndPoint* address);
+#endif
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   // Applies |socket_options_| to |socket_|. Should be called before
@@ -276,6 +281,15 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
 
+#if defined(OS_LINUX)
+  class ReceiveBatch;
+
+  // Number of reads in a row that found a datagram waiting. Once a socket has
+  // shown that it is busy enough, reads switch to |receive_batch_|.
+  int consecutive_reads_;
+  scoped_ptr<ReceiveBatch> receive_batch_;
+#endif
+
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
@@ -9,6 +9,7 @@
 #include "base/bind.h"
 #include "base/metrics/histogram.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -202,6 +203,41 @@ TEST_F(UDPSocketTest, Connect) {
       client_entries, 5, NetLog::TYPE_SOCKET_ALIVE));
 }
 
+// Datagrams that pile up on a busy socket are read back in order, whether or
+// not the socket receives them in batches.
+TEST_F(UDPSocketTest, ManyDatagramsInOrder) {
+  const int kPort = 9997;
+  const int kNumDatagrams = 40;
+
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", kPort, &bind_address);
+  scoped_ptr<UDPServerSocket> server(
+      new UDPServerSocket(NULL, NetLog::Source()));
+  server->AllowAddressReuse();
+  ASSERT_EQ(OK, server->Listen(bind_address));
+
+  scoped_ptr<UDPClientSocket> client(
+      new UDPClientSocket(DatagramSocket::DEFAULT_BIND,
+                          RandIntCallback(),
+                          NULL,
+                          NetLog::Source()));
+  ASSERT_EQ(OK, client->Connect(bind_address));
+  IPEndPoint client_address;
+  ASSERT_EQ(OK, client->GetLocalAddress(&client_address));
+
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    std::string message = "datagram " + base::IntToString(i);
+    EXPECT_EQ(static_cast<int>(message.length()),
+              WriteSocket(client.get(), message));
+  }
+
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    EXPECT_EQ("datagram " + base::IntToString(i),
+              RecvFromSocket(server.get()));
+    EXPECT_TRUE(client_address == recv_from_address_);
+  }
+}
+
 #if defined(OS_MACOSX)
 // UDPSocketPrivate_Broadcast is disabled for OSX because it requires
 // root permissions on OSX 10.7+.
@@ -417,6 +417,36 @@ TEST(WebSocketFrameParserTest, DecodePartialHeader) {
   }
 }
 
+// Tests that the payload and a following frame are decoded correctly when
+// they arrive in the same call as the end of a split frame header.
+TEST(WebSocketFrameParserTest, DecodeDataAfterPartialHeader) {
+  std::vector<char> input(kMaskedHelloFrame,
+                          kMaskedHelloFrame + kMaskedHelloFrameLength);
+  input.insert(input.end(), kHelloFrame, kHelloFrame + kHelloFrameLength);
+  // Split inside the masking key.
+  const size_t kSplit = 4;
+
+  WebSocketFrameParser parser;
+  ScopedVector<WebSocketFrameChunk> frames;
+  EXPECT_TRUE(parser.Decode(&input.front(), kSplit, &frames));
+  EXPECT_EQ(0u, frames.size());
+  EXPECT_TRUE(parser.Decode(&input.front() + kSplit, input.size() - kSplit,
+                            &frames));
+  EXPECT_EQ(kWebSocketNormalClosure, parser.websocket_error());
+  ASSERT_EQ(2u, frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    WebSocketFrameChunk* frame = frames[i];
+    ASSERT_TRUE(frame->header.get());
+    EXPECT_EQ(i == 0, frame->header->masked);
+    EXPECT_EQ(kHelloLength, frame->header->payload_length);
+    EXPECT_TRUE(frame->final_chunk);
+    ASSERT_TRUE(frame->data.get());
+    ASSERT_EQ(static_cast<int>(kHelloLength), frame->data->size());
+    EXPECT_TRUE(std::equal(kHello, kHello + kHelloLength,
+                           frame->data->data()));
+  }
+}
+
 TEST(WebSocketFrameParserTest, InvalidLengthEncoding) {
   struct TestCase {
     const char* frame_header;
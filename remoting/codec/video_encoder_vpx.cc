@@ -4,6 +4,8 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/logging.h"
 #include "base/sys_info.h"
@@ -29,6 +31,28 @@ namespace {
 // map for the encoder.
 const int kMacroBlockSize = 16;
 
+// Frames with at least this many pixels (e.g. 2560x1440 and up) are encoded
+// with up to kMaxLargeFrameThreads threads, since two threads can't keep up
+// with them.
+const int kLargeFramePixels = 2560 * 1440;
+const int kMaxLargeFrameThreads = 4;
+
+// Returns the number of threads to encode frames of |size| with.
+int GetEncoderThreadCount(const webrtc::DesktopSize& size) {
+  // Using 2 threads gives a great boost in performance for most systems with
+  // adequate processing power. NB: Going to multiple threads on low end
+  // windows systems can really hurt performance.
+  // http://crbug.com/99179
+  int processors = base::SysInfo::NumberOfProcessors();
+  if (processors <= 2)
+    return 1;
+  if (size.width() * size.height() < kLargeFramePixels)
+    return 2;
+
+  // Leave half of the cores for capturing and for the rest of the system.
+  return std::max(2, std::min(processors / 2, kMaxLargeFrameThreads));
+}
+
 ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   ScopedVpxCodec codec(new vpx_codec_ctx_t);
 
@@ -51,11 +75,7 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   // encoding.
   config.g_profile = 2;
 
-  // Using 2 threads gives a great boost in performance for most systems with
-  // adequate processing power. NB: Going to multiple threads on low end
-  // windows systems can really hurt performance.
-  // http://crbug.com/99179
-  config.g_threads = (base::SysInfo::NumberOfProcessors() > 2) ? 2 : 1;
+  config.g_threads = GetEncoderThreadCount(size);
   config.rc_min_quantizer = 20;
   config.rc_max_quantizer = 30;
   config.g_timebase.num = 1;
@@ -254,9 +274,11 @@ void VideoEncoderVpx::PrepareImage(const webrtc::DesktopFrame& frame,
     return;
   }
 
-  // Align the region to macroblocks, to avoid encoding artefacts.
-  // This also ensures that all rectangles have even-aligned top-left, which
-  // is required for ConvertRGBToYUVWithRect() to work.
+  // Align the rectangles to even coordinates, which is required for
+  // ConvertRGB32ToYUVWithRect() to work. They are deliberately not grown to
+  // whole macroblocks: the active map already marks the macroblocks they touch
+  // for encoding, and the rest of those macroblocks is unchanged in |image_|,
+  // so converting it again would only add work.
   std::vector<webrtc::DesktopRect> aligned_rects;
   for (webrtc::DesktopRegion::Iterator r(frame.updated_region());
        !r.IsAtEnd(); r.Advance()) {
@@ -4,6 +4,8 @@
 
 #include "remoting/protocol/buffered_socket_writer.h"
 
+#include <iterator>
+
 #include "base/bind.h"
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
@@ -14,6 +16,15 @@
 namespace remoting {
 namespace protocol {
 
+namespace {
+
+// Packets are merged into writes of at most this many bytes. Bigger packets
+// are written on their own, since copying them would cost more than the write
+// it saves.
+const int kMaxCoalescedSize = 4096;
+
+}  // namespace
+
 struct BufferedSocketWriterBase::PendingPacket {
   PendingPacket(scoped_refptr<net::IOBufferWithSize> data,
                 const base::Closure& done_task)
@@ -180,6 +191,7 @@ void BufferedSocketWriter::GetNextPacket(
       *buffer = NULL;
       return;  // Nothing to write.
     }
+    CoalesceSmallPackets();
     current_buf_ = new net::DrainableIOBuffer(queue_.front()->data.get(),
                                               queue_.front()->data->size());
   }
@@ -199,6 +211,39 @@ base::Closure BufferedSocketWriter::AdvanceBufferPosition(int written) {
   return base::Closure();
 }
 
+void BufferedSocketWriter::CoalesceSmallPackets() {
+  DCHECK(!current_buf_.get());
+
+  // Only the last merged packet may have a |done_task|, so that every task
+  // still runs once its own data is written, and only then.
+  int merged_size = 0;
+  DataQueue::iterator end = queue_.begin();
+  while (end != queue_.end() &&
+         merged_size + (*end)->data->size() <= kMaxCoalescedSize) {
+    merged_size += (*end)->data->size();
+    bool has_done_task = !(*end)->done_task.is_null();
+    ++end;
+    if (has_done_task)
+      break;
+  }
+  if (std::distance(queue_.begin(), end) < 2)
+    return;
+
+  scoped_refptr<net::IOBufferWithSize> merged =
+      new net::IOBufferWithSize(merged_size);
+  base::Closure done_task;
+  int position = 0;
+  for (DataQueue::iterator it = queue_.begin(); it != end; ++it) {
+    memcpy(merged->data() + position, (*it)->data->data(),
+           (*it)->data->size());
+    position += (*it)->data->size();
+    done_task = (*it)->done_task;
+    delete *it;
+  }
+  queue_.erase(queue_.begin(), end);
+  queue_.push_front(new PendingPacket(merged, done_task));
+}
+
 void BufferedSocketWriter::OnError(int result) {
   current_buf_ = NULL;
 }
@@ -112,6 +112,11 @@ class BufferedSocketWriter : public BufferedSocketWriterBase {
   virtual void OnError(int result) OVERRIDE;
 
  private:
+  // Merges the small packets at the front of the queue into one, so that a
+  // burst of small messages (e.g. mouse moves) queued while a write was
+  // pending goes out in a single write.
+  void CoalesceSmallPackets();
+
   scoped_refptr<net::DrainableIOBuffer> current_buf_;
 };
 
@@ -153,6 +153,29 @@ TEST_F(BufferedSocketWriterTest, DestroyFromCallback) {
                       test_buffer_->size()));
 }
 
+// Test that small packets queued behind a pending write are merged, and still
+// written in order.
+TEST_F(BufferedSocketWriterTest, CoalesceSmallPackets) {
+  socket_->set_async_write(true);
+  std::string expected_data;
+  for (int i = 0; i < 5; ++i) {
+    scoped_refptr<net::IOBufferWithSize> buffer =
+        new net::IOBufferWithSize(100);
+    memset(buffer->data(), 'a' + i, buffer->size());
+    expected_data.append(buffer->data(), buffer->size());
+    writer_->Write(buffer, i == 4 ? base::Bind(
+        &BufferedSocketWriterTest::OnDone, base::Unretained(this)) :
+        base::Closure());
+  }
+  message_loop_.Run();
+  EXPECT_EQ(expected_data, socket_->written_data());
+  // The first packet is written on its own while the rest are queued, and
+  // then those go out together.
+  EXPECT_EQ(2, socket_->write_count());
+  EXPECT_EQ(0, writer_->GetBufferSize());
+  EXPECT_EQ(0, writer_->GetBufferChunks());
+}
+
 // Verify that it stops writing after the first error.
 TEST_F(BufferedSocketWriterTest, TestWriteErrorSync) {
   socket_->set_write_limit(kWriteChunkSize);
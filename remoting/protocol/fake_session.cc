@@ -22,6 +22,7 @@ FakeSocket::FakeSocket()
       write_pending_(false),
       write_limit_(0),
       next_write_error_(net::OK),
+      write_count_(0),
       next_read_error_(net::OK),
       read_pending_(false),
       read_buffer_size_(0),
@@ -86,6 +87,7 @@ int FakeSocket::Write(net::IOBuffer* buf, int buf_len,
                       const net::CompletionCallback& callback) {
   EXPECT_EQ(message_loop_, base::MessageLoop::current());
   EXPECT_FALSE(write_pending_);
+  ++write_count_;
 
   if (write_limit_ > 0)
     buf_len = std::min(write_limit_, buf_len);
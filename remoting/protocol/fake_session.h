@@ -42,6 +42,8 @@ class FakeSocket : public net::StreamSocket {
   virtual ~FakeSocket();
 
   const std::string& written_data() const { return written_data_; }
+  // Number of times Write() was called.
+  int write_count() const { return write_count_; }
 
   void set_write_limit(int write_limit) { write_limit_ = write_limit; }
   void set_async_write(bool async_write) { async_write_ = async_write; }
@@ -86,6 +88,7 @@ class FakeSocket : public net::StreamSocket {
   bool write_pending_;
   int write_limit_;
   int next_write_error_;
+  int write_count_;
 
   int next_read_error_;
   bool read_pending_;
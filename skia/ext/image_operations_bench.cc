@@ -6,7 +6,8 @@
 // resize algorithms offered by the ImageOperations::Resize function.
 // It will generate an empty source bitmap, and rescale it to specified
 // dimensions. It will repeat this operation multiple time to get more accurate
-// average throughput. Because it uses elapsed time to do its math, it is only
+// average throughput. Several methods can be given at once to compare them on
+// the same bitmaps. Because it uses elapsed time to do its math, it is only
 // accurate on an idle system (but that approach was deemed more accurate
 // than the use of the times() call.
 // To present a single number in MB/s, it calculates the 'speed' by taking
@@ -16,6 +17,8 @@
 
 #include <stdio.h>
 
+#include <vector>
+
 #include "base/basictypes.h"
 #include "base/command_line.h"
 #include "base/format_macros.h"
@@ -141,7 +144,7 @@ class Benchmark {
 
   Benchmark()
       : num_iterations_(kDefaultNumberIterations),
-        method_(kDefaultResizeMethod) {}
+        methods_(1, kDefaultResizeMethod) {}
 
   // Returns true if command line parsing was successful, false otherwise.
   bool ParseArgs(const CommandLine* command_line);
@@ -152,7 +155,7 @@ class Benchmark {
   static void Usage();
  private:
   int num_iterations_;
-  skia::ImageOperations::ResizeMethod method_;
+  std::vector<skia::ImageOperations::ResizeMethod> methods_;
   Dimensions source_;
   Dimensions dest_;
 };
@@ -165,11 +168,12 @@ const skia::ImageOperations::ResizeMethod Benchmark::kDefaultResizeMethod =
 // argument management
 void Benchmark::Usage() {
   printf("image_operations_bench -source wxh -destination wxh "
-         "[-iterations i] [-method m] [-help]\n"
+         "[-iterations i] [-method m[,m...]] [-help]\n"
          "  -source wxh: specify source width and height\n"
          "  -destination wxh: specify destination width and height\n"
          "  -iter i: perform i iterations (default:%d)\n"
-         "  -method m: use method m (default:%s), which can be:",
+         "  -method m[,m...]: use method m, or each of a comma separated\n"
+         "   list of methods in turn (default:%s), which can be:",
          Benchmark::kDefaultNumberIterations,
          MethodToString(Benchmark::kDefaultResizeMethod));
   PrintMethods();
@@ -199,9 +203,14 @@ bool Benchmark::ParseArgs(const CommandLine* command_line) {
         fNeedHelp = true;
       }
     } else if (s == "method") {
-      if (!StringToMethod(value, &method_)) {
-        printf("Invalid method '%s' specified\n", value.c_str());
-        fNeedHelp = true;
+      std::vector<std::string> names;
+      base::SplitString(value, ',', &names);
+      methods_.resize(names.size());
+      for (size_t i = 0; i < names.size(); ++i) {
+        if (!StringToMethod(names[i], &methods_[i])) {
+          printf("Invalid method '%s' specified\n", names[i].c_str());
+          fNeedHelp = true;
+        }
       }
     } else {
       fNeedHelp = true;
@@ -234,25 +243,30 @@ bool Benchmark::Run() const {
   source.allocPixels();
   source.eraseARGB(0, 0, 0, 0);
 
-  SkBitmap dest;
+  for (size_t m = 0; m < methods_.size(); ++m) {
+    SkBitmap dest;
 
-  const base::TimeTicks start = base::TimeTicks::Now();
+    const base::TimeTicks start = base::TimeTicks::Now();
 
-  for (int i = 0; i < num_iterations_; ++i) {
-    dest = skia::ImageOperations::Resize(source,
-                                         method_,
-                                         dest_.width(), dest_.height());
-  }
+    for (int i = 0; i < num_iterations_; ++i) {
+      dest = skia::ImageOperations::Resize(source,
+                                           methods_[m],
+                                           dest_.width(), dest_.height());
+    }
 
-  const int64 elapsed_us = (base::TimeTicks::Now() - start).InMicroseconds();
+    const int64 elapsed_us =
+        (base::TimeTicks::Now() - start).InMicroseconds();
 
-  const uint64 num_bytes = static_cast<uint64>(num_iterations_) *
-      (GetBitmapSize(&source) + GetBitmapSize(&dest));
+    const uint64 num_bytes = static_cast<uint64>(num_iterations_) *
+        (GetBitmapSize(&source) + GetBitmapSize(&dest));
 
-  printf("%" PRIu64 " MB/s,\telapsed = %" PRIu64 " source=%d dest=%d\n",
-         static_cast<uint64>(elapsed_us == 0 ? 0 : num_bytes / elapsed_us),
-         static_cast<uint64>(elapsed_us),
-         GetBitmapSize(&source), GetBitmapSize(&dest));
+    printf("%s:\t%" PRIu64 " MB/s,\telapsed = %" PRIu64
+           " source=%d dest=%d\n",
+           MethodToString(methods_[m]),
+           static_cast<uint64>(elapsed_us == 0 ? 0 : num_bytes / elapsed_us),
+           static_cast<uint64>(elapsed_us),
+           GetBitmapSize(&source), GetBitmapSize(&dest));
+  }
 
   return true;
 }
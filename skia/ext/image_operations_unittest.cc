@@ -461,6 +461,31 @@ TEST(ImageOperations, HalveSubset) {
   }
 }
 
+// Halving with a box filter averages each 2x2 block, rounding to nearest.
+TEST(ImageOperations, HalveRounding) {
+  SkBitmap src;
+  src.setConfig(SkBitmap::kARGB_8888_Config, 4, 2);
+  src.allocPixels();
+  SkAutoLockPixels src_lock(src);
+  *src.getAddr32(0, 0) = 0x80402010;
+  *src.getAddr32(1, 0) = 0x80402011;
+  *src.getAddr32(0, 1) = 0x80402012;
+  *src.getAddr32(1, 1) = 0x80402012;
+  *src.getAddr32(2, 0) = 0xFFFFFFFF;
+  *src.getAddr32(3, 0) = 0xFFFFFFFF;
+  *src.getAddr32(2, 1) = 0xFFFFFFFF;
+  *src.getAddr32(3, 1) = 0xFFFEFDFC;
+
+  SkBitmap results = skia::ImageOperations::Resize(
+      src, skia::ImageOperations::RESIZE_BOX, 2, 1);
+  ASSERT_EQ(2, results.width());
+  ASSERT_EQ(1, results.height());
+
+  SkAutoLockPixels results_lock(results);
+  EXPECT_EQ(0x80402011u, *results.getAddr32(0, 0));
+  EXPECT_EQ(0xFFFFFFFEu, *results.getAddr32(1, 0));
+}
+
 TEST(ImageOperations, InvalidParams) {
   // Make our source bitmap.
   SkBitmap src;
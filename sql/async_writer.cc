@@ -0,0 +1,146 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/async_writer.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "sql/connection.h"
+#include "sql/transaction.h"
+
+namespace sql {
+
+AsyncWriter::AsyncWriter(
+    const scoped_refptr<base::SequencedTaskRunner>& db_task_runner,
+    Connection* db,
+    size_t batch_size,
+    base::TimeDelta commit_interval)
+    : db_task_runner_(db_task_runner),
+      batch_size_(batch_size),
+      commit_interval_(commit_interval),
+      db_(db),
+      num_pending_(0),
+      commit_scheduled_(false) {
+  DCHECK(db_task_runner_.get());
+  DCHECK_GT(batch_size_, 0u);
+}
+
+AsyncWriter::~AsyncWriter() {
+}
+
+void AsyncWriter::Enqueue(const std::string& key,
+                          const Operation& operation) {
+  DCHECK(!operation.is_null());
+
+  PendingOperation po;
+  po.key = key;
+  po.operation = operation;
+
+  bool commit_now = false;
+  bool start_timer = false;
+  {
+    base::AutoLock locked(lock_);
+    bool replaced = false;
+    if (!key.empty()) {
+      KeyMap::iterator it = keys_.find(key);
+      if (it != keys_.end()) {
+        pending_.erase(it->second);
+        --num_pending_;
+        replaced = true;
+      }
+    }
+    PendingOperationList::iterator pos = pending_.insert(pending_.end(), po);
+    if (!key.empty())
+      keys_[key] = pos;
+    ++num_pending_;
+
+    // Replacing an operation doesn't grow the batch, so it never needs a
+    // commit of its own.
+    if (!replaced && num_pending_ == batch_size_)
+      commit_now = true;
+    else if (!commit_scheduled_)
+      start_timer = true;
+    commit_scheduled_ = true;
+  }
+
+  if (commit_now) {
+    // We've reached a big enough batch, fire off a commit now.
+    db_task_runner_->PostTask(FROM_HERE,
+                              base::Bind(&AsyncWriter::Commit, this));
+  } else if (start_timer) {
+    // We've gotten our first entry for this batch, fire off the timer.
+    db_task_runner_->PostDelayedTask(
+        FROM_HERE, base::Bind(&AsyncWriter::Commit, this), commit_interval_);
+  }
+}
+
+void AsyncWriter::Flush(const base::Closure& callback) {
+  if (callback.is_null()) {
+    db_task_runner_->PostTask(FROM_HERE,
+                              base::Bind(&AsyncWriter::Commit, this));
+  } else {
+    db_task_runner_->PostTaskAndReply(
+        FROM_HERE, base::Bind(&AsyncWriter::Commit, this), callback);
+  }
+}
+
+void AsyncWriter::Close() {
+  db_task_runner_->PostTask(FROM_HERE,
+                            base::Bind(&AsyncWriter::InternalClose, this));
+}
+
+size_t AsyncWriter::num_pending() const {
+  base::AutoLock locked(lock_);
+  return num_pending_;
+}
+
+void AsyncWriter::SetConnection(Connection* db) {
+  DCHECK(db_task_runner_->RunsTasksOnCurrentThread());
+  db_ = db;
+}
+
+void AsyncWriter::Commit() {
+  DCHECK(db_task_runner_->RunsTasksOnCurrentThread());
+
+  PendingOperationList ops;
+  {
+    base::AutoLock locked(lock_);
+    pending_.swap(ops);
+    keys_.clear();
+    num_pending_ = 0;
+    commit_scheduled_ = false;
+  }
+
+  // Maybe an old timer fired, or we are Close()'ed or detached.
+  if (!db_ || ops.empty())
+    return;
+
+  const size_t num_ops = ops.size();
+  bool success = false;
+  Transaction transaction(db_);
+  if (transaction.Begin()) {
+    success = true;
+    for (PendingOperationList::iterator it = ops.begin();
+         it != ops.end(); ++it) {
+      if (!it->operation.Run(db_))
+        success = false;
+    }
+    if (!transaction.Commit())
+      success = false;
+  }
+
+  if (!commit_callback_.is_null())
+    commit_callback_.Run(num_ops, success);
+}
+
+void AsyncWriter::InternalClose() {
+  DCHECK(db_task_runner_->RunsTasksOnCurrentThread());
+  // Commit any pending operations.
+  Commit();
+  db_ = NULL;
+}
+
+}  // namespace sql
@@ -0,0 +1,135 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SQL_ASYNC_WRITER_H_
+#define SQL_ASYNC_WRITER_H_
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "sql/sql_export.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace sql {
+
+class Connection;
+
+// Batches writes to a database that lives on a background sequence, so that
+// callers don't each need their own pending list, commit timer and
+// transaction handling.  Operations may be queued from any thread; they are
+// run on |db_task_runner| inside a single transaction once |batch_size| of
+// them are pending or |commit_interval| has passed since the first one was
+// queued, whichever comes first.
+//
+// Typical use, with |db_| owned by a backend that lives on |task_runner|:
+//
+//   writer_ = new sql::AsyncWriter(task_runner, db_.get(), 512,
+//                                  base::TimeDelta::FromSeconds(30));
+//   ...
+//   writer_->Enqueue(key, base::Bind(&UpdateRow, key, value));
+//   ...
+//   writer_->Close();  // Before |db_| is destroyed on |task_runner|.
+//
+// A backend that opens its database lazily on |task_runner| can pass a NULL
+// |db| and SetConnection() once it is open, as the cookie store does.
+class SQL_EXPORT AsyncWriter
+    : public base::RefCountedThreadSafe<AsyncWriter> {
+ public:
+  // Runs one mutation against the connection, returning false on failure.  A
+  // failed operation does not abort the batch, since rolling back would also
+  // throw away all the unrelated operations in it.
+  typedef base::Callback<bool(Connection*)> Operation;
+
+  // Run on |db_task_runner| after each batch with the number of operations in
+  // it and whether all of them and the commit succeeded.
+  typedef base::Callback<void(size_t, bool)> CommitCallback;
+
+  // |db| must only be used on |db_task_runner|, and must outlive the task
+  // posted by Close().  It may be NULL, see SetConnection().
+  AsyncWriter(const scoped_refptr<base::SequencedTaskRunner>& db_task_runner,
+              Connection* db,
+              size_t batch_size,
+              base::TimeDelta commit_interval);
+
+  // Sets the callback run after each batch is committed.  Must be called
+  // before the first operation is queued.
+  void set_commit_callback(const CommitCallback& callback) {
+    commit_callback_ = callback;
+  }
+
+  // Queues |operation|.  If |key| is not empty, a still-queued operation with
+  // the same |key| is dropped in favor of this one, so repeated updates to a
+  // row only write it once.  The surviving operation runs in the position of
+  // the latest one.
+  void Enqueue(const std::string& key, const Operation& operation);
+
+  // Commits whatever is queued without waiting for the batch to fill.  If
+  // |callback| is not null, it is posted back to the calling thread, which
+  // must have a message loop, once the commit has happened.
+  void Flush(const base::Closure& callback);
+
+  // Commits whatever is queued and detaches from the connection.  Operations
+  // queued afterwards and commits triggered by stale timers are dropped.
+  void Close();
+
+  // Returns the number of operations waiting for the next commit.
+  size_t num_pending() const;
+
+  // Commits to |db| from now on, or drops the operations committed while it
+  // is NULL.  Must be called on |db_task_runner|, and with NULL before |db| is
+  // destroyed.
+  void SetConnection(Connection* db);
+
+  // Runs the queued operations in a transaction right away.  Must be called
+  // on |db_task_runner|; Flush() is the asynchronous version.
+  void Commit();
+
+ private:
+  friend class base::RefCountedThreadSafe<AsyncWriter>;
+
+  struct PendingOperation {
+    std::string key;
+    Operation operation;
+  };
+  typedef std::list<PendingOperation> PendingOperationList;
+  typedef std::map<std::string, PendingOperationList::iterator> KeyMap;
+
+  ~AsyncWriter();
+
+  // Close() executed on |db_task_runner_|.
+  void InternalClose();
+
+  const scoped_refptr<base::SequencedTaskRunner> db_task_runner_;
+  const size_t batch_size_;
+  const base::TimeDelta commit_interval_;
+  CommitCallback commit_callback_;
+
+  // Only used on |db_task_runner_|.  NULL once closed.
+  Connection* db_;
+
+  // Guards |pending_|, |num_pending_|, |keys_| and |commit_scheduled_|.
+  mutable base::Lock lock_;
+  PendingOperationList pending_;
+  size_t num_pending_;
+  // Maps the key of each keyed operation in |pending_| to its position.
+  KeyMap keys_;
+  // Whether a Commit() task has been posted for the operations in |pending_|,
+  // so that queueing more of them doesn't post another.
+  bool commit_scheduled_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncWriter);
+};
+
+}  // namespace sql
+
+#endif  // SQL_ASYNC_WRITER_H_
@@ -0,0 +1,218 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/test/test_simple_task_runner.h"
+#include "sql/async_writer.h"
+#include "sql/connection.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+bool InsertRow(int a, int b, sql::Connection* db) {
+  sql::Statement s(db->GetCachedStatement(
+      SQL_FROM_HERE, "INSERT OR REPLACE INTO foo (a, b) VALUES (?, ?)"));
+  s.BindInt(0, a);
+  s.BindInt(1, b);
+  return s.Run();
+}
+
+bool FailingOperation(sql::Connection* db) {
+  return false;
+}
+
+void SetTrue(bool* flag) {
+  *flag = true;
+}
+
+class SQLAsyncWriterTest : public testing::Test {
+ public:
+  SQLAsyncWriterTest() : commits_(0), last_num_ops_(0), last_success_(false) {}
+
+  virtual void SetUp() {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(db_.Open(
+        temp_dir_.path().AppendASCII("SQLAsyncWriterTest.db")));
+    ASSERT_TRUE(db_.Execute("CREATE TABLE foo (a PRIMARY KEY, b)"));
+  }
+
+  virtual void TearDown() {
+    if (writer_.get()) {
+      writer_->Close();
+      message_loop_.RunUntilIdle();
+      writer_ = NULL;
+    }
+    db_.Close();
+  }
+
+  // Creates |writer_| with a commit interval long enough that only batch size
+  // and explicit flushes cause commits.
+  void CreateWriter(size_t batch_size) {
+    writer_ = new sql::AsyncWriter(message_loop_.message_loop_proxy(),
+                                   &db_,
+                                   batch_size,
+                                   base::TimeDelta::FromHours(1));
+    writer_->set_commit_callback(
+        base::Bind(&SQLAsyncWriterTest::OnCommit, base::Unretained(this)));
+  }
+
+  void OnCommit(size_t num_ops, bool success) {
+    ++commits_;
+    last_num_ops_ = num_ops;
+    last_success_ = success;
+  }
+
+  // Returns the number of rows in table "foo".
+  int CountFoo() {
+    sql::Statement count(db_.GetUniqueStatement("SELECT count(*) FROM foo"));
+    count.Step();
+    return count.ColumnInt(0);
+  }
+
+ protected:
+  base::MessageLoop message_loop_;
+  sql::Connection db_;
+  scoped_refptr<sql::AsyncWriter> writer_;
+
+  int commits_;
+  size_t last_num_ops_;
+  bool last_success_;
+
+ private:
+  base::ScopedTempDir temp_dir_;
+};
+
+// Operations are held until the batch is full, then committed together.
+TEST_F(SQLAsyncWriterTest, BatchSize) {
+  CreateWriter(3);
+
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 1, 10));
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 2, 20));
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(0, commits_);
+  EXPECT_EQ(0, CountFoo());
+  EXPECT_EQ(2u, writer_->num_pending());
+
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 3, 30));
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(1, commits_);
+  EXPECT_EQ(3u, last_num_ops_);
+  EXPECT_TRUE(last_success_);
+  EXPECT_EQ(3, CountFoo());
+  EXPECT_EQ(0u, writer_->num_pending());
+}
+
+// Repeated operations on the same key only run once, with the latest value.
+TEST_F(SQLAsyncWriterTest, Coalesce) {
+  CreateWriter(100);
+
+  writer_->Enqueue("1", base::Bind(&InsertRow, 1, 10));
+  writer_->Enqueue("2", base::Bind(&InsertRow, 2, 20));
+  writer_->Enqueue("1", base::Bind(&InsertRow, 1, 11));
+  writer_->Enqueue("1", base::Bind(&InsertRow, 1, 12));
+  EXPECT_EQ(2u, writer_->num_pending());
+
+  bool flushed = false;
+  writer_->Flush(base::Bind(&SetTrue, &flushed));
+  message_loop_.RunUntilIdle();
+  EXPECT_TRUE(flushed);
+  EXPECT_EQ(1, commits_);
+  EXPECT_EQ(2u, last_num_ops_);
+
+  sql::Statement s(db_.GetUniqueStatement("SELECT b FROM foo WHERE a = 1"));
+  ASSERT_TRUE(s.Step());
+  EXPECT_EQ(12, s.ColumnInt(0));
+  EXPECT_EQ(2, CountFoo());
+}
+
+// Only one commit task is posted per batch, however many operations are
+// queued or replaced in it.
+TEST_F(SQLAsyncWriterTest, OneCommitTaskPerBatch) {
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner(
+      new base::TestSimpleTaskRunner);
+  scoped_refptr<sql::AsyncWriter> writer(new sql::AsyncWriter(
+      task_runner, &db_, 3, base::TimeDelta::FromHours(1)));
+
+  writer->Enqueue("1", base::Bind(&InsertRow, 1, 10));
+  writer->Enqueue("1", base::Bind(&InsertRow, 1, 11));
+  writer->Enqueue("1", base::Bind(&InsertRow, 1, 12));
+  writer->Enqueue("2", base::Bind(&InsertRow, 2, 20));
+  EXPECT_EQ(1u, task_runner->GetPendingTasks().size());
+
+  // Filling the batch commits it right away.
+  writer->Enqueue("3", base::Bind(&InsertRow, 3, 30));
+  ASSERT_EQ(2u, task_runner->GetPendingTasks().size());
+  EXPECT_EQ(base::TimeDelta(), task_runner->GetPendingTasks().back().delay);
+
+  // Replacing an operation in a full batch doesn't post another commit.
+  writer->Enqueue("3", base::Bind(&InsertRow, 3, 31));
+  EXPECT_EQ(2u, task_runner->GetPendingTasks().size());
+
+  task_runner->RunPendingTasks();
+  EXPECT_EQ(3, CountFoo());
+
+  // The next batch gets its own timer.
+  writer->Enqueue("4", base::Bind(&InsertRow, 4, 40));
+  writer->Enqueue("5", base::Bind(&InsertRow, 5, 50));
+  EXPECT_EQ(1u, task_runner->GetPendingTasks().size());
+
+  writer->Close();
+  task_runner->RunPendingTasks();
+  EXPECT_EQ(5, CountFoo());
+}
+
+// A failing operation is reported, but doesn't lose the rest of the batch.
+TEST_F(SQLAsyncWriterTest, FailedOperation) {
+  CreateWriter(100);
+
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 1, 10));
+  writer_->Enqueue(std::string(), base::Bind(&FailingOperation));
+  writer_->Flush(base::Closure());
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(1, commits_);
+  EXPECT_FALSE(last_success_);
+  EXPECT_EQ(1, CountFoo());
+}
+
+// Close() commits what is queued and drops anything queued afterwards.
+TEST_F(SQLAsyncWriterTest, Close) {
+  CreateWriter(100);
+
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 1, 10));
+  writer_->Close();
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(1, commits_);
+  EXPECT_EQ(1, CountFoo());
+
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 2, 20));
+  writer_->Flush(base::Closure());
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(1, commits_);
+  EXPECT_EQ(1, CountFoo());
+}
+
+// Operations committed without a connection are dropped.  Once one is set,
+// Commit() writes the queue right away.
+TEST_F(SQLAsyncWriterTest, SetConnection) {
+  writer_ = new sql::AsyncWriter(message_loop_.message_loop_proxy(),
+                                 NULL,
+                                 100,
+                                 base::TimeDelta::FromHours(1));
+
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 1, 10));
+  writer_->Commit();
+  EXPECT_EQ(0u, writer_->num_pending());
+  EXPECT_EQ(0, CountFoo());
+
+  writer_->SetConnection(&db_);
+  writer_->Enqueue(std::string(), base::Bind(&InsertRow, 2, 20));
+  writer_->Commit();
+  EXPECT_EQ(1, CountFoo());
+}
+
+}  // namespace
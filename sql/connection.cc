@@ -70,6 +70,46 @@ class ScopedWritableSchema {
   sqlite3* db_;
 };
 
+// Helper to take a database out of write-ahead logging for the duration of
+// Raze().  sqlite3_backup_*() can't change the page size of a database in WAL
+// mode (it fails with SQLITE_READONLY), and a stale -wal file must not be
+// replayed over the razed database.  Leaving WAL mode checkpoints the log and
+// deletes the -wal file.
+class ScopedRollbackJournal {
+ public:
+  explicit ScopedRollbackJournal(sqlite3* db)
+      : db_(db) {
+    sqlite3_exec(db_, "PRAGMA journal_mode=PERSIST", NULL, NULL, NULL);
+  }
+  ~ScopedRollbackJournal() {
+    sqlite3_exec(db_, "PRAGMA journal_mode=WAL", NULL, NULL, NULL);
+  }
+
+ private:
+  sqlite3* db_;
+};
+
+// Returns the path of the file backing the "main" database of |db|, which is
+// empty for an in-memory database.
+std::string GetMainDatabasePath(sqlite3* db) {
+  std::string path;
+  sqlite3_stmt* s = NULL;
+  if (sqlite3_prepare_v2(db, "PRAGMA database_list", -1, &s, NULL) !=
+      SQLITE_OK) {
+    return path;
+  }
+  while (sqlite3_step(s) == SQLITE_ROW) {
+    const char* name = reinterpret_cast<const char*>(sqlite3_column_text(s, 1));
+    const char* file = reinterpret_cast<const char*>(sqlite3_column_text(s, 2));
+    if (name && file && !strcmp(name, "main")) {
+      path = file;
+      break;
+    }
+  }
+  sqlite3_finalize(s);
+  return path;
+}
+
 // Helper to wrap the sqlite3_backup_*() step of Raze().  Return
 // SQLite error code from running the backup step.
 int BackupDatabase(sqlite3* src, sqlite3* dst, const char* db_name) {
@@ -215,6 +255,7 @@ Connection::Connection()
       page_size_(0),
       cache_size_(0),
       exclusive_locking_(false),
+      write_ahead_logging_(false),
       restrict_to_user_(false),
       transaction_nesting_(0),
       needs_rollback_(false),
@@ -441,6 +482,10 @@ bool Connection::Raze() {
   // page_size" can be used to query such a database.
   ScopedWritableSchema writable_schema(db_);
 
+  scoped_ptr<ScopedRollbackJournal> rollback_journal;
+  if (write_ahead_logging_)
+    rollback_journal.reset(new ScopedRollbackJournal(db_));
+
   const char* kMain = "main";
   int rc = BackupDatabase(null_db.db_, db_, kMain);
   UMA_HISTOGRAM_SPARSE_SLOWLY("Sqlite.RazeDatabase",rc);
@@ -471,6 +516,17 @@ bool Connection::Raze() {
       return false;
     }
 
+    // SQLite couldn't read the corrupt database's header, so it can't have
+    // left WAL mode above.  Remove any -wal file by hand so that it isn't
+    // replayed over the new database once WAL mode is turned back on.
+    if (write_ahead_logging_) {
+      const std::string path = GetMainDatabasePath(db_);
+      if (!path.empty()) {
+        base::DeleteFile(base::FilePath::FromUTF8Unsafe(path + "-wal"), false);
+        base::DeleteFile(base::FilePath::FromUTF8Unsafe(path + "-shm"), false);
+      }
+    }
+
     rc = BackupDatabase(null_db.db_, db_, kMain);
     UMA_HISTOGRAM_SPARSE_SLOWLY("Sqlite.RazeDatabase2",rc);
 
@@ -552,13 +608,16 @@ bool Connection::Delete(const base::FilePath& path) {
 
   base::FilePath journal_path(path.value() + FILE_PATH_LITERAL("-journal"));
   base::FilePath wal_path(path.value() + FILE_PATH_LITERAL("-wal"));
+  base::FilePath shm_path(path.value() + FILE_PATH_LITERAL("-shm"));
 
   base::DeleteFile(journal_path, false);
   base::DeleteFile(wal_path, false);
+  base::DeleteFile(shm_path, false);
   base::DeleteFile(path, false);
 
   return !base::PathExists(journal_path) &&
       !base::PathExists(wal_path) &&
+      !base::PathExists(shm_path) &&
       !base::PathExists(path);
 }
 
@@ -617,8 +676,15 @@ bool Connection::CommitTransaction() {
     return false;
   }
 
+  // The commit is where the journal is synced, so it's the statement slow
+  // disks make slow.
+  const base::TimeTicks before = base::TimeTicks::Now();
   Statement commit(GetCachedStatement(SQL_FROM_HERE, "COMMIT"));
-  return commit.Run();
+  bool ret = commit.Run();
+  const base::TimeDelta delta = base::TimeTicks::Now() - before;
+  UMA_HISTOGRAM_TIMES("Sqlite.CommitTime", delta);
+  AddTaggedTimeHistogram("Sqlite.CommitTime", delta);
+  return ret;
 }
 
 void Connection::RollbackAllTransactions() {
@@ -917,8 +983,10 @@ bool Connection::OpenInternal(const std::string& file_name,
       // be fatal unless the file doesn't exist.
       base::FilePath journal_path(file_name + FILE_PATH_LITERAL("-journal"));
       base::FilePath wal_path(file_name + FILE_PATH_LITERAL("-wal"));
+      base::FilePath shm_path(file_name + FILE_PATH_LITERAL("-shm"));
       base::SetPosixFilePermissions(journal_path, mode);
       base::SetPosixFilePermissions(wal_path, mode);
+      base::SetPosixFilePermissions(shm_path, mode);
     }
   }
 #endif  // defined(OS_POSIX)
@@ -974,10 +1042,19 @@ bool Connection::OpenInternal(const std::string& file_name,
   // TRUNCATE - truncate -journal file to commit.
   // PERSIST - zero out header of -journal file to commit.
   // journal_size_limit provides size to trim to in PERSIST.
+  // WAL - append to -wal file to commit (see set_write_ahead_logging()).
   // TODO(shess): Figure out if PERSIST and journal_size_limit really
   // matter.  In theory, it keeps pages pre-allocated, so if
   // transactions usually fit, it should be faster.
-  ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+  if (write_ahead_logging_) {
+    // In WAL mode, synchronous=NORMAL only syncs at checkpoints and is still
+    // safe from corruption.  journal_size_limit also truncates the -wal file
+    // after checkpoints.
+    ignore_result(Execute("PRAGMA journal_mode = WAL"));
+    ignore_result(Execute("PRAGMA synchronous = NORMAL"));
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+  }
   ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
 
   const base::TimeDelta kBusyTimeout =
@@ -1048,6 +1125,24 @@ void Connection::AddTaggedHistogram(const std::string& name,
     histogram->Add(sample);
 }
 
+void Connection::AddTaggedTimeHistogram(const std::string& name,
+                                        base::TimeDelta sample) const {
+  if (histogram_tag_.empty())
+    return;
+
+  // See the TODO in AddTaggedHistogram() about caching.
+  std::string full_histogram_name = name + "." + histogram_tag_;
+  base::HistogramBase* histogram =
+      base::Histogram::FactoryTimeGet(
+          full_histogram_name,
+          base::TimeDelta::FromMilliseconds(1),
+          base::TimeDelta::FromSeconds(10),
+          50,
+          base::HistogramBase::kUmaTargetedHistogramFlag);
+  if (histogram)
+    histogram->AddTime(sample);
+}
+
 int Connection::OnSqliteError(int err, sql::Statement *stmt, const char* sql) {
   UMA_HISTOGRAM_SPARSE_SLOWLY("Sqlite.Error", err);
   AddTaggedHistogram("Sqlite.Error", err);
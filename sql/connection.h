@@ -117,6 +117,17 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use write-ahead logging with "PRAGMA synchronous=NORMAL" instead
+  // of the default PERSIST rollback journal.  Commits then only append to the
+  // -wal file, and the database file is only synced when the log is
+  // checkpointed, which turns most commits from several fsyncs into none.  The
+  // cost is that the last transactions before a power failure may be lost
+  // (the database is never corrupted).  An existing database is converted
+  // (in either direction) the next time it is opened.
+  //
+  // This must be called before Open() to have an effect.
+  void set_write_ahead_logging() { write_ahead_logging_ = true; }
+
   // Call to cause Open() to restrict access permissions of the
   // database file to only the owner.
   // TODO(shess): Currently only supported on OS_POSIX, is a noop on
@@ -150,6 +161,10 @@ class SQL_EXPORT Connection {
   // histogram is recorded.
   void AddTaggedHistogram(const std::string& name, size_t sample) const;
 
+  // Like AddTaggedHistogram(), but records a timing sample.
+  void AddTaggedTimeHistogram(const std::string& name,
+                              base::TimeDelta sample) const;
+
   // Run "PRAGMA integrity_check" and post each line of
   // results into |messages|.  Returns the success of running the
   // statement - per the SQLite documentation, if no errors are found the
@@ -556,6 +571,7 @@ class SQL_EXPORT Connection {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool write_ahead_logging_;
   bool restrict_to_user_;
 
   // All cached statements. Keeping a reference to these statements means that
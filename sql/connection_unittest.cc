@@ -363,6 +363,53 @@ TEST_F(SQLConnectionTest, RazePageSize) {
   ASSERT_EQ(kPageSize, s.ColumnInt(0));
 }
 
+// Test that Raze() works on a database in WAL mode, even when the page size of
+// the database differs from that of the empty database it is razed to, and
+// that the database is still in WAL mode afterwards.
+TEST_F(SQLConnectionTest, RazeWriteAheadLogging) {
+  int default_page_size = 0;
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA page_size"));
+    ASSERT_TRUE(s.Step());
+    default_page_size = s.ColumnInt(0);
+  }
+  ASSERT_GT(default_page_size, 0);
+
+  const char* kCreateSql = "CREATE TABLE foo (id INTEGER PRIMARY KEY, value)";
+  db().Close();
+  {
+    sql::Connection other_db;
+    other_db.set_page_size(2 * default_page_size);
+    ASSERT_TRUE(other_db.Open(db_path()));
+    ASSERT_TRUE(other_db.Execute(kCreateSql));
+  }
+
+  db().set_write_ahead_logging();
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (value) VALUES (12)"));
+  ASSERT_EQ(1, SqliteMasterCount(&db()));
+
+  ASSERT_TRUE(db().Raze());
+  EXPECT_EQ(0, SqliteMasterCount(&db()));
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA page_size"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(default_page_size, s.ColumnInt(0));
+  }
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+
+  // The razed database is usable, and stays empty when reopened.
+  ASSERT_TRUE(db().Execute(kCreateSql));
+  ASSERT_TRUE(db().Raze());
+  db().Close();
+  ASSERT_TRUE(db().Open(db_path()));
+  EXPECT_EQ(0, SqliteMasterCount(&db()));
+}
+
 // Test that Raze() results are seen in other connections.
 TEST_F(SQLConnectionTest, RazeMultiple) {
   const char* kCreateSql = "CREATE TABLE foo (id INTEGER PRIMARY KEY, value)";
@@ -663,6 +710,38 @@ TEST_F(SQLConnectionTest, Delete) {
   EXPECT_FALSE(base::PathExists(journal));
 }
 
+// Test that set_write_ahead_logging() switches the journal to WAL, and that
+// Delete() cleans up the extra files WAL creates.
+TEST_F(SQLConnectionTest, WriteAheadLogging) {
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("persist", s.ColumnString(0));
+  }
+
+  db().Close();
+  db().set_write_ahead_logging();
+  ASSERT_TRUE(db().Open(db_path()));
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+
+  // Write something so that the -wal and -shm files exist.
+  EXPECT_TRUE(db().Execute("CREATE TABLE x (x)"));
+  base::FilePath wal(db_path().value() + FILE_PATH_LITERAL("-wal"));
+  base::FilePath shm(db_path().value() + FILE_PATH_LITERAL("-shm"));
+  ASSERT_TRUE(base::PathExists(wal));
+  ASSERT_TRUE(base::PathExists(shm));
+
+  db().Close();
+  sql::Connection::Delete(db_path());
+  EXPECT_FALSE(base::PathExists(db_path()));
+  EXPECT_FALSE(base::PathExists(wal));
+  EXPECT_FALSE(base::PathExists(shm));
+}
+
 #if defined(OS_POSIX)
 // Test that set_restrict_to_user() trims database permissions so that
 // only the owner (and root) can read.
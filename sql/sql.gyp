@@ -20,6 +20,8 @@
       ],
       'defines': [ 'SQL_IMPLEMENTATION' ],
       'sources': [
+        'async_writer.cc',
+        'async_writer.h',
         'connection.cc',
         'connection.h',
         'error_delegate_util.cc',
@@ -86,6 +88,7 @@
         '../third_party/sqlite/sqlite.gyp:sqlite',
       ],
       'sources': [
+        'async_writer_unittest.cc',
         'connection_unittest.cc',
         'meta_table_unittest.cc',
         'recovery_unittest.cc',
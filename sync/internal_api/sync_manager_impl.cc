@@ -122,6 +122,8 @@ class NudgeStrategy {
      case AUTOFILL:
        return ACCOMPANY_ONLY;
      case PREFERENCES:
+     case EXTENSION_SETTINGS:
+     case APP_SETTINGS:
      case SESSIONS:
      case FAVICON_IMAGES:
      case FAVICON_TRACKING:
@@ -148,6 +150,10 @@ class NudgeStrategy {
      case CUSTOM:
        switch (model_type) {
          case PREFERENCES:
+         // Extensions tend to write their settings in bursts of small
+         // changes, each of which would otherwise get a commit of its own.
+         case EXTENSION_SETTINGS:
+         case APP_SETTINGS:
            delay = TimeDelta::FromMilliseconds(
                kPreferencesNudgeDelayMilliseconds);
            break;
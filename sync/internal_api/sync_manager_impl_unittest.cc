@@ -1673,6 +1673,14 @@ TEST_F(SyncManagerTest, NudgeDelayTest) {
   EXPECT_EQ(sync_manager_.GetNudgeDelayTimeDelta(PREFERENCES),
       base::TimeDelta::FromMilliseconds(
           SyncManagerImpl::GetPreferencesNudgeDelay()));
+
+  EXPECT_EQ(sync_manager_.GetNudgeDelayTimeDelta(EXTENSION_SETTINGS),
+      base::TimeDelta::FromMilliseconds(
+          SyncManagerImpl::GetPreferencesNudgeDelay()));
+
+  EXPECT_EQ(sync_manager_.GetNudgeDelayTimeDelta(APP_SETTINGS),
+      base::TimeDelta::FromMilliseconds(
+          SyncManagerImpl::GetPreferencesNudgeDelay()));
 }
 
 // Friended by WriteNode, so can't be in an anonymouse namespace.
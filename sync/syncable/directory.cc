@@ -8,6 +8,7 @@
 
 #include "base/base64.h"
 #include "base/debug/trace_event.h"
+#include "base/metrics/histogram.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "sync/internal_api/public/base/unique_position.h"
@@ -451,6 +452,7 @@ bool Directory::SafeToPurgeFromMemory(WriteTransaction* trans,
 void Directory::TakeSnapshotForSaveChanges(SaveChangesSnapshot* snapshot) {
   ReadTransaction trans(FROM_HERE, this);
   ScopedKernelLock lock(this);
+  const base::TimeTicks start_time = base::TimeTicks::Now();
 
   // If there is an unrecoverable error then just bail out.
   if (unrecoverable_error_set(&trans))
@@ -492,6 +494,15 @@ void Directory::TakeSnapshotForSaveChanges(SaveChangesSnapshot* snapshot) {
 
   delete_journal_->TakeSnapshotAndClear(
       &trans, &snapshot->delete_journals, &snapshot->delete_journals_to_purge);
+
+  // Everything above runs with the kernel lock held and blocks all other
+  // transactions on the share, so keep an eye on how long it takes.
+  UMA_HISTOGRAM_TIMES("Sync.DirectorySaveChangesSnapshotTime",
+                      base::TimeTicks::Now() - start_time);
+  if (!snapshot->dirty_metas.empty()) {
+    UMA_HISTOGRAM_COUNTS("Sync.DirectorySaveChangesDirtyEntries",
+                         snapshot->dirty_metas.size());
+  }
 }
 
 bool Directory::SaveChanges() {
@@ -502,7 +513,12 @@ bool Directory::SaveChanges() {
   // Snapshot and save.
   SaveChangesSnapshot snapshot;
   TakeSnapshotForSaveChanges(&snapshot);
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   success = store_->SaveChanges(snapshot);
+  if (!snapshot.dirty_metas.empty()) {
+    UMA_HISTOGRAM_TIMES("Sync.DirectorySaveChangesWriteTime",
+                        base::TimeTicks::Now() - start_time);
+  }
 
   // Handle success or failure.
   if (success)
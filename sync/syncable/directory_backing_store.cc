@@ -6,6 +6,8 @@
 
 #include "build/build_config.h"
 
+#include <string.h>
+
 #include <limits>
 
 #include "base/base64.h"
@@ -98,8 +100,26 @@ scoped_ptr<EntryKernel> UnpackEntry(sql::Statement* statement) {
                 statement->ColumnString(i));
   }
   for ( ; i < PROTO_FIELDS_END; ++i) {
-    kernel->mutable_ref(static_cast<ProtoField>(i)).ParseFromArray(
-        statement->ColumnBlob(i), statement->ColumnByteLength(i));
+    const int length = statement->ColumnByteLength(i);
+    if (!length)
+      continue;  // Leave the default value.
+    const void* blob = statement->ColumnBlob(i);
+    // Let identical specifics share one copy in memory rather than parsing
+    // the same bytes again.
+    int same_as = PROTO_FIELDS_BEGIN;
+    while (same_as < i &&
+           (statement->ColumnByteLength(same_as) != length ||
+            memcmp(statement->ColumnBlob(same_as), blob, length) != 0)) {
+      ++same_as;
+    }
+    if (same_as < i) {
+      kernel->put(static_cast<ProtoField>(i),
+                  kernel->ref(static_cast<ProtoField>(same_as)));
+    } else {
+      sync_pb::EntitySpecifics specifics;
+      specifics.ParseFromArray(blob, length);
+      kernel->put(static_cast<ProtoField>(i), specifics);
+    }
   }
   for ( ; i < UNIQUE_POSITION_FIELDS_END; ++i) {
     std::string temp;
@@ -21,6 +21,34 @@ EntryKernel::EntryKernel() : dirty_(false) {
 
 EntryKernel::~EntryKernel() {}
 
+void EntryKernel::put(ProtoField field,
+                      const sync_pb::EntitySpecifics& value) {
+  scoped_refptr<SharedSpecifics>& specifics =
+      specifics_fields[field - PROTO_FIELDS_BEGIN];
+  for (int i = 0; i < PROTO_FIELDS_COUNT; ++i) {
+    if (specifics_fields[i].get() && &specifics_fields[i]->data == &value) {
+      specifics = specifics_fields[i];
+      return;
+    }
+  }
+  // Overwrite in place when nothing else can see the old value.
+  if (specifics.get() && specifics->HasOneRef())
+    specifics->data.CopyFrom(value);
+  else
+    specifics = new SharedSpecifics(value);
+}
+
+bool EntryKernel::SpecificsEquals(
+    ProtoField field,
+    const sync_pb::EntitySpecifics& value) const {
+  const sync_pb::EntitySpecifics& specifics = ref(field);
+  if (&specifics == &value)
+    return true;
+  if (specifics.ByteSize() != value.ByteSize())
+    return false;
+  return specifics.SerializeAsString() == value.SerializeAsString();
+}
+
 ModelType EntryKernel::GetModelType() const {
   ModelType specifics_type = GetModelTypeFromSpecifics(ref(SPECIFICS));
   if (specifics_type != UNSPECIFIED)
@@ -7,6 +7,7 @@
 
 #include <set>
 
+#include "base/memory/ref_counted.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "sync/base/sync_export.h"
@@ -177,8 +178,14 @@ enum {
 
 struct SYNC_EXPORT_PRIVATE EntryKernel {
  private:
+  // Synced entries usually have the same SPECIFICS and SERVER_SPECIFICS, so
+  // proto fields are shared between fields (and between copies of the
+  // kernel, e.g. in SaveChanges snapshots) and copied only when written.
+  // A NULL field holds the default value.
+  typedef base::RefCountedData<sync_pb::EntitySpecifics> SharedSpecifics;
+
   std::string string_fields[STRING_FIELDS_COUNT];
-  sync_pb::EntitySpecifics specifics_fields[PROTO_FIELDS_COUNT];
+  scoped_refptr<SharedSpecifics> specifics_fields[PROTO_FIELDS_COUNT];
   int64 int64_fields[INT64_FIELDS_COUNT];
   base::Time time_fields[TIME_FIELDS_COUNT];
   Id id_fields[ID_FIELDS_COUNT];
@@ -247,9 +254,9 @@ struct SYNC_EXPORT_PRIVATE EntryKernel {
   inline void put(StringField field, const std::string& value) {
     string_fields[field - STRING_FIELDS_BEGIN] = value;
   }
-  inline void put(ProtoField field, const sync_pb::EntitySpecifics& value) {
-    specifics_fields[field - PROTO_FIELDS_BEGIN].CopyFrom(value);
-  }
+  // If |value| is another proto field of this kernel, the two fields end up
+  // sharing one copy.
+  void put(ProtoField field, const sync_pb::EntitySpecifics& value);
   inline void put(UniquePositionField field, const UniquePosition& value) {
     unique_position_fields[field - UNIQUE_POSITION_FIELDS_BEGIN] = value;
   }
@@ -286,7 +293,10 @@ struct SYNC_EXPORT_PRIVATE EntryKernel {
     return string_fields[field - STRING_FIELDS_BEGIN];
   }
   inline const sync_pb::EntitySpecifics& ref(ProtoField field) const {
-    return specifics_fields[field - PROTO_FIELDS_BEGIN];
+    const SharedSpecifics* specifics =
+        specifics_fields[field - PROTO_FIELDS_BEGIN].get();
+    return specifics ? specifics->data
+                     : sync_pb::EntitySpecifics::default_instance();
   }
   inline const UniquePosition& ref(UniquePositionField field) const {
     return unique_position_fields[field - UNIQUE_POSITION_FIELDS_BEGIN];
@@ -299,9 +309,6 @@ struct SYNC_EXPORT_PRIVATE EntryKernel {
   inline std::string& mutable_ref(StringField field) {
     return string_fields[field - STRING_FIELDS_BEGIN];
   }
-  inline sync_pb::EntitySpecifics& mutable_ref(ProtoField field) {
-    return specifics_fields[field - PROTO_FIELDS_BEGIN];
-  }
   inline Id& mutable_ref(IdField field) {
     return id_fields[field - ID_FIELDS_BEGIN];
   }
@@ -309,6 +316,12 @@ struct SYNC_EXPORT_PRIVATE EntryKernel {
     return unique_position_fields[field - UNIQUE_POSITION_FIELDS_BEGIN];
   }
 
+  // Returns true if |field| holds the same specifics as |value|.  Cheaper
+  // than comparing serializations when the two are shared or differ in size,
+  // as for every update received during an initial sync.
+  bool SpecificsEquals(ProtoField field,
+                       const sync_pb::EntitySpecifics& value) const;
+
   ModelType GetModelType() const;
   ModelType GetServerModelType() const;
   bool ShouldMaintainPosition() const;
@@ -297,10 +297,7 @@ void ModelNeutralMutableEntry::PutServerSpecifics(
   DCHECK(kernel_);
   CHECK(!value.password().has_client_only_encrypted_data());
   base_write_transaction_->TrackChangesTo(kernel_);
-  // TODO(ncarter): This is unfortunately heavyweight.  Can we do
-  // better?
-  if (kernel_->ref(SERVER_SPECIFICS).SerializeAsString() !=
-      value.SerializeAsString()) {
+  if (!kernel_->SpecificsEquals(SERVER_SPECIFICS, value)) {
     if (kernel_->ref(IS_UNAPPLIED_UPDATE)) {
       // Remove ourselves from unapplied_update_metahandles with our
       // old server type.
@@ -331,10 +328,7 @@ void ModelNeutralMutableEntry::PutBaseServerSpecifics(
   DCHECK(kernel_);
   CHECK(!value.password().has_client_only_encrypted_data());
   base_write_transaction_->TrackChangesTo(kernel_);
-  // TODO(ncarter): This is unfortunately heavyweight.  Can we do
-  // better?
-  if (kernel_->ref(BASE_SERVER_SPECIFICS).SerializeAsString()
-      != value.SerializeAsString()) {
+  if (!kernel_->SpecificsEquals(BASE_SERVER_SPECIFICS, value)) {
     kernel_->put(BASE_SERVER_SPECIFICS, value);
     kernel_->mark_dirty(&dir()->kernel_->dirty_metahandles);
   }
@@ -202,10 +202,7 @@ void MutableEntry::PutSpecifics(const sync_pb::EntitySpecifics& value) {
   DCHECK(kernel_);
   CHECK(!value.password().has_client_only_encrypted_data());
   write_transaction()->TrackChangesTo(kernel_);
-  // TODO(ncarter): This is unfortunately heavyweight.  Can we do
-  // better?
-  if (kernel_->ref(SPECIFICS).SerializeAsString() !=
-      value.SerializeAsString()) {
+  if (!kernel_->SpecificsEquals(SPECIFICS, value)) {
     kernel_->put(SPECIFICS, value);
     kernel_->mark_dirty(&dir()->kernel_->dirty_metahandles);
   }
@@ -62,6 +62,48 @@ TEST_F(SyncableKernelTest, ToValue) {
   }
 }
 
+// Tests that proto fields copied from each other share storage, without
+// changing what each field reads back when one of them is written.
+TEST_F(SyncableKernelTest, SharedSpecifics) {
+  EntryKernel kernel;
+  EXPECT_EQ(0, kernel.ref(SPECIFICS).ByteSize());
+
+  sync_pb::EntitySpecifics specifics;
+  specifics.mutable_bookmark()->set_url("http://www.google.com");
+  kernel.put(SERVER_SPECIFICS, specifics);
+  kernel.put(SPECIFICS, kernel.ref(SERVER_SPECIFICS));
+  EXPECT_EQ(&kernel.ref(SERVER_SPECIFICS), &kernel.ref(SPECIFICS));
+
+  // Copies of the kernel share it too.
+  EntryKernel copy(kernel);
+  EXPECT_EQ(&kernel.ref(SPECIFICS), &copy.ref(SPECIFICS));
+
+  specifics.mutable_bookmark()->set_url("http://www.example.com");
+  kernel.put(SPECIFICS, specifics);
+  EXPECT_EQ("http://www.example.com", kernel.ref(SPECIFICS).bookmark().url());
+  EXPECT_EQ("http://www.google.com",
+            kernel.ref(SERVER_SPECIFICS).bookmark().url());
+  EXPECT_EQ("http://www.google.com", copy.ref(SPECIFICS).bookmark().url());
+  EXPECT_EQ("http://www.google.com",
+            copy.ref(SERVER_SPECIFICS).bookmark().url());
+}
+
+TEST_F(SyncableKernelTest, SpecificsEquals) {
+  EntryKernel kernel;
+  sync_pb::EntitySpecifics specifics;
+  EXPECT_TRUE(kernel.SpecificsEquals(SPECIFICS, specifics));
+
+  specifics.mutable_bookmark()->set_url("http://www.google.com");
+  EXPECT_FALSE(kernel.SpecificsEquals(SPECIFICS, specifics));
+  kernel.put(SPECIFICS, specifics);
+  EXPECT_TRUE(kernel.SpecificsEquals(SPECIFICS, specifics));
+  EXPECT_TRUE(kernel.SpecificsEquals(SPECIFICS, kernel.ref(SPECIFICS)));
+
+  // Same size, different contents.
+  specifics.mutable_bookmark()->set_url("http://www.goggle.com");
+  EXPECT_FALSE(kernel.SpecificsEquals(SPECIFICS, specifics));
+}
+
 namespace {
 void PutDataAsBookmarkFavicon(WriteTransaction* wtrans,
                               MutableEntry* e,
@@ -92,18 +92,24 @@ bool RE2::Set::Compile() {
 }
 
 bool RE2::Set::Match(const StringPiece& text, vector<int>* v) const {
+  bool failed;
+  bool ret = Match(text, v, &failed);
+  if (failed)
+    LOG(DFATAL) << "RE2::Set::Match: DFA ran out of cache space";
+  return ret;
+}
+
+bool RE2::Set::Match(const StringPiece& text, vector<int>* v,
+                     bool* dfa_failed) const {
+  *dfa_failed = false;
   if (!compiled_) {
     LOG(DFATAL) << "RE2::Set::Match without Compile";
     return false;
   }
   v->clear();
-  bool failed;
   bool ret = prog_->SearchDFA(text, text, Prog::kAnchored,
-                              Prog::kManyMatch, NULL, &failed, v);
-  if (failed)
-    LOG(DFATAL) << "RE2::Set::Match: DFA ran out of cache space";
-
-  if (ret == false)
+                              Prog::kManyMatch, NULL, dfa_failed, v);
+  if (*dfa_failed || ret == false)
     return false;
   if (v->size() == 0) {
     LOG(DFATAL) << "RE2::Set::Match: match but unknown regexp set";
@@ -39,6 +39,11 @@ class RE2::Set {
   // If so, it fills v with the indices of the matching regexps.
   bool Match(const StringPiece& text, vector<int>* v) const;
 
+  // Like Match, but if the DFA runs out of memory, sets *dfa_failed and
+  // returns false instead of logging a DFATAL.  The caller must then
+  // match text some other way.
+  bool Match(const StringPiece& text, vector<int>* v, bool* dfa_failed) const;
+
  private:
   RE2::Options options_;
   RE2::Anchor anchor_;
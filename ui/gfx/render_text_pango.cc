@@ -77,6 +77,8 @@ RenderTextPango::RenderTextPango()
 
 RenderTextPango::~RenderTextPango() {
   ResetLayout();
+  if (layout_)
+    g_object_unref(layout_);
 }
 
 Size RenderTextPango::GetStringSize() {
@@ -282,11 +284,9 @@ bool RenderTextPango::IsCursorablePosition(size_t position) {
 void RenderTextPango::ResetLayout() {
   // set_cached_bounds_and_offset_valid(false) is done in RenderText for every
   // operation that triggers ResetLayout().
-  if (layout_) {
-    // TODO(msw): Keep |layout_| across text changes, etc.; it can be re-used.
-    g_object_unref(layout_);
-    layout_ = NULL;
-  }
+  // |layout_| itself is kept, and set up again by the next EnsureLayout(), to
+  // save creating a new Cairo context, Pango context and layout every time the
+  // text or its style changes.
   if (current_line_) {
     pango_layout_line_unref(current_line_);
     current_line_ = NULL;
@@ -300,17 +300,19 @@ void RenderTextPango::ResetLayout() {
 }
 
 void RenderTextPango::EnsureLayout() {
-  if (layout_ == NULL) {
-    cairo_surface_t* surface =
-        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 0, 0);
-    CHECK_EQ(CAIRO_STATUS_SUCCESS, cairo_surface_status(surface));
-    cairo_t* cr = cairo_create(surface);
-    CHECK_EQ(CAIRO_STATUS_SUCCESS, cairo_status(cr));
-
-    layout_ = pango_cairo_create_layout(cr);
-    CHECK_NE(static_cast<PangoLayout*>(NULL), layout_);
-    cairo_destroy(cr);
-    cairo_surface_destroy(surface);
+  if (current_line_ == NULL) {
+    if (layout_ == NULL) {
+      cairo_surface_t* surface =
+          cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 0, 0);
+      CHECK_EQ(CAIRO_STATUS_SUCCESS, cairo_surface_status(surface));
+      cairo_t* cr = cairo_create(surface);
+      CHECK_EQ(CAIRO_STATUS_SUCCESS, cairo_status(cr));
+
+      layout_ = pango_cairo_create_layout(cr);
+      CHECK_NE(static_cast<PangoLayout*>(NULL), layout_);
+      cairo_destroy(cr);
+      cairo_surface_destroy(surface);
+    }
 
     SetupPangoLayoutWithFontDescription(layout_,
                                         GetLayoutText(),
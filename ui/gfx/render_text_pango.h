@@ -67,9 +67,11 @@ class RenderTextPango : public RenderText {
   // Get the text index corresponding to the |run|'s |glyph_index|.
   size_t GetGlyphTextIndex(PangoLayoutRun* run, int glyph_index) const;
 
-  // Pango Layout.
+  // Pango Layout. Kept across ResetLayout() calls, so it is only up to date
+  // while |current_line_| is set.
   PangoLayout* layout_;
-  // A single line layout resulting from laying out via |layout_|.
+  // A single line layout resulting from laying out via |layout_|. NULL when
+  // |layout_| needs to be set up again.
   PangoLayoutLine* current_line_;
 
   // Information about character attributes.
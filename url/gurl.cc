@@ -19,6 +19,22 @@
 
 namespace {
 
+// The most capacity a spec may have beyond its length before it is
+// reallocated to fit.
+const size_t kMaxSpecSlack = 64;
+
+// Canonicalizing reserves some room for the output to grow, and doubles the
+// buffer when that isn't enough. Gives back the room when there is a lot of
+// it, since GURLs are often kept for a long time (history, the cache,
+// navigation entries).
+void ShrinkSpecIfOversized(std::string* spec) {
+  if (spec->capacity() > spec->size() + kMaxSpecSlack) {
+    // Copy the characters rather than the string, which may share its
+    // buffer.
+    std::string(spec->data(), spec->size()).swap(*spec);
+  }
+}
+
 static std::string* empty_string = NULL;
 static GURL* empty_gurl = NULL;
 
@@ -113,6 +129,7 @@ void GURL::InitCanonical(const STR& input_spec, bool trim_path_end) {
       NULL, &output, &parsed_);
 
   output.Complete();  // Must be done before using string.
+  ShrinkSpecIfOversized(&spec_);
   if (is_valid_ && SchemeIsFileSystem()) {
     inner_url_.reset(new GURL(spec_.data(), parsed_.Length(),
                               *parsed_.inner_parsed(), true));
@@ -207,6 +224,7 @@ GURL GURL::ResolveWithCharsetConverter(
   }
 
   output.Complete();
+  ShrinkSpecIfOversized(&result.spec_);
   result.is_valid_ = true;
   if (result.SchemeIsFileSystem()) {
     result.inner_url_.reset(
@@ -240,6 +258,7 @@ GURL GURL::ResolveWithCharsetConverter(
   }
 
   output.Complete();
+  ShrinkSpecIfOversized(&result.spec_);
   result.is_valid_ = true;
   if (result.SchemeIsFileSystem()) {
     result.inner_url_.reset(
@@ -268,6 +287,7 @@ GURL GURL::ReplaceComponents(
       NULL, &output, &result.parsed_);
 
   output.Complete();
+  ShrinkSpecIfOversized(&result.spec_);
   if (result.is_valid_ && result.SchemeIsFileSystem()) {
     result.inner_url_.reset(new GURL(spec_.data(), result.parsed_.Length(),
                                      *result.parsed_.inner_parsed(), true));
@@ -294,6 +314,7 @@ GURL GURL::ReplaceComponents(
       NULL, &output, &result.parsed_);
 
   output.Complete();
+  ShrinkSpecIfOversized(&result.spec_);
   if (result.is_valid_ && result.SchemeIsFileSystem()) {
     result.inner_url_.reset(new GURL(spec_.data(), result.parsed_.Length(),
                                      *result.parsed_.inner_parsed(), true));
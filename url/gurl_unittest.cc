@@ -564,3 +564,19 @@ TEST(GURLTest, SchemeIsWSOrWSS) {
   EXPECT_TRUE(GURL("wss://bar/").SchemeIsWSOrWSS());
   EXPECT_FALSE(GURL("http://bar/").SchemeIsWSOrWSS());
 }
+
+// Tests that a spec that grew a lot while being canonicalized doesn't keep
+// the room it grew into.
+TEST(GURLTest, SpecCapacity) {
+  std::string relative = "x" + std::string(1000, ' ') + "end";
+  std::string input = "http://www.google.com/" + relative;
+  GURL url(input);
+  ASSERT_TRUE(url.is_valid());
+  EXPECT_EQ(3026u, url.spec().size());
+  EXPECT_GE(url.spec().size() + 64, url.spec().capacity());
+
+  GURL resolved = GURL("http://www.google.com/").Resolve(relative);
+  ASSERT_TRUE(resolved.is_valid());
+  EXPECT_EQ(url.spec(), resolved.spec());
+  EXPECT_GE(resolved.spec().size() + 64, resolved.spec().capacity());
+}
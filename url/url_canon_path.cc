@@ -162,6 +162,27 @@ void BackUpToPreviousSlash(int path_begin_in_output,
   output->set_length(i + 1);
 }
 
+// Returns true if |uch| is copied to the output unchanged when it appears in
+// a path, without needing any of the special handling in DoPartialPath.
+template<typename UCHAR>
+inline bool IsOrdinaryPathChar(UCHAR uch) {
+  return uch < 0x80 &&
+      !(kPathCharLookup[static_cast<unsigned char>(uch)] & SPECIAL);
+}
+
+// Appends the characters of |spec| in [begin, end), which must all be
+// ordinary path characters, to the output.
+inline void AppendPathRun(const char* spec, int begin, int end,
+                          CanonOutput* output) {
+  output->Append(&spec[begin], end - begin);
+}
+
+inline void AppendPathRun(const base::char16* spec, int begin, int end,
+                          CanonOutput* output) {
+  for (int i = begin; i < end; i++)
+    output->push_back(static_cast<char>(spec[i]));
+}
+
 // Appends the given path to the output. It assumes that if the input path
 // starts with a slash, it should be copied to the output. If no path has
 // already been appended to the output (the case when not resolving
@@ -285,8 +306,15 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character, so append it along with the
+        // ordinary characters following it. Most paths are already
+        // canonical and are copied in a few such runs.
+        int run_end = i + 1;
+        while (run_end < end &&
+               IsOrdinaryPathChar(static_cast<UCHAR>(spec[run_end])))
+          run_end++;
+        AppendPathRun(spec, i, run_end, output);
+        i = run_end - 1;
       }
     }
   }
@@ -1103,6 +1103,9 @@ TEST(URLCanonTest, Path) {
 
     // ----- escaping tests -----
     {"/foo", L"/foo", "/foo", url_parse::Component(0, 4), true},
+      // Runs of ordinary characters around ones that need handling.
+    {"/foo/bar/./baz.html", L"/foo/bar/./baz.html", "/foo/bar/baz.html", url_parse::Component(0, 17), true},
+    {"/foo bar\\baz/qux", L"/foo bar\\baz/qux", "/foo%20bar/baz/qux", url_parse::Component(0, 18), true},
       // Valid escape sequence
     {"/%20foo", L"/%20foo", "/%20foo", url_parse::Component(0, 7), true},
       // Invalid escape sequence we should pass through unchanged.
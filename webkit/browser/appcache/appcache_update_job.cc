@@ -113,7 +113,8 @@ AppCacheUpdateJob::URLFetcher::URLFetcher(const GURL& url,
       buffer_(new net::IOBuffer(kBufferSize)),
       request_(job->service_->request_context()
                    ->CreateRequest(url, net::DEFAULT_PRIORITY, this)),
-      result_(UPDATE_OK) {}
+      result_(UPDATE_OK),
+      matched_existing_response_(false) {}
 
 AppCacheUpdateJob::URLFetcher::~URLFetcher() {
 }
@@ -162,6 +163,17 @@ void AppCacheUpdateJob::URLFetcher::OnResponseStarted(
       }
     }
 
+    // Servers that ignore our conditional headers still tend to send the
+    // same ETag for content that hasn't changed. Keep the response we
+    // already have rather than storing another copy of it.
+    if (fetch_type_ == URL_FETCH &&
+        MatchesExistingResponse(request->response_headers())) {
+      request->Cancel();
+      matched_existing_response_ = true;
+      OnResponseCompleted();
+      return;
+    }
+
     // Write response info to storage for URL fetches. Wait for async write
     // completion before reading any response data.
     if (fetch_type_ == URL_FETCH || fetch_type_ == MASTER_ENTRY_FETCH) {
@@ -235,6 +247,26 @@ void AppCacheUpdateJob::URLFetcher::AddConditionalHeaders(
     request_->SetExtraRequestHeaders(extra_headers);
 }
 
+bool AppCacheUpdateJob::URLFetcher::MatchesExistingResponse(
+    const net::HttpResponseHeaders* headers) {
+  if (!existing_entry_.has_response_id() ||
+      !existing_response_headers_.get() || !headers) {
+    return false;
+  }
+
+  // Only strong validators identify the exact bytes of a representation.
+  const std::string etag = "ETag";
+  std::string existing_etag;
+  existing_response_headers_->EnumerateHeader(NULL, etag, &existing_etag);
+  if (existing_etag.empty() ||
+      StartsWithASCII(existing_etag, "W/", true)) {
+    return false;
+  }
+  std::string new_etag;
+  headers->EnumerateHeader(NULL, etag, &new_etag);
+  return new_etag == existing_etag;
+}
+
 void  AppCacheUpdateJob::URLFetcher::OnWriteComplete(int result) {
   if (result < 0) {
     request_->Cancel();
@@ -579,7 +611,12 @@ void AppCacheUpdateJob::HandleUrlFetchCompleted(URLFetcher* fetcher) {
       ? request->GetResponseCode() : -1;
   AppCacheEntry& entry = url_file_list_.find(url)->second;
 
-  if (response_code / 100 == 2) {
+  if (fetcher->matched_existing_response()) {
+    // Keep the existing response.
+    entry.set_response_id(fetcher->existing_entry().response_id());
+    entry.set_response_size(fetcher->existing_entry().response_size());
+    inprogress_cache_->AddOrModifyEntry(url, entry);
+  } else if (response_code / 100 == 2) {
     // Associate storage with the new entry.
     DCHECK(fetcher->response_writer());
     entry.set_response_id(fetcher->response_writer()->response_id());
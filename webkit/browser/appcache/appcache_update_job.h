@@ -126,6 +126,11 @@ class WEBKIT_STORAGE_BROWSER_EXPORT AppCacheUpdateJob
       existing_entry_ = entry;
     }
     ResultType result() const { return result_; }
+    // True if a URL fetch was stopped because the server sent the same
+    // representation as |existing_entry_|.
+    bool matched_existing_response() const {
+      return matched_existing_response_;
+    }
 
    private:
     // URLRequest::Delegate overrides
@@ -137,6 +142,7 @@ class WEBKIT_STORAGE_BROWSER_EXPORT AppCacheUpdateJob
                                  int bytes_read) OVERRIDE;
 
     void AddConditionalHeaders(const net::HttpResponseHeaders* headers);
+    bool MatchesExistingResponse(const net::HttpResponseHeaders* headers);
     void OnWriteComplete(int result);
     void ReadResponseData();
     bool ConsumeResponseData(int bytes_read);
@@ -153,6 +159,7 @@ class WEBKIT_STORAGE_BROWSER_EXPORT AppCacheUpdateJob
     scoped_refptr<net::HttpResponseHeaders> existing_response_headers_;
     std::string manifest_data_;
     ResultType result_;
+    bool matched_existing_response_;
     scoped_ptr<AppCacheResponseWriter> response_writer_;
   };  // class URLFetcher
 
@@ -89,6 +89,10 @@ class MockHttpServer {
         "HTTP/1.1 200 OK\0"
         "Cache-Control: no-store\0"
         "\0";
+    const char etag_headers[] =
+        "HTTP/1.1 200 OK\0"
+        "ETag: \"Unchanged\"\0"
+        "\0";
 
     if (path == "/files/missing-mime-manifest") {
       (*headers) = std::string(ok_headers, arraysize(ok_headers));
@@ -165,6 +169,13 @@ class MockHttpServer {
       (*body) = "CACHE MANIFEST\n"
                 "CHROMIUM-INTERCEPT:\n"
                 "intercept1 return intercept1a\n";
+    } else if (path == "/files/manifest-unchanged-etag") {
+      (*headers) = std::string(manifest_headers, arraysize(manifest_headers));
+      (*body) = "CACHE MANIFEST\n"
+                "unchanged-etag\n";
+    } else if (path == "/files/unchanged-etag") {
+      (*headers) = std::string(etag_headers, arraysize(etag_headers));
+      (*body) = "unchanged-etag";
     } else if (path == "/files/notmodified") {
       (*headers) = std::string(not_modified_headers,
                                arraysize(not_modified_headers));
@@ -1586,6 +1597,57 @@ class AppCacheUpdateJobTest : public testing::Test,
     WaitForUpdateToFinish();
   }
 
+  void UpgradeUnchangedETagTest() {
+    ASSERT_TRUE(base::MessageLoopForIO::IsCurrent());
+
+    MakeService();
+    const GURL kManifestUrl =
+        MockHttpServer::GetMockUrl("files/manifest-unchanged-etag");
+    group_ = new AppCacheGroup(
+        service_->storage(), kManifestUrl,
+        service_->storage()->NewGroupId());
+    AppCacheUpdateJob* update =
+        new AppCacheUpdateJob(service_.get(), group_.get());
+    group_->update_job_ = update;
+
+    AppCache* cache = MakeCacheForGroup(service_->storage()->NewCacheId(), 25);
+    MockFrontend* frontend = MakeMockFrontend();
+    AppCacheHost* host = MakeHost(1, frontend);
+    host->AssociateCompleteCache(cache);
+
+    cache->AddEntry(
+        MockHttpServer::GetMockUrl("files/unchanged-etag"),
+        AppCacheEntry(AppCacheEntry::EXPLICIT, 555));
+
+    // The mock server answers with a 200 and the same ETag, as servers that
+    // don't support If-None-Match do, so the existing response is reused.
+    const char kData[] =
+        "HTTP/1.1 200 OK\0"
+        "ETag: \"Unchanged\"\0"
+        "\0";
+    MakeAppCacheResponseInfo(kManifestUrl, 555,
+                             std::string(kData, arraysize(kData)));
+
+    update->StartUpdate(NULL, GURL());
+    EXPECT_TRUE(update->manifest_fetcher_ != NULL);
+
+    // Set up checks for when update job finishes.
+    do_checks_after_update_finished_ = true;
+    expect_group_obsolete_ = false;
+    expect_group_has_cache_ = true;
+    expect_old_cache_ = cache;
+    expect_response_ids_.insert(std::map<GURL, int64>::value_type(
+        MockHttpServer::GetMockUrl("files/unchanged-etag"), 555));  // copied
+    MockFrontend::HostIds ids(1, host->host_id());
+    frontend->AddExpectedEvent(ids, CHECKING_EVENT);
+    frontend->AddExpectedEvent(ids, DOWNLOADING_EVENT);
+    frontend->AddExpectedEvent(ids, PROGRESS_EVENT);  // unchanged-etag
+    frontend->AddExpectedEvent(ids, PROGRESS_EVENT);  // final
+    frontend->AddExpectedEvent(ids, UPDATE_READY_EVENT);
+
+    WaitForUpdateToFinish();
+  }
+
   void EmptyManifestTest() {
     ASSERT_TRUE(base::MessageLoopForIO::IsCurrent());
 
@@ -3564,6 +3626,10 @@ TEST_F(AppCacheUpdateJobTest, UpgradeFailMasterUrlFetch) {
   RunTestOnIOThread(&AppCacheUpdateJobTest::UpgradeFailMasterUrlFetchTest);
 }
 
+TEST_F(AppCacheUpdateJobTest, UpgradeUnchangedETag) {
+  RunTestOnIOThread(&AppCacheUpdateJobTest::UpgradeUnchangedETagTest);
+}
+
 TEST_F(AppCacheUpdateJobTest, EmptyManifest) {
   RunTestOnIOThread(&AppCacheUpdateJobTest::EmptyManifestTest);
 }
@@ -8,6 +8,7 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/sys_info.h"
 #include "url/gurl.h"
 #include "webkit/browser/blob/blob_data_handle.h"
 #include "webkit/common/blob/blob_data.h"
@@ -32,9 +33,18 @@ GURL ClearBlobUrlRef(const GURL& url) {
   return GURL(url.spec().substr(0, hash_pos));
 }
 
-// TODO(michaeln): use base::SysInfo::AmountOfPhysicalMemoryMB() in some
-// way to come up with a better limit.
+// Blob bytes may use up to a fifth of physical memory, but never more than
+// half a gig, so that devices with little memory don't swap.
 static const int64 kMaxMemoryUsage = 500 * 1024 * 1024;  // Half a gig.
+static const int kPhysicalMemoryDivisor = 5;
+
+int64 ComputeMemoryLimit() {
+  int64 limit = base::SysInfo::AmountOfPhysicalMemory() /
+                kPhysicalMemoryDivisor;
+  if (limit <= 0 || limit > kMaxMemoryUsage)
+    return kMaxMemoryUsage;
+  return limit;
+}
 
 }  // namespace
 
@@ -51,7 +61,8 @@ BlobStorageContext::BlobMapEntry::~BlobMapEntry() {
 }
 
 BlobStorageContext::BlobStorageContext()
-    : memory_usage_(0) {
+    : memory_usage_(0),
+      memory_limit_(ComputeMemoryLimit()) {
 }
 
 BlobStorageContext::~BlobStorageContext() {
@@ -278,7 +289,7 @@ bool BlobStorageContext::AppendBytesItem(
     DCHECK(false);
     return false;
   }
-  if (memory_usage_ + length > kMaxMemoryUsage)
+  if (memory_usage_ + length > memory_limit_)
     return false;
   target_blob_data->AppendData(bytes, static_cast<size_t>(length));
   memory_usage_ += length;
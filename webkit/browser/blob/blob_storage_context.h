@@ -47,6 +47,9 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
   bool RegisterPublicBlobURL(const GURL& url, const std::string& uuid);
   void RevokePublicBlobURL(const GURL& url);
 
+  int64 memory_usage() const { return memory_usage_; }
+  void set_memory_limit_for_testing(int64 limit) { memory_limit_ = limit; }
+
  private:
   friend class BlobDataHandle;
   friend class BlobStorageHost;
@@ -106,6 +109,10 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
   // items of TYPE_FILE.
   int64 memory_usage_;
 
+  // The most |memory_usage_| may grow to. Blobs that would take it over the
+  // limit are dropped.
+  int64 memory_limit_;
+
   DISALLOW_COPY_AND_ASSIGN(BlobStorageContext);
 };
 
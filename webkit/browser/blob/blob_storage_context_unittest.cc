@@ -131,6 +131,34 @@ TEST(BlobStorageContextTest, CompoundBlobs) {
   EXPECT_TRUE(*(blob_data_handle->data()) == *canonicalized_blob_data2.get());
 }
 
+TEST(BlobStorageContextTest, MemoryLimit) {
+  BlobStorageContext context;
+  base::MessageLoop fake_io_message_loop;
+  context.set_memory_limit_for_testing(10);
+
+  // A blob that fits is stored and counted.
+  scoped_refptr<BlobData> small_data(new BlobData("small"));
+  small_data->AppendData("12345", 5);
+  scoped_ptr<BlobDataHandle> small_handle =
+      context.AddFinishedBlob(small_data.get());
+  EXPECT_TRUE(small_handle);
+  EXPECT_EQ(5, context.memory_usage());
+
+  // One that would exceed the limit is dropped, and gives its memory back.
+  scoped_refptr<BlobData> large_data(new BlobData("large"));
+  large_data->AppendData("1234", 4);
+  large_data->AppendData("5678", 4);
+  scoped_ptr<BlobDataHandle> large_handle =
+      context.AddFinishedBlob(large_data.get());
+  EXPECT_FALSE(large_handle);
+  EXPECT_EQ(5, context.memory_usage());
+
+  // Releasing a blob frees its memory.
+  small_handle.reset();
+  fake_io_message_loop.RunUntilIdle();
+  EXPECT_EQ(0, context.memory_usage());
+}
+
 TEST(BlobStorageContextTest, PublicBlobUrls) {
   BlobStorageContext context;
   BlobStorageHost host(&context);
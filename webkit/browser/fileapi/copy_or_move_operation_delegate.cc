@@ -4,6 +4,8 @@
 
 #include "webkit/browser/fileapi/copy_or_move_operation_delegate.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/files/file_path.h"
 #include "net/base/io_buffer.h"
@@ -351,8 +353,9 @@ class SnapshotCopyOrMoveImpl
   DISALLOW_COPY_AND_ASSIGN(SnapshotCopyOrMoveImpl);
 };
 
-// The size of buffer for StreamCopyHelper.
+// The initial and maximum size of buffer for StreamCopyHelper.
 const int kReadBufferSize = 32768;
+const int kMaxReadBufferSize = 1024 * 1024;
 
 // To avoid too many progress callbacks, it should be called less
 // frequently than 50ms.
@@ -451,6 +454,7 @@ class StreamCopyOrMoveImpl
             reader_.Pass(), writer_.Pass(),
             need_flush,
             kReadBufferSize,
+            kMaxReadBufferSize,
             file_progress_callback_,
             base::TimeDelta::FromMilliseconds(
                 kMinProgressCallbackInvocationSpanInMilliseconds)));
@@ -536,6 +540,7 @@ CopyOrMoveOperationDelegate::StreamCopyHelper::StreamCopyHelper(
     scoped_ptr<FileStreamWriter> writer,
     bool need_flush,
     int buffer_size,
+    int max_buffer_size,
     const FileSystemOperation::CopyFileProgressCallback&
         file_progress_callback,
     const base::TimeDelta& min_progress_callback_invocation_span)
@@ -544,6 +549,7 @@ CopyOrMoveOperationDelegate::StreamCopyHelper::StreamCopyHelper(
       need_flush_(need_flush),
       file_progress_callback_(file_progress_callback),
       io_buffer_(new net::IOBufferWithSize(buffer_size)),
+      max_buffer_size_(max_buffer_size),
       num_copied_bytes_(0),
       previous_flush_offset_(0),
       min_progress_callback_invocation_span_(
@@ -643,6 +649,14 @@ void CopyOrMoveOperationDelegate::StreamCopyHelper::DidWrite(
     return;
   }
 
+  // The last read filled the buffer, so there is likely more to come; read
+  // it in bigger chunks. |buffer| (and the old |io_buffer_|) is done with.
+  if (buffer->size() == io_buffer_->size() &&
+      io_buffer_->size() < max_buffer_size_) {
+    io_buffer_ = new net::IOBufferWithSize(
+        std::min(io_buffer_->size() * 2, max_buffer_size_));
+  }
+
   if (need_flush_ &&
       (num_copied_bytes_ - previous_flush_offset_) > kFlushIntervalInBytes) {
     Flush(callback, false /* not is_eof */);
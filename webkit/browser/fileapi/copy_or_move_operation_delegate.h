@@ -50,6 +50,7 @@ class CopyOrMoveOperationDelegate
         scoped_ptr<FileStreamWriter> writer,
         bool need_flush,
         int buffer_size,
+        int max_buffer_size,
         const FileSystemOperation::CopyFileProgressCallback&
             file_progress_callback,
         const base::TimeDelta& min_progress_callback_invocation_span);
@@ -81,6 +82,9 @@ class CopyOrMoveOperationDelegate
     const bool need_flush_;
     FileSystemOperation::CopyFileProgressCallback file_progress_callback_;
     scoped_refptr<net::IOBufferWithSize> io_buffer_;
+    // |io_buffer_| starts at |buffer_size| and doubles, up to this, each time
+    // a read fills it, so large files take fewer reads and writes.
+    const int max_buffer_size_;
     int64 num_copied_bytes_;
     int64 previous_flush_offset_;
     base::Time last_progress_callback_invocation_time_;
@@ -74,6 +74,9 @@ const char kChildLookupSeparator[] = ":";
 const char kLastFileIdKey[] = "LAST_FILE_ID";
 const char kLastIntegerKey[] = "LAST_INTEGER";
 const int64 kMinimumReportIntervalHours = 1;
+// Enough for the directories along the paths in use by a typical app; each
+// entry costs roughly the length of its key.
+const size_t kMaxCachedChildIds = 4096;
 const char kInitStatusHistogramLabel[] = "FileSystem.DirectoryDatabaseInit";
 const char kDatabaseRepairHistogramLabel[] =
     "FileSystem.DirectoryDatabaseRepair";
@@ -413,7 +416,8 @@ SandboxDirectoryDatabase::SandboxDirectoryDatabase(
     const base::FilePath& filesystem_data_directory,
     leveldb::Env* env_override)
     : filesystem_data_directory_(filesystem_data_directory),
-      env_override_(env_override) {
+      env_override_(env_override),
+      child_id_cache_(kMaxCachedChildIds) {
 }
 
 SandboxDirectoryDatabase::~SandboxDirectoryDatabase() {
@@ -427,6 +431,11 @@ bool SandboxDirectoryDatabase::GetChildWithName(
     return false;
   DCHECK(child_id);
   std::string child_key = GetChildLookupKey(parent_id, name);
+  ChildIdCache::iterator found = child_id_cache_.Get(child_key);
+  if (found != child_id_cache_.end()) {
+    *child_id = found->second;
+    return true;
+  }
   std::string child_id_string;
   leveldb::Status status =
       db_->Get(leveldb::ReadOptions(), child_key, &child_id_string);
@@ -437,6 +446,7 @@ bool SandboxDirectoryDatabase::GetChildWithName(
       LOG(ERROR) << "Hit database corruption!";
       return false;
     }
+    child_id_cache_.Put(child_key, *child_id);
     return true;
   }
   HandleError(FROM_HERE, status);
@@ -561,6 +571,7 @@ base::File::Error SandboxDirectoryDatabase::AddFileInfo(
     HandleError(FROM_HERE, status);
     return base::File::FILE_ERROR_FAILED;
   }
+  child_id_cache_.Put(child_key, temp_id);
   *file_id = temp_id;
   return base::File::FILE_OK;
 }
@@ -731,6 +742,7 @@ bool SandboxDirectoryDatabase::Init(RecoveryOption recovery_option) {
   leveldb::Status status = leveldb::DB::Open(options, path, &db);
   ReportInitStatus(status);
   if (status.ok()) {
+    child_id_cache_.Clear();
     db_.reset(db);
     return true;
   }
@@ -894,6 +906,10 @@ bool SandboxDirectoryDatabase::AddFileInfoHelper(
   } else {
     std::string child_key = GetChildLookupKey(info.parent_id, info.name);
     batch->Put(child_key, id_string);
+    // Only filled in again once |batch| has been written.
+    ChildIdCache::iterator cached = child_id_cache_.Peek(child_key);
+    if (cached != child_id_cache_.end())
+      child_id_cache_.Erase(cached);
   }
   Pickle pickle;
   if (!PickleFromFileInfo(info, &pickle))
@@ -922,8 +938,12 @@ bool SandboxDirectoryDatabase::RemoveFileInfoHelper(
       return false;
     }
   }
-  batch->Delete(GetChildLookupKey(info.parent_id, info.name));
+  std::string child_key = GetChildLookupKey(info.parent_id, info.name);
+  batch->Delete(child_key);
   batch->Delete(GetFileLookupKey(file_id));
+  ChildIdCache::iterator cached = child_id_cache_.Peek(child_key);
+  if (cached != child_id_cache_.end())
+    child_id_cache_.Erase(cached);
   return true;
 }
 
@@ -932,6 +952,7 @@ void SandboxDirectoryDatabase::HandleError(
     const leveldb::Status& status) {
   LOG(ERROR) << "SandboxDirectoryDatabase failed at: "
              << from_here.ToString() << " with error: " << status.ToString();
+  child_id_cache_.Clear();
   db_.reset();
 }
 
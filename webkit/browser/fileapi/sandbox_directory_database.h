@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/memory/scoped_ptr.h"
@@ -119,9 +120,16 @@ class WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE SandboxDirectoryDatabase {
   void HandleError(const tracked_objects::Location& from_here,
                    const leveldb::Status& status);
 
+  // Maps child lookup keys to FileIds, so that resolving a path doesn't go to
+  // the database once per component for recently used directories.
+  typedef base::MRUCache<std::string, FileId> ChildIdCache;
+
   const base::FilePath filesystem_data_directory_;
   leveldb::Env* env_override_;
   scoped_ptr<leveldb::DB> db_;
+  // Only holds entries read from or written to |db_|; cleared whenever |db_|
+  // is dropped.
+  ChildIdCache child_id_cache_;
   base::Time last_reported_time_;
   DISALLOW_COPY_AND_ASSIGN(SandboxDirectoryDatabase);
 };
@@ -277,6 +277,44 @@ TEST_F(SandboxDirectoryDatabaseTest, TestGetChildWithName) {
   EXPECT_EQ(file_id1, check_file_id);
 }
 
+// Lookups that have been cached must not survive renames and removals.
+TEST_F(SandboxDirectoryDatabaseTest, TestGetChildWithNameAfterUpdate) {
+  FileId dir_id;
+  FileId file_id;
+  base::FilePath::StringType dir_name = FILE_PATH_LITERAL("dir");
+  base::FilePath::StringType name0 = FILE_PATH_LITERAL("foo");
+  base::FilePath::StringType name1 = FILE_PATH_LITERAL("bar");
+  CreateDirectory(0, dir_name, &dir_id);
+  CreateFile(dir_id, name0, FPL("1"), &file_id);
+
+  FileId check_file_id;
+  EXPECT_TRUE(db()->GetChildWithName(dir_id, name0, &check_file_id));
+  EXPECT_EQ(file_id, check_file_id);
+
+  FileInfo info;
+  ASSERT_TRUE(db()->GetFileInfo(file_id, &info));
+  info.name = name1;
+  EXPECT_TRUE(db()->UpdateFileInfo(file_id, info));
+  EXPECT_FALSE(db()->GetChildWithName(dir_id, name0, &check_file_id));
+  EXPECT_TRUE(db()->GetChildWithName(dir_id, name1, &check_file_id));
+  EXPECT_EQ(file_id, check_file_id);
+
+  info.parent_id = 0;
+  EXPECT_TRUE(db()->UpdateFileInfo(file_id, info));
+  EXPECT_FALSE(db()->GetChildWithName(dir_id, name1, &check_file_id));
+  EXPECT_TRUE(db()->GetFileWithPath(base::FilePath(name1), &check_file_id));
+  EXPECT_EQ(file_id, check_file_id);
+
+  EXPECT_TRUE(db()->RemoveFileInfo(file_id));
+  EXPECT_FALSE(db()->GetChildWithName(0, name1, &check_file_id));
+
+  // A fresh instance sees the same state as the cached one.
+  InitDatabase();
+  EXPECT_FALSE(db()->GetChildWithName(0, name1, &check_file_id));
+  EXPECT_TRUE(db()->GetFileWithPath(base::FilePath(dir_name), &check_file_id));
+  EXPECT_EQ(dir_id, check_file_id);
+}
+
 TEST_F(SandboxDirectoryDatabaseTest, TestGetFileWithPath) {
   FileInfo info;
   FileId file_id0;
@@ -358,6 +358,7 @@ void ClientUsageTracker::UpdateUsageCache(
       return;
 
     cached_usage_by_host_[host][origin] += delta;
+    cached_usage_total_by_host_[host] += delta;
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
@@ -409,6 +410,7 @@ void ClientUsageTracker::SetUsageCacheEnabled(const GURL& origin,
         cached_usage_for_host.erase(found);
         if (cached_usage_for_host.empty()) {
           cached_usage_by_host_.erase(found_host);
+          cached_usage_total_by_host_.erase(host);
           cached_hosts_.erase(host);
         }
       }
@@ -558,6 +560,7 @@ void ClientUsageTracker::AddCachedOrigin(
   int64 delta = new_usage - *usage;
   *usage = new_usage;
   if (delta) {
+    cached_usage_total_by_host_[host] += delta;
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
@@ -572,17 +575,11 @@ void ClientUsageTracker::AddCachedHost(const std::string& host) {
 }
 
 int64 ClientUsageTracker::GetCachedHostUsage(const std::string& host) const {
-  HostUsageMap::const_iterator found = cached_usage_by_host_.find(host);
-  if (found == cached_usage_by_host_.end())
+  HostTotalUsageMap::const_iterator found =
+      cached_usage_total_by_host_.find(host);
+  if (found == cached_usage_total_by_host_.end())
     return 0;
-
-  int64 usage = 0;
-  const UsageMap& map = found->second;
-  for (UsageMap::const_iterator iter = map.begin();
-       iter != map.end(); ++iter) {
-    usage += iter->second;
-  }
-  return usage;
+  return found->second;
 }
 
 bool ClientUsageTracker::GetCachedOriginUsage(
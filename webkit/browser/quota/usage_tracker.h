@@ -122,6 +122,7 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   typedef std::set<std::string> HostSet;
   typedef std::map<GURL, int64> UsageMap;
   typedef std::map<std::string, UsageMap> HostUsageMap;
+  typedef std::map<std::string, int64> HostTotalUsageMap;
 
   struct AccumulateInfo {
     int pending_jobs;
@@ -177,6 +178,10 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   bool global_usage_retrieved_;
   HostSet cached_hosts_;
   HostUsageMap cached_usage_by_host_;
+  // The sum of each host's entries in |cached_usage_by_host_|, kept up to
+  // date as usage changes so cached host usage queries are O(1) rather than
+  // a walk over the host's origins.
+  HostTotalUsageMap cached_usage_total_by_host_;
 
   OriginSetByHost non_cached_limited_origins_by_host_;
   OriginSetByHost non_cached_unlimited_origins_by_host_;